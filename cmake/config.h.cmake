@@ -38,6 +38,15 @@
 /* Define to 1 if you have the <unistd.h> header file. */
 #cmakedefine HAVE_UNISTD_H 1
 
+/* Define to 1 if you have the `preadv' function. */
+#cmakedefine HAVE_PREADV 1
+
+/* Define to 1 if POSIX threads are available. */
+#cmakedefine HAVE_PTHREAD 1
+
+/* Set to 1 to count libdwarf events for dwarf_get_perf_stats(). */
+#cmakedefine HAVE_PERF_STATS 1
+
 /* Set to 1 if zlib decompression is available. */
 #cmakedefine HAVE_ZLIB 1
 
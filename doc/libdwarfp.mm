@@ -1121,6 +1121,78 @@ by the \f(CWdwarf_producer_finish_a() \fP call
 was actually correct), along
 with all the other space in use with that Dwarf_P_Debug.
 
+.H 3 "dwarf_pro_set_section_sink()"
+.DS
+\f(CWint dwarf_pro_set_section_sink(
+        Dwarf_P_Debug dbg,
+        Dwarf_P_Section_Sink_Func sink,
+        void *sink_user_data,
+        Dwarf_Error* error)\fP
+.DE
+The function \f(CWdwarf_pro_set_section_sink()\fP
+lets a producer stream the section bytes instead
+of holding every section in memory until
+\f(CWdwarf_get_section_bytes_a()\fP is called.
+Call it before
+\f(CWdwarf_transform_to_disk_form_a()\fP.
+.P
+The sink is called as
+\f(CWsink(elf_section_index,bytes,length,sink_user_data,&errcode)\fP
+as soon as a section is finished, and
+every 64KB or so while the DIEs of .debug_info
+are written.
+The bytes for any one elf section arrive in order
+and are never changed afterwards (the .debug_info
+unit length is written before the DIEs), but they
+are only valid during the call, as the
+buffer is reused.
+The sink returns \f(CWDW_DLV_OK\fP, or
+\f(CWDW_DLV_ERROR\fP to make
+\f(CWdwarf_transform_to_disk_form_a()\fP
+fail with \f(CWDW_DLE_PRO_SECTION_SINK_ERROR\fP.
+.P
+With a sink,
+\f(CWdwarf_transform_to_disk_form_a()\fP
+returns a chunk count of zero.
+Symbolic relocations are still fetched with
+\f(CWdwarf_get_relocation_info()\fP.
+A NULL sink restores the default behavior.
+It returns \f(CWDW_DLV_OK\fP, or \f(CWDW_DLV_ERROR\fP
+if \f(CWdbg\fP is not a valid \f(CWDwarf_P_Debug\fP.
+
+.H 3 "dwarf_pro_set_parallel_generation()"
+.DS
+\f(CWint dwarf_pro_set_parallel_generation(
+        Dwarf_P_Debug dbg,
+        Dwarf_Bool enable,
+        Dwarf_Error* error)\fP
+.DE
+The function \f(CWdwarf_pro_set_parallel_generation()\fP
+with \f(CWenable\fP non-zero has
+\f(CWdwarf_transform_to_disk_form_a()\fP
+generate .debug_line, .debug_frame and
+.debug_info (with .debug_abbrev) at the same time,
+each on its own thread with its own section buffers,
+and then join the buffers in the order a serial
+transform creates them.
+The section bytes are identical either way.
+Call it before
+\f(CWdwarf_transform_to_disk_form_a()\fP.
+.P
+The allocator of the \f(CWDwarf_P_Debug\fP
+is then called from those threads, so it must
+be thread safe (\f(CWmalloc()\fP is).
+If an FDE was tied to a DIE
+(for DW_AT_MIPS_fde) .debug_info is generated
+after .debug_frame rather than alongside it.
+With a section sink .debug_info is passed to
+the sink when it is complete, not in pieces.
+.P
+It returns \f(CWDW_DLV_OK\fP,
+\f(CWDW_DLV_NO_ENTRY\fP if libdwarfp was built
+without POSIX threads (generation stays serial),
+or \f(CWDW_DLV_ERROR\fP
+if \f(CWdbg\fP is not a valid \f(CWDwarf_P_Debug\fP.
 
 .H 3 "dwarf_get_relocation_info_count()"
 .DS
@@ -0,0 +1,62 @@
+#!/bin/sh
+#
+# This code is public domain and can be freely used or copied.
+#
+# --check-all benchmark for dwarfdump.
+# Runs dwarfdump -ka on an object a few times and reports
+# the best wall-clock seconds. Given a second dwarfdump
+# it times that one too (for comparing a build against
+# an older one) and reports whether the two outputs
+# are identical.
+#
+# Usage: checkbench.sh objectfile [path-to-dwarfdump]
+#            [path-to-other-dwarfdump]
+# Set RUNS to change the number of runs (default 3).
+# The outputs are left in $TMPDIR (or /tmp) as
+# checkbench.1.txt and checkbench.2.txt.
+# Needs a date(1) that knows %N (GNU date).
+
+obj=$1
+dd=${2:-./dwarfdump}
+other=$3
+runs=${RUNS:-3}
+t=${TMPDIR:-/tmp}
+if [ ! -f "$obj" ]
+then
+  echo "Usage: checkbench.sh objectfile [path-to-dwarfdump]" \
+    "[path-to-other-dwarfdump]"
+  exit 1
+fi
+
+# Prints the best of $runs wall-clock times.
+run() {
+  d=$1
+  out=$2
+  best=
+  i=0
+  while [ $i -lt $runs ]
+  do
+    start=`date +%s.%N`
+    $d -ka $obj > $out 2>&1
+    end=`date +%s.%N`
+    best=`awk -v s=$start -v e=$end -v b="$best" 'BEGIN {
+      secs = e - s;
+      if (b == "" || secs < b) b = secs;
+      printf "%.3f", b;
+    }'`
+    i=`expr $i + 1`
+  done
+  echo "$best sec  $d -ka $obj"
+}
+
+run $dd $t/checkbench.1.txt
+if [ -n "$other" ]
+then
+  run $other $t/checkbench.2.txt
+  if cmp -s $t/checkbench.1.txt $t/checkbench.2.txt
+  then
+    echo "outputs identical"
+  else
+    echo "outputs differ"
+  fi
+fi
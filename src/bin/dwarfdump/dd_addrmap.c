@@ -32,7 +32,7 @@
 #include <config.h>
 
 #include <stddef.h> /* NULL */
-#include <stdlib.h> /* free() malloc() */
+#include <stdlib.h> /* calloc() free() qsort() realloc() */
 #include <string.h> /* strdup() */
 
 /* Windows specific header files */
@@ -43,99 +43,209 @@
 #include "dwarf.h"
 #include "libdwarf.h"
 #include "dd_globals.h"
+#include "dd_map.h"
+#include "dd_intern.h"
 #include "dd_addrmap.h"
-#include "dd_tsearchbal.h"
 #include "libdwarf_private.h" /* For malloc/calloc debug */
 
-static struct Addr_Map_Entry *
-addr_map_create_entry(Dwarf_Unsigned k,char *name)
+/*  The void * a caller holds for an address map
+    points to a struct Dd_Hash_Map_s, created
+    on the first insert.  print_frames.c checks each
+    FDE low_pc before inserting it, and FDEs need not
+    be in address order, so a sorted map would move
+    entries on most inserts. */
+static struct Dd_Hash_Map_s *
+addr_map_get(void **map,Dwarf_Bool create)
 {
-    struct Addr_Map_Entry *mp =
-        (struct Addr_Map_Entry *)malloc(
-        sizeof(struct Addr_Map_Entry));
-    if (!mp) {
+    struct Dd_Hash_Map_s *hm =
+        (struct Dd_Hash_Map_s *)*map;
+
+    if (!hm && create) {
+        hm = (struct Dd_Hash_Map_s *)calloc(1,
+            sizeof(struct Dd_Hash_Map_s));
+        if (!hm) {
+            return 0;
+        }
+        dd_hash_map_init(hm,sizeof(struct Addr_Map_Entry));
+        *map = hm;
+    }
+    return hm;
+}
+
+struct Addr_Map_Entry *
+addr_map_insert( Dwarf_Unsigned addr,char *name,void **map)
+{
+    struct Dd_Hash_Map_s *hm = 0;
+    struct Addr_Map_Entry *re = 0;
+    Dwarf_Bool is_new = FALSE;
+
+    hm = addr_map_get(map,TRUE);
+    if (!hm) {
         return 0;
     }
-    mp->mp_key = k;
-    if (name) {
+    re = (struct Addr_Map_Entry *)dd_hash_map_insert(hm,
+        addr,&is_new);
+    if (re && is_new && name) {
         /* Might be zero if malloc fails. Ok. */
-        mp->mp_name = (char *)strdup(name);
-    } else {
-        mp->mp_name = 0;
+        re->mp_name = (char *)strdup(name);
+    }
+    return re;
+}
+
+struct Addr_Map_Entry *
+addr_map_find(Dwarf_Unsigned addr,void **map)
+{
+    struct Dd_Hash_Map_s *hm = 0;
+
+    hm = addr_map_get(map,FALSE);
+    if (!hm) {
+        return 0;
     }
-    return mp;
+    return (struct Addr_Map_Entry *)dd_hash_map_find(hm,addr);
 }
+
 static void
-addr_map_free_func(void *mx)
+addr_map_free_name(void *entry, void *data)
 {
-    struct Addr_Map_Entry *m = mx;
-    if (!m) {
+    struct Addr_Map_Entry *e = (struct Addr_Map_Entry *)entry;
+
+    (void)data;
+    free(e->mp_name);
+    e->mp_name = 0;
+}
+
+void
+addr_map_destroy(void *map)
+{
+    struct Dd_Hash_Map_s *hm = (struct Dd_Hash_Map_s *)map;
+
+    if (!hm) {
         return;
     }
-    free(m->mp_name);
-    m->mp_name = 0;
-    free(m);
-    return;
+    dd_hash_map_walk(hm,addr_map_free_name,0);
+    dd_hash_map_destroy(hm);
+    free(hm);
+}
+
+#define ADDR_NAME_TABLE_INITIAL 1024
+
+void
+addr_name_table_add(struct Addr_Name_Table *table,
+    Dwarf_Unsigned addr, const char *name,
+    Dwarf_Bool name_in_section)
+{
+    struct Addr_Name_Entry *e = 0;
+
+    if (table->nt_count >= table->nt_alloc) {
+        Dwarf_Unsigned newalloc = table->nt_alloc?
+            table->nt_alloc*2:ADDR_NAME_TABLE_INITIAL;
+        struct Addr_Name_Entry *newents =
+            (struct Addr_Name_Entry *)realloc(table->nt_entries,
+            newalloc*sizeof(struct Addr_Name_Entry));
+
+        if (!newents) {
+            return;
+        }
+        table->nt_entries = newents;
+        table->nt_alloc = newalloc;
+    }
+    e = table->nt_entries + table->nt_count;
+    e->ne_key = addr;
+    e->ne_seq = table->nt_count;
+    if (name_in_section) {
+        e->ne_name = dd_intern_section_string(&table->nt_names,
+            name);
+    } else {
+        e->ne_name = dd_intern(&table->nt_names,name);
+    }
+    if (!e->ne_name) {
+        return;
+    }
+    table->nt_count++;
+    table->nt_sorted = FALSE;
 }
 
 static int
-addr_map_compare_func(const void *l, const void *r)
+addr_name_compare_func(const void *l, const void *r)
 {
-    const struct Addr_Map_Entry *ml = l;
-    const struct Addr_Map_Entry *mr = r;
-    if (ml->mp_key < mr->mp_key) {
+    const struct Addr_Name_Entry *ml = l;
+    const struct Addr_Name_Entry *mr = r;
+
+    if (ml->ne_key < mr->ne_key) {
         return -1;
     }
-    if (ml->mp_key > mr->mp_key) {
+    if (ml->ne_key > mr->ne_key) {
+        return 1;
+    }
+    if (ml->ne_seq < mr->ne_seq) {
+        return -1;
+    }
+    if (ml->ne_seq > mr->ne_seq) {
         return 1;
     }
     return 0;
 }
-struct Addr_Map_Entry *
-addr_map_insert( Dwarf_Unsigned addr,char *name,void **tree1)
+
+/*  Sort by address and drop all but the first-added
+    entry for each address. */
+void
+addr_name_table_sort(struct Addr_Name_Table *table)
 {
-    void *retval = 0;
-    struct Addr_Map_Entry *re = 0;
-    struct Addr_Map_Entry *e;
-    e  = addr_map_create_entry(addr,name);
-    /*  tsearch records e's contents unless e
-        is already present . We must not free it till
-        destroy time if it got added to tree1.  */
-    retval = dwarf_tsearch(e,tree1, addr_map_compare_func);
-    if (retval) {
-        re = *(struct Addr_Map_Entry **)retval;
-        if (re != e) {
-            /* We returned an existing record, e not needed. */
-            addr_map_free_func(e);
-        } else {
-            /* Record e got added to tree1, do not free record e. */
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned out = 0;
+
+    if (table->nt_sorted) {
+        return;
+    }
+    table->nt_sorted = TRUE;
+    if (!table->nt_count) {
+        return;
+    }
+    qsort(table->nt_entries,table->nt_count,
+        sizeof(struct Addr_Name_Entry),addr_name_compare_func);
+    for (i = 1; i < table->nt_count; ++i) {
+        struct Addr_Name_Entry *e = table->nt_entries+i;
+
+        if (e->ne_key == table->nt_entries[out].ne_key) {
+            continue;
         }
+        ++out;
+        table->nt_entries[out] = *e;
     }
-    return re;
+    table->nt_count = out+1;
 }
-struct Addr_Map_Entry *
-addr_map_find(Dwarf_Unsigned addr,void **tree1)
+
+/*  The table must have been sorted. */
+const char *
+addr_name_table_find(struct Addr_Name_Table *table,
+    Dwarf_Unsigned addr)
 {
-    void *retval = 0;
-    struct Addr_Map_Entry *re = 0;
-    struct Addr_Map_Entry *e = 0;
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = table->nt_count;
 
-    e = addr_map_create_entry(addr,NULL);
-    retval = dwarf_tfind(e,tree1, addr_map_compare_func);
-    if (retval) {
-        re = *(struct Addr_Map_Entry **)retval;
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+        struct Addr_Name_Entry *e = table->nt_entries+mid;
+
+        if (e->ne_key == addr) {
+            return e->ne_name;
+        }
+        if (e->ne_key < addr) {
+            lo = mid+1;
+        } else {
+            hi = mid;
+        }
     }
-    /*  The one we created here must be deleted, it is dead.
-        We look at the returned one instead. */
-    addr_map_free_func(e);
-    return re;
+    return 0;
 }
 
 void
-addr_map_destroy(void *map)
+addr_name_table_destroy(struct Addr_Name_Table *table)
 {
-    /* tdestroy is not part of Posix, it is a GNU libc function. */
-    if (map) {
-        dwarf_tdestroy(map,addr_map_free_func);
-    }
+    dd_intern_destroy(&table->nt_names);
+    free(table->nt_entries);
+    table->nt_entries = 0;
+    table->nt_count = 0;
+    table->nt_alloc = 0;
+    table->nt_sorted = FALSE;
 }
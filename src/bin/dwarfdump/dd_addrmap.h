@@ -43,6 +43,38 @@ struct Addr_Map_Entry * addr_map_find(Dwarf_Unsigned addr,
     void **map);
 void addr_map_destroy(void *map);
 
+/*  A table of (address, name) pairs filled in one pass
+    and then sorted once, so lookups are a binary search
+    with no allocation. For a duplicated address the
+    first name added is the one found.
+    The names are interned (include dd_map.h and
+    dd_intern.h before this), so a name shared by many
+    addresses is stored once. A table is for one
+    Dwarf_Debug: destroy it before dwarf_finish(). */
+struct Addr_Name_Entry {
+    Dwarf_Unsigned ne_key;
+    Dwarf_Unsigned ne_seq;  /* order added, for duplicates */
+    const char    *ne_name;
+};
+struct Addr_Name_Table {
+    struct Addr_Name_Entry *nt_entries;
+    Dwarf_Unsigned          nt_count;
+    Dwarf_Unsigned          nt_alloc;
+    Dwarf_Bool              nt_sorted;
+    struct Dd_Intern_s      nt_names;
+};
+
+/*  name_in_section TRUE means name is as returned by
+    dwarf_formstring(), in a section libdwarf has loaded,
+    not in a caller's buffer. */
+void addr_name_table_add(struct Addr_Name_Table *table,
+    Dwarf_Unsigned addr, const char *name,
+    Dwarf_Bool name_in_section);
+void addr_name_table_sort(struct Addr_Name_Table *table);
+const char * addr_name_table_find(struct Addr_Name_Table *table,
+    Dwarf_Unsigned addr);
+void addr_name_table_destroy(struct Addr_Name_Table *table);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -28,6 +28,7 @@
 
 #include <stdio.h>  /* printf() */
 #include <stdlib.h> /* calloc() free() malloc() */
+#include <string.h> /* memset() */
 
 /* Windows specific header files */
 #if defined(_WIN32) && defined(HAVE_STDAFX_H)
@@ -226,33 +227,28 @@ static Dwarf_Bool
 legal_attr_formclass_combination(Dwarf_Half attr,
     Dwarf_Half fc)
 {
-    Three_Key_Entry *e = 0;
+    Three_Key_Entry e;
     Three_Key_Entry *re = 0;
     void *ret = 0;
-    int res = 0;
 
-    res = make_3key(attr,fc,0,0,0,0,&e);
-    if (res!= DW_DLV_OK) {
-        /*  Hiding some sort of botch/malloc issue */
-        return TRUE;
-    }
-    ret = dwarf_tfind(e,&threekey_attr_form_base,
+    /*  Only the keys are compared, so a local
+        record serves for the search. */
+    memset(&e,0,sizeof(e));
+    e.key1 = attr;
+    e.key2 = fc;
+    ret = dwarf_tfind(&e,&threekey_attr_form_base,
         std_compare_3key_entry);
     if (!ret) {
         /*  Surprising combo. */
-        free(e);
         return FALSE;
     }
     re = *(Three_Key_Entry **)ret;
     if (!glflags.gf_suppress_check_extensions_tables) {
-        free(e);
         return TRUE;
     }
     if (re->std_or_exten == AF_STD) {
-        free(e);
         return TRUE;
     }
-    free(e);
     return FALSE;
 }
 
@@ -297,6 +293,7 @@ record_attr_form_use(
     int pd_dwarf_names_print_on_error,
     int die_stack_indent_level)
 {
+    Three_Key_Entry  k;
     Three_Key_Entry *e =  0;
     Three_Key_Entry *re =  0;
     void *ret =  0;
@@ -322,6 +319,20 @@ record_attr_form_use(
         tag,attr,fclass,pd_dwarf_names_print_on_error,
         die_stack_indent_level);
 #endif /* SKIP_AF_CHECK */
+    /*  Nearly every use is of a combination already
+        recorded, so look with a local record first and
+        only malloc a record for a new combination. */
+    memset(&k,0,sizeof(k));
+    k.key1 = attr;
+    k.key2 = fclass;
+    k.key3 = form;
+    ret = dwarf_tfind(&k,&threekey_attr_form_base,
+        std_compare_3key_entry);
+    if (ret) {
+        re = *(Three_Key_Entry **)ret;
+        ++re->count;
+        return;
+    }
     res = make_3key(attr,fclass,form,std_or_exten,0,1,&e);
     if (res!= DW_DLV_OK) {
         /*  Could print something */
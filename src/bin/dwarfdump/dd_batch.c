@@ -0,0 +1,466 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  --file-batch: dump several object files in one run.
+    The command line and dwarfdump.conf are processed
+    once, then each file is dumped by a worker process
+    forked from that state, so the per-file globals
+    (glflags and the many static tables of dwarfdump)
+    start clean for every file without any reset code.
+    Up to --file-batch-jobs workers run at a time. Each
+    writes its output to a temporary file which is
+    copied to stdout in command line order, so the
+    output does not depend on the number of jobs.
+    The check totals of each worker come back the same
+    way and are summed for a summary at the end.
+
+    A name of the form @<listfile> reads object names,
+    one per line, from listfile. Empty lines and lines
+    starting with # are ignored. */
+
+#include <config.h>
+
+#include <stdio.h>  /* fflush() fopen() fread() fwrite()
+    printf() rewind() tmpfile() */
+#include <stdlib.h> /* exit() free() realloc() */
+#include <string.h> /* memset() strlen() */
+
+#if defined(HAVE_UNISTD_H) && !defined(_WIN32)
+#define BATCH_HAVE_FORK 1
+#include <errno.h>     /* EINTR errno */
+#include <sys/types.h> /* pid_t */
+#include <sys/wait.h>  /* waitpid() WIFEXITED() */
+#include <unistd.h>    /* dup2() fork() sysconf() */
+#endif /* HAVE_UNISTD_H && !_WIN32 */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dd_globals.h"
+#include "dd_glflags.h"
+#include "dd_makename.h"
+#include "dd_esb.h"
+#include "dd_sanitized.h"
+#include "dd_compiler_info.h"
+
+/*  Results a worker hands back to the parent. */
+struct batch_result_s {
+    Dwarf_Check_Result br_totals[LAST_CATEGORY];
+    unsigned long      br_major_errors;
+    unsigned long      br_macronotes;
+};
+
+#define BATCH_IDLE    0
+#define BATCH_RUNNING 1
+#define BATCH_DONE    2
+
+struct batch_job_s {
+    const char *bj_path;
+    int         bj_state;
+    int         bj_status;
+    /*  Nonzero if the worker could not be started. */
+    int         bj_start_failed;
+#ifdef BATCH_HAVE_FORK
+    pid_t       bj_pid;
+#endif /* BATCH_HAVE_FORK */
+    FILE       *bj_out;
+    FILE       *bj_res;
+};
+
+static struct batch_job_s *batch_jobs;
+static unsigned batch_count;
+static unsigned batch_alloc;
+
+/*  Set in a worker only: where batch_record_results()
+    writes. */
+static FILE *batch_results_file;
+
+static void
+batch_append(const char *path)
+{
+    if (batch_count >= batch_alloc) {
+        unsigned newalloc = batch_alloc?batch_alloc*2:64;
+        struct batch_job_s *newjobs = 0;
+
+        newjobs = (struct batch_job_s *)realloc(batch_jobs,
+            newalloc*sizeof(struct batch_job_s));
+        if (!newjobs) {
+            printf("%s ERROR: out of memory recording "
+                "batch file %s\n",glflags.program_name,
+                sanitized(path));
+            global_destructors();
+            exit(EXIT_FAILURE);
+        }
+        batch_jobs = newjobs;
+        batch_alloc = newalloc;
+    }
+    memset(&batch_jobs[batch_count],0,sizeof(struct batch_job_s));
+    batch_jobs[batch_count].bj_path = path;
+    ++batch_count;
+}
+
+static void
+batch_read_listfile(const char *listpath)
+{
+    FILE *f = 0;
+    struct esb_s line;
+    int c = 0;
+
+    f = fopen(listpath,"r");
+    if (!f) {
+        printf("%s ERROR: can't open batch list file %s\n",
+            glflags.program_name,sanitized(listpath));
+        global_destructors();
+        exit(EXIT_FAILURE);
+    }
+    esb_constructor(&line);
+    for (;;) {
+        c = getc(f);
+        if (c != EOF && c != '\n') {
+            /*  esb_appendn() wants a NUL-terminated
+                string. */
+            char ch[2];
+
+            ch[0] = (char)c;
+            ch[1] = 0;
+            esb_appendn(&line,ch,1);
+            continue;
+        }
+        {
+            char  *s = esb_get_string(&line);
+            size_t len = esb_string_len(&line);
+
+            if (len && s[len-1] == '\r') {
+                s[--len] = 0;
+            }
+            if (len && s[0] != '#') {
+                batch_append(makename(s));
+            }
+        }
+        esb_empty_string(&line);
+        if (c == EOF) {
+            break;
+        }
+    }
+    esb_destructor(&line);
+    fclose(f);
+}
+
+/*  path is a makename() string. */
+void
+batch_add_file(const char *path)
+{
+    if (path[0] == '@' && path[1]) {
+        batch_read_listfile(path+1);
+        return;
+    }
+    batch_append(path);
+}
+
+unsigned
+batch_file_count(void)
+{
+    return batch_count;
+}
+
+const char *
+batch_first_file(void)
+{
+    if (!batch_count) {
+        return 0;
+    }
+    return batch_jobs[0].bj_path;
+}
+
+/*  Called by a worker once its file is dumped, before
+    the check counts are cleared. Does nothing
+    outside a worker. */
+void
+batch_record_results(void)
+{
+    struct batch_result_s r;
+
+    if (!batch_results_file) {
+        return;
+    }
+    memset(&r,0,sizeof(r));
+    get_check_totals(r.br_totals);
+    r.br_major_errors = glflags.gf_count_major_errors;
+    r.br_macronotes = glflags.gf_count_macronotes;
+    fwrite(&r,sizeof(r),1,batch_results_file);
+    fflush(batch_results_file);
+}
+
+void
+batch_destructor(void)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < batch_count; ++i) {
+        if (batch_jobs[i].bj_out) {
+            fclose(batch_jobs[i].bj_out);
+        }
+        if (batch_jobs[i].bj_res) {
+            fclose(batch_jobs[i].bj_res);
+        }
+    }
+    free(batch_jobs);
+    batch_jobs = 0;
+    batch_count = 0;
+    batch_alloc = 0;
+}
+
+/*  The number of worker processes to run at once when
+    no --file-batch-jobs is given: one per CPU.
+    Also used by --print-size-stats. */
+unsigned
+batch_default_jobs(void)
+{
+#ifdef _SC_NPROCESSORS_ONLN
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (n > 0) {
+        return (unsigned)n;
+    }
+#endif /* _SC_NPROCESSORS_ONLN */
+    return 1;
+}
+
+#ifdef BATCH_HAVE_FORK
+static void
+batch_start(struct batch_job_s *job,
+    void (*dump_one)(const char *path))
+{
+    job->bj_out = tmpfile();
+    job->bj_res = tmpfile();
+    if (!job->bj_out || !job->bj_res) {
+        job->bj_start_failed = TRUE;
+        job->bj_state = BATCH_DONE;
+        return;
+    }
+    /*  Anything buffered would otherwise be
+        written again by the worker. */
+    fflush(stdout);
+    job->bj_pid = fork();
+    if (job->bj_pid < 0) {
+        job->bj_start_failed = TRUE;
+        job->bj_state = BATCH_DONE;
+        return;
+    }
+    if (job->bj_pid == 0) {
+        /*  The worker. */
+        if (dup2(fileno(job->bj_out),fileno(stdout)) < 0) {
+            exit(EXIT_FAILURE);
+        }
+        batch_results_file = job->bj_res;
+        dump_one(job->bj_path);
+        batch_results_file = 0;
+        global_destructors();
+        exit(0);
+    }
+    job->bj_state = BATCH_RUNNING;
+}
+
+static void
+batch_copy_output(FILE *f)
+{
+    char buf[8192];
+    size_t len = 0;
+
+    rewind(f);
+    while ((len = fread(buf,1,sizeof(buf),f)) > 0) {
+        fwrite(buf,1,len,stdout);
+    }
+}
+
+/*  Prints the output of a finished job and adds its
+    results to *sum. Returns TRUE if the job failed. */
+static int
+batch_emit(unsigned index, struct batch_result_s *sum)
+{
+    struct batch_job_s *job = &batch_jobs[index];
+    struct batch_result_s r;
+    int failed = FALSE;
+    int i = 0;
+
+    if (glflags.gf_format_json) {
+        print_json_batch_file(index+1,batch_count,job->bj_path);
+    } else {
+        printf("\n%s batch file %u of %u: %s\n",
+            glflags.program_name,index+1,batch_count,
+            sanitized(job->bj_path));
+    }
+    if (job->bj_start_failed) {
+        printf("%s ERROR: could not start a worker for %s\n",
+            glflags.program_name,sanitized(job->bj_path));
+        failed = TRUE;
+    } else {
+        batch_copy_output(job->bj_out);
+        if (WIFSIGNALED(job->bj_status)) {
+            printf("%s ERROR: worker for %s terminated by "
+                "signal %d\n",glflags.program_name,
+                sanitized(job->bj_path),
+                WTERMSIG(job->bj_status));
+            failed = TRUE;
+        } else if (!WIFEXITED(job->bj_status) ||
+            WEXITSTATUS(job->bj_status)) {
+            failed = TRUE;
+        }
+        rewind(job->bj_res);
+        if (fread(&r,sizeof(r),1,job->bj_res) == 1) {
+            for (i = 0; i < LAST_CATEGORY; ++i) {
+                sum->br_totals[i].checks += r.br_totals[i].checks;
+                sum->br_totals[i].errors += r.br_totals[i].errors;
+            }
+            sum->br_major_errors += r.br_major_errors;
+            sum->br_macronotes += r.br_macronotes;
+        }
+    }
+    if (job->bj_out) {
+        fclose(job->bj_out);
+        job->bj_out = 0;
+    }
+    if (job->bj_res) {
+        fclose(job->bj_res);
+        job->bj_res = 0;
+    }
+    fflush(stdout);
+    return failed;
+}
+
+/*  Dumps every batch file with dump_one() in a worker
+    process, at most --file-batch-jobs at a time.
+    Returns DW_DLV_ERROR if any file could not be
+    dumped, else DW_DLV_OK. */
+int
+batch_run(void (*dump_one)(const char *path))
+{
+    struct batch_result_s sum;
+    unsigned jobs = glflags.gf_file_batch_jobs;
+    unsigned window = 0;
+    unsigned next = 0;
+    unsigned emitted = 0;
+    unsigned running = 0;
+    unsigned failed = 0;
+
+    memset(&sum,0,sizeof(sum));
+    if (!jobs) {
+        jobs = batch_default_jobs();
+    }
+    if (jobs > batch_count) {
+        jobs = batch_count;
+    }
+    /*  Finished output waits in temporary files until
+        every earlier file is printed. The window bounds
+        how many such files are open at once. */
+    window = jobs*4;
+    while (emitted < batch_count) {
+        while (running < jobs && next < batch_count &&
+            next < emitted + window) {
+            batch_start(&batch_jobs[next],dump_one);
+            if (batch_jobs[next].bj_state == BATCH_RUNNING) {
+                ++running;
+            }
+            ++next;
+        }
+        if (running) {
+            int status = 0;
+            unsigned i = 0;
+            pid_t pid = waitpid(-1,&status,0);
+
+            if (pid < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                printf("%s ERROR: lost track of batch "
+                    "workers\n",glflags.program_name);
+                return DW_DLV_ERROR;
+            }
+            for (i = emitted; i < next; ++i) {
+                struct batch_job_s *job = &batch_jobs[i];
+
+                if (job->bj_state == BATCH_RUNNING &&
+                    job->bj_pid == pid) {
+                    job->bj_status = status;
+                    job->bj_state = BATCH_DONE;
+                    --running;
+                    break;
+                }
+            }
+        }
+        while (emitted < next &&
+            batch_jobs[emitted].bj_state == BATCH_DONE) {
+            if (batch_emit(emitted,&sum)) {
+                ++failed;
+            }
+            ++emitted;
+        }
+    }
+
+    if (glflags.gf_format_json) {
+        print_json_batch_summary(batch_count - failed,failed);
+        fflush(stdout);
+        return failed?DW_DLV_ERROR:DW_DLV_OK;
+    }
+    printf("\n*** BATCH SUMMARY ***\n");
+    printf("Files dumped     : %u\n",batch_count - failed);
+    printf("Files failed     : %u\n",failed);
+    if (sum.br_major_errors) {
+        printf("DWARF errors     : %lu\n",sum.br_major_errors);
+    }
+    if (sum.br_macronotes) {
+        printf("DWARF MACRONOTEs : %lu\n",sum.br_macronotes);
+    }
+    if (glflags.gf_do_check_dwarf || glflags.gf_check_show_results) {
+        printf("\n*** TOTAL ERRORS FOR ALL FILES ***\n");
+        print_check_totals(sum.br_totals);
+    }
+    fflush(stdout);
+    return failed?DW_DLV_ERROR:DW_DLV_OK;
+}
+#else /* !BATCH_HAVE_FORK */
+
+/*  Without fork() there is no cheap way to give each
+    file fresh dwarfdump state, so only a single
+    file can be dumped. */
+int
+batch_run(void (*dump_one)(const char *path))
+{
+    if (batch_count != 1) {
+        printf("%s ERROR: --file-batch with more than one "
+            "file is not supported on this platform\n",
+            glflags.program_name);
+        return DW_DLV_ERROR;
+    }
+    dump_one(batch_jobs[0].bj_path);
+    return DW_DLV_OK;
+}
+#endif /* BATCH_HAVE_FORK */
@@ -48,13 +48,18 @@ Portions Copyright (C) 2011-2019 David Anderson. All Rights Reserved.
         to test with.
     2022.
 
+    Address and key lookups use sorted indexes
+    (Bucket_Interval, Bucket_Key) over the buckets
+    so they are logarithmic rather than a scan
+    of every entry.  2026.
 */
 
 #include <config.h>
 
 #include <stdio.h>  /* printf() */
-#include <stdlib.h> /* calloc() free() */
-#include <string.h> /* strcmp() */
+#include <stdlib.h> /* calloc() free() qsort() realloc() */
+#include <string.h> /* memmove() strcmp() */
+#include <time.h>   /* clock() */
 
 /* Windows specific header files */
 #if defined(_WIN32) && defined(HAVE_STDAFX_H)
@@ -80,6 +85,12 @@ static void DumpFullBucketGroup(Bucket_Group *pBucketGroup);
 static unsigned long bucketgroupnext  = 0;
 static unsigned long bucketnext  = 0;
 
+#define MAX_ADDR (~(Dwarf_Addr)0)
+/*  TRUE if an interval ending at ahigh overlaps or
+    is immediately followed by one starting at blow. */
+#define TOUCHES(ahigh,blow) ((blow) <= (ahigh) || \
+    ((ahigh) != MAX_ADDR && (ahigh)+1 == (blow)))
+
 static const char *
 kindstring(int kind)
 {
@@ -134,6 +145,10 @@ ReleaseBucketGroup(Bucket_Group *pBucketGroup)
     }
     pBucketGroup->pHead = NULL;
     pBucketGroup->pTail = NULL;
+    free(pBucketGroup->pIntervals);
+    pBucketGroup->pIntervals = NULL;
+    free(pBucketGroup->pKeys);
+    pBucketGroup->pKeys = NULL;
     free(pBucketGroup);
 }
 
@@ -151,6 +166,9 @@ ResetBucketGroup(Bucket_Group *pBucketGroup)
         pBucket = pBucket->pNext) {
         pBucket->nEntries = 0;
     }
+    /*  Empty indexes are accurate for empty buckets. */
+    pBucketGroup->nIntervals = 0;
+    pBucketGroup->nKeys = 0;
     ResetSentinelBucketGroup(pBucketGroup);
 }
 
@@ -177,6 +195,34 @@ PrintBucketGroup(Bucket_Group *pBucketGroup)
     }
 }
 
+/*  For --print-perf-stats. The counts are
+    cleared once printed. */
+void
+PrintBucketGroupStats(Bucket_Group *pBucketGroup)
+{
+    const char *kindstr = 0;
+
+    if (!pBucketGroup) {
+        return;
+    }
+    kindstr = kindstring(pBucketGroup->kind);
+    if (!kindstr) {
+        return;
+    }
+    printf("  %-18s: lookups %" DW_PR_DUu
+        ", probes %" DW_PR_DUu
+        ", intervals %lu, keys %lu, %.6f sec\n",
+        kindstr,
+        pBucketGroup->nLookups,
+        pBucketGroup->nProbes,
+        pBucketGroup->nIntervals,
+        pBucketGroup->nKeys,
+        pBucketGroup->lookupSeconds);
+    pBucketGroup->nLookups = 0;
+    pBucketGroup->nProbes = 0;
+    pBucketGroup->lookupSeconds = 0.0;
+}
+
 static void
 DumpFullBucketGroup(Bucket_Group *pBucketGroup)
 {
@@ -226,43 +272,317 @@ DumpFullBucketGroup(Bucket_Group *pBucketGroup)
     }
 }
 
-/*  Insert entry into Bucket Group.
-    We make no check for duplicate information. */
-void
-AddEntryIntoBucketGroup(Bucket_Group *pBucketGroup,
-    Dwarf_Addr key,Dwarf_Addr base,
-    Dwarf_Addr low,Dwarf_Addr high,
-    const char *name,
-    Dwarf_Bool bFlag)
+static Dwarf_Bool
+grow_index(void **array,unsigned long *nalloc,size_t entsize)
+{
+    unsigned long newalloc = *nalloc? *nalloc*2: 64;
+    void *newp = 0;
+
+    newp = realloc(*array,newalloc*entsize);
+    if (!newp) {
+        return FALSE;
+    }
+    *array = newp;
+    *nalloc = newalloc;
+    return TRUE;
+}
+
+static void
+start_lookup(Bucket_Group *pBucketGroup,clock_t *start)
+{
+    ++pBucketGroup->nLookups;
+    if (glflags.gf_print_perf_stats) {
+        *start = clock();
+    }
+}
+
+static void
+end_lookup(Bucket_Group *pBucketGroup,clock_t start)
+{
+    if (glflags.gf_print_perf_stats) {
+        pBucketGroup->lookupSeconds +=
+            (double)(clock() - start)/CLOCKS_PER_SEC;
+    }
+}
+
+/*  Add [low,high] to the sorted, coalesced intervals.
+    Returns FALSE if out of memory. */
+static Dwarf_Bool
+insert_interval(Bucket_Group *pBucketGroup,
+    Dwarf_Addr low,Dwarf_Addr high)
+{
+    Bucket_Interval *iv = pBucketGroup->pIntervals;
+    unsigned long n = pBucketGroup->nIntervals;
+    unsigned long lo = 0;
+    unsigned long hi = n;
+    unsigned long j = 0;
+
+    if (low > high) {
+        /* Can never contain an address. */
+        return TRUE;
+    }
+    /*  Find the first interval that touches or
+        follows low. */
+    while (lo < hi) {
+        unsigned long mid = lo + (hi - lo)/2;
+
+        if (TOUCHES(iv[mid].high,low)) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    for (j = lo; j < n && TOUCHES(high,iv[j].low); ++j) {
+    }
+    if (j == lo) {
+        if (n >= pBucketGroup->nIntervalsAlloc) {
+            if (!grow_index((void **)&pBucketGroup->pIntervals,
+                &pBucketGroup->nIntervalsAlloc,
+                sizeof(Bucket_Interval))) {
+                return FALSE;
+            }
+            iv = pBucketGroup->pIntervals;
+        }
+        memmove(iv+lo+1,iv+lo,(n-lo)*sizeof(Bucket_Interval));
+        iv[lo].low = low;
+        iv[lo].high = high;
+        pBucketGroup->nIntervals = n+1;
+        return TRUE;
+    }
+    /* Intervals lo through j-1 merge into one. */
+    if (low < iv[lo].low) {
+        iv[lo].low = low;
+    }
+    iv[lo].high = high > iv[j-1].high? high: iv[j-1].high;
+    memmove(iv+lo+1,iv+j,(n-j)*sizeof(Bucket_Interval));
+    pBucketGroup->nIntervals = n - (j - lo - 1);
+    return TRUE;
+}
+
+static int
+compare_interval(const void *l,const void *r)
+{
+    const Bucket_Interval *li = (const Bucket_Interval *)l;
+    const Bucket_Interval *ri = (const Bucket_Interval *)r;
+
+    if (li->low < ri->low) {
+        return -1;
+    }
+    if (li->low > ri->low) {
+        return 1;
+    }
+    return 0;
+}
+
+/*  Sort all the bucket ranges then merge
+    them in one pass. */
+static void
+build_intervals(Bucket_Group *pBucketGroup)
 {
     Bucket *pBucket = 0;
-    Bucket_Data data;
+    Bucket_Interval *iv = 0;
+    unsigned long n = 0;
+    unsigned long out = 0;
+    unsigned long i = 0;
+    int nIndex = 0;
 
-    data.bFlag = bFlag;
-    data.name = name;
-    data.key = key;
-    data.base = base;
-    data.low = low;
-    data.high = high;
+    pBucketGroup->nIntervals = 0;
+    pBucketGroup->bIntervalsValid = FALSE;
+    for (pBucket = pBucketGroup->pHead; pBucket && pBucket->nEntries;
+        pBucket = pBucket->pNext) {
+        for (nIndex = 0; nIndex < pBucket->nEntries; ++nIndex) {
+            Bucket_Data *pBucketData = &pBucket->Entries[nIndex];
 
-    if (!pBucketGroup) {
-        printf("ERROR AddEntryIntoBucketGroup passed NULL."
-            " Ignored\n");
-        glflags.gf_count_major_errors++;
+            if (pBucketData->low > pBucketData->high) {
+                continue;
+            }
+            if (n >= pBucketGroup->nIntervalsAlloc) {
+                if (!grow_index((void **)&pBucketGroup->pIntervals,
+                    &pBucketGroup->nIntervalsAlloc,
+                    sizeof(Bucket_Interval))) {
+                    return;
+                }
+            }
+            iv = pBucketGroup->pIntervals;
+            iv[n].low = pBucketData->low;
+            iv[n].high = pBucketData->high;
+            ++n;
+        }
+    }
+    if (n) {
+        qsort(iv,n,sizeof(Bucket_Interval),compare_interval);
+        for (i = 1; i < n; ++i) {
+            if (TOUCHES(iv[out].high,iv[i].low)) {
+                if (iv[i].high > iv[out].high) {
+                    iv[out].high = iv[i].high;
+                }
+            } else {
+                iv[++out] = iv[i];
+            }
+        }
+        ++out;
+    }
+    pBucketGroup->nIntervals = out;
+    pBucketGroup->bIntervalsValid = TRUE;
+}
+
+/*  Binary search for the key. Returns the index of the
+    key, or where it would be inserted, in *position.
+    Steps are added to *probes if probes is non-null. */
+static Dwarf_Bool
+find_key_position(Bucket_Group *pBucketGroup,Dwarf_Addr key,
+    unsigned long *position,Dwarf_Unsigned *probes)
+{
+    Bucket_Key *k = pBucketGroup->pKeys;
+    unsigned long lo = 0;
+    unsigned long hi = pBucketGroup->nKeys;
+
+    while (lo < hi) {
+        unsigned long mid = lo + (hi - lo)/2;
+
+        if (probes) {
+            ++*probes;
+        }
+        if (k[mid].key < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    *position = lo;
+    return lo < pBucketGroup->nKeys && k[lo].key == key;
+}
+
+static Dwarf_Bool
+insert_key(Bucket_Group *pBucketGroup,Dwarf_Addr key)
+{
+    Bucket_Key *k = 0;
+    unsigned long pos = 0;
+
+    if (find_key_position(pBucketGroup,key,&pos,0)) {
+        ++pBucketGroup->pKeys[pos].count;
+        return TRUE;
+    }
+    if (pBucketGroup->nKeys >= pBucketGroup->nKeysAlloc) {
+        if (!grow_index((void **)&pBucketGroup->pKeys,
+            &pBucketGroup->nKeysAlloc,sizeof(Bucket_Key))) {
+            return FALSE;
+        }
+    }
+    k = pBucketGroup->pKeys;
+    memmove(k+pos+1,k+pos,
+        (pBucketGroup->nKeys-pos)*sizeof(Bucket_Key));
+    k[pos].key = key;
+    k[pos].count = 1;
+    ++pBucketGroup->nKeys;
+    return TRUE;
+}
+
+static void
+remove_key(Bucket_Group *pBucketGroup,Dwarf_Addr key)
+{
+    Bucket_Key *k = pBucketGroup->pKeys;
+    unsigned long pos = 0;
+
+    if (!find_key_position(pBucketGroup,key,&pos,0)) {
+        return;
+    }
+    if (--k[pos].count) {
         return;
     }
+    memmove(k+pos,k+pos+1,
+        (pBucketGroup->nKeys-pos-1)*sizeof(Bucket_Key));
+    --pBucketGroup->nKeys;
+}
+
+static void
+build_keys(Bucket_Group *pBucketGroup)
+{
+    Bucket *pBucket = 0;
+    int nIndex = 0;
+
+    pBucketGroup->nKeys = 0;
+    pBucketGroup->bKeysValid = FALSE;
+    for (pBucket = pBucketGroup->pHead; pBucket && pBucket->nEntries;
+        pBucket = pBucket->pNext) {
+        for (nIndex = 0; nIndex < pBucket->nEntries; ++nIndex) {
+            if (!insert_key(pBucketGroup,
+                pBucket->Entries[nIndex].key)) {
+                return;
+            }
+        }
+    }
+    pBucketGroup->bKeysValid = TRUE;
+}
+
+/*  Checks if 'address' is inside some entry
+    using the interval index, falling back to a
+    linear search if the index cannot be built. */
+static Dwarf_Bool
+address_in_bucket_group(Bucket_Group *pBucketGroup,
+    Dwarf_Addr address)
+{
+    Bucket_Interval *iv = 0;
+    unsigned long lo = 0;
+    unsigned long hi = 0;
+    Bucket *pBucket = 0;
+    int nIndex = 0;
+
+    if (!pBucketGroup->bIntervalsValid) {
+        build_intervals(pBucketGroup);
+    }
+    if (pBucketGroup->bIntervalsValid) {
+        /* Find the last interval with low <= address. */
+        iv = pBucketGroup->pIntervals;
+        hi = pBucketGroup->nIntervals;
+        while (lo < hi) {
+            unsigned long mid = lo + (hi - lo)/2;
+
+            ++pBucketGroup->nProbes;
+            if (iv[mid].low <= address) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo && address <= iv[lo-1].high;
+    }
+    for (pBucket = pBucketGroup->pHead; pBucket && pBucket->nEntries;
+        pBucket = pBucket->pNext) {
+        for (nIndex = 0; nIndex < pBucket->nEntries; ++nIndex) {
+            Bucket_Data *pBucketData = &pBucket->Entries[nIndex];
+
+            ++pBucketGroup->nProbes;
+            if (address >= pBucketData->low &&
+                address <= pBucketData->high) {
+                return TRUE;
+            }
+        }
+    }
+    return FALSE;
+}
+
+/*  Insert entry into Bucket Group.
+    We make no check for duplicate information. */
+static Dwarf_Bool
+add_entry_to_buckets(Bucket_Group *pBucketGroup,
+    Bucket_Data *pdata)
+{
+    Bucket *pBucket = 0;
+    Bucket_Data data = *pdata;
+
     if (!pBucketGroup->pHead) {
         /* Allocate first bucket */
         pBucket = (Bucket *)calloc(1,sizeof(Bucket));
         if (!pBucket) {
-            return;
+            return FALSE;
         }
         pBucket->b_number = bucketnext++;
         pBucketGroup->pHead = pBucket;
         pBucketGroup->pTail = pBucket;
         pBucket->nEntries = 1;
         pBucket->Entries[0] = data;
-        return;
+        return TRUE;
     }
     pBucket = pBucketGroup->pTail;
 
@@ -275,7 +595,7 @@ AddEntryIntoBucketGroup(Bucket_Group *pBucketGroup,
             /* Allocate new bucket */
             pBucket = (Bucket *)calloc(1,sizeof(Bucket));
             if (!pBucket) {
-                return;
+                return FALSE;
             }
             pBucketGroup->pTail->pNext = pBucket;
             pBucketGroup->pTail = pBucket;
@@ -293,9 +613,48 @@ AddEntryIntoBucketGroup(Bucket_Group *pBucketGroup,
 
             if (pBucket->nEntries < BUCKET_SIZE) {
                 pBucket->Entries[pBucket->nEntries++] = data;
-                break;
+                return TRUE;
             }
         }
+        return FALSE;
+    }
+    return TRUE;
+}
+
+void
+AddEntryIntoBucketGroup(Bucket_Group *pBucketGroup,
+    Dwarf_Addr key,Dwarf_Addr base,
+    Dwarf_Addr low,Dwarf_Addr high,
+    const char *name,
+    Dwarf_Bool bFlag)
+{
+    Bucket_Data data;
+
+    data.bFlag = bFlag;
+    data.name = name;
+    data.key = key;
+    data.base = base;
+    data.low = low;
+    data.high = high;
+
+    if (!pBucketGroup) {
+        printf("ERROR AddEntryIntoBucketGroup passed NULL."
+            " Ignored\n");
+        glflags.gf_count_major_errors++;
+        return;
+    }
+    if (!add_entry_to_buckets(pBucketGroup,&data)) {
+        return;
+    }
+    /*  Keep any index already built in step,
+        else it is rebuilt on next use. */
+    if (pBucketGroup->bIntervalsValid &&
+        !insert_interval(pBucketGroup,low,high)) {
+        pBucketGroup->bIntervalsValid = FALSE;
+    }
+    if (pBucketGroup->bKeysValid &&
+        !insert_key(pBucketGroup,key)) {
+        pBucketGroup->bKeysValid = FALSE;
     }
 }
 
@@ -333,6 +692,12 @@ DeleteKeyInBucketGroup(Bucket_Group *pBucketGroup,Dwarf_Addr key)
                 }
                 pBucket->Entries[nIndex] = data;
                 --pBucket->nEntries;
+                if (pBucketGroup->bKeysValid) {
+                    remove_key(pBucketGroup,key);
+                }
+                /*  A merged interval cannot be split,
+                    rebuild when next needed. */
+                pBucketGroup->bIntervalsValid = FALSE;
                 return TRUE;
             }
         }
@@ -349,9 +714,8 @@ Dwarf_Bool
 FindAddressInBucketGroup(Bucket_Group *pBucketGroup,
     Dwarf_Addr address)
 {
-    int nIndex = 0;
-    Bucket *pBucket = 0;
-    Bucket_Data *pBucketData = 0;
+    clock_t start = 0;
+    Dwarf_Bool found = FALSE;
 
     if (!pBucketGroup) {
         printf("ERROR FindAdressinBucketGroup passed NULL. "
@@ -359,19 +723,10 @@ FindAddressInBucketGroup(Bucket_Group *pBucketGroup,
         glflags.gf_count_major_errors++;
         return FALSE;
     }
-    /* For now do a linear search */
-    for (pBucket = pBucketGroup->pHead; pBucket && pBucket->nEntries;
-        pBucket = pBucket->pNext) {
-
-        for (nIndex = 0; nIndex < pBucket->nEntries; ++nIndex) {
-            pBucketData = &pBucket->Entries[nIndex];
-            if (address >= pBucketData->low &&
-                address <= pBucketData->high) {
-                return TRUE;
-            }
-        }
-    }
-    return FALSE;
+    start_lookup(pBucketGroup,&start);
+    found = address_in_bucket_group(pBucketGroup,address);
+    end_lookup(pBucketGroup,start);
+    return found;
 }
 
 /*  Search an entry (Bucket Data) in the Bucket Set */
@@ -429,6 +784,8 @@ Bucket_Data *FindKeyInBucketGroup(Bucket_Group *pBucketGroup,
     int nIndex = 0;
     Bucket *pBucket = 0;
     Bucket_Data *pBucketData = 0;
+    unsigned long pos = 0;
+    clock_t start = 0;
 
     /* Sanity checks */
     if (!pBucketGroup) {
@@ -436,17 +793,31 @@ Bucket_Data *FindKeyInBucketGroup(Bucket_Group *pBucketGroup,
         glflags.gf_count_major_errors++;
         return 0;
     }
-
-    /* For now do a linear search */
+    start_lookup(pBucketGroup,&start);
+    if (!pBucketGroup->bKeysValid) {
+        build_keys(pBucketGroup);
+    }
+    /*  The usual answer is 'not present', which the
+        key index gives directly.  Only a key that is
+        present needs the search for its Bucket_Data. */
+    if (pBucketGroup->bKeysValid &&
+        !find_key_position(pBucketGroup,key,&pos,
+        &pBucketGroup->nProbes)) {
+        end_lookup(pBucketGroup,start);
+        return (Bucket_Data *)NULL;
+    }
     for (pBucket = pBucketGroup->pHead; pBucket && pBucket->nEntries;
         pBucket = pBucket->pNext) {
         for (nIndex = 0; nIndex < pBucket->nEntries; ++nIndex) {
             pBucketData = &pBucket->Entries[nIndex];
+            ++pBucketGroup->nProbes;
             if (pBucketData->key == key) {
+                end_lookup(pBucketGroup,start);
                 return pBucketData;
             }
         }
     }
+    end_lookup(pBucketGroup,start);
     return (Bucket_Data *)NULL;
 }
 
@@ -488,9 +859,8 @@ FindNameInBucketGroup(Bucket_Group *pBucketGroup,char *name)
 Dwarf_Bool
 IsValidInBucketGroup(Bucket_Group *pBucketGroup,Dwarf_Addr address)
 {
-    Bucket *pBucket = 0;
-    Bucket_Data *pBucketData = 0;
-    int nIndex = 0;
+    clock_t start = 0;
+    Dwarf_Bool found = FALSE;
 
     if (!pBucketGroup) {
         printf("ERROR IsValidInBucketGroup passed NULL. Ignored\n");
@@ -500,20 +870,11 @@ IsValidInBucketGroup(Bucket_Group *pBucketGroup,Dwarf_Addr address)
     /* Check the address is within the allowed limits */
     if (address >= pBucketGroup->lower &&
         address <= pBucketGroup->upper) {
-        pBucket = pBucketGroup->pHead;
-        for ( ;
-            pBucket && pBucket->nEntries;
-            pBucket = pBucket->pNext) {
-            for (nIndex = 0; nIndex < pBucket->nEntries; ++nIndex) {
-                pBucketData = &pBucket->Entries[nIndex];
-                if (address >= pBucketData->low &&
-                    address <= pBucketData->high) {
-                    return TRUE;
-                }
-            }
-        }
+        start_lookup(pBucketGroup,&start);
+        found = address_in_bucket_group(pBucketGroup,address);
+        end_lookup(pBucketGroup,start);
     }
-    return FALSE;
+    return found;
 }
 
 /*  Reset limits for values in the Bucket Set */
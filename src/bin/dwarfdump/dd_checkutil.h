@@ -65,6 +65,21 @@ typedef struct bucket {
     struct bucket *pNext;
 }   Bucket;
 
+/*  The low/high of all the Bucket_Data in a group,
+    sorted by low and merged where they overlap or
+    touch, so finding an address is a binary search. */
+typedef struct {
+    Dwarf_Addr low;
+    Dwarf_Addr high;
+} Bucket_Interval;
+
+/*  The keys of all the Bucket_Data in a group, sorted,
+    with a count as nothing prevents duplicate keys. */
+typedef struct {
+    Dwarf_Addr    key;
+    unsigned long count;
+} Bucket_Key;
+
 /* This Forms the head record of a list of Buckets.
 */
 typedef struct {
@@ -76,6 +91,26 @@ typedef struct {
     Bucket_Data *pLast;   /* Last sentinel */
     Bucket *pHead;        /* First bucket in set */
     Bucket *pTail;        /* Last bucket in set */
+
+    /*  Indexes over the buckets. Each is built by the
+        first lookup needing it and then kept up to date
+        by AddEntryIntoBucketGroup(). If not valid the
+        lookups rebuild it (or, failing a malloc,
+        search the buckets linearly). */
+    Bucket_Interval *pIntervals;
+    unsigned long nIntervals;
+    unsigned long nIntervalsAlloc;
+    Dwarf_Bool bIntervalsValid;
+    Bucket_Key *pKeys;
+    unsigned long nKeys;
+    unsigned long nKeysAlloc;
+    Dwarf_Bool bKeysValid;
+
+    /*  Lookup statistics for --print-perf-stats.
+        Time is only measured with that option. */
+    Dwarf_Unsigned nLookups;
+    Dwarf_Unsigned nProbes;
+    double lookupSeconds;
 } Bucket_Group;
 
 Bucket_Group *AllocateBucketGroup(int kind);
@@ -84,6 +119,7 @@ void ResetBucketGroup(Bucket_Group *pBucketGroup);
 void ResetSentinelBucketGroup(Bucket_Group *pBucketGroup);
 
 void PrintBucketGroup(Bucket_Group *pBucketGroup);
+void PrintBucketGroupStats(Bucket_Group *pBucketGroup);
 
 void AddEntryIntoBucketGroup(Bucket_Group *pBucketGroup,
     Dwarf_Addr key,Dwarf_Addr base,Dwarf_Addr low,Dwarf_Addr high,
@@ -89,12 +89,17 @@ static char *config_file_defaults[] = {
 };
 static const char *config_file_abi = 0;
 
+/*  Set once do_all() has selected the default print set,
+    either for -a or because no print option was given. */
+static Dwarf_Bool print_all_selected = FALSE;
+
 /* Do printing of most sections.
    Do not do detailed checking.
 */
 static void
 do_all(void)
 {
+    print_all_selected = TRUE;
     glflags.gf_frame_flag = TRUE;
     glflags.gf_info_flag = TRUE;
     glflags.gf_types_flag =  TRUE; /* .debug_types */
@@ -335,6 +340,8 @@ static void arg_file_abi(void);
 static void arg_file_line5(void);
 static void arg_file_name(void);
 static void arg_file_output(void);
+static void arg_file_batch(void);
+static void arg_file_batch_jobs(void);
 static void arg_file_tied(void);
 static void arg_file_use_no_libelf(void);
 
@@ -342,6 +349,7 @@ static void arg_format_attr_name(void);
 static void arg_format_dense(void);
 static void arg_format_ellipsis(void);
 static void arg_format_expr_ops_joined(void);
+static void arg_format_json(void);
 static void arg_format_extensions(void);
 static void arg_format_global_offsets(void);
 static void arg_format_loc(void);
@@ -389,6 +397,8 @@ static void arg_print_static(void);
 static void arg_print_static_func(void);
 static void arg_print_static_var(void);
 static void arg_print_str_offsets(void);
+static void arg_print_perf_stats(void);
+static void arg_print_size_stats(void);
 static void arg_print_strings(void);
 static void arg_print_types(void);
 static void arg_print_weaknames(void);
@@ -409,6 +419,7 @@ static void arg_search_invalid(void);
 static void arg_search_print_children(void);
 static void arg_search_print_parent(void);
 static void arg_search_print_tree(void);
+static void arg_search_use_index(void);
 
 static void arg_help(void);
 static void arg_trace(void);
@@ -492,6 +503,9 @@ static const char *usage_long_text[] = {
 "-tv  --print-static-var  Print static var section",
 "-s   --print-strings     Print raw .debug_str section",
 "     --print-str-offsets Print raw .debug_str_offsets section",
+"     --print-perf-stats  Print libdwarf internal counters",
+"     --print-size-stats  Print where the DWARF bytes go",
+"                         (by CU, producer, tag, form)",
 "-y   --print-type        Print pubtypes section",
 "-w   --print-weakname    Print weakname section",
 " ",
@@ -563,6 +577,10 @@ static const char *usage_long_text[] = {
 "     --format-expr-ops-joined  Print each group of DWARF DW_OPs",
 "                               on one line rather than one",
 "                               per line.",
+"     --format-json             Print .debug_info, .debug_types,",
+"                               .debug_line and frame sections",
+"                               as JSON Lines records. Other",
+"                               print options are rejected",
 "-R   --format-registers        Print frame register names as",
 "                               r33 etc and allow up to 1200",
 "                               registers using a generic",
@@ -628,6 +646,11 @@ static const char *usage_long_text[] = {
 "                 --file-use-no-libelf  Use non-libelf to",
 "                                       read objects",
 "                                         (as much as possible)",
+"                 --file-batch          Accept several object",
+"                                       files (or @<listfile>)",
+"                                       and dump each in turn",
+"                 --file-batch-jobs=<n> With --file-batch run",
+"                                       <n> files at a time",
 " ",
 "-------------------------------------------------------------------",
 "GNU debuglink options",
@@ -666,6 +689,9 @@ static const char *usage_long_text[] = {
 "                             (wide format) with -S",
 "-W   --search-print-tree     Print parent/children tree ",
 "                             (wide format) with -S",
+"     --search-use-index      With -S match= or -S any= only",
+"                             search CUs whose name index",
+"                             entries match",
 " ",
 "-------------------------------------------------------------------",
 "Help & Version",
@@ -727,12 +753,15 @@ OPT_FILE_NAME,         /* -x name=<path>  --file-name=<path>   */
 OPT_FILE_OUTPUT,       /* -O file=<path>  --file-output=<path> */
 OPT_FILE_TIED,         /* -x tied=<path>  --file-tied=<path>   */
 OPT_FILE_USE_NO_LIBELF,/* --file-use-no-libelf=<path>        */
+OPT_FILE_BATCH,        /* --file-batch                       */
+OPT_FILE_BATCH_JOBS,   /* --file-batch-jobs=<n>              */
 
 /* Print Output Qualifiers  */
 OPT_FORMAT_ATTR_NAME,         /* -M   --format-attr-name       */
 OPT_FORMAT_DENSE,             /* -d   --format-dense           */
 OPT_FORMAT_ELLIPSIS,          /* -e   --format-ellipsis        */
 OPT_FORMAT_EXPR_OPS_JOINED,   /*      --format-expr-ops-joined */
+OPT_FORMAT_JSON,              /*      --format-json            */
 OPT_FORMAT_EXTENSIONS,        /* -C   --format-extensions      */
 OPT_FORMAT_GLOBAL_OFFSETS,    /* -G   --format-global-offsets  */
 OPT_FORMAT_LOC,               /* -g   --format-loc             */
@@ -789,6 +818,8 @@ OPT_PRINT_STATIC_FUNC,        /* -tf  --print-static-func */
 OPT_PRINT_STATIC_VAR,         /* -tv  --print-static-var  */
 OPT_PRINT_STRINGS,            /* -s   --print-strings     */
 OPT_PRINT_STR_OFFSETS,        /*      --print-str-offsets */
+OPT_PRINT_PERF_STATS,         /*      --print-perf-stats  */
+OPT_PRINT_SIZE_STATS,         /*      --print-size-stats  */
 OPT_PRINT_TYPE,               /* -y   --print-type        */
 OPT_PRINT_WEAKNAME,           /* -w   --print-weakname    */
 
@@ -806,6 +837,7 @@ OPT_SEARCH_MATCH_COUNT,
 OPT_SEARCH_PRINT_CHILDREN, /* -Wc --search-print-children */
 OPT_SEARCH_PRINT_PARENT, /* -Wp --search-print-parent    */
 OPT_SEARCH_PRINT_TREE,        /* -W  --search-print-tree  */
+OPT_SEARCH_USE_INDEX,         /*     --search-use-index   */
 OPT_SEARCH_REGEX,       /* -S regex=<text> --search-regex=<text> */
 OPT_SEARCH_REGEX_COUNT,
     /* -Svregex=<text> --search-regex-count<text>*/
@@ -867,6 +899,8 @@ static struct dwoption longopts[] =  {
 {"file-output", dwrequired_argument, 0, OPT_FILE_OUTPUT},
 {"file-tied",   dwrequired_argument, 0, OPT_FILE_TIED  },
 {"file-use-no-libelf",   dwno_argument, 0, OPT_FILE_USE_NO_LIBELF  },
+{"file-batch",  dwno_argument,       0, OPT_FILE_BATCH },
+{"file-batch-jobs", dwrequired_argument, 0, OPT_FILE_BATCH_JOBS},
 
 /* Print Output Qualifiers. */
 {"format-attr-name",         dwno_argument, 0,
@@ -877,6 +911,8 @@ static struct dwoption longopts[] =  {
     OPT_FORMAT_ELLIPSIS         },
 {"format-expr-ops-joined",   dwno_argument, 0,
     OPT_FORMAT_EXPR_OPS_JOINED },
+{"format-json",              dwno_argument, 0,
+    OPT_FORMAT_JSON             },
 {"format-extensions",        dwno_argument, 0,
     OPT_FORMAT_EXTENSIONS       },
 {"format-global-offsets",    dwno_argument, 0,
@@ -941,6 +977,8 @@ OPT_FORMAT_SUPPRESS_OFFSETS },
 {"print-static-var",  dwno_argument, 0, OPT_PRINT_STATIC_VAR },
 {"print-strings",     dwno_argument, 0, OPT_PRINT_STRINGS    },
 {"print-str-offsets", dwno_argument, 0, OPT_PRINT_STR_OFFSETS},
+{"print-perf-stats",  dwno_argument, 0, OPT_PRINT_PERF_STATS},
+{"print-size-stats",  dwno_argument, 0, OPT_PRINT_SIZE_STATS},
 {"print-type",        dwno_argument, 0, OPT_PRINT_TYPE       },
 {"print-weakname",    dwno_argument, 0, OPT_PRINT_WEAKNAME   },
 
@@ -964,6 +1002,8 @@ OPT_FORMAT_SUPPRESS_OFFSETS },
     OPT_SEARCH_PRINT_PARENT  },
 {"search-print-tree",     dwno_argument,  0,
     OPT_SEARCH_PRINT_TREE    },
+{"search-use-index",      dwno_argument,  0,
+    OPT_SEARCH_USE_INDEX     },
 {"search-regex",          dwrequired_argument, 0, OPT_SEARCH_REGEX },
 {"search-regex-count",    dwrequired_argument, 0,
     OPT_SEARCH_REGEX_COUNT   },
@@ -1017,6 +1057,18 @@ void arg_print_str_offsets(void)
     glflags.gf_print_str_offsets = TRUE;
 }
 
+/*  Option '--print-perf-stats' */
+void arg_print_perf_stats(void)
+{
+    glflags.gf_print_perf_stats = TRUE;
+}
+
+/*  Option '--print-size-stats' */
+void arg_print_size_stats(void)
+{
+    glflags.gf_print_size_stats = TRUE;
+}
+
 void arg_trace(void)
 {
     int nTraceLevel = 0;
@@ -1121,6 +1173,120 @@ void arg_format_expr_ops_joined(void)
 {
     glflags.gf_expr_ops_joined = TRUE;
 }
+
+/*  Option '--format-json' */
+void arg_format_json(void)
+{
+    glflags.gf_format_json = TRUE;
+}
+
+/*  The print options that have no JSON form. jn_in_all
+    is set where do_all() turns the option on: for -a,
+    or with no print option, those just mean the sections
+    that have a JSON form. */
+static struct json_noform_s {
+    Dwarf_Bool *jn_flag;
+    Dwarf_Bool  jn_in_all;
+    const char *jn_option;
+} json_noform[] = {
+{&glflags.gf_pubnames_flag,    TRUE, "-p (.debug_pubnames)"},
+{&glflags.gf_macinfo_flag,     TRUE, "-m (macro sections)"},
+{&glflags.gf_aranges_flag,     TRUE, "-r (.debug_aranges)"},
+{&glflags.gf_string_flag,      TRUE, "-s (.debug_str)"},
+{&glflags.gf_static_func_flag, TRUE, "-tf (.debug_funcnames)"},
+{&glflags.gf_static_var_flag,  TRUE, "-tv (.debug_varnames)"},
+{&glflags.gf_pubtypes_flag,    TRUE, "-y (.debug_pubtypes)"},
+{&glflags.gf_weakname_flag,    TRUE, "-w (.debug_weaknames)"},
+{&glflags.gf_debug_names_flag, TRUE, "--print-debug-names"},
+{&glflags.gf_debug_sup_flag,   TRUE, "--print-debug-sup"},
+{&glflags.gf_ranges_flag,      FALSE,"-N (.debug_ranges)"},
+{&glflags.gf_abbrev_flag,      FALSE,"-b (.debug_abbrev)"},
+{&glflags.gf_gdbindex_flag,    FALSE,"-I (.gdb_index)"},
+{&glflags.gf_debug_addr_flag,  FALSE,"--print-debug-addr"},
+{&glflags.gf_debug_gnu_flag,   FALSE,"--print-debug-gnu"},
+{&glflags.gf_gnu_debuglink_flag,FALSE,"--print-gnu-debuglink"},
+{&glflags.gf_print_raw_loclists,FALSE,"--print-raw-loclists"},
+{&glflags.gf_print_raw_rnglists,FALSE,"--print-raw-rnglists"},
+{&glflags.gf_print_str_offsets,FALSE,"--print-str-offsets"},
+{&glflags.gf_cu_name_flag,     FALSE,"-u (CU name selection)"},
+{&glflags.gf_producer_children_flag,FALSE,"-P (producers)"},
+{&glflags.gf_print_perf_stats, FALSE,"--print-perf-stats"},
+{&glflags.gf_print_size_stats, FALSE,"--print-size-stats"},
+{&glflags.gf_machine_arch_flag,FALSE,"--print-machine-arch"},
+{0,FALSE,0}
+};
+
+/*  Reports each option given that --format-json
+    cannot write. Returns TRUE if there was one. */
+static Dwarf_Bool
+json_reject_noform_options(void)
+{
+    Dwarf_Bool found = FALSE;
+    int k = 0;
+
+    for (k = 0; json_noform[k].jn_flag; ++k) {
+        if (!*json_noform[k].jn_flag) {
+            continue;
+        }
+        if (json_noform[k].jn_in_all && print_all_selected) {
+            continue;
+        }
+        printf("--format-json has no JSON form for %s.\n",
+            json_noform[k].jn_option);
+        found = TRUE;
+    }
+    return found;
+}
+
+/*  --format-json runs the -i, -l, -f and -F walkers with
+    text printing off (as -Q does) and they write JSON
+    records instead. Options with no JSON form were
+    rejected in process_args(), what is left of the
+    default print set is turned off here. -v only
+    changes the text, so it is dropped too. */
+static void
+select_json_sections(void)
+{
+    if (!glflags.gf_info_flag && !glflags.gf_types_flag &&
+        !glflags.gf_line_flag && !glflags.gf_frame_flag &&
+        !glflags.gf_eh_frame_flag) {
+        /*  No print option (or only, say, -x name=):
+            the default set. */
+        glflags.gf_info_flag = TRUE;
+        glflags.gf_types_flag = TRUE;
+        glflags.gf_line_flag = TRUE;
+        glflags.gf_frame_flag = TRUE;
+    }
+    glflags.gf_do_print_dwarf = FALSE;
+    glflags.verbose = 0;
+    glflags.gf_pubnames_flag = FALSE;
+    glflags.gf_macinfo_flag = FALSE;
+    glflags.gf_macro_flag = FALSE;
+    glflags.gf_aranges_flag = FALSE;
+    glflags.gf_ranges_flag = FALSE;
+    glflags.gf_string_flag = FALSE;
+    glflags.gf_abbrev_flag = FALSE;
+    glflags.gf_loc_flag = FALSE;
+    glflags.gf_reloc_flag = FALSE;
+    glflags.gf_static_func_flag = FALSE;
+    glflags.gf_static_var_flag = FALSE;
+    glflags.gf_pubtypes_flag = FALSE;
+    glflags.gf_weakname_flag = FALSE;
+    glflags.gf_gdbindex_flag = FALSE;
+    glflags.gf_debug_addr_flag = FALSE;
+    glflags.gf_debug_names_flag = FALSE;
+    glflags.gf_debug_sup_flag = FALSE;
+    glflags.gf_debug_gnu_flag = FALSE;
+    glflags.gf_gnu_debuglink_flag = FALSE;
+    glflags.gf_print_raw_loclists = FALSE;
+    glflags.gf_print_raw_rnglists = FALSE;
+    glflags.gf_print_str_offsets = FALSE;
+    glflags.gf_cu_name_flag = FALSE;
+    glflags.gf_producer_children_flag = FALSE;
+    glflags.gf_print_perf_stats = FALSE;
+    glflags.gf_print_size_stats = FALSE;
+    glflags.gf_machine_arch_flag = FALSE;
+}
 /*  Option '-C' */
 void arg_format_extensions(void)
 {
@@ -1722,6 +1888,30 @@ void arg_file_output(void)
     }
 }
 
+/*  Option '--file-batch' */
+void arg_file_batch(void)
+{
+    glflags.gf_file_batch = TRUE;
+}
+
+/*  Option '--file-batch-jobs=' */
+void arg_file_batch_jobs(void)
+{
+    int jobs = 0;
+
+    if (!dwoptarg || !dwoptarg[0]) {
+        arg_usage_error = TRUE;
+        return;
+    }
+    jobs = atoi(dwoptarg);
+    if (jobs < 1) {
+        arg_usage_error = TRUE;
+        return;
+    }
+    glflags.gf_file_batch = TRUE;
+    glflags.gf_file_batch_jobs = (unsigned)jobs;
+}
+
 /*  Option '-p' */
 void arg_print_pubnames(void)
 {
@@ -2138,6 +2328,12 @@ void arg_search_print_tree(void)
     glflags.gf_display_parent_tree = TRUE;
 }
 
+/*  Option '--search-use-index' */
+void arg_search_use_index(void)
+{
+    glflags.gf_search_use_index = TRUE;
+}
+
 /*  Option '-Wc' */
 void arg_search_print_children(void)
 {
@@ -2524,6 +2720,8 @@ set_command_options(int argc, char *argv[])
         case OPT_FILE_OUTPUT: arg_file_output(); break;
         case OPT_FILE_TIED:   arg_file_tied();   break;
         case OPT_FILE_USE_NO_LIBELF: arg_file_use_no_libelf(); break;
+        case OPT_FILE_BATCH:  arg_file_batch();  break;
+        case OPT_FILE_BATCH_JOBS: arg_file_batch_jobs(); break;
 
         /* Print Output Qualifiers. */
         case OPT_FORMAT_ATTR_NAME:
@@ -2534,6 +2732,8 @@ set_command_options(int argc, char *argv[])
             arg_format_ellipsis();         break;
         case OPT_FORMAT_EXPR_OPS_JOINED:
             arg_format_expr_ops_joined(); break;
+        case OPT_FORMAT_JSON:
+            arg_format_json();             break;
         case OPT_FORMAT_EXTENSIONS:
             arg_format_extensions();       break;
         case OPT_FORMAT_GLOBAL_OFFSETS:
@@ -2598,6 +2798,8 @@ set_command_options(int argc, char *argv[])
         case OPT_PRINT_STATIC_VAR:  arg_print_static_var();  break;
         case OPT_PRINT_STRINGS:     arg_print_strings();     break;
         case OPT_PRINT_STR_OFFSETS: arg_print_str_offsets(); break;
+        case OPT_PRINT_PERF_STATS:  arg_print_perf_stats(); break;
+        case OPT_PRINT_SIZE_STATS:  arg_print_size_stats(); break;
         case OPT_PRINT_TYPE:        arg_print_types();       break;
         case OPT_PRINT_WEAKNAME:    arg_print_weaknames();   break;
 
@@ -2621,6 +2823,7 @@ set_command_options(int argc, char *argv[])
         case OPT_SEARCH_PRINT_PARENT:   arg_search_print_parent();
             break;
         case OPT_SEARCH_PRINT_TREE:     arg_search_print_tree();break;
+        case OPT_SEARCH_USE_INDEX:      arg_search_use_index();break;
         case OPT_SEARCH_REGEX:          arg_search_regex();break;
         case OPT_SEARCH_REGEX_COUNT:    arg_search_regex_count();
             break;
@@ -2673,6 +2876,8 @@ static const char *simplestdargs[] ={
 "--suppress-de-alloc-tree",
 "--suppress-debuglink-crc",
 "--no-follow-debuglink",
+"--file-batch",
+"--format-json",
 0
 };
 
@@ -2696,6 +2901,9 @@ lacking_normal_args (int argct,char **args)
                 break;
             }
         }
+        if (!simple && !strncmp(curarg,"--file-batch-jobs=",18)) {
+            simple = TRUE;
+        }
         if (simple) {
             continue;
         }
@@ -2764,6 +2972,16 @@ process_args(int argc, char *argv[])
             /* FOUND_ABI_START nothing to do. */
         }
     }
+    if (glflags.gf_format_json &&
+        (glflags.gf_do_check_dwarf || glflags.gf_search_is_on)) {
+        printf("--format-json cannot be combined with "
+            "checking (-k) or searching (-S).\n");
+        arg_usage_error = TRUE;
+    }
+    if (glflags.gf_format_json && json_reject_noform_options()) {
+        printf("--format-json only writes -i, -l, -f and -F.\n");
+        arg_usage_error = TRUE;
+    }
     if (arg_usage_error ) {
         printf("%s option error.\n",glflags.program_name);
         printf("To see the options list: %s -h\n",
@@ -2772,7 +2990,21 @@ process_args(int argc, char *argv[])
         global_destructors();
         exit(EXIT_FAILURE);
     }
-    if (dwoptind < (argc - 1)) {
+    if (glflags.gf_file_batch) {
+        int i = dwoptind;
+
+        for ( ; i < argc; ++i) {
+            batch_add_file(do_uri_translation(argv[i],
+                "file-to-process"));
+        }
+        if (!batch_file_count()) {
+            printf("No object file name provided to %s\n",
+                glflags.program_name);
+            makename_destructor();
+            global_destructors();
+            exit(EXIT_FAILURE);
+        }
+    } else if (dwoptind < (argc - 1)) {
         printf("Multiple apparent object file names "
             "provided to %s\n",glflags.program_name);
         printf("Only a single object name is allowed\n");
@@ -2822,5 +3054,11 @@ process_args(int argc, char *argv[])
             (checking means checking-only). */
         glflags.verbose = 1;
     }
+    if (glflags.gf_format_json) {
+        select_json_sections();
+    }
+    if (glflags.gf_file_batch) {
+        return batch_first_file();
+    }
     return do_uri_translation(argv[dwoptind],"file-to-process");
 }
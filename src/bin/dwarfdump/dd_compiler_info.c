@@ -29,7 +29,7 @@
 #include <stddef.h> /* NULL */
 #include <stdio.h>  /* stdout fprintf() printf() */
 #include <stdlib.h> /* exit() free() malloc() qsort() */
-#include <string.h> /* memset() strcmp() stricmp()
+#include <string.h> /* memcpy() memset() strcmp() stricmp()
     strlen() strncmp() */
 
 /* Windows specific header files */
@@ -321,6 +321,40 @@ update_compiler_target(const char *producer_name)
     }
 }
 
+/*  The compilers_detected index of the producer given
+    to the latest update_compiler_target(), or 0 if the
+    table was full and the producer is not in it. */
+int
+current_compiler_index(void)
+{
+    const char *name = 0;
+
+    if (current_compiler < 1) {
+        return 0;
+    }
+    name = compilers_detected[current_compiler].name;
+    if (!name ||
+#if _WIN32
+        stricmp(name,glflags.CU_producer)
+#else
+        strcmp(name,glflags.CU_producer)
+#endif /* _WIN32 */
+        ) {
+        return 0;
+    }
+    return current_compiler;
+}
+
+/*  Returns NULL for an index not in use. */
+const char *
+compiler_name_by_index(int index)
+{
+    if (index < 1 || index > compilers_detected_count) {
+        return 0;
+    }
+    return compilers_detected[index].name;
+}
+
 void
 clean_up_compilers_detected(void)
 {
@@ -489,6 +523,28 @@ print_checks_results(void)
     fflush(stdout);
 }
 
+/*  Copies the all-compilers totals (LAST_CATEGORY
+    entries) so a batch worker can hand them back
+    before clean_up_compilers_detected() clears them. */
+void
+get_check_totals(Dwarf_Check_Result *totals)
+{
+    memcpy(totals,compilers_detected[0].results,
+        sizeof(compilers_detected[0].results));
+}
+
+/*  Prints totals summed over the files of a batch
+    in the same layout as the per-file summary. */
+void
+print_check_totals(Dwarf_Check_Result *totals)
+{
+    Compiler c;
+
+    memset(&c,0,sizeof(c));
+    memcpy(c.results,totals,sizeof(c.results));
+    print_specific_checks_results(&c);
+}
+
 void DWARF_CHECK_COUNT(Dwarf_Check_Categories category, int inc)
 {
     Compiler * c = 0;
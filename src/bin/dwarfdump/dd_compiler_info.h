@@ -59,6 +59,9 @@ typedef struct {
 extern void clean_up_compilers_detected(void);
 extern void reset_compiler_entry(Compiler *compiler);
 extern void print_checks_results(void);
+/*  Totals across all compilers, for --file-batch. */
+extern void get_check_totals(Dwarf_Check_Result *totals);
+extern void print_check_totals(Dwarf_Check_Result *totals);
 extern Dwarf_Bool record_producer(char *name);
 
 #ifdef __cplusplus
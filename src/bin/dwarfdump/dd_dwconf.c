@@ -53,6 +53,7 @@ Portions Copyright 2012 SN Systems Ltd. All rights reserved.
 #include "dd_canonical_append.h"
 #include "dd_makename.h"
 #include "dd_sanitized.h"
+#include "dd_output.h"
 #include "dd_esb.h"
 #include "dd_safe_strcpy.h"
 
@@ -392,8 +393,10 @@ find_a_file(const char *named_file,
     if (lname && (strlen(lname) > 0)) {
         /*  Name given, just assume it is fully correct,
             try no other. */
-        printf("dwarfdump looking for"
-            " configuration as \"%s\"\n", lname);
+        if (!glflags.gf_format_json) {
+            printf("dwarfdump looking for"
+                " configuration as \"%s\"\n", lname);
+        }
         fin = fopen(lname, type);
         if (fin) {
             *name_used = makename(lname);
@@ -1475,30 +1478,32 @@ print_reg_from_config_data(Dwarf_Unsigned reg,
 {
     char *name = 0;
     if (reg == config_data->cf_cfa_reg) {
-        fputs("cfa",stdout);
+        dd_out_string("cfa");
         return;
     }
     if (reg == config_data->cf_undefined_val) {
-        fputs("u",stdout);
+        dd_out_char('u');
         return;
     }
     if (reg == config_data->cf_same_val) {
-        fputs("s",stdout);
+        dd_out_char('s');
         return;
     }
 
     if (config_data->cf_regs == 0 ||
         reg >= config_data->cf_named_regs_table_size) {
-        printf("r%" DW_PR_DUu "",reg);
+        dd_out_char('r');
+        dd_out_udec(reg,0);
         return;
     }
     name = config_data->cf_regs[reg];
     if (!name) {
         /* Can happen, the reg names table can be sparse. */
-        printf("r%" DW_PR_DUu "", reg);
+        dd_out_char('r');
+        dd_out_udec(reg,0);
         return;
     }
-    fputs(name,stdout);
+    dd_out_string(name);
     return;
 }
 
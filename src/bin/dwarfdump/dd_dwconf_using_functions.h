@@ -33,9 +33,10 @@ Portions Copyright 2012-2018 SN Systems Ltd. All rights reserved.
 extern "C" {
 #endif
 
+struct Addr_Name_Table;
 int print_frames (Dwarf_Debug dbg,int want_eh,
     struct dwconf_s *, Dwarf_Die *,
-    void **, void **,Dwarf_Error *);
+    struct Addr_Name_Table *, void **,Dwarf_Error *);
 void printreg(Dwarf_Unsigned reg,struct dwconf_s *config_data);
 
 #ifdef __cplusplus
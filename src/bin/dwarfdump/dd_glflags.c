@@ -155,6 +155,8 @@ init_global_flags(void)
     glflags.gf_do_print_uri_in_input = TRUE;
 
     glflags.gf_machine_arch_flag = FALSE;
+    glflags.gf_print_perf_stats = FALSE;
+    glflags.gf_print_size_stats = FALSE;
 
     glflags.gf_print_unique_errors = FALSE;
     glflags.gf_found_error_message = FALSE;
@@ -210,6 +212,10 @@ init_global_flags(void)
     /* -S option: strings for 'any' and 'match' */
     glflags.gf_search_is_on         = FALSE;
     glflags.gf_search_print_results = FALSE;
+    glflags.gf_search_use_index     = FALSE;
+    glflags.gf_format_json          = FALSE;
+    glflags.gf_file_batch           = FALSE;
+    glflags.gf_file_batch_jobs      = 0;
     glflags.gf_cu_name_flag         = FALSE;
     glflags.gf_show_global_offsets  = FALSE;
     glflags.gf_display_offsets      = TRUE;
@@ -256,15 +256,29 @@ struct glflags_s {
     Dwarf_Bool gf_search_is_on;
 
     Dwarf_Bool gf_search_print_results;
+    /*  --search-use-index: only walk CUs the name
+        indexes list as having a matching name. */
+    Dwarf_Bool gf_search_use_index;
     Dwarf_Bool gf_cu_name_flag;
     Dwarf_Bool gf_show_global_offsets;
     Dwarf_Bool gf_display_offsets;
     Dwarf_Bool gf_print_str_offsets;
+    Dwarf_Bool gf_print_perf_stats;
+    Dwarf_Bool gf_print_size_stats;
     Dwarf_Bool gf_machine_arch_flag;
     Dwarf_Bool gf_expr_ops_joined;
     Dwarf_Bool gf_print_raw_rnglists;
     Dwarf_Bool gf_print_raw_loclists;
 
+    /*  --format-json: JSON Lines records instead of text
+        for -i, -l, -f and -F. */
+    Dwarf_Bool gf_format_json;
+
+    /*  --file-batch: several object files, each dumped
+        by its own worker process. */
+    Dwarf_Bool gf_file_batch;
+    unsigned   gf_file_batch_jobs;
+
     unsigned long gf_count_major_errors;
     unsigned long gf_count_macronotes;
 
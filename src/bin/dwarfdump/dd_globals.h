@@ -192,6 +192,8 @@ extern int print_one_die(
 /* Check for specific compiler */
 extern Dwarf_Bool checking_this_compiler(void);
 extern void update_compiler_target(const char *producer_name);
+extern int current_compiler_index(void);
+extern const char *compiler_name_by_index(int index);
 extern void add_cu_name_compiler_target(char *name);
 
 /*  General error reporting routines. These were
@@ -216,11 +218,12 @@ void ranges_esb_string_destructor(void);
 void global_destructors(void);
 void destruct_abbrev_array(void);
 
+struct Addr_Name_Table;
 int get_proc_name_by_die(Dwarf_Debug dbg,
     Dwarf_Die die, Dwarf_Addr low_pc,
     struct esb_s *proc_name,
     Dwarf_Die *cu_die_for_print_frames,
-    void **pcMap,
+    struct Addr_Name_Table *pcMap,
     Dwarf_Error *err);
 
 extern void dump_block(char *prefix, char *data, Dwarf_Signed len);
@@ -258,6 +261,59 @@ int legal_tag_tree_combination(Dwarf_Half parent_tag,
     Dwarf_Half child_tag);
 
 int print_str_offsets_section(Dwarf_Debug dbg,Dwarf_Error *);
+int print_perf_stats(Dwarf_Debug dbg,Dwarf_Error *);
+int print_size_stats(Dwarf_Debug dbg,Dwarf_Error *);
+
+void search_index_prepare(Dwarf_Debug dbg);
+Dwarf_Bool search_index_skip_cu(Dwarf_Off cu_die_goff);
+void search_index_print_strategy(void);
+void search_index_destroy(void);
+
+/*  print_json.c: --format-json records, written
+    from the print_die.c, print_lines.c and
+    print_frames.c walkers. */
+void print_json_cu(const char *secname, Dwarf_Off cu_off,
+    Dwarf_Half version, Dwarf_Half unit_type,
+    Dwarf_Half address_size, Dwarf_Unsigned abbrev_offset,
+    Dwarf_Sig8 *signature);
+void print_json_die_begin(Dwarf_Off offset, int depth,
+    Dwarf_Half tag);
+void print_json_die_attr(Dwarf_Debug dbg, Dwarf_Attribute attr,
+    Dwarf_Half attrnum, Dwarf_Half form,
+    enum Dwarf_Form_Class fc, Dwarf_Bool is_signed,
+    const char *text, const char *extra);
+void print_json_die_end(void);
+void print_json_line_file(Dwarf_Off cu_off, Dwarf_Signed index,
+    const char *name);
+void print_json_line(Dwarf_Off cu_off, Dwarf_Addr address,
+    Dwarf_Unsigned file, Dwarf_Unsigned line,
+    Dwarf_Unsigned column, Dwarf_Bool is_stmt,
+    Dwarf_Bool end_sequence);
+void print_json_cie(const char *secname, Dwarf_Off offset,
+    unsigned version, const char *augmentation,
+    Dwarf_Unsigned code_align, Dwarf_Signed data_align,
+    Dwarf_Unsigned ra_reg,
+    Dwarf_Small *instrs, Dwarf_Unsigned instrs_len);
+void print_json_fde(const char *secname, Dwarf_Off offset,
+    Dwarf_Off cie_offset, Dwarf_Addr low_pc,
+    Dwarf_Unsigned length, const char *name);
+void print_json_frame_rule(Dwarf_Off fde_offset, Dwarf_Addr pc,
+    Dwarf_Bool is_cfa, Dwarf_Unsigned column,
+    Dwarf_Small value_type, Dwarf_Unsigned reg,
+    Dwarf_Bool offset_relevant, Dwarf_Signed offset,
+    Dwarf_Block *block);
+void print_json_batch_file(unsigned index, unsigned count,
+    const char *path);
+void print_json_batch_summary(unsigned dumped, unsigned failed);
+
+/*  dd_batch.c: --file-batch */
+void batch_add_file(const char *path);
+unsigned batch_file_count(void);
+const char *batch_first_file(void);
+int  batch_run(void (*dump_one)(const char *path));
+void batch_record_results(void);
+void batch_destructor(void);
+unsigned batch_default_jobs(void);
 
 void print_any_harmless_errors(Dwarf_Debug dbg);
 
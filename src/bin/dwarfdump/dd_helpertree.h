@@ -27,14 +27,17 @@
 #ifndef HELPERTREE_H
 #define HELPERTREE_H
 
-/*  This is a tsearch tree  interface we may use in various ways
+/*  This is a map from DIE offset to a value
+    we may use in various ways
     where each different sort of use is a different
-    Helpertree_Base_s instance. */
+    Helpertree_Base_s instance.
+    It is a Dd_Hash_Map_s, so include dd_map.h first.
+    The name is from when it was a tsearch tree. */
 
 /*  We create Helpertree_Base_s so we can use type-checked calls,
-    not showing the tsearch void* outside of helpertree.c. */
+    not showing the map outside of helpertree.c. */
 struct Helpertree_Base_s {
-    void * hb_base;
+    struct Dd_Hash_Map_s hb_map;
 };
 
 /* For .debug_info  */
@@ -62,7 +65,8 @@ helpertree_add_entry( Dwarf_Unsigned offset, int  val,
     struct Helpertree_Base_s *helper);
 
 /*  Look for entry. Use hm_val (if non-null return)
-    to determine signedness. */
+    to determine signedness. A returned entry is only
+    valid until the next helpertree_add_entry(). */
 struct Helpertree_Map_Entry_s *
 helpertree_find(Dwarf_Unsigned offset,
     struct Helpertree_Base_s *helper);
@@ -0,0 +1,215 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  String interning for dwarfdump.
+    See dd_intern.h. */
+
+#include <config.h>
+
+#include <stddef.h> /* size_t */
+#include <stdlib.h> /* free() malloc() */
+#include <string.h> /* memcmp() memcpy() memset() */
+
+#ifdef HAVE_STDINT_H
+#include <stdint.h> /* uintptr_t */
+#endif /* HAVE_STDINT_H */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "dd_map.h"
+#include "dd_intern.h"
+#include "libdwarf_private.h" /* TRUE FALSE */
+
+#define INTERN_CHUNK_SIZE (64*1024)
+/*  Every node starts on this boundary. */
+#define INTERN_ALIGN 8
+#define INTERN_ROUNDUP(n) (((n) + INTERN_ALIGN - 1) & \
+    ~(Dwarf_Unsigned)(INTERN_ALIGN - 1))
+
+struct Dd_Intern_Chunk_s {
+    struct Dd_Intern_Chunk_s *ic_next;
+};
+#define CHUNK_HEADER_SIZE \
+    INTERN_ROUNDUP(sizeof(struct Dd_Intern_Chunk_s))
+
+/*  A stored string: the node, then the text and NUL.
+    Strings whose hashes are equal are chained. */
+struct Dd_Intern_Node_s {
+    struct Dd_Intern_Node_s *in_next;
+    Dwarf_Unsigned           in_len;
+};
+#define NODE_HEADER_SIZE \
+    INTERN_ROUNDUP(sizeof(struct Dd_Intern_Node_s))
+#define NODE_TEXT(n) ((char *)(n) + NODE_HEADER_SIZE)
+
+struct Hash_Entry_s {
+    Dwarf_Unsigned           he_hash;
+    struct Dd_Intern_Node_s *he_first;
+};
+struct Location_Entry_s {
+    Dwarf_Unsigned  le_location;
+    const char     *le_string;
+};
+
+/*  FNV-1a, also returning the length. */
+static Dwarf_Unsigned
+intern_hash(const char *s, Dwarf_Unsigned *len_out)
+{
+    const unsigned char *p = (const unsigned char *)s;
+    Dwarf_Unsigned h = ((Dwarf_Unsigned)0xcbf29ce4 << 32) |
+        0x84222325;
+    Dwarf_Unsigned prime = ((Dwarf_Unsigned)0x100 << 32) |
+        0x1b3;
+
+    for ( ; *p; ++p) {
+        h ^= *p;
+        h *= prime;
+    }
+    *len_out = (Dwarf_Unsigned)(p - (const unsigned char *)s);
+    return h;
+}
+
+static void *
+intern_alloc(struct Dd_Intern_s *in, Dwarf_Unsigned size)
+{
+    void *ret = 0;
+
+    size = INTERN_ROUNDUP(size);
+    if (size > in->in_left) {
+        Dwarf_Unsigned csize = INTERN_CHUNK_SIZE;
+        struct Dd_Intern_Chunk_s *c = 0;
+
+        if (size > csize - CHUNK_HEADER_SIZE) {
+            /*  A very long string gets a chunk of its own,
+                the rest of the current chunk is kept. */
+            csize = CHUNK_HEADER_SIZE + size;
+        }
+        c = (struct Dd_Intern_Chunk_s *)malloc(csize);
+        if (!c) {
+            return 0;
+        }
+        c->ic_next = in->in_chunks;
+        in->in_chunks = c;
+        if (csize != INTERN_CHUNK_SIZE) {
+            return (char *)c + CHUNK_HEADER_SIZE;
+        }
+        in->in_next = (char *)c + CHUNK_HEADER_SIZE;
+        in->in_left = csize - CHUNK_HEADER_SIZE;
+    }
+    ret = in->in_next;
+    in->in_next += size;
+    in->in_left -= size;
+    return ret;
+}
+
+const char *
+dd_intern(struct Dd_Intern_s *in, const char *s)
+{
+    Dwarf_Unsigned len = 0;
+    Dwarf_Unsigned h = 0;
+    Dwarf_Bool is_new = FALSE;
+    struct Hash_Entry_s *he = 0;
+    struct Dd_Intern_Node_s *n = 0;
+
+    if (!in->in_by_hash.hm_entry_size) {
+        dd_hash_map_init(&in->in_by_hash,
+            sizeof(struct Hash_Entry_s));
+    }
+    h = intern_hash(s,&len);
+    he = (struct Hash_Entry_s *)dd_hash_map_insert(
+        &in->in_by_hash,h,&is_new);
+    if (!he) {
+        return 0;
+    }
+    if (!is_new) {
+        for (n = he->he_first; n; n = n->in_next) {
+            if (n->in_len == len &&
+                !memcmp(NODE_TEXT(n),s,len)) {
+                return NODE_TEXT(n);
+            }
+        }
+    }
+    n = (struct Dd_Intern_Node_s *)intern_alloc(in,
+        NODE_HEADER_SIZE + len + 1);
+    if (!n) {
+        return 0;
+    }
+    n->in_len = len;
+    memcpy(NODE_TEXT(n),s,len+1);
+    /*  intern_alloc() does not touch the map, so he
+        is still valid. */
+    n->in_next = he->he_first;
+    he->he_first = n;
+    in->in_count++;
+    in->in_bytes += len+1;
+    return NODE_TEXT(n);
+}
+
+const char *
+dd_intern_section_string(struct Dd_Intern_s *in, const char *s)
+{
+    Dwarf_Bool is_new = FALSE;
+    struct Location_Entry_s *le = 0;
+    const char *ret = 0;
+
+    if (!in->in_by_location.hm_entry_size) {
+        dd_hash_map_init(&in->in_by_location,
+            sizeof(struct Location_Entry_s));
+    }
+    le = (struct Location_Entry_s *)dd_hash_map_insert(
+        &in->in_by_location,(Dwarf_Unsigned)(uintptr_t)s,&is_new);
+    if (!le) {
+        return dd_intern(in,s);
+    }
+    if (!is_new) {
+        return le->le_string;
+    }
+    /*  dd_intern() uses the other map, so le stays valid. */
+    ret = dd_intern(in,s);
+    le->le_string = ret;
+    return ret;
+}
+
+void
+dd_intern_destroy(struct Dd_Intern_s *in)
+{
+    struct Dd_Intern_Chunk_s *c = in->in_chunks;
+
+    while (c) {
+        struct Dd_Intern_Chunk_s *next = c->ic_next;
+
+        free(c);
+        c = next;
+    }
+    dd_hash_map_destroy(&in->in_by_hash);
+    dd_hash_map_destroy(&in->in_by_location);
+    memset(in,0,sizeof(*in));
+}
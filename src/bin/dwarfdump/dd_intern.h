@@ -0,0 +1,82 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef DD_INTERN_H
+#define DD_INTERN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*  String interning: each distinct string is stored
+    once, in large arena chunks, so two interned strings
+    are equal exactly when the pointers are equal and
+    there is no malloc per string.
+    Include dd_map.h before this.
+
+    dd_intern() finds a string by a hash of its text.
+    dd_intern_section_string() is for a string returned
+    by libdwarf (dwarf_formstring() and the like) that
+    lies in a loaded section such as .debug_str: such a
+    string is first looked up by where it lies in the
+    section, so a string seen again (the usual case with
+    .debug_str) is found without reading its text.
+    Those section locations are only meaningful while
+    the Dwarf_Debug is open, so use a Dd_Intern_s holding
+    section strings only with one Dwarf_Debug and destroy
+    it (or use a new one) before dwarf_finish().
+
+    A zeroed struct is ready to use.  The strings stay
+    valid until dd_intern_destroy(). */
+
+struct Dd_Intern_Chunk_s;
+
+struct Dd_Intern_s {
+    struct Dd_Hash_Map_s      in_by_hash;
+    struct Dd_Hash_Map_s      in_by_location;
+    struct Dd_Intern_Chunk_s *in_chunks;
+    char                     *in_next;
+    Dwarf_Unsigned            in_left;
+    Dwarf_Unsigned            in_count;  /* distinct strings */
+    Dwarf_Unsigned            in_bytes;  /* their length+1 */
+};
+
+/*  These return NULL only if out of memory. */
+const char * dd_intern(struct Dd_Intern_s *in, const char *s);
+const char * dd_intern_section_string(struct Dd_Intern_s *in,
+    const char *s);
+void dd_intern_destroy(struct Dd_Intern_s *in);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* DD_INTERN_H */
@@ -28,98 +28,46 @@ Portions Copyright(C) David Anderson 2016-2019. All Rights reserved.
    $Revision: 1.4 $
    $Date: 2005/11/08 21:48:42 $
 
-   This used to be elaborate stuff.
-   Now it is trivial, as duplicating names is
-   unimportant in dwarfdump (in general).
-
-   And in fact, this is only called for attributes and
-   tags etc whose true name is unknown. Not for
-   any normal case.
+   Puts strings into stable storage, one copy of
+   each distinct string.
 
 */
 
 #include <config.h>
 
-#include <stdio.h> /* free() */
-#include <stdlib.h> /* free() */
-#include <string.h> /* strcmp() strdup() */
+#include <stdio.h> /* printf() */
 
 #include "dwarf.h"
 #include "libdwarf.h"
 #include "libdwarf_private.h"
 #include "dd_globals.h"
-#include "dd_tsearchbal.h"
+#include "dd_map.h"
+#include "dd_intern.h"
 #include "dd_makename.h"
 #include "dd_minimal.h"
 
-static void * makename_data;
-#define VALTYPE char *
-
-static int
-value_compare_func(const void *l, const void *r)
-{
-    VALTYPE ml = (VALTYPE)l;
-    VALTYPE mr = (VALTYPE)r;
-    return strcmp(ml,mr);
-}
-/*  Nothing to free for the 'value' example but
-    the key itself. */
-static void
-value_node_free(void *valp)
-{
-    VALTYPE v = (VALTYPE)valp;
-    free(v);
-}
+/*  The strings are interned: one copy of each distinct
+    string, kept in large chunks, found by a hash. */
+static struct Dd_Intern_s makename_data;
 
 void
 makename_destructor(void)
 {
-    /*  Pass in root, not pointer to root */
-    dwarf_tdestroy(makename_data,value_node_free);
-    makename_data = 0;
+    dd_intern_destroy(&makename_data);
 }
 
-/*  WARNING: the tree walk functions will, if presented **tree
-    when *tree is wanted, simply find nothing. No error,
-    just bad results. So when a walk produces nothing
-    suspect a code mistake here.
-    The basic problem is void* is a terrible way to
-    pass in a pointer. But it's how tsearch was defined
-    long ago.
-
-    This function can return NULL if memory is exhausted.
-*/
-
+/*  This function returns "" if memory is exhausted. */
 char *
 makename(const char *s)
 {
-    char *newstr = 0;
-    VALTYPE re = 0;
-    void *retval = 0;
+    const char *re = 0;
     static int mnfailed = FALSE;
 
     if (!s) {
         return "";
     }
-    retval = dwarf_tfind(s,&makename_data, value_compare_func);
-    if (retval) {
-        /* We found our string, it existed already. */
-        re = *(VALTYPE *)retval;
-        return re;
-    }
-    newstr = (char *)strdup(s);
-    if (!newstr) {
-        if (!mnfailed) {
-            printf("ERROR: Out of memory to record a string"
-                "dwarfdump will not work correctly."
-                " Future errors of this type are not shown.\n");
-            dd_minimal_count_global_error();
-            mnfailed = TRUE;
-        }
-        return "";
-    }
-    retval = dwarf_tsearch(newstr,&makename_data, value_compare_func);
-    if (!retval) {
+    re = dd_intern(&makename_data,s);
+    if (!re) {
         if (!mnfailed) {
             printf("ERROR: Out of memory to record a string"
                 " in a search table. "
@@ -128,10 +76,7 @@ makename(const char *s)
             dd_minimal_count_global_error();
             mnfailed = TRUE;
         }
-        /*  Out of memory, */
-        free(newstr);
         return "";
     }
-    re = *(VALTYPE *)retval;
-    return re;
+    return (char *)re;
 }
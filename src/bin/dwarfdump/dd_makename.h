@@ -34,21 +34,18 @@ Portions Copyright 2011-2016 David Anderson. All Rights Reserved.
 
     This is for putting strings into stable storage.
 
-    Effectively an strdup() wrapper.
-
-    Rarely called.
-
-    It leaks memory, (the memory
-    is never freed) but that seems unimportant since
-    use of this is very rare.
+    Each distinct string is stored once (see dd_intern.h),
+    so equal strings from makename() have equal pointers.
+    The storage is freed by makename_destructor().
 */
 
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
 
-char * makename(const char *); /* Makes a copy of the string in
-    a malloc area.  Can never return 0. */
+char * makename(const char *); /* Returns the stored copy of
+    the string. Can never return 0. Do not alter the string,
+    it may be shared. */
 
 /*  Destroy all makename data. Do just before exit. */
 void makename_destructor(void);
@@ -0,0 +1,341 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/*  Offset and address maps for dwarfdump.
+    See dd_map.h. */
+
+#include <config.h>
+
+#include <stdlib.h> /* calloc() free() malloc() realloc() */
+#include <string.h> /* memcpy() memmove() memset() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "dd_map.h"
+#include "libdwarf_private.h" /* TRUE FALSE */
+
+#define HASH_MAP_INITIAL_SIZE 1024
+#define SORTED_MAP_INITIAL_ALLOC 256
+
+/*  The key is the first member of every entry. */
+static Dwarf_Unsigned
+entry_key(const char *entry)
+{
+    Dwarf_Unsigned key = 0;
+
+    memcpy(&key,entry,sizeof(key));
+    return key;
+}
+
+static void
+entry_init(char *entry, size_t entry_size, Dwarf_Unsigned key)
+{
+    memset(entry,0,entry_size);
+    memcpy(entry,&key,sizeof(key));
+}
+
+void
+dd_hash_map_init(struct Dd_Hash_Map_s *map,
+    size_t entry_size)
+{
+    memset(map,0,sizeof(*map));
+    map->hm_entry_size = entry_size;
+}
+
+/*  Fibonacci hashing: multiply by 2^64/phi and fold
+    the high half, where the mixing is, into the low
+    bits used. Offsets and addresses are often
+    multiples of a small power of two, which the key
+    itself would spread badly. */
+static Dwarf_Unsigned
+hash_slot(Dwarf_Unsigned key, Dwarf_Unsigned size)
+{
+    const Dwarf_Unsigned golden =
+        ((Dwarf_Unsigned)0x9e3779b9 << 32) | 0x7f4a7c15;
+    Dwarf_Unsigned h = key * golden;
+
+    h ^= h >> 32;
+    return h & (size - 1);
+}
+
+/*  Finds the slot of key, or the empty slot where
+    it would go. The table is never full. */
+static Dwarf_Unsigned
+hash_probe(struct Dd_Hash_Map_s *map, Dwarf_Unsigned key)
+{
+    Dwarf_Unsigned mask = map->hm_size - 1;
+    Dwarf_Unsigned i = hash_slot(key,map->hm_size);
+
+    while (map->hm_used[i]) {
+        if (entry_key(map->hm_entries +
+            i*map->hm_entry_size) == key) {
+            break;
+        }
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+static int
+hash_grow(struct Dd_Hash_Map_s *map)
+{
+    struct Dd_Hash_Map_s n;
+    Dwarf_Unsigned i = 0;
+
+    n = *map;
+    n.hm_size = map->hm_size? map->hm_size*2:
+        HASH_MAP_INITIAL_SIZE;
+    n.hm_entries = (char *)malloc(
+        (size_t)n.hm_size*map->hm_entry_size);
+    n.hm_used = (unsigned char *)calloc(
+        (size_t)n.hm_size,1);
+    if (!n.hm_entries || !n.hm_used) {
+        free(n.hm_entries);
+        free(n.hm_used);
+        return DW_DLV_ERROR;
+    }
+    for (i = 0; i < map->hm_size; ++i) {
+        char *old = 0;
+        Dwarf_Unsigned slot = 0;
+
+        if (!map->hm_used[i]) {
+            continue;
+        }
+        old = map->hm_entries + i*map->hm_entry_size;
+        slot = hash_probe(&n,entry_key(old));
+        memcpy(n.hm_entries + slot*n.hm_entry_size,old,
+            map->hm_entry_size);
+        n.hm_used[slot] = 1;
+    }
+    free(map->hm_entries);
+    free(map->hm_used);
+    *map = n;
+    return DW_DLV_OK;
+}
+
+void *
+dd_hash_map_insert(struct Dd_Hash_Map_s *map,
+    Dwarf_Unsigned key, Dwarf_Bool *is_new)
+{
+    Dwarf_Unsigned slot = 0;
+    char *entry = 0;
+
+    /*  Keep the load at most one half so probe
+        sequences stay short. */
+    if ((map->hm_count+1)*2 > map->hm_size) {
+        if (hash_grow(map) != DW_DLV_OK) {
+            return NULL;
+        }
+    }
+    slot = hash_probe(map,key);
+    entry = map->hm_entries + slot*map->hm_entry_size;
+    if (map->hm_used[slot]) {
+        if (is_new) {
+            *is_new = FALSE;
+        }
+        return entry;
+    }
+    map->hm_used[slot] = 1;
+    ++map->hm_count;
+    entry_init(entry,map->hm_entry_size,key);
+    if (is_new) {
+        *is_new = TRUE;
+    }
+    return entry;
+}
+
+void *
+dd_hash_map_find(struct Dd_Hash_Map_s *map,
+    Dwarf_Unsigned key)
+{
+    Dwarf_Unsigned slot = 0;
+
+    if (!map->hm_count) {
+        return NULL;
+    }
+    slot = hash_probe(map,key);
+    if (!map->hm_used[slot]) {
+        return NULL;
+    }
+    return map->hm_entries + slot*map->hm_entry_size;
+}
+
+Dwarf_Unsigned
+dd_hash_map_count(struct Dd_Hash_Map_s *map)
+{
+    return map->hm_count;
+}
+
+void
+dd_hash_map_walk(struct Dd_Hash_Map_s *map,
+    void (*visit)(void *entry, void *data), void *data)
+{
+    Dwarf_Unsigned i = 0;
+
+    for (i = 0; i < map->hm_size; ++i) {
+        if (map->hm_used[i]) {
+            visit(map->hm_entries + i*map->hm_entry_size,data);
+        }
+    }
+}
+
+void
+dd_hash_map_destroy(struct Dd_Hash_Map_s *map)
+{
+    free(map->hm_entries);
+    free(map->hm_used);
+    map->hm_entries = 0;
+    map->hm_used = 0;
+    map->hm_size = 0;
+    map->hm_count = 0;
+}
+
+void
+dd_sorted_map_init(struct Dd_Sorted_Map_s *map,
+    size_t entry_size)
+{
+    memset(map,0,sizeof(*map));
+    map->sm_entry_size = entry_size;
+}
+
+/*  Returns the index of the first entry with a key
+    not less than key (sm_count if none). */
+static Dwarf_Unsigned
+sorted_lower_bound(struct Dd_Sorted_Map_s *map,
+    Dwarf_Unsigned key)
+{
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = map->sm_count;
+
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (entry_key(map->sm_entries +
+            mid*map->sm_entry_size) < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+void *
+dd_sorted_map_insert(struct Dd_Sorted_Map_s *map,
+    Dwarf_Unsigned key, Dwarf_Bool *is_new)
+{
+    size_t esize = map->sm_entry_size;
+    Dwarf_Unsigned pos = map->sm_count;
+    char *entry = 0;
+
+    if (map->sm_count) {
+        Dwarf_Unsigned lastkey = entry_key(map->sm_entries +
+            (map->sm_count-1)*esize);
+
+        /*  Increasing keys need no search. */
+        if (key <= lastkey) {
+            pos = sorted_lower_bound(map,key);
+            entry = map->sm_entries + pos*esize;
+            if (entry_key(entry) == key) {
+                if (is_new) {
+                    *is_new = FALSE;
+                }
+                return entry;
+            }
+        }
+    }
+    if (map->sm_count >= map->sm_alloc) {
+        Dwarf_Unsigned newalloc = map->sm_alloc?
+            map->sm_alloc*2:SORTED_MAP_INITIAL_ALLOC;
+        char *newentries = (char *)realloc(map->sm_entries,
+            (size_t)newalloc*esize);
+
+        if (!newentries) {
+            return NULL;
+        }
+        map->sm_entries = newentries;
+        map->sm_alloc = newalloc;
+    }
+    entry = map->sm_entries + pos*esize;
+    if (pos < map->sm_count) {
+        memmove(entry + esize,entry,
+            (size_t)(map->sm_count - pos)*esize);
+    }
+    ++map->sm_count;
+    entry_init(entry,esize,key);
+    if (is_new) {
+        *is_new = TRUE;
+    }
+    return entry;
+}
+
+void *
+dd_sorted_map_find(struct Dd_Sorted_Map_s *map,
+    Dwarf_Unsigned key)
+{
+    Dwarf_Unsigned pos = sorted_lower_bound(map,key);
+    char *entry = 0;
+
+    if (pos >= map->sm_count) {
+        return NULL;
+    }
+    entry = map->sm_entries + pos*map->sm_entry_size;
+    if (entry_key(entry) != key) {
+        return NULL;
+    }
+    return entry;
+}
+
+Dwarf_Unsigned
+dd_sorted_map_count(struct Dd_Sorted_Map_s *map)
+{
+    return map->sm_count;
+}
+
+void *
+dd_sorted_map_entry(struct Dd_Sorted_Map_s *map,
+    Dwarf_Unsigned index)
+{
+    if (index >= map->sm_count) {
+        return NULL;
+    }
+    return map->sm_entries + index*map->sm_entry_size;
+}
+
+void
+dd_sorted_map_destroy(struct Dd_Sorted_Map_s *map)
+{
+    free(map->sm_entries);
+    map->sm_entries = 0;
+    map->sm_count = 0;
+    map->sm_alloc = 0;
+}
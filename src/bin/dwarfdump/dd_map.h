@@ -0,0 +1,106 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef DD_MAP_H
+#define DD_MAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*  Two maps from a Dwarf_Unsigned key (a section offset
+    or an address) to a caller-defined entry, in place of
+    dwarf_tsearch() where the key is a single number.
+    The entry is a struct whose first member is the
+    Dwarf_Unsigned key, and entries live in one array,
+    so there is no malloc per insert.
+
+    Dd_Hash_Map: open addressing with linear probing,
+    for keys that arrive in any order.
+    Dd_Sorted_Map: an array kept in key order, for keys
+    that arrive mostly in increasing order (appending is
+    then O(1)) and for walking in key order.
+
+    Both have the same calls. A map must be
+    zeroed or given to ..._init() before use.
+    An entry pointer returned by insert or find stays
+    valid only until the next insert. */
+
+struct Dd_Hash_Map_s {
+    char           *hm_entries;
+    unsigned char  *hm_used;
+    Dwarf_Unsigned  hm_size;  /* A power of 2, or 0 */
+    Dwarf_Unsigned  hm_count;
+    size_t          hm_entry_size;
+};
+
+struct Dd_Sorted_Map_s {
+    char           *sm_entries;
+    Dwarf_Unsigned  sm_count;
+    Dwarf_Unsigned  sm_alloc;
+    size_t          sm_entry_size;
+};
+
+void dd_hash_map_init(struct Dd_Hash_Map_s *map,
+    size_t entry_size);
+/*  Returns the entry for key, adding one with all but
+    the key zeroed if there is none, and sets *is_new
+    accordingly (is_new may be null).
+    Returns NULL if out of memory. */
+void * dd_hash_map_insert(struct Dd_Hash_Map_s *map,
+    Dwarf_Unsigned key, Dwarf_Bool *is_new);
+void * dd_hash_map_find(struct Dd_Hash_Map_s *map,
+    Dwarf_Unsigned key);
+Dwarf_Unsigned dd_hash_map_count(struct Dd_Hash_Map_s *map);
+/*  Calls visit() for every entry, in no particular
+    order. visit() must not insert into the map. */
+void dd_hash_map_walk(struct Dd_Hash_Map_s *map,
+    void (*visit)(void *entry, void *data), void *data);
+/*  Frees the entries, the map can then be used again. */
+void dd_hash_map_destroy(struct Dd_Hash_Map_s *map);
+
+void dd_sorted_map_init(struct Dd_Sorted_Map_s *map,
+    size_t entry_size);
+void * dd_sorted_map_insert(struct Dd_Sorted_Map_s *map,
+    Dwarf_Unsigned key, Dwarf_Bool *is_new);
+void * dd_sorted_map_find(struct Dd_Sorted_Map_s *map,
+    Dwarf_Unsigned key);
+Dwarf_Unsigned dd_sorted_map_count(struct Dd_Sorted_Map_s *map);
+void dd_sorted_map_destroy(struct Dd_Sorted_Map_s *map);
+/*  The entry at index (0 to count-1) in key order. */
+void * dd_sorted_map_entry(struct Dd_Sorted_Map_s *map,
+    Dwarf_Unsigned index);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* DD_MAP_H */
@@ -0,0 +1,209 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/*  The output layer for dwarfdump.
+
+    A dump of a large object is millions of short
+    printf() calls. stdout gets a large buffer, so
+    stdio empties it with one write(2) per
+    DD_OUTPUT_BUFFER_SIZE bytes rather than one per
+    few kilobytes, and the per-line fields (offsets,
+    indentation, row addresses) are formatted here by
+    hand instead of by printf's format interpreter.
+
+    Everything still goes through the stdout FILE, so
+    output of these functions, of printf() and of
+    libdwarf's printf callback stays in order. Each
+    --file-batch worker is its own process and so
+    fills its own copy of the buffer; dwarfdump has
+    no threads and stdio takes no lock that another
+    thread could contend for. */
+
+#include <config.h>
+
+#include <stdio.h>  /* fputs() fwrite() putchar() setvbuf() */
+#include <string.h> /* memset() */
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h> /* isatty() */
+#endif /* HAVE_UNISTD_H */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "dd_output.h"
+
+/*  Static: stdout may still use it while exit()
+    flushes, after every destructor has run. */
+static char dd_output_buffer[DD_OUTPUT_BUFFER_SIZE];
+
+#define DD_SPACES_LEN 64
+static const char dd_spaces[DD_SPACES_LEN+1] =
+    "                                "
+    "                                ";
+
+void
+dd_output_setup(void)
+{
+#ifdef HAVE_UNISTD_H
+    /*  On a terminal keep the line buffering stdio
+        chose, so progress shows up as it happens. */
+    if (isatty(fileno(stdout))) {
+        return;
+    }
+    setvbuf(stdout,dd_output_buffer,_IOFBF,
+        sizeof(dd_output_buffer));
+#endif /* HAVE_UNISTD_H */
+}
+
+void
+dd_out_string(const char *s)
+{
+    fputs(s,stdout);
+}
+
+void
+dd_out_char(int c)
+{
+    putchar(c);
+}
+
+void
+dd_out_spaces(int count)
+{
+    while (count > DD_SPACES_LEN) {
+        fwrite(dd_spaces,1,DD_SPACES_LEN,stdout);
+        count -= DD_SPACES_LEN;
+    }
+    if (count > 0) {
+        fwrite(dd_spaces,1,(size_t)count,stdout);
+    }
+}
+
+/*  Writes the digits of v right to left ending just
+    before end, returning a pointer to the first. */
+static char *
+format_unsigned(char *end, Dwarf_Unsigned v, unsigned base)
+{
+    static const char digits[] = "0123456789abcdef";
+    char *p = end;
+
+    do {
+        *--p = digits[v % base];
+        v /= base;
+    } while (v);
+    return p;
+}
+
+/*  Emits [prefix]digits padded to width. Zero padding
+    goes between the prefix and the digits, as printf
+    puts it between the sign and the digits. */
+static void
+emit_padded(const char *prefix, char *first, char *end,
+    int width, int pad)
+{
+    char buf[DD_NUMBUF_LEN];
+    size_t plen = strlen(prefix);
+    size_t dlen = (size_t)(end - first);
+    size_t fill = 0;
+    size_t len = 0;
+
+    if (width > 0 && (size_t)width > plen + dlen) {
+        fill = (size_t)width - plen - dlen;
+        if (fill > sizeof(buf) - plen - dlen) {
+            fill = sizeof(buf) - plen - dlen;
+        }
+    }
+    if (pad == ' ') {
+        memset(buf,' ',fill);
+        len = fill;
+        memcpy(buf+len,prefix,plen);
+        len += plen;
+    } else {
+        memcpy(buf,prefix,plen);
+        len = plen;
+        memset(buf+len,'0',fill);
+        len += fill;
+    }
+    memcpy(buf+len,first,dlen);
+    len += dlen;
+    fwrite(buf,1,len,stdout);
+}
+
+void
+dd_out_hex(Dwarf_Unsigned v, int digits)
+{
+    char buf[DD_NUMBUF_LEN];
+    char *end = buf + sizeof(buf);
+    char *first = format_unsigned(end,v,16);
+
+    /*  The 0x counts in the width here, unlike with
+        printf's # flag, so add it. */
+    emit_padded("0x",first,end,digits>0?digits+2:0,'0');
+}
+
+void
+dd_out_udec(Dwarf_Unsigned v, int width)
+{
+    char buf[DD_NUMBUF_LEN];
+    char *end = buf + sizeof(buf);
+
+    emit_padded("",format_unsigned(end,v,10),end,width,' ');
+}
+
+static void
+out_signed(Dwarf_Signed v, int width, int pad)
+{
+    char buf[DD_NUMBUF_LEN];
+    char *end = buf + sizeof(buf);
+    Dwarf_Unsigned mag = (Dwarf_Unsigned)v;
+
+    if (v < 0) {
+        /*  Correct for the most negative value too. */
+        mag = (Dwarf_Unsigned)0 - mag;
+        emit_padded("-",format_unsigned(end,mag,10),end,
+            width,pad);
+        return;
+    }
+    emit_padded("",format_unsigned(end,mag,10),end,width,pad);
+}
+
+void
+dd_out_sdec(Dwarf_Signed v, int width)
+{
+    out_signed(v,width,' ');
+}
+
+void
+dd_out_sdec_zero(Dwarf_Signed v, int width)
+{
+    out_signed(v,width,'0');
+}
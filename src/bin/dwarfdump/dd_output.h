@@ -0,0 +1,79 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef DD_OUTPUT_H
+#define DD_OUTPUT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*  All dwarfdump output goes to stdout. These write
+    to it without going through printf format parsing,
+    for the lines printed once per DIE, attribute,
+    line table row or frame row. They may be freely
+    mixed with printf(). */
+
+/*  The digit count of DW_PR_XZEROS, the usual width
+    of offsets and addresses. */
+#define DD_OUT_XZEROS 8
+
+/*  Wide enough for a 64 bit value in decimal with sign,
+    or in hex with 0x, plus generous padding. The number
+    functions never write more than this: a wider width
+    gets only the padding that fits. */
+#define DD_NUMBUF_LEN 96
+
+/*  Size of the stdout buffer set by dd_output_setup(). */
+#define DD_OUTPUT_BUFFER_SIZE (1024*1024)
+
+/*  Call before anything is printed and again after
+    stdout is reopened. */
+void dd_output_setup(void);
+
+void dd_out_string(const char *s);
+void dd_out_char(int c);
+void dd_out_spaces(int count);
+
+/*  Like printf("0x%0*" DW_PR_DUx,digits,v). */
+void dd_out_hex(Dwarf_Unsigned v, int digits);
+/*  Like printf("%*" DW_PR_DUu,width,v). */
+void dd_out_udec(Dwarf_Unsigned v, int width);
+/*  Like printf("%*" DW_PR_DSd,width,v). */
+void dd_out_sdec(Dwarf_Signed v, int width);
+/*  Like printf("%0*" DW_PR_DSd,width,v). */
+void dd_out_sdec_zero(Dwarf_Signed v, int width);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* DD_OUTPUT_H */
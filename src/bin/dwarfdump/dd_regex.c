@@ -127,6 +127,7 @@
 #include <config.h>
 
 #include <stdio.h> /* printf() */
+#include <string.h> /* memcpy() memset() strchr() strstr() */
 #include "dwarf.h"
 #include "libdwarf.h"
 #include "dd_regex.h"
@@ -142,6 +143,10 @@
     Except when using ^ or $ in the regex
     we find any matching substring.
     David Anderson.  2 September 2021.
+
+    dd_re_exec() now runs a DFA built from the nfa
+    (see "The DFA matcher" below), the nfa matcher
+    remains as dd_re_exec_nfa().
 */
 
 #ifndef DW_DLV_OK
@@ -217,6 +222,8 @@ chset(CHAR c)
     *mp++ = (x);                                         \
     }  while(0)
 
+static void dfa_build(void);
+
 static void
 resetbittab(void)
 {
@@ -422,6 +429,7 @@ dd_re_comp(const char *pat)
 #ifdef DEBUG
     symbolic("Final nfa");
 #endif /* DEBUG */
+    dfa_build();
     return DW_DLV_OK;
 }
 
@@ -448,7 +456,7 @@ static int dd_pmatch(const char *, CHAR *,char **str_out,
 */
 
 int
-dd_re_exec(char *lp)
+dd_re_exec_nfa(char *lp)
 {
     CHAR c   = 0;
     char *ep = 0;
@@ -714,6 +722,372 @@ dd_pmatch(const char *lp, CHAR *ap,char **end_ptr,
     return DW_DLV_OK;
 }
 
+/*  The DFA matcher.
+
+    dd_re_comp() also turns the nfa into a list of at
+    most DFA_MAXELEM elements, each a set of bytes
+    (from CHR, ANY or CCL) that may be a closure.
+    dd_re_exec() then runs a DFA built lazily from that
+    list, one table lookup per input byte, instead of
+    the backtracking dd_pmatch(). Patterns the DFA
+    cannot hold run dd_re_exec_nfa() as before.
+
+    The DFA accepts exactly what dd_pmatch() accepts,
+    including its peculiarities:
+    A closure that matches nothing is only accepted
+    at the end of both string and pattern, so a
+    closure is entered only if the next byte is in
+    its set (but once entered it may give back every
+    byte, including the first). A match never starts
+    at the terminating NUL of a non-empty string.
+    A CCL op uses the same 7-bit bitmap lookup, so
+    bytes over 127 test the set as byte&0177.
+    A complemented CCL accepts the terminating NUL as
+    the last element of a pattern without $.
+
+    A DFA state is a set of NFA states: E(p) means
+    element p is next, I(p) means closure p has
+    matched at least one byte. E(n) (n elements)
+    is the match.
+
+    Before the DFA runs, the longest string of
+    plain characters the pattern requires is looked
+    for with strchr()/strstr(), which rejects most
+    names without looking at them byte by byte, and
+    when the string is at a fixed distance from the
+    start of the pattern the scan starts there. */
+
+#define DFA_MAXELEM    63  /* E(0)..E(63) fit in 64 bits */
+#define DFA_MAXSTATES  256
+#define DFA_UNKNOWN    -1
+#define DFA_FULL       -2
+
+struct dfa_elem_s {
+    Dwarf_Unsigned de_set[4];  /* 256 bits, one per byte */
+    int            de_closure;
+};
+
+struct dfa_state_s {
+    Dwarf_Unsigned ds_e;     /* bit p: E(p) */
+    Dwarf_Unsigned ds_i;     /* bit p: I(p) */
+};
+
+/*  dfa_flags[] bits, kept apart from the sets
+    so the matching loop touches little memory. */
+#define DFA_MATCH  1  /* a match, with no $ */
+#define DFA_DEAD   2  /* no match can follow (with ^) */
+#define DFA_ENDOK  4  /* a match if the string ends here */
+
+static int  dfa_ok;        /* dfa usable for current pattern */
+static int  dfa_bol;
+static int  dfa_eol;
+static int  dfa_nelem;
+static int  dfa_e0_endok;  /* {E(0)} ok at end of "" */
+static struct dfa_elem_s dfa_elem[DFA_MAXELEM];
+static char dfa_lit[DFA_MAXELEM+1];
+static int  dfa_litlen;
+static int  dfa_litlead;   /* elements before dfa_lit, or -1 */
+static int  dfa_first;     /* element 0 if a plain char, or 0 */
+static int  dfa_nstates;
+static struct dfa_state_s dfa_states[DFA_MAXSTATES];
+static short dfa_next[DFA_MAXSTATES][256];
+static unsigned char dfa_flags[DFA_MAXSTATES];
+
+#define dfa_inset(e,b) \
+    ((dfa_elem[e].de_set[(b)>>6] >> ((b)&63)) & 1)
+
+static void
+dfa_setbit(struct dfa_elem_s *e,unsigned b)
+{
+    e->de_set[b>>6] |= ((Dwarf_Unsigned)1) << (b&63);
+}
+
+/*  Is E(p) accepted at the end of the string? */
+static int
+dfa_elem_endok(int p)
+{
+    if (p == dfa_nelem) {
+        return 1;
+    }
+    if (p != dfa_nelem-1 || dfa_eol) {
+        return 0;
+    }
+    /*  An empty closure, or a complemented CCL taking
+        the NUL, as the final element. */
+    return dfa_elem[p].de_closure || dfa_inset(p,0);
+}
+
+/*  Record E(q) reached before byte c is read, following
+    closures that may match nothing. */
+static void
+dfa_enter(int q,unsigned c,Dwarf_Unsigned *ne,
+    Dwarf_Unsigned *ni)
+{
+    for (;;) {
+        if (q == dfa_nelem) {
+            /* Only reached with $, the byte is too many. */
+            return;
+        }
+        if (!dfa_inset(q,c)) {
+            return;
+        }
+        if (!dfa_elem[q].de_closure) {
+            *ne |= ((Dwarf_Unsigned)1) << (q+1);
+            return;
+        }
+        *ni |= ((Dwarf_Unsigned)1) << q;
+        ++q;
+    }
+}
+
+/*  Returns the state index, DFA_FULL if there is
+    no room for a new state. */
+static int
+dfa_add_state(Dwarf_Unsigned e,Dwarf_Unsigned i)
+{
+    struct dfa_state_s *st = 0;
+    unsigned char flags = 0;
+    int k = 0;
+    int p = 0;
+
+    for (k = 0; k < dfa_nstates; ++k) {
+        if (dfa_states[k].ds_e == e && dfa_states[k].ds_i == i) {
+            return k;
+        }
+    }
+    if (dfa_nstates >= DFA_MAXSTATES) {
+        return DFA_FULL;
+    }
+    st = &dfa_states[dfa_nstates];
+    st->ds_e = e;
+    st->ds_i = i;
+    /*  Leaving a final closure needs nothing more. */
+    if (!dfa_eol && (((e >> dfa_nelem) & 1) ||
+        ((i >> (dfa_nelem-1)) & 1))) {
+        flags |= DFA_MATCH;
+    }
+    if (!e && !i) {
+        flags |= DFA_DEAD;
+    }
+    for (p = 0; p <= dfa_nelem; ++p) {
+        /*  E(0) here is the next start position, and
+            no match starts at the end of the string. */
+        if (p && ((e >> p) & 1) && dfa_elem_endok(p)) {
+            flags |= DFA_ENDOK;
+        }
+        if (p < dfa_nelem && ((i >> p) & 1) &&
+            dfa_elem_endok(p+1)) {
+            flags |= DFA_ENDOK;
+        }
+    }
+    dfa_flags[dfa_nstates] = flags;
+    for (k = 0; k < 256; ++k) {
+        dfa_next[dfa_nstates][k] = DFA_UNKNOWN;
+    }
+    return dfa_nstates++;
+}
+
+static int
+dfa_step(int s,unsigned c)
+{
+    Dwarf_Unsigned e = dfa_states[s].ds_e;
+    Dwarf_Unsigned i = dfa_states[s].ds_i;
+    Dwarf_Unsigned ne = 0;
+    Dwarf_Unsigned ni = 0;
+    int p = 0;
+    int next = 0;
+
+    for (p = 0; p < dfa_nelem; ++p) {
+        if ((e >> p) & 1) {
+            dfa_enter(p,c,&ne,&ni);
+        }
+        if ((i >> p) & 1) {
+            if (dfa_inset(p,c)) {
+                ni |= ((Dwarf_Unsigned)1) << p;
+            }
+            dfa_enter(p+1,c,&ne,&ni);
+        }
+    }
+    if (!dfa_bol) {
+        /* A match may start at the next byte too. */
+        ne |= 1;
+    }
+    next = dfa_add_state(ne,ni);
+    if (next >= 0) {
+        dfa_next[s][c] = (short)next;
+    }
+    return next;
+}
+
+static void
+dfa_build(void)
+{
+    CHAR *ap = nfa;
+    char runbuf[DFA_MAXELEM];
+    int  run = 0;
+    int  runlead = 0;
+    int  fixed = 1;
+
+    dfa_ok = 0;
+    dfa_bol = 0;
+    dfa_eol = 0;
+    dfa_nelem = 0;
+    dfa_litlen = 0;
+    dfa_litlead = -1;
+    dfa_nstates = 0;
+    memset(dfa_elem,0,sizeof(dfa_elem));
+    if (*ap == BOL) {
+        dfa_bol = 1;
+        ++ap;
+    }
+    while (*ap != END) {
+        struct dfa_elem_s *el = 0;
+        int closure = 0;
+        int chr = 0;
+        unsigned b = 0;
+
+        if (*ap == EOL) {
+            dfa_eol = 1;
+            ++ap;
+            continue;
+        }
+        if (dfa_nelem >= DFA_MAXELEM) {
+            return;
+        }
+        el = &dfa_elem[dfa_nelem];
+        if (*ap == CLO) {
+            closure = 1;
+            ++ap;
+        }
+        el->de_closure = closure;
+        switch(*ap) {
+        case CHR:
+            chr = ap[1];
+            dfa_setbit(el,chr);
+            ap += 2;
+            break;
+        case ANY:
+            for (b = 1; b < 256; ++b) {
+                dfa_setbit(el,b);
+            }
+            ++ap;
+            break;
+        case CCL:
+            /*  The same test dd_pmatch() makes on a
+                (maybe signed) char. */
+            for (b = 0; b < 256; ++b) {
+                int c = (char)b;
+
+                if (isinset(ap+1,c)) {
+                    dfa_setbit(el,b);
+                }
+            }
+            ap += 1+BITBLK;
+            break;
+        default:
+            return;
+        }
+        if (closure) {
+            ++ap; /* The END closing the closure. */
+        }
+        /*  Track the longest run of plain chars. */
+        if (!closure && chr) {
+            if (!run) {
+                runlead = fixed?dfa_nelem:-1;
+            }
+            runbuf[run++] = (char)chr;
+            if (run > dfa_litlen) {
+                dfa_litlen = run;
+                dfa_litlead = runlead;
+                memcpy(dfa_lit,runbuf,run);
+                dfa_lit[run] = 0;
+            }
+        } else {
+            run = 0;
+        }
+        if (closure) {
+            fixed = 0;
+        }
+        ++dfa_nelem;
+    }
+    if (!dfa_nelem) {
+        /*  ^ $ and ^$ alone are left to dd_re_exec_nfa(). */
+        return;
+    }
+    if (dfa_bol) {
+        /*  An anchored match fails at once when it
+            fails, looking for the literal first costs
+            more than it saves. */
+        dfa_litlen = 0;
+        dfa_litlead = -1;
+    }
+    dfa_first = 0;
+    if (!dfa_elem[0].de_closure && dfa_litlen && !dfa_litlead) {
+        dfa_first = (unsigned char)dfa_lit[0];
+    }
+    dfa_e0_endok = dfa_elem_endok(0);
+    if (dfa_add_state(1,0) != 0) {
+        return;
+    }
+    dfa_ok = 1;
+}
+
+/*  Returns DW_DLV_OK on a match, else DW_DLV_NO_ENTRY,
+    or DW_DLV_ERROR if dd_re_comp() failed. */
+int
+dd_re_exec(char *lp)
+{
+    const unsigned char *up = (const unsigned char *)lp;
+    int s = 0;
+
+    if (!dfa_ok) {
+        return dd_re_exec_nfa(lp);
+    }
+    if (!*up) {
+        return dfa_e0_endok?DW_DLV_OK:DW_DLV_NO_ENTRY;
+    }
+    if (dfa_litlen > 1 || (dfa_litlen && !dfa_first)) {
+        const char *f = 0;
+
+        if (dfa_litlen == 1) {
+            f = strchr(lp,dfa_lit[0]);
+        } else {
+            f = strstr(lp,dfa_lit);
+        }
+        if (!f) {
+            return DW_DLV_NO_ENTRY;
+        }
+        if (dfa_litlead >= 0 && f - lp > dfa_litlead) {
+            up = (const unsigned char *)f - dfa_litlead;
+        }
+    }
+    for ( ; *up; ++up) {
+        int next = 0;
+
+        if (!s && dfa_first && *up != dfa_first) {
+            /*  Nothing started, skip to where one can. */
+            up = (const unsigned char *)strchr((const char *)up,
+                dfa_first);
+            if (!up) {
+                return DW_DLV_NO_ENTRY;
+            }
+        }
+        next = dfa_next[s][*up];
+        if (next < 0) {
+            next = dfa_step(s,*up);
+            if (next == DFA_FULL) {
+                return dd_re_exec_nfa(lp);
+            }
+        }
+        s = next;
+        if (dfa_flags[s]&(DFA_MATCH|DFA_DEAD)) {
+            return (dfa_flags[s]&DFA_MATCH)?
+                DW_DLV_OK:DW_DLV_NO_ENTRY;
+        }
+    }
+    return (dfa_flags[s]&DFA_ENDOK)?DW_DLV_OK:DW_DLV_NO_ENTRY;
+}
+
 #ifdef DEBUG
 /*  symbolic - produce a symbolic dump of the nfa */
 static void
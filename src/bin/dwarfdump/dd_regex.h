@@ -20,6 +20,10 @@
 #define DD_REGEX_H
 
 int dd_re_comp(const char *);
+/*  Both return DW_DLV_OK on a match. dd_re_exec() uses
+    a DFA where it can, dd_re_exec_nfa() always runs the
+    original backtracking matcher. */
 int dd_re_exec(char *);
+int dd_re_exec_nfa(char *);
 
 #endif /* DD_REGEX_H */
@@ -43,6 +43,7 @@ extern "C" {
     an ephemeral location (only callfor printf,
     and only once per printf! */
 const char * sanitized(const char *s);
+
 void sanitized_string_destructor(void);
 extern char dwarfdump_sanitize_table[256];
 
@@ -0,0 +1,681 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  For --search-use-index: before the .debug_info walk
+    of -S match= or -S any= look the search text up in
+    the name indexes the object has (.debug_names,
+    .debug_pubnames, .debug_pubtypes, .debug_gnu_pubnames,
+    .debug_gnu_pubtypes, .gdb_index) and record the CUs
+    with a matching name. The walk then skips a CU only
+    if the indexes cover both its names and its types
+    and list no matching name for it. A CU the indexes
+    do not cover (built without -gpubnames, say) is
+    walked as usual, as is every CU for a regex search
+    or an object with no index. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* free() qsort() realloc() */
+#include <string.h> /* strcmp() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dd_globals.h"
+#include "dd_glflags.h"
+
+#define SI_DEBUG_NAMES    0x01
+#define SI_PUBNAMES       0x02
+#define SI_PUBTYPES       0x04
+#define SI_GNU_PUBNAMES   0x08
+#define SI_GNU_PUBTYPES   0x10
+#define SI_GDB_INDEX      0x20
+
+static struct si_secname_s {
+    unsigned    sn_bit;
+    const char *sn_name;
+} si_secnames[] = {
+{SI_DEBUG_NAMES,  ".debug_names"},
+{SI_PUBNAMES,     ".debug_pubnames"},
+{SI_PUBTYPES,     ".debug_pubtypes"},
+{SI_GNU_PUBNAMES, ".debug_gnu_pubnames"},
+{SI_GNU_PUBTYPES, ".debug_gnu_pubtypes"},
+{SI_GDB_INDEX,    ".gdb_index"},
+{0,0}
+};
+
+/*  A list of .debug_info CU DIE offsets, sorted and
+    without duplicates once si_active is set. */
+struct si_culist_s {
+    Dwarf_Off     *cl_offs;
+    Dwarf_Unsigned cl_count;
+    Dwarf_Unsigned cl_alloc;
+};
+
+/*  si_matched: CUs with an indexed name matching the search.
+    si_names_covered: CUs whose global names an index lists.
+    si_types_covered: CUs whose type names an index lists. */
+static struct si_culist_s si_matched;
+static struct si_culist_s si_names_covered;
+static struct si_culist_s si_types_covered;
+static Dwarf_Bool     si_active;
+static unsigned       si_sources;
+static const char    *si_fallback_reason;
+static Dwarf_Unsigned si_names_examined;
+static Dwarf_Unsigned si_cus_searched;
+static Dwarf_Unsigned si_cus_skipped;
+static Dwarf_Unsigned si_cus_not_indexed;
+
+#define SI_COVERS_NAMES 1
+#define SI_COVERS_TYPES 2
+
+/*  C++ index entries are qualified (ns::f) while the
+    DIE's DW_AT_name, which -S match= compares, is the
+    last component. Returns that component, skipping
+    any :: within template arguments (ns::g<a::b>). */
+static const char *
+si_unqualified_name(const char *name)
+{
+    const char *cp = name;
+    const char *last = name;
+    int depth = 0;
+
+    for ( ; *cp; ++cp) {
+        if (*cp == '<' || *cp == '(') {
+            ++depth;
+        } else if ((*cp == '>' || *cp == ')') && depth) {
+            --depth;
+        } else if (!depth && cp[0] == ':' && cp[1] == ':') {
+            last = cp + 2;
+            ++cp;
+        }
+    }
+    return last;
+}
+
+static Dwarf_Bool
+si_name_matches(const char *name)
+{
+    if (!name) {
+        return FALSE;
+    }
+    if (glflags.search_match_text) {
+        if (!strcmp(name,glflags.search_match_text)) {
+            return TRUE;
+        }
+        return !strcmp(si_unqualified_name(name),
+            glflags.search_match_text);
+    }
+    if (glflags.search_any_text) {
+        return is_strstrnocase(name,glflags.search_any_text);
+    }
+    return FALSE;
+}
+
+/*  Returns DW_DLV_ERROR only if out of memory. */
+static int
+si_add_cu(struct si_culist_s *l,Dwarf_Off cu_die_off)
+{
+    if (l->cl_count &&
+        l->cl_offs[l->cl_count-1] == cu_die_off) {
+        /*  Names of one CU are usually together,
+            no need to record them all. */
+        return DW_DLV_OK;
+    }
+    if (l->cl_count >= l->cl_alloc) {
+        Dwarf_Unsigned newalloc = l->cl_alloc?
+            l->cl_alloc*2:64;
+        Dwarf_Off *newoffs = (Dwarf_Off *)realloc(l->cl_offs,
+            (size_t)(newalloc*sizeof(Dwarf_Off)));
+
+        if (!newoffs) {
+            return DW_DLV_ERROR;
+        }
+        l->cl_offs = newoffs;
+        l->cl_alloc = newalloc;
+    }
+    l->cl_offs[l->cl_count++] = cu_die_off;
+    return DW_DLV_OK;
+}
+
+/*  Records that an index lists the names of kind covers
+    (SI_COVERS_NAMES, SI_COVERS_TYPES or both) for the CU
+    and, if matched, that one of them matches. */
+static int
+si_add_cu_coverage(Dwarf_Off cu_die_off,unsigned covers,
+    Dwarf_Bool matched)
+{
+    int res = DW_DLV_OK;
+
+    if (covers & SI_COVERS_NAMES) {
+        res = si_add_cu(&si_names_covered,cu_die_off);
+    }
+    if (res == DW_DLV_OK && (covers & SI_COVERS_TYPES)) {
+        res = si_add_cu(&si_types_covered,cu_die_off);
+    }
+    if (res == DW_DLV_OK && matched) {
+        res = si_add_cu(&si_matched,cu_die_off);
+    }
+    return res;
+}
+
+static int
+si_add_cu_header(Dwarf_Debug dbg,Dwarf_Unsigned cu_hdr_off,
+    unsigned covers,Dwarf_Bool matched,Dwarf_Error *err)
+{
+    Dwarf_Off cu_die_off = 0;
+    int res = 0;
+
+    res = dwarf_get_cu_die_offset_given_cu_header_offset_b(dbg,
+        cu_hdr_off,TRUE,&cu_die_off,err);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    return si_add_cu_coverage(cu_die_off,covers,matched);
+}
+
+struct si_globals_data_s {
+    unsigned    sg_covers;
+    Dwarf_Error sg_err;
+    int         sg_res;
+};
+
+static int
+si_globals_callback(Dwarf_Global glob,void *user_data)
+{
+    struct si_globals_data_s *sg =
+        (struct si_globals_data_s *)user_data;
+    char     *name = 0;
+    Dwarf_Off die_off = 0;
+    Dwarf_Off cu_die_off = 0;
+    unsigned  covers = sg->sg_covers;
+    int       res = 0;
+
+    res = dwarf_global_name_offsets(glob,&name,&die_off,
+        &cu_die_off,&sg->sg_err);
+    if (res != DW_DLV_OK) {
+        sg->sg_res = res;
+        return res;
+    }
+    ++si_names_examined;
+    if (dwarf_global_tag_number(glob)) {
+        /*  From .debug_names, which lists types
+            along with the other names. */
+        covers = SI_COVERS_NAMES | SI_COVERS_TYPES;
+    }
+    res = si_add_cu_coverage(cu_die_off,covers,
+        si_name_matches(name));
+    if (res != DW_DLV_OK) {
+        sg->sg_res = res;
+        return res;
+    }
+    return DW_DLV_OK;
+}
+
+static Dwarf_Bool
+si_have_section(Dwarf_Debug dbg,const char *secname)
+{
+    Dwarf_Addr     addr = 0;
+    Dwarf_Unsigned size = 0;
+    Dwarf_Error    err = 0;
+    int            res = 0;
+
+    res = dwarf_get_section_info_by_name(dbg,secname,
+        &addr,&size,&err);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,err);
+        return FALSE;
+    }
+    return res == DW_DLV_OK && size > 0;
+}
+
+/*  DW_GL_GLOBALS reads .debug_pubnames and .debug_names,
+    DW_GL_PUBTYPES reads .debug_pubtypes. */
+static int
+si_scan_globals(Dwarf_Debug dbg,int category,
+    Dwarf_Error *err)
+{
+    struct si_globals_data_s sg;
+    int res = 0;
+
+    sg.sg_covers = (category == DW_GL_PUBTYPES)?
+        SI_COVERS_TYPES:SI_COVERS_NAMES;
+    sg.sg_err = 0;
+    sg.sg_res = DW_DLV_OK;
+    res = dwarf_iterate_globals_by_type(dbg,category,
+        si_globals_callback,&sg,0,err);
+    if (sg.sg_res == DW_DLV_ERROR) {
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,*err);
+        }
+        *err = sg.sg_err;
+        return DW_DLV_ERROR;
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (category == DW_GL_PUBTYPES) {
+        si_sources |= SI_PUBTYPES;
+    } else {
+        if (si_have_section(dbg,".debug_pubnames")) {
+            si_sources |= SI_PUBNAMES;
+        }
+        if (si_have_section(dbg,".debug_names")) {
+            si_sources |= SI_DEBUG_NAMES;
+        }
+    }
+    return DW_DLV_OK;
+}
+
+static int
+si_scan_gnu_index(Dwarf_Debug dbg,Dwarf_Bool for_pubnames,
+    Dwarf_Error *err)
+{
+    Dwarf_Gnu_Index_Head head = 0;
+    Dwarf_Unsigned block_count = 0;
+    Dwarf_Unsigned b = 0;
+    unsigned covers = for_pubnames?
+        SI_COVERS_NAMES:SI_COVERS_TYPES;
+    int res = 0;
+
+    res = dwarf_get_gnu_index_head(dbg,for_pubnames,
+        &head,&block_count,err);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    for (b = 0; b < block_count; ++b) {
+        Dwarf_Unsigned block_length = 0;
+        Dwarf_Half     version = 0;
+        Dwarf_Unsigned cu_hdr_off = 0;
+        Dwarf_Unsigned cu_size = 0;
+        Dwarf_Unsigned entry_count = 0;
+        Dwarf_Unsigned e = 0;
+
+        res = dwarf_get_gnu_index_block(head,b,&block_length,
+            &version,&cu_hdr_off,&cu_size,&entry_count,err);
+        if (res == DW_DLV_ERROR) {
+            dwarf_gnu_index_dealloc(head);
+            return res;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            continue;
+        }
+        /*  A block covers its CU even if it has no entries. */
+        res = si_add_cu_header(dbg,cu_hdr_off,covers,
+            FALSE,err);
+        if (res == DW_DLV_ERROR) {
+            dwarf_gnu_index_dealloc(head);
+            return res;
+        }
+        for (e = 0; e < entry_count; ++e) {
+            Dwarf_Unsigned die_off = 0;
+            const char    *name = 0;
+            unsigned char  flagbyte = 0;
+            unsigned char  staticorglobal = 0;
+            unsigned char  typeofentry = 0;
+
+            res = dwarf_get_gnu_index_block_entry(head,b,e,
+                &die_off,&name,&flagbyte,&staticorglobal,
+                &typeofentry,err);
+            if (res == DW_DLV_ERROR) {
+                dwarf_gnu_index_dealloc(head);
+                return res;
+            }
+            if (res == DW_DLV_NO_ENTRY) {
+                continue;
+            }
+            ++si_names_examined;
+            if (si_name_matches(name)) {
+                res = si_add_cu_header(dbg,cu_hdr_off,covers,
+                    TRUE,err);
+                if (res == DW_DLV_ERROR) {
+                    dwarf_gnu_index_dealloc(head);
+                    return res;
+                }
+                /*  The rest of this block is the same CU. */
+                break;
+            }
+        }
+    }
+    dwarf_gnu_index_dealloc(head);
+    si_sources |= for_pubnames?SI_GNU_PUBNAMES:SI_GNU_PUBTYPES;
+    return DW_DLV_OK;
+}
+
+static int
+si_scan_gdbindex(Dwarf_Debug dbg,Dwarf_Error *err)
+{
+    Dwarf_Gdbindex gdbindex = 0;
+    Dwarf_Unsigned version = 0;
+    Dwarf_Unsigned cu_list_offset = 0;
+    Dwarf_Unsigned types_cu_list_offset = 0;
+    Dwarf_Unsigned address_area_offset = 0;
+    Dwarf_Unsigned symbol_table_offset = 0;
+    Dwarf_Unsigned constant_pool_offset = 0;
+    Dwarf_Unsigned section_size = 0;
+    const char    *section_name = 0;
+    Dwarf_Unsigned culist_len = 0;
+    Dwarf_Unsigned symtab_len = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    res = dwarf_gdbindex_header(dbg,&gdbindex,&version,
+        &cu_list_offset,&types_cu_list_offset,
+        &address_area_offset,&symbol_table_offset,
+        &constant_pool_offset,&section_size,
+        &section_name,err);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dwarf_gdbindex_culist_array(gdbindex,&culist_len,err);
+    if (res == DW_DLV_OK) {
+        res = dwarf_gdbindex_symboltable_array(gdbindex,
+            &symtab_len,err);
+    }
+    if (res != DW_DLV_OK) {
+        dwarf_dealloc_gdbindex(gdbindex);
+        return res;
+    }
+    /*  The index covers every CU in its CU list. */
+    for (i = 0; i < culist_len; ++i) {
+        Dwarf_Unsigned cu_hdr_off = 0;
+        Dwarf_Unsigned cu_length = 0;
+
+        res = dwarf_gdbindex_culist_entry(gdbindex,i,
+            &cu_hdr_off,&cu_length,err);
+        if (res == DW_DLV_OK) {
+            res = si_add_cu_header(dbg,cu_hdr_off,
+                SI_COVERS_NAMES|SI_COVERS_TYPES,FALSE,err);
+        }
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_gdbindex(gdbindex);
+            return res;
+        }
+    }
+    for (i = 0; i < symtab_len; ++i) {
+        Dwarf_Unsigned name_off = 0;
+        Dwarf_Unsigned cuvec_off = 0;
+        Dwarf_Unsigned cuvec_len = 0;
+        Dwarf_Unsigned j = 0;
+        const char    *name = 0;
+
+        res = dwarf_gdbindex_symboltable_entry(gdbindex,i,
+            &name_off,&cuvec_off,err);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_gdbindex(gdbindex);
+            return res;
+        }
+        if (res == DW_DLV_NO_ENTRY ||
+            (!name_off && !cuvec_off)) {
+            /* An empty hash slot. */
+            continue;
+        }
+        res = dwarf_gdbindex_string_by_offset(gdbindex,
+            name_off,&name,err);
+        if (res == DW_DLV_OK) {
+            ++si_names_examined;
+            if (!si_name_matches(name)) {
+                continue;
+            }
+            res = dwarf_gdbindex_cuvector_length(gdbindex,
+                cuvec_off,&cuvec_len,err);
+        }
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_gdbindex(gdbindex);
+            return res;
+        }
+        for (j = 0; res == DW_DLV_OK && j < cuvec_len; ++j) {
+            Dwarf_Unsigned field = 0;
+            Dwarf_Unsigned cu_index = 0;
+            Dwarf_Unsigned symbol_kind = 0;
+            Dwarf_Unsigned is_static = 0;
+            Dwarf_Unsigned cu_hdr_off = 0;
+            Dwarf_Unsigned cu_length = 0;
+
+            res = dwarf_gdbindex_cuvector_inner_attributes(
+                gdbindex,cuvec_off,j,&field,err);
+            if (res != DW_DLV_OK) {
+                break;
+            }
+            res = dwarf_gdbindex_cuvector_instance_expand_value(
+                gdbindex,field,&cu_index,&symbol_kind,
+                &is_static,err);
+            if (res != DW_DLV_OK) {
+                break;
+            }
+            if (cu_index >= culist_len) {
+                /*  A type unit from the types CU list,
+                    .debug_types is always walked. */
+                continue;
+            }
+            res = dwarf_gdbindex_culist_entry(gdbindex,cu_index,
+                &cu_hdr_off,&cu_length,err);
+            if (res != DW_DLV_OK) {
+                break;
+            }
+            res = si_add_cu_header(dbg,cu_hdr_off,
+                SI_COVERS_NAMES|SI_COVERS_TYPES,TRUE,err);
+        }
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_gdbindex(gdbindex);
+            return res;
+        }
+    }
+    dwarf_dealloc_gdbindex(gdbindex);
+    si_sources |= SI_GDB_INDEX;
+    return DW_DLV_OK;
+}
+
+static int
+si_compare_offs(const void *l,const void *r)
+{
+    Dwarf_Off lo = *(const Dwarf_Off *)l;
+    Dwarf_Off ro = *(const Dwarf_Off *)r;
+
+    if (lo < ro) {
+        return -1;
+    }
+    if (lo > ro) {
+        return 1;
+    }
+    return 0;
+}
+
+static void
+si_sort_unique(struct si_culist_s *l)
+{
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned out = 0;
+
+    if (!l->cl_count) {
+        return;
+    }
+    qsort(l->cl_offs,(size_t)l->cl_count,sizeof(Dwarf_Off),
+        si_compare_offs);
+    for (i = 1; i < l->cl_count; ++i) {
+        if (l->cl_offs[i] != l->cl_offs[out]) {
+            ++out;
+            l->cl_offs[out] = l->cl_offs[i];
+        }
+    }
+    l->cl_count = out+1;
+}
+
+static Dwarf_Bool
+si_has_cu(struct si_culist_s *l,Dwarf_Off cu_die_goff)
+{
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = l->cl_count;
+
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (l->cl_offs[mid] == cu_die_goff) {
+            return TRUE;
+        }
+        if (l->cl_offs[mid] < cu_die_goff) {
+            lo = mid+1;
+        } else {
+            hi = mid;
+        }
+    }
+    return FALSE;
+}
+
+static void
+si_free_list(struct si_culist_s *l)
+{
+    free(l->cl_offs);
+    l->cl_offs = 0;
+    l->cl_count = 0;
+    l->cl_alloc = 0;
+}
+
+/*  Called once per object before print_infos().
+    Decides the search strategy. Index read errors
+    are not reported here (printing the index sections
+    reports them), the search just walks every CU. */
+void
+search_index_prepare(Dwarf_Debug dbg)
+{
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    search_index_destroy();
+    if (!glflags.gf_search_use_index || !glflags.gf_search_is_on) {
+        return;
+    }
+    if (glflags.search_regex_text) {
+        si_fallback_reason = "regex needs every name";
+        return;
+    }
+    res = si_scan_globals(dbg,DW_GL_GLOBALS,&err);
+    if (res != DW_DLV_ERROR) {
+        res = si_scan_globals(dbg,DW_GL_PUBTYPES,&err);
+    }
+    if (res != DW_DLV_ERROR) {
+        res = si_scan_gnu_index(dbg,TRUE,&err);
+    }
+    if (res != DW_DLV_ERROR) {
+        res = si_scan_gnu_index(dbg,FALSE,&err);
+    }
+    if (res != DW_DLV_ERROR) {
+        res = si_scan_gdbindex(dbg,&err);
+    }
+    if (res == DW_DLV_ERROR) {
+        if (err) {
+            /*  err is not set if out of memory. */
+            dwarf_dealloc_error(dbg,err);
+        }
+        si_free_list(&si_matched);
+        si_free_list(&si_names_covered);
+        si_free_list(&si_types_covered);
+        si_sources = 0;
+        si_fallback_reason = "index unreadable";
+        return;
+    }
+    if (!si_sources) {
+        si_fallback_reason = "no name index";
+        return;
+    }
+    si_sort_unique(&si_matched);
+    si_sort_unique(&si_names_covered);
+    si_sort_unique(&si_types_covered);
+    si_active = TRUE;
+}
+
+/*  Returns TRUE if the .debug_info CU whose CU DIE is at
+    cu_die_goff has its names and types indexed and
+    no indexed name matching the search. */
+Dwarf_Bool
+search_index_skip_cu(Dwarf_Off cu_die_goff)
+{
+    if (!si_active) {
+        return FALSE;
+    }
+    if (si_has_cu(&si_matched,cu_die_goff)) {
+        ++si_cus_searched;
+        return FALSE;
+    }
+    if (!si_has_cu(&si_names_covered,cu_die_goff) ||
+        !si_has_cu(&si_types_covered,cu_die_goff)) {
+        ++si_cus_searched;
+        ++si_cus_not_indexed;
+        return FALSE;
+    }
+    ++si_cus_skipped;
+    return TRUE;
+}
+
+void
+search_index_print_strategy(void)
+{
+    int k = 0;
+
+    fflush(stdout);
+    if (!si_active) {
+        printf("Search strategy  : full DIE walk (%s)\n",
+            si_fallback_reason?si_fallback_reason:
+            "index not requested");
+        fflush(stdout);
+        return;
+    }
+    printf("Search strategy  : index of");
+    for (k = 0; si_secnames[k].sn_name; ++k) {
+        if (si_sources & si_secnames[k].sn_bit) {
+            printf(" %s",si_secnames[k].sn_name);
+        }
+    }
+    printf("\n");
+    printf("Index names read : %" DW_PR_DUu "\n",
+        si_names_examined);
+    printf("CUs searched     : %" DW_PR_DUu " of %" DW_PR_DUu "\n",
+        si_cus_searched,si_cus_searched+si_cus_skipped);
+    printf("CUs not indexed  : %" DW_PR_DUu "\n",
+        si_cus_not_indexed);
+    fflush(stdout);
+}
+
+void
+search_index_destroy(void)
+{
+    si_free_list(&si_matched);
+    si_free_list(&si_names_covered);
+    si_free_list(&si_types_covered);
+    si_active = FALSE;
+    si_sources = 0;
+    si_fallback_reason = 0;
+    si_names_examined = 0;
+    si_cus_searched = 0;
+    si_cus_skipped = 0;
+    si_cus_not_indexed = 0;
+}
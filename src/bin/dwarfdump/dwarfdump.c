@@ -72,10 +72,13 @@ Portions Copyright 2012 SN Systems Ltd. All rights reserved.
 #include "dd_dwconf.h"
 #include "dd_dwconf_using_functions.h"
 #include "dd_common.h"
+#include "dd_map.h"
+#include "dd_intern.h"
 #include "dd_helpertree.h"
 #include "dd_esb.h"                /* For flexible string buffer. */
 #include "dd_esb_using_functions.h"
 #include "dd_sanitized.h"
+#include "dd_output.h"
 #include "dd_tag_common.h"
 #include "dd_addrmap.h"
 #include "dd_attr_form.h"
@@ -175,6 +178,7 @@ global_destructors(void)
     ranges_esb_string_destructor();
     close_a_file(global_basefd);
     close_a_file(global_tiedfd);
+    batch_destructor();
 #ifdef _WIN32
     /* Close the null device used during formatting printing */
     esb_close_null_device();
@@ -294,13 +298,13 @@ void _dwarf_alloc_tree_counts(Dwarf_Unsigned *allocount,
     Dwarf_Unsigned *unused2,
     Dwarf_Unsigned *unused3);
 
-/*
-   Iterate through dwarf and print all info.
-*/
-int
-main(int argc, char *argv[])
+/*  Opens, dumps and closes one object file.
+    Errors opening the file exit() here as they
+    always have: in --file-batch mode this runs
+    in a worker process. */
+static void
+dump_one_object(const char *file_name)
 {
-    const char     *file_name = 0;
     unsigned        ftype = 0;
     unsigned        endian = 0;
     unsigned        offsetsize = 0;
@@ -312,137 +316,6 @@ main(int argc, char *argv[])
     /* path_source will be DW_PATHSOURCE_basic  */
     unsigned char   path_source = DW_PATHSOURCE_unspecified;
 
-#ifdef _WIN32
-    /*  Open the null device used during formatting printing */
-    if (!esb_open_null_device()) {
-        printf("ERROR dwarfdump: Unable to open null device.\n");
-        exit(EXIT_FAILURE);
-    }
-#endif /* _WIN32 */
-
-    /*  Global flags initialization and esb-buffers construction. */
-    init_global_flags();
-
-    set_checks_off();
-    uri_data_constructor();
-    esb_constructor(&esb_short_cu_name);
-    esb_constructor(&esb_long_cu_name);
-    esb_constructor(&dwarf_error_line);
-#ifdef _WIN32
-    /*  Often we redirect the output to a file, but we have found
-        issues due to the buffering associated with stdout.
-        Some issues were fixed just by the use of 'fflush',
-        but the main issued remained.
-        The stdout stream is buffered, so will only display
-        what's in the buffer after it reaches a newline
-        (or when it's told to).
-        We have a few options to print immediately:
-        - Print to stderr instead using fprintf.
-        - Print to stdout and flush stdout whenever
-            we need it to using fflush.
-        - We can also disable buffering on stdout by using setbuf:
-            setbuf(stdout,NULL);
-            Make stdout unbuffered; this seems to work for all cases.
-        The problem is no longer present. Now, for practical
-        purposes, there is no stderr output, all is stdout.
-        September 2018.  */
-
-    /*  Calling setbuf() with NULL argument, it turns off
-        all buffering for the specified stream.
-        Then writing to and/or reading from the stream
-        will be exactly as directed by the program.
-        But if dwarfdump is used over a network drive,
-        it shows a dramatic
-        slowdown when sending the output to a file.
-        An operation that takes
-        couple of seconds, it was taking few hours. */
-    /*  setbuf(stdout,NULL); */
-    /*  Redirect stderr to stdout. */
-    /*  No more redirect needed. We only use stdout */
-#endif /* _WIN32 */
-
-#ifdef HAVE_UTF8
-    {
-        char *langinf = 0;
-
-        setlocale(LC_CTYPE, "");
-        setlocale(LC_NUMERIC, "");
-        langinf = nl_langinfo(CODESET);
-        if (strcmp(langinf,"UTF-8") && strcmp(langinf,"UTF8")) {
-            glflags.gf_print_utf8_flag = FALSE;
-        }else {
-            glflags.gf_print_utf8_flag = TRUE;
-        }
-    }
-#endif /* HAVE_UTF8 */
-    file_name = process_args(argc, argv);
-    /*  print_version_details already done in
-        dd_command_options.c */
-    print_args(argc,argv);
-
-    /*  Redirect stdout  to an specific file */
-    if (glflags.output_file) {
-        if (NULL == freopen(glflags.output_file,"w",stdout)) {
-            printf("ERROR dwarfdump: Unable to redirect "
-                "output to '%s'\n",
-                glflags.output_file);
-            global_destructors();
-            exit(EXIT_FAILURE);
-        }
-        /* Record version and arguments in the output file */
-        print_version_details(argv[0]);
-        print_args(argc,argv);
-    }
-
-    /*  Allow the user to hide some warnings by using
-        command line options */
-    {
-        Dwarf_Cmdline_Options wcmd;
-        /* The struct has just one field!. */
-        wcmd.check_verbose_mode = glflags.gf_check_verbose_mode;
-        dwarf_record_cmdline_options(wcmd);
-    }
-    if (glflags.gf_check_functions) {
-        static const Dwarf_Signed stab[] =
-            {0,1,-1,100,-100,-10000000,10000000};
-        int i = 0;
-        int len = sizeof(stab)/sizeof(stab[0]);
-        char vbuf[100];
-
-        vbuf[0] = 0;
-        DWARF_CHECK_COUNT(check_functions_result,1);
-        for (i = 0; i < len; ++i) {
-            Dwarf_Signed basevalue = 0;
-            Dwarf_Signed decodedvalue = 0;
-            Dwarf_Unsigned silen = 0;
-            int leblen = 0;
-
-            basevalue = stab[i];
-            memset(vbuf,0,sizeof(vbuf));
-            res = dwarf_encode_signed_leb128(basevalue,
-                &leblen,
-                vbuf,(int)sizeof(vbuf));
-            if (res == DW_DLV_ERROR) {
-                DWARF_CHECK_ERROR(check_functions_result,
-                    "Got error encoding Encoding Dwarf_Signed");
-                break;
-            }
-            res = dwarf_decode_signed_leb128(
-                vbuf,&silen, &decodedvalue,
-                vbuf + sizeof(vbuf));
-            if (res == DW_DLV_ERROR) {
-                DWARF_CHECK_ERROR(check_functions_result,
-                    "Got error encoding Decoding Dwarf_Signed");
-                break;
-            }
-            if ( decodedvalue != basevalue) {
-                DWARF_CHECK_ERROR(check_functions_result,
-                    "Decode Dwarf_signed does not match"
-                    "starting value");
-                break;
-            }
-        }
-    }
     /* ======= BEGIN FINDING NAMES AND OPENING FDs ===== */
     /*  The 200+2 etc is more than suffices for the expansion that a
         MacOS dsym or a GNU debuglink might need, we hope. */
@@ -607,7 +480,6 @@ main(int argc, char *argv[])
             esb_get_string(&global_tied_file_name),
             temp_path_buf, (unsigned int)temp_path_buf_len,
             glflags.config_file_data);
-        flag_data_post_cleanup();
     } else {
         printf("ERROR Can't process %s: unhandled format\n",
             file_name);
@@ -625,9 +497,162 @@ main(int argc, char *argv[])
         to  exit(1) by using print_error() */
     check_for_major_errors();
     check_for_notes();
+    batch_record_results();
     flag_data_post_cleanup();
+}
+
+/*
+   Iterate through dwarf and print all info.
+*/
+int
+main(int argc, char *argv[])
+{
+    const char     *file_name = 0;
+    int             res = 0;
+
+#ifdef _WIN32
+    /*  Open the null device used during formatting printing */
+    if (!esb_open_null_device()) {
+        printf("ERROR dwarfdump: Unable to open null device.\n");
+        exit(EXIT_FAILURE);
+    }
+#endif /* _WIN32 */
+
+    /*  Global flags initialization and esb-buffers construction. */
+    init_global_flags();
+
+    set_checks_off();
+    uri_data_constructor();
+    esb_constructor(&esb_short_cu_name);
+    esb_constructor(&esb_long_cu_name);
+    esb_constructor(&dwarf_error_line);
+#ifdef _WIN32
+    /*  Often we redirect the output to a file, but we have found
+        issues due to the buffering associated with stdout.
+        Some issues were fixed just by the use of 'fflush',
+        but the main issued remained.
+        The stdout stream is buffered, so will only display
+        what's in the buffer after it reaches a newline
+        (or when it's told to).
+        We have a few options to print immediately:
+        - Print to stderr instead using fprintf.
+        - Print to stdout and flush stdout whenever
+            we need it to using fflush.
+        - We can also disable buffering on stdout by using setbuf:
+            setbuf(stdout,NULL);
+            Make stdout unbuffered; this seems to work for all cases.
+        The problem is no longer present. Now, for practical
+        purposes, there is no stderr output, all is stdout.
+        September 2018.  */
+
+    /*  Calling setbuf() with NULL argument, it turns off
+        all buffering for the specified stream.
+        Then writing to and/or reading from the stream
+        will be exactly as directed by the program.
+        But if dwarfdump is used over a network drive,
+        it shows a dramatic
+        slowdown when sending the output to a file.
+        An operation that takes
+        couple of seconds, it was taking few hours. */
+    /*  setbuf(stdout,NULL); */
+    /*  Redirect stderr to stdout. */
+    /*  No more redirect needed. We only use stdout */
+#endif /* _WIN32 */
+    dd_output_setup();
+
+#ifdef HAVE_UTF8
+    {
+        char *langinf = 0;
+
+        setlocale(LC_CTYPE, "");
+        setlocale(LC_NUMERIC, "");
+        langinf = nl_langinfo(CODESET);
+        if (strcmp(langinf,"UTF-8") && strcmp(langinf,"UTF8")) {
+            glflags.gf_print_utf8_flag = FALSE;
+        }else {
+            glflags.gf_print_utf8_flag = TRUE;
+        }
+    }
+#endif /* HAVE_UTF8 */
+    file_name = process_args(argc, argv);
+    /*  print_version_details already done in
+        dd_command_options.c */
+    print_args(argc,argv);
+
+    /*  Redirect stdout  to an specific file */
+    if (glflags.output_file) {
+        if (NULL == freopen(glflags.output_file,"w",stdout)) {
+            printf("ERROR dwarfdump: Unable to redirect "
+                "output to '%s'\n",
+                glflags.output_file);
+            global_destructors();
+            exit(EXIT_FAILURE);
+        }
+        /*  freopen() dropped the buffer set up earlier. */
+        dd_output_setup();
+        /* Record version and arguments in the output file */
+        print_version_details(argv[0]);
+        print_args(argc,argv);
+    }
+
+    /*  Allow the user to hide some warnings by using
+        command line options */
+    {
+        Dwarf_Cmdline_Options wcmd;
+        /* The struct has just one field!. */
+        wcmd.check_verbose_mode = glflags.gf_check_verbose_mode;
+        dwarf_record_cmdline_options(wcmd);
+    }
+    if (glflags.gf_check_functions) {
+        static const Dwarf_Signed stab[] =
+            {0,1,-1,100,-100,-10000000,10000000};
+        int i = 0;
+        int len = sizeof(stab)/sizeof(stab[0]);
+        char vbuf[100];
+
+        vbuf[0] = 0;
+        DWARF_CHECK_COUNT(check_functions_result,1);
+        for (i = 0; i < len; ++i) {
+            Dwarf_Signed basevalue = 0;
+            Dwarf_Signed decodedvalue = 0;
+            Dwarf_Unsigned silen = 0;
+            int leblen = 0;
+
+            basevalue = stab[i];
+            memset(vbuf,0,sizeof(vbuf));
+            res = dwarf_encode_signed_leb128(basevalue,
+                &leblen,
+                vbuf,(int)sizeof(vbuf));
+            if (res == DW_DLV_ERROR) {
+                DWARF_CHECK_ERROR(check_functions_result,
+                    "Got error encoding Encoding Dwarf_Signed");
+                break;
+            }
+            res = dwarf_decode_signed_leb128(
+                vbuf,&silen, &decodedvalue,
+                vbuf + sizeof(vbuf));
+            if (res == DW_DLV_ERROR) {
+                DWARF_CHECK_ERROR(check_functions_result,
+                    "Got error encoding Decoding Dwarf_Signed");
+                break;
+            }
+            if ( decodedvalue != basevalue) {
+                DWARF_CHECK_ERROR(check_functions_result,
+                    "Decode Dwarf_signed does not match"
+                    "starting value");
+                break;
+            }
+        }
+    }
+    if (glflags.gf_file_batch) {
+        /*  Each file is dumped by a worker process
+            that starts from the state set up above. */
+        res = batch_run(dump_one_object);
+        global_destructors();
+        exit(res == DW_DLV_OK?0:EXIT_FAILURE);
+    }
+    dump_one_object(file_name);
     global_destructors();
-    free(temp_path_buf);
     /*  As the tool have reached this point, it means there are
         no internal errors and we should return an OKAY condition,
         regardless if the file being processed has
@@ -1023,7 +1048,9 @@ process_one_file(
         DROP_ERROR_INSTANCE(dbg,dres,onef_err);
         return DW_DLV_NO_ENTRY;
     }
-    if (path_source == DW_PATHSOURCE_dsym) {
+    if (glflags.gf_format_json) {
+        /*  Nothing but JSON records on stdout. */
+    } else if (path_source == DW_PATHSOURCE_dsym) {
         struct esb_s homifiedname;
 
         esb_constructor(&homifiedname);
@@ -1045,7 +1072,7 @@ process_one_file(
         Dwarf_Unsigned index = 0;
         Dwarf_Unsigned count = 0;
         dres = dwarf_get_universalbinary_count(dbg,&index,&count);
-        if (dres == DW_DLV_OK) {
+        if (dres == DW_DLV_OK && !glflags.gf_format_json) {
             const char * name = "object";
             if (count != 1) {
                 name = "objects";
@@ -1204,6 +1231,7 @@ process_one_file(
         int res = 0;
 
         reset_overall_CU_error_data();
+        search_index_prepare(dbg);
         res = print_infos(dbg,TRUE,&err);
         if (res == DW_DLV_ERROR) {
             print_error_and_continue(
@@ -1378,9 +1406,11 @@ process_one_file(
         /*  These three shared .eh_frame and .debug_frame
             as they are about the DIEs, not about frames. */
         Dwarf_Die cu_die_for_print_frames = 0;
-        void *map_lowpc_to_name = 0;
+        struct Addr_Name_Table map_lowpc_to_name;
         void *lowpcSet = 0;
 
+        memset(&map_lowpc_to_name,0,sizeof(map_lowpc_to_name));
+
         reset_overall_CU_error_data();
         if (glflags.gf_frame_flag) {
             want_eh = 0;
@@ -1413,7 +1443,7 @@ process_one_file(
             }
         }
         addr_map_destroy(lowpcSet);
-        addr_map_destroy(map_lowpc_to_name);
+        addr_name_table_destroy(&map_lowpc_to_name);
         if (cu_die_for_print_frames) {
             dwarf_dealloc_die(cu_die_for_print_frames);
         }
@@ -1498,6 +1528,10 @@ process_one_file(
         /* No dwarf errors possible in this function. */
         print_search_results();
     }
+    if (glflags.gf_search_use_index && glflags.gf_search_is_on) {
+        search_index_print_strategy();
+    }
+    search_index_destroy();
 
     /*  The right time to do this is unclear. But we need to do it. */
     if (glflags.gf_check_harmless) {
@@ -1609,6 +1643,31 @@ process_one_file(
         glflags.gf_count_major_errors++;
     }
 
+    if (glflags.gf_print_size_stats) {
+        int sres = 0;
+        Dwarf_Error err = 0;
+
+        sres = print_size_stats(dbg,&err);
+        if (sres == DW_DLV_ERROR) {
+            print_error_and_continue(
+                "print size stats failed", sres, err);
+            DROP_ERROR_INSTANCE(dbg,sres,err);
+        }
+    }
+
+    if (glflags.gf_print_perf_stats) {
+        /*  Last, so the counters cover everything printed. */
+        int pres = 0;
+        Dwarf_Error err = 0;
+
+        pres = print_perf_stats(dbg,&err);
+        if (pres == DW_DLV_ERROR) {
+            print_error_and_continue(
+                "print perf stats failed", pres, err);
+            DROP_ERROR_INSTANCE(dbg,pres,err);
+        }
+    }
+
     /*  Could finish dbg first. Either order ok. */
     if (dbgtied) {
         dres = dwarf_finish(dbgtied);
@@ -1627,7 +1686,9 @@ process_one_file(
         DROP_ERROR_INSTANCE(dbg,dres,onef_err);
         dbg = 0;
     }
-    printf("\n");
+    if (!glflags.gf_format_json) {
+        printf("\n");
+    }
     destroy_attr_form_trees();
     destruct_abbrev_array();
     esb_close_null_device();
@@ -0,0 +1,45 @@
+#!/bin/sh
+#
+# This code is public domain and can be freely used or copied.
+#
+# Output format benchmark for dwarfdump.
+# Prints .debug_info, .debug_line and .debug_frame of an
+# object as text (-i -l -f) and as --format-json -i -l -f,
+# each run writing to a file, and reports for each the
+# seconds used, the output size and the rates in MB/sec
+# of object read and of output written.
+#
+# Usage: jsonbench.sh objectfile [path-to-dwarfdump]
+# The output files are left in $TMPDIR (or /tmp) as
+# jsonbench.txt and jsonbench.json.
+# Needs a date(1) that knows %N (GNU date).
+
+obj=$1
+dd=${2:-./dwarfdump}
+t=${TMPDIR:-/tmp}
+if [ ! -f "$obj" ]
+then
+  echo "Usage: jsonbench.sh objectfile [path-to-dwarfdump]"
+  exit 1
+fi
+insize=`wc -c < $obj`
+
+run() {
+  label=$1
+  out=$2
+  shift 2
+  start=`date +%s.%N`
+  $dd "$@" $obj > $out || exit 1
+  end=`date +%s.%N`
+  outsize=`wc -c < $out`
+  awk -v l="$label" -v s=$start -v e=$end -v i=$insize \
+      -v o=$outsize 'BEGIN {
+    secs = e - s;
+    if (secs <= 0) secs = 0.000001;
+    printf "%-5s %8.3f sec %10.1f MB out %8.1f MB/sec in %8.1f MB/sec out\n",
+        l, secs, o/1e6, i/1e6/secs, o/1e6/secs;
+  }'
+}
+
+run text $t/jsonbench.txt -i -l -f
+run json $t/jsonbench.json --format-json -i -l -f
@@ -50,8 +50,10 @@ Portions Copyright 2007-2021 David Anderson. All rights reserved.
 #include "dd_esb.h"                /* For flexible string buffer. */
 #include "dd_esb_using_functions.h"
 #include "dd_sanitized.h"
+#include "dd_output.h"
 #include "print_frames.h"  /* for print_expression_operations() . */
 #include "dd_macrocheck.h"
+#include "dd_map.h"
 #include "dd_helpertree.h"
 #include "dd_opscounttab.h"
 #include "dd_tag_common.h"
@@ -163,6 +165,9 @@ static void formx_signed(Dwarf_Signed s, struct esb_s *esbp);
 static int        pd_dwarf_names_print_on_error = 1;
 static int        die_stack_indent_level = 0;
 static Dwarf_Bool local_symbols_already_begun = FALSE;
+/*  Set by formxdata_print_value() when it wrote the value
+    as signed, so --format-json writes it the same way. */
+static Dwarf_Bool formx_value_signed = FALSE;
 static const Dwarf_Sig8 zerosig;
 
 #if 0
@@ -226,7 +231,7 @@ print_indent_prefix(int prespaces,int indent,int postspaces)
 {
     if (indent < glflags.gf_max_space_indent) {
         int len = prespaces+postspaces+ 2*indent;
-        printf("%*s",len," ");
+        dd_out_spaces(len);
         return;
     }
     if (prespaces) {
@@ -1295,6 +1300,14 @@ print_one_die_section(Dwarf_Debug dbg,Dwarf_Bool is_info,
                 continue;
             }
         }
+        if (is_info && glflags.gf_search_is_on &&
+            search_index_skip_cu(dieprint_cu_goffset)) {
+            /*  --search-use-index found no name here. */
+            dwarf_dealloc_die(cu_die);
+            cu_die = 0;
+            ++cu_count;
+            continue;
+        }
         fill_in_producer_name(dbg,cu_die, dieprint_cu_goffset);
         /*  Once the compiler table has been updated, see
             if we need to generate the list of CU compiled
@@ -1334,6 +1347,20 @@ print_one_die_section(Dwarf_Debug dbg,Dwarf_Bool is_info,
         }
         reset_error_reporting_globals();
 
+        if ((glflags.gf_info_flag || glflags.gf_types_flag) &&
+            glflags.gf_format_json) {
+            Dwarf_Off cu_hdr_offset = 0;
+            Dwarf_Off cu_hdr_length = 0;
+            int hdres = 0;
+
+            hdres = dwarf_die_CU_offset_range(cu_die,
+                &cu_hdr_offset,&cu_hdr_length,pod_err);
+            DROP_ERROR_INSTANCE(dbg,hdres,*pod_err);
+            print_json_cu(is_info?".debug_info":".debug_types",
+                cu_hdr_offset,version_stamp,cu_type,address_size,
+                abbrev_offset,
+                empty_signature(&signature)?0:&signature);
+        }
         if ((glflags.gf_info_flag || glflags.gf_types_flag) &&
             glflags.gf_do_print_dwarf) {
             print_cu_header_data_or_signature(cu_header_length,
@@ -1717,19 +1744,34 @@ check_sibling_off(Dwarf_Unsigned loop_iteration,
             "The offset count from dwarf_offset_list"
             " is smaller than the actual sibling count");
     } else {
-        Dwarf_Unsigned i = 0;
-        Dwarf_Off      off = 0;
+        Dwarf_Unsigned lo = 0;
+        Dwarf_Unsigned hi = sibling_off_count;
         struct esb_s m;
         Dwarf_Off check_off = glflags.DIE_section_offset;
 
-        /*  The following could use binary search as
-            the array is strictly assending values. */
-        for ( ; i < sibling_off_count; ++i) {
-            off = sibling_off_array[i];
+        /*  Normally the loop_iteration'th sibling is the
+            loop_iteration'th entry, so check that first.
+            Otherwise binary search, as the array is
+            strictly ascending values.  A linear search
+            here made checking a CU quadratic in its
+            number of top-level DIEs. */
+        if (sibling_off_array[loop_iteration] == check_off) {
+            /* Good. Found */
+            return;
+        }
+        while (lo < hi) {
+            Dwarf_Unsigned mid = lo + (hi - lo)/2;
+            Dwarf_Off      off = sibling_off_array[mid];
+
             if (check_off == off) {
                 /* Good. Found */
                 return;
             }
+            if (off < check_off) {
+                lo = mid+1;
+            } else {
+                hi = mid;
+            }
         }
         esb_constructor(&m);
         esb_append_printf_u(&m,
@@ -2664,6 +2706,10 @@ print_one_die(Dwarf_Debug dbg, Dwarf_Die die,
         print_indent_prefix(0,die_indent_level,2);
         printf("%s\n",tagname);
     }
+    if (glflags.gf_format_json && print_else_name_match &&
+        !ignore_die_stack) {
+        print_json_die_begin(overall_offset,die_indent_level,tag);
+    }
     /* Print the die */
     if (PRINTING_DIES && print_else_name_match) {
         if (!ignore_die_stack) {
@@ -2750,20 +2796,21 @@ print_one_die(Dwarf_Debug dbg, Dwarf_Die die,
                     printf(">");
                 }
             } else {
+                /*  "<%2d><0x%08x>" and, with global offsets,
+                    " GOFF=0x%08x" before the closing >. */
+                dd_out_char('<');
+                dd_out_sdec(die_indent_level,2);
+                dd_out_string("><");
+                dd_out_hex(offset,DD_OUT_XZEROS);
                 if (glflags.gf_show_global_offsets) {
-                    printf("<%2d><0x%" DW_PR_XZEROS DW_PR_DUx
-                        " GOFF=0x%" DW_PR_XZEROS DW_PR_DUx ">",
-                        die_indent_level, (Dwarf_Unsigned)offset,
-                        (Dwarf_Unsigned)overall_offset);
-                } else {
-                    printf("<%2d><0x%" DW_PR_XZEROS DW_PR_DUx ">",
-                        die_indent_level,
-                        (Dwarf_Unsigned)offset);
+                    dd_out_string(" GOFF=");
+                    dd_out_hex(overall_offset,DD_OUT_XZEROS);
                 }
+                dd_out_char('>');
 
                 /* Print using indentation */
                 print_indent_prefix(0,die_indent_level, 2);
-                printf("%s",tagname);
+                dd_out_string(tagname);
                 if (glflags.verbose) {
                     Dwarf_Off agoff = 0;
                     Dwarf_Unsigned acount = 0;
@@ -2797,7 +2844,7 @@ print_one_die(Dwarf_Debug dbg, Dwarf_Die die,
                     }
                     printf(">");
                 }
-                fputs("\n",stdout);
+                dd_out_char('\n');
             }
         }
     }
@@ -2912,6 +2959,9 @@ print_one_die(Dwarf_Debug dbg, Dwarf_Die die,
     if (atlist) {
         dealloc_local_atlist(dbg,atlist,atcnt);
     }
+    if (glflags.gf_format_json) {
+        print_json_die_end();
+    }
     if (PRINTING_DIES && glflags.dense && print_else_name_match) {
         printf("\n");
     }
@@ -4498,6 +4548,7 @@ print_attribute(Dwarf_Debug dbg, Dwarf_Die die,
 
     esb_constructor_fixed(&esb_extra,xtrabuf,sizeof(xtrabuf));
     esb_constructor_fixed(&valname,valbuf,sizeof(valbuf));
+    formx_value_signed = FALSE;
     is_info = dwarf_get_die_infotypes_flag(die);
     atname = get_AT_name(attr,pd_dwarf_names_print_on_error);
     res = get_address_size_and_max(dbg,&address_size_base,
@@ -5720,11 +5771,23 @@ print_attribute(Dwarf_Debug dbg, Dwarf_Die die,
         has so much in it.
     */
 
+    if (glflags.gf_format_json && print_else_name_match) {
+        print_json_die_attr(dbg,attrib,attr,theform,fc,
+            formx_value_signed,
+            esb_get_string(&valname),
+            append_extra_string?esb_get_string(&esb_extra):0);
+    }
     if ((PRINTING_UNIQUE && PRINTING_DIES && print_else_name_match)
         || bTextFound) {
         /*  Print just the Tags and Attributes */
         if (!glflags.gf_display_offsets) {
-            printf("%-28s\n",atname);
+            size_t atlen = strlen(atname);
+
+            dd_out_string(atname);
+            if (atlen < 28) {
+                dd_out_spaces((int)(28 - atlen));
+            }
+            dd_out_char('\n');
         } else {
             if (glflags.dense) {
                 char *v = 0;
@@ -5736,15 +5799,18 @@ print_attribute(Dwarf_Debug dbg, Dwarf_Die die,
                 }
             } else {
                 char *v = 0;
-                printf("%-28s", atname);
-                if (strlen(atname) >= 28) {
-                    printf(" ");
-                }
+                size_t atlen = strlen(atname);
+
+                /*  printf("%-28s",atname), then a space
+                    if the name filled the column. */
+                dd_out_string(atname);
+                dd_out_spaces(atlen < 28? (int)(28 - atlen):1);
                 v = esb_get_string(&valname);
-                printf("%s\n", sanitized(v));
+                dd_out_string(sanitized(v));
+                dd_out_char('\n');
                 if (append_extra_string) {
                     v = esb_get_string(&esb_extra);
-                    printf("%s", sanitized(v));
+                    dd_out_string(sanitized(v));
                 }
             }
         }
@@ -7299,6 +7365,7 @@ formxdata_print_value(Dwarf_Debug dbg,
                 } else {
                     /* Value signed. */
                     formx_signed(tempsd,esbp);
+                    formx_value_signed = TRUE;
                     return DW_DLV_OK;
                 }
             }
@@ -7315,6 +7382,7 @@ formxdata_print_value(Dwarf_Debug dbg,
         sres = dwarf_formsdata(attrib, &tempsd, pverr);
         if (sres == DW_DLV_OK) {
             formx_signed(tempsd,esbp);
+            formx_value_signed = TRUE;
             return sres;
         } else if (sres == DW_DLV_ERROR) {
             esb_append_printf_u(esbp,
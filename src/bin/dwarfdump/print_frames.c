@@ -52,6 +52,9 @@ Portions Copyright (C) 2007-2020 David Anderson. All Rights Reserved.
 #include "dd_esb.h"
 #include "dd_esb_using_functions.h"
 #include "dd_sanitized.h"
+#include "dd_output.h"
+#include "dd_map.h"
+#include "dd_intern.h"
 #include "dd_addrmap.h"
 #include "dd_naming.h"
 #include "dd_safe_strcpy.h"
@@ -67,6 +70,8 @@ Dwarf_Sig8 zero_type_signature;
 static void
 print_one_frame_reg_col(Dwarf_Debug dbg,
     Dwarf_Die die,
+    Dwarf_Off fde_offset,
+    Dwarf_Addr row_address,
     Dwarf_Unsigned rule_id,
     Dwarf_Small value_type,
     Dwarf_Unsigned reg_used,
@@ -307,7 +312,8 @@ get_abstract_origin_funcname(Dwarf_Debug dbg,
     we do not really have a sensible context, so this
     really just looks at the current attributes for a name.
 
-    From print_frames.c we do have a pcMap.
+    From print_frames.c we do have a pcMap, and every
+    subprogram name and low_pc found is added to it.
 */
 int
 get_proc_name_by_die(Dwarf_Debug dbg,
@@ -315,7 +321,7 @@ get_proc_name_by_die(Dwarf_Debug dbg,
     Dwarf_Addr low_pc,
     struct esb_s *proc_name,
     Dwarf_Die * cu_die_for_print_frames,
-    void **pcMap,
+    struct Addr_Name_Table *pcMap,
     Dwarf_Error *err)
 {
     Dwarf_Signed atcnt = 0;
@@ -327,16 +333,10 @@ get_proc_name_by_die(Dwarf_Debug dbg,
     int funcres = DW_DLV_OK;
     int funcnamefound = 0;
     int loop_ok = TRUE;
+    /*  Set when proc_name holds just a DW_AT_name string
+        that libdwarf returned from its section data. */
+    const char *name_in_section = 0;
 
-    if (pcMap) {
-        struct Addr_Map_Entry *ame = 0;
-        ame = addr_map_find(low_pc,pcMap);
-        if (ame && ame->mp_name) {
-            /* mp_name is NULL only if we ran out of heap space. */
-            esb_append(proc_name,ame->mp_name);
-            return DW_DLV_OK;
-        }
-    }
     if (glflags.gf_all_cus_seen_search_by_address) {
         return DW_DLV_NO_ENTRY;
     }
@@ -408,12 +408,16 @@ get_proc_name_by_die(Dwarf_Debug dbg,
                         "formstring in get_proc_name failed\n");
                     esb_append(proc_name,
                         "ERROR in dwarf_formstring!");
+                    name_in_section = 0;
                     dwarf_dealloc(dbg,aterr,DW_DLA_ERROR);
                     aterr = 0;
                 } else if (sres == DW_DLV_NO_ENTRY) {
                     esb_append(proc_name,
                         "NO ENTRY on dwarf_formstring?!");
+                    name_in_section = 0;
                 } else {
+                    name_in_section = esb_string_len(proc_name)?
+                        0:temps;
                     esb_append(proc_name,temps);
                 }
                 funcnamefound = 1; /* FOUND THE NAME (sort of,
@@ -458,14 +462,15 @@ get_proc_name_by_die(Dwarf_Debug dbg,
     } /* end for loop on atcnt */
     dealloc_local_atlist(dbg,atlist,atcnt);
     if (funcnamefound && funcpcfound && pcMap ) {
-        /*  Insert the name to map even if not
-            the low_pc we are looking for.
-            This version does extra work in that
-            early symbols in a CU will be inserted
-            multiple times (the extra times have no
-            effect). */
-        addr_map_insert(low_pc_for_die,esb_get_string(proc_name),
-            pcMap);
+        /*  Add the name to the table even if not
+            the low_pc we are looking for. */
+        if (name_in_section) {
+            addr_name_table_add(pcMap,low_pc_for_die,
+                name_in_section,TRUE);
+        } else {
+            addr_name_table_add(pcMap,low_pc_for_die,
+                esb_get_string(proc_name),FALSE);
+        }
     }
     if (funcnamefound == 0 || funcpcfound == 0 ||
         low_pc != low_pc_for_die) {
@@ -474,29 +479,27 @@ get_proc_name_by_die(Dwarf_Debug dbg,
     return funcres;
 }
 
-/*  Modified Depth First Search looking for the procedure:
+/*  Modified Depth First Search recording every procedure:
     a)  only looks for children of subprogram.
     b)  With subprogram looks at current die *before* looking
         for a child.
 
     Needed since some languages, including SGI MP Fortran,
     have nested functions.
-    Return 0 on failure, 1 on success.
+    Returns DW_DLV_OK or, after reporting the problem,
+    DW_DLV_ERROR.
 */
 static int
-load_nested_proc_name(Dwarf_Debug dbg, Dwarf_Die die,
-    Dwarf_Addr low_pc,
-    struct esb_s *ret_name,
+load_nested_proc_names(Dwarf_Debug dbg, Dwarf_Die die,
     Dwarf_Die *cu_die_for_print_frames,
-    void **pcMap,
+    struct Addr_Name_Table *pcMap,
     Dwarf_Error *err)
 {
     Dwarf_Die curdie = die;
     int die_locally_gotten = 0;
-    Dwarf_Die prev_child = 0;
     Dwarf_Die newchild = 0;
     Dwarf_Die newsibling = 0;
-    Dwarf_Half tag;
+    Dwarf_Half tag = 0;
     int chres = DW_DLV_OK;
     struct esb_s nestname;
 
@@ -504,110 +507,75 @@ load_nested_proc_name(Dwarf_Debug dbg, Dwarf_Die die,
     while (chres == DW_DLV_OK) {
         int tres = 0;
 
-        esb_empty_string(&nestname);
         tres = dwarf_tag(curdie, &tag, err);
-        newchild = 0;
-        if (tres == DW_DLV_OK) {
-            int lchres = 0;
-
-            if (tag == DW_TAG_subprogram) {
-                int gotit = 0;
-                Dwarf_Error locerr = 0;
-                gotit = get_proc_name_by_die(dbg, curdie, low_pc,
-                    &nestname, cu_die_for_print_frames,
-                    pcMap,&locerr);
-                if (gotit == DW_DLV_OK) {
-                    if (die_locally_gotten) {
-                        /*  If we got this die from the parent, we do
-                            not want to dealloc here! */
-                        dwarf_dealloc(dbg, curdie, DW_DLA_DIE);
-                    }
-                    esb_append(ret_name,esb_get_string(&nestname));
-                    esb_destructor(&nestname);
-                    return DW_DLV_OK;
-                }
-                if (gotit == DW_DLV_ERROR) {
-                    dwarf_dealloc(dbg,locerr,DW_DLA_ERROR);
-                    locerr = 0;
-                }
-                /* Check children of subprograms recursively should
-                    this really be check children of anything,
-                    or just children of subprograms? */
-
-                lchres = dwarf_child(curdie, &newchild, err);
-                esb_empty_string(&nestname);
-                if (lchres == DW_DLV_OK) {
-                    int newprog = 0;
-                    Dwarf_Error innererr = 0;
-                    /* look for inner subprogram */
-                    newprog = load_nested_proc_name(dbg,
-                        newchild, low_pc,
-                        &nestname,
-                        cu_die_for_print_frames,
-                        pcMap,&innererr);
-                    dwarf_dealloc(dbg, newchild, DW_DLA_DIE);
-                    if (newprog == DW_DLV_OK) {
-                        /*  Found it.  We could just take this
-                            name or we could concatenate names
-                            together. For now,
-                            just take name */
-                        if (die_locally_gotten) {
-                            /*  If we got this die from the parent,
-                                we do not want to dealloc here! */
-                            dwarf_dealloc(dbg, curdie, DW_DLA_DIE);
-                        }
-                        esb_append(ret_name,esb_get_string(
-                            &nestname));
-                        esb_destructor(&nestname);
-                        return DW_DLV_OK;
-                    } else if (newprog == DW_DLV_ERROR) {
-                        dwarf_dealloc(dbg,innererr,DW_DLA_ERROR);
-                        innererr = 0;
-                    }
-                } else if (lchres == DW_DLV_NO_ENTRY) {
-                    /* nothing to do */
-                } else {
-                    load_CU_error_data(dbg,*cu_die_for_print_frames);
-                    simple_err_only_return_action(lchres,
-                        "\nERROR:load_nested_proc_name dwarf_child()"
-                        " failed.");
-                    if (die_locally_gotten) {
-                        /*  If we got this die from the parent, we do
-                            not want to dealloc here! */
-                        dwarf_dealloc(dbg, curdie, DW_DLA_DIE);
-                    }
-                    esb_destructor(&nestname);
-                    return lchres;
-                }
-            }  /* end if TAG_subprogram */
-        } else {
-            esb_empty_string(&nestname);
+        if (tres != DW_DLV_OK) {
             if (tres == DW_DLV_ERROR)  {
                 struct esb_s m;
 
                 load_CU_error_data(dbg,*cu_die_for_print_frames);
                 esb_constructor(&m);
                 esb_append_printf_s(&m,
-                    "\nERROR: load_nested_proc_name dwarf_tag failed:"
+                    "\nERROR: load_nested_proc_names dwarf_tag failed:"
                     " trying to get proc name. "
                     "Error is %s.",dwarf_errmsg(*err));
                 simple_err_only_return_action(tres,
                     esb_get_string(&m));
                 esb_destructor(&m);
-                esb_destructor(&nestname);
-                return tres;
             }
             if (die_locally_gotten) {
-                /*  If we got this die from the parent, we do not want
-                    to dealloc here! */
                 dwarf_dealloc(dbg, curdie, DW_DLA_DIE);
             }
             esb_destructor(&nestname);
-            return DW_DLV_NO_ENTRY;
+            return tres == DW_DLV_ERROR? DW_DLV_ERROR:DW_DLV_OK;
         }
+        if (tag == DW_TAG_subprogram) {
+            int gotit = 0;
+            int lchres = 0;
+            Dwarf_Error locerr = 0;
+
+            esb_empty_string(&nestname);
+            /*  Adds the name to pcMap when it has one. */
+            gotit = get_proc_name_by_die(dbg, curdie, 0,
+                &nestname, cu_die_for_print_frames,
+                pcMap,&locerr);
+            if (gotit == DW_DLV_ERROR) {
+                dwarf_dealloc(dbg,locerr,DW_DLA_ERROR);
+                locerr = 0;
+            }
+            /* Check children of subprograms recursively should
+                this really be check children of anything,
+                or just children of subprograms? */
+            newchild = 0;
+            lchres = dwarf_child(curdie, &newchild, err);
+            if (lchres == DW_DLV_OK) {
+                int newprog = 0;
+                Dwarf_Error innererr = 0;
+
+                /* look for inner subprograms */
+                newprog = load_nested_proc_names(dbg,
+                    newchild,
+                    cu_die_for_print_frames,
+                    pcMap,&innererr);
+                dwarf_dealloc(dbg, newchild, DW_DLA_DIE);
+                if (newprog == DW_DLV_ERROR) {
+                    dwarf_dealloc(dbg,innererr,DW_DLA_ERROR);
+                    innererr = 0;
+                }
+            } else if (lchres == DW_DLV_ERROR) {
+                load_CU_error_data(dbg,*cu_die_for_print_frames);
+                simple_err_only_return_action(lchres,
+                    "\nERROR:load_nested_proc_names dwarf_child()"
+                    " failed.");
+                if (die_locally_gotten) {
+                    /*  If we got this die from the parent, we do
+                        not want to dealloc here! */
+                    dwarf_dealloc(dbg, curdie, DW_DLA_DIE);
+                }
+                esb_destructor(&nestname);
+                return lchres;
+            }
+        }  /* end if TAG_subprogram */
         /* try next sibling */
-        prev_child = curdie;
-        esb_empty_string(&nestname);
 #ifdef ORIGINAL_HEADER_API
         chres = dwarf_siblingof_b(dbg, curdie,
             dwarf_get_die_infotypes_flag(curdie),
@@ -615,6 +583,11 @@ load_nested_proc_name(Dwarf_Debug dbg, Dwarf_Die die,
 #else
         chres = dwarf_siblingof_c(curdie,&newsibling,err);
 #endif /* ORIGINAL_HEADER_API */
+        if (die_locally_gotten) {
+            /*  If we got this die from the parent, we do not want
+                to dealloc here! */
+            dwarf_dealloc(dbg, curdie, DW_DLA_DIE);
+        }
         if (chres == DW_DLV_ERROR) {
             struct esb_s m;
 
@@ -629,60 +602,29 @@ load_nested_proc_name(Dwarf_Debug dbg, Dwarf_Die die,
                 esb_get_string(&m), chres,*err);
             esb_destructor(&m);
             DROP_ERROR_INSTANCE(dbg,chres,*err);
-            if (die_locally_gotten) {
-                /*  If we got this die from the parent, we do not want
-                    to dealloc here! */
-                dwarf_dealloc(dbg, curdie, DW_DLA_DIE);
-            }
-            esb_destructor(&nestname);
-            return DW_DLV_NO_ENTRY;
-        } else if (chres == DW_DLV_NO_ENTRY) {
-            if (die_locally_gotten) {
-                /*  If we got this die from the parent, we do not want
-                    to dealloc here! */
-                dwarf_dealloc(dbg, prev_child, DW_DLA_DIE);
-                prev_child = 0;
-            }
-            /* Not there at this level */
             esb_destructor(&nestname);
-            return DW_DLV_NO_ENTRY;
+            return DW_DLV_OK;
         }
-        /* DW_DLV_OK */
+        /* DW_DLV_OK or DW_DLV_NO_ENTRY */
         curdie = newsibling;
-        if (die_locally_gotten) {
-            /*  If we got this die from the parent, we do not want
-                to dealloc here! */
-            dwarf_dealloc(dbg, prev_child, DW_DLA_DIE);
-            /*  Clearing prev_child here gets coverity 330895
-                unused value warning.
-                prev_child = 0; */
-        }
         die_locally_gotten = 1;
     }
-    if (die_locally_gotten) {
-        /*  If we got this die from the parent, we do not want to
-            dealloc here! */
-        dwarf_dealloc(dbg, curdie, DW_DLA_DIE);
-    }
     esb_destructor(&nestname);
-    return DW_DLV_NO_ENTRY;
+    return DW_DLV_OK;
 }
 
-/*  For SGI MP Fortran and other languages, functions
-    nest!  As a result, we must dig thru all functions,
-    not just the top level.
-    This remembers the CU die and restarts each search at the start
-    of  the current cu.
-    Return DW_DLV_OK means found name.
-    Return DW_DLV_NO_ENTRY means not found name.
-    Never returns DW_DLV_ERROR
+/*  Walk all the CUs once, adding every subprogram
+    (nested ones too, for SGI MP Fortran and other
+    languages where functions nest) with a name and
+    low_pc to pcMap. Then sort pcMap so each FDE
+    finds its name by binary search.
+    Leaves the last CU die in *cu_die_for_print_frames.
 */
-static int
-get_fde_proc_name_by_address(Dwarf_Debug dbg, Dwarf_Addr low_pc,
+static void
+load_all_proc_names(Dwarf_Debug dbg,
     const char *frame_section_name,
-    struct esb_s *name,
     Dwarf_Die *cu_die_for_print_frames,
-    void **pcMap,Dwarf_Error *err)
+    struct Addr_Name_Table *pcMap,Dwarf_Error *err)
 {
     Dwarf_Unsigned cu_header_length = 0;
     Dwarf_Unsigned abbrev_offset = 0;
@@ -690,9 +632,6 @@ get_fde_proc_name_by_address(Dwarf_Debug dbg, Dwarf_Addr low_pc,
     Dwarf_Half address_size = 0;
     Dwarf_Unsigned next_cu_offset = 0;
     int cures = DW_DLV_OK;
-    int dres = DW_DLV_OK;
-    int chres = DW_DLV_OK;
-    struct Addr_Map_Entry *ame = 0;
     Dwarf_Half length_size = 0;
     Dwarf_Half extension_size = 0;
     Dwarf_Sig8 type_signature;
@@ -700,122 +639,16 @@ get_fde_proc_name_by_address(Dwarf_Debug dbg, Dwarf_Addr low_pc,
     Dwarf_Half header_cu_type = 0;
     Dwarf_Bool is_info = TRUE; /* An assumption, but
         sensible as functions will not be in .debug_types */
+    Dwarf_Bool restarted = FALSE;
+    Dwarf_Unsigned cu_count = 0;
 
-    type_signature = zero_type_signature;
-    ame = addr_map_find(low_pc,pcMap);
-    if (ame && ame->mp_name) {
-        esb_append(name,ame->mp_name);
-        return DW_DLV_OK;
-    }
-    if (glflags.gf_all_cus_seen_search_by_address) {
-        return DW_DLV_NO_ENTRY;
-    }
-    if (glflags.gf_debug_addr_missing) {
-        return DW_DLV_NO_ENTRY;
-    }
-    if (*cu_die_for_print_frames == NULL) {
-        /* Call depends on dbg->cu_context to know what to do. */
-        cures = dwarf_next_cu_header_e(dbg,
-            is_info,
-            cu_die_for_print_frames,
-            &cu_header_length,
-            &version_stamp, &abbrev_offset,
-            &address_size,
-            &length_size,
-            &extension_size,
-            &type_signature,
-            &typeoffset,
-            &next_cu_offset,
-            &header_cu_type,
-            err);
-        if (cures == DW_DLV_ERROR) {
-            /*  If there is a serious error in DIE information
-                we just skip looking for a procedure name.
-                Perhaps we should report something? */
-            printf("\nERROR: Error getting next cu header "
-                "looking for a subroutine"
-                "/procedure name. Section %s. Err is %s\n",
-                sanitized(frame_section_name),
-                dwarf_errmsg(*err));
-                glflags.gf_count_major_errors++;
-            glflags.gf_all_cus_seen_search_by_address = 1;
-            DROP_ERROR_INSTANCE(dbg,cures,*err);
-            return DW_DLV_NO_ENTRY;
-        } else if (cures == DW_DLV_NO_ENTRY) {
-            /* loop thru the list again */
-            *cu_die_for_print_frames = 0;
-        } else {                /* DW_DLV_OK */
-#ifdef ORIGINAL_HEADER_API
-            dres = dwarf_siblingof_b(dbg, NULL,
-                is_info,
-                cu_die_for_print_frames,
-                err);
-            if (dres == DW_DLV_ERROR) {
-                /*  If there is a serious error in DIE information
-                    we just skip looking for a procedure name.
-                    Perhaps we should report something? */
-                printf("\nERROR: Error getting "
-                    "dwarf_siblingof when looking for"
-                    " procedure name. "
-                    "Section %s. Err is %s\n",
-                    sanitized(frame_section_name),
-                    dwarf_errmsg(*err));
-                glflags.gf_count_major_errors++;
-                DROP_ERROR_INSTANCE(dbg,dres,*err);
-                glflags.gf_all_cus_seen_search_by_address = 1;
-                return DW_DLV_NO_ENTRY;;
-            }
-            if (dres == DW_DLV_NO_ENTRY) {
-                /*  No initial die? Something is wrong! */
-                return dres;
-            }
-#endif /* ORIGINAL_HEADER_API */
-        }
-    }
-    if (dres == DW_DLV_OK) {
-        Dwarf_Die child = 0;
-
-        if (*cu_die_for_print_frames == 0) {
-            /*  no information. Possibly a stripped file */
-            return DW_DLV_NO_ENTRY;
-        }
-        chres = dwarf_child(*cu_die_for_print_frames,
-            &child, err);
-        if (chres == DW_DLV_ERROR) {
-            printf("\nERROR: Error getting "
-                "dwarf_child(). "
-                "Section %s. Err is %s\n",
-                sanitized(frame_section_name),
-                dwarf_errmsg(*err));
-            DROP_ERROR_INSTANCE(dbg,chres,*err);
-            glflags.gf_count_major_errors++;
-            glflags.gf_all_cus_seen_search_by_address = 1;
-            return DW_DLV_NO_ENTRY;
-        } else if (chres == DW_DLV_NO_ENTRY) {
-            /* FALL THROUGH to look for more CU headers  */
-        } else { /* DW_DLV_OK */
-            int gotname = 0;
-            gotname = load_nested_proc_name(dbg, child, low_pc, name,
-                cu_die_for_print_frames,
-                pcMap,err);
-            dwarf_dealloc(dbg, child, DW_DLA_DIE);
-            if (gotname == DW_DLV_OK) {
-                return DW_DLV_OK;
-            }
-            if (gotname == DW_DLV_ERROR) {
-                glflags.gf_all_cus_seen_search_by_address = 1;
-                DROP_ERROR_INSTANCE(dbg,gotname,*err);
-                return DW_DLV_NO_ENTRY;
-            }
-            child = 0;
-        }
-    }
     for (;;) {
         Dwarf_Die ldie = 0;
+        int chpfres = 0;
+        Dwarf_Die child = 0;
 
         type_signature = zero_type_signature;
 #ifdef ORIGINAL_HEADER_API
-
         cures = dwarf_next_cu_header_d(dbg,
             is_info, &cu_header_length,
             &version_stamp, &abbrev_offset,
@@ -845,78 +678,94 @@ get_fde_proc_name_by_address(Dwarf_Debug dbg, Dwarf_Addr low_pc,
                     dwarf_errmsg(*err));
                 DROP_ERROR_INSTANCE(dbg,cures,*err);
                 glflags.gf_count_major_errors++;
-                glflags.gf_all_cus_seen_search_by_address = 1;
-                return DW_DLV_NO_ENTRY;
+            } else if (!cu_count && !restarted) {
+                /*  We were at the end of the CUs (having
+                    printed .debug_info, for example).
+                    The next call starts over. */
+                restarted = TRUE;
+                continue;
             }
-            glflags.gf_all_cus_seen_search_by_address = 1;
             break;
         }
-
+        ++cu_count;
 #ifdef ORIGINAL_HEADER_API
-        dres = dwarf_siblingof_b(dbg,NULL,is_info, &ldie, err);
-#else
-        dres = DW_DLV_OK;
-#endif
+        {
+            int dres = dwarf_siblingof_b(dbg,NULL,is_info,
+                &ldie, err);
+            if (dres == DW_DLV_ERROR) {
+                DROP_ERROR_INSTANCE(dbg,dres,*err);
+                break;
+            } else if (dres == DW_DLV_NO_ENTRY) {
+                break;
+            }
+        }
+#endif /* ORIGINAL_HEADER_API */
         if (*cu_die_for_print_frames) {
             dwarf_dealloc(dbg, *cu_die_for_print_frames,DW_DLA_DIE);
-            *cu_die_for_print_frames = 0;
-        }
-#ifdef ORIGINAL_HEADER_API
-        if (dres == DW_DLV_ERROR) {
-            DROP_ERROR_INSTANCE(dbg,dres,*err);
-            glflags.gf_all_cus_seen_search_by_address = 1;
-            return dres;
-        } else if (dres == DW_DLV_NO_ENTRY) {
-            return dres;
         }
-#endif /* ORIGINAL_HEADER_API */
-        /*  DW_DLV_OK
-            In normal processing (ie, when doing print_info()
+        /*  In normal processing (ie, when doing print_info()
             we would call print_attribute for each die
             including cu_die and thus get CU_base_address,
             CU_high_address, PU_base_address, PU_high_address,
             CU_name for PRINT_CU_INFO() in case of error.  */
         *cu_die_for_print_frames = ldie;
-        {
-            int chpfres = 0;
-            Dwarf_Die child = 0;
-
-            chpfres =
-                dwarf_child(*cu_die_for_print_frames, &child,
-                    err);
-            if (chpfres == DW_DLV_ERROR) {
-                load_CU_error_data(dbg,*cu_die_for_print_frames);
-                glflags.gf_count_major_errors++;
-                printf("\nERROR: Getting procedure name "
-                    "dwarf_child fails "
-                    " %s\n",dwarf_errmsg(*err));
-                DROP_ERROR_INSTANCE(dbg,chpfres,*err);
-                glflags.gf_all_cus_seen_search_by_address = 1;
-                return DW_DLV_NO_ENTRY;
-            } else if (chpfres == DW_DLV_NO_ENTRY) {
-                /* FALL THROUGH to loop more */
-            } else {
-                /* DW_DLV_OK) */
-                int gotname = 0;
+        chpfres = dwarf_child(*cu_die_for_print_frames, &child,
+            err);
+        if (chpfres == DW_DLV_ERROR) {
+            load_CU_error_data(dbg,*cu_die_for_print_frames);
+            glflags.gf_count_major_errors++;
+            printf("\nERROR: Getting procedure name "
+                "dwarf_child fails "
+                " %s\n",dwarf_errmsg(*err));
+            DROP_ERROR_INSTANCE(dbg,chpfres,*err);
+            break;
+        } else if (chpfres == DW_DLV_OK) {
+            int gotnames = 0;
 
-                gotname = load_nested_proc_name(dbg, child,
-                    low_pc, name,
-                    cu_die_for_print_frames,
-                    pcMap,err);
-                dwarf_dealloc(dbg, child, DW_DLA_DIE);
-                if (gotname == DW_DLV_OK) {
-                    return gotname;
-                }
-                if (gotname == DW_DLV_ERROR) {
-                    DROP_ERROR_INSTANCE(dbg,gotname,*err);
-                    glflags.gf_all_cus_seen_search_by_address = 1;
-                    return DW_DLV_NO_ENTRY;
-                }
+            gotnames = load_nested_proc_names(dbg, child,
+                cu_die_for_print_frames,
+                pcMap,err);
+            dwarf_dealloc(dbg, child, DW_DLA_DIE);
+            if (gotnames == DW_DLV_ERROR) {
+                DROP_ERROR_INSTANCE(dbg,gotnames,*err);
+                break;
             }
         }
         reset_overall_CU_error_data();
     }
-    return DW_DLV_NO_ENTRY;
+    addr_name_table_sort(pcMap);
+    glflags.gf_all_cus_seen_search_by_address = 1;
+}
+
+/*  The first call builds the table of all procedure
+    names (see load_all_proc_names()), so each FDE
+    costs a binary search rather than a DIE walk.
+    Return DW_DLV_OK means found name.
+    Return DW_DLV_NO_ENTRY means not found name.
+    Never returns DW_DLV_ERROR
+*/
+static int
+get_fde_proc_name_by_address(Dwarf_Debug dbg, Dwarf_Addr low_pc,
+    const char *frame_section_name,
+    struct esb_s *name,
+    Dwarf_Die *cu_die_for_print_frames,
+    struct Addr_Name_Table *pcMap,Dwarf_Error *err)
+{
+    const char *pname = 0;
+
+    if (!glflags.gf_all_cus_seen_search_by_address) {
+        if (glflags.gf_debug_addr_missing) {
+            return DW_DLV_NO_ENTRY;
+        }
+        load_all_proc_names(dbg,frame_section_name,
+            cu_die_for_print_frames,pcMap,err);
+    }
+    pname = addr_name_table_find(pcMap,low_pc);
+    if (!pname) {
+        return DW_DLV_NO_ENTRY;
+    }
+    esb_append(name,pname);
+    return DW_DLV_OK;
 }
 
 /*  Attempting to take care of overflows so we
@@ -1052,7 +901,7 @@ print_one_fde(Dwarf_Debug dbg,
     Dwarf_Half version,
     int        is_eh,
     struct dwconf_s *config_data,
-    void    ** pcMap,
+    struct Addr_Name_Table *pcMap,
     void    ** lowpcSet,
     Dwarf_Die *cu_die_for_print_frames,
     Dwarf_Error *err)
@@ -1192,6 +1041,10 @@ print_one_fde(Dwarf_Debug dbg,
             (Dwarf_Unsigned)fde_offset,
             fde_bytes_length);
     }
+    if (glflags.gf_format_json) {
+        print_json_fde(frame_section_name,fde_offset,cie_offset,
+            low_pc,func_length,esb_get_string(&temps));
+    }
     esb_destructor(&temps);
     if (!is_eh) {
         /* IRIX used eh_table_offset. No one else uses it. */
@@ -1333,12 +1186,14 @@ print_one_fde(Dwarf_Debug dbg,
             }
             /* Do not print if in check mode */
             if (!printed_intro_addr && glflags.gf_do_print_dwarf) {
-                printf("        0x%" DW_PR_XZEROS DW_PR_DUx
-                    ": ", (Dwarf_Unsigned)cur_pc_in_table);
+                dd_out_spaces(8);
+                dd_out_hex(cur_pc_in_table,DD_OUT_XZEROS);
+                dd_out_string(": ");
                 printed_intro_addr = 1;
             }
             print_one_frame_reg_col(dbg,
                 *cu_die_for_print_frames,
+                fde_offset,cur_pc_in_table,
                 config_data->cf_cfa_reg,
                 value_type,
                 reg,
@@ -1407,12 +1262,14 @@ print_one_fde(Dwarf_Debug dbg,
 
             /* Do not print if in check mode */
             if (!printed_intro_addr && glflags.gf_do_print_dwarf) {
-                printf("        0x%" DW_PR_XZEROS DW_PR_DUx ": ",
-                    (Dwarf_Unsigned)j);
+                dd_out_spaces(8);
+                dd_out_hex(j,DD_OUT_XZEROS);
+                dd_out_string(": ");
                 printed_intro_addr = 1;
             }
             print_one_frame_reg_col(dbg,
                 *cu_die_for_print_frames,
+                fde_offset,j,
                 k,
                 value_type,
                 reg,
@@ -1422,7 +1279,7 @@ print_one_fde(Dwarf_Debug dbg,
                 offset_relevant, offset, &block);
         }
         if (printed_intro_addr) {
-            printf("\n");
+            dd_out_char('\n');
             printed_intro_addr = 0;
         }
     }
@@ -1574,6 +1431,7 @@ print_one_fde(Dwarf_Debug dbg,
 */
 int
 print_one_cie(Dwarf_Debug dbg,
+    const char *frame_section_name,
     Dwarf_Die die,
     Dwarf_Cie cie,
     Dwarf_Unsigned cie_index,
@@ -1613,6 +1471,20 @@ print_one_cie(Dwarf_Debug dbg,
             "\n", cie_index);
         return cires;
     }
+    if (glflags.gf_format_json) {
+        Dwarf_Error oerr = 0;
+
+        cires = dwarf_cie_section_offset(dbg, cie, &cie_off, &oerr);
+        if (cires == DW_DLV_OK) {
+            print_json_cie(frame_section_name,cie_off,version,
+                augmenter,code_alignment_factor,
+                data_alignment_factor,
+                return_address_register_rule,
+                cie_initial_instructions,
+                cie_initial_instructions_length);
+        }
+        DROP_ERROR_INSTANCE(dbg,cires,oerr);
+    }
     {
         if (glflags.gf_do_print_dwarf) {
             printf("<%5" DW_PR_DUu "> version      %d\n",
@@ -2151,6 +2023,8 @@ printreg(Dwarf_Unsigned reg, struct dwconf_s *config_data)
 static void
 print_one_frame_reg_col(Dwarf_Debug dbg,
     Dwarf_Die die,
+    Dwarf_Off fde_offset,
+    Dwarf_Addr row_address,
     Dwarf_Unsigned rule_id,
     Dwarf_Small value_type,
     Dwarf_Unsigned reg_used,
@@ -2165,9 +2039,6 @@ print_one_frame_reg_col(Dwarf_Debug dbg,
     char *type_title = "";
     int print_type_title = 1;
 
-    if (!glflags.gf_do_print_dwarf) {
-        return;
-    }
     if (reg_used == config_data->cf_initial_rule_value &&
         (value_type == DW_EXPR_OFFSET ||
         value_type == DW_EXPR_VAL_OFFSET) ) {
@@ -2176,6 +2047,16 @@ print_one_frame_reg_col(Dwarf_Debug dbg,
             the *next* column used here or something. */
         return;
     }
+    if (glflags.gf_format_json) {
+        print_json_frame_rule(fde_offset,row_address,
+            rule_id == config_data->cf_cfa_reg,rule_id,
+            value_type,reg_used,offset_relevant?TRUE:FALSE,
+            offset,block);
+        return;
+    }
+    if (!glflags.gf_do_print_dwarf) {
+        return;
+    }
     switch (value_type) {
     case DW_EXPR_OFFSET:
         type_title = "off";
@@ -2184,21 +2065,25 @@ print_one_frame_reg_col(Dwarf_Debug dbg,
         type_title = "valoff";
 
         preg2:
-        if (print_type_title)
-            printf("<%s ", type_title);
+        if (print_type_title) {
+            dd_out_char('<');
+            dd_out_string(type_title);
+            dd_out_char(' ');
+        }
         printreg(rule_id, config_data);
-        printf("=");
+        dd_out_char('=');
         if (offset_relevant == 0) {
             printreg(reg_used, config_data);
-            printf(" ");
+            dd_out_char(' ');
         } else {
-            printf("%02" DW_PR_DSd , offset);
-            printf("(");
+            dd_out_sdec_zero(offset,2);
+            dd_out_char('(');
             printreg(reg_used, config_data);
-            printf(") ");
+            dd_out_string(") ");
+        }
+        if (print_type_title) {
+            dd_out_string("> ");
         }
-        if (print_type_title)
-            printf("> ");
         break;
     case DW_EXPR_EXPRESSION:
         type_title = "expr";
@@ -2320,7 +2205,7 @@ print_all_fdes(Dwarf_Debug dbg,
     Dwarf_Half version,
     int is_eh,
     struct dwconf_s *config_data,
-    void **map_lowpc_to_name,
+    struct Addr_Name_Table *map_lowpc_to_name,
     void **lowpcSet,
     Dwarf_Die *cu_die_for_print_frames,
     Dwarf_Error*err)
@@ -2390,6 +2275,7 @@ print_all_fdes(Dwarf_Debug dbg,
 
 static int
 print_all_cies(Dwarf_Debug dbg,
+    const char *frame_section_name,
     Dwarf_Cie *cie_data,
     Dwarf_Signed cie_element_count,
     Dwarf_Half address_size,
@@ -2409,6 +2295,7 @@ print_all_cies(Dwarf_Debug dbg,
         int cres = 0;
 
         cres = print_one_cie(dbg,
+            frame_section_name,
             *cu_die_for_print_frames,
             cie_data[i], i, address_size,
             config_data,
@@ -2445,7 +2332,7 @@ print_frames(Dwarf_Debug dbg,
     /*  Pass these next 3 so preserved from .eh_frame
         to .debug_frame */
     Dwarf_Die * cu_die_for_print_frames,
-    void ** map_lowpc_to_name,
+    struct Addr_Name_Table * map_lowpc_to_name,
     void ** lowpcSet,
     Dwarf_Error *err)
 {
@@ -2568,7 +2455,7 @@ print_frames(Dwarf_Debug dbg,
         }
 
         if (fres == DW_DLV_NO_ENTRY) {
-            if (!silent_if_missing) {
+            if (!silent_if_missing && !glflags.gf_format_json) {
                 printf("\n%s is not present\n",
                     sanitized(frame_section_name));
             }
@@ -2594,7 +2481,7 @@ print_frames(Dwarf_Debug dbg,
                 *err = 0;
             }
             res = print_all_cies(dbg,
-                /* frame_section_name, */
+                frame_section_name,
                 cie_data, cie_element_count,
                 address_size,
                 /* offset_size,version,is_eh, */
@@ -34,6 +34,7 @@ extern "C" {
 #endif /* __cplusplus */
 
 int print_one_cie(Dwarf_Debug dbg,
+    const char *frame_section_name,
     Dwarf_Die die,
     Dwarf_Cie cie,
     Dwarf_Unsigned cie_index,
@@ -43,6 +43,7 @@ Portions Copyright 2007-2020 David Anderson. All rights reserved.
 #include "dd_esb_using_functions.h"
 #include "dd_sanitized.h"
 #include "dd_macrocheck.h"
+#include "dd_map.h"
 #include "dd_helpertree.h"
 #include "dd_tag_common.h"
 #include "print_frames.h"  /* for print_expression_operations() . */
@@ -0,0 +1,736 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  --format-json: the record formatting for JSON Lines
+    output, one JSON object per line, each with a "type"
+    member. The records are written from the record points
+    of the text walkers (print_die.c, print_lines.c,
+    print_frames.c), which run with text printing off, so
+    both formats see the same traversal. Nothing here uses
+    esb strings or sanitized(): JSON has its own escaping.
+
+    Record types:
+    cu        one per unit header
+    die       one per DIE, in section order; "depth"
+              is 0 for the unit DIE, "attributes" maps
+              attribute names to values
+    line_file one per file of a CU line table
+    line      one per line table row
+    cie, fde  frame section entries
+    cfa       the CFA rule of each row of an FDE
+    register  each other register rule the row sets
+
+    Attribute values: strings for string forms, numbers
+    for constants, addresses, references (global section
+    offsets) and section offsets, true/false for flags,
+    and a string of hex digits for DW_FORM_data16 and
+    DW_FORM_ref_sig8. Location expressions, location
+    lists, range lists and blocks are the strings the
+    text output shows. */
+
+#include <config.h>
+
+#include <stdio.h>  /* fwrite() stdout */
+#include <string.h> /* strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dd_globals.h"
+#include "dd_glflags.h"
+
+/*  Output is built in jbuf and written a record at a time
+    so the JSON and any text dwarfdump prints in between
+    (error messages) stay in order. */
+#define JBUF_SIZE 16384
+static char   jbuf[JBUF_SIZE];
+static size_t jlen;
+
+/*  FALSE until the first member of the current object
+    is written. */
+static Dwarf_Bool jmember;
+
+/*  A die record is written over several calls, one per
+    attribute. TRUE from print_json_die_begin() until
+    the record is closed. */
+static Dwarf_Bool jdie_open;
+
+static void
+jflush(void)
+{
+    if (jlen) {
+        fwrite(jbuf,1,jlen,stdout);
+        jlen = 0;
+    }
+}
+
+static void
+jputc(char c)
+{
+    if (jlen == JBUF_SIZE) {
+        jflush();
+    }
+    jbuf[jlen++] = c;
+}
+
+static void
+jputs(const char *s, size_t len)
+{
+    if (len > JBUF_SIZE - jlen) {
+        jflush();
+        if (len > JBUF_SIZE) {
+            fwrite(s,1,len,stdout);
+            return;
+        }
+    }
+    memcpy(jbuf+jlen,s,len);
+    jlen += len;
+}
+
+static const char jhex[] = "0123456789abcdef";
+
+/*  Length of the valid UTF-8 sequence starting at s,
+    or 0 if it is not one. */
+static int
+utf8_len(const unsigned char *s)
+{
+    unsigned char c = s[0];
+    int len = 0;
+    int i = 0;
+
+    if (c < 0xc2) {
+        return 0;
+    }
+    if (c < 0xe0) {
+        len = 2;
+    } else if (c < 0xf0) {
+        len = 3;
+    } else if (c < 0xf5) {
+        len = 4;
+    } else {
+        return 0;
+    }
+    for (i = 1; i < len; ++i) {
+        if ((s[i] & 0xc0) != 0x80) {
+            return 0;
+        }
+    }
+    return len;
+}
+
+/*  The characters of a JSON string, without the quotes:
+    slen bytes of str.
+    Bytes that are not valid UTF-8 are written as \u00XX. */
+static void
+jstring_body(const char *str, size_t slen)
+{
+    const unsigned char *s = (const unsigned char *)str;
+    const unsigned char *end = s + slen;
+    const unsigned char *run = s;
+
+    for (;;) {
+        unsigned char c = (s < end)? *s : 0;
+        int len = 0;
+
+        if (c >= 0x20 && c < 0x80 && c != '"' && c != '\\') {
+            ++s;
+            continue;
+        }
+        if (c >= 0x80 && (len = utf8_len(s)) > 0 &&
+            len <= end - s) {
+            s += len;
+            continue;
+        }
+        jputs((const char *)run,(size_t)(s-run));
+        if (s >= end) {
+            break;
+        }
+        jputc('\\');
+        if (c == '"' || c == '\\') {
+            jputc((char)c);
+        } else if (c == '\n') {
+            jputc('n');
+        } else if (c == '\t') {
+            jputc('t');
+        } else {
+            jputs("u00",3);
+            jputc(jhex[c >> 4]);
+            jputc(jhex[c & 0xf]);
+        }
+        ++s;
+        run = s;
+    }
+}
+
+static void
+jstring(const char *str)
+{
+    jputc('"');
+    jstring_body(str,strlen(str));
+    jputc('"');
+}
+
+/*  The value strings print_attribute() built for the
+    text, as one JSON string.  The line breaks and
+    indentation of the text layout (with whatever blanks
+    are next to them) become one space, and blanks at
+    either end are dropped. */
+static void
+jtext(const char *text, const char *extra)
+{
+    const char *parts[2];
+    Dwarf_Bool started = FALSE;
+    Dwarf_Bool pending_break = FALSE;
+    const char *pending = 0;
+    size_t pending_len = 0;
+    int p = 0;
+
+    parts[0] = text;
+    parts[1] = extra;
+    jputc('"');
+    for (p = 0; p < 2; ++p) {
+        const char *s = parts[p];
+
+        while (s && *s) {
+            const char *w = s;
+
+            while (*w == ' ' || *w == '\t' || *w == '\n') {
+                if (*w == '\n') {
+                    pending_break = TRUE;
+                }
+                ++w;
+            }
+            if (w != s) {
+                if (pending) {
+                    /*  A run of blanks split across
+                        text and extra. */
+                    pending_break = TRUE;
+                }
+                pending = s;
+                pending_len = (size_t)(w - s);
+                s = w;
+                continue;
+            }
+            while (*w && *w != ' ' && *w != '\t' && *w != '\n') {
+                ++w;
+            }
+            if (started && pending) {
+                if (pending_break) {
+                    jputc(' ');
+                } else {
+                    jstring_body(pending,pending_len);
+                }
+            }
+            pending = 0;
+            pending_break = FALSE;
+            jstring_body(s,(size_t)(w - s));
+            started = TRUE;
+            s = w;
+        }
+    }
+    jputc('"');
+}
+
+static void
+junsigned(Dwarf_Unsigned v)
+{
+    char buf[24];
+    char *p = buf + sizeof(buf);
+
+    do {
+        *--p = (char)('0' + v%10);
+        v /= 10;
+    } while (v);
+    jputs(p,(size_t)(buf + sizeof(buf) - p));
+}
+
+static void
+jsigned(Dwarf_Signed v)
+{
+    if (v < 0) {
+        jputc('-');
+        junsigned((Dwarf_Unsigned)0 - (Dwarf_Unsigned)v);
+        return;
+    }
+    junsigned((Dwarf_Unsigned)v);
+}
+
+static void
+jhexbytes(const Dwarf_Small *bytes, Dwarf_Unsigned len)
+{
+    Dwarf_Unsigned i = 0;
+
+    jputc('"');
+    for (i = 0; i < len; ++i) {
+        jputc(jhex[bytes[i] >> 4]);
+        jputc(jhex[bytes[i] & 0xf]);
+    }
+    jputc('"');
+}
+
+/*  Member names are DWARF names or fixed ASCII,
+    so they need no escaping. */
+static void
+jkey(const char *key)
+{
+    if (jmember) {
+        jputc(',');
+    }
+    jmember = TRUE;
+    jputc('"');
+    jputs(key,strlen(key));
+    jputs("\":",2);
+}
+
+static void
+jrecord_end(void)
+{
+    jputs("}\n",2);
+    jflush();
+}
+
+/*  Ends a die record whose attributes were cut short
+    by an error. */
+static void
+jdie_close(void)
+{
+    if (jdie_open) {
+        jdie_open = FALSE;
+        jputc('}');
+        jrecord_end();
+    }
+}
+
+static void
+jrecord_begin(const char *type)
+{
+    jdie_close();
+    jputs("{\"type\":\"",9);
+    jputs(type,strlen(type));
+    jputc('"');
+    jmember = TRUE;
+}
+
+static void
+jkey_unsigned(const char *key, Dwarf_Unsigned v)
+{
+    jkey(key);
+    junsigned(v);
+}
+
+static void
+jkey_signed(const char *key, Dwarf_Signed v)
+{
+    jkey(key);
+    jsigned(v);
+}
+
+static void
+jkey_string(const char *key, const char *s)
+{
+    jkey(key);
+    jstring(s);
+}
+
+static void
+jkey_bool(const char *key, Dwarf_Bool v)
+{
+    jkey(key);
+    if (v) {
+        jputs("true",4);
+    } else {
+        jputs("false",5);
+    }
+}
+
+/*  Writes a DW_xx name as a JSON string or, for an
+    unknown value (no name), prefix followed by the
+    value in hex. */
+static void
+jdwname(const char *name, const char *prefix, unsigned int v)
+{
+    char buf[24];
+    char *p = buf + sizeof(buf);
+
+    jputc('"');
+    if (name) {
+        jputs(name,strlen(name));
+    } else {
+        do {
+            *--p = jhex[v & 0xf];
+            v >>= 4;
+        } while (v);
+        jputs(prefix,strlen(prefix));
+        jputs("0x",2);
+        jputs(p,(size_t)(buf + sizeof(buf) - p));
+    }
+    jputc('"');
+}
+
+static void
+jkey_dwname(const char *key, const char *name,
+    const char *prefix, unsigned int v)
+{
+    jkey(key);
+    jdwname(name,prefix,v);
+}
+
+/*  One unit header. signature is 0 for units
+    that have none. */
+void
+print_json_cu(const char *secname, Dwarf_Off cu_off,
+    Dwarf_Half version, Dwarf_Half unit_type,
+    Dwarf_Half address_size, Dwarf_Unsigned abbrev_offset,
+    Dwarf_Sig8 *signature)
+{
+    const char *name = 0;
+
+    jrecord_begin("cu");
+    jkey_string("section",secname);
+    jkey_unsigned("offset",cu_off);
+    jkey_unsigned("version",version);
+    if (dwarf_get_UT_name(unit_type,&name) != DW_DLV_OK) {
+        name = 0;
+    }
+    jkey_dwname("unit_type",name,"DW_UT_",unit_type);
+    jkey_unsigned("address_size",address_size);
+    jkey_unsigned("abbrev_offset",abbrev_offset);
+    if (signature) {
+        jkey("signature");
+        jhexbytes((Dwarf_Small *)signature->signature,
+            sizeof(signature->signature));
+    }
+    jrecord_end();
+}
+
+/*  Starts the record of a DIE. Its attributes follow
+    from print_json_die_attr(). */
+void
+print_json_die_begin(Dwarf_Off offset, int depth, Dwarf_Half tag)
+{
+    const char *name = 0;
+
+    jrecord_begin("die");
+    jkey_unsigned("offset",offset);
+    jkey_unsigned("depth",(Dwarf_Unsigned)depth);
+    if (dwarf_get_TAG_name(tag,&name) != DW_DLV_OK) {
+        name = 0;
+    }
+    jkey_dwname("tag",name,"DW_TAG_",tag);
+    jkey("attributes");
+    jputc('{');
+    jmember = FALSE;
+    jdie_open = TRUE;
+}
+
+/*  A reference or section offset, as a global
+    section offset. */
+static int
+json_global_offset(Dwarf_Attribute attr, Dwarf_Error *err)
+{
+    Dwarf_Off off = 0;
+    Dwarf_Bool is_info = TRUE;
+    int res = 0;
+
+    res = dwarf_global_formref_b(attr,&off,&is_info,err);
+    if (res == DW_DLV_OK) {
+        junsigned(off);
+    }
+    return res;
+}
+
+/*  The typed value of an attribute. Returns
+    DW_DLV_NO_ENTRY for the classes written as text. */
+static int
+json_attr_value(Dwarf_Attribute attr, Dwarf_Half form,
+    enum Dwarf_Form_Class fc, Dwarf_Bool is_signed,
+    Dwarf_Error *err)
+{
+    int res = DW_DLV_NO_ENTRY;
+
+    switch (fc) {
+    case DW_FORM_CLASS_STRING: {
+        char *s = 0;
+
+        res = dwarf_formstring(attr,&s,err);
+        if (res == DW_DLV_OK) {
+            jstring(s);
+        }
+        break;
+    }
+    case DW_FORM_CLASS_FLAG: {
+        Dwarf_Bool f = 0;
+
+        res = dwarf_formflag(attr,&f,err);
+        if (res == DW_DLV_OK) {
+            jputs(f?"true":"false",f?4:5);
+        }
+        break;
+    }
+    case DW_FORM_CLASS_ADDRESS: {
+        Dwarf_Addr a = 0;
+
+        res = dwarf_formaddr(attr,&a,err);
+        if (res == DW_DLV_OK) {
+            junsigned(a);
+        }
+        break;
+    }
+    case DW_FORM_CLASS_REFERENCE:
+        if (form == DW_FORM_ref_sig8) {
+            Dwarf_Sig8 sig;
+
+            res = dwarf_formsig8(attr,&sig,err);
+            if (res == DW_DLV_OK) {
+                jhexbytes((Dwarf_Small *)sig.signature,
+                    sizeof(sig.signature));
+            }
+        } else {
+            res = json_global_offset(attr,err);
+        }
+        break;
+    case DW_FORM_CLASS_LINEPTR:
+    case DW_FORM_CLASS_MACPTR:
+    case DW_FORM_CLASS_MACROPTR:
+    case DW_FORM_CLASS_ADDRPTR:
+    case DW_FORM_CLASS_LOCLISTSPTR:
+    case DW_FORM_CLASS_RNGLISTSPTR:
+    case DW_FORM_CLASS_STROFFSETSPTR:
+        res = json_global_offset(attr,err);
+        break;
+    case DW_FORM_CLASS_UNKNOWN:
+        /*  A vendor attribute dwarf_get_form_class()
+            does not know: a section offset is still one. */
+        if (form == DW_FORM_sec_offset) {
+            res = json_global_offset(attr,err);
+        }
+        break;
+    case DW_FORM_CLASS_CONSTANT:
+        if (form == DW_FORM_data16) {
+            Dwarf_Form_Data16 d;
+
+            res = dwarf_formdata16(attr,&d,err);
+            if (res == DW_DLV_OK) {
+                jhexbytes((Dwarf_Small *)d.fd_data,
+                    sizeof(d.fd_data));
+            }
+        } else if (is_signed) {
+            Dwarf_Signed sv = 0;
+
+            res = dwarf_formsdata(attr,&sv,err);
+            if (res == DW_DLV_OK) {
+                jsigned(sv);
+            }
+        } else {
+            Dwarf_Unsigned u = 0;
+
+            res = dwarf_formudata(attr,&u,err);
+            if (res == DW_DLV_OK) {
+                junsigned(u);
+            }
+        }
+        break;
+    default:
+        break;
+    }
+    return res;
+}
+
+/*  One attribute of the open die record. text and extra
+    are the value strings print_attribute() built for
+    the text output: they are the value of the classes
+    with no typed JSON form, and of any attribute whose
+    value cannot be read by its class. */
+void
+print_json_die_attr(Dwarf_Debug dbg, Dwarf_Attribute attr,
+    Dwarf_Half attrnum, Dwarf_Half form,
+    enum Dwarf_Form_Class fc, Dwarf_Bool is_signed,
+    const char *text, const char *extra)
+{
+    const char *name = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    if (!jdie_open) {
+        return;
+    }
+    if (jmember) {
+        jputc(',');
+    }
+    jmember = TRUE;
+    if (dwarf_get_AT_name(attrnum,&name) != DW_DLV_OK) {
+        name = 0;
+    }
+    jdwname(name,"DW_AT_",attrnum);
+    jputc(':');
+    res = json_attr_value(attr,form,fc,is_signed,&err);
+    if (res == DW_DLV_OK) {
+        return;
+    }
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,err);
+    }
+    jtext(text,extra);
+}
+
+void
+print_json_die_end(void)
+{
+    jdie_close();
+}
+
+/*  One file of a CU line table. */
+void
+print_json_line_file(Dwarf_Off cu_off, Dwarf_Signed index,
+    const char *name)
+{
+    jrecord_begin("line_file");
+    jkey_unsigned("cu",cu_off);
+    jkey_signed("index",index);
+    jkey_string("name",name);
+    jrecord_end();
+}
+
+/*  One row of a CU line table. */
+void
+print_json_line(Dwarf_Off cu_off, Dwarf_Addr address,
+    Dwarf_Unsigned file, Dwarf_Unsigned line,
+    Dwarf_Unsigned column, Dwarf_Bool is_stmt,
+    Dwarf_Bool end_sequence)
+{
+    jrecord_begin("line");
+    jkey_unsigned("cu",cu_off);
+    jkey_unsigned("address",address);
+    jkey_unsigned("file",file);
+    jkey_unsigned("line",line);
+    jkey_unsigned("column",column);
+    jkey_bool("is_stmt",is_stmt);
+    jkey_bool("end_sequence",end_sequence);
+    jrecord_end();
+}
+
+void
+print_json_cie(const char *secname, Dwarf_Off offset,
+    unsigned version, const char *augmentation,
+    Dwarf_Unsigned code_align, Dwarf_Signed data_align,
+    Dwarf_Unsigned ra_reg,
+    Dwarf_Small *instrs, Dwarf_Unsigned instrs_len)
+{
+    jrecord_begin("cie");
+    jkey_string("section",secname);
+    jkey_unsigned("offset",offset);
+    jkey_unsigned("version",version);
+    jkey_string("augmentation",augmentation?augmentation:"");
+    jkey_unsigned("code_alignment_factor",code_align);
+    jkey_signed("data_alignment_factor",data_align);
+    jkey_unsigned("return_address_register",ra_reg);
+    jkey("initial_instructions");
+    jhexbytes(instrs,instrs_len);
+    jrecord_end();
+}
+
+/*  name is the function the FDE is for, or "". */
+void
+print_json_fde(const char *secname, Dwarf_Off offset,
+    Dwarf_Off cie_offset, Dwarf_Addr low_pc,
+    Dwarf_Unsigned length, const char *name)
+{
+    jrecord_begin("fde");
+    jkey_string("section",secname);
+    jkey_unsigned("offset",offset);
+    jkey_unsigned("cie_offset",cie_offset);
+    jkey_unsigned("low_pc",low_pc);
+    jkey_unsigned("length",length);
+    if (name && *name) {
+        jkey_string("name",name);
+    }
+    jrecord_end();
+}
+
+/*  One rule of a frame table row: the CFA rule (is_cfa)
+    or the rule for register column. */
+void
+print_json_frame_rule(Dwarf_Off fde_offset, Dwarf_Addr pc,
+    Dwarf_Bool is_cfa, Dwarf_Unsigned column,
+    Dwarf_Small value_type, Dwarf_Unsigned reg,
+    Dwarf_Bool offset_relevant, Dwarf_Signed offset,
+    Dwarf_Block *block)
+{
+    const char *rule = 0;
+
+    jrecord_begin(is_cfa?"cfa":"register");
+    jkey_unsigned("fde",fde_offset);
+    jkey_unsigned("pc",pc);
+    if (!is_cfa) {
+        jkey_unsigned("column",column);
+    }
+    switch (value_type) {
+    case DW_EXPR_OFFSET:         rule = "offset"; break;
+    case DW_EXPR_VAL_OFFSET:     rule = "val_offset"; break;
+    case DW_EXPR_EXPRESSION:     rule = "expression"; break;
+    case DW_EXPR_VAL_EXPRESSION: rule = "val_expression"; break;
+    default:                     rule = "unknown"; break;
+    }
+    jkey_string("rule",rule);
+    if (value_type == DW_EXPR_EXPRESSION ||
+        value_type == DW_EXPR_VAL_EXPRESSION) {
+        jkey("expression");
+        jhexbytes((Dwarf_Small *)block->bl_data,block->bl_len);
+    } else {
+        jkey_unsigned("register",reg);
+        if (offset_relevant) {
+            jkey_signed("offset",offset);
+        }
+    }
+    jrecord_end();
+}
+
+/*  The record starting each file of a --file-batch run. */
+void
+print_json_batch_file(unsigned index, unsigned count,
+    const char *path)
+{
+    jrecord_begin("file");
+    jkey_unsigned("index",index);
+    jkey_unsigned("count",count);
+    jkey_string("path",path);
+    jrecord_end();
+}
+
+/*  The record ending a --file-batch run. */
+void
+print_json_batch_summary(unsigned dumped, unsigned failed)
+{
+    jrecord_begin("batch_summary");
+    jkey_unsigned("files_dumped",dumped);
+    jkey_unsigned("files_failed",failed);
+    jrecord_end();
+}
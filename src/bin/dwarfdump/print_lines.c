@@ -41,6 +41,7 @@ Portions Copyright 2015-2015 Google, Inc. All Rights Reserved
 #include "dd_esb.h"
 #include "dd_esb_using_functions.h"
 #include "dd_sanitized.h"
+#include "dd_output.h"
 #include "dd_uri.h"
 
 #include "print_sections.h"
@@ -148,6 +149,7 @@ check_last_line_of_table(Dwarf_Addr   pc,
 static int
 process_line_table(Dwarf_Debug dbg,
     const char *sec_name,
+    Dwarf_Off json_cu_offset,
     Dwarf_Line *linebuf,
     Dwarf_Signed linecount,
     Dwarf_Bool is_logicals_table,
@@ -441,18 +443,29 @@ process_line_table(Dwarf_Debug dbg,
             }
         }
         if (glflags.gf_do_print_dwarf) {
+            /*  The fields of each row are written with
+                dd_out_*(), not printf(), as there are
+                many rows. */
             if (is_logicals_table || is_actuals_table) {
-                printf("[%4" DW_PR_DUu "]  ", i + 1);
+                dd_out_char('[');
+                dd_out_udec((Dwarf_Unsigned)(i + 1),4);
+                dd_out_string("]  ");
             }
             /* Check if print of <pc> address is needed. */
             if (glflags.gf_line_print_pc) {
-                printf("0x%" DW_PR_XZEROS DW_PR_DUx "  ", pc);
+                dd_out_hex(pc,DD_OUT_XZEROS);
+                dd_out_string("  ");
             }
             if (is_actuals_table) {
-                printf("[%7" DW_PR_DUu "]", logicalno);
+                dd_out_char('[');
+                dd_out_udec(logicalno,7);
+                dd_out_char(']');
             } else {
-                printf("[%4" DW_PR_DUu ",%2" DW_PR_DUu "]",
-                    lineno, column);
+                dd_out_char('[');
+                dd_out_udec(lineno,4);
+                dd_out_char(',');
+                dd_out_udec(column,2);
+                dd_out_char(']');
             }
         }
 
@@ -461,7 +474,7 @@ process_line_table(Dwarf_Debug dbg,
                 &newstatement, lt_err);
             if (nsres == DW_DLV_OK) {
                 if (newstatement && glflags.gf_do_print_dwarf) {
-                    printf(" %s","NS");
+                    dd_out_string(" NS");
                 }
             } else if (nsres == DW_DLV_ERROR) {
                 struct esb_s m;
@@ -486,7 +499,7 @@ process_line_table(Dwarf_Debug dbg,
                 &new_basic_block, lt_err);
             if (nsres == DW_DLV_OK) {
                 if (new_basic_block && glflags.gf_do_print_dwarf) {
-                    printf(" %s","BB");
+                    dd_out_string(" BB");
                 }
             } else if (nsres == DW_DLV_ERROR) {
                 struct esb_s m;
@@ -509,7 +522,7 @@ process_line_table(Dwarf_Debug dbg,
             if (nsres == DW_DLV_OK) {
                 if (lineendsequence &&
                     glflags.gf_do_print_dwarf) {
-                    printf(" %s", "ET");
+                    dd_out_string(" ET");
                 }
             } else if (nsres == DW_DLV_ERROR) {
                 struct esb_s m;
@@ -528,6 +541,16 @@ process_line_table(Dwarf_Debug dbg,
                 return nsres;
             }
         }
+        if (glflags.gf_format_json && !is_actuals_table) {
+            Dwarf_Unsigned fileno = 0;
+            Dwarf_Error fnerr = 0;
+            int fnres = 0;
+
+            fnres = dwarf_line_srcfileno(line,&fileno,&fnerr);
+            DROP_ERROR_INSTANCE(dbg,fnres,fnerr);
+            print_json_line(json_cu_offset,pc,fileno,lineno,
+                column,newstatement,lineendsequence);
+        }
 
         if (glflags.gf_do_print_dwarf) {
             Dwarf_Bool prologue_end = 0;
@@ -554,10 +577,10 @@ process_line_table(Dwarf_Debug dbg,
                 return disres;
             }
             if (prologue_end && !is_actuals_table) {
-                printf(" PE");
+                dd_out_string(" PE");
             }
             if (epilogue_begin && !is_actuals_table) {
-                printf(" EB");
+                dd_out_string(" EB");
             }
             if (isa && !is_logicals_table) {
                 printf(" IS=0x%" DW_PR_DUx, isa);
@@ -650,7 +673,7 @@ process_line_table(Dwarf_Debug dbg,
                     &urs);
                 esb_append(&urs,"\"");
                 if (glflags.gf_do_print_dwarf) {
-                    printf("%s",esb_get_string(&urs));
+                    dd_out_string(esb_get_string(&urs));
                 }
                 esb_destructor(&urs);
                 esb_empty_string(&lastsrc);
@@ -662,7 +685,7 @@ process_line_table(Dwarf_Debug dbg,
             }
         }
         if (glflags.gf_do_print_dwarf) {
-            printf("\n");
+            dd_out_char('\n');
         }
         dwarf_dealloc(dbg,lsrc_filename, DW_DLA_STRING);
         lsrc_filename = 0;
@@ -885,6 +908,30 @@ print_line_context_record(Dwarf_Line_Context line_context,
     return DW_DLV_OK;
 }
 
+/*  For --format-json: one line_file record per srcfiles
+    entry, numbered as the line table numbers its files. */
+static void
+print_json_line_files(Dwarf_Debug dbg,
+    Dwarf_Line_Context line_context,
+    Dwarf_Off cu_offset,
+    char **srcfiles,
+    Dwarf_Signed srcf_count)
+{
+    Dwarf_Signed baseindex = 0;
+    Dwarf_Signed file_count = 0;
+    Dwarf_Signed endindex = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Error ferr = 0;
+    int fres = 0;
+
+    fres = dwarf_srclines_files_indexes(line_context,
+        &baseindex,&file_count,&endindex,&ferr);
+    DROP_ERROR_INSTANCE(dbg,fres,ferr);
+    for (i = 0; i < srcf_count; ++i) {
+        print_json_line_file(cu_offset,baseindex + i,srcfiles[i]);
+    }
+}
+
 int
 print_line_numbers_this_cu(Dwarf_Debug dbg, Dwarf_Die cu_die,
     char **srcfiles,
@@ -903,6 +950,7 @@ print_line_numbers_this_cu(Dwarf_Debug dbg, Dwarf_Die cu_die,
     const char *sec_name = 0;
     Dwarf_Off cudie_local_offset = 0;
     Dwarf_Off dieprint_cu_goffset = 0;
+    Dwarf_Off json_cu_offset = 0;
     int atres = 0;
 
     glflags.current_section_id = DEBUG_LINE;
@@ -920,6 +968,15 @@ print_line_numbers_this_cu(Dwarf_Debug dbg, Dwarf_Die cu_die,
     atres = dwarf_die_offsets(cu_die,&dieprint_cu_goffset,
         &cudie_local_offset,err);
     DROP_ERROR_INSTANCE(dbg,atres,*err);
+    if (glflags.gf_format_json) {
+        /*  JSON records name the unit by its header offset,
+            as the cu record does. */
+        Dwarf_Off cu_length = 0;
+
+        atres = dwarf_die_CU_offset_range(cu_die,
+            &json_cu_offset,&cu_length,err);
+        DROP_ERROR_INSTANCE(dbg,atres,*err);
+    }
 
     if (glflags.gf_do_print_dwarf) {
         struct esb_s truename;
@@ -1052,7 +1109,12 @@ print_line_numbers_this_cu(Dwarf_Debug dbg, Dwarf_Die cu_die,
         }
         DROP_ERROR_INSTANCE(dbg,lres,*err);
         return DW_DLV_OK;
-    } else if (lres == DW_DLV_NO_ENTRY) {
+    }
+    if (lres == DW_DLV_OK && glflags.gf_format_json) {
+        print_json_line_files(dbg,line_context,json_cu_offset,
+            srcfiles,srcf_count);
+    }
+    if (lres == DW_DLV_NO_ENTRY) {
         /* no line information is included */
     } else if (table_count > 0) {
         /* lres DW_DLV_OK */
@@ -1097,6 +1159,7 @@ print_line_numbers_this_cu(Dwarf_Debug dbg, Dwarf_Die cu_die,
                 Dwarf_Bool is_actuals = FALSE;
 
                 ltres = process_line_table(dbg,sec_name,
+                    json_cu_offset,
                     linebuf, linecount,
                     is_logicals,is_actuals,err);
                 if (ltres == DW_DLV_ERROR) {
@@ -1109,6 +1172,7 @@ print_line_numbers_this_cu(Dwarf_Debug dbg, Dwarf_Die cu_die,
                 Dwarf_Bool is_actuals = FALSE;
 
                 ltres = process_line_table(dbg,sec_name,
+                    json_cu_offset,
                     linebuf, linecount,
                     is_logicals, is_actuals,err);
                 if (ltres != DW_DLV_OK) {
@@ -1116,6 +1180,7 @@ print_line_numbers_this_cu(Dwarf_Debug dbg, Dwarf_Die cu_die,
                     return ltres;
                 }
                 ltres = process_line_table(dbg,sec_name,
+                    json_cu_offset,
                     linebuf_actuals,
                     linecount_actuals,
                     !is_logicals, !is_actuals,err);
@@ -39,6 +39,7 @@ Portions Copyright 2007-2020 David Anderson. All rights reserved.
 #include "dd_esb.h"                /* For flexible string buffer. */
 #include "dd_esb_using_functions.h"
 #include "dd_sanitized.h"
+#include "dd_map.h"
 #include "dd_helpertree.h"
 #include "dd_tag_common.h"
 
@@ -96,6 +97,11 @@ print_debug_loclists_linecodes(Dwarf_Bool checking,
         /* Nothing to do. */
         esb_append(esbp,"<end-of-list>");
         break;
+    case DW_LLE_default_location:
+        /*  Applies wherever no bounded entry does,
+            there are no addresses to check. */
+        esb_append(esbp,"<default location>");
+        break;
     case  DW_LLE_start_length:
         if (glflags.verbose) {
             esb_append_printf_u(esbp,
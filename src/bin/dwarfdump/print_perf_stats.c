@@ -0,0 +1,180 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  To print libdwarf internal counters
+    (--print-perf-stats) */
+
+#include <config.h>
+
+#include <stdio.h> /* printf() */
+#include <string.h> /* memset() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dd_globals.h"
+#include "dd_glflags.h"
+
+struct dla_name_s {
+    int         dn_number;
+    const char *dn_name;
+};
+
+/*  Only the DW_DLA numbers visible in libdwarf.h,
+    others are printed by number. */
+static struct dla_name_s dla_names[] = {
+{DW_DLA_STRING,          "DW_DLA_STRING"},
+{DW_DLA_LOC,             "DW_DLA_LOC"},
+{DW_DLA_LOCDESC,         "DW_DLA_LOCDESC"},
+{DW_DLA_BLOCK,           "DW_DLA_BLOCK"},
+{DW_DLA_DEBUG,           "DW_DLA_DEBUG"},
+{DW_DLA_DIE,             "DW_DLA_DIE"},
+{DW_DLA_LINE,            "DW_DLA_LINE"},
+{DW_DLA_ATTR,            "DW_DLA_ATTR"},
+{DW_DLA_GLOBAL,          "DW_DLA_GLOBAL"},
+{DW_DLA_ERROR,           "DW_DLA_ERROR"},
+{DW_DLA_LIST,            "DW_DLA_LIST"},
+{DW_DLA_ARANGE,          "DW_DLA_ARANGE"},
+{DW_DLA_ABBREV,          "DW_DLA_ABBREV"},
+{DW_DLA_FRAME_INSTR_HEAD,"DW_DLA_FRAME_INSTR_HEAD"},
+{DW_DLA_CIE,             "DW_DLA_CIE"},
+{DW_DLA_FDE,             "DW_DLA_FDE"},
+{DW_DLA_LOC_BLOCK,       "DW_DLA_LOC_BLOCK"},
+{DW_DLA_FUNC,            "DW_DLA_FUNC"},
+{DW_DLA_UARRAY,          "DW_DLA_UARRAY"},
+{DW_DLA_VAR,             "DW_DLA_VAR"},
+{DW_DLA_WEAK,            "DW_DLA_WEAK"},
+{DW_DLA_ADDR,            "DW_DLA_ADDR"},
+{DW_DLA_RANGES,          "DW_DLA_RANGES"},
+{DW_DLA_GNU_INDEX_HEAD,  "DW_DLA_GNU_INDEX_HEAD"},
+{DW_DLA_RNGLISTS_HEAD,   "DW_DLA_RNGLISTS_HEAD"},
+{DW_DLA_GDBINDEX,        "DW_DLA_GDBINDEX"},
+{DW_DLA_XU_INDEX,        "DW_DLA_XU_INDEX"},
+{DW_DLA_LOC_BLOCK_C,     "DW_DLA_LOC_BLOCK_C"},
+{DW_DLA_LOCDESC_C,       "DW_DLA_LOCDESC_C"},
+{DW_DLA_LOC_HEAD_C,      "DW_DLA_LOC_HEAD_C"},
+{DW_DLA_MACRO_CONTEXT,   "DW_DLA_MACRO_CONTEXT"},
+{DW_DLA_DSC_HEAD,        "DW_DLA_DSC_HEAD"},
+{DW_DLA_DNAMES_HEAD,     "DW_DLA_DNAMES_HEAD"},
+{DW_DLA_STR_OFFSETS,     "DW_DLA_STR_OFFSETS"},
+{DW_DLA_DEBUG_ADDR,      "DW_DLA_DEBUG_ADDR"},
+{0,0}
+};
+
+static const char *
+get_dla_name(int n)
+{
+    struct dla_name_s *p = dla_names;
+
+    for ( ; p->dn_name; ++p) {
+        if (p->dn_number == n) {
+            return p->dn_name;
+        }
+    }
+    return 0;
+}
+
+/*  The dwarfdump check lookups (--check-ranges
+    and the like) since the last print. */
+static void
+print_check_lookup_stats(void)
+{
+    if (!glflags.pRangesInfo && !glflags.pLinkonceInfo &&
+        !glflags.pVisitedInfo) {
+        return;
+    }
+    printf("\ndwarfdump check lookup statistics\n");
+    PrintBucketGroupStats(glflags.pRangesInfo);
+    PrintBucketGroupStats(glflags.pLinkonceInfo);
+    PrintBucketGroupStats(glflags.pVisitedInfo);
+}
+
+int
+print_perf_stats(Dwarf_Debug dbg,Dwarf_Error *error)
+{
+    Dwarf_Perf_Stats st;
+    int res = 0;
+    int i = 0;
+
+    memset(&st,0,sizeof(st));
+    res = dwarf_get_perf_stats(dbg,&st,error);
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    printf("\nlibdwarf performance statistics\n");
+    if (res == DW_DLV_NO_ENTRY) {
+        printf("  Not available: libdwarf was built "
+            "without perf stats\n");
+        print_check_lookup_stats();
+        return DW_DLV_OK;
+    }
+    printf("  Sections loaded          : %" DW_PR_DUu
+        " (%" DW_PR_DUu " bytes)\n",
+        st.ps_sections_loaded, st.ps_section_bytes_loaded);
+    printf("  Sections decompressed    : %" DW_PR_DUu
+        " (%" DW_PR_DUu " bytes)\n",
+        st.ps_sections_decompressed,
+        st.ps_section_bytes_decompressed);
+    printf("  Abbrev lookups           : %" DW_PR_DUu "\n",
+        st.ps_abbrev_lookups);
+    printf("  Abbrev hash probes       : %" DW_PR_DUu "\n",
+        st.ps_abbrev_hash_probes);
+    printf("  Abbrev rehashes          : %" DW_PR_DUu "\n",
+        st.ps_abbrev_rehashes);
+    printf("  CU context lookups       : %" DW_PR_DUu "\n",
+        st.ps_cu_context_lookups);
+    printf("  CU context list steps    : %" DW_PR_DUu "\n",
+        st.ps_cu_context_list_steps);
+    printf("  Frame instr executions   : %" DW_PR_DUu "\n",
+        st.ps_frame_instr_executions);
+    printf("  Line program executions  : %" DW_PR_DUu "\n",
+        st.ps_line_program_executions);
+    printf("  Allocation bytes         : %" DW_PR_DUu "\n",
+        st.ps_alloc_bytes);
+    printf("  Allocations by type:\n");
+    for (i = 0; i < DW_PERF_ALLOC_TYPE_COUNT; ++i) {
+        const char *name = 0;
+
+        if (!st.ps_alloc_count[i]) {
+            continue;
+        }
+        name = get_dla_name(i);
+        if (name) {
+            printf("    %-24s: %" DW_PR_DUu "\n",
+                name,st.ps_alloc_count[i]);
+        } else {
+            printf("    DW_DLA 0x%02x             : %" DW_PR_DUu "\n",
+                i,st.ps_alloc_count[i]);
+        }
+    }
+    print_check_lookup_stats();
+    return DW_DLV_OK;
+}
@@ -0,0 +1,1770 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  --print-size-stats: where the bytes of .debug_info,
+    .debug_line, .debug_str, .debug_loclists and
+    .debug_rnglists go, by compilation unit, producer,
+    DIE tag and attribute form, and which types are
+    defined with the same name and size in several CUs
+    (candidates for type deduplication).
+
+    .debug_info is measured exactly: each DIE's bytes
+    (its abbreviation code and attributes) count for
+    its tag and each attribute's bytes for its form,
+    with the unit headers and the null entries ending
+    sibling chains counted apart. A .debug_str string
+    counts for the first CU referring to it, a line
+    table for the first CU whose DW_AT_stmt_list names
+    it and a DWARF5 loclists or rnglists table for the
+    first CU referring into it.  What no CU refers to
+    is left unattributed.
+
+    The CU headers are read here, then the CUs are split
+    into contiguous runs of about equal .debug_info size
+    and each run is measured by a worker process forked
+    from this one, as --file-batch does: a Dwarf_Debug
+    can not be shared between threads, but libdwarf
+    reads the object with pread() so forked copies of it
+    work independently. Each worker writes its counts to
+    a temporary file and the files are merged in CU
+    order, so the report is the same for any number of
+    workers. Small objects, and systems without fork(),
+    measure every run in this process. */
+
+#include <config.h>
+
+#include <stdio.h>  /* FILE fread() fwrite() printf() tmpfile() */
+#include <stdlib.h> /* calloc() free() qsort() realloc() */
+#include <string.h> /* memcpy() memset() strcmp() strlen() */
+
+#ifdef HAVE_STDINT_H
+#include <stdint.h> /* uintptr_t */
+#endif /* HAVE_STDINT_H */
+
+#if defined(HAVE_UNISTD_H) && !defined(_WIN32)
+#define SIZE_HAVE_FORK 1
+#include <errno.h>     /* EINTR errno */
+#include <sys/types.h> /* pid_t */
+#include <sys/wait.h>  /* waitpid() WIFEXITED() */
+#include <unistd.h>    /* _exit() fork() */
+#endif /* HAVE_UNISTD_H && !_WIN32 */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dd_globals.h"
+#include "dd_glflags.h"
+#include "dd_naming.h"
+#include "dd_sanitized.h"
+#include "dd_map.h"
+#include "dd_intern.h"
+#include "dd_compiler_info.h"
+
+/*  A worker is only worth starting for this much
+    .debug_info. */
+#ifndef SIZE_BYTES_PER_WORKER
+#define SIZE_BYTES_PER_WORKER (4*1024*1024)
+#endif /* SIZE_BYTES_PER_WORKER */
+
+/*  Longest lists printed unless -v. */
+#define SIZE_TOP_CUS   50
+#define SIZE_TOP_TYPES 100
+
+#define SIZE_NONE     ((Dwarf_Unsigned)-1)
+#define SIZE_NO_SCOPE ((size_t)-1)
+#define SIZE_MAGIC    0x5a51a757a75ULL
+
+struct size_cu_s {
+    Dwarf_Off      sc_offset;     /* of the unit header */
+    Dwarf_Off      sc_die_offset;
+    Dwarf_Unsigned sc_info_bytes;
+    Dwarf_Unsigned sc_line_bytes;
+    Dwarf_Unsigned sc_str_bytes;
+    Dwarf_Unsigned sc_loclists_bytes;
+    Dwarf_Unsigned sc_rnglists_bytes;
+    Dwarf_Unsigned sc_stmt_list;  /* or SIZE_NONE */
+    Dwarf_Unsigned sc_loclists_ref;
+    Dwarf_Unsigned sc_rnglists_ref;
+    const char    *sc_name;
+    int            sc_producer;   /* compiler index, 0 other */
+};
+
+/*  What a worker reports for each of its CUs:
+    an offset into the loclists and rnglists
+    tables used, if any. */
+struct size_cu_result_s {
+    Dwarf_Unsigned cr_index;
+    Dwarf_Unsigned cr_loclists_ref;
+    Dwarf_Unsigned cr_rnglists_ref;
+};
+
+struct size_totals_s {
+    Dwarf_Unsigned st_null_bytes;
+    Dwarf_Unsigned st_abbrev_code_bytes;
+    Dwarf_Unsigned st_failed_cus;
+    Dwarf_Unsigned st_out_of_memory;
+};
+
+/*  Bytes and count for a DIE tag or attribute form. */
+struct size_bucket_s {
+    Dwarf_Unsigned sb_key;
+    Dwarf_Unsigned sb_bytes;
+    Dwarf_Unsigned sb_count;
+};
+
+/*  A .debug_str string and the CU it counts for. */
+struct size_string_s {
+    Dwarf_Unsigned ss_offset;
+    Dwarf_Unsigned ss_len;
+    Dwarf_Unsigned ss_cu;
+};
+
+/*  Keyed by a hash of tag, size and name, with the
+    next key up tried on a collision. */
+struct size_type_s {
+    Dwarf_Unsigned ty_key;
+    Dwarf_Unsigned ty_size;
+    Dwarf_Unsigned ty_copies;   /* CUs defining it */
+    Dwarf_Unsigned ty_last_cu;  /* index+1 */
+    const char    *ty_name;     /* interned */
+    Dwarf_Half     ty_tag;
+};
+
+struct size_type_rec_s {
+    Dwarf_Unsigned tr_size;
+    Dwarf_Unsigned tr_copies;
+    Dwarf_Unsigned tr_namelen;
+    Dwarf_Unsigned tr_tag;
+};
+
+/*  The counts of a worker, and the merged counts. */
+struct size_counts_s {
+    struct size_totals_s ct_totals;
+    struct Dd_Hash_Map_s ct_tags;
+    struct Dd_Hash_Map_s ct_forms;
+    struct Dd_Hash_Map_s ct_strings;
+    struct Dd_Hash_Map_s ct_types;
+    struct Dd_Intern_s   ct_names;
+
+    /*  Worker scratch space. */
+    Dwarf_Off           *ct_attr_offs;
+    Dwarf_Unsigned       ct_attr_alloc;
+    /*  The qualified name of the current scope and,
+        by depth, its length for a scope holding types
+        worth counting (the unit or a namespace in one)
+        or SIZE_NO_SCOPE. */
+    char                *ct_scope;
+    size_t               ct_scope_alloc;
+    size_t              *ct_scope_len;
+    Dwarf_Unsigned       ct_depth_alloc;
+};
+
+struct size_stats_s {
+    Dwarf_Debug       ss_dbg;
+    struct size_cu_s *ss_cus;
+    Dwarf_Unsigned    ss_cu_count;
+    Dwarf_Unsigned    ss_cu_alloc;
+    const char       *ss_str_base;
+    Dwarf_Unsigned    ss_info_size;
+    Dwarf_Unsigned    ss_line_size;
+    Dwarf_Unsigned    ss_str_size;
+    Dwarf_Unsigned    ss_loclists_size;
+    Dwarf_Unsigned    ss_rnglists_size;
+    Dwarf_Unsigned    ss_producer_cus[COMPILER_TABLE_MAX];
+    Dwarf_Unsigned    ss_producer_bytes[COMPILER_TABLE_MAX][5];
+    struct Dd_Intern_s ss_cu_names;
+    struct size_counts_s ss_merged;
+};
+
+/*  The per-DIE results of size_measure_die(). */
+struct size_die_s {
+    Dwarf_Unsigned sd_own;    /* bytes of the DIE itself */
+    Dwarf_Unsigned sd_nulls;  /* null entries after it */
+    Dwarf_Unsigned sd_open;   /* depth after it */
+    const char    *sd_name;
+    Dwarf_Bool     sd_declaration;
+};
+
+/*  Per-CU state while measuring. */
+struct size_walk_s {
+    Dwarf_Die                cw_cu_die;
+    Dwarf_Unsigned           cw_cu;
+    Dwarf_Half               cw_version;
+    Dwarf_Half               cw_offset_size;
+    struct size_cu_result_s *cw_result;
+};
+
+static void
+size_counts_init(struct size_counts_s *c)
+{
+    memset(c,0,sizeof(*c));
+    dd_hash_map_init(&c->ct_tags,sizeof(struct size_bucket_s));
+    dd_hash_map_init(&c->ct_forms,sizeof(struct size_bucket_s));
+    dd_hash_map_init(&c->ct_strings,sizeof(struct size_string_s));
+    dd_hash_map_init(&c->ct_types,sizeof(struct size_type_s));
+}
+
+static void
+size_counts_destroy(struct size_counts_s *c)
+{
+    dd_hash_map_destroy(&c->ct_tags);
+    dd_hash_map_destroy(&c->ct_forms);
+    dd_hash_map_destroy(&c->ct_strings);
+    dd_hash_map_destroy(&c->ct_types);
+    dd_intern_destroy(&c->ct_names);
+    free(c->ct_attr_offs);
+    free(c->ct_scope);
+    free(c->ct_scope_len);
+    memset(c,0,sizeof(*c));
+}
+
+static Dwarf_Bool
+size_bucket_add(struct size_counts_s *c,struct Dd_Hash_Map_s *map,
+    Dwarf_Unsigned key,Dwarf_Unsigned bytes,Dwarf_Unsigned count)
+{
+    struct size_bucket_s *b = 0;
+
+    b = (struct size_bucket_s *)dd_hash_map_insert(map,key,0);
+    if (!b) {
+        c->ct_totals.st_out_of_memory = TRUE;
+        return FALSE;
+    }
+    b->sb_bytes += bytes;
+    b->sb_count += count;
+    return TRUE;
+}
+
+static Dwarf_Unsigned
+size_type_hash(Dwarf_Half tag,Dwarf_Unsigned size,const char *name)
+{
+    /*  FNV-1a */
+    Dwarf_Unsigned h = 14695981039346656037ULL;
+    const unsigned char *p = (const unsigned char *)name;
+
+    for ( ; *p; ++p) {
+        h ^= *p;
+        h *= 1099511628211ULL;
+    }
+    h ^= tag;
+    h *= 1099511628211ULL;
+    h ^= size;
+    h *= 1099511628211ULL;
+    return h;
+}
+
+/*  name must be interned in c->ct_names. */
+static struct size_type_s *
+size_type_entry(struct size_counts_s *c,Dwarf_Half tag,
+    Dwarf_Unsigned size,const char *name)
+{
+    Dwarf_Unsigned key = size_type_hash(tag,size,name);
+
+    for (;;) {
+        Dwarf_Bool is_new = FALSE;
+        struct size_type_s *t = 0;
+
+        t = (struct size_type_s *)dd_hash_map_insert(
+            &c->ct_types,key,&is_new);
+        if (!t) {
+            c->ct_totals.st_out_of_memory = TRUE;
+            return 0;
+        }
+        if (is_new) {
+            t->ty_tag = tag;
+            t->ty_size = size;
+            t->ty_name = name;
+            return t;
+        }
+        if (t->ty_tag == tag && t->ty_size == size &&
+            t->ty_name == name) {
+            return t;
+        }
+        ++key;
+    }
+}
+
+static Dwarf_Bool
+size_is_type_tag(Dwarf_Half tag)
+{
+    switch (tag) {
+    case DW_TAG_class_type:
+    case DW_TAG_enumeration_type:
+    case DW_TAG_structure_type:
+    case DW_TAG_typedef:
+    case DW_TAG_union_type:
+        return TRUE;
+    default:
+        break;
+    }
+    return FALSE;
+}
+
+static Dwarf_Bool
+size_note_string(struct size_stats_s *st,struct size_counts_s *c,
+    const char *s,Dwarf_Unsigned cu)
+{
+    Dwarf_Unsigned base = (Dwarf_Unsigned)(uintptr_t)st->ss_str_base;
+    Dwarf_Unsigned where = (Dwarf_Unsigned)(uintptr_t)s;
+    struct size_string_s *e = 0;
+    Dwarf_Bool is_new = FALSE;
+
+    if (!base || where < base || where - base >= st->ss_str_size) {
+        /*  Not in .debug_str. */
+        return TRUE;
+    }
+    e = (struct size_string_s *)dd_hash_map_insert(&c->ct_strings,
+        where - base,&is_new);
+    if (!e) {
+        c->ct_totals.st_out_of_memory = TRUE;
+        return FALSE;
+    }
+    if (is_new) {
+        e->ss_len = strlen(s)+1;
+        e->ss_cu = cu;
+    }
+    return TRUE;
+}
+
+/*  Counts the attributes of die, whose bytes end
+    at die_end. */
+static int
+size_measure_attrs(struct size_stats_s *st,struct size_counts_s *c,
+    struct size_walk_s *w,Dwarf_Die die,Dwarf_Half tag,
+    Dwarf_Off die_offset,Dwarf_Off die_end,
+    Dwarf_Attribute *atlist,Dwarf_Signed atcount,
+    struct size_die_s *d,Dwarf_Error *err)
+{
+    Dwarf_Signed i = 0;
+    Dwarf_Bool want_name = tag == DW_TAG_namespace ||
+        size_is_type_tag(tag);
+    int res = 0;
+
+    if ((Dwarf_Unsigned)atcount > c->ct_attr_alloc) {
+        Dwarf_Unsigned newalloc = (Dwarf_Unsigned)atcount*2;
+        Dwarf_Off *offs = 0;
+
+        offs = (Dwarf_Off *)realloc(c->ct_attr_offs,
+            newalloc*sizeof(Dwarf_Off));
+        if (!offs) {
+            c->ct_totals.st_out_of_memory = TRUE;
+            return DW_DLV_NO_ENTRY;
+        }
+        c->ct_attr_offs = offs;
+        c->ct_attr_alloc = newalloc;
+    }
+    for (i = 0; i < atcount; ++i) {
+        res = dwarf_attr_offset(die,atlist[i],&c->ct_attr_offs[i],err);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    {
+        Dwarf_Off first = atcount?c->ct_attr_offs[0]:die_end;
+
+        c->ct_totals.st_abbrev_code_bytes +=
+            first > die_offset?first - die_offset:0;
+    }
+    for (i = 0; i < atcount; ++i) {
+        Dwarf_Attribute attr = atlist[i];
+        Dwarf_Off start = c->ct_attr_offs[i];
+        Dwarf_Off end = (i+1 < atcount)?c->ct_attr_offs[i+1]:
+            die_end;
+        Dwarf_Half form = 0;
+        Dwarf_Half attrnum = 0;
+        char *s = 0;
+
+        res = dwarf_whatform(attr,&form,err);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        res = dwarf_whatattr(attr,&attrnum,err);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (!size_bucket_add(c,&c->ct_forms,form,
+            end > start?end - start:0,1)) {
+            return DW_DLV_NO_ENTRY;
+        }
+        switch (form) {
+        case DW_FORM_strp:
+        case DW_FORM_strx:
+        case DW_FORM_strx1:
+        case DW_FORM_strx2:
+        case DW_FORM_strx3:
+        case DW_FORM_strx4:
+        case DW_FORM_GNU_str_index:
+            res = dwarf_formstring(attr,&s,err);
+            if (res == DW_DLV_ERROR) {
+                return res;
+            }
+            if (res == DW_DLV_OK &&
+                !size_note_string(st,c,s,w->cw_cu)) {
+                return DW_DLV_NO_ENTRY;
+            }
+            break;
+        case DW_FORM_sec_offset:
+            if (w->cw_version >= 5) {
+                enum Dwarf_Form_Class cl = dwarf_get_form_class(
+                    w->cw_version,attrnum,w->cw_offset_size,form);
+                Dwarf_Unsigned *ref = 0;
+                Dwarf_Off o = 0;
+
+                /*  dwarf_get_form_class() calls a DWARF5
+                    DW_AT_location and the like LOCLISTPTR. */
+                if (cl == DW_FORM_CLASS_LOCLIST ||
+                    cl == DW_FORM_CLASS_LOCLISTPTR ||
+                    cl == DW_FORM_CLASS_LOCLISTSPTR) {
+                    ref = &w->cw_result->cr_loclists_ref;
+                } else if (cl == DW_FORM_CLASS_RNGLIST ||
+                    cl == DW_FORM_CLASS_RNGLISTSPTR) {
+                    ref = &w->cw_result->cr_rnglists_ref;
+                }
+                if (ref && *ref == SIZE_NONE) {
+                    res = dwarf_global_formref(attr,&o,err);
+                    if (res == DW_DLV_ERROR) {
+                        return res;
+                    }
+                    if (res == DW_DLV_OK) {
+                        *ref = o;
+                    }
+                }
+            }
+            break;
+        default:
+            break;
+        }
+        if (attrnum == DW_AT_declaration) {
+            d->sd_declaration = TRUE;
+        } else if (attrnum == DW_AT_name && want_name) {
+            if (!s) {
+                res = dwarf_formstring(attr,&s,err);
+                if (res == DW_DLV_ERROR) {
+                    return res;
+                }
+            }
+            d->sd_name = s;
+        }
+    }
+    return DW_DLV_OK;
+}
+
+/*  Counts the DIE at table index, whose bytes and
+    following null entries take gap bytes. */
+static int
+size_measure_die(struct size_stats_s *st,struct size_counts_s *c,
+    struct size_walk_s *w,Dwarf_Unsigned index,Dwarf_Half tag,
+    Dwarf_Off die_offset,Dwarf_Unsigned gap,Dwarf_Unsigned depth,
+    Dwarf_Unsigned next_depth,struct size_die_s *d,Dwarf_Error *err)
+{
+    Dwarf_Die die = 0;
+    Dwarf_Half has_child = 0;
+    Dwarf_Attribute *atlist = 0;
+    Dwarf_Signed atcount = 0;
+    Dwarf_Signed i = 0;
+    int res = 0;
+
+    memset(d,0,sizeof(*d));
+    res = dwarf_die_table_die(w->cw_cu_die,index,&die,err);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    dwarf_die_abbrev_children_flag(die,&has_child);
+    /*  The null entries before the next DIE close the
+        sibling chains from d->sd_open down to next_depth. */
+    d->sd_open = has_child?depth+1:depth;
+    d->sd_nulls = d->sd_open > next_depth?d->sd_open - next_depth:0;
+    if (d->sd_nulls > gap) {
+        d->sd_nulls = gap;
+    }
+    d->sd_own = gap - d->sd_nulls;
+    c->ct_totals.st_null_bytes += d->sd_nulls;
+    if (!size_bucket_add(c,&c->ct_tags,tag,d->sd_own,1)) {
+        dwarf_dealloc_die(die);
+        return DW_DLV_NO_ENTRY;
+    }
+    res = dwarf_attrlist(die,&atlist,&atcount,err);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_die(die);
+        return res;
+    }
+    res = size_measure_attrs(st,c,w,die,tag,die_offset,
+        die_offset+d->sd_own,atlist,atcount,d,err);
+    for (i = 0; i < atcount; ++i) {
+        dwarf_dealloc_attribute(atlist[i]);
+    }
+    if (atlist) {
+        dwarf_dealloc(st->ss_dbg,atlist,DW_DLA_LIST);
+    }
+    dwarf_dealloc_die(die);
+    return res;
+}
+
+/*  Sets the scope at depth to that at depth-1 followed
+    by name and suffix, returning the new scope string,
+    or NULL if out of memory. */
+static const char *
+size_scope_push(struct size_counts_s *c,Dwarf_Unsigned depth,
+    const char *name,const char *suffix)
+{
+    size_t plen = c->ct_scope_len[depth-1];
+    size_t nlen = strlen(name);
+    size_t slen = strlen(suffix);
+    size_t need = plen + nlen + slen + 1;
+
+    if (need > c->ct_scope_alloc) {
+        size_t newalloc = need*2;
+        char *scope = (char *)realloc(c->ct_scope,newalloc);
+
+        if (!scope) {
+            c->ct_totals.st_out_of_memory = TRUE;
+            return 0;
+        }
+        c->ct_scope = scope;
+        c->ct_scope_alloc = newalloc;
+    }
+    memcpy(c->ct_scope+plen,name,nlen);
+    memcpy(c->ct_scope+plen+nlen,suffix,slen+1);
+    c->ct_scope_len[depth] = plen + nlen + slen;
+    return c->ct_scope;
+}
+
+static Dwarf_Bool
+size_reserve_depth(struct size_counts_s *c,Dwarf_Unsigned depth)
+{
+    Dwarf_Unsigned newalloc = 0;
+    size_t *lens = 0;
+
+    if (depth < c->ct_depth_alloc) {
+        return TRUE;
+    }
+    newalloc = depth*2 + 16;
+    lens = (size_t *)realloc(c->ct_scope_len,
+        newalloc*sizeof(size_t));
+    if (!lens) {
+        c->ct_totals.st_out_of_memory = TRUE;
+        return FALSE;
+    }
+    c->ct_scope_len = lens;
+    c->ct_depth_alloc = newalloc;
+    return TRUE;
+}
+
+/*  A candidate type: named, a definition, and at
+    namespace scope. Nested types count with the
+    type holding them. */
+struct size_open_type_s {
+    Dwarf_Bool     ot_open;
+    Dwarf_Unsigned ot_depth;
+    Dwarf_Unsigned ot_size;
+    Dwarf_Half     ot_tag;
+    const char    *ot_name;
+};
+
+static Dwarf_Bool
+size_close_type(struct size_counts_s *c,
+    struct size_open_type_s *ot,Dwarf_Unsigned cu)
+{
+    struct size_type_s *t = 0;
+
+    ot->ot_open = FALSE;
+    t = size_type_entry(c,ot->ot_tag,ot->ot_size,ot->ot_name);
+    if (!t) {
+        return FALSE;
+    }
+    if (t->ty_last_cu != cu+1) {
+        t->ty_last_cu = cu+1;
+        t->ty_copies++;
+    }
+    return TRUE;
+}
+
+static int
+size_measure_cu(struct size_stats_s *st,struct size_counts_s *c,
+    Dwarf_Unsigned cuindex,struct size_cu_result_s *r,
+    Dwarf_Error *err)
+{
+    struct size_cu_s *cu = &st->ss_cus[cuindex];
+    Dwarf_Off cu_end = cu->sc_offset + cu->sc_info_bytes;
+    struct size_walk_s w;
+    struct size_open_type_s ot;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Off next_offset = 0;
+    Dwarf_Half next_tag = 0;
+    Dwarf_Unsigned next_depth = 0;
+    int res = 0;
+
+    memset(&w,0,sizeof(w));
+    memset(&ot,0,sizeof(ot));
+    w.cw_cu = cuindex;
+    w.cw_result = r;
+    res = dwarf_offdie_b(st->ss_dbg,cu->sc_die_offset,TRUE,
+        &w.cw_cu_die,err);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    dwarf_get_version_of_die(w.cw_cu_die,&w.cw_version,
+        &w.cw_offset_size);
+    res = dwarf_die_table_build(w.cw_cu_die,&count,err);
+    if (res == DW_DLV_OK && count) {
+        res = dwarf_die_table_entry(w.cw_cu_die,0,&next_offset,
+            &next_tag,0,&next_depth,0,0,0,err);
+    }
+    for (i = 0; res == DW_DLV_OK && i < count; ++i) {
+        Dwarf_Off offset = next_offset;
+        Dwarf_Half tag = next_tag;
+        Dwarf_Unsigned depth = next_depth;
+        struct size_die_s d;
+
+        if (i+1 < count) {
+            res = dwarf_die_table_entry(w.cw_cu_die,i+1,
+                &next_offset,&next_tag,0,&next_depth,0,0,0,err);
+            if (res != DW_DLV_OK) {
+                break;
+            }
+        } else {
+            next_offset = cu_end;
+            next_depth = 0;
+        }
+        if (ot.ot_open && depth <= ot.ot_depth &&
+            !size_close_type(c,&ot,cuindex)) {
+            res = DW_DLV_NO_ENTRY;
+            break;
+        }
+        res = size_measure_die(st,c,&w,i,tag,offset,
+            next_offset > offset?next_offset - offset:0,
+            depth,next_depth,&d,err);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        if (!size_reserve_depth(c,depth)) {
+            res = DW_DLV_NO_ENTRY;
+            break;
+        }
+        if (!depth) {
+            c->ct_scope_len[0] = 0;
+        } else if (c->ct_scope_len[depth-1] == SIZE_NO_SCOPE) {
+            c->ct_scope_len[depth] = SIZE_NO_SCOPE;
+        } else if (tag == DW_TAG_namespace) {
+            if (!size_scope_push(c,depth,
+                d.sd_name?d.sd_name:"(anonymous namespace)","::")) {
+                res = DW_DLV_NO_ENTRY;
+                break;
+            }
+        } else {
+            c->ct_scope_len[depth] = SIZE_NO_SCOPE;
+            if (size_is_type_tag(tag) && d.sd_name &&
+                !d.sd_declaration) {
+                const char *qual = size_scope_push(c,depth,
+                    d.sd_name,"");
+
+                if (qual) {
+                    ot.ot_name = dd_intern(&c->ct_names,qual);
+                }
+                c->ct_scope_len[depth] = SIZE_NO_SCOPE;
+                if (!qual || !ot.ot_name) {
+                    c->ct_totals.st_out_of_memory = TRUE;
+                    res = DW_DLV_NO_ENTRY;
+                    break;
+                }
+                ot.ot_open = TRUE;
+                ot.ot_depth = depth;
+                ot.ot_size = 0;
+                ot.ot_tag = tag;
+            }
+        }
+        if (ot.ot_open) {
+            /*  The DIE, and the null entries ending
+                sibling chains inside the type. */
+            Dwarf_Unsigned inner = ot.ot_depth+1;
+            Dwarf_Unsigned low = next_depth > inner?next_depth:inner;
+            Dwarf_Unsigned nulls = d.sd_open > low?d.sd_open - low:0;
+
+            if (nulls > d.sd_nulls) {
+                nulls = d.sd_nulls;
+            }
+            ot.ot_size += d.sd_own + nulls;
+        }
+    }
+    if (res == DW_DLV_OK && ot.ot_open &&
+        !size_close_type(c,&ot,cuindex)) {
+        res = DW_DLV_NO_ENTRY;
+    }
+    dwarf_dealloc_die(w.cw_cu_die);
+    return res;
+}
+
+static void
+size_write(FILE *f,const void *p,size_t len)
+{
+    fwrite(p,1,len,f);
+}
+
+static Dwarf_Bool
+size_read(FILE *f,void *p,size_t len)
+{
+    return fread(p,1,len,f) == len;
+}
+
+static void
+size_write_entry(void *entry,void *data)
+{
+    FILE *f = (FILE *)data;
+
+    /*  Only the buckets and strings are written this
+        way, both being three Dwarf_Unsigned. */
+    size_write(f,entry,sizeof(struct size_bucket_s));
+}
+
+static void
+size_write_type(void *entry,void *data)
+{
+    FILE *f = (FILE *)data;
+    struct size_type_s *t = (struct size_type_s *)entry;
+    struct size_type_rec_s rec;
+
+    memset(&rec,0,sizeof(rec));
+    rec.tr_size = t->ty_size;
+    rec.tr_copies = t->ty_copies;
+    rec.tr_namelen = strlen(t->ty_name);
+    rec.tr_tag = t->ty_tag;
+    size_write(f,&rec,sizeof(rec));
+    size_write(f,t->ty_name,(size_t)rec.tr_namelen);
+}
+
+static void
+size_write_map(FILE *f,struct Dd_Hash_Map_s *map,
+    void (*visit)(void *entry,void *data))
+{
+    Dwarf_Unsigned count = dd_hash_map_count(map);
+
+    size_write(f,&count,sizeof(count));
+    dd_hash_map_walk(map,visit,f);
+}
+
+/*  Measures CUs first to last-1 and writes the
+    counts to out. Returns FALSE if they could not
+    all be written. */
+static Dwarf_Bool
+size_measure_run(struct size_stats_s *st,Dwarf_Unsigned first,
+    Dwarf_Unsigned last,FILE *out)
+{
+    struct size_counts_s c;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned magic = SIZE_MAGIC;
+
+    size_counts_init(&c);
+    for (i = first; i < last; ++i) {
+        struct size_cu_result_s r;
+        Dwarf_Error err = 0;
+        int res = 0;
+
+        memset(&r,0,sizeof(r));
+        r.cr_index = i;
+        r.cr_loclists_ref = SIZE_NONE;
+        r.cr_rnglists_ref = SIZE_NONE;
+        if (!c.ct_totals.st_out_of_memory) {
+            res = size_measure_cu(st,&c,i,&r,&err);
+        }
+        if (res != DW_DLV_OK) {
+            c.ct_totals.st_failed_cus++;
+            DROP_ERROR_INSTANCE(st->ss_dbg,res,err);
+        }
+        size_write(out,&r,sizeof(r));
+    }
+    size_write(out,&c.ct_totals,sizeof(c.ct_totals));
+    size_write_map(out,&c.ct_tags,size_write_entry);
+    size_write_map(out,&c.ct_forms,size_write_entry);
+    size_write_map(out,&c.ct_strings,size_write_entry);
+    size_write_map(out,&c.ct_types,size_write_type);
+    size_write(out,&magic,sizeof(magic));
+    size_counts_destroy(&c);
+    fflush(out);
+    return !ferror(out);
+}
+
+static Dwarf_Bool
+size_merge_buckets(FILE *f,struct size_counts_s *m,
+    struct Dd_Hash_Map_s *map)
+{
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned i = 0;
+
+    if (!size_read(f,&count,sizeof(count))) {
+        return FALSE;
+    }
+    for (i = 0; i < count; ++i) {
+        struct size_bucket_s b;
+
+        if (!size_read(f,&b,sizeof(b)) ||
+            !size_bucket_add(m,map,b.sb_key,b.sb_bytes,b.sb_count)) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/*  Reads the counts written by size_measure_run() for
+    CUs first to last-1 and adds them to the totals.
+    Returns FALSE if the file is incomplete. */
+static Dwarf_Bool
+size_merge_run(struct size_stats_s *st,Dwarf_Unsigned first,
+    Dwarf_Unsigned last,FILE *f)
+{
+    struct size_counts_s *m = &st->ss_merged;
+    struct size_totals_s t;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned magic = 0;
+    char *name = 0;
+    Dwarf_Unsigned name_alloc = 0;
+    Dwarf_Bool ok = TRUE;
+
+    rewind(f);
+    for (i = first; i < last; ++i) {
+        struct size_cu_result_s r;
+
+        if (!size_read(f,&r,sizeof(r)) || r.cr_index != i) {
+            return FALSE;
+        }
+        st->ss_cus[i].sc_loclists_ref = r.cr_loclists_ref;
+        st->ss_cus[i].sc_rnglists_ref = r.cr_rnglists_ref;
+    }
+    if (!size_read(f,&t,sizeof(t))) {
+        return FALSE;
+    }
+    m->ct_totals.st_null_bytes += t.st_null_bytes;
+    m->ct_totals.st_abbrev_code_bytes += t.st_abbrev_code_bytes;
+    m->ct_totals.st_failed_cus += t.st_failed_cus;
+    if (t.st_out_of_memory) {
+        m->ct_totals.st_out_of_memory = TRUE;
+    }
+    if (!size_merge_buckets(f,m,&m->ct_tags) ||
+        !size_merge_buckets(f,m,&m->ct_forms)) {
+        return FALSE;
+    }
+    if (!size_read(f,&count,sizeof(count))) {
+        return FALSE;
+    }
+    for (i = 0; i < count; ++i) {
+        struct size_string_s s;
+        struct size_string_s *e = 0;
+        Dwarf_Bool is_new = FALSE;
+
+        if (!size_read(f,&s,sizeof(s)) || s.ss_cu >= last) {
+            return FALSE;
+        }
+        e = (struct size_string_s *)dd_hash_map_insert(
+            &m->ct_strings,s.ss_offset,&is_new);
+        if (!e) {
+            m->ct_totals.st_out_of_memory = TRUE;
+            return FALSE;
+        }
+        if (is_new) {
+            /*  Earlier runs merged first: the first CU
+                using the string gets it. */
+            e->ss_len = s.ss_len;
+            e->ss_cu = s.ss_cu;
+        }
+    }
+    if (!size_read(f,&count,sizeof(count))) {
+        return FALSE;
+    }
+    for (i = 0; ok && i < count; ++i) {
+        struct size_type_rec_s rec;
+        struct size_type_s *t2 = 0;
+        const char *iname = 0;
+
+        if (!size_read(f,&rec,sizeof(rec))) {
+            ok = FALSE;
+            break;
+        }
+        if (rec.tr_namelen >= name_alloc) {
+            char *newname = (char *)realloc(name,
+                (size_t)rec.tr_namelen+1);
+
+            if (!newname) {
+                m->ct_totals.st_out_of_memory = TRUE;
+                ok = FALSE;
+                break;
+            }
+            name = newname;
+            name_alloc = rec.tr_namelen+1;
+        }
+        if (!size_read(f,name,(size_t)rec.tr_namelen)) {
+            ok = FALSE;
+            break;
+        }
+        name[rec.tr_namelen] = 0;
+        iname = dd_intern(&m->ct_names,name);
+        if (!iname) {
+            m->ct_totals.st_out_of_memory = TRUE;
+            ok = FALSE;
+            break;
+        }
+        t2 = size_type_entry(m,(Dwarf_Half)rec.tr_tag,rec.tr_size,
+            iname);
+        if (!t2) {
+            ok = FALSE;
+            break;
+        }
+        t2->ty_copies += rec.tr_copies;
+    }
+    free(name);
+    if (!ok) {
+        return FALSE;
+    }
+    return size_read(f,&magic,sizeof(magic)) && magic == SIZE_MAGIC;
+}
+
+#ifdef SIZE_HAVE_FORK
+/*  Starts a worker measuring CUs first to last-1 into
+    out. Returns its pid, or -1 if there is none (in
+    which case the CUs have been measured here). */
+static pid_t
+size_start_worker(struct size_stats_s *st,Dwarf_Unsigned first,
+    Dwarf_Unsigned last,FILE *out)
+{
+    pid_t pid = 0;
+
+    /*  Anything buffered would otherwise be
+        written again by the worker. */
+    fflush(stdout);
+    pid = fork();
+    if (pid == 0) {
+        _exit(size_measure_run(st,first,last,out)?0:1);
+    }
+    if (pid < 0) {
+        size_measure_run(st,first,last,out);
+        return -1;
+    }
+    return pid;
+}
+#endif /* SIZE_HAVE_FORK */
+
+/*  Measures every CU, with up to jobs workers, and
+    merges the counts. Returns FALSE (having printed
+    why) if something could not be measured. */
+static Dwarf_Bool
+size_measure_all(struct size_stats_s *st,unsigned jobs)
+{
+    Dwarf_Unsigned *firsts = 0;
+    FILE **files = 0;
+#ifdef SIZE_HAVE_FORK
+    pid_t *pids = 0;
+#endif /* SIZE_HAVE_FORK */
+    Dwarf_Unsigned per_job = st->ss_info_size/jobs;
+    Dwarf_Unsigned done_bytes = 0;
+    Dwarf_Unsigned i = 0;
+    unsigned runs = 0;
+    unsigned k = 0;
+    Dwarf_Bool ok = TRUE;
+
+    firsts = (Dwarf_Unsigned *)calloc(jobs+1,sizeof(Dwarf_Unsigned));
+    files = (FILE **)calloc(jobs,sizeof(FILE *));
+#ifdef SIZE_HAVE_FORK
+    pids = (pid_t *)calloc(jobs,sizeof(pid_t));
+    if (!pids) {
+        free(firsts);
+        firsts = 0;
+    }
+#endif /* SIZE_HAVE_FORK */
+    if (!firsts || !files) {
+        printf("ERROR: out of memory starting the size "
+            "statistics\n");
+        free(firsts);
+        free(files);
+        return FALSE;
+    }
+    /*  Contiguous runs of about per_job bytes each. */
+    for (i = 0; i < st->ss_cu_count; ++i) {
+        if (i && done_bytes >= per_job*runs && runs < jobs) {
+            firsts[runs++] = i;
+        } else if (!i) {
+            firsts[runs++] = 0;
+        }
+        done_bytes += st->ss_cus[i].sc_info_bytes;
+    }
+    firsts[runs] = st->ss_cu_count;
+
+    for (k = 0; k < runs; ++k) {
+        files[k] = tmpfile();
+        if (!files[k]) {
+            printf("ERROR: can not create a temporary file "
+                "for the size statistics\n");
+            ok = FALSE;
+            break;
+        }
+#ifdef SIZE_HAVE_FORK
+        if (runs > 1) {
+            pids[k] = size_start_worker(st,firsts[k],firsts[k+1],
+                files[k]);
+            continue;
+        }
+#endif /* SIZE_HAVE_FORK */
+        size_measure_run(st,firsts[k],firsts[k+1],files[k]);
+    }
+#ifdef SIZE_HAVE_FORK
+    for (k = 0; k < runs; ++k) {
+        int status = 0;
+
+        if (pids[k] <= 0) {
+            continue;
+        }
+        while (waitpid(pids[k],&status,0) < 0) {
+            if (errno != EINTR) {
+                status = 1;
+                break;
+            }
+        }
+        if (!WIFEXITED(status) || WEXITSTATUS(status)) {
+            printf("ERROR: size statistics worker for CUs "
+                "%" DW_PR_DUu " to %" DW_PR_DUu " failed\n",
+                firsts[k],firsts[k+1]-1);
+            ok = FALSE;
+        }
+    }
+    free(pids);
+#endif /* SIZE_HAVE_FORK */
+    for (k = 0; ok && k < runs; ++k) {
+        if (!size_merge_run(st,firsts[k],firsts[k+1],files[k])) {
+            printf("ERROR: size statistics for CUs "
+                "%" DW_PR_DUu " to %" DW_PR_DUu " are incomplete\n",
+                firsts[k],firsts[k+1]-1);
+            ok = FALSE;
+        }
+    }
+    for (k = 0; k < runs; ++k) {
+        if (files[k]) {
+            fclose(files[k]);
+        }
+    }
+    free(files);
+    free(firsts);
+    return ok;
+}
+
+/*  Reads the unit headers and what the CU DIEs say
+    about producer and line table. */
+static int
+size_read_cus(struct size_stats_s *st,Dwarf_Error *err)
+{
+    for (;;) {
+        Dwarf_Die cu_die = 0;
+        Dwarf_Unsigned length = 0;
+        Dwarf_Half version = 0;
+        Dwarf_Off abbrev_off = 0;
+        Dwarf_Half address_size = 0;
+        Dwarf_Half length_size = 0;
+        Dwarf_Half extension_size = 0;
+        Dwarf_Sig8 signature;
+        Dwarf_Unsigned typeoffset = 0;
+        Dwarf_Unsigned next_off = 0;
+        Dwarf_Half unit_type = 0;
+        Dwarf_Off cu_len = 0;
+        Dwarf_Attribute attr = 0;
+        struct size_cu_s *cu = 0;
+        char *s = 0;
+        int res = 0;
+
+        memset(&signature,0,sizeof(signature));
+        res = dwarf_next_cu_header_e(st->ss_dbg,TRUE,&cu_die,
+            &length,&version,&abbrev_off,&address_size,
+            &length_size,&extension_size,&signature,
+            &typeoffset,&next_off,&unit_type,err);
+        if (res == DW_DLV_NO_ENTRY) {
+            return DW_DLV_OK;
+        }
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (st->ss_cu_count >= st->ss_cu_alloc) {
+            Dwarf_Unsigned newalloc = st->ss_cu_alloc?
+                st->ss_cu_alloc*2:256;
+            struct size_cu_s *cus = 0;
+
+            cus = (struct size_cu_s *)realloc(st->ss_cus,
+                (size_t)newalloc*sizeof(struct size_cu_s));
+            if (!cus) {
+                dwarf_dealloc_die(cu_die);
+                printf("ERROR: out of memory recording CUs "
+                    "for the size statistics\n");
+                return DW_DLV_NO_ENTRY;
+            }
+            st->ss_cus = cus;
+            st->ss_cu_alloc = newalloc;
+        }
+        cu = &st->ss_cus[st->ss_cu_count];
+        memset(cu,0,sizeof(*cu));
+        cu->sc_stmt_list = SIZE_NONE;
+        res = dwarf_die_CU_offset_range(cu_die,&cu->sc_offset,
+            &cu_len,err);
+        if (res == DW_DLV_OK) {
+            res = dwarf_dieoffset(cu_die,&cu->sc_die_offset,err);
+        }
+        if (res != DW_DLV_OK) {
+            dwarf_dealloc_die(cu_die);
+            return res;
+        }
+        cu->sc_info_bytes = cu_len;
+        res = dwarf_diename(cu_die,&s,err);
+        if (res == DW_DLV_OK) {
+            cu->sc_name = dd_intern(&st->ss_cu_names,s);
+        }
+        DROP_ERROR_INSTANCE(st->ss_dbg,res,*err);
+        res = dwarf_die_text(cu_die,DW_AT_producer,&s,err);
+        DROP_ERROR_INSTANCE(st->ss_dbg,res,*err);
+        update_compiler_target(res == DW_DLV_OK?s:
+            "<no DW_AT_producer>");
+        cu->sc_producer = current_compiler_index();
+        res = dwarf_attr(cu_die,DW_AT_stmt_list,&attr,err);
+        if (res == DW_DLV_OK) {
+            Dwarf_Off off = 0;
+            Dwarf_Unsigned uoff = 0;
+
+            res = dwarf_global_formref(attr,&off,err);
+            if (res == DW_DLV_OK) {
+                cu->sc_stmt_list = off;
+            } else {
+                DROP_ERROR_INSTANCE(st->ss_dbg,res,*err);
+                res = dwarf_formudata(attr,&uoff,err);
+                if (res == DW_DLV_OK) {
+                    cu->sc_stmt_list = uoff;
+                }
+            }
+            dwarf_dealloc_attribute(attr);
+        }
+        DROP_ERROR_INSTANCE(st->ss_dbg,res,*err);
+        dwarf_dealloc_die(cu_die);
+        st->ss_cu_count++;
+    }
+}
+
+static void
+size_collect_string(void *entry,void *data)
+{
+    struct size_string_s **next = (struct size_string_s **)data;
+
+    memcpy(*next,entry,sizeof(struct size_string_s));
+    ++*next;
+}
+
+static int
+size_string_compare(const void *l,const void *r)
+{
+    const struct size_string_s *a = (const struct size_string_s *)l;
+    const struct size_string_s *b = (const struct size_string_s *)r;
+
+    if (a->ss_offset != b->ss_offset) {
+        return a->ss_offset < b->ss_offset?-1:1;
+    }
+    return 0;
+}
+
+/*  A compiler may merge a string into the tail of
+    a longer one, so the strings are taken in section
+    order and only bytes no earlier string covered
+    are counted. */
+static void
+size_attribute_strings(struct size_stats_s *st)
+{
+    struct Dd_Hash_Map_s *map = &st->ss_merged.ct_strings;
+    Dwarf_Unsigned count = dd_hash_map_count(map);
+    struct size_string_s *strs = 0;
+    struct size_string_s *next = 0;
+    Dwarf_Unsigned covered = 0;
+    Dwarf_Unsigned i = 0;
+
+    if (!count) {
+        return;
+    }
+    strs = (struct size_string_s *)calloc((size_t)count,
+        sizeof(struct size_string_s));
+    if (!strs) {
+        printf("ERROR: out of memory attributing "
+            ".debug_str\n");
+        return;
+    }
+    next = strs;
+    dd_hash_map_walk(map,size_collect_string,&next);
+    qsort(strs,(size_t)count,sizeof(struct size_string_s),
+        size_string_compare);
+    for (i = 0; i < count; ++i) {
+        Dwarf_Unsigned start = strs[i].ss_offset;
+        Dwarf_Unsigned end = start + strs[i].ss_len;
+
+        if (start < covered) {
+            start = covered;
+        }
+        if (end > start) {
+            st->ss_cus[strs[i].ss_cu].sc_str_bytes += end - start;
+            covered = end;
+        }
+    }
+    free(strs);
+}
+
+struct size_line_ref_s {
+    Dwarf_Unsigned lr_offset;
+    Dwarf_Unsigned lr_cu;
+};
+
+static int
+size_line_ref_compare(const void *l,const void *r)
+{
+    const struct size_line_ref_s *a = (const struct size_line_ref_s *)l;
+    const struct size_line_ref_s *b = (const struct size_line_ref_s *)r;
+
+    if (a->lr_offset != b->lr_offset) {
+        return a->lr_offset < b->lr_offset?-1:1;
+    }
+    if (a->lr_cu != b->lr_cu) {
+        return a->lr_cu < b->lr_cu?-1:1;
+    }
+    return 0;
+}
+
+/*  Line tables have no index: each runs from its
+    DW_AT_stmt_list offset to the next one (or the
+    section end). */
+static void
+size_attribute_lines(struct size_stats_s *st)
+{
+    struct size_line_ref_s *refs = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned i = 0;
+
+    if (!st->ss_cu_count) {
+        return;
+    }
+    refs = (struct size_line_ref_s *)calloc((size_t)st->ss_cu_count,
+        sizeof(struct size_line_ref_s));
+    if (!refs) {
+        printf("ERROR: out of memory attributing "
+            ".debug_line\n");
+        return;
+    }
+    for (i = 0; i < st->ss_cu_count; ++i) {
+        if (st->ss_cus[i].sc_stmt_list < st->ss_line_size) {
+            refs[count].lr_offset = st->ss_cus[i].sc_stmt_list;
+            refs[count].lr_cu = i;
+            ++count;
+        }
+    }
+    qsort(refs,(size_t)count,sizeof(struct size_line_ref_s),
+        size_line_ref_compare);
+    for (i = 0; i < count; ++i) {
+        Dwarf_Unsigned end = st->ss_line_size;
+        Dwarf_Unsigned j = i+1;
+
+        if (i && refs[i-1].lr_offset == refs[i].lr_offset) {
+            continue;
+        }
+        for ( ; j < count; ++j) {
+            if (refs[j].lr_offset != refs[i].lr_offset) {
+                end = refs[j].lr_offset;
+                break;
+            }
+        }
+        st->ss_cus[refs[i].lr_cu].sc_line_bytes +=
+            end - refs[i].lr_offset;
+    }
+    free(refs);
+}
+
+/*  Gives each DWARF5 loclists (is_loc) or rnglists
+    table to the first CU referring into it. */
+static void
+size_attribute_lists(struct size_stats_s *st,Dwarf_Bool is_loc)
+{
+    Dwarf_Unsigned tables = 0;
+    Dwarf_Unsigned t = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    if (is_loc) {
+        res = dwarf_load_loclists(st->ss_dbg,&tables,&err);
+    } else {
+        res = dwarf_load_rnglists(st->ss_dbg,&tables,&err);
+    }
+    if (res != DW_DLV_OK) {
+        DROP_ERROR_INSTANCE(st->ss_dbg,res,err);
+        return;
+    }
+    for (t = 0; t < tables; ++t) {
+        Dwarf_Unsigned header = 0;
+        Dwarf_Small offset_size = 0;
+        Dwarf_Small extension_size = 0;
+        unsigned version = 0;
+        Dwarf_Small address_size = 0;
+        Dwarf_Small selector_size = 0;
+        Dwarf_Unsigned entry_count = 0;
+        Dwarf_Unsigned offsets = 0;
+        Dwarf_Unsigned first = 0;
+        Dwarf_Unsigned past = 0;
+
+        if (is_loc) {
+            res = dwarf_get_loclist_context_basics(st->ss_dbg,t,
+                &header,&offset_size,&extension_size,&version,
+                &address_size,&selector_size,&entry_count,
+                &offsets,&first,&past,&err);
+        } else {
+            res = dwarf_get_rnglist_context_basics(st->ss_dbg,t,
+                &header,&offset_size,&extension_size,&version,
+                &address_size,&selector_size,&entry_count,
+                &offsets,&first,&past,&err);
+        }
+        if (res != DW_DLV_OK) {
+            DROP_ERROR_INSTANCE(st->ss_dbg,res,err);
+            return;
+        }
+        for (i = 0; i < st->ss_cu_count; ++i) {
+            struct size_cu_s *cu = &st->ss_cus[i];
+            Dwarf_Unsigned ref = is_loc?cu->sc_loclists_ref:
+                cu->sc_rnglists_ref;
+
+            if (ref != SIZE_NONE && ref >= header && ref < past) {
+                if (is_loc) {
+                    cu->sc_loclists_bytes += past - header;
+                } else {
+                    cu->sc_rnglists_bytes += past - header;
+                }
+                break;
+            }
+        }
+    }
+}
+
+static double
+size_percent(Dwarf_Unsigned part,Dwarf_Unsigned whole)
+{
+    if (!whole) {
+        return 0.0;
+    }
+    return (double)part*100.0/(double)whole;
+}
+
+static Dwarf_Unsigned
+size_cu_total(struct size_cu_s *cu)
+{
+    return cu->sc_info_bytes + cu->sc_line_bytes +
+        cu->sc_str_bytes + cu->sc_loclists_bytes +
+        cu->sc_rnglists_bytes;
+}
+
+struct size_order_s {
+    Dwarf_Unsigned so_bytes;
+    Dwarf_Unsigned so_index;
+};
+
+/*  Largest first, then by index so the order does
+    not depend on qsort(). */
+static int
+size_order_compare(const void *l,const void *r)
+{
+    const struct size_order_s *a = (const struct size_order_s *)l;
+    const struct size_order_s *b = (const struct size_order_s *)r;
+
+    if (a->so_bytes != b->so_bytes) {
+        return a->so_bytes > b->so_bytes?-1:1;
+    }
+    if (a->so_index != b->so_index) {
+        return a->so_index < b->so_index?-1:1;
+    }
+    return 0;
+}
+
+static void
+size_print_sections(struct size_stats_s *st)
+{
+    Dwarf_Unsigned sums[5];
+    Dwarf_Unsigned sizes[5];
+    static const char *names[5] = {
+        ".debug_info", ".debug_line", ".debug_str",
+        ".debug_loclists", ".debug_rnglists"};
+    Dwarf_Unsigned i = 0;
+    int k = 0;
+
+    memset(sums,0,sizeof(sums));
+    for (i = 0; i < st->ss_cu_count; ++i) {
+        struct size_cu_s *cu = &st->ss_cus[i];
+
+        sums[0] += cu->sc_info_bytes;
+        sums[1] += cu->sc_line_bytes;
+        sums[2] += cu->sc_str_bytes;
+        sums[3] += cu->sc_loclists_bytes;
+        sums[4] += cu->sc_rnglists_bytes;
+    }
+    sizes[0] = st->ss_info_size;
+    sizes[1] = st->ss_line_size;
+    sizes[2] = st->ss_str_size;
+    sizes[3] = st->ss_loclists_size;
+    sizes[4] = st->ss_rnglists_size;
+    printf("\nSize statistics for %" DW_PR_DUu
+        " compilation units\n",st->ss_cu_count);
+    printf("  %-16s %12s %12s\n","section","bytes","in CUs");
+    for (k = 0; k < 5; ++k) {
+        printf("  %-16s %12" DW_PR_DUu " %12" DW_PR_DUu
+            " %5.1f%%\n",names[k],sizes[k],sums[k],
+            size_percent(sums[k],sizes[k]));
+    }
+}
+
+static void
+size_print_cus(struct size_stats_s *st)
+{
+    struct size_order_s *order = 0;
+    Dwarf_Unsigned shown = st->ss_cu_count;
+    Dwarf_Unsigned i = 0;
+
+    if (!st->ss_cu_count) {
+        return;
+    }
+    order = (struct size_order_s *)calloc((size_t)st->ss_cu_count,
+        sizeof(struct size_order_s));
+    if (!order) {
+        printf("ERROR: out of memory sorting CUs\n");
+        return;
+    }
+    for (i = 0; i < st->ss_cu_count; ++i) {
+        order[i].so_bytes = size_cu_total(&st->ss_cus[i]);
+        order[i].so_index = i;
+    }
+    qsort(order,(size_t)st->ss_cu_count,sizeof(struct size_order_s),
+        size_order_compare);
+    if (!glflags.verbose && shown > SIZE_TOP_CUS) {
+        shown = SIZE_TOP_CUS;
+    }
+    printf("\nCompilation units by size (%" DW_PR_DUu
+        " of %" DW_PR_DUu ")\n",shown,st->ss_cu_count);
+    printf("  %10s %10s %10s %10s %10s %10s  %s\n",
+        "total","info","line","str","loclists","rnglists",
+        "CU offset and name");
+    for (i = 0; i < shown; ++i) {
+        struct size_cu_s *cu = &st->ss_cus[order[i].so_index];
+
+        printf("  %10" DW_PR_DUu " %10" DW_PR_DUu " %10" DW_PR_DUu
+            " %10" DW_PR_DUu " %10" DW_PR_DUu " %10" DW_PR_DUu
+            "  0x%" DW_PR_XZEROS DW_PR_DUx " %s\n",
+            order[i].so_bytes,cu->sc_info_bytes,cu->sc_line_bytes,
+            cu->sc_str_bytes,cu->sc_loclists_bytes,
+            cu->sc_rnglists_bytes,(Dwarf_Unsigned)cu->sc_offset,
+            cu->sc_name?sanitized(cu->sc_name):"<no DW_AT_name>");
+    }
+    free(order);
+}
+
+static void
+size_print_producers(struct size_stats_s *st)
+{
+    struct size_order_s order[COMPILER_TABLE_MAX];
+    Dwarf_Unsigned i = 0;
+    int count = 0;
+    int k = 0;
+
+    for (i = 0; i < st->ss_cu_count; ++i) {
+        struct size_cu_s *cu = &st->ss_cus[i];
+        Dwarf_Unsigned *b = st->ss_producer_bytes[cu->sc_producer];
+
+        st->ss_producer_cus[cu->sc_producer]++;
+        b[0] += cu->sc_info_bytes;
+        b[1] += cu->sc_line_bytes;
+        b[2] += cu->sc_str_bytes;
+        b[3] += cu->sc_loclists_bytes;
+        b[4] += cu->sc_rnglists_bytes;
+    }
+    for (k = 0; k < COMPILER_TABLE_MAX; ++k) {
+        Dwarf_Unsigned *b = st->ss_producer_bytes[k];
+
+        if (!st->ss_producer_cus[k]) {
+            continue;
+        }
+        order[count].so_bytes = b[0]+b[1]+b[2]+b[3]+b[4];
+        order[count].so_index = (Dwarf_Unsigned)k;
+        ++count;
+    }
+    qsort(order,(size_t)count,sizeof(struct size_order_s),
+        size_order_compare);
+    printf("\nProducers by size\n");
+    printf("  %6s %10s %10s %10s %10s %10s %10s  %s\n",
+        "CUs","total","info","line","str","loclists","rnglists",
+        "producer");
+    for (k = 0; k < count; ++k) {
+        int p = (int)order[k].so_index;
+        Dwarf_Unsigned *b = st->ss_producer_bytes[p];
+        const char *name = compiler_name_by_index(p);
+
+        printf("  %6" DW_PR_DUu " %10" DW_PR_DUu " %10" DW_PR_DUu
+            " %10" DW_PR_DUu " %10" DW_PR_DUu " %10" DW_PR_DUu
+            " %10" DW_PR_DUu "  %s\n",
+            st->ss_producer_cus[p],order[k].so_bytes,
+            b[0],b[1],b[2],b[3],b[4],
+            name?sanitized(name):"<other producers>");
+    }
+}
+
+struct size_collect_s {
+    struct size_order_s *co_order;
+    void               **co_entries;
+    Dwarf_Unsigned       co_count;
+};
+
+static void
+size_collect_bucket(void *entry,void *data)
+{
+    struct size_collect_s *co = (struct size_collect_s *)data;
+    struct size_bucket_s *b = (struct size_bucket_s *)entry;
+
+    co->co_order[co->co_count].so_bytes = b->sb_bytes;
+    co->co_order[co->co_count].so_index = b->sb_key;
+    co->co_count++;
+}
+
+/*  Prints tag (is_tag) or form buckets, largest first. */
+static void
+size_print_buckets(struct size_stats_s *st,Dwarf_Bool is_tag)
+{
+    struct size_counts_s *m = &st->ss_merged;
+    struct Dd_Hash_Map_s *map = is_tag?&m->ct_tags:&m->ct_forms;
+    struct size_collect_s co;
+    Dwarf_Unsigned i = 0;
+
+    memset(&co,0,sizeof(co));
+    co.co_order = (struct size_order_s *)calloc(
+        (size_t)dd_hash_map_count(map)+1,sizeof(struct size_order_s));
+    if (!co.co_order) {
+        printf("ERROR: out of memory sorting sizes\n");
+        return;
+    }
+    dd_hash_map_walk(map,size_collect_bucket,&co);
+    qsort(co.co_order,(size_t)co.co_count,sizeof(struct size_order_s),
+        size_order_compare);
+    printf("\n.debug_info bytes by %s\n",
+        is_tag?"DIE tag":"attribute form");
+    printf("  %12s %6s %10s  %s\n","bytes","%","count",
+        is_tag?"tag":"form");
+    for (i = 0; i < co.co_count; ++i) {
+        Dwarf_Unsigned key = co.co_order[i].so_index;
+        struct size_bucket_s *b = 0;
+
+        b = (struct size_bucket_s *)dd_hash_map_find(map,key);
+        printf("  %12" DW_PR_DUu " %5.1f%% %10" DW_PR_DUu "  %s\n",
+            b->sb_bytes,size_percent(b->sb_bytes,st->ss_info_size),
+            b->sb_count,
+            is_tag?get_TAG_name((unsigned)key,FALSE):
+            get_FORM_name((unsigned)key,FALSE));
+    }
+    if (is_tag) {
+        Dwarf_Unsigned headers = 0;
+
+        for (i = 0; i < st->ss_cu_count; ++i) {
+            headers += st->ss_cus[i].sc_die_offset -
+                st->ss_cus[i].sc_offset;
+        }
+        printf("  %12" DW_PR_DUu " %5.1f%% %10" DW_PR_DUu "  %s\n",
+            headers,size_percent(headers,st->ss_info_size),
+            st->ss_cu_count,"(unit headers)");
+        printf("  %12" DW_PR_DUu " %5.1f%% %10" DW_PR_DUu "  %s\n",
+            m->ct_totals.st_null_bytes,
+            size_percent(m->ct_totals.st_null_bytes,st->ss_info_size),
+            m->ct_totals.st_null_bytes,"(null entries)");
+    } else {
+        printf("  %12" DW_PR_DUu " %5.1f%% %10s  %s\n",
+            m->ct_totals.st_abbrev_code_bytes,
+            size_percent(m->ct_totals.st_abbrev_code_bytes,
+                st->ss_info_size),
+            "","(abbreviation codes)");
+    }
+    free(co.co_order);
+}
+
+static void
+size_collect_type(void *entry,void *data)
+{
+    struct size_collect_s *co = (struct size_collect_s *)data;
+    struct size_type_s *t = (struct size_type_s *)entry;
+
+    if (t->ty_copies < 2) {
+        return;
+    }
+    co->co_entries[co->co_count++] = t;
+}
+
+/*  Most excess bytes first, then by name, tag
+    and size. */
+static int
+size_type_compare(const void *l,const void *r)
+{
+    const struct size_type_s *a = *(const struct size_type_s *const*)l;
+    const struct size_type_s *b = *(const struct size_type_s *const*)r;
+    Dwarf_Unsigned ax = (a->ty_copies-1)*a->ty_size;
+    Dwarf_Unsigned bx = (b->ty_copies-1)*b->ty_size;
+    int c = 0;
+
+    if (ax != bx) {
+        return ax > bx?-1:1;
+    }
+    c = strcmp(a->ty_name,b->ty_name);
+    if (c) {
+        return c;
+    }
+    if (a->ty_tag != b->ty_tag) {
+        return a->ty_tag < b->ty_tag?-1:1;
+    }
+    if (a->ty_size != b->ty_size) {
+        return a->ty_size < b->ty_size?-1:1;
+    }
+    return 0;
+}
+
+static void
+size_print_types(struct size_stats_s *st)
+{
+    struct size_counts_s *m = &st->ss_merged;
+    struct size_collect_s co;
+    Dwarf_Unsigned shown = 0;
+    Dwarf_Unsigned excess = 0;
+    Dwarf_Unsigned i = 0;
+
+    memset(&co,0,sizeof(co));
+    co.co_entries = (void **)calloc(
+        (size_t)dd_hash_map_count(&m->ct_types)+1,sizeof(void *));
+    if (!co.co_entries) {
+        printf("ERROR: out of memory sorting types\n");
+        return;
+    }
+    dd_hash_map_walk(&m->ct_types,size_collect_type,&co);
+    qsort(co.co_entries,(size_t)co.co_count,sizeof(void *),
+        size_type_compare);
+    for (i = 0; i < co.co_count; ++i) {
+        struct size_type_s *t = (struct size_type_s *)co.co_entries[i];
+
+        excess += (t->ty_copies-1)*t->ty_size;
+    }
+    shown = co.co_count;
+    if (!glflags.verbose && shown > SIZE_TOP_TYPES) {
+        shown = SIZE_TOP_TYPES;
+    }
+    printf("\nDuplicate type candidates (%" DW_PR_DUu " of %"
+        DW_PR_DUu ", %" DW_PR_DUu " bytes in extra copies)\n",
+        shown,co.co_count,excess);
+    printf("  %12s %10s %8s  %s\n","excess","size","copies",
+        "tag and name");
+    for (i = 0; i < shown; ++i) {
+        struct size_type_s *t = (struct size_type_s *)co.co_entries[i];
+
+        printf("  %12" DW_PR_DUu " %10" DW_PR_DUu " %8" DW_PR_DUu
+            "  %s %s\n",
+            (t->ty_copies-1)*t->ty_size,t->ty_size,t->ty_copies,
+            get_TAG_name(t->ty_tag,FALSE),sanitized(t->ty_name));
+    }
+    free(co.co_entries);
+}
+
+int
+print_size_stats(Dwarf_Debug dbg,Dwarf_Error *err)
+{
+    struct size_stats_s *st = 0;
+    Dwarf_Unsigned unused = 0;
+    Dwarf_Signed len = 0;
+    char *str = 0;
+    unsigned jobs = 0;
+    int res = 0;
+
+    st = (struct size_stats_s *)calloc(1,sizeof(*st));
+    if (!st) {
+        printf("ERROR: out of memory starting the size "
+            "statistics\n");
+        glflags.gf_count_major_errors++;
+        return DW_DLV_NO_ENTRY;
+    }
+    st->ss_dbg = dbg;
+    size_counts_init(&st->ss_merged);
+    res = dwarf_get_section_max_offsets_d(dbg,
+        &st->ss_info_size,&unused,&st->ss_line_size,&unused,&unused,
+        &unused,&unused,&st->ss_str_size,&unused,&unused,
+        &unused,&unused,&unused,&unused,&unused,
+        &unused,&unused,&unused,&st->ss_loclists_size,
+        &st->ss_rnglists_size);
+    if (res == DW_DLV_OK && st->ss_str_size) {
+        /*  The strings dwarf_formstring() returns lie in
+            the loaded .debug_str, which begins here. */
+        res = dwarf_get_str(dbg,0,&str,&len,err);
+        if (res == DW_DLV_OK) {
+            st->ss_str_base = str;
+        }
+        DROP_ERROR_INSTANCE(dbg,res,*err);
+    }
+    res = size_read_cus(st,err);
+    if (res == DW_DLV_OK) {
+        jobs = batch_default_jobs();
+        if (jobs > st->ss_info_size/SIZE_BYTES_PER_WORKER) {
+            jobs = (unsigned)(st->ss_info_size/SIZE_BYTES_PER_WORKER);
+        }
+        if (jobs > st->ss_cu_count) {
+            jobs = (unsigned)st->ss_cu_count;
+        }
+        if (!jobs) {
+            jobs = 1;
+        }
+        if (size_measure_all(st,jobs)) {
+            size_attribute_strings(st);
+            size_attribute_lines(st);
+            size_attribute_lists(st,TRUE);
+            size_attribute_lists(st,FALSE);
+            size_print_sections(st);
+            size_print_cus(st);
+            size_print_producers(st);
+            size_print_buckets(st,TRUE);
+            size_print_buckets(st,FALSE);
+            size_print_types(st);
+            if (st->ss_merged.ct_totals.st_failed_cus) {
+                printf("\nERROR: %" DW_PR_DUu " CUs could not be "
+                    "fully measured\n",
+                    st->ss_merged.ct_totals.st_failed_cus);
+                glflags.gf_count_major_errors++;
+            }
+            if (st->ss_merged.ct_totals.st_out_of_memory) {
+                printf("\nERROR: out of memory, the size "
+                    "statistics are incomplete\n");
+                glflags.gf_count_major_errors++;
+            }
+        } else {
+            glflags.gf_count_major_errors++;
+        }
+    }
+    size_counts_destroy(&st->ss_merged);
+    dd_intern_destroy(&st->ss_cu_names);
+    free(st->ss_cus);
+    free(st);
+    return res;
+}
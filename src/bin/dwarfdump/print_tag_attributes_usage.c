@@ -44,6 +44,7 @@ Portions Copyright 2007-2021 David Anderson. All rights reserved.
 #include "dd_sanitized.h"
 #include "print_frames.h"  /* for print_expression_operations() . */
 #include "dd_macrocheck.h"
+#include "dd_map.h"
 #include "dd_helpertree.h"
 #include "dd_tag_common.h"
 #include "dd_attr_form.h"
@@ -0,0 +1,375 @@
+/*
+  Copyright (C) 2026 David Anderson.
+  This source code is placed in the Public Domain.
+  It may be copied or used in any way without restriction.
+*/
+/*  allocbench.c
+    An example of dwarf_set_allocator() that also serves
+    as a benchmark: it walks every DIE and attribute
+    in .debug_info a number of times, first with the
+    default malloc()/free() and then with a simple bump
+    allocator, and reports DIEs walked per second
+    for each.
+
+    To use, try
+        make
+        ./allocbench --iterations=20 ./allocbench
+*/
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* atoi() exit() free() malloc() */
+#include <string.h> /* memset() strncmp() */
+#include <time.h>   /* clock() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+
+/*  The bump allocator hands out memory from large
+    chunks and never frees anything individually.
+    All chunks are released after dwarf_finish(). */
+#define BUMP_CHUNK_SIZE (4*1024*1024)
+#define BUMP_ALIGN 16
+
+struct bump_chunk_s {
+    struct bump_chunk_s *bc_next;
+    Dwarf_Unsigned       bc_size;
+    Dwarf_Unsigned       bc_used;
+};
+struct bump_arena_s {
+    struct bump_chunk_s *ba_chunks;
+    Dwarf_Unsigned       ba_total;
+};
+/*  Chunk header rounded up so the data keeps BUMP_ALIGN. */
+#define BUMP_HDR  ((sizeof(struct bump_chunk_s) + BUMP_ALIGN-1) &\
+    ~(Dwarf_Unsigned)(BUMP_ALIGN-1))
+
+static void *
+bump_malloc(void *user, Dwarf_Unsigned len)
+{
+    struct bump_arena_s *ba = (struct bump_arena_s *)user;
+    struct bump_chunk_s *c = ba->ba_chunks;
+    char *ret = 0;
+
+    len = (len + BUMP_ALIGN-1) & ~(Dwarf_Unsigned)(BUMP_ALIGN-1);
+    if (!c || (c->bc_size - c->bc_used) < len) {
+        Dwarf_Unsigned size = BUMP_CHUNK_SIZE;
+
+        if (len > size) {
+            size = len;
+        }
+        c = (struct bump_chunk_s *)malloc((size_t)(size +
+            BUMP_HDR));
+        if (!c) {
+            return 0;
+        }
+        c->bc_next = ba->ba_chunks;
+        c->bc_size = size;
+        c->bc_used = 0;
+        ba->ba_chunks = c;
+        ba->ba_total += size;
+    }
+    ret = (char *)c + BUMP_HDR + c->bc_used;
+    c->bc_used += len;
+    return ret;
+}
+
+static void
+bump_free(void *user, void *space)
+{
+    /*  Nothing to do, everything goes in bump_release(). */
+    (void)user;
+    (void)space;
+}
+
+static void
+bump_release(struct bump_arena_s *ba)
+{
+    struct bump_chunk_s *c = ba->ba_chunks;
+
+    while (c) {
+        struct bump_chunk_s *n = c->bc_next;
+
+        free(c);
+        c = n;
+    }
+    ba->ba_chunks = 0;
+    ba->ba_total = 0;
+}
+
+/*  Make all the arena space available again.
+    If more than one chunk was needed replace them
+    with a single chunk of the total size so the
+    next Dwarf_Debug runs without growing the arena. */
+static void
+bump_reset(struct bump_arena_s *ba)
+{
+    struct bump_chunk_s *c = ba->ba_chunks;
+    Dwarf_Unsigned total = ba->ba_total;
+
+    if (!c) {
+        return;
+    }
+    if (!c->bc_next) {
+        c->bc_used = 0;
+        return;
+    }
+    bump_release(ba);
+    c = (struct bump_chunk_s *)malloc((size_t)(total + BUMP_HDR));
+    if (!c) {
+        return;
+    }
+    c->bc_next = 0;
+    c->bc_size = total;
+    c->bc_used = 0;
+    ba->ba_chunks = c;
+    ba->ba_total = total;
+}
+
+static Dwarf_Unsigned die_count;
+
+static int
+walk_die_and_attrs(Dwarf_Debug dbg, Dwarf_Die die,
+    Dwarf_Error *errp)
+{
+    Dwarf_Attribute *atlist = 0;
+    Dwarf_Signed     atcount = 0;
+    Dwarf_Signed     i = 0;
+    int              res = 0;
+
+    ++die_count;
+    res = dwarf_attrlist(die,&atlist,&atcount,errp);
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        return DW_DLV_OK;
+    }
+    for (i = 0; i < atcount; ++i) {
+        Dwarf_Half form = 0;
+        Dwarf_Unsigned uval = 0;
+        char *str = 0;
+
+        res = dwarf_whatform(atlist[i],&form,errp);
+        if (res == DW_DLV_OK) {
+            switch (form) {
+            case DW_FORM_string: case DW_FORM_strp:
+            case DW_FORM_line_strp: case DW_FORM_strx:
+            case DW_FORM_strx1: case DW_FORM_strx2:
+            case DW_FORM_strx3: case DW_FORM_strx4:
+                res = dwarf_formstring(atlist[i],&str,errp);
+                break;
+            case DW_FORM_data1: case DW_FORM_data2:
+            case DW_FORM_data4: case DW_FORM_data8:
+            case DW_FORM_udata:
+                res = dwarf_formudata(atlist[i],&uval,errp);
+                break;
+            default:
+                break;
+            }
+        }
+        if (res == DW_DLV_ERROR) {
+            for ( ; i < atcount; ++i) {
+                dwarf_dealloc_attribute(atlist[i]);
+            }
+            dwarf_dealloc(dbg,atlist,DW_DLA_LIST);
+            return res;
+        }
+        dwarf_dealloc_attribute(atlist[i]);
+    }
+    dwarf_dealloc(dbg,atlist,DW_DLA_LIST);
+    return DW_DLV_OK;
+}
+
+static int
+walk_die_tree(Dwarf_Debug dbg, Dwarf_Die in_die,
+    Dwarf_Bool is_info, Dwarf_Error *errp)
+{
+    Dwarf_Die cur_die = in_die;
+    int res = 0;
+
+    res = walk_die_and_attrs(dbg,in_die,errp);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    for (;;) {
+        Dwarf_Die child = 0;
+        Dwarf_Die sib_die = 0;
+
+        res = dwarf_child(cur_die,&child,errp);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_OK) {
+            res = walk_die_tree(dbg,child,is_info,errp);
+            dwarf_dealloc_die(child);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+        }
+        res = dwarf_siblingof_b(dbg,cur_die,is_info,&sib_die,errp);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            break;
+        }
+        if (cur_die != in_die) {
+            dwarf_dealloc_die(cur_die);
+        }
+        cur_die = sib_die;
+        res = walk_die_and_attrs(dbg,cur_die,errp);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    if (cur_die != in_die) {
+        dwarf_dealloc_die(cur_die);
+    }
+    return DW_DLV_OK;
+}
+
+static int
+walk_all_cus(Dwarf_Debug dbg, Dwarf_Error *errp)
+{
+    Dwarf_Bool is_info = TRUE;
+
+    for (;;) {
+        Dwarf_Die cu_die = 0;
+        Dwarf_Unsigned next_cu_header = 0;
+        Dwarf_Half header_cu_type = 0;
+        int res = 0;
+
+        res = dwarf_next_cu_header_d(dbg,is_info,
+            0,0,0,0,0,0,0,0,
+            &next_cu_header,&header_cu_type,errp);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            return DW_DLV_OK;
+        }
+        res = dwarf_siblingof_b(dbg,0,is_info,&cu_die,errp);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            continue;
+        }
+        res = walk_die_tree(dbg,cu_die,is_info,errp);
+        dwarf_dealloc_die(cu_die);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+}
+
+/*  Returns seconds used, or a negative number on error. */
+static double
+run_walks(const char *path, int iterations)
+{
+    int i = 0;
+    clock_t start = clock();
+
+    for (i = 0; i < iterations; ++i) {
+        Dwarf_Debug dbg = 0;
+        Dwarf_Error err = 0;
+        int res = 0;
+
+        res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+            0,0,&dbg,&err);
+        if (res != DW_DLV_OK) {
+            if (res == DW_DLV_ERROR) {
+                printf("dwarf_init_path failed: %s\n",
+                    dwarf_errmsg(err));
+                dwarf_dealloc_error(dbg,err);
+            } else {
+                printf("No DWARF in %s\n",path);
+            }
+            return -1.0;
+        }
+        res = walk_all_cus(dbg,&err);
+        if (res == DW_DLV_ERROR) {
+            printf("Walking DIEs failed: %s\n",
+                dwarf_errmsg(err));
+            dwarf_dealloc_error(dbg,err);
+            dwarf_finish(dbg);
+            return -1.0;
+        }
+        dwarf_finish(dbg);
+    }
+    return (double)(clock() - start)/CLOCKS_PER_SEC;
+}
+
+static void
+report(const char *label, double secs, Dwarf_Unsigned dies)
+{
+    double rate = 0.0;
+
+    if (secs > 0.0) {
+        rate = (double)dies/secs;
+    }
+    printf("%-8s %10" DW_PR_DUu " DIEs %9.3f sec %14.0f DIEs/sec\n",
+        label,dies,secs,rate);
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *path = 0;
+    int iterations = 10;
+    int i = 1;
+    double secs = 0.0;
+    double bumpsecs = 0.0;
+    struct bump_arena_s arena;
+    Dwarf_Allocator bump;
+
+    for ( ; i < argc; ++i) {
+        if (!strncmp(argv[i],"--iterations=",13)) {
+            iterations = atoi(argv[i]+13);
+            if (iterations < 1) {
+                iterations = 1;
+            }
+        } else {
+            path = argv[i];
+        }
+    }
+    if (!path) {
+        printf("Usage: allocbench [--iterations=<n>] <objectfile>\n");
+        exit(EXIT_FAILURE);
+    }
+
+    die_count = 0;
+    secs = run_walks(path,iterations);
+    if (secs < 0.0) {
+        exit(EXIT_FAILURE);
+    }
+    report("malloc",secs,die_count);
+
+    memset(&arena,0,sizeof(arena));
+    bump.da_malloc = bump_malloc;
+    bump.da_free = bump_free;
+    bump.da_user_data = &arena;
+    die_count = 0;
+    for (i = 0; i < iterations; ++i) {
+        /*  One Dwarf_Debug at a time uses the arena,
+            which is reset after each dwarf_finish(). */
+        double s = 0.0;
+
+        dwarf_set_allocator(&bump,0);
+        s = run_walks(path,1);
+        dwarf_set_allocator(0,0);
+        if (s < 0.0) {
+            bump_release(&arena);
+            exit(EXIT_FAILURE);
+        }
+        bumpsecs += s;
+        bump_reset(&arena);
+    }
+    report("bump",bumpsecs,die_count);
+    printf("bump arena bytes: %" DW_PR_DUu "\n",arena.ba_total);
+    bump_release(&arena);
+    return 0;
+}
@@ -0,0 +1,623 @@
+/*
+  Copyright (C) 2026 David Anderson.
+  This source code is placed in the Public Domain.
+  It may be copied or used in any way without restriction.
+*/
+/*  exprbench.c
+    An example of dwarf_expr_evaluate() that also serves
+    as a benchmark: it collects every location
+    description (expressions and location list entries)
+    of every DIE in .debug_info and evaluates them all a
+    number of times against a made-up machine state,
+    first with the sort of switch over the DW_OP values
+    a consumer typically writes (reading the operators
+    with dwarf_get_location_op_value_c()) and then
+    with dwarf_expr_evaluate().
+    It reports evaluations per second for each and
+    checks the two agree.
+
+    To use, try
+        make
+        ./exprbench --iterations=20 ./exprbench
+*/
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* atoi() exit() free() realloc() */
+#include <string.h> /* memset() strncmp() */
+#include <time.h>   /* clock() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+
+#define MAX_PIECES 64
+#define STACK_MAX  64
+
+struct desc_s {
+    Dwarf_Locdesc_c   de_desc;
+    Dwarf_Unsigned    de_opcount;
+};
+struct locset_s {
+    Dwarf_Loc_Head_c *ls_heads;
+    Dwarf_Unsigned    ls_head_count;
+    Dwarf_Unsigned    ls_head_max;
+    struct desc_s    *ls_descs;
+    Dwarf_Unsigned    ls_desc_count;
+    Dwarf_Unsigned    ls_desc_max;
+};
+
+/*  The made-up machine: register N holds 0x1000*N+8,
+    memory at A holds A^0x5a5a, everything else
+    is a constant. */
+static int
+fake_register(void *ud, Dwarf_Unsigned regnum,
+    Dwarf_Unsigned *value)
+{
+    (void)ud;
+    *value = 0x1000*regnum + 8;
+    return DW_DLV_OK;
+}
+static int
+fake_memory(void *ud, Dwarf_Addr addr, Dwarf_Unsigned size,
+    Dwarf_Unsigned *value)
+{
+    (void)ud;
+    *value = addr ^ 0x5a5a;
+    if (size < sizeof(Dwarf_Unsigned)) {
+        *value &= ((Dwarf_Unsigned)1 << (size*8)) - 1;
+    }
+    return DW_DLV_OK;
+}
+static int
+fake_frame_base(void *ud, Dwarf_Addr *value)
+{
+    (void)ud;
+    *value = 0x7fff0000;
+    return DW_DLV_OK;
+}
+static int
+fake_cfa(void *ud, Dwarf_Addr *value)
+{
+    (void)ud;
+    *value = 0x7fff0010;
+    return DW_DLV_OK;
+}
+static int
+fake_tls(void *ud, Dwarf_Unsigned offset, Dwarf_Addr *value)
+{
+    (void)ud;
+    *value = 0x600000 + offset;
+    return DW_DLV_OK;
+}
+static int
+fake_object(void *ud, Dwarf_Addr *value)
+{
+    (void)ud;
+    *value = 0x5000;
+    return DW_DLV_OK;
+}
+
+static int
+add_head(struct locset_s *ls, Dwarf_Loc_Head_c head,
+    Dwarf_Unsigned count, Dwarf_Error *errp)
+{
+    Dwarf_Unsigned i = 0;
+
+    if (ls->ls_head_count >= ls->ls_head_max) {
+        Dwarf_Unsigned n = ls->ls_head_max? ls->ls_head_max*2:256;
+        Dwarf_Loc_Head_c *h = (Dwarf_Loc_Head_c *)realloc(
+            ls->ls_heads,(size_t)(n*sizeof(*h)));
+
+        if (!h) {
+            printf("Out of memory\n");
+            exit(EXIT_FAILURE);
+        }
+        ls->ls_heads = h;
+        ls->ls_head_max = n;
+    }
+    ls->ls_heads[ls->ls_head_count++] = head;
+    for (i = 0; i < count; ++i) {
+        Dwarf_Small lle = 0;
+        Dwarf_Unsigned rawlo = 0;
+        Dwarf_Unsigned rawhi = 0;
+        Dwarf_Bool debug_addr_unavailable = FALSE;
+        Dwarf_Addr lopc = 0;
+        Dwarf_Addr hipc = 0;
+        Dwarf_Unsigned opcount = 0;
+        Dwarf_Locdesc_c desc = 0;
+        Dwarf_Small source = 0;
+        Dwarf_Unsigned exproff = 0;
+        Dwarf_Unsigned descoff = 0;
+        int res = 0;
+
+        res = dwarf_get_locdesc_entry_d(head,i,&lle,
+            &rawlo,&rawhi,&debug_addr_unavailable,&lopc,&hipc,
+            &opcount,&desc,&source,&exproff,&descoff,errp);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (lle == DW_LLE_end_of_list ||
+            lle == DW_LLE_base_address ||
+            lle == DW_LLE_base_addressx) {
+            continue;
+        }
+        if (ls->ls_desc_count >= ls->ls_desc_max) {
+            Dwarf_Unsigned n = ls->ls_desc_max?
+                ls->ls_desc_max*2:1024;
+            struct desc_s *d = (struct desc_s *)realloc(
+                ls->ls_descs,(size_t)(n*sizeof(*d)));
+
+            if (!d) {
+                printf("Out of memory\n");
+                exit(EXIT_FAILURE);
+            }
+            ls->ls_descs = d;
+            ls->ls_desc_max = n;
+        }
+        ls->ls_descs[ls->ls_desc_count].de_desc = desc;
+        ls->ls_descs[ls->ls_desc_count].de_opcount = opcount;
+        ++ls->ls_desc_count;
+    }
+    return DW_DLV_OK;
+}
+
+static int
+collect_die(Dwarf_Debug dbg, Dwarf_Die die,
+    struct locset_s *ls, Dwarf_Error *errp)
+{
+    Dwarf_Attribute *atlist = 0;
+    Dwarf_Signed     atcount = 0;
+    Dwarf_Signed     i = 0;
+    Dwarf_Half       version = 0;
+    Dwarf_Half       offset_size = 0;
+    int              res = 0;
+
+    res = dwarf_get_version_of_die(die,&version,&offset_size);
+    if (res != DW_DLV_OK) {
+        return DW_DLV_OK;
+    }
+    res = dwarf_attrlist(die,&atlist,&atcount,errp);
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        return DW_DLV_OK;
+    }
+    for (i = 0; i < atcount; ++i) {
+        Dwarf_Half attrnum = 0;
+        Dwarf_Half form = 0;
+        enum Dwarf_Form_Class cl = DW_FORM_CLASS_UNKNOWN;
+        Dwarf_Loc_Head_c head = 0;
+        Dwarf_Unsigned count = 0;
+
+        res = dwarf_whatattr(atlist[i],&attrnum,errp);
+        if (res == DW_DLV_OK) {
+            res = dwarf_whatform(atlist[i],&form,errp);
+        }
+        if (res == DW_DLV_OK) {
+            cl = dwarf_get_form_class(version,attrnum,
+                offset_size,form);
+            if (cl == DW_FORM_CLASS_EXPRLOC ||
+                cl == DW_FORM_CLASS_LOCLIST ||
+                cl == DW_FORM_CLASS_LOCLISTPTR ||
+                (cl == DW_FORM_CLASS_BLOCK &&
+                (attrnum == DW_AT_location ||
+                attrnum == DW_AT_frame_base))) {
+                res = dwarf_get_loclist_c(atlist[i],&head,
+                    &count,errp);
+                if (res == DW_DLV_OK) {
+                    res = add_head(ls,head,count,errp);
+                }
+            }
+        }
+        if (res == DW_DLV_ERROR) {
+            /*  Skip damaged location data. */
+            dwarf_dealloc_error(dbg,*errp);
+            *errp = 0;
+        }
+        dwarf_dealloc_attribute(atlist[i]);
+    }
+    dwarf_dealloc(dbg,atlist,DW_DLA_LIST);
+    return DW_DLV_OK;
+}
+
+static int
+collect_tree(Dwarf_Debug dbg, Dwarf_Die in_die,
+    struct locset_s *ls, Dwarf_Error *errp)
+{
+    Dwarf_Die cur_die = in_die;
+    int res = 0;
+
+    res = collect_die(dbg,in_die,ls,errp);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    for (;;) {
+        Dwarf_Die child = 0;
+        Dwarf_Die sib_die = 0;
+
+        res = dwarf_child(cur_die,&child,errp);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_OK) {
+            res = collect_tree(dbg,child,ls,errp);
+            dwarf_dealloc_die(child);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+        }
+        res = dwarf_siblingof_c(cur_die,&sib_die,errp);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            break;
+        }
+        if (cur_die != in_die) {
+            dwarf_dealloc_die(cur_die);
+        }
+        cur_die = sib_die;
+        res = collect_die(dbg,cur_die,ls,errp);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    if (cur_die != in_die) {
+        dwarf_dealloc_die(cur_die);
+    }
+    return DW_DLV_OK;
+}
+
+static int
+collect_all(Dwarf_Debug dbg, struct locset_s *ls,
+    Dwarf_Error *errp)
+{
+    for (;;) {
+        Dwarf_Die cu_die = 0;
+        Dwarf_Unsigned next_cu_header = 0;
+        Dwarf_Half header_cu_type = 0;
+        int res = 0;
+
+        res = dwarf_next_cu_header_e(dbg,TRUE,&cu_die,
+            0,0,0,0,0,0,0,0,
+            &next_cu_header,&header_cu_type,errp);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            return DW_DLV_OK;
+        }
+        res = collect_tree(dbg,cu_die,ls,errp);
+        dwarf_dealloc_die(cu_die);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+}
+
+/*  What a consumer usually writes: read each operator
+    and switch on it. Handles the operators compilers
+    commonly emit, returns DW_DLV_NO_ENTRY for others. */
+static int
+switch_evaluate(Dwarf_Locdesc_c desc, Dwarf_Unsigned opcount,
+    Dwarf_Expr_Piece *pieces, Dwarf_Unsigned *piece_count,
+    Dwarf_Error *errp)
+{
+    Dwarf_Unsigned stack[STACK_MAX];
+    Dwarf_Unsigned sp = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned n = 0;
+    Dwarf_Small kind = DW_EXPR_LOC_MEMORY;
+    Dwarf_Unsigned value = 0;
+    int res = 0;
+
+    if (!opcount) {
+        pieces[0].ep_kind = DW_EXPR_LOC_EMPTY;
+        pieces[0].ep_value = 0;
+        pieces[0].ep_size_bits = 0;
+        pieces[0].ep_offset_bits = 0;
+        *piece_count = 1;
+        return DW_DLV_OK;
+    }
+    for (i = 0; i < opcount; ++i) {
+        Dwarf_Small op = 0;
+        Dwarf_Unsigned op1 = 0;
+        Dwarf_Unsigned op2 = 0;
+        Dwarf_Unsigned op3 = 0;
+        Dwarf_Unsigned branch = 0;
+        Dwarf_Unsigned v = 0;
+
+        res = dwarf_get_location_op_value_c(desc,i,&op,
+            &op1,&op2,&op3,&branch,errp);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (sp >= STACK_MAX-1) {
+            return DW_DLV_NO_ENTRY;
+        }
+        if (op >= DW_OP_lit0 && op <= DW_OP_lit31) {
+            stack[sp++] = op - DW_OP_lit0;
+            continue;
+        }
+        if (op >= DW_OP_reg0 && op <= DW_OP_reg31) {
+            kind = DW_EXPR_LOC_REGISTER;
+            value = op - DW_OP_reg0;
+            continue;
+        }
+        if (op >= DW_OP_breg0 && op <= DW_OP_breg31) {
+            fake_register(0,op - DW_OP_breg0,&v);
+            stack[sp++] = v + op1;
+            continue;
+        }
+        switch (op) {
+        case DW_OP_addr:
+        case DW_OP_const1u: case DW_OP_const1s:
+        case DW_OP_const2u: case DW_OP_const2s:
+        case DW_OP_const4u: case DW_OP_const4s:
+        case DW_OP_const8u: case DW_OP_const8s:
+        case DW_OP_constu:  case DW_OP_consts:
+            stack[sp++] = op1;
+            break;
+        case DW_OP_regx:
+            kind = DW_EXPR_LOC_REGISTER;
+            value = op1;
+            break;
+        case DW_OP_bregx:
+            fake_register(0,op1,&v);
+            stack[sp++] = v + op2;
+            break;
+        case DW_OP_fbreg:
+            fake_frame_base(0,&v);
+            stack[sp++] = v + op1;
+            break;
+        case DW_OP_call_frame_cfa:
+            fake_cfa(0,&v);
+            stack[sp++] = v;
+            break;
+        case DW_OP_plus_uconst:
+            if (!sp) {
+                return DW_DLV_NO_ENTRY;
+            }
+            stack[sp-1] += op1;
+            break;
+        case DW_OP_plus:
+        case DW_OP_minus:
+        case DW_OP_and:
+            if (sp < 2) {
+                return DW_DLV_NO_ENTRY;
+            }
+            --sp;
+            if (op == DW_OP_plus) {
+                stack[sp-1] += stack[sp];
+            } else if (op == DW_OP_minus) {
+                stack[sp-1] -= stack[sp];
+            } else {
+                stack[sp-1] &= stack[sp];
+            }
+            break;
+        case DW_OP_deref:
+            if (!sp) {
+                return DW_DLV_NO_ENTRY;
+            }
+            fake_memory(0,stack[sp-1],8,&v);
+            stack[sp-1] = v;
+            break;
+        case DW_OP_stack_value:
+            if (!sp) {
+                return DW_DLV_NO_ENTRY;
+            }
+            kind = DW_EXPR_LOC_VALUE;
+            value = stack[--sp];
+            break;
+        case DW_OP_piece:
+            if (n >= MAX_PIECES) {
+                return DW_DLV_NO_ENTRY;
+            }
+            if (kind != DW_EXPR_LOC_MEMORY) {
+                pieces[n].ep_kind = kind;
+                pieces[n].ep_value = value;
+            } else if (sp) {
+                pieces[n].ep_kind = DW_EXPR_LOC_MEMORY;
+                pieces[n].ep_value = stack[--sp];
+            } else {
+                pieces[n].ep_kind = DW_EXPR_LOC_EMPTY;
+                pieces[n].ep_value = 0;
+            }
+            pieces[n].ep_size_bits = op1*8;
+            pieces[n].ep_offset_bits = 0;
+            ++n;
+            kind = DW_EXPR_LOC_MEMORY;
+            break;
+        default:
+            return DW_DLV_NO_ENTRY;
+        }
+    }
+    if (!n) {
+        if (kind == DW_EXPR_LOC_MEMORY) {
+            if (!sp) {
+                return DW_DLV_NO_ENTRY;
+            }
+            value = stack[sp-1];
+        }
+        pieces[0].ep_kind = kind;
+        pieces[0].ep_value = value;
+        pieces[0].ep_size_bits = 0;
+        pieces[0].ep_offset_bits = 0;
+        n = 1;
+    }
+    *piece_count = n;
+    return DW_DLV_OK;
+}
+
+static Dwarf_Bool
+same_pieces(Dwarf_Expr_Piece *a, Dwarf_Unsigned acount,
+    Dwarf_Expr_Piece *b, Dwarf_Unsigned bcount)
+{
+    Dwarf_Unsigned i = 0;
+
+    if (acount != bcount) {
+        return FALSE;
+    }
+    for (i = 0; i < acount; ++i) {
+        if (a[i].ep_kind != b[i].ep_kind ||
+            a[i].ep_value != b[i].ep_value ||
+            a[i].ep_size_bits != b[i].ep_size_bits) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static void
+report(const char *label, double secs, Dwarf_Unsigned evals)
+{
+    double rate = 0.0;
+
+    if (secs > 0.0) {
+        rate = (double)evals/secs;
+    }
+    printf("%-8s %12" DW_PR_DUu " evaluations %9.3f sec "
+        "%14.0f evals/sec\n",label,evals,secs,rate);
+}
+
+static void
+release(Dwarf_Debug dbg, struct locset_s *ls)
+{
+    Dwarf_Unsigned i = 0;
+
+    for (i = 0; i < ls->ls_head_count; ++i) {
+        dwarf_dealloc_loc_head_c(ls->ls_heads[i]);
+    }
+    free(ls->ls_heads);
+    free(ls->ls_descs);
+    dwarf_finish(dbg);
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *path = 0;
+    int iterations = 10;
+    int i = 1;
+    int it = 0;
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    struct locset_s ls;
+    Dwarf_Expr_Callbacks cb;
+    Dwarf_Expr_Piece pieces[MAX_PIECES];
+    Dwarf_Expr_Piece swpieces[MAX_PIECES];
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned swcount = 0;
+    Dwarf_Unsigned d = 0;
+    Dwarf_Unsigned used = 0;
+    Dwarf_Unsigned evfail = 0;
+    Dwarf_Unsigned swfail = 0;
+    Dwarf_Unsigned mismatch = 0;
+    clock_t start = 0;
+    double secs = 0.0;
+    int res = 0;
+
+    for ( ; i < argc; ++i) {
+        if (!strncmp(argv[i],"--iterations=",13)) {
+            iterations = atoi(argv[i]+13);
+            if (iterations < 1) {
+                iterations = 1;
+            }
+        } else {
+            path = argv[i];
+        }
+    }
+    if (!path) {
+        printf("Usage: exprbench [--iterations=<n>] <objectfile>\n");
+        exit(EXIT_FAILURE);
+    }
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            printf("dwarf_init_path failed: %s\n",
+                dwarf_errmsg(err));
+            dwarf_dealloc_error(dbg,err);
+        } else {
+            printf("No DWARF in %s\n",path);
+        }
+        exit(EXIT_FAILURE);
+    }
+    memset(&ls,0,sizeof(ls));
+    res = collect_all(dbg,&ls,&err);
+    if (res == DW_DLV_ERROR) {
+        printf("Reading DIEs failed: %s\n",dwarf_errmsg(err));
+        dwarf_dealloc_error(dbg,err);
+        release(dbg,&ls);
+        exit(EXIT_FAILURE);
+    }
+    memset(&cb,0,sizeof(cb));
+    cb.ec_read_register = fake_register;
+    cb.ec_read_memory = fake_memory;
+    cb.ec_frame_base = fake_frame_base;
+    cb.ec_call_frame_cfa = fake_cfa;
+    cb.ec_tls_address = fake_tls;
+    cb.ec_object_address = fake_object;
+
+    /*  Check the two agree where both can evaluate
+        and time only those, moving them to the front. */
+    for (d = 0; d < ls.ls_desc_count; ++d) {
+        struct desc_s *de = ls.ls_descs + d;
+        int swres = 0;
+
+        res = dwarf_expr_evaluate(de->de_desc,&cb,
+            pieces,MAX_PIECES,&count,&err);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,err);
+            err = 0;
+            ++evfail;
+            continue;
+        }
+        swres = switch_evaluate(de->de_desc,de->de_opcount,
+            swpieces,&swcount,&err);
+        if (swres == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,err);
+            err = 0;
+        }
+        if (swres != DW_DLV_OK) {
+            ++swfail;
+            continue;
+        }
+        if (!same_pieces(pieces,count,swpieces,swcount)) {
+            ++mismatch;
+            continue;
+        }
+        ls.ls_descs[used++] = *de;
+    }
+    printf("%" DW_PR_DUu " location descriptions: %" DW_PR_DUu
+        " timed, %" DW_PR_DUu " unsupported by "
+        "dwarf_expr_evaluate(), %" DW_PR_DUu
+        " by the switch, %" DW_PR_DUu " mismatches\n",
+        ls.ls_desc_count,used,evfail,swfail,mismatch);
+
+    start = clock();
+    for (it = 0; it < iterations; ++it) {
+        for (d = 0; d < used; ++d) {
+            (void)switch_evaluate(ls.ls_descs[d].de_desc,
+                ls.ls_descs[d].de_opcount,
+                swpieces,&swcount,&err);
+        }
+    }
+    secs = (double)(clock() - start)/CLOCKS_PER_SEC;
+    report("switch",secs,used*iterations);
+
+    start = clock();
+    for (it = 0; it < iterations; ++it) {
+        for (d = 0; d < used; ++d) {
+            (void)dwarf_expr_evaluate(ls.ls_descs[d].de_desc,
+                &cb,pieces,MAX_PIECES,&count,&err);
+        }
+    }
+    secs = (double)(clock() - start)/CLOCKS_PER_SEC;
+    report("evaluate",secs,used*iterations);
+    release(dbg,&ls);
+    return mismatch? EXIT_FAILURE : 0;
+}
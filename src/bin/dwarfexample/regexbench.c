@@ -0,0 +1,292 @@
+/*
+  Copyright (C) 2026 David Anderson.
+  This source code is placed in the Public Domain.
+  It may be copied or used in any way without restriction.
+*/
+/*  regexbench.c
+    A benchmark of the regular expression matcher
+    dwarfdump uses for --search-regex.
+    It reads every DW_AT_name string in .debug_info
+    of an object file and then, for each pattern,
+    matches all the names a number of times with
+    dd_re_exec() (the DFA) and with dd_re_exec_nfa()
+    (the backtracking matcher), reporting names per
+    second for each and checking the two agree.
+
+    To use, try
+        make
+        ./regexbench --iterations=20 ./regexbench
+        ./regexbench --regex='^dwarf_.*die' ./libdwarf.so
+*/
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* atoi() exit() free() malloc() realloc() */
+#include <string.h> /* strdup() strncmp() */
+#include <time.h>   /* clock() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dd_regex.h"
+#include "dd_safe_strcpy.h"
+#include "dd_checkutil.h"
+#include "dd_glflags.h"
+
+/*  dd_regex.c counts pattern errors here. */
+struct glflags_s glflags;
+
+#define MAX_PATTERNS 32
+
+static char         **names;
+static Dwarf_Unsigned name_count;
+static Dwarf_Unsigned name_alloc;
+
+static const char *default_patterns[] = {
+    "^main$",
+    "alloc",
+    "str.*cmp",
+    "_t$",
+    "^[A-Z][a-z]*[0-9]+",
+    "u.leb",
+    0
+};
+
+static int
+add_name(const char *name)
+{
+    char *n = 0;
+
+    if (name_count >= name_alloc) {
+        Dwarf_Unsigned newalloc = name_alloc?name_alloc*2:1024;
+        char **newnames = (char **)realloc(names,
+            (size_t)(newalloc*sizeof(char *)));
+
+        if (!newnames) {
+            return DW_DLV_ERROR;
+        }
+        names = newnames;
+        name_alloc = newalloc;
+    }
+    n = strdup(name);
+    if (!n) {
+        return DW_DLV_ERROR;
+    }
+    names[name_count++] = n;
+    return DW_DLV_OK;
+}
+
+static int
+collect_names(Dwarf_Debug dbg, Dwarf_Die in_die,
+    Dwarf_Bool is_info, Dwarf_Error *errp)
+{
+    Dwarf_Die cur_die = in_die;
+    int res = 0;
+
+    for (;;) {
+        Dwarf_Die child = 0;
+        Dwarf_Die sib_die = 0;
+        char *name = 0;
+
+        res = dwarf_diename(cur_die,&name,errp);
+        if (res == DW_DLV_ERROR) {
+            break;
+        }
+        if (res == DW_DLV_OK && add_name(name) != DW_DLV_OK) {
+            printf("Out of memory collecting names\n");
+            exit(EXIT_FAILURE);
+        }
+        res = dwarf_child(cur_die,&child,errp);
+        if (res == DW_DLV_ERROR) {
+            break;
+        }
+        if (res == DW_DLV_OK) {
+            res = collect_names(dbg,child,is_info,errp);
+            dwarf_dealloc_die(child);
+            if (res != DW_DLV_OK) {
+                break;
+            }
+        }
+        res = dwarf_siblingof_b(dbg,cur_die,is_info,&sib_die,errp);
+        if (res != DW_DLV_OK) {
+            if (res == DW_DLV_NO_ENTRY) {
+                res = DW_DLV_OK;
+            }
+            break;
+        }
+        if (cur_die != in_die) {
+            dwarf_dealloc_die(cur_die);
+        }
+        cur_die = sib_die;
+    }
+    if (cur_die != in_die) {
+        dwarf_dealloc_die(cur_die);
+    }
+    return res;
+}
+
+static int
+collect_all_names(Dwarf_Debug dbg, Dwarf_Error *errp)
+{
+    Dwarf_Bool is_info = TRUE;
+
+    for (;;) {
+        Dwarf_Die cu_die = 0;
+        Dwarf_Unsigned next_cu_header = 0;
+        Dwarf_Half header_cu_type = 0;
+        int res = 0;
+
+        res = dwarf_next_cu_header_d(dbg,is_info,
+            0,0,0,0,0,0,0,0,
+            &next_cu_header,&header_cu_type,errp);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            return DW_DLV_OK;
+        }
+        res = dwarf_siblingof_b(dbg,0,is_info,&cu_die,errp);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            continue;
+        }
+        res = collect_names(dbg,cu_die,is_info,errp);
+        dwarf_dealloc_die(cu_die);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+}
+
+typedef int (*matcher_func)(char *);
+
+/*  Returns seconds used, the match count in *matches. */
+static double
+run_matcher(matcher_func m, int iterations,
+    Dwarf_Unsigned *matches)
+{
+    clock_t start = clock();
+    Dwarf_Unsigned count = 0;
+    int i = 0;
+
+    for (i = 0; i < iterations; ++i) {
+        Dwarf_Unsigned n = 0;
+
+        count = 0;
+        for (n = 0; n < name_count; ++n) {
+            if (m(names[n]) == DW_DLV_OK) {
+                ++count;
+            }
+        }
+    }
+    *matches = count;
+    return (double)(clock() - start)/CLOCKS_PER_SEC;
+}
+
+static void
+report(const char *label, double secs, Dwarf_Unsigned names_run,
+    Dwarf_Unsigned matches)
+{
+    double rate = 0.0;
+
+    if (secs > 0.0) {
+        rate = (double)names_run/secs;
+    }
+    printf("  %-10s %9.3f sec %14.0f names/sec %8" DW_PR_DUu
+        " matches\n",label,secs,rate,matches);
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *path = 0;
+    const char *patterns[MAX_PATTERNS+1];
+    int pattern_count = 0;
+    int iterations = 10;
+    int i = 1;
+    int errors = 0;
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    Dwarf_Unsigned n = 0;
+    int res = 0;
+
+    for ( ; i < argc; ++i) {
+        if (!strncmp(argv[i],"--iterations=",13)) {
+            iterations = atoi(argv[i]+13);
+            if (iterations < 1) {
+                iterations = 1;
+            }
+        } else if (!strncmp(argv[i],"--regex=",8)) {
+            if (pattern_count < MAX_PATTERNS) {
+                patterns[pattern_count++] = argv[i]+8;
+            }
+        } else {
+            path = argv[i];
+        }
+    }
+    if (!path) {
+        printf("Usage: regexbench [--iterations=<n>] "
+            "[--regex=<pattern>]... <objectfile>\n");
+        exit(EXIT_FAILURE);
+    }
+    if (!pattern_count) {
+        for ( ; default_patterns[pattern_count]; ++pattern_count) {
+            patterns[pattern_count] =
+                default_patterns[pattern_count];
+        }
+    }
+    patterns[pattern_count] = 0;
+
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            printf("dwarf_init_path failed: %s\n",
+                dwarf_errmsg(err));
+            dwarf_dealloc_error(dbg,err);
+        } else {
+            printf("No DWARF in %s\n",path);
+        }
+        exit(EXIT_FAILURE);
+    }
+    res = collect_all_names(dbg,&err);
+    if (res == DW_DLV_ERROR) {
+        printf("Reading DIE names failed: %s\n",
+            dwarf_errmsg(err));
+        dwarf_dealloc_error(dbg,err);
+        dwarf_finish(dbg);
+        exit(EXIT_FAILURE);
+    }
+    dwarf_finish(dbg);
+    printf("%" DW_PR_DUu " names, %d iterations\n",
+        name_count,iterations);
+
+    for (i = 0; patterns[i]; ++i) {
+        Dwarf_Unsigned dfa_matches = 0;
+        Dwarf_Unsigned nfa_matches = 0;
+        Dwarf_Unsigned names_run = name_count*iterations;
+        double secs = 0.0;
+
+        printf("pattern %s\n",patterns[i]);
+        if (dd_re_comp(patterns[i]) != DW_DLV_OK) {
+            ++errors;
+            continue;
+        }
+        secs = run_matcher(dd_re_exec,iterations,&dfa_matches);
+        report("dfa",secs,names_run,dfa_matches);
+        secs = run_matcher(dd_re_exec_nfa,iterations,&nfa_matches);
+        report("backtrack",secs,names_run,nfa_matches);
+        if (dfa_matches != nfa_matches) {
+            printf("  ERROR: the matchers disagree\n");
+            ++errors;
+        }
+    }
+    for (n = 0; n < name_count; ++n) {
+        free(names[n]);
+    }
+    free(names);
+    return errors?EXIT_FAILURE:0;
+}
@@ -53,6 +53,7 @@
 #include <list>
 #include <map>
 #include <vector>
+#include <algorithm> // For std::lower_bound
 #include <string.h> // For memset etc
 #include "strtabdata.h"
 #include "dwarf.h"
@@ -537,12 +538,10 @@ IRFormReference::IRFormReference(IRFormInterface * interface)
         exit(1);
     }
     setCUOffset(val);
+    // The target IRDie is set by updateReferenceAttrDieTargets()
+    // once the whole CU is read: until then IRDie
+    // records can still move.
     cudata.insertLocalReferenceAttrTargetRef(val,this);
-    IRDie *targdie = cudata.getLocalDie(val);
-    if (targdie) {
-        // Record local offset's IRDie when it is already known.
-        setTargetInDie(targdie);
-    }
 }
 
 // Global static data used to initialized a sig8 reliably.
@@ -56,6 +56,7 @@
 #include <list>
 #include <map>
 #include <vector>
+#include <algorithm> // For std::lower_bound
 #include <string.h> // For memset etc
 #include <sys/stat.h> //open
 #include <fcntl.h> //open
@@ -382,9 +383,8 @@ get_attrs_of_die(Dwarf_Die in_die,IRDie &irdie,
     Dwarf_Error error = 0;
     Dwarf_Attribute *atlist = 0;
     Dwarf_Signed atcnt = 0;
-    std::list<IRAttr> &attrlist = irdie.getAttributes();
+    std::vector<IRAttr> &attrlist = irdie.getAttributes();
     int res = dwarf_attrlist(in_die, &atlist,&atcnt,&error);
-    std::map<unsigned,unsigned> attrmap;
 
     (void)irep;
     if (res == DW_DLV_NO_ENTRY) {
@@ -395,42 +395,58 @@ get_attrs_of_die(Dwarf_Die in_die,IRDie &irdie,
         cerr << "dwarf_attrlist failed " << endl;
         exit(1);
     }
+    attrlist.reserve(atcnt);
     for (Dwarf_Signed i = 0; i < atcnt; ++i) {
         Dwarf_Attribute attr = atlist[i];
         Dwarf_Half attrnum = 0;
 
         res = dwarf_whatattr(attr,&attrnum,&error);
         if (res != DW_DLV_OK) {
+            for ( ; i < atcnt; ++i) {
+                dwarf_dealloc_attribute(atlist[i]);
+            }
             dwarf_dealloc(dbg,atlist, DW_DLA_LIST);
             cout << "ERROR FAIL: unable to get attrnum from attr!"
                 <<endl;
             return;
         }
-        std::map<unsigned,unsigned>::iterator m =
-            attrmap.find(attrnum);
-
-        if (m != attrmap.end()) {
+        // A DIE has few attributes, a linear search
+        // is cheapest.
+        bool duplicate = false;
+        for (std::vector<IRAttr>::iterator it = attrlist.begin();
+            it != attrlist.end(); ++it) {
+            if (it->getAttrNum() == attrnum) {
+                duplicate = true;
+                break;
+            }
+        }
+        if (duplicate) {
             //  A duplicate! ignore. Compiler bug
             //  in some gcc versions.
+            dwarf_dealloc_attribute(attr);
             continue;
         }
-        attrmap[attrnum] = i;
         // Use an empty attr to get a placeholder on
         // the attr list for this IRDie.
-        IRAttr irattr;
-        attrlist.push_back(irattr);
+        attrlist.push_back(IRAttr());
         // We want a pointer to the final attr to be
         // recorded for references, not a local temp IRAttr.
         IRAttr & lastirattr = attrlist.back();
         get_basic_attr_data_one_attr(dbg,attr,cudata,lastirattr);
+        // The IRForm holds copies of everything it needs,
+        // so free the attribute now rather than leaving
+        // it to dwarf_finish().
+        dwarf_dealloc_attribute(attr);
     }
     dwarf_dealloc(dbg,atlist, DW_DLA_LIST);
 }
 
-// Invariant: IRDie and IRCUdata are in the irep tree,
-// not local record references to local scopes.
+// Invariant: IRCUdata is in the irep tree,
+// not a local record reference to a local scope.
+// The parent is passed as an index as adding
+// children can move the IRDie records. See irepdie.h.
 static void
-get_children_of_die(Dwarf_Die in_die,IRDie&irdie,
+get_children_of_die(Dwarf_Die in_die,size_t parentindex,
     IRCUdata &ircudata,
     IRepresentation &irep,
     Dwarf_Debug dbg)
@@ -446,17 +462,12 @@ get_children_of_die(Dwarf_Die in_die,IRDie&irdie,
         cerr << "dwarf_child failed " << endl;
         exit(1);
     }
-    //std::list<IRDie> & childlist =  irdie.getChildren();
     for (;;) {
-        IRDie child;
+        size_t childindex = ircudata.addChildDie(parentindex);
+        IRDie &child = ircudata.getDie(childindex);
         get_basic_die_data(dbg,curchilddie,child);
-        irdie.addChild(child);
-        IRDie &lastchild = irdie.lastChild();
-        get_attrs_of_die(curchilddie,lastchild,ircudata,irep,dbg);
-
-        ircudata.insertLocalDieOffset(lastchild.getCURelativeOffset(),
-            &lastchild);
-        get_children_of_die(curchilddie,lastchild,ircudata,irep,dbg);
+        get_attrs_of_die(curchilddie,child,ircudata,irep,dbg);
+        get_children_of_die(curchilddie,childindex,ircudata,irep,dbg);
 
         Dwarf_Die tchild = 0;
         res = dwarf_siblingof_b(dbg,curchilddie,
@@ -741,11 +752,9 @@ readCUDataFromBinary(Dwarf_Debug dbg, IRepresentation & irep)
         IRCUdata & treecu = irep.infodata().lastCU();
         IRDie &cuirdie = treecu.baseDie();
         get_basic_die_data(dbg,cu_die,cuirdie);
-        treecu.insertLocalDieOffset(cuirdie.getCURelativeOffset(),
-            &cuirdie);
         get_attrs_of_die(cu_die,cuirdie,treecu,irep,dbg);
-        get_children_of_die(cu_die,cuirdie,treecu,irep,dbg);
-        get_linedata_of_cu_die(cu_die,cuirdie,treecu,irep,dbg);
+        get_children_of_die(cu_die,0,treecu,irep,dbg);
+        get_linedata_of_cu_die(cu_die,treecu.baseDie(),treecu,irep,dbg);
 
         // Now we have all local DIEs in the CU so we
         // can identify all targets of local CLASS_REFERENCE
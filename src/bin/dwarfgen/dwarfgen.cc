@@ -63,6 +63,21 @@
 //  where -c supplies a CU number of the obj input to output
 //         because the dwarf producer wants just one CU.
 //         Default is -1 which won't match anything.
+//  where --print-timing reports the seconds spent reading
+//         the input, adding DIEs to the producer, in
+//         dwarf_transform_to_disk_form_a(), writing the
+//         object and in dwarf_producer_finish_a(),
+//         and the DIEs per second for the whole round trip.
+//         See dwarfgenbench.sh.
+//  where --stream-output has the producer stream the section
+//         bytes to a sink (dwarf_pro_set_section_sink())
+//         instead of returning them from
+//         dwarf_get_section_bytes_a(). The output is the same.
+//  where --parallel-generation has the producer generate
+//         .debug_line, .debug_frame and .debug_info on
+//         separate threads
+//         (dwarf_pro_set_parallel_generation()).
+//         The output is the same.
 
 #include "config.h"
 
@@ -82,6 +97,7 @@
 #include <list>
 #include <map>
 #include <vector>
+#include <algorithm> // For std::lower_bound
 #include <string.h> /* for strchr etc */
 #ifdef HAVE_SYS_TYPES_H
 #include <sys/types.h>  /* For open() S_IRUSR etc */
@@ -90,6 +106,7 @@
 #include <sys/stat.h>  /* For open() S_IRUSR etc */
 #endif /* HAVE_SYS_STAT_H */
 #include <fcntl.h> //open
+#include <time.h> // clock()
 #include "general.h"
 #include "dg_getopt.h"
 #include "strtabdata.h"
@@ -171,6 +188,12 @@ static int CallbackFunc(
     Dwarf_Unsigned*     sect_name_symbol_index,
     void *              user_data,
     int*                error);
+static int StreamSink(
+    Dwarf_Unsigned      dw_section_index,
+    Dwarf_Ptr           bytes,
+    Dwarf_Unsigned      length,
+    void *              user_data,
+    int*                error);
 }
 // End extern "C"
 
@@ -298,9 +321,23 @@ CmdOptions cmdoptions = {
     false, //addframeadvanceloc
     false, //addSUNfuncoffsets
     false, //add_debug_sup
-    false //addskipbranch
+    false, //addskipbranch
+    false, //printtiming
+    false, //streamoutput
+    false //parallelgeneration
 };
 
+// With --print-timing the seconds spent in each phase
+// of generation are reported so producer changes can
+// be measured on large inputs.
+static double
+elapsed_secs(clock_t start)
+{
+    return (double)(clock() - start)/CLOCKS_PER_SEC;
+}
+static double disk_form_secs = 0.0;
+
+
 // loff_t is signed for some reason (strange)
 // but we make offsets unsigned.
 #define LOFFTODWUNS(x)  ( (Dwarf_Unsigned)(x))
@@ -712,6 +749,9 @@ main(int argc, char **argv)
             {"show-reloc-details",dwno_argument,0,'r'},
             {"high-pc-as-const",dwno_argument,0,'h'},
             {"add-skip-branch-ops",dwno_argument,0,1007},
+            {"print-timing",dwno_argument,0,1008},
+            {"stream-output",dwno_argument,0,1009},
+            {"parallel-generation",dwno_argument,0,1010},
             {0,0,0,0},
         };
         // -p is pointer size
@@ -770,6 +810,20 @@ main(int argc, char **argv)
                 //{"add-skip-branch-ops",dwno_argument,0,1007},
                 cmdoptions.addskipbranch = true;
                 break;
+            case 1008:
+                //{"print-timing",dwno_argument,0,1008},
+                cmdoptions.printtiming = true;
+                break;
+            case 1009:
+                //{"stream-output",dwno_argument,0,1009},
+                // To test dwarf_pro_set_section_sink().
+                cmdoptions.streamoutput = true;
+                break;
+            case 1010:
+                //{"parallel-generation",dwno_argument,0,1010},
+                // To test dwarf_pro_set_parallel_generation().
+                cmdoptions.parallelgeneration = true;
+                break;
             case 'c':
                 // At present we can only create a single
                 // cu in the output of the libdwarf producer.
@@ -861,8 +915,13 @@ main(int argc, char **argv)
             machine = EM_X86_64; /* from elf.h */
         }
 
+        clock_t phase_start = clock();
+        double read_secs = 0.0;
+        double irep_secs = 0.0;
+        double write_secs = 0.0;
         if (whichinput == OptReadBin) {
             createIrepFromBinary(infile,Irep);
+            read_secs = elapsed_secs(phase_start);
         } else if (whichinput == OptReadText) {
             cout << "dwarfgen: dwarfgen: text read not supported yet"
                 << endl;
@@ -940,9 +999,56 @@ main(int argc, char **argv)
         if (cmdoptions.adddebugsup) {
             create_debug_sup_content(dbg);
         }
+        if (cmdoptions.streamoutput) {
+            res = dwarf_pro_set_section_sink(dbg,StreamSink,0,&err);
+            if (res != DW_DLV_OK) {
+                cout << "dwarfgen: Failed " <<
+                    "dwarf_pro_set_section_sink" << endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+        if (cmdoptions.parallelgeneration) {
+            res = dwarf_pro_set_parallel_generation(dbg,TRUE,&err);
+            if (res == DW_DLV_ERROR) {
+                cout << "dwarfgen: Failed " <<
+                    "dwarf_pro_set_parallel_generation" << endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+        phase_start = clock();
         transform_irep_to_dbg(dbg,Irep,cu_of_input_we_output);
+        irep_secs = elapsed_secs(phase_start);
+        phase_start = clock();
         write_object_file(dbg,Irep,machine,endian, dwbitflags,
             user_data);
+        write_secs = elapsed_secs(phase_start);
+        if (cmdoptions.printtiming) {
+            cout << std::fixed << std::setprecision(3);
+            cout << "Timing: read input       " << read_secs <<
+                " sec" << endl;
+            cout << "Timing: add DIEs         " << irep_secs <<
+                " sec" << endl;
+            cout << "Timing: disk form        " << disk_form_secs <<
+                " sec" << endl;
+            cout << "Timing: write object     " << write_secs <<
+                " sec" << endl;
+
+            Dwarf_Unsigned diecount = 0;
+            std::list<IRCUdata> &culist = Irep.infodata().getCUData();
+            for (std::list<IRCUdata>::iterator it = culist.begin();
+                it != culist.end(); ++it) {
+                diecount += it->getDieCount();
+            }
+            double roundtrip_secs = read_secs + irep_secs + write_secs;
+            cout << "Timing: round trip       " << roundtrip_secs <<
+                " sec, " << diecount << " DIEs";
+            if (roundtrip_secs > 0.0) {
+                cout << ", " << std::setprecision(0) <<
+                    (double)diecount/roundtrip_secs << " DIEs/sec" <<
+                    std::setprecision(3);
+            }
+            cout << endl;
+        }
 
         Dwarf_Unsigned str_count = 0;
         Dwarf_Unsigned str_len = 0;
@@ -967,7 +1073,12 @@ main(int argc, char **argv)
             cout << "Debug_Str: Reused count " <<reused_count <<
                 ", byte total len not emitted " <<reused_len << endl;
         }
+        phase_start = clock();
         dwarf_producer_finish_a( dbg, 0);
+        if (cmdoptions.printtiming) {
+            cout << "Timing: producer finish  " <<
+                elapsed_secs(phase_start) << " sec" << endl;
+        }
         return 0;
     } // End try
     catch (std::bad_alloc &ba) {
@@ -1135,6 +1246,30 @@ create_text_section(void)
 // malloc block to contain it all pointing
 // to it with the public struct DW_Elf_Data that
 // _dwarf_elf_newdata() creates.
+// The section bytes passed to StreamSink() are only valid
+// during the call, so they are copied here. A std::list
+// so the copies never move once added to a section.
+static std::list<std::vector<unsigned char> > streamedbytes;
+
+extern "C" {
+static int
+StreamSink(Dwarf_Unsigned dw_section_index,
+    Dwarf_Ptr bytes,
+    Dwarf_Unsigned length,
+    void *user_data,
+    int *error)
+{
+    (void)user_data;
+    (void)error;
+    unsigned char *b = static_cast<unsigned char *>(bytes);
+    streamedbytes.push_back(std::vector<unsigned char>(b,b+length));
+    SectionForDwarf &ds = dwsectab[dw_section_index];
+    ds.add_section_content(streamedbytes.back().data(),length);
+    return DW_DLV_OK;
+}
+}
+// End extern "C"
+
 // d is dwarfgen section index 
 static void
 InsertDataIntoElf(Dwarf_Unsigned d,Dwarf_P_Debug dbg)
@@ -1303,10 +1438,12 @@ write_generated_dbg(Dwarf_P_Debug dbg,
     // Sectioncount here is dwarfgen blob count, not Elf
     // or even section count
     Dwarf_Unsigned sectioncount = 0;
+    clock_t start = clock();
 
     //  This call does callbacks to inform of all the sections
     //  we need to create.
     int res = dwarf_transform_to_disk_form_a(dbg,&sectioncount,&err);
+    disk_form_secs = elapsed_secs(start);
     if (res != DW_DLV_OK) {
         if (res == DW_DLV_ERROR) {
             string msg(dwarf_errmsg(err));
@@ -1317,6 +1454,8 @@ write_generated_dbg(Dwarf_P_Debug dbg,
         cout << "Dwarfgen fails, some internal error " << endl;
         exit(1);
     }
+    // With --stream-output sectioncount is zero,
+    // StreamSink() already saved the bytes.
     Dwarf_Unsigned d = 0;
     for (d = 0; d < sectioncount ; ++d) {
         InsertDataIntoElf(d,dbg);
@@ -0,0 +1,73 @@
+#!/bin/sh
+#
+# This code is public domain and can be freely used or copied.
+#
+# Generation benchmark for libdwarfp through dwarfgen.
+# Writes a C source with many structs, enums and functions
+# of varied shape (so the producer sees many distinct
+# abbreviations: attribute forms change with the size of
+# line numbers, file numbers, offsets and constants),
+# compiles it with -g and has dwarfgen regenerate its
+# single CU with --print-timing, which ends with the
+# round trip (read, IR, write) throughput in DIEs/sec.
+#
+# Usage: dwarfgenbench.sh [count] [path-to-dwarfgen]
+#   count  number of structs/functions (default 20000)
+# CC and CFLAGS are honored. The work files are left
+# in $TMPDIR (or /tmp) as dwarfgenbench.c/.o.
+
+n=${1:-20000}
+dg=${2:-./dwarfgen}
+cc=${CC:-cc}
+cflags=${CFLAGS:--gdwarf-4 -O0}
+t=${TMPDIR:-/tmp}
+src=$t/dwarfgenbench.c
+obj=$t/dwarfgenbench.o
+out=$t/dwarfgenbench.out.o
+
+awk -v n=$n 'BEGIN {
+  split("char short int long float double", ty, " ");
+  for (i = 0; i < n; i++) {
+    printf "#line %d \"f%d.h\"\n", (i*7919)%200000+1, i%397;
+    printf "struct s%d {", i;
+    m = i % 13 + 1;
+    if (i % 11 == 0) printf " char pad[%d];", (i%3)*200+1;
+    for (j = 0; j < m; j++) {
+      if ((i+j) % 5 == 0) printf " unsigned b%d:%d;", j, (i+j)%31+1;
+      else if ((i+j) % 7 == 0) printf " %s a%d[%d];",
+          ty[(i+j)%6+1], j, (i*j)%70000+1;
+      else if ((i+j) % 3 == 0) printf " const volatile %s *p%d;",
+          ty[(i+j)%6+1], j;
+      else printf " %s m%d;", ty[(i+j)%6+1], j;
+    }
+    printf " };\n";
+    if (i % 3 == 0) {
+      printf "enum e%d {", i;
+      for (j = 0; j < i % 5 + 1; j++)
+        printf " e%d_%d = %d,", i, j, (i%4 == 0)? -j*70000 : j*(i%300);
+      printf " };\n";
+      printf "enum e%d ev%d;\n", i, i;
+    }
+    printf "#line %d \"g%d.c\"\n", (i*104729)%300000+1, i%353;
+    if (i % 4 == 0) printf "static ";
+    if (i % 6 == 0) printf "inline ";
+    if (i % 17 == 0) printf "__attribute__((noreturn)) void ";
+    else printf "%s ", ty[i%6+1];
+    printf "fn%d(struct s%d *q", i, i;
+    for (j = 0; j < i % 5; j++) printf ", %s x%d", ty[(i+j)%6+1], j;
+    printf ") {";
+    for (j = 0; j < i % 4; j++)
+      printf " %s v%d = (%s)%d;", ty[(j+i)%6+1], j, ty[(j+i)%6+1], j;
+    if (i % 9 == 0 && i % 6 != 0) printf " { static int st%d; st%d = %d; }", i, i, i;
+    if (i % 17 == 0) {
+      printf " for (;;) { q = q; } }\n";
+    } else {
+      printf " return (%s)(sizeof(*q)", ty[i%6+1];
+      for (j = 0; j < i % 4; j++) printf " + v%d", j;
+      printf "); }\n";
+    }
+    printf "void *use%d = (void*)fn%d;\n", i, i;
+  }
+}' > $src || exit 1
+$cc $cflags -c -o $obj $src || exit 1
+$dg -t obj -c 0 --print-timing -o $out $obj | grep '^Timing'
@@ -48,6 +48,9 @@ extern struct CmdOptions {
     bool addSUNfuncoffsets;
     bool adddebugsup;
     bool addskipbranch;
+    bool printtiming;
+    bool streamoutput;
+    bool parallelgeneration;
 } cmdoptions;
 
 template <typename T >
@@ -53,6 +53,7 @@
 #include <list>
 #include <map>
 #include <vector>
+#include <algorithm> // For std::lower_bound
 #include <string.h> // For memset etc
 #include "general.h"
 #include "strtabdata.h"
@@ -444,7 +445,7 @@ AddAttrToDie(Dwarf_P_Debug dbg,
 void
 IRCUdata::updateClassReferenceTargets()
 {
-    for (std::list<ClassReferenceFixupData>::iterator it =
+    for (std::vector<ClassReferenceFixupData>::iterator it =
         classReferenceFixupList_.begin();
         it != classReferenceFixupList_.end();
         ++it) {
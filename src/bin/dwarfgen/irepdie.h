@@ -58,8 +58,29 @@ public:
             formdata_ = 0;
         }
     };
+    // Moving hands over the IRForm, so a std::vector<IRAttr>
+    // can grow without cloning every form.
+    IRAttr(IRAttr &&r) noexcept:
+        attr_(r.attr_),finalform_(r.finalform_),
+        initialform_(r.initialform_),
+        formclass_(r.formclass_),formdata_(r.formdata_) {
+        r.formdata_ = 0;
+    };
     ~IRAttr() {
         delete formdata_; };
+    IRAttr & operator=(IRAttr &&r) noexcept {
+        if(this == &r) {
+            return *this;
+        }
+        delete formdata_;
+        attr_ = r.attr_;
+        finalform_ = r.finalform_;
+        initialform_ = r.initialform_;
+        formclass_ = r.formclass_;
+        formdata_ = r.formdata_;
+        r.formdata_ = 0;
+        return *this;
+    }
     IRAttr & operator=( const IRAttr &r) {
         if(this == &r) {
             return *this;
@@ -111,16 +132,20 @@ private:
     IRForm *formdata_;
 };
 
+// IRDie records live in a single std::vector owned by their
+// IRCUdata, in input (preorder) order. The tree links are
+// indexes into that vector, 0 meaning none: index 0 is the
+// CU die, which is never anyone's child or sibling.
+// Because the vector can grow while a CU is read, keep
+// IRDie indexes (not pointers or references) until
+// the whole CU is read in.
 class IRDie {
 public:
     IRDie():tag_(0),globalOffset_(0), cuRelativeOffset_(0),
-        generatedDie_(0) {};
-    ~IRDie() {};
-    void addChild(const IRDie & newdie ) {
-        children_.push_back(newdie);
-    };
+        generatedDie_(0),firstChild_(0),lastChild_(0),
+        nextSibling_(0) {};
     std::string  getName() {
-        std::list<IRAttr>::iterator it = attrs_.begin();
+        std::vector<IRAttr>::iterator it = attrs_.begin();
         for( ; it != attrs_.end() ; ++it) {
             if (it->getAttrNum() == DW_AT_name) {
                 IRForm *f = it->getFormData();
@@ -133,18 +158,8 @@ public:
         }
         return "";
     };
-    std::list<IRAttr> & getAttributes() {return attrs_; };
-    std::list<IRDie> & getChildren() {return children_; };
-    bool hasNewestChild(IRDie **lastch) { size_t N = children_.size();
-        if(N < 1) {
-            return false;
-        }
-        *lastch = &children_.back();
-        return true;
-    };
-    // lastChild and lastAttr will throw if no entry exists.
-    IRDie &lastChild() { return children_.back(); };
-    IRAttr &lastAttr() { return attrs_.back(); };
+    std::vector<IRAttr> & getAttributes() {return attrs_; };
+    bool hasChildren() const { return firstChild_ != 0; };
     void setBaseData(Dwarf_Half tag,Dwarf_Unsigned goff,
         Dwarf_Unsigned cuoff) {
         tag_ = tag;
@@ -159,11 +174,9 @@ public:
     unsigned getTag() {return tag_; }
 
 private:
-   // We rely on the IRDie container being one which does not
-   // invalidate pointers with addition/deletion.
-   std::list<IRDie>  children_;
+   friend class IRCUdata;
 
-   std::list<IRAttr> attrs_;
+   std::vector<IRAttr> attrs_;
    unsigned tag_;
    // The following are data from input.
    Dwarf_Unsigned globalOffset_;
@@ -171,6 +184,11 @@ private:
 
    // the following is generated during output.
    Dwarf_P_Die generatedDie_;
+
+   // Indexes into the IRCUdata DIE vector.
+   size_t firstChild_;
+   size_t lastChild_;
+   size_t nextSibling_;
 };
 
 
@@ -223,7 +241,8 @@ public:
         has_linedata_(false),
         linedata_offset_(0),
         cudie_offset_(0),
-        dwarf32bit_(0)
+        dwarf32bit_(0),
+        dies_(1)
         {};
 
     IRCUdata(Dwarf_Unsigned len,Dwarf_Half version,
@@ -245,7 +264,8 @@ public:
         has_linedata_(false),
         linedata_offset_(0),
         cudie_offset_(0) ,
-        dwarf32bit_(0){};
+        dwarf32bit_(0),
+        dies_(1) {};
     ~IRCUdata() { };
     bool hasMacroData(Dwarf_Unsigned *offset_out,Dwarf_Unsigned *cudie_off) {
         *offset_out = macrodata_offset_;
@@ -267,26 +287,50 @@ public:
         linedata_offset_ = offset;
         cudie_offset_ = cudieoff;
     };
-    IRDie & baseDie() { return cudie_; };
+    IRDie & baseDie() { return dies_[0]; };
+    IRDie & getDie(size_t index) { return dies_[index]; };
+    size_t getDieCount() const { return dies_.size(); };
+    // Appends a new last child of dies_[parent] and
+    // returns its index.
+    size_t addChildDie(size_t parent) {
+        size_t index = dies_.size();
+        dies_.push_back(IRDie());
+        IRDie &p = dies_[parent];
+        if (p.lastChild_) {
+            dies_[p.lastChild_].nextSibling_ = index;
+        } else {
+            p.firstChild_ = index;
+        }
+        p.lastChild_ = index;
+        return index;
+    };
+    IRDie * firstChild(const IRDie &d) {
+        return d.firstChild_? &dies_[d.firstChild_]:NULL;
+    };
+    IRDie * nextSibling(const IRDie &d) {
+        return d.nextSibling_? &dies_[d.nextSibling_]:NULL;
+    };
     Dwarf_Half getVersionStamp() { return version_stamp_; };
     Dwarf_Half getOffsetSize() { return length_size_; };
     Dwarf_Unsigned getCUdieOffset() { return cudie_offset_; };
     IRCULineData & getCULines() { return cu_lines_; };
 
-    void insertLocalDieOffset(Dwarf_Unsigned localoff,IRDie* dieptr) {
-        cuOffInLocalToIRDie_[localoff] = dieptr;
-    };
     void insertLocalReferenceAttrTargetRef(Dwarf_Unsigned localoff,
         IRFormReference* attrptr) {
 
         cuOffInLocalToIRFormRef_.push_back(OffsetFormEntry(localoff,
             attrptr));
     };
+    // The DIEs were appended in preorder, so dies_ is sorted
+    // by CU-relative offset and serves as the offset map.
     IRDie * getLocalDie(Dwarf_Unsigned localoff) {
-        std::map<Dwarf_Unsigned,IRDie*>::iterator pos;
-        pos = cuOffInLocalToIRDie_.find(localoff);
-        if(pos != cuOffInLocalToIRDie_.end()) {
-            return pos->second;
+        std::vector<IRDie>::iterator pos =
+            std::lower_bound(dies_.begin(),dies_.end(),localoff,
+            [](const IRDie &d,Dwarf_Unsigned off) {
+                return d.getCURelativeOffset() < off; });
+        if(pos != dies_.end() &&
+            pos->getCURelativeOffset() == localoff) {
+            return &*pos;
         }
         return NULL;
     };
@@ -295,12 +339,12 @@ public:
     }
     void updateClassReferenceTargets();
     std::string  getCUName() {
-        return cudie_.getName();
+        return dies_[0].getName();
     };
-    // Use  cuOffInLocalToIRDie_ and
-    // cuOffInLocalToIRAttr_ to update attr targets.
+    // Use  dies_ and
+    // cuOffInLocalToIRFormRef_ to update attr targets.
     void updateReferenceAttrDieTargets() {
-        for(std::list<OffsetFormEntry>::iterator it =
+        for(std::vector<OffsetFormEntry>::iterator it =
             cuOffInLocalToIRFormRef_.begin();
             it != cuOffInLocalToIRFormRef_.end();
             ++it) {
@@ -357,23 +401,20 @@ private:
     bool dwarf32bit_;
     IRCULineData      cu_lines_;
     // If true, is 32bit dwarf,else 64bit. Gives the size of a reference.
-    IRDie   cudie_;
 
-    // Refers to cu-local offsets in the input CU and which DIE
-    // in the input they target for this CU.
-    // Used to find the target DIE for the IRAttrs
-    // referenced by  cuOffInLocalToIRAttr_
-    std::map<Dwarf_Unsigned,IRDie*> cuOffInLocalToIRDie_;
+    // Every DIE of the CU, dies_[0] being the CU die.
+    // See IRDie.
+    std::vector<IRDie> dies_;
 
     // Refers to IRAttrs which make a CU local reference
     // meaning CLASS_REFERENCE IRFormReference to a cu-local die
-    // Once Input dies read in this and cuOffInLocalToIRDie_
+    // Once Input dies read in this and dies_
     // are used to update the IRAttr itself.
-    std::list<OffsetFormEntry> cuOffInLocalToIRFormRef_;
+    std::vector<OffsetFormEntry> cuOffInLocalToIRFormRef_;
 
     // The data needed to get the Dwarf_P_Die  set for
     // some class reference instances.
-    std::list<ClassReferenceFixupData> classReferenceFixupList_;
+    std::vector<ClassReferenceFixupData> classReferenceFixupList_;
 };
 
 class IRDInfo {
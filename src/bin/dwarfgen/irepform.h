@@ -182,7 +182,8 @@ public:
         fromloclist_ = bl->bl_from_loclist;
         sectionoffset_ = bl->bl_section_offset;
     };
-    std::vector<Dwarf_Small> getBlockData(){ return blockdata_;};
+    const std::vector<Dwarf_Small> & getBlockData() const {
+        return blockdata_;};
 private:
     Dwarf_Half finalform_;
     // In most cases directform == indirect form.
@@ -324,7 +325,8 @@ public:
     Dwarf_Half getInitialForm() { return initialform_;}
     Dwarf_Half getFinalForm() {return finalform_;}
     enum Dwarf_Form_Class getFormClass() const { return formclass_; };
-    std::vector<char> getexprlocdata() const {return exprlocdata_; };
+    const std::vector<char> & getexprlocdata() const {
+        return exprlocdata_; };
     void insertBlock(Dwarf_Unsigned len, Dwarf_Ptr data) {
         char *d = static_cast<char *>(data);
         exprlocdata_.clear();
@@ -51,6 +51,7 @@
 #include <list>
 #include <map>
 #include <vector>
+#include <algorithm> // For std::lower_bound
 #include <string.h> // For memset etc
 #include "strtabdata.h"
 #include "dwarf.h"
@@ -156,7 +157,7 @@ addSkipBranchOps(Dwarf_P_Debug dbg,
     Dwarf_P_Die ourdie,
     IRDie &inDie,
     IRDie &inParent,
-    list<IRAttr>& attrs,
+    std::vector<IRAttr>& attrs,
     unsigned level)
 {
     static int done  = false;
@@ -176,7 +177,7 @@ addSkipBranchOps(Dwarf_P_Debug dbg,
     if (dietag != DW_TAG_variable) {
         return;
     }
-    for (list<IRAttr>::iterator it = attrs.begin();
+    for (std::vector<IRAttr>::iterator it = attrs.begin();
         it != attrs.end();
         it++) {
         IRAttr & attr = *it;
@@ -199,7 +200,6 @@ addSkipBranchOps(Dwarf_P_Debug dbg,
                 break;
             }
 
-            std::vector<unsigned char> vec= f2->getBlockData();
             Dwarf_Block bl;
             int res = createskipbranchblock(dbg,bl);
             if (res != DW_DLV_OK) {
@@ -221,7 +221,7 @@ specialAttrTransformations(Dwarf_P_Debug dbg,
     IRepresentation & Irep,
     Dwarf_P_Die ourdie,
     IRDie &inDie,
-    list<IRAttr>& attrs,
+    std::vector<IRAttr>& attrs,
     unsigned level)
 {
     (void)dbg;
@@ -241,7 +241,7 @@ specialAttrTransformations(Dwarf_P_Debug dbg,
     bool foundlopc= false;
     Dwarf_Addr lopcval = 0;
     Dwarf_Addr hipcval = 0;
-    for (list<IRAttr>::iterator it = attrs.begin();
+    for (std::vector<IRAttr>::iterator it = attrs.begin();
         it != attrs.end();
         it++) {
         IRAttr & attr = *it;
@@ -293,8 +293,8 @@ specialAttrTransformations(Dwarf_P_Debug dbg,
     }
     Dwarf_Addr hipcoffset = hipcval - lopcval;
     // Now we create a revised attribute.
-    list<IRAttr> revisedattrs;
-    for (list<IRAttr>::iterator it = attrs.begin();
+    std::vector<IRAttr> revisedattrs;
+    for (std::vector<IRAttr>::iterator it = attrs.begin();
         it != attrs.end();
         it++) {
         IRAttr & attr = *it;
@@ -333,7 +333,7 @@ addData16DataItem(Dwarf_P_Debug dbg,
     Dwarf_P_Die ourdie,
     IRDie &inDie,
     IRDie &inParent,
-    list<IRAttr>& attrs,
+    std::vector<IRAttr>& attrs,
     unsigned level)
 {
     static bool alreadydone = false;
@@ -357,8 +357,8 @@ addData16DataItem(Dwarf_P_Debug dbg,
     if (dietag != DW_TAG_variable || parenttag != DW_TAG_subprogram) {
         return;
     }
-    list<IRAttr> revisedattrs;
-    for (list<IRAttr>::iterator it = attrs.begin();
+    std::vector<IRAttr> revisedattrs;
+    for (std::vector<IRAttr>::iterator it = attrs.begin();
         it != attrs.end();
         it++) {
         IRAttr & attr = *it;
@@ -430,7 +430,7 @@ addSUNfuncoffsets(Dwarf_P_Debug dbg ,
     Dwarf_P_Die ourdie,
     IRDie &inDie,
     IRDie &inParent,
-    list<IRAttr>& attrs,
+    std::vector<IRAttr>& attrs,
     unsigned level)
 {
     (void)Irep;
@@ -493,7 +493,7 @@ addImplicitConstItem(Dwarf_P_Debug dbg,
     Dwarf_P_Die ourdie,
     IRDie &inDie,
     IRDie &inParent,
-    list<IRAttr>& attrs,
+    std::vector<IRAttr>& attrs,
     unsigned level)
 {
     static int alreadydone = 0;
@@ -521,8 +521,8 @@ addImplicitConstItem(Dwarf_P_Debug dbg,
     if (dietag != DW_TAG_variable || parenttag != DW_TAG_subprogram) {
         return;
     }
-    list<IRAttr> revisedattrs;
-    for (list<IRAttr>::iterator it = attrs.begin();
+    std::vector<IRAttr> revisedattrs;
+    for (std::vector<IRAttr>::iterator it = attrs.begin();
         it != attrs.end();
         it++) {
         IRAttr & attr = *it;
@@ -583,7 +583,6 @@ HandleOneDieAndChildren(Dwarf_P_Debug dbg,
     IRDie    &inParent,
     unsigned level)
 {
-    list<IRDie>& children = inDie.getChildren();
     // We create our target DIE first so we can link
     // children to it, but add no content yet.
     Dwarf_P_Die gendie =  0;
@@ -596,12 +595,10 @@ HandleOneDieAndChildren(Dwarf_P_Debug dbg,
     inDie.setGeneratedDie(gendie);
 
     Dwarf_P_Die lastch = 0;
-    for ( list<IRDie>::iterator it = children.begin();
-        it != children.end();
-        it++) {
-        IRDie & ch = *it;
+    for (IRDie *ch = cu.firstChild(inDie); ch;
+        ch = cu.nextSibling(*ch)) {
         Dwarf_P_Die chp = HandleOneDieAndChildren(dbg,Irep,
-            cu,ch,inDie,level+1);
+            cu,*ch,inDie,level+1);
         int res2 = 0;
 
         if (lastch) {
@@ -619,7 +616,7 @@ HandleOneDieAndChildren(Dwarf_P_Debug dbg,
         lastch = chp;
     }
     {
-    list<IRAttr>& attrs = inDie.getAttributes();
+    std::vector<IRAttr>& attrs = inDie.getAttributes();
 
     // Now any special transformations to the attrs list.
     specialAttrTransformations(dbg,Irep,gendie,inDie,attrs,level);
@@ -630,7 +627,7 @@ HandleOneDieAndChildren(Dwarf_P_Debug dbg,
 
     // Now we add attributes (content), if any, to the
     // output die 'gendie'.
-    for (list<IRAttr>::iterator it = attrs.begin();
+    for (std::vector<IRAttr>::iterator it = attrs.begin();
         it != attrs.end();
         it++) {
         IRAttr & attr = *it;
@@ -1061,29 +1058,24 @@ transform_macro_info(Dwarf_P_Debug dbg,
     }
 }
 
-// Starting at a Die, look through its children
-// in its input to find which one we have by
-// comparing the input-die global offset.
+// Find the generated output DIE for an input DIE
+// of this CU given the input-die global offset.
 static
-Dwarf_P_Die findTargetDieByOffset(IRDie& indie,
+Dwarf_P_Die findTargetDieByOffset(IRCUdata &cu,
     Dwarf_Unsigned targetglobaloff)
 {
-    Dwarf_Unsigned globoff = indie.getGlobalOffset();
-    if (globoff == targetglobaloff) {
-        return indie.getGeneratedDie();
+    IRDie &basedie = cu.baseDie();
+    Dwarf_Unsigned cuglobaloff = basedie.getGlobalOffset() -
+        basedie.getCURelativeOffset();
+
+    if (targetglobaloff < cuglobaloff) {
+        return NULL;
     }
-    std::list<IRDie> dielist =  indie.getChildren();
-    for ( list<IRDie>::iterator it = dielist.begin();
-        it != dielist.end();
-        it++) {
-        IRDie &ldie = *it;
-        Dwarf_P_Die foundDie = findTargetDieByOffset(ldie,
-            targetglobaloff);
-        if (foundDie) {
-            return foundDie;
-        }
+    IRDie *d = cu.getLocalDie(targetglobaloff - cuglobaloff);
+    if (!d) {
+        return NULL;
     }
-    return NULL;
+    return d->getGeneratedDie();
 }
 
 // If the pubnames/pubtypes entry is in the
@@ -1098,7 +1090,6 @@ transform_debug_pubnames_types_inner(Dwarf_P_Debug dbg,
 {
     // First, get the target CU. */
     Dwarf_Unsigned targetcuoff= cu.getCUdieOffset();
-    IRDie &basedie = cu.baseDie();
     IRPubsData& pubs = Irep.pubnamedata();
     std::list<IRPub> &nameslist = pubs.getPubnames();
 
@@ -1113,7 +1104,7 @@ transform_debug_pubnames_types_inner(Dwarf_P_Debug dbg,
             if (pubcuoff != targetcuoff) {
                 continue;
             }
-            Dwarf_P_Die targdie = findTargetDieByOffset(basedie,
+            Dwarf_P_Die targdie = findTargetDieByOffset(cu,
                 ourdieoff);
             if (targdie) {
                 // Ugly. Old mistake in libdwarf declaration.
@@ -1148,7 +1139,7 @@ transform_debug_pubnames_types_inner(Dwarf_P_Debug dbg,
             if (pubcuoff != targetcuoff) {
                 continue;
             }
-            Dwarf_P_Die targdie = findTargetDieByOffset(basedie,
+            Dwarf_P_Die targdie = findTargetDieByOffset(cu,
                 ourdieoff);
             if (targdie) {
                 // Ugly. Old mistake in libdwarf declaration.
@@ -1158,7 +1149,7 @@ transform_debug_pubnames_types_inner(Dwarf_P_Debug dbg,
                     dbg,targdie,
                     mystr,
                     &error);
-                if (!res) {
+                if (res != DW_DLV_OK) {
                     cerr << "Failed to add pubtype entry for offset"
                         << ourdieoff
                         << "in CU at offset " << pubcuoff << endl;
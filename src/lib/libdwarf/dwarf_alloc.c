@@ -132,6 +132,64 @@ int dwarf_set_de_alloc_flag(int v)
     return ov;
 }
 
+/*  See dwarf_set_allocator(). Copied into each
+    Dwarf_Debug (and object reader) created without
+    an allocator of its own (see dwarf_init_path_alloc()).
+    All zero means malloc()/free(). */
+static Dwarf_Allocator global_allocator;
+
+int
+dwarf_set_allocator(const Dwarf_Allocator *newalloc,
+    Dwarf_Allocator *oldalloc)
+{
+    if (newalloc && (!newalloc->da_malloc != !newalloc->da_free)) {
+        /* Only one of the pair provided. */
+        return DW_DLV_ERROR;
+    }
+    if (oldalloc) {
+        *oldalloc = global_allocator;
+    }
+    if (newalloc) {
+        global_allocator = *newalloc;
+    } else {
+        memset(&global_allocator,0,sizeof(global_allocator));
+    }
+    return DW_DLV_OK;
+}
+
+void
+_dwarf_choose_allocator(const Dwarf_Allocator *requested,
+    Dwarf_Allocator *out)
+{
+    if (requested) {
+        *out = *requested;
+        return;
+    }
+    *out = global_allocator;
+}
+
+void *
+_dwarf_allocator_malloc(Dwarf_Allocator *a, Dwarf_Unsigned len)
+{
+    if (a->da_malloc) {
+        return a->da_malloc(a->da_user_data,len);
+    }
+    return malloc((size_t)len);
+}
+
+void
+_dwarf_allocator_free(Dwarf_Allocator *a, void *space)
+{
+    if (!space) {
+        return;
+    }
+    if (a->da_free) {
+        a->da_free(a->da_user_data,space);
+        return;
+    }
+    free(space);
+}
+
 void
 _dwarf_error_destructor(void *m)
 {
@@ -215,6 +273,20 @@ dw_empty_errlist_item(Dwarf_Error e_in)
     }
 }
 
+/*  For an error about to be freed
+    by dwarf_dealloc(). */
+static void
+dw_remove_from_static_err_list(Dwarf_Error e_in)
+{
+    unsigned i = 0;
+
+    for ( ; i <static_used; ++i) {
+        if (staticerrlist[i] == e_in) {
+            staticerrlist[i] = 0;
+        }
+    }
+}
+
 /*  If the userr calls dwarf_dealloc on an error
     out of a dwarf_init*() call, this will find
     it in the static err list. Here dbg is NULL
@@ -256,7 +328,7 @@ _dwarf_free_static_errlist(void)
 }
 
 static const
-struct ial_s alloc_instance_basics[ALLOC_AREA_INDEX_TABLE_MAX] = {
+struct ial_s alloc_instance_basics[] = {
     /* 0  none */
     { 1,MULTIPLY_NO, 0, 0},
 
@@ -491,6 +563,19 @@ struct ial_s alloc_instance_basics[ALLOC_AREA_INDEX_TABLE_MAX] = {
     {sizeof(struct Dwarf_Debug_Addr_Table_s),MULTIPLY_NO, 0,0},
 };
 
+/*  Compile-time checks (a negative array size fails
+    to compile) that the table has exactly one entry
+    per allocation type and that the last DW_DLA
+    type is in it, so ps_alloc_count[] in
+    Dwarf_Perf_Stats cannot be indexed out of range.
+    Adding a DW_DLA type means adding a table entry
+    and raising DW_PERF_ALLOC_TYPE_COUNT. */
+typedef char _dwarf_alloc_table_size_check[
+    (sizeof(alloc_instance_basics)/sizeof(struct ial_s) ==
+    ALLOC_AREA_INDEX_TABLE_MAX)? 1: -1];
+typedef char _dwarf_alloc_last_type_check[
+    (DW_DLA_DEBUG_ADDR < ALLOC_AREA_INDEX_TABLE_MAX)? 1: -1];
+
 /*  We are simply using the incoming pointer as the key-pointer.
 */
 
@@ -512,6 +597,7 @@ tdestroy_free_node(void *nodep)
     char                  *malloc_addr =  0;
     struct reserve_data_s *reserve =  0;
     unsigned int           type = 0;
+    Dwarf_Debug            dbg = 0;
 
     m = (char *)nodep;
     if ((uintptr_t)m > DW_RESERVE) {
@@ -539,7 +625,8 @@ tdestroy_free_node(void *nodep)
     if (alloc_instance_basics[type].specialdestructor) {
         alloc_instance_basics[type].specialdestructor(m);
     }
-    free(malloc_addr);
+    dbg = (Dwarf_Debug)reserve->rd_dbg;
+    _dwarf_allocator_free(&dbg->de_allocator,malloc_addr);
 }
 
 /*  The sort of hash table entries result in very simple
@@ -620,10 +707,12 @@ _dwarf_get_alloc(Dwarf_Debug dbg,
             sizeof(Dwarf_Addr) : sizeof(Dwarf_Off));
     }
     size += DW_RESERVE;
-    alloc_mem = malloc(size);
+    alloc_mem = _dwarf_allocator_malloc(&dbg->de_allocator,size);
     if (!alloc_mem) {
         return NULL;
     }
+    DW_PERF_ADD(dbg,ps_alloc_count[alloc_type],1);
+    DW_PERF_ADD(dbg,ps_alloc_bytes,size);
     {
         char * ret_mem = alloc_mem + DW_RESERVE;
         void *key = ret_mem;
@@ -977,10 +1066,22 @@ dwarf_dealloc(Dwarf_Debug dbg,
             In any case, we simply don't worry about it.
             Not Supposed To Happen. */
     }
+    if (!r->rd_dbg) {
+        /*  A DE_MALLOC error from
+            _dwarf_special_no_dbg_error_malloc(),
+            which uses plain malloc(). It is on the
+            static list, _dwarf_free_static_errlist()
+            must not free it again. */
+        dw_remove_from_static_err_list((Dwarf_Error)space);
+        r->rd_length = 0;
+        r->rd_type = 0;
+        free(malloc_addr);
+        return;
+    }
     r->rd_dbg  = (void *)(uintptr_t)0xfeadbeef;
     r->rd_length = 0;
     r->rd_type = 0;
-    free(malloc_addr);
+    _dwarf_allocator_free(&dbg->de_allocator,malloc_addr);
     return;
 }
 
@@ -989,15 +1090,20 @@ dwarf_dealloc(Dwarf_Debug dbg,
     since one does not exist.
 */
 Dwarf_Debug
-_dwarf_get_debug(Dwarf_Unsigned filesize)
+_dwarf_get_debug(Dwarf_Unsigned filesize,
+    const Dwarf_Allocator *requested)
 {
     Dwarf_Debug dbg;
+    Dwarf_Allocator alloc;
 
-    dbg = (Dwarf_Debug) malloc(sizeof(struct Dwarf_Debug_s));
+    _dwarf_choose_allocator(requested,&alloc);
+    dbg = (Dwarf_Debug)_dwarf_allocator_malloc(&alloc,
+        sizeof(struct Dwarf_Debug_s));
     if (!dbg) {
         return NULL;
     }
     memset(dbg, 0, sizeof(struct Dwarf_Debug_s));
+    dbg->de_allocator = alloc;
     /* Set up for a dwarf_tsearch hash table */
     dbg->de_magic = DBG_IS_VALID;
 
@@ -1021,10 +1127,10 @@ _dwarf_get_debug(Dwarf_Unsigned filesize)
     space (to ensure it is read-write or to decompress it
     respectively, or both). In that case, free the space.  */
 static void
-malloc_section_free(struct Dwarf_Section_s * sec)
+malloc_section_free(Dwarf_Debug dbg,struct Dwarf_Section_s * sec)
 {
     if (sec->dss_data_was_malloc) {
-        free(sec->dss_data);
+        _dwarf_allocator_free(&dbg->de_allocator,sec->dss_data);
     }
     sec->dss_data = 0;
     sec->dss_data_was_malloc = 0;
@@ -1050,6 +1156,7 @@ freecontextlist(Dwarf_Debug dbg, Dwarf_Debug_InfoTypes dis)
             dwarf_die_deliv.c */
         free(hash_table);
         context->cc_abbrev_hash_table = 0;
+        _dwarf_free_die_table(context);
         dwarf_dealloc(dbg, context, DW_DLA_CU_CONTEXT);
     }
     dis->de_cu_context_list = 0;
@@ -1068,6 +1175,7 @@ int
 _dwarf_free_all_of_one_debug(Dwarf_Debug dbg)
 {
     unsigned g = 0;
+    Dwarf_Allocator alloc;
 
     if (IS_INVALID_DBG(dbg)) {
         _dwarf_free_static_errlist();
@@ -1093,40 +1201,41 @@ _dwarf_free_all_of_one_debug(Dwarf_Debug dbg)
     freecontextlist(dbg,&dbg->de_info_reading);
     freecontextlist(dbg,&dbg->de_types_reading);
     /* Housecleaning done. Now really free all the space. */
-    malloc_section_free(&dbg->de_debug_info);
-    malloc_section_free(&dbg->de_debug_types);
-    malloc_section_free(&dbg->de_debug_abbrev);
-    malloc_section_free(&dbg->de_debug_line);
-    malloc_section_free(&dbg->de_debug_line_str);
-    malloc_section_free(&dbg->de_debug_loc);
-    malloc_section_free(&dbg->de_debug_aranges);
-    malloc_section_free(&dbg->de_debug_macinfo);
-    malloc_section_free(&dbg->de_debug_macro);
-    malloc_section_free(&dbg->de_debug_names);
-    malloc_section_free(&dbg->de_debug_pubnames);
-    malloc_section_free(&dbg->de_debug_str);
-    malloc_section_free(&dbg->de_debug_sup);
-    malloc_section_free(&dbg->de_debug_frame);
-    malloc_section_free(&dbg->de_debug_frame_eh_gnu);
-    malloc_section_free(&dbg->de_debug_pubtypes);
-    malloc_section_free(&dbg->de_debug_funcnames);
-    malloc_section_free(&dbg->de_debug_typenames);
-    malloc_section_free(&dbg->de_debug_varnames);
-    malloc_section_free(&dbg->de_debug_weaknames);
-    malloc_section_free(&dbg->de_debug_ranges);
-    malloc_section_free(&dbg->de_debug_str_offsets);
-    malloc_section_free(&dbg->de_debug_addr);
-    malloc_section_free(&dbg->de_debug_gdbindex);
-    malloc_section_free(&dbg->de_debug_cu_index);
-    malloc_section_free(&dbg->de_debug_tu_index);
-    malloc_section_free(&dbg->de_debug_loclists);
-    malloc_section_free(&dbg->de_debug_rnglists);
-    malloc_section_free(&dbg->de_gnu_debuglink);
-    malloc_section_free(&dbg->de_note_gnu_buildid);
+    malloc_section_free(dbg,&dbg->de_debug_info);
+    malloc_section_free(dbg,&dbg->de_debug_types);
+    malloc_section_free(dbg,&dbg->de_debug_abbrev);
+    malloc_section_free(dbg,&dbg->de_debug_line);
+    malloc_section_free(dbg,&dbg->de_debug_line_str);
+    malloc_section_free(dbg,&dbg->de_debug_loc);
+    malloc_section_free(dbg,&dbg->de_debug_aranges);
+    malloc_section_free(dbg,&dbg->de_debug_macinfo);
+    malloc_section_free(dbg,&dbg->de_debug_macro);
+    malloc_section_free(dbg,&dbg->de_debug_names);
+    malloc_section_free(dbg,&dbg->de_debug_pubnames);
+    malloc_section_free(dbg,&dbg->de_debug_str);
+    malloc_section_free(dbg,&dbg->de_debug_sup);
+    malloc_section_free(dbg,&dbg->de_debug_frame);
+    malloc_section_free(dbg,&dbg->de_debug_frame_eh_gnu);
+    malloc_section_free(dbg,&dbg->de_debug_pubtypes);
+    malloc_section_free(dbg,&dbg->de_debug_funcnames);
+    malloc_section_free(dbg,&dbg->de_debug_typenames);
+    malloc_section_free(dbg,&dbg->de_debug_varnames);
+    malloc_section_free(dbg,&dbg->de_debug_weaknames);
+    malloc_section_free(dbg,&dbg->de_debug_ranges);
+    malloc_section_free(dbg,&dbg->de_debug_str_offsets);
+    malloc_section_free(dbg,&dbg->de_debug_addr);
+    malloc_section_free(dbg,&dbg->de_debug_gdbindex);
+    malloc_section_free(dbg,&dbg->de_debug_cu_index);
+    malloc_section_free(dbg,&dbg->de_debug_tu_index);
+    malloc_section_free(dbg,&dbg->de_debug_loclists);
+    malloc_section_free(dbg,&dbg->de_debug_rnglists);
+    malloc_section_free(dbg,&dbg->de_gnu_debuglink);
+    malloc_section_free(dbg,&dbg->de_note_gnu_buildid);
     _dwarf_harmless_cleanout(&dbg->de_harmless_errors);
 
     _dwarf_dealloc_rnglists_context(dbg);
     _dwarf_dealloc_loclists_context(dbg);
+    _dwarf_free_pc_cu_table(dbg);
     if (dbg->de_printf_callback.dp_buffer &&
         !dbg->de_printf_callback.dp_buffer_user_provided ) {
         free(dbg->de_printf_callback.dp_buffer);
@@ -1159,8 +1268,9 @@ _dwarf_free_all_of_one_debug(Dwarf_Debug dbg)
     free((void*)dbg->de_gnu_global_paths);
     dbg->de_gnu_global_paths = 0;
     dbg->de_gnu_global_path_count = 0;
+    alloc = dbg->de_allocator;
     memset(dbg, 0, sizeof(*dbg)); /* Prevent accidental use later. */
-    free(dbg);
+    _dwarf_allocator_free(&alloc,dbg);
     return DW_DLV_OK;
 }
 /*  A special case: we have no dbg, no alloc header etc.
@@ -32,6 +32,8 @@
 
 #include <stddef.h> /* NULL size_t */
 #include <stdio.h> /* debug printf */
+#include <stdlib.h> /* qsort() */
+#include <string.h> /* memcpy() memset() */
 
 #if defined(_WIN32) && defined(HAVE_STDAFX_H)
 #include "stdafx.h"
@@ -732,3 +734,610 @@ dwarf_get_arange_info_b(Dwarf_Arange arange,
     }
     return DW_DLV_OK;
 }
+
+/*  The address to CU table used by dwarf_find_cu_by_pc().
+    Entries are sorted by pt_low and do not overlap,
+    pt_high is one past the last address. */
+struct Dwarf_Pc_Cu_Entry_s {
+    Dwarf_Addr pt_low;
+    Dwarf_Addr pt_high;
+    Dwarf_Off  pt_cu_die_offset;
+};
+struct Dwarf_Pc_Cu_Table_s {
+    struct Dwarf_Pc_Cu_Entry_s *pt_entries;
+    Dwarf_Unsigned              pt_count;
+    Dwarf_Unsigned              pt_alloc;
+};
+
+/*  The table and the temporary CU offset list come
+    from the allocator of the Dwarf_Debug
+    (see dwarf_init_path_alloc()). */
+static void
+pc_cu_free_table(Dwarf_Debug dbg,struct Dwarf_Pc_Cu_Table_s *t)
+{
+    Dwarf_Allocator *a = &dbg->de_allocator;
+
+    if (t->pt_entries) {
+        _dwarf_allocator_free(a,t->pt_entries);
+    }
+    _dwarf_allocator_free(a,t);
+}
+
+void
+_dwarf_free_pc_cu_table(Dwarf_Debug dbg)
+{
+    struct Dwarf_Pc_Cu_Table_s *t = dbg->de_pc_cu_table;
+
+    if (!t) {
+        return;
+    }
+    pc_cu_free_table(dbg,t);
+    dbg->de_pc_cu_table = 0;
+}
+
+static int
+pc_cu_add(Dwarf_Debug dbg,struct Dwarf_Pc_Cu_Table_s *t,
+    Dwarf_Addr low, Dwarf_Addr high, Dwarf_Off cu_die_offset,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Pc_Cu_Entry_s *e = 0;
+
+    if (low >= high) {
+        /* Empty, nothing to find. */
+        return DW_DLV_OK;
+    }
+    if (t->pt_count >= t->pt_alloc) {
+        Dwarf_Unsigned newalloc = t->pt_alloc? t->pt_alloc*2: 64;
+        struct Dwarf_Pc_Cu_Entry_s *newe = 0;
+
+        /*  The allocator has no realloc, so copy. */
+        newe = (struct Dwarf_Pc_Cu_Entry_s *)_dwarf_allocator_malloc(
+            &dbg->de_allocator,
+            newalloc*sizeof(struct Dwarf_Pc_Cu_Entry_s));
+        if (!newe) {
+            _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+                "DW_DLE_ALLOC_FAIL: growing the pc to CU table");
+            return DW_DLV_ERROR;
+        }
+        if (t->pt_entries) {
+            memcpy(newe,t->pt_entries,(size_t)(t->pt_count*
+                sizeof(struct Dwarf_Pc_Cu_Entry_s)));
+            _dwarf_allocator_free(&dbg->de_allocator,t->pt_entries);
+        }
+        t->pt_entries = newe;
+        t->pt_alloc = newalloc;
+    }
+    e = t->pt_entries + t->pt_count;
+    e->pt_low = low;
+    e->pt_high = high;
+    e->pt_cu_die_offset = cu_die_offset;
+    t->pt_count++;
+    return DW_DLV_OK;
+}
+
+static int
+pc_cu_compare(const void *l, const void *r)
+{
+    const struct Dwarf_Pc_Cu_Entry_s *le =
+        (const struct Dwarf_Pc_Cu_Entry_s *)l;
+    const struct Dwarf_Pc_Cu_Entry_s *re =
+        (const struct Dwarf_Pc_Cu_Entry_s *)r;
+
+    if (le->pt_low < re->pt_low) {
+        return -1;
+    }
+    if (le->pt_low > re->pt_low) {
+        return 1;
+    }
+    /*  Equal lows: the CU earlier in .debug_info first
+        so the result does not depend on qsort. */
+    if (le->pt_cu_die_offset < re->pt_cu_die_offset) {
+        return -1;
+    }
+    if (le->pt_cu_die_offset > re->pt_cu_die_offset) {
+        return 1;
+    }
+    return 0;
+}
+
+static int
+offset_compare(const void *l, const void *r)
+{
+    Dwarf_Off lo = *(const Dwarf_Off *)l;
+    Dwarf_Off ro = *(const Dwarf_Off *)r;
+
+    if (lo < ro) {
+        return -1;
+    }
+    if (lo > ro) {
+        return 1;
+    }
+    return 0;
+}
+
+/*  Adds every .debug_aranges entry to the table and
+    returns a sorted array of the CU header offsets
+    that have aranges (which the caller must free
+    with _dwarf_allocator_free()).  */
+static int
+pc_cu_add_aranges(Dwarf_Debug dbg,struct Dwarf_Pc_Cu_Table_s *t,
+    Dwarf_Off **cu_offsets_out,Dwarf_Unsigned *cu_offsets_count,
+    Dwarf_Error *error)
+{
+    Dwarf_Chain head_chain = 0;
+    Dwarf_Chain curr = 0;
+    Dwarf_Signed arange_count = 0;
+    Dwarf_Off *cu_offsets = 0;
+    Dwarf_Unsigned cu_count = 0;
+    Dwarf_Off last_info_offset = 0;
+    Dwarf_Off cu_die_offset = 0;
+    int res = 0;
+
+    res = _dwarf_load_section(dbg, &dbg->de_debug_aranges, error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = _dwarf_get_aranges_list(dbg,&head_chain,
+        &arange_count,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (!arange_count) {
+        free_aranges_chain(dbg,head_chain);
+        return DW_DLV_NO_ENTRY;
+    }
+    cu_offsets = (Dwarf_Off *)_dwarf_allocator_malloc(
+        &dbg->de_allocator,
+        (Dwarf_Unsigned)arange_count*sizeof(Dwarf_Off));
+    if (!cu_offsets) {
+        free_aranges_chain(dbg,head_chain);
+        _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: allocating the aranges CU list");
+        return DW_DLV_ERROR;
+    }
+    for (curr = head_chain; curr; curr = curr->ch_next) {
+        Dwarf_Arange ar = (Dwarf_Arange)curr->ch_item;
+
+        if (!ar) {
+            continue;
+        }
+        /*  Each set of aranges is for one CU, so
+            the header length is rarely recomputed. */
+        if (!cu_count || ar->ar_info_offset != last_info_offset) {
+            Dwarf_Unsigned headerlen = 0;
+
+            res = _dwarf_length_of_cu_header(dbg,
+                ar->ar_info_offset,TRUE,&headerlen,error);
+            if (res != DW_DLV_OK) {
+                _dwarf_allocator_free(&dbg->de_allocator,cu_offsets);
+                free_aranges_chain(dbg,head_chain);
+                return res;
+            }
+            last_info_offset = ar->ar_info_offset;
+            cu_die_offset = last_info_offset + headerlen;
+            cu_offsets[cu_count++] = last_info_offset;
+        }
+        res = pc_cu_add(dbg,t,ar->ar_address,
+            ar->ar_address + ar->ar_length,cu_die_offset,error);
+        if (res != DW_DLV_OK) {
+            _dwarf_allocator_free(&dbg->de_allocator,cu_offsets);
+            free_aranges_chain(dbg,head_chain);
+            return res;
+        }
+    }
+    free_aranges_chain(dbg,head_chain);
+    qsort(cu_offsets,(size_t)cu_count,sizeof(Dwarf_Off),
+        offset_compare);
+    *cu_offsets_out = cu_offsets;
+    *cu_offsets_count = cu_count;
+    return DW_DLV_OK;
+}
+
+/*  DWARF5 DW_AT_ranges, .debug_rnglists */
+static int
+pc_cu_add_rnglists(Dwarf_Debug dbg,struct Dwarf_Pc_Cu_Table_s *t,
+    Dwarf_Attribute attr, Dwarf_Half form, Dwarf_Off cu_die_offset,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned attrval = 0;
+    Dwarf_Rnglists_Head head = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned rle_offset = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    if (form == DW_FORM_rnglistx) {
+        res = dwarf_formudata(attr,&attrval,error);
+    } else {
+        Dwarf_Off off = 0;
+
+        res = dwarf_global_formref(attr,&off,error);
+        attrval = off;
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dwarf_rnglists_get_rle_head(attr,form,attrval,
+        &head,&count,&rle_offset,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    for (i = 0; i < count; ++i) {
+        unsigned code = 0;
+        Dwarf_Bool no_addr = FALSE;
+        Dwarf_Unsigned low = 0;
+        Dwarf_Unsigned high = 0;
+
+        res = dwarf_get_rnglists_entry_fields_a(head,i,0,&code,
+            0,0,&no_addr,&low,&high,error);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_rnglists_head(head);
+            return res;
+        }
+        if (res == DW_DLV_NO_ENTRY || no_addr) {
+            continue;
+        }
+        switch (code) {
+        case DW_RLE_offset_pair:
+        case DW_RLE_startx_endx:
+        case DW_RLE_startx_length:
+        case DW_RLE_start_end:
+        case DW_RLE_start_length:
+            res = pc_cu_add(dbg,t,low,high,cu_die_offset,error);
+            if (res != DW_DLV_OK) {
+                dwarf_dealloc_rnglists_head(head);
+                return res;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    dwarf_dealloc_rnglists_head(head);
+    return DW_DLV_OK;
+}
+
+/*  DWARF2-4 DW_AT_ranges, .debug_ranges */
+static int
+pc_cu_add_ranges(Dwarf_Debug dbg,struct Dwarf_Pc_Cu_Table_s *t,
+    Dwarf_Die cu_die, Dwarf_Attribute attr,
+    Dwarf_Off cu_die_offset, Dwarf_Error *error)
+{
+    Dwarf_Off off = 0;
+    Dwarf_Off realoff = 0;
+    Dwarf_Ranges *ranges = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Unsigned bytes = 0;
+    Dwarf_Addr base = 0;
+    Dwarf_CU_Context context = cu_die->di_cu_context;
+    Dwarf_Signed i = 0;
+    int res = 0;
+
+    res = dwarf_global_formref(attr,&off,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dwarf_get_ranges_b(dbg,off,cu_die,&realoff,
+        &ranges,&count,&bytes,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (context->cc_low_pc_present) {
+        base = context->cc_low_pc;
+    }
+    for (i = 0; i < count; ++i) {
+        Dwarf_Ranges *r = ranges + i;
+
+        if (r->dwr_type == DW_RANGES_ADDRESS_SELECTION) {
+            base = r->dwr_addr2;
+        } else if (r->dwr_type == DW_RANGES_ENTRY) {
+            res = pc_cu_add(dbg,t,base + r->dwr_addr1,
+                base + r->dwr_addr2,cu_die_offset,error);
+            if (res != DW_DLV_OK) {
+                dwarf_dealloc_ranges(dbg,ranges,count);
+                return res;
+            }
+        }
+    }
+    dwarf_dealloc_ranges(dbg,ranges,count);
+    return DW_DLV_OK;
+}
+
+static int
+pc_cu_add_cu_die(Dwarf_Debug dbg,struct Dwarf_Pc_Cu_Table_s *t,
+    Dwarf_Die cu_die, Dwarf_Off cu_die_offset,
+    Dwarf_Error *error)
+{
+    Dwarf_Attribute attr = 0;
+    Dwarf_Addr low = 0;
+    Dwarf_Addr high = 0;
+    Dwarf_Half form = 0;
+    enum Dwarf_Form_Class formclass = DW_FORM_CLASS_UNKNOWN;
+    int res = 0;
+
+    res = dwarf_attr(cu_die,DW_AT_ranges,&attr,error);
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_whatform(attr,&form,error);
+        if (res == DW_DLV_OK) {
+            if (cu_die->di_cu_context->cc_version_stamp >=
+                DW_CU_VERSION5) {
+                res = pc_cu_add_rnglists(dbg,t,attr,form,
+                    cu_die_offset,error);
+            } else {
+                res = pc_cu_add_ranges(dbg,t,cu_die,attr,
+                    cu_die_offset,error);
+            }
+        }
+        dwarf_dealloc_attribute(attr);
+        return res;
+    }
+    res = dwarf_lowpc(cu_die,&low,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dwarf_highpc_b(cu_die,&high,&form,&formclass,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (formclass == DW_FORM_CLASS_CONSTANT) {
+        high += low;
+    }
+    return pc_cu_add(dbg,t,low,high,cu_die_offset,error);
+}
+
+/*  For each CU in .debug_info without aranges
+    add the ranges of its CU DIE. */
+static int
+pc_cu_add_cu_ranges(Dwarf_Debug dbg,struct Dwarf_Pc_Cu_Table_s *t,
+    Dwarf_Off *cu_offsets,Dwarf_Unsigned cu_count,
+    Dwarf_Error *error)
+{
+    Dwarf_Off offset = 0;
+    Dwarf_Unsigned section_size = 0;
+    int res = 0;
+
+    res = _dwarf_load_debug_info(dbg, error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    section_size = dbg->de_debug_info.dss_size;
+    while (offset < section_size) {
+        Dwarf_Unsigned headerlen = 0;
+        Dwarf_Die cu_die = 0;
+        Dwarf_Off next_offset = 0;
+
+        res = _dwarf_length_of_cu_header(dbg,offset,TRUE,
+            &headerlen,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        res = dwarf_offdie_b(dbg,offset + headerlen,TRUE,
+            &cu_die,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        next_offset = _dwarf_calculate_next_cu_context_offset(
+            cu_die->di_cu_context);
+        if (!cu_count || !bsearch(&offset,cu_offsets,
+            (size_t)cu_count,sizeof(Dwarf_Off),offset_compare)) {
+            res = pc_cu_add_cu_die(dbg,t,cu_die,
+                offset + headerlen,error);
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc_die(cu_die);
+                return res;
+            }
+        }
+        dwarf_dealloc_die(cu_die);
+        if (next_offset <= offset) {
+            break;
+        }
+        offset = next_offset;
+    }
+    return DW_DLV_OK;
+}
+
+/*  Sort, then merge entries of the same CU that
+    overlap or touch and trim overlaps between
+    different CUs (invalid DWARF) so the entries
+    are disjoint: the range that starts first wins. */
+static void
+pc_cu_sort_and_coalesce(struct Dwarf_Pc_Cu_Table_s *t)
+{
+    struct Dwarf_Pc_Cu_Entry_s *e = t->pt_entries;
+    Dwarf_Unsigned out = 0;
+    Dwarf_Unsigned i = 0;
+
+    if (!t->pt_count) {
+        return;
+    }
+    qsort(e,(size_t)t->pt_count,sizeof(*e),pc_cu_compare);
+    for (i = 1; i < t->pt_count; ++i) {
+        struct Dwarf_Pc_Cu_Entry_s *last = e + out;
+        struct Dwarf_Pc_Cu_Entry_s cur = e[i];
+
+        if (cur.pt_low <= last->pt_high &&
+            cur.pt_cu_die_offset == last->pt_cu_die_offset) {
+            if (cur.pt_high > last->pt_high) {
+                last->pt_high = cur.pt_high;
+            }
+            continue;
+        }
+        if (cur.pt_low < last->pt_high) {
+            if (cur.pt_high <= last->pt_high) {
+                continue;
+            }
+            cur.pt_low = last->pt_high;
+        }
+        e[++out] = cur;
+    }
+    t->pt_count = out + 1;
+}
+
+static int
+get_pc_cu_table(Dwarf_Debug dbg,
+    struct Dwarf_Pc_Cu_Table_s **table_out,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Pc_Cu_Table_s *t = 0;
+    Dwarf_Off *cu_offsets = 0;
+    Dwarf_Unsigned cu_count = 0;
+    int res = 0;
+
+    if (dbg->de_pc_cu_table) {
+        *table_out = dbg->de_pc_cu_table;
+        return DW_DLV_OK;
+    }
+    /*  aranges point in to info, so load it now. */
+    res = _dwarf_load_debug_info(dbg, error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    t = (struct Dwarf_Pc_Cu_Table_s *)_dwarf_allocator_malloc(
+        &dbg->de_allocator,sizeof(*t));
+    if (!t) {
+        _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: allocating the pc to CU table");
+        return DW_DLV_ERROR;
+    }
+    memset(t,0,sizeof(*t));
+    res = pc_cu_add_aranges(dbg,t,&cu_offsets,&cu_count,error);
+    if (res == DW_DLV_OK || res == DW_DLV_NO_ENTRY) {
+        res = pc_cu_add_cu_ranges(dbg,t,cu_offsets,cu_count,error);
+    }
+    if (cu_offsets) {
+        _dwarf_allocator_free(&dbg->de_allocator,cu_offsets);
+    }
+    if (res != DW_DLV_OK) {
+        pc_cu_free_table(dbg,t);
+        return res;
+    }
+    pc_cu_sort_and_coalesce(t);
+    dbg->de_pc_cu_table = t;
+    *table_out = t;
+    return DW_DLV_OK;
+}
+
+/*  Index of the entry containing pc, searching
+    entries [lo,hi).  Returns FALSE if none does. */
+static Dwarf_Bool
+pc_cu_search(struct Dwarf_Pc_Cu_Table_s *t,Dwarf_Addr pc,
+    Dwarf_Unsigned lo, Dwarf_Unsigned hi,
+    Dwarf_Unsigned *index_out)
+{
+    struct Dwarf_Pc_Cu_Entry_s *e = t->pt_entries;
+    Dwarf_Unsigned start = lo;
+
+    /* Find the first entry with pt_low > pc */
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (e[mid].pt_low <= pc) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    *index_out = lo;
+    if (lo > start && pc < e[lo-1].pt_high) {
+        *index_out = lo - 1;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+int
+dwarf_find_cu_by_pc(Dwarf_Debug dbg,
+    Dwarf_Addr   pc,
+    Dwarf_Off   *cu_die_offset,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Pc_Cu_Table_s *t = 0;
+    Dwarf_Unsigned index = 0;
+    int res = 0;
+
+    CHECK_DBG(dbg,error,"dwarf_find_cu_by_pc()");
+    res = get_pc_cu_table(dbg,&t,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (!pc_cu_search(t,pc,0,t->pt_count,&index)) {
+        return DW_DLV_NO_ENTRY;
+    }
+    *cu_die_offset = t->pt_entries[index].pt_cu_die_offset;
+    return DW_DLV_OK;
+}
+
+/*  Ascending pcs mostly land in the entry already
+    found or one of the next few, so look there
+    before a binary search of the rest. */
+#define PC_CU_LINEAR_STEPS 4
+
+int
+dwarf_find_cus_by_pcs(Dwarf_Debug dbg,
+    Dwarf_Unsigned    pc_count,
+    const Dwarf_Addr *pcs,
+    Dwarf_Off        *cu_die_offsets,
+    Dwarf_Unsigned   *found_count,
+    Dwarf_Error      *error)
+{
+    struct Dwarf_Pc_Cu_Table_s *t = 0;
+    struct Dwarf_Pc_Cu_Entry_s *e = 0;
+    Dwarf_Unsigned pos = 0;
+    Dwarf_Unsigned found = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Addr prevpc = 0;
+    int res = 0;
+
+    CHECK_DBG(dbg,error,"dwarf_find_cus_by_pcs()");
+    if (pc_count && (!pcs || !cu_die_offsets)) {
+        _dwarf_error_string(dbg, error, DW_DLE_ARANGES_NULL,
+            "DW_DLE_ARANGES_NULL: dwarf_find_cus_by_pcs() "
+            "passed a NULL array");
+        return DW_DLV_ERROR;
+    }
+    res = get_pc_cu_table(dbg,&t,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    e = t->pt_entries;
+    for (i = 0; i < pc_count; ++i) {
+        Dwarf_Addr pc = pcs[i];
+        Dwarf_Unsigned steps = 0;
+        Dwarf_Bool hit = FALSE;
+
+        if (i && pc < prevpc) {
+            /* Not sorted here, restart from the front. */
+            pos = 0;
+        }
+        prevpc = pc;
+        for ( ; pos < t->pt_count && steps < PC_CU_LINEAR_STEPS;
+            ++pos, ++steps) {
+            if (pc < e[pos].pt_low) {
+                break;
+            }
+            if (pc < e[pos].pt_high) {
+                hit = TRUE;
+                break;
+            }
+        }
+        if (!hit && steps == PC_CU_LINEAR_STEPS) {
+            hit = pc_cu_search(t,pc,pos,t->pt_count,&pos);
+        }
+        if (hit) {
+            cu_die_offsets[i] = e[pos].pt_cu_die_offset;
+            ++found;
+        } else {
+            cu_die_offsets[i] = 0;
+        }
+    }
+    if (found_count) {
+        *found_count = found;
+    }
+    if (!found) {
+        return DW_DLV_NO_ENTRY;
+    }
+    return DW_DLV_OK;
+}
@@ -52,6 +52,8 @@ struct Dwarf_Arange_s {
     Dwarf_Half ar_segment_selector_size;
 };
 
+void _dwarf_free_pc_cu_table(Dwarf_Debug dbg);
+
 int
 _dwarf_get_aranges_addr_offsets(Dwarf_Debug dbg,
     Dwarf_Addr ** addrs,
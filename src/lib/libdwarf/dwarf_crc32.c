@@ -73,6 +73,7 @@ dwarf_crc32 (Dwarf_Debug dbg,unsigned char *crcbuf,
         an unsigned value. */
     Dwarf_Unsigned  readlenu = 10000;
     Dwarf_Unsigned  size_left = 0;
+    Dwarf_Unsigned  readloc = 0;
     const unsigned char *readbuf = 0;
     unsigned int   tcrc = 0;
     unsigned int   init = 0;
@@ -110,13 +111,6 @@ dwarf_crc32 (Dwarf_Debug dbg,unsigned char *crcbuf,
         return DW_DLV_NO_ENTRY;
     }
     size_left = fsize;
-    res = _dwarf_seekr(fd,0,SEEK_SET,0);
-    if (res != DW_DLV_OK) {
-        _dwarf_error_string(dbg,error,DW_DLE_SEEK_ERROR,
-            "DW_DLE_SEEK_ERROR: dwarf_crc32 seek "
-            "to start fails");
-        return DW_DLV_ERROR;
-    }
     readbuf = (unsigned char *)malloc(readlenu);
     if (!readbuf) {
         _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
@@ -128,7 +122,8 @@ dwarf_crc32 (Dwarf_Debug dbg,unsigned char *crcbuf,
         if (size_left < readlenu) {
             readlenu = size_left;
         }
-        res = _dwarf_readr(fd,(char *)readbuf,readlenu,0);
+        res = _dwarf_preadr(fd,(char *)readbuf,readloc,
+            readlenu,0);
         if (res != DW_DLV_OK) {
             _dwarf_error_string(dbg,error,DW_DLE_READ_ERROR,
                 "DW_DLE_READ_ERROR: dwarf_crc32 read fails ");
@@ -141,6 +136,7 @@ dwarf_crc32 (Dwarf_Debug dbg,unsigned char *crcbuf,
             (unsigned long)init);
         init = tcrc;
         size_left -= readlenu;
+        readloc += readlenu;
     }
     /*  endianness issues?  */
     free((unsigned char*)readbuf);
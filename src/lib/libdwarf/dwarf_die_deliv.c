@@ -127,6 +127,7 @@ _dwarf_find_CU_Context(Dwarf_Debug dbg,
     Dwarf_Debug_InfoTypes dis = is_info? &dbg->de_info_reading:
         &dbg->de_types_reading;
 
+    DW_PERF_ADD(dbg,ps_cu_context_lookups,1);
     if (offset >= dis->de_last_offset){
         return NULL;
     }
@@ -140,6 +141,7 @@ _dwarf_find_CU_Context(Dwarf_Debug dbg,
         for (cu_context = dis->de_cu_context;
             cu_context != NULL;
             cu_context = cu_context->cc_next) {
+            DW_PERF_ADD(dbg,ps_cu_context_list_steps,1);
             if (offset >= cu_context->cc_debug_offset &&
                 offset < cu_context->cc_debug_offset +
                 cu_context->cc_length + cu_context->cc_length_size
@@ -151,6 +153,7 @@ _dwarf_find_CU_Context(Dwarf_Debug dbg,
     for (cu_context = dis->de_cu_context_list;
         cu_context != NULL;
         cu_context = cu_context->cc_next) {
+        DW_PERF_ADD(dbg,ps_cu_context_list_steps,1);
         if (offset >= cu_context->cc_debug_offset &&
             offset < cu_context->cc_debug_offset +
             cu_context->cc_length + cu_context->cc_length_size
@@ -663,6 +666,7 @@ local_dealloc_cu_context(Dwarf_Debug dbg,
         free(hash_table);
         context->cc_abbrev_hash_table = 0;
     }
+    _dwarf_free_die_table(context);
     dwarf_dealloc(dbg, context, DW_DLA_CU_CONTEXT);
 }
 
@@ -2245,8 +2249,11 @@ dwarf_validate_die_sibling(Dwarf_Die sibling,Dwarf_Off *offset)
     has a DW_AT_sibling attribute *has_die_child is set
     false to indicate that the children are being skipped.
 
-    die_info_end  points to the last byte+1 of the cu.  */
-static int
+    die_info_end  points to the last byte+1 of the cu.
+
+    If abbrev_list_out is non-null the abbreviation
+    of the DIE is returned through it. */
+int
 _dwarf_next_die_info_ptr(Dwarf_Byte_Ptr die_info_ptr,
     Dwarf_CU_Context cu_context,
     Dwarf_Byte_Ptr die_info_end,
@@ -2254,6 +2261,7 @@ _dwarf_next_die_info_ptr(Dwarf_Byte_Ptr die_info_ptr,
     Dwarf_Bool want_AT_sibling,
     Dwarf_Bool * has_die_child,
     Dwarf_Byte_Ptr *next_die_ptr_out,
+    Dwarf_Abbrev_List *abbrev_list_out,
     Dwarf_Error *error)
 {
     Dwarf_Byte_Ptr info_ptr = 0;
@@ -2303,6 +2311,9 @@ _dwarf_next_die_info_ptr(Dwarf_Byte_Ptr die_info_ptr,
     }
 
     *has_die_child = abbrev_list->abl_has_child;
+    if (abbrev_list_out) {
+        *abbrev_list_out = abbrev_list;
+    }
     abbrev_ptr = abbrev_list->abl_abbrev_ptr;
     abbrev_end = _dwarf_calculate_abbrev_section_end_ptr(cu_context);
 
@@ -2714,7 +2725,7 @@ _dwarf_siblingof_internal(Dwarf_Debug dbg,
             res2 = _dwarf_next_die_info_ptr(die_info_ptr,
                 context, die_info_end,
                 cu_info_start, true, &has_child,
-                &die_info_ptr2,
+                &die_info_ptr2,0,
                 error);
             if (res2 != DW_DLV_OK) {
                 return res2;
@@ -2938,6 +2949,7 @@ _dwarf_siblingof_internal(Dwarf_Debug dbg,
         _dwarf_error(dbg, error, DW_DLE_FIRST_DIE_NOT_CU);
         return DW_DLV_ERROR;
     }
+    _dwarf_die_table_note_related(die,ret_die,FALSE);
     *caller_ret_die = ret_die;
     return DW_DLV_OK;
 }
@@ -2986,7 +2998,7 @@ dwarf_child(Dwarf_Die die,
         die_info_end,
         NULL, false,
         &has_die_child,
-        &die_info_ptr2,
+        &die_info_ptr2,0,
         error);
     if (res != DW_DLV_OK) {
         return res;
@@ -3091,81 +3103,33 @@ dwarf_child(Dwarf_Die die,
             return bres;
         }
     }
+    _dwarf_die_table_note_related(die,ret_die,TRUE);
     *caller_ret_die = ret_die;
     return DW_DLV_OK;
 }
 
-/*  Given a (global, not cu_relative) die offset, this returns
-    a pointer to a DIE thru *new_die.
-    It is up to the caller to do a
-    dwarf_dealloc(dbg,*new_die,DW_DLE_DIE);
-    The old form only works with debug_info.
-    The new _b form works with debug_info or debug_types.
-
-    */
+/*  Create the Dwarf_Die at section-global offset
+    in the given (already known) CU context.
+    Used by dwarf_offdie_b() and the DIE table
+    navigation functions.
+    Returns DW_DLV_NO_ENTRY if the offset is
+    that of a null DIE. */
 int
-dwarf_offdie_b(Dwarf_Debug dbg,
-    Dwarf_Off offset, Dwarf_Bool is_info,
-    Dwarf_Die * new_die, Dwarf_Error * error)
+_dwarf_make_die_at(Dwarf_CU_Context cu_context,
+    Dwarf_Bool is_info,
+    Dwarf_Off offset,
+    Dwarf_Die * new_die,
+    Dwarf_Error * error)
 {
-    Dwarf_CU_Context cu_context = 0;
-    Dwarf_Small     *dataptr = 0;
-    Dwarf_Off        new_cu_offset = 0;
+    Dwarf_Debug      dbg = cu_context->cc_dbg;
     Dwarf_Die        die = 0;
     Dwarf_Byte_Ptr   info_ptr = 0;
     Dwarf_Unsigned   abbrev_code = 0;
     Dwarf_Unsigned   utmp = 0;
     int              lres = 0;
-    Dwarf_Debug_InfoTypes dis = 0;
     Dwarf_Byte_Ptr   die_info_end = 0;
     Dwarf_Unsigned   highest_code = 0;
-    struct Dwarf_Section_s * secdp = 0;
-
-    CHECK_DBG(dbg,error,"dwarf_offdie_b()");
-    if (is_info) {
-        dis =&dbg->de_info_reading;
-        secdp = &dbg->de_debug_info;
-        dataptr = dbg->de_debug_info.dss_data;
-    } else {
-        dis =&dbg->de_types_reading;
-        secdp = &dbg->de_debug_types;
-        dataptr = dbg->de_debug_types.dss_data;
-    }
 
-    if (!dataptr) {
-        lres = _dwarf_load_die_containing_section(dbg,
-            is_info, error);
-        if (lres != DW_DLV_OK) {
-            return lres;
-        }
-    }
-    cu_context = _dwarf_find_CU_Context(dbg, offset,is_info);
-    if (cu_context == NULL) {
-        Dwarf_Unsigned section_size = 0;
-
-        if (dis->de_cu_context_list_end != NULL) {
-            new_cu_offset = _dwarf_calculate_next_cu_context_offset(
-                dis->de_cu_context_list_end);
-        }/* Else new_cu_offset remains 0, no CUs on list,
-            a fresh section setup. */
-        section_size = secdp->dss_size;
-        do {
-            /*  We do not want this to return cu_die as
-                we only want the last one to create DIE,
-                and that will be done just below. */
-            lres = _dwarf_create_a_new_cu_context_record_on_list(
-                dbg, dis,is_info,section_size,new_cu_offset,
-                &cu_context,NULL,error);
-            if (lres != DW_DLV_OK) {
-                return lres;
-            }
-            new_cu_offset =  _dwarf_calculate_next_cu_context_offset(
-                cu_context);
-            /*  Not setting dis->de_cu_context, leave
-                that unchanged. */
-        } while (offset >= new_cu_offset);
-    }
-    /*  We have a cu_context for this offset. */
     die_info_end = _dwarf_calculate_info_section_end_ptr(cu_context);
     die = (Dwarf_Die) _dwarf_get_alloc(dbg, DW_DLA_DIE, 1);
     if (!die) {
@@ -3174,8 +3138,8 @@ dwarf_offdie_b(Dwarf_Debug dbg,
     }
     die->di_cu_context = cu_context;
     die->di_is_info = is_info;
-    /*  dataptr above might be stale if we loaded a section
-        above.  So access dss_data here. */
+    /*  The section may have been loaded just now
+        by our caller, so access dss_data here. */
     if (is_info) {
         info_ptr = offset + dbg->de_debug_info.dss_data;
     } else {
@@ -3248,6 +3212,75 @@ dwarf_offdie_b(Dwarf_Debug dbg,
     return DW_DLV_OK;
 }
 
+/*  Given a (global, not cu_relative) die offset, this returns
+    a pointer to a DIE thru *new_die.
+    It is up to the caller to do a
+    dwarf_dealloc(dbg,*new_die,DW_DLE_DIE);
+    The old form only works with debug_info.
+    The new _b form works with debug_info or debug_types.
+
+    */
+int
+dwarf_offdie_b(Dwarf_Debug dbg,
+    Dwarf_Off offset, Dwarf_Bool is_info,
+    Dwarf_Die * new_die, Dwarf_Error * error)
+{
+    Dwarf_CU_Context cu_context = 0;
+    Dwarf_Small     *dataptr = 0;
+    Dwarf_Off        new_cu_offset = 0;
+    int              lres = 0;
+    Dwarf_Debug_InfoTypes dis = 0;
+    struct Dwarf_Section_s * secdp = 0;
+
+    CHECK_DBG(dbg,error,"dwarf_offdie_b()");
+    if (is_info) {
+        dis =&dbg->de_info_reading;
+        secdp = &dbg->de_debug_info;
+        dataptr = dbg->de_debug_info.dss_data;
+    } else {
+        dis =&dbg->de_types_reading;
+        secdp = &dbg->de_debug_types;
+        dataptr = dbg->de_debug_types.dss_data;
+    }
+
+    if (!dataptr) {
+        lres = _dwarf_load_die_containing_section(dbg,
+            is_info, error);
+        if (lres != DW_DLV_OK) {
+            return lres;
+        }
+    }
+    cu_context = _dwarf_find_CU_Context(dbg, offset,is_info);
+    if (cu_context == NULL) {
+        Dwarf_Unsigned section_size = 0;
+
+        if (dis->de_cu_context_list_end != NULL) {
+            new_cu_offset = _dwarf_calculate_next_cu_context_offset(
+                dis->de_cu_context_list_end);
+        }/* Else new_cu_offset remains 0, no CUs on list,
+            a fresh section setup. */
+        section_size = secdp->dss_size;
+        do {
+            /*  We do not want this to return cu_die as
+                we only want the last one to create DIE,
+                and that will be done just below. */
+            lres = _dwarf_create_a_new_cu_context_record_on_list(
+                dbg, dis,is_info,section_size,new_cu_offset,
+                &cu_context,NULL,error);
+            if (lres != DW_DLV_OK) {
+                return lres;
+            }
+            new_cu_offset =  _dwarf_calculate_next_cu_context_offset(
+                cu_context);
+            /*  Not setting dis->de_cu_context, leave
+                that unchanged. */
+        } while (offset >= new_cu_offset);
+    }
+    /*  We have a cu_context for this offset. */
+    return _dwarf_make_die_at(cu_context,is_info,offset,
+        new_die,error);
+}
+
 /*  New March 2016.
     Lets one cross check the abbreviations section and
     the DIE information presented  by dwarfdump -i -G -v. */
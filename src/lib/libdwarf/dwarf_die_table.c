@@ -0,0 +1,498 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/*  A flat table of the DIEs of one CU, built in a
+    single pass over the CU so that the parent,
+    sibling and first child of any DIE are found
+    without re-reading the CU.
+    See dwarf_die_table_build() and dwarf_die_parent(). */
+
+#include <config.h>
+
+#include <string.h> /* memcpy() memset() */
+
+#if defined(_WIN32) && defined(HAVE_STDAFX_H)
+#include "stdafx.h"
+#endif /* HAVE_STDAFX_H */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dwarf_base_types.h"
+#include "dwarf_opaque.h"
+#include "dwarf_alloc.h"
+#include "dwarf_error.h"
+#include "dwarf_util.h"
+#include "dwarf_die_deliv.h"
+
+struct Dwarf_Die_Table_Entry_s {
+    /* Section-global offset */
+    Dwarf_Off      dte_offset;
+    Dwarf_Unsigned dte_abbrev_code;
+    Dwarf_Unsigned dte_depth;
+    Dwarf_Unsigned dte_parent;
+    Dwarf_Unsigned dte_sibling;
+    Dwarf_Unsigned dte_first_child;
+    Dwarf_Half     dte_tag;
+};
+
+struct Dwarf_Die_Table_s {
+    /*  In offset order, which is also a
+        preorder walk of the DIE tree. */
+    struct Dwarf_Die_Table_Entry_s *dt_entries;
+    Dwarf_Unsigned                  dt_count;
+};
+
+/*  All the table memory comes from the
+    allocator of the Dwarf_Debug (see dwarf_set_allocator()). */
+void
+_dwarf_free_die_table(Dwarf_CU_Context context)
+{
+    struct Dwarf_Die_Table_s *t = context->cc_die_table;
+    Dwarf_Allocator *a = 0;
+
+    if (!t) {
+        return;
+    }
+    a = &context->cc_dbg->de_allocator;
+    _dwarf_allocator_free(a,t->dt_entries);
+    t->dt_entries = 0;
+    t->dt_count = 0;
+    _dwarf_allocator_free(a,t);
+    context->cc_die_table = 0;
+}
+
+/*  Grows the array to at least *cap_io + 1 entries
+    of entsize bytes. The allocator has no realloc
+    so the entries are copied.
+    Returns zero on allocation failure,
+    leaving the array unchanged. */
+static int
+grow_array(Dwarf_Allocator *a,void **array_io,
+    Dwarf_Unsigned *cap_io, size_t entsize)
+{
+    Dwarf_Unsigned newcap = *cap_io? (*cap_io * 2): 64;
+    void *newp = 0;
+
+    newp = _dwarf_allocator_malloc(a,newcap*entsize);
+    if (!newp) {
+        return FALSE;
+    }
+    if (*array_io) {
+        memcpy(newp,*array_io,(size_t)(*cap_io*entsize));
+        _dwarf_allocator_free(a,*array_io);
+    }
+    *array_io = newp;
+    *cap_io = newcap;
+    return TRUE;
+}
+
+static int
+build_die_table(Dwarf_CU_Context context,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug    dbg = context->cc_dbg;
+    Dwarf_Allocator *a = &dbg->de_allocator;
+    Dwarf_Small   *dataptr = 0;
+    Dwarf_Byte_Ptr cu_info_start = 0;
+    Dwarf_Byte_Ptr info_ptr = 0;
+    Dwarf_Byte_Ptr die_info_end = 0;
+    Dwarf_Unsigned headerlen = 0;
+    Dwarf_Unsigned seclen = 0;
+    struct Dwarf_Die_Table_Entry_s *entries = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned cap = 0;
+    /*  For depth d (d >= 1) parents[d-1] is the index
+        of the open parent and lastkid[d-1] the index of
+        its most recent child. */
+    Dwarf_Unsigned *parents = 0;
+    Dwarf_Unsigned *lastkid = 0;
+    Dwarf_Unsigned stackcap = 0;
+    Dwarf_Unsigned lastkidcap = 0;
+    Dwarf_Unsigned depth = 0;
+    struct Dwarf_Die_Table_s *table = 0;
+    int res = 0;
+
+    dataptr = _dwarf_calculate_info_section_start_ptr(context,
+        &seclen);
+    cu_info_start = dataptr + context->cc_debug_offset;
+    res = _dwarf_length_of_cu_header(dbg,
+        context->cc_debug_offset,context->cc_is_info,
+        &headerlen,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    info_ptr = cu_info_start + headerlen;
+    die_info_end = _dwarf_calculate_info_section_end_ptr(context);
+
+    while (info_ptr < die_info_end) {
+        Dwarf_Byte_Ptr die_ptr = info_ptr;
+        Dwarf_Byte_Ptr next_ptr = 0;
+        Dwarf_Unsigned abbrev_code = 0;
+        Dwarf_Bool has_child = FALSE;
+        Dwarf_Abbrev_List abbrev_list = 0;
+        struct Dwarf_Die_Table_Entry_s *e = 0;
+
+        res = _dwarf_leb128_uword_wrapper(dbg,&info_ptr,
+            die_info_end,&abbrev_code,error);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        if (!abbrev_code) {
+            /*  A null DIE ends the children of
+                the innermost open parent. */
+            if (depth <= 1) {
+                break;
+            }
+            --depth;
+            continue;
+        }
+        if (count >= cap) {
+            if (!grow_array(a,(void **)&entries,&cap,
+                sizeof(*entries))) {
+                res = DW_DLV_ERROR;
+                _dwarf_error_string(dbg, error,
+                    DW_DLE_ALLOC_FAIL,
+                    "DW_DLE_ALLOC_FAIL: "
+                    "growing the DIE table");
+                break;
+            }
+        }
+        res = _dwarf_next_die_info_ptr(die_ptr,context,
+            die_info_end,cu_info_start,FALSE,
+            &has_child,&next_ptr,&abbrev_list,error);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        e = entries + count;
+        e->dte_offset = (Dwarf_Off)(die_ptr - dataptr);
+        e->dte_abbrev_code = abbrev_code;
+        e->dte_tag = abbrev_list->abl_tag;
+        e->dte_depth = depth;
+        e->dte_sibling = DW_DIE_TABLE_NO_INDEX;
+        e->dte_first_child = DW_DIE_TABLE_NO_INDEX;
+        if (depth) {
+            Dwarf_Unsigned p = parents[depth-1];
+
+            e->dte_parent = p;
+            if (lastkid[depth-1] == DW_DIE_TABLE_NO_INDEX) {
+                entries[p].dte_first_child = count;
+            } else {
+                entries[lastkid[depth-1]].dte_sibling = count;
+            }
+            lastkid[depth-1] = count;
+        } else {
+            e->dte_parent = DW_DIE_TABLE_NO_INDEX;
+        }
+        info_ptr = next_ptr;
+        if (!has_child) {
+            ++count;
+            if (!depth) {
+                /* CU DIE without children. */
+                break;
+            }
+            continue;
+        }
+        if (depth >= stackcap) {
+            if (!grow_array(a,(void **)&parents,&stackcap,
+                sizeof(*parents)) ||
+                !grow_array(a,(void **)&lastkid,&lastkidcap,
+                sizeof(*lastkid))) {
+                res = DW_DLV_ERROR;
+                _dwarf_error_string(dbg, error,
+                    DW_DLE_ALLOC_FAIL,
+                    "DW_DLE_ALLOC_FAIL: "
+                    "growing the DIE table depth");
+                break;
+            }
+        }
+        parents[depth] = count;
+        lastkid[depth] = DW_DIE_TABLE_NO_INDEX;
+        ++depth;
+        ++count;
+    }
+    _dwarf_allocator_free(a,parents);
+    _dwarf_allocator_free(a,lastkid);
+    if (res == DW_DLV_ERROR) {
+        _dwarf_allocator_free(a,entries);
+        return res;
+    }
+    table = (struct Dwarf_Die_Table_s *)_dwarf_allocator_malloc(a,
+        sizeof(*table));
+    if (!table) {
+        _dwarf_allocator_free(a,entries);
+        _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: allocating the DIE table");
+        return DW_DLV_ERROR;
+    }
+    table->dt_entries = entries;
+    table->dt_count = count;
+    context->cc_die_table = table;
+    return DW_DLV_OK;
+}
+
+static int
+get_die_table(Dwarf_Die die,
+    struct Dwarf_Die_Table_s **table_out,
+    Dwarf_Error *error)
+{
+    Dwarf_CU_Context context = die->di_cu_context;
+
+    if (!context->cc_die_table) {
+        int res = build_die_table(context,error);
+
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    *table_out = context->cc_die_table;
+    return DW_DLV_OK;
+}
+
+/*  Binary search by offset unless the DIE
+    already knows its index. */
+static int
+find_die_index(Dwarf_Die die,
+    struct Dwarf_Die_Table_s *table,
+    Dwarf_Unsigned *index_out)
+{
+    Dwarf_Unsigned seclen = 0;
+    Dwarf_Small   *dataptr = 0;
+    Dwarf_Off      offset = 0;
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = table->dt_count;
+
+    if (die->di_table_index &&
+        die->di_table_index <= table->dt_count) {
+        *index_out = die->di_table_index - 1;
+        return DW_DLV_OK;
+    }
+    dataptr = _dwarf_calculate_info_section_start_ptr(
+        die->di_cu_context,&seclen);
+    offset = (Dwarf_Off)(die->di_debug_ptr - dataptr);
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+        Dwarf_Off midoff = table->dt_entries[mid].dte_offset;
+
+        if (midoff == offset) {
+            die->di_table_index = mid + 1;
+            *index_out = mid;
+            return DW_DLV_OK;
+        }
+        if (midoff < offset) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return DW_DLV_NO_ENTRY;
+}
+
+/*  Called as dwarf_child() (is_child TRUE) or
+    dwarf_siblingof_c() return newdie from from.
+    If the CU table exists and from knows its index
+    the index of newdie is one table read away, which
+    keeps dwarf_die_parent() on newdie O(1).
+    The offset check keeps a DW_AT_sibling that
+    disagrees with the table from recording
+    a wrong index. */
+void
+_dwarf_die_table_note_related(Dwarf_Die from,
+    Dwarf_Die newdie,
+    Dwarf_Bool is_child)
+{
+    struct Dwarf_Die_Table_s *table = 0;
+    struct Dwarf_Die_Table_Entry_s *e = 0;
+    Dwarf_Unsigned seclen = 0;
+    Dwarf_Small   *dataptr = 0;
+    Dwarf_Unsigned index = 0;
+
+    if (!from || !from->di_table_index ||
+        from->di_cu_context != newdie->di_cu_context) {
+        return;
+    }
+    table = newdie->di_cu_context->cc_die_table;
+    if (!table || from->di_table_index > table->dt_count) {
+        return;
+    }
+    e = table->dt_entries + (from->di_table_index - 1);
+    index = is_child? e->dte_first_child : e->dte_sibling;
+    if (index >= table->dt_count) {
+        /* Includes DW_DIE_TABLE_NO_INDEX */
+        return;
+    }
+    dataptr = _dwarf_calculate_info_section_start_ptr(
+        newdie->di_cu_context,&seclen);
+    if (table->dt_entries[index].dte_offset !=
+        (Dwarf_Off)(newdie->di_debug_ptr - dataptr)) {
+        return;
+    }
+    newdie->di_table_index = index + 1;
+}
+
+int
+dwarf_die_table_build(Dwarf_Die die,
+    Dwarf_Unsigned *entry_count,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Die_Table_s *table = 0;
+    int res = 0;
+
+    CHECK_DIE(die, DW_DLV_ERROR);
+    res = get_die_table(die,&table,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (entry_count) {
+        *entry_count = table->dt_count;
+    }
+    return DW_DLV_OK;
+}
+
+int
+dwarf_die_table_index(Dwarf_Die die,
+    Dwarf_Unsigned *index,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Die_Table_s *table = 0;
+    int res = 0;
+
+    CHECK_DIE(die, DW_DLV_ERROR);
+    res = get_die_table(die,&table,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    return find_die_index(die,table,index);
+}
+
+int
+dwarf_die_table_entry(Dwarf_Die die,
+    Dwarf_Unsigned  index,
+    Dwarf_Off      *offset,
+    Dwarf_Half     *tag,
+    Dwarf_Unsigned *abbrev_code,
+    Dwarf_Unsigned *depth,
+    Dwarf_Unsigned *parent,
+    Dwarf_Unsigned *sibling,
+    Dwarf_Unsigned *first_child,
+    Dwarf_Error    *error)
+{
+    struct Dwarf_Die_Table_s *table = 0;
+    struct Dwarf_Die_Table_Entry_s *e = 0;
+    int res = 0;
+
+    CHECK_DIE(die, DW_DLV_ERROR);
+    res = get_die_table(die,&table,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (index >= table->dt_count) {
+        return DW_DLV_NO_ENTRY;
+    }
+    e = table->dt_entries + index;
+    if (offset) {
+        *offset = e->dte_offset;
+    }
+    if (tag) {
+        *tag = e->dte_tag;
+    }
+    if (abbrev_code) {
+        *abbrev_code = e->dte_abbrev_code;
+    }
+    if (depth) {
+        *depth = e->dte_depth;
+    }
+    if (parent) {
+        *parent = e->dte_parent;
+    }
+    if (sibling) {
+        *sibling = e->dte_sibling;
+    }
+    if (first_child) {
+        *first_child = e->dte_first_child;
+    }
+    return DW_DLV_OK;
+}
+
+int
+dwarf_die_table_die(Dwarf_Die die,
+    Dwarf_Unsigned index,
+    Dwarf_Die     *return_die,
+    Dwarf_Error   *error)
+{
+    struct Dwarf_Die_Table_s *table = 0;
+    Dwarf_Die newdie = 0;
+    int res = 0;
+
+    CHECK_DIE(die, DW_DLV_ERROR);
+    res = get_die_table(die,&table,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (index >= table->dt_count) {
+        return DW_DLV_NO_ENTRY;
+    }
+    res = _dwarf_make_die_at(die->di_cu_context,die->di_is_info,
+        table->dt_entries[index].dte_offset,&newdie,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    newdie->di_table_index = index + 1;
+    *return_die = newdie;
+    return DW_DLV_OK;
+}
+
+int
+dwarf_die_parent(Dwarf_Die die,
+    Dwarf_Die   *return_parent,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Die_Table_s *table = 0;
+    Dwarf_Unsigned index = 0;
+    Dwarf_Unsigned parent = 0;
+    int res = 0;
+
+    CHECK_DIE(die, DW_DLV_ERROR);
+    res = get_die_table(die,&table,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = find_die_index(die,table,&index);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    parent = table->dt_entries[index].dte_parent;
+    if (parent == DW_DIE_TABLE_NO_INDEX) {
+        return DW_DLV_NO_ENTRY;
+    }
+    return dwarf_die_table_die(die,parent,return_parent,error);
+}
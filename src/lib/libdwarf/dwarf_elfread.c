@@ -124,6 +124,7 @@ _dwarf_elf_object_access_init(
     unsigned endian,
     unsigned offsetsize,
     size_t filesize,
+    const Dwarf_Allocator *alloc,
     Dwarf_Obj_Access_Interface_a **binary_interface,
     int *localerrnum);
 
@@ -227,7 +228,8 @@ elf_load_nolibelf_section (void *obj, Dwarf_Unsigned section_index,
             return DW_DLV_ERROR;
         }
 
-        sp->gh_content = malloc((size_t)sp->gh_size);
+        sp->gh_content = _dwarf_allocator_malloc(
+            &elf->f_allocator,sp->gh_size);
         if (!sp->gh_content) {
             *error = DW_DLE_ALLOC_FAIL;
             return DW_DLV_ERROR;
@@ -247,7 +249,8 @@ elf_load_nolibelf_section (void *obj, Dwarf_Unsigned section_index,
                 read_size,
                 elf->f_filesize, error);
             if (res != DW_DLV_OK) {
-                free(sp->gh_content);
+                _dwarf_allocator_free(&elf->f_allocator,
+                    sp->gh_content);
                 sp->gh_content = 0;
                 return res;
             }
@@ -261,6 +264,160 @@ elf_load_nolibelf_section (void *obj, Dwarf_Unsigned section_index,
     return DW_DLV_NO_ENTRY;
 }
 
+/*  Frees the section bytes read by
+    elf_load_nolibelf_section() so a later load
+    reads them from the file again. */
+void
+_dwarf_elf_nlunload_section(
+    struct Dwarf_Obj_Access_Interface_a_s *aip,
+    Dwarf_Unsigned section_index)
+{
+    dwarf_elf_object_access_internals_t *elf = 0;
+    struct generic_shdr *sp = 0;
+
+    if (!aip) {
+        return;
+    }
+    elf = (dwarf_elf_object_access_internals_t*)aip->ai_object;
+    if (!section_index || section_index >= elf->f_loc_shdr.g_count) {
+        return;
+    }
+    sp = elf->f_shdr + section_index;
+    _dwarf_allocator_free(&elf->f_allocator,sp->gh_content);
+    sp->gh_content = 0;
+}
+
+/*  Sections closer together than this in the file
+    are read by one preadv(), the gap bytes going
+    to a scratch buffer and being discarded. */
+#define DW_BATCH_MAX_GAP 64
+
+/*  Reads the contents of all the sections listed
+    in indexes (which must be valid section indexes)
+    so later elf_load_nolibelf_section() calls
+    find gh_content already present.
+    Sections adjacent in the file are read together
+    with a single vectored read.
+    Already-loaded and empty sections are skipped. */
+int
+_dwarf_elf_nlload_sections(
+    struct Dwarf_Obj_Access_Interface_a_s *aip,
+    Dwarf_Unsigned *indexes,
+    unsigned count,
+    int *errc)
+{
+    dwarf_elf_object_access_internals_t *elf = 0;
+    struct generic_shdr *toload[DWARF_MAX_DEBUG_SECTIONS];
+    struct Dwarf_Read_Vec_s vec[DWARF_MAX_DEBUG_SECTIONS*2];
+    char gapbuf[DW_BATCH_MAX_GAP];
+    unsigned loadcount = 0;
+    unsigned i = 0;
+
+    if (!aip) {
+        return DW_DLV_NO_ENTRY;
+    }
+    elf = (dwarf_elf_object_access_internals_t*)aip->ai_object;
+    if (count > DWARF_MAX_DEBUG_SECTIONS) {
+        count = DWARF_MAX_DEBUG_SECTIONS;
+    }
+    for (i = 0; i < count; ++i) {
+        struct generic_shdr *sp = 0;
+        unsigned k = 0;
+        Dwarf_Unsigned sindex = indexes[i];
+
+        if (!sindex || sindex >= elf->f_loc_shdr.g_count) {
+            continue;
+        }
+        sp = elf->f_shdr + sindex;
+        if (sp->gh_content || !sp->gh_size) {
+            continue;
+        }
+        if (sp->gh_size > elf->f_filesize ||
+            sp->gh_offset > elf->f_filesize ||
+            (sp->gh_size + sp->gh_offset) >
+                elf->f_filesize) {
+            *errc = DW_DLE_ELF_SECTION_ERROR;
+            return DW_DLV_ERROR;
+        }
+        /*  Insertion sort by file offset, the
+            list is short. Duplicates are dropped. */
+        for (k = loadcount; k > 0; --k) {
+            if (toload[k-1] == sp) {
+                break;
+            }
+            if (toload[k-1]->gh_offset <= sp->gh_offset) {
+                break;
+            }
+        }
+        if (k > 0 && toload[k-1] == sp) {
+            continue;
+        }
+        if (k < loadcount) {
+            memmove(&toload[k+1],&toload[k],
+                (loadcount-k)*sizeof(toload[0]));
+        }
+        toload[k] = sp;
+        ++loadcount;
+    }
+    for (i = 0; i < loadcount; ++i) {
+        toload[i]->gh_content = _dwarf_allocator_malloc(
+            &elf->f_allocator,toload[i]->gh_size);
+        if (!toload[i]->gh_content) {
+            *errc = DW_DLE_ALLOC_FAIL;
+            for ( ; i > 0; --i) {
+                _dwarf_allocator_free(&elf->f_allocator,
+                    toload[i-1]->gh_content);
+                toload[i-1]->gh_content = 0;
+            }
+            return DW_DLV_ERROR;
+        }
+    }
+    i = 0;
+    while (i < loadcount) {
+        unsigned first = i;
+        unsigned veccount = 0;
+        Dwarf_Unsigned runend = 0;
+        int res = 0;
+
+        vec[veccount].rv_buf = toload[i]->gh_content;
+        vec[veccount].rv_len = toload[i]->gh_size;
+        ++veccount;
+        runend = toload[i]->gh_offset + toload[i]->gh_size;
+        for (++i; i < loadcount; ++i) {
+            struct generic_shdr *sp = toload[i];
+
+            /*  Overlapping sections (corrupt or odd
+                objects) start a new run. */
+            if (sp->gh_offset < runend ||
+                (sp->gh_offset - runend) > DW_BATCH_MAX_GAP) {
+                break;
+            }
+            if (sp->gh_offset > runend) {
+                vec[veccount].rv_buf = gapbuf;
+                vec[veccount].rv_len = sp->gh_offset - runend;
+                ++veccount;
+            }
+            vec[veccount].rv_buf = sp->gh_content;
+            vec[veccount].rv_len = sp->gh_size;
+            ++veccount;
+            runend = sp->gh_offset + sp->gh_size;
+        }
+        res = _dwarf_object_readv_random(elf->f_fd,vec,veccount,
+            toload[first]->gh_offset,elf->f_filesize,errc);
+        if (res != DW_DLV_OK) {
+            unsigned j = first;
+
+            for ( ; j < loadcount; ++j) {
+                _dwarf_allocator_free(&elf->f_allocator,
+                    toload[j]->gh_content);
+                toload[j]->gh_content = 0;
+            }
+            return res;
+        }
+    }
+    return DW_DLV_OK;
+}
+
 #define MATCH_REL_SEC(i_,s_,r_)  \
 if ((i_) == (s_).dss_index) { \
     *(r_) = &(s_);            \
@@ -544,7 +701,7 @@ _dwarf_destruct_elf_nlaccess(
     for (i = 0; i < shcount; ++i,++shp) {
         free(shp->gh_rels);
         shp->gh_rels = 0;
-        free(shp->gh_content);
+        _dwarf_allocator_free(&ep->f_allocator,shp->gh_content);
         shp->gh_content = 0;
         free(shp->gh_sht_group_array);
         shp->gh_sht_group_array = 0;
@@ -580,6 +737,7 @@ _dwarf_elf_nlsetup(int fd,
     unsigned groupnumber,
     Dwarf_Handler errhand,
     Dwarf_Ptr errarg,
+    const Dwarf_Allocator *alloc,
     Dwarf_Debug *dbg,Dwarf_Error *error)
 {
     Dwarf_Obj_Access_Interface_a *binary_interface = 0;
@@ -590,6 +748,7 @@ _dwarf_elf_nlsetup(int fd,
     res = _dwarf_elf_object_access_init(
         fd,
         ftype,endian,offsetsize,filesize,
+        alloc,
         &binary_interface,
         &localerrnum);
     if (res != DW_DLV_OK) {
@@ -601,8 +760,8 @@ _dwarf_elf_nlsetup(int fd,
     }
     /*  allocates and initializes Dwarf_Debug,
         generic code */
-    res = dwarf_object_init_b(binary_interface, errhand, errarg,
-        groupnumber, dbg, error);
+    res = dwarf_object_init_alloc(binary_interface, alloc,
+        errhand, errarg, groupnumber, dbg, error);
     if (res != DW_DLV_OK){
         _dwarf_destruct_elf_nlaccess(binary_interface);
         return res;
@@ -766,6 +925,7 @@ _dwarf_elf_object_access_init(
     unsigned endian,
     unsigned offsetsize,
     size_t filesize,
+    const Dwarf_Allocator *alloc,
     Dwarf_Obj_Access_Interface_a **binary_interface,
     int *localerrnum)
 {
@@ -781,6 +941,7 @@ _dwarf_elf_object_access_init(
         return DW_DLV_ERROR;
     }
     memset(internals,0,sizeof(*internals));
+    _dwarf_choose_allocator(alloc,&internals->f_allocator);
     res = _dwarf_elf_object_access_internals_init(internals,
         fd,
         ftype, endian, offsetsize, filesize,
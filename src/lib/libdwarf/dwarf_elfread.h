@@ -192,6 +192,8 @@ typedef struct elf_filedata_s {
     Dwarf_Small    f_pointersize;
     int            f_ftype;
     int            f_path_source;
+    /*  Used for gh_content, see dwarf_set_allocator(). */
+    Dwarf_Allocator f_allocator;
 
     Dwarf_Unsigned f_max_secdata_offset;
     Dwarf_Unsigned f_max_progdata_offset;
@@ -686,6 +686,12 @@ static const char _dwarf_errmsgs[DW_DLE_LAST+1][DW_MAX_MSG_LEN] = {
 {"DW_DLE_UNIVERSAL_BINARY_ERROR(502) Error reading Mach-O "
     "uninversal binary head. Corrupt Mach-O object." },
 {"DW_DLE_UNIV_BIN_OFFSET_SIZE_ERROR(503) Offset/size from "
-    "a Mach-O universal binary has an impossible value"}
+    "a Mach-O universal binary has an impossible value"},
+{"DW_DLE_EXPR_EVAL_ERROR(504) A DWARF expression could "
+    "not be evaluated"},
+{"DW_DLE_PRO_SECTION_SINK_ERROR(505) The producer section "
+    "sink callback returned an error"},
+{"DW_DLE_ALLOCATOR_ERROR(506) A Dwarf_Allocator passed at "
+    "init has only one of da_malloc and da_free"}
 };
 #endif /* DWARF_ERRMSG_LIST_H */
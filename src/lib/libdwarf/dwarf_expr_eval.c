@@ -0,0 +1,1011 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/*  Evaluation of DWARF location expressions.
+    See dwarf_expr_evaluate().
+
+    Nearly all location expressions compilers emit are
+    one of a few shapes: a single DW_OP_fbreg, DW_OP_bregN,
+    DW_OP_addr, DW_OP_regN or DW_OP_call_frame_cfa,
+    a constant with DW_OP_stack_value, or a sequence of
+    those each followed by DW_OP_piece.
+    The first evaluation of a Dwarf_Locdesc_c records
+    its shape (and, for single operators, the operands)
+    in the locdesc so later evaluations compute those
+    directly. Anything else is run on the stack machine
+    in _dwarf_expr_eval_general(). */
+
+#include <config.h>
+
+#include <string.h> /* memset() */
+
+#if defined(_WIN32) && defined(HAVE_STDAFX_H)
+#include "stdafx.h"
+#endif /* HAVE_STDAFX_H */
+
+#ifdef HAVE_STDINT_H
+#include <stdint.h> /* uintptr_t */
+#endif /* HAVE_STDINT_H */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dwarf_base_types.h"
+#include "dwarf_opaque.h"
+#include "dwarf_alloc.h"
+#include "dwarf_error.h"
+#include "dwarf_util.h"
+#include "dwarf_loc.h"
+#include "dwarf_string.h"
+
+/*  Values of ld_eval_shape. */
+#define EXPR_SHAPE_UNKNOWN 0
+#define EXPR_SHAPE_GENERAL 1 /* Use the stack machine */
+#define EXPR_SHAPE_EMPTY   2 /* No operators */
+#define EXPR_SHAPE_ADDR    3 /* DW_OP_addr, DW_OP_addrx */
+#define EXPR_SHAPE_REG     4 /* DW_OP_regN, DW_OP_regx */
+#define EXPR_SHAPE_BREG    5 /* DW_OP_bregN, DW_OP_bregx */
+#define EXPR_SHAPE_FBREG   6 /* DW_OP_fbreg */
+#define EXPR_SHAPE_CFA     7 /* DW_OP_call_frame_cfa */
+#define EXPR_SHAPE_VALUE   8 /* constant, DW_OP_stack_value */
+#define EXPR_SHAPE_PIECES  9 /* simple operators and pieces */
+
+/*  DWARF5 2.5.1 asks for no particular stack depth.
+    Compilers never come close to this. */
+#define EXPR_STACK_MAX 64
+/*  DW_OP_bra and DW_OP_skip allow loops, so stop
+    a (corrupt) expression that never ends. */
+#define EXPR_STEP_MAX  100000
+
+struct expr_eval_s {
+    Dwarf_Debug      ev_dbg;
+    Dwarf_Locdesc_c  ev_locdesc;
+    Dwarf_CU_Context ev_context;
+    const Dwarf_Expr_Callbacks *ev_cb;
+    unsigned         ev_address_size;
+    /*  Values on the stack are address-sized
+        (the DWARF generic type). */
+    Dwarf_Unsigned   ev_mask;
+    Dwarf_Expr_Piece *ev_pieces;
+    Dwarf_Unsigned   ev_pieces_max;
+    Dwarf_Unsigned   ev_piece_count;
+    Dwarf_Error     *ev_error;
+};
+
+static int
+expr_error(struct expr_eval_s *ev, Dwarf_Small atom,
+    const char *msg)
+{
+    dwarfstring m;
+
+    dwarfstring_constructor(&m);
+    dwarfstring_append(&m,"DW_DLE_EXPR_EVAL_ERROR: ");
+    dwarfstring_append(&m,(char *)msg);
+    if (atom) {
+        const char *opname = 0;
+        int res = 0;
+
+        res = dwarf_get_OP_name(atom,&opname);
+        if (res == DW_DLV_OK) {
+            dwarfstring_append_printf_s(&m," at %s",
+                (char *)opname);
+        } else {
+            dwarfstring_append_printf_u(&m,
+                " at operator 0x%x",atom);
+        }
+    }
+    _dwarf_error_string(ev->ev_dbg,ev->ev_error,
+        DW_DLE_EXPR_EVAL_ERROR,dwarfstring_string(&m));
+    dwarfstring_destructor(&m);
+    return DW_DLV_ERROR;
+}
+
+/*  A callback returning DW_DLV_NO_ENTRY (value not
+    available) ends the evaluation with DW_DLV_NO_ENTRY.
+    Anything else but DW_DLV_OK is an error. */
+static int
+expr_callback_result(struct expr_eval_s *ev, int res,
+    const char *name)
+{
+    dwarfstring m;
+
+    if (res == DW_DLV_OK || res == DW_DLV_NO_ENTRY) {
+        return res;
+    }
+    dwarfstring_constructor(&m);
+    dwarfstring_append_printf_s(&m,
+        "DW_DLE_EXPR_EVAL_ERROR: the %s callback failed",
+        (char *)name);
+    _dwarf_error_string(ev->ev_dbg,ev->ev_error,
+        DW_DLE_EXPR_EVAL_ERROR,dwarfstring_string(&m));
+    dwarfstring_destructor(&m);
+    return DW_DLV_ERROR;
+}
+
+static int
+expr_missing_callback(struct expr_eval_s *ev,
+    const char *name)
+{
+    dwarfstring m;
+
+    dwarfstring_constructor(&m);
+    dwarfstring_append_printf_s(&m,
+        "DW_DLE_EXPR_EVAL_ERROR: the expression needs "
+        "the %s callback but it is NULL",
+        (char *)name);
+    _dwarf_error_string(ev->ev_dbg,ev->ev_error,
+        DW_DLE_EXPR_EVAL_ERROR,dwarfstring_string(&m));
+    dwarfstring_destructor(&m);
+    return DW_DLV_ERROR;
+}
+
+static int
+expr_read_register(struct expr_eval_s *ev,
+    Dwarf_Unsigned regnum, Dwarf_Unsigned *value)
+{
+    const Dwarf_Expr_Callbacks *cb = ev->ev_cb;
+
+    if (!cb->ec_read_register) {
+        return expr_missing_callback(ev,"ec_read_register");
+    }
+    return expr_callback_result(ev,
+        cb->ec_read_register(cb->ec_user_data,regnum,value),
+        "ec_read_register");
+}
+
+static int
+expr_read_memory(struct expr_eval_s *ev,
+    Dwarf_Addr addr, Dwarf_Unsigned size,
+    Dwarf_Unsigned *value)
+{
+    const Dwarf_Expr_Callbacks *cb = ev->ev_cb;
+
+    if (!cb->ec_read_memory) {
+        return expr_missing_callback(ev,"ec_read_memory");
+    }
+    return expr_callback_result(ev,
+        cb->ec_read_memory(cb->ec_user_data,addr,size,value),
+        "ec_read_memory");
+}
+
+static int
+expr_frame_base(struct expr_eval_s *ev, Dwarf_Addr *value)
+{
+    const Dwarf_Expr_Callbacks *cb = ev->ev_cb;
+
+    if (!cb->ec_frame_base) {
+        return expr_missing_callback(ev,"ec_frame_base");
+    }
+    return expr_callback_result(ev,
+        cb->ec_frame_base(cb->ec_user_data,value),
+        "ec_frame_base");
+}
+
+static int
+expr_call_frame_cfa(struct expr_eval_s *ev, Dwarf_Addr *value)
+{
+    const Dwarf_Expr_Callbacks *cb = ev->ev_cb;
+
+    if (!cb->ec_call_frame_cfa) {
+        return expr_missing_callback(ev,"ec_call_frame_cfa");
+    }
+    return expr_callback_result(ev,
+        cb->ec_call_frame_cfa(cb->ec_user_data,value),
+        "ec_call_frame_cfa");
+}
+
+static int
+expr_tls_address(struct expr_eval_s *ev,
+    Dwarf_Unsigned offset, Dwarf_Addr *value)
+{
+    const Dwarf_Expr_Callbacks *cb = ev->ev_cb;
+
+    if (!cb->ec_tls_address) {
+        return expr_missing_callback(ev,"ec_tls_address");
+    }
+    return expr_callback_result(ev,
+        cb->ec_tls_address(cb->ec_user_data,offset,value),
+        "ec_tls_address");
+}
+
+static int
+expr_object_address(struct expr_eval_s *ev, Dwarf_Addr *value)
+{
+    const Dwarf_Expr_Callbacks *cb = ev->ev_cb;
+
+    if (!cb->ec_object_address) {
+        return expr_missing_callback(ev,"ec_object_address");
+    }
+    return expr_callback_result(ev,
+        cb->ec_object_address(cb->ec_user_data,value),
+        "ec_object_address");
+}
+
+/*  A .debug_addr entry for DW_OP_addrx or DW_OP_constx. */
+static int
+expr_debug_addr(struct expr_eval_s *ev, Dwarf_Small atom,
+    Dwarf_Unsigned index, Dwarf_Unsigned *value)
+{
+    if (!ev->ev_context) {
+        return expr_error(ev,atom,
+            "no CU is known for the .debug_addr index");
+    }
+    return _dwarf_look_in_local_and_tied_by_index(ev->ev_dbg,
+        ev->ev_context,index,value,ev->ev_error);
+}
+
+/*  Interpret an address-sized value as signed. */
+static Dwarf_Signed
+expr_signed(struct expr_eval_s *ev, Dwarf_Unsigned v)
+{
+    Dwarf_Unsigned signbit = 0;
+
+    if (ev->ev_mask == ~(Dwarf_Unsigned)0) {
+        return (Dwarf_Signed)v;
+    }
+    signbit = (ev->ev_mask >> 1) + 1;
+    if (v & signbit) {
+        v |= ~ev->ev_mask;
+    }
+    return (Dwarf_Signed)v;
+}
+
+static int
+expr_add_piece(struct expr_eval_s *ev,
+    Dwarf_Small kind, Dwarf_Unsigned value,
+    Dwarf_Ptr block,
+    Dwarf_Unsigned size_bits, Dwarf_Unsigned offset_bits)
+{
+    Dwarf_Expr_Piece *p = 0;
+
+    if (ev->ev_piece_count >= ev->ev_pieces_max) {
+        return expr_error(ev,0,
+            "more pieces than dw_pieces_max allows");
+    }
+    p = ev->ev_pieces + ev->ev_piece_count;
+    p->ep_kind = kind;
+    p->ep_value = value;
+    p->ep_block = block;
+    p->ep_size_bits = size_bits;
+    p->ep_offset_bits = offset_bits;
+    ++ev->ev_piece_count;
+    return DW_DLV_OK;
+}
+
+/*  If op is one of the single operator locations
+    return its shape and operands, else return FALSE.
+    DW_OP_addrx is only looked up in .debug_addr
+    if lookup_index is TRUE. */
+static Dwarf_Bool
+expr_simple_op(struct expr_eval_s *ev, Dwarf_Loc_Expr_Op op,
+    Dwarf_Bool lookup_index,
+    Dwarf_Small *shape, Dwarf_Unsigned *value,
+    Dwarf_Signed *offset)
+{
+    Dwarf_Small atom = op->lr_atom;
+
+    if (atom >= DW_OP_reg0 && atom <= DW_OP_reg31) {
+        *shape = EXPR_SHAPE_REG;
+        *value = atom - DW_OP_reg0;
+        return TRUE;
+    }
+    if (atom >= DW_OP_breg0 && atom <= DW_OP_breg31) {
+        *shape = EXPR_SHAPE_BREG;
+        *value = atom - DW_OP_breg0;
+        *offset = (Dwarf_Signed)op->lr_number;
+        return TRUE;
+    }
+    switch (atom) {
+    case DW_OP_addr:
+        *shape = EXPR_SHAPE_ADDR;
+        *value = op->lr_number;
+        return TRUE;
+    case DW_OP_addrx:
+    case DW_OP_GNU_addr_index: {
+        Dwarf_Error lerr = 0;
+        Dwarf_Error *saved = ev->ev_error;
+        int res = 0;
+
+        if (!lookup_index || !ev->ev_context) {
+            return FALSE;
+        }
+        /*  On failure leave it to the stack machine
+            to report the error. */
+        ev->ev_error = &lerr;
+        res = expr_debug_addr(ev,atom,op->lr_number,value);
+        ev->ev_error = saved;
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(ev->ev_dbg,lerr);
+        }
+        if (res != DW_DLV_OK) {
+            return FALSE;
+        }
+        *shape = EXPR_SHAPE_ADDR;
+        return TRUE;
+    }
+    case DW_OP_regx:
+        *shape = EXPR_SHAPE_REG;
+        *value = op->lr_number;
+        return TRUE;
+    case DW_OP_bregx:
+        *shape = EXPR_SHAPE_BREG;
+        *value = op->lr_number;
+        *offset = (Dwarf_Signed)op->lr_number2;
+        return TRUE;
+    case DW_OP_fbreg:
+        *shape = EXPR_SHAPE_FBREG;
+        *offset = (Dwarf_Signed)op->lr_number;
+        return TRUE;
+    case DW_OP_call_frame_cfa:
+        *shape = EXPR_SHAPE_CFA;
+        return TRUE;
+    default:
+        break;
+    }
+    return FALSE;
+}
+
+/*  Operators that push a constant known
+    without any machine state. */
+static Dwarf_Bool
+expr_constant_op(Dwarf_Loc_Expr_Op op)
+{
+    Dwarf_Small atom = op->lr_atom;
+
+    if (atom >= DW_OP_lit0 && atom <= DW_OP_lit31) {
+        return TRUE;
+    }
+    switch (atom) {
+    case DW_OP_const1u: case DW_OP_const1s:
+    case DW_OP_const2u: case DW_OP_const2s:
+    case DW_OP_const4u: case DW_OP_const4s:
+    case DW_OP_const8u: case DW_OP_const8s:
+    case DW_OP_constu:  case DW_OP_consts:
+        return TRUE;
+    default:
+        break;
+    }
+    return FALSE;
+}
+
+static Dwarf_Bool
+expr_piece_op(Dwarf_Loc_Expr_Op op)
+{
+    return op->lr_atom == DW_OP_piece ||
+        op->lr_atom == DW_OP_bit_piece;
+}
+
+static void
+expr_piece_size(Dwarf_Loc_Expr_Op op,
+    Dwarf_Unsigned *size_bits, Dwarf_Unsigned *offset_bits)
+{
+    if (op->lr_atom == DW_OP_piece) {
+        *size_bits = op->lr_number * 8;
+        *offset_bits = 0;
+    } else {
+        *size_bits = op->lr_number;
+        *offset_bits = op->lr_number2;
+    }
+}
+
+/*  Record the shape of the expression in the locdesc. */
+static void
+expr_classify(struct expr_eval_s *ev)
+{
+    Dwarf_Locdesc_c ld = ev->ev_locdesc;
+    Dwarf_Loc_Expr_Op ops = ld->ld_s;
+    Dwarf_Unsigned count = ld->ld_cents;
+    Dwarf_Small shape = EXPR_SHAPE_GENERAL;
+    Dwarf_Unsigned value = 0;
+    Dwarf_Signed offset = 0;
+    Dwarf_Unsigned i = 0;
+
+    if (!count) {
+        ld->ld_eval_shape = EXPR_SHAPE_EMPTY;
+        return;
+    }
+    if (count == 1) {
+        if (!expr_simple_op(ev,ops,TRUE,&shape,&value,&offset)) {
+            shape = EXPR_SHAPE_GENERAL;
+        }
+        ld->ld_eval_value = value;
+        ld->ld_eval_offset = offset;
+        ld->ld_eval_shape = shape;
+        return;
+    }
+    if (count == 2 && expr_constant_op(ops) &&
+        ops[1].lr_atom == DW_OP_stack_value) {
+        ld->ld_eval_value = ops->lr_number & ev->ev_mask;
+        ld->ld_eval_shape = EXPR_SHAPE_VALUE;
+        return;
+    }
+    /*  Each piece is an empty location or one
+        simple operator (no .debug_addr lookup).  */
+    while (i < count) {
+        if (expr_piece_op(ops+i)) {
+            ++i;
+            continue;
+        }
+        if (i+1 < count && expr_piece_op(ops+i+1) &&
+            expr_simple_op(ev,ops+i,FALSE,&shape,&value,
+            &offset)) {
+            i += 2;
+            continue;
+        }
+        ld->ld_eval_shape = EXPR_SHAPE_GENERAL;
+        return;
+    }
+    ld->ld_eval_shape = EXPR_SHAPE_PIECES;
+}
+
+/*  Compute a single operator location of the
+    given shape. */
+static int
+expr_eval_simple(struct expr_eval_s *ev, Dwarf_Small shape,
+    Dwarf_Unsigned value, Dwarf_Signed offset,
+    Dwarf_Unsigned size_bits, Dwarf_Unsigned offset_bits)
+{
+    Dwarf_Unsigned v = 0;
+    int res = 0;
+
+    switch (shape) {
+    case EXPR_SHAPE_ADDR:
+        return expr_add_piece(ev,DW_EXPR_LOC_MEMORY,value,0,
+            size_bits,offset_bits);
+    case EXPR_SHAPE_REG:
+        return expr_add_piece(ev,DW_EXPR_LOC_REGISTER,value,0,
+            size_bits,offset_bits);
+    case EXPR_SHAPE_BREG:
+        res = expr_read_register(ev,value,&v);
+        break;
+    case EXPR_SHAPE_FBREG:
+        res = expr_frame_base(ev,&v);
+        break;
+    case EXPR_SHAPE_CFA:
+        res = expr_call_frame_cfa(ev,&v);
+        break;
+    default:
+        return expr_error(ev,0,"impossible expression shape");
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    v = (v + (Dwarf_Unsigned)offset) & ev->ev_mask;
+    return expr_add_piece(ev,DW_EXPR_LOC_MEMORY,v,0,
+        size_bits,offset_bits);
+}
+
+static int
+expr_eval_pieces(struct expr_eval_s *ev)
+{
+    Dwarf_Locdesc_c ld = ev->ev_locdesc;
+    Dwarf_Loc_Expr_Op ops = ld->ld_s;
+    Dwarf_Unsigned count = ld->ld_cents;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    while (i < count) {
+        Dwarf_Small shape = 0;
+        Dwarf_Unsigned value = 0;
+        Dwarf_Signed offset = 0;
+        Dwarf_Unsigned size_bits = 0;
+        Dwarf_Unsigned offset_bits = 0;
+
+        if (expr_piece_op(ops+i)) {
+            expr_piece_size(ops+i,&size_bits,&offset_bits);
+            res = expr_add_piece(ev,DW_EXPR_LOC_EMPTY,0,0,
+                size_bits,offset_bits);
+            ++i;
+        } else {
+            /*  expr_classify() checked the shape. */
+            (void)expr_simple_op(ev,ops+i,FALSE,&shape,&value,
+                &offset);
+            expr_piece_size(ops+i+1,&size_bits,&offset_bits);
+            res = expr_eval_simple(ev,shape,value,offset,
+                size_bits,offset_bits);
+            i += 2;
+        }
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    return DW_DLV_OK;
+}
+
+/*  Index of the operator at byte offset target,
+    or the operator count if target is the end
+    of the expression. */
+static int
+expr_branch_target(struct expr_eval_s *ev, Dwarf_Small atom,
+    Dwarf_Unsigned target, Dwarf_Unsigned *index)
+{
+    Dwarf_Locdesc_c ld = ev->ev_locdesc;
+    Dwarf_Loc_Expr_Op ops = ld->ld_s;
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = ld->ld_cents;
+
+    if (target == ld->ld_expr_length) {
+        *index = ld->ld_cents;
+        return DW_DLV_OK;
+    }
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (ops[mid].lr_offset == target) {
+            *index = mid;
+            return DW_DLV_OK;
+        }
+        if (ops[mid].lr_offset < target) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return expr_error(ev,atom,
+        "the branch target is not the start of an operator");
+}
+
+#define EXPR_NEED(n) \
+    do { \
+        if (sp < (n)) { \
+            return expr_error(ev,atom,"DWARF stack underflow"); \
+        } \
+    } while (0)
+
+#define EXPR_PUSH(v) \
+    do { \
+        if (sp >= EXPR_STACK_MAX) { \
+            return expr_error(ev,atom,"DWARF stack overflow"); \
+        } \
+        stack[sp] = (v) & ev->ev_mask; \
+        ++sp; \
+    } while (0)
+
+/*  The DWARF5 section 2.5 stack machine. */
+static int
+_dwarf_expr_eval_general(struct expr_eval_s *ev)
+{
+    Dwarf_Locdesc_c ld = ev->ev_locdesc;
+    Dwarf_Loc_Expr_Op ops = ld->ld_s;
+    Dwarf_Unsigned count = ld->ld_cents;
+    Dwarf_Unsigned stack[EXPR_STACK_MAX];
+    Dwarf_Unsigned sp = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned steps = 0;
+    /*  A location other than the memory address on the
+        top of the stack, set by DW_OP_reg*,
+        DW_OP_stack_value or DW_OP_implicit_value. */
+    Dwarf_Small loc_kind = DW_EXPR_LOC_MEMORY;
+    Dwarf_Unsigned loc_value = 0;
+    Dwarf_Ptr loc_block = 0;
+    /*  Any operators since the last piece? */
+    Dwarf_Bool pending = FALSE;
+    int res = 0;
+
+    while (i < count) {
+        Dwarf_Loc_Expr_Op op = ops + i;
+        Dwarf_Small atom = op->lr_atom;
+        Dwarf_Unsigned a = 0;
+        Dwarf_Unsigned b = 0;
+
+        if (++steps > EXPR_STEP_MAX) {
+            return expr_error(ev,atom,
+                "too many operators executed, "
+                "the expression loops");
+        }
+        if (loc_kind != DW_EXPR_LOC_MEMORY &&
+            !expr_piece_op(op) && atom != DW_OP_nop &&
+            atom != DW_OP_GNU_uninit) {
+            return expr_error(ev,atom,"operator follows a "
+                "register, stack value or implicit value "
+                "location");
+        }
+        if (atom >= DW_OP_lit0 && atom <= DW_OP_lit31) {
+            EXPR_PUSH((Dwarf_Unsigned)(atom - DW_OP_lit0));
+            pending = TRUE;
+            ++i;
+            continue;
+        }
+        if (atom >= DW_OP_reg0 && atom <= DW_OP_reg31) {
+            loc_kind = DW_EXPR_LOC_REGISTER;
+            loc_value = atom - DW_OP_reg0;
+            pending = TRUE;
+            ++i;
+            continue;
+        }
+        if (atom >= DW_OP_breg0 && atom <= DW_OP_breg31) {
+            res = expr_read_register(ev,
+                (Dwarf_Unsigned)(atom - DW_OP_breg0),&a);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            EXPR_PUSH(a + op->lr_number);
+            pending = TRUE;
+            ++i;
+            continue;
+        }
+        if (atom != DW_OP_nop && atom != DW_OP_GNU_uninit) {
+            pending = TRUE;
+        }
+        switch (atom) {
+        case DW_OP_addr:
+        case DW_OP_const1u: case DW_OP_const1s:
+        case DW_OP_const2u: case DW_OP_const2s:
+        case DW_OP_const4u: case DW_OP_const4s:
+        case DW_OP_const8u: case DW_OP_const8s:
+        case DW_OP_constu:  case DW_OP_consts:
+            EXPR_PUSH(op->lr_number);
+            break;
+        case DW_OP_addrx:
+        case DW_OP_GNU_addr_index:
+        case DW_OP_constx:
+        case DW_OP_GNU_const_index:
+            res = expr_debug_addr(ev,atom,op->lr_number,&a);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            EXPR_PUSH(a);
+            break;
+        case DW_OP_regx:
+            loc_kind = DW_EXPR_LOC_REGISTER;
+            loc_value = op->lr_number;
+            break;
+        case DW_OP_bregx:
+            res = expr_read_register(ev,op->lr_number,&a);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            EXPR_PUSH(a + op->lr_number2);
+            break;
+        case DW_OP_fbreg:
+            res = expr_frame_base(ev,&a);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            EXPR_PUSH(a + op->lr_number);
+            break;
+        case DW_OP_call_frame_cfa:
+            res = expr_call_frame_cfa(ev,&a);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            EXPR_PUSH(a);
+            break;
+        case DW_OP_push_object_address:
+            res = expr_object_address(ev,&a);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            EXPR_PUSH(a);
+            break;
+        case DW_OP_form_tls_address:
+        case DW_OP_GNU_push_tls_address:
+            EXPR_NEED(1);
+            res = expr_tls_address(ev,stack[sp-1],&a);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            stack[sp-1] = a & ev->ev_mask;
+            break;
+        case DW_OP_dup:
+            EXPR_NEED(1);
+            EXPR_PUSH(stack[sp-1]);
+            break;
+        case DW_OP_drop:
+            EXPR_NEED(1);
+            --sp;
+            break;
+        case DW_OP_over:
+            EXPR_NEED(2);
+            EXPR_PUSH(stack[sp-2]);
+            break;
+        case DW_OP_pick:
+            EXPR_NEED(op->lr_number+1);
+            EXPR_PUSH(stack[sp-1-op->lr_number]);
+            break;
+        case DW_OP_swap:
+            EXPR_NEED(2);
+            a = stack[sp-1];
+            stack[sp-1] = stack[sp-2];
+            stack[sp-2] = a;
+            break;
+        case DW_OP_rot:
+            /*  Top moves to third, second and third
+                move up. */
+            EXPR_NEED(3);
+            a = stack[sp-1];
+            stack[sp-1] = stack[sp-2];
+            stack[sp-2] = stack[sp-3];
+            stack[sp-3] = a;
+            break;
+        case DW_OP_deref:
+        case DW_OP_deref_size:
+            EXPR_NEED(1);
+            b = ev->ev_address_size;
+            if (atom == DW_OP_deref_size) {
+                b = op->lr_number;
+            }
+            if (b < 1 || b > sizeof(Dwarf_Unsigned)) {
+                return expr_error(ev,atom,
+                    "the size to read is not 1 to 8 bytes");
+            }
+            res = expr_read_memory(ev,stack[sp-1],b,&a);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            if (b < sizeof(Dwarf_Unsigned)) {
+                a &= ((Dwarf_Unsigned)1 << (b*8)) - 1;
+            }
+            stack[sp-1] = a & ev->ev_mask;
+            break;
+        case DW_OP_abs:
+            EXPR_NEED(1);
+            if (expr_signed(ev,stack[sp-1]) < 0) {
+                stack[sp-1] = (0 - stack[sp-1]) & ev->ev_mask;
+            }
+            break;
+        case DW_OP_neg:
+            EXPR_NEED(1);
+            stack[sp-1] = (0 - stack[sp-1]) & ev->ev_mask;
+            break;
+        case DW_OP_not:
+            EXPR_NEED(1);
+            stack[sp-1] = ~stack[sp-1] & ev->ev_mask;
+            break;
+        case DW_OP_plus_uconst:
+            EXPR_NEED(1);
+            stack[sp-1] = (stack[sp-1] + op->lr_number) &
+                ev->ev_mask;
+            break;
+        case DW_OP_and: case DW_OP_or: case DW_OP_xor:
+        case DW_OP_plus: case DW_OP_minus: case DW_OP_mul:
+        case DW_OP_div: case DW_OP_mod:
+        case DW_OP_shl: case DW_OP_shr: case DW_OP_shra:
+        case DW_OP_eq: case DW_OP_ne: case DW_OP_lt:
+        case DW_OP_le: case DW_OP_gt: case DW_OP_ge: {
+            Dwarf_Signed sa = 0;
+            Dwarf_Signed sb = 0;
+
+            /*  b is the top of the stack, a the entry below. */
+            EXPR_NEED(2);
+            b = stack[sp-1];
+            a = stack[sp-2];
+            sa = expr_signed(ev,a);
+            sb = expr_signed(ev,b);
+            --sp;
+            switch (atom) {
+            case DW_OP_and:   a &= b; break;
+            case DW_OP_or:    a |= b; break;
+            case DW_OP_xor:   a ^= b; break;
+            case DW_OP_plus:  a += b; break;
+            case DW_OP_minus: a -= b; break;
+            case DW_OP_mul:   a *= b; break;
+            case DW_OP_div:
+                if (!b) {
+                    return expr_error(ev,atom,"division by zero");
+                }
+                if (sb == -1) {
+                    /*  Avoid the overflow trap of
+                        the most negative value / -1. */
+                    a = 0 - a;
+                } else {
+                    a = (Dwarf_Unsigned)(sa / sb);
+                }
+                break;
+            case DW_OP_mod:
+                if (!b) {
+                    return expr_error(ev,atom,"division by zero");
+                }
+                a %= b;
+                break;
+            case DW_OP_shl:
+                a = (b >= 64)? 0 : a << b;
+                break;
+            case DW_OP_shr:
+                a = (b >= 64)? 0 : a >> b;
+                break;
+            case DW_OP_shra:
+                if (b >= 64) {
+                    a = (sa < 0)? ~(Dwarf_Unsigned)0 : 0;
+                } else if (sa < 0) {
+                    a = ~(~(Dwarf_Unsigned)sa >> b);
+                } else {
+                    a = (Dwarf_Unsigned)sa >> b;
+                }
+                break;
+            case DW_OP_eq: a = (sa == sb); break;
+            case DW_OP_ne: a = (sa != sb); break;
+            case DW_OP_lt: a = (sa <  sb); break;
+            case DW_OP_le: a = (sa <= sb); break;
+            case DW_OP_gt: a = (sa >  sb); break;
+            case DW_OP_ge: a = (sa >= sb); break;
+            default: break;
+            }
+            stack[sp-1] = a & ev->ev_mask;
+            }
+            break;
+        case DW_OP_skip:
+        case DW_OP_bra:
+            if (atom == DW_OP_bra) {
+                EXPR_NEED(1);
+                --sp;
+                if (!stack[sp]) {
+                    break;
+                }
+            }
+            /*  The 2 byte operand is relative to the
+                end of this operator. */
+            res = expr_branch_target(ev,atom,
+                op->lr_offset + 3 + op->lr_number,&i);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            continue;
+        case DW_OP_nop:
+        case DW_OP_GNU_uninit:
+            break;
+        case DW_OP_stack_value:
+            EXPR_NEED(1);
+            --sp;
+            loc_kind = DW_EXPR_LOC_VALUE;
+            loc_value = stack[sp];
+            break;
+        case DW_OP_implicit_value:
+            loc_kind = DW_EXPR_LOC_IMPLICIT;
+            loc_value = op->lr_number;
+            loc_block = (Dwarf_Ptr)(uintptr_t)op->lr_number2;
+            break;
+        case DW_OP_piece:
+        case DW_OP_bit_piece: {
+            Dwarf_Unsigned size_bits = 0;
+            Dwarf_Unsigned offset_bits = 0;
+
+            expr_piece_size(op,&size_bits,&offset_bits);
+            if (loc_kind != DW_EXPR_LOC_MEMORY) {
+                res = expr_add_piece(ev,loc_kind,loc_value,
+                    loc_block,size_bits,offset_bits);
+            } else if (sp) {
+                --sp;
+                res = expr_add_piece(ev,DW_EXPR_LOC_MEMORY,
+                    stack[sp],0,size_bits,offset_bits);
+            } else {
+                res = expr_add_piece(ev,DW_EXPR_LOC_EMPTY,0,0,
+                    size_bits,offset_bits);
+            }
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            loc_kind = DW_EXPR_LOC_MEMORY;
+            loc_value = 0;
+            loc_block = 0;
+            pending = FALSE;
+            }
+            break;
+        default:
+            return expr_error(ev,atom,"unsupported operator");
+        }
+        ++i;
+    }
+    if (ev->ev_piece_count) {
+        if (pending) {
+            return expr_error(ev,0,
+                "operators follow the last piece");
+        }
+        return DW_DLV_OK;
+    }
+    if (loc_kind != DW_EXPR_LOC_MEMORY) {
+        return expr_add_piece(ev,loc_kind,loc_value,
+            loc_block,0,0);
+    }
+    if (!sp) {
+        return expr_error(ev,0,
+            "the DWARF stack is empty at the end");
+    }
+    return expr_add_piece(ev,DW_EXPR_LOC_MEMORY,
+        stack[sp-1],0,0,0);
+}
+
+int
+dwarf_expr_evaluate(Dwarf_Locdesc_c locdesc,
+    const Dwarf_Expr_Callbacks *callbacks,
+    Dwarf_Expr_Piece *pieces,
+    Dwarf_Unsigned    pieces_max,
+    Dwarf_Unsigned   *piece_count,
+    Dwarf_Error      *error)
+{
+    struct expr_eval_s ev;
+    Dwarf_Loc_Head_c head = 0;
+    int res = 0;
+
+    if (!locdesc || !locdesc->ld_loclist_head) {
+        _dwarf_error_string(NULL, error,DW_DLE_DBG_NULL,
+            "DW_DLE_DBG_NULL: "
+            "Dwarf_Locdesc_c NULL or without its head "
+            "in calling dwarf_expr_evaluate()");
+        return DW_DLV_ERROR;
+    }
+    head = locdesc->ld_loclist_head;
+    memset(&ev,0,sizeof(ev));
+    ev.ev_dbg = head->ll_dbg;
+    ev.ev_error = error;
+    if (!callbacks || !pieces || !pieces_max || !piece_count) {
+        _dwarf_error_string(ev.ev_dbg,error,
+            DW_DLE_INVALID_NULL_ARGUMENT,
+            "DW_DLE_INVALID_NULL_ARGUMENT: "
+            "dwarf_expr_evaluate() needs callbacks, "
+            "a pieces array and a piece count pointer");
+        return DW_DLV_ERROR;
+    }
+    ev.ev_locdesc = locdesc;
+    ev.ev_context = head->ll_context;
+    ev.ev_cb = callbacks;
+    ev.ev_address_size = head->ll_address_size;
+    if (!ev.ev_address_size ||
+        ev.ev_address_size > sizeof(Dwarf_Unsigned)) {
+        ev.ev_address_size = sizeof(Dwarf_Unsigned);
+    }
+    ev.ev_mask = ~(Dwarf_Unsigned)0;
+    if (ev.ev_address_size < sizeof(Dwarf_Unsigned)) {
+        ev.ev_mask = ((Dwarf_Unsigned)1 <<
+            (ev.ev_address_size*8)) - 1;
+    }
+    ev.ev_pieces = pieces;
+    ev.ev_pieces_max = pieces_max;
+
+    if (locdesc->ld_eval_shape == EXPR_SHAPE_UNKNOWN) {
+        expr_classify(&ev);
+    }
+    switch (locdesc->ld_eval_shape) {
+    case EXPR_SHAPE_EMPTY:
+        res = expr_add_piece(&ev,DW_EXPR_LOC_EMPTY,0,0,0,0);
+        break;
+    case EXPR_SHAPE_VALUE:
+        res = expr_add_piece(&ev,DW_EXPR_LOC_VALUE,
+            locdesc->ld_eval_value,0,0,0);
+        break;
+    case EXPR_SHAPE_PIECES:
+        res = expr_eval_pieces(&ev);
+        break;
+    case EXPR_SHAPE_GENERAL:
+        res = _dwarf_expr_eval_general(&ev);
+        break;
+    default:
+        res = expr_eval_simple(&ev,locdesc->ld_eval_shape,
+            locdesc->ld_eval_value,locdesc->ld_eval_offset,0,0);
+        break;
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    *piece_count = ev.ev_piece_count;
+    return DW_DLV_OK;
+}
@@ -446,6 +446,7 @@ _dwarf_exec_frame_instr(Dwarf_Bool make_instr,
 
     Dwarf_Unsigned i = 0;
 
+    DW_PERF_ADD(dbg,ps_frame_instr_executions,1);
     /*  Initialize first row from associated Cie.
         Using temp regs explicitly */
 
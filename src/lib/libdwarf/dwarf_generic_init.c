@@ -78,6 +78,20 @@ dwarf_init_path_dl(path true_path and globals, dbg1
 #include "dwarf_error.h"
 #include "dwarf_object_detector.h"
 
+static int init_path_common(const char *path,
+    char            * true_path_out_buffer,
+    unsigned        true_path_bufferlen,
+    unsigned        groupnumber,
+    unsigned        universalnumber,
+    const Dwarf_Allocator *allocator,
+    Dwarf_Handler   errhand,
+    Dwarf_Ptr       errarg,
+    Dwarf_Debug     * ret_dbg,
+    char            ** dl_path_array,
+    unsigned int    dl_path_count,
+    unsigned char   * path_source,
+    Dwarf_Error     * error);
+
 static int
 set_global_paths_init(Dwarf_Debug dbg, Dwarf_Error* error)
 {
@@ -221,6 +235,63 @@ dwarf_init_path_dl_a(const char *path,
     unsigned char   * path_source,
     Dwarf_Error     * error)
 {
+    return init_path_common(path,
+        true_path_out_buffer,true_path_bufferlen,
+        groupnumber,universalnumber,
+        0,errhand,errarg,ret_dbg,
+        dl_path_array,dl_path_count,path_source,
+        error);
+}
+
+/* New October 2026. */
+int
+dwarf_init_path_alloc(const char *path,
+    char            * true_path_out_buffer,
+    unsigned        true_path_bufferlen,
+    unsigned        groupnumber,
+    unsigned        universalnumber,
+    const Dwarf_Allocator *allocator,
+    Dwarf_Handler   errhand,
+    Dwarf_Ptr       errarg,
+    Dwarf_Debug     * ret_dbg,
+    Dwarf_Error     * error)
+{
+    if (allocator &&
+        (!allocator->da_malloc != !allocator->da_free)) {
+        if (ret_dbg) {
+            *ret_dbg = 0;
+        }
+        DWARF_DBG_ERROR(NULL,DW_DLE_ALLOCATOR_ERROR,
+            DW_DLV_ERROR);
+    }
+    return init_path_common(path,
+        true_path_out_buffer,true_path_bufferlen,
+        groupnumber,universalnumber,
+        allocator,errhand,errarg,ret_dbg,
+        0,0,0,
+        error);
+}
+
+/*  The object reader and the Dwarf_Debug both get
+    the allocator chosen here, read once, so a
+    concurrent dwarf_set_allocator() cannot give
+    them different ones. */
+static int
+init_path_common(const char *path,
+    char            * true_path_out_buffer,
+    unsigned        true_path_bufferlen,
+    unsigned        groupnumber,
+    unsigned        universalnumber,
+    const Dwarf_Allocator *allocator,
+    Dwarf_Handler   errhand,
+    Dwarf_Ptr       errarg,
+    Dwarf_Debug     * ret_dbg,
+    char            ** dl_path_array,
+    unsigned int    dl_path_count,
+    unsigned char   * path_source,
+    Dwarf_Error     * error)
+{
+    Dwarf_Allocator alloc;
     unsigned       ftype = 0;
     unsigned       endian = 0;
     unsigned       offsetsize = 0;
@@ -315,12 +386,13 @@ dwarf_init_path_dl_a(const char *path,
         DWARF_DBG_ERROR(NULL, DW_DLE_FILE_UNAVAILABLE,
             DW_DLV_ERROR);
     }
+    _dwarf_choose_allocator(allocator,&alloc);
     switch(ftype) {
     case DW_FTYPE_ELF: {
         res = _dwarf_elf_nlsetup(fd,
             file_path,
             ftype,endian,offsetsize,filesize,
-            groupnumber,errhand,errarg,&dbg,error);
+            groupnumber,errhand,errarg,&alloc,&dbg,error);
         if (res != DW_DLV_OK) {
             _dwarf_closer(fd);
             return res;
@@ -337,7 +409,7 @@ dwarf_init_path_dl_a(const char *path,
             file_path,
             universalnumber,
             ftype,endian,offsetsize,filesize,
-            groupnumber,errhand,errarg,&dbg,error);
+            groupnumber,errhand,errarg,&alloc,&dbg,error);
         if (res != DW_DLV_OK) {
             _dwarf_closer(fd);
             return res;
@@ -352,7 +424,7 @@ dwarf_init_path_dl_a(const char *path,
         res = _dwarf_pe_setup(fd,
             file_path,
             ftype,endian,offsetsize,filesize,
-            groupnumber,errhand,errarg,&dbg,error);
+            groupnumber,errhand,errarg,&alloc,&dbg,error);
         if (res != DW_DLV_OK) {
             _dwarf_closer(fd);
             return res;
@@ -392,6 +464,7 @@ dwarf_init_b(int fd,
     Dwarf_Unsigned   filesize = 0;
     int res = 0;
     int errcode = 0;
+    Dwarf_Allocator alloc;
 
     if (!ret_dbg) {
         DWARF_DBG_ERROR(NULL,DW_DLE_DWARF_INIT_DBG_NULL,DW_DLV_ERROR);
@@ -408,13 +481,14 @@ dwarf_init_b(int fd,
         /* This macro does a return. */
         DWARF_DBG_ERROR(NULL, DW_DLE_FILE_WRONG_TYPE, DW_DLV_ERROR);
     }
+    _dwarf_choose_allocator(0,&alloc);
     switch(ftype) {
     case DW_FTYPE_ELF: {
         int res2 = 0;
 
         res2 = _dwarf_elf_nlsetup(fd,"",
             ftype,endian,offsetsize,filesize,
-            group_number,errhand,errarg,ret_dbg,error);
+            group_number,errhand,errarg,&alloc,ret_dbg,error);
         if (res2 != DW_DLV_OK) {
             return res2;
         }
@@ -428,7 +502,7 @@ dwarf_init_b(int fd,
         resm = _dwarf_macho_setup(fd,"",
             universalnumber,
             ftype,endian,offsetsize,filesize,
-            group_number,errhand,errarg,ret_dbg,error);
+            group_number,errhand,errarg,&alloc,ret_dbg,error);
         if (resm != DW_DLV_OK) {
             return resm;
         }
@@ -442,7 +516,7 @@ dwarf_init_b(int fd,
         resp = _dwarf_pe_setup(fd,
             "",
             ftype,endian,offsetsize,filesize,
-            group_number,errhand,errarg,ret_dbg,error);
+            group_number,errhand,errarg,&alloc,ret_dbg,error);
         if (resp != DW_DLV_OK) {
             return resp;
         }
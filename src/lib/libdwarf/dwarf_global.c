@@ -31,7 +31,7 @@
 #include <config.h>
 #include <stdio.h>
 
-#include <string.h> /* strlen() */
+#include <string.h> /* memset() strlen() */
 #if defined(_WIN32) && defined(HAVE_STDAFX_H)
 #include "stdafx.h"
 #endif /* HAVE_STDAFX_H */
@@ -141,9 +141,24 @@ dealloc_globals_chain(Dwarf_Debug dbg,
     }
 }
 
+/*  For dwarf_iterate_globals_by_type().
+    When one of these is passed to the section readers
+    each entry is handed to the callback as it is read
+    instead of being allocated and added to a chain. */
+struct Dwarf_Global_Stream_s {
+    dwarf_global_callback_func gs_callback;
+    void                      *gs_user_data;
+    Dwarf_Unsigned             gs_count;
+    Dwarf_Bool                 gs_stopped;
+};
+
 /*  INVARIANTS:
     1) on error does not leak Dwarf_Global
     2) glname is not malloc space. Never free.
+    With a non-null stream nothing is allocated,
+    pubnames_context_on_list is left unchanged (the caller
+    still owns the context) and DW_DLV_NO_ENTRY
+    means the callback asked to stop.
 */
 static int
 _dwarf_make_global_add_to_chain(Dwarf_Debug dbg,
@@ -155,11 +170,31 @@ _dwarf_make_global_add_to_chain(Dwarf_Debug dbg,
     Dwarf_Unsigned       global_DLA_code,
     Dwarf_Chain        **plast_chain,
     Dwarf_Half           tag,
+    struct Dwarf_Global_Stream_s *stream,
     Dwarf_Error         *error)
 {
     Dwarf_Chain  curr_chain = 0;
     Dwarf_Global global = 0;
 
+    if (stream) {
+        struct Dwarf_Global_s sglobal;
+        int cres = 0;
+
+        memset(&sglobal,0,sizeof(sglobal));
+        sglobal.gl_context = pubnames_context;
+        sglobal.gl_alloc_type = (Dwarf_Small)global_DLA_code;
+        sglobal.gl_named_die_offset_within_cu = die_offset_in_cu;
+        sglobal.gl_name = glname;
+        sglobal.gl_tag = tag;
+        (*global_count)++;
+        stream->gs_count++;
+        cres = stream->gs_callback(&sglobal,stream->gs_user_data);
+        if (cres != DW_DLV_OK) {
+            stream->gs_stopped = TRUE;
+            return DW_DLV_NO_ENTRY;
+        }
+        return DW_DLV_OK;
+    }
     global = (Dwarf_Global)
         _dwarf_get_alloc(dbg, (Dwarf_Small)global_DLA_code, 1);
     if (!global) {
@@ -278,7 +313,8 @@ _dwarf_internal_get_debug_names_globals(Dwarf_Debug dbg,
     Dwarf_Signed  *total_count,
     Dwarf_Error   *error,
     int            context_DLA_code,
-    int            global_DLA_code)
+    int            global_DLA_code,
+    struct Dwarf_Global_Stream_s *stream)
 {
     int                  res = 0;
     Dwarf_Off            cur_offset = 0;
@@ -286,6 +322,7 @@ _dwarf_internal_get_debug_names_globals(Dwarf_Debug dbg,
     Dwarf_Dnames_Head    dn_head = 0;
     Dwarf_Bool           pubnames_context_on_list = FALSE;
     Dwarf_Global_Context pubnames_context = 0;
+    struct Dwarf_Global_Context_s stream_context;
 
     res = _dwarf_load_section(dbg, &dbg->de_debug_names,error);
     if (res != DW_DLV_OK) {
@@ -500,9 +537,18 @@ _dwarf_internal_get_debug_names_globals(Dwarf_Debug dbg,
                 (pubnames_context->pu_offset_of_cu_header !=
                 cu_header_global_offset)) {
                 pubnames_context_on_list = FALSE;
-                pubnames_context = (Dwarf_Global_Context)
-                    _dwarf_get_alloc(dbg,
-                        (Dwarf_Small)context_DLA_code, 1);
+                if (stream) {
+                    /*  Only needed while the callback runs,
+                        and never passed to dwarf_dealloc(). */
+                    memset(&stream_context,0,
+                        sizeof(stream_context));
+                    pubnames_context = &stream_context;
+                    pubnames_context_on_list = TRUE;
+                } else {
+                    pubnames_context = (Dwarf_Global_Context)
+                        _dwarf_get_alloc(dbg,
+                            (Dwarf_Small)context_DLA_code, 1);
+                }
                 if (!pubnames_context) {
                     dwarf_dealloc_dnames(dn_head);
                     _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
@@ -532,8 +578,11 @@ _dwarf_internal_get_debug_names_globals(Dwarf_Debug dbg,
                 global_DLA_code,
                 pplast_chain,
                 abbrev_tag,
+                stream,
                 error);
-            if (res == DW_DLV_ERROR) {
+            if (res != DW_DLV_OK) {
+                /*  DW_DLV_NO_ENTRY: the stream callback
+                    asked to stop. */
                 if (!pubnames_context_on_list) {
                     dwarf_dealloc(dbg,pubnames_context,
                         context_DLA_code);
@@ -620,7 +669,8 @@ _dwarf_internal_get_pubnames_like(Dwarf_Debug dbg,
     Dwarf_Signed * return_count,
     Dwarf_Error * error,
     int length_err_num,
-    int version_err_num)
+    int version_err_num,
+    struct Dwarf_Global_Stream_s *stream)
 {
     Dwarf_Small   *pubnames_like_ptr = 0;
     /*  Section offset to the above pointer. */
@@ -932,6 +982,7 @@ _dwarf_internal_get_pubnames_like(Dwarf_Debug dbg,
                     global_DLA_code,
                     out_pplast_chain,
                     0,
+                    stream,
                     error);
                 if (res != DW_DLV_OK) {
                     dealloc_globals_chain(dbg,*out_phead_chain);
@@ -990,6 +1041,7 @@ _dwarf_internal_get_pubnames_like(Dwarf_Debug dbg,
                 global_DLA_code,
                 out_pplast_chain,
                 0,
+                stream,
                 error);
             if (res != DW_DLV_OK) {
                 dealloc_globals_chain(dbg,*out_phead_chain);
@@ -1084,6 +1136,12 @@ _dwarf_internal_get_pubnames_like(Dwarf_Debug dbg,
             }
         }
 #endif
+        if (!pubnames_context_on_list) {
+            /*  Streaming: the callback has seen every
+                entry using this context. */
+            dwarf_dealloc(dbg,pubnames_context,context_DLA_code);
+            pubnames_context = 0;
+        }
         pubnames_like_ptr = pubnames_ptr_past_end_cu;
     } while (pubnames_like_ptr < section_end_ptr);
     *return_count = global_count;
@@ -1118,29 +1176,25 @@ static const char * secna[] =
 ".debug_weaknames",
 };
 
-/*  New in 0.6.0, unifies all the access routines
-    for the sections like .debug_pubtypes.
-*/
-int
-dwarf_globals_by_type(Dwarf_Debug dbg,
+/*  Reads the requested section(s) and either builds
+    the chain (stream zero) or hands each entry to
+    the stream callback.  Once the stream callback
+    asks to stop nothing more is read. */
+static int
+_dwarf_internal_globals_by_type(Dwarf_Debug dbg,
     int            requested_section,
-    Dwarf_Global **contents,
+    const char    *funcname,
+    Dwarf_Chain   *phead_chain,
     Dwarf_Signed  *ret_count,
+    struct Dwarf_Global_Stream_s *stream,
     Dwarf_Error   *error)
 {
     struct Dwarf_Section_s *section = 0;
-    Dwarf_Chain  head_chain = 0;
-    Dwarf_Chain *plast_chain = &head_chain;
+    Dwarf_Chain *plast_chain = phead_chain;
     Dwarf_Bool   have_base_sec = FALSE;
     Dwarf_Bool   have_second_sec = FALSE;
     int          res = 0;
 
-    /*  Zero caller's fields in case caller
-        failed to do so. Bad input here causes
-        segfault!  */
-    *contents = 0;
-    *ret_count = 0;
-    CHECK_DBG(dbg,error,"dwarf_globals_by_type()");
     switch(requested_section){
     case  DW_GL_GLOBALS:
         section = &dbg->de_debug_pubnames;
@@ -1169,8 +1223,9 @@ dwarf_globals_by_type(Dwarf_Debug dbg,
         dwarfstring_append_printf_u(&m,
             "ERROR DW_DLE_GLOBAL_NULL: Passed in Dwarf_Global "
             "requested section "
-            "%u which is unknown to dwarf_globals_by_type().",
+            "%u which is unknown to ",
             requested_section);
+        dwarfstring_append(&m,(char *)funcname);
         _dwarf_error_string(dbg, error, DW_DLE_GLOBAL_NULL,
             dwarfstring_string(&m));
         dwarfstring_destructor(&m);
@@ -1191,16 +1246,19 @@ dwarf_globals_by_type(Dwarf_Debug dbg,
             secna[requested_section],
             section->dss_data,
             section->dss_size,
-            &head_chain,
+            phead_chain,
             &plast_chain,
             ret_count,
             error,
             err3[requested_section],
-            err4[requested_section]);
+            err4[requested_section],
+            stream);
         if (res == DW_DLV_ERROR) {
-            dealloc_globals_chain(dbg,head_chain);
             return res;
         }
+        if (stream && stream->gs_stopped) {
+            return DW_DLV_OK;
+        }
     }
     if (0 == requested_section) {
         res = _dwarf_load_section(dbg, &dbg->de_debug_names,error);
@@ -1216,13 +1274,40 @@ dwarf_globals_by_type(Dwarf_Debug dbg,
             ret_count,
             error,
             DW_DLA_GLOBAL_CONTEXT,
-            DW_DLA_GLOBAL);
+            DW_DLA_GLOBAL,
+            stream);
         if (res == DW_DLV_ERROR) {
-            dealloc_globals_chain(dbg,head_chain);
-            head_chain = 0;
             return res;
         }
     }
+    return DW_DLV_OK;
+}
+
+/*  New in 0.6.0, unifies all the access routines
+    for the sections like .debug_pubtypes.
+*/
+int
+dwarf_globals_by_type(Dwarf_Debug dbg,
+    int            requested_section,
+    Dwarf_Global **contents,
+    Dwarf_Signed  *ret_count,
+    Dwarf_Error   *error)
+{
+    Dwarf_Chain  head_chain = 0;
+    int          res = 0;
+
+    /*  Zero caller's fields in case caller
+        failed to do so. Bad input here causes
+        segfault!  */
+    *contents = 0;
+    *ret_count = 0;
+    CHECK_DBG(dbg,error,"dwarf_globals_by_type()");
+    res = _dwarf_internal_globals_by_type(dbg,requested_section,
+        "dwarf_globals_by_type().",&head_chain,ret_count,0,error);
+    if (res == DW_DLV_ERROR) {
+        dealloc_globals_chain(dbg,head_chain);
+        return res;
+    }
     res = _dwarf_chain_to_array(dbg,head_chain,
         *ret_count, contents, error);
     if (res == DW_DLV_ERROR) {
@@ -1235,6 +1320,53 @@ dwarf_globals_by_type(Dwarf_Debug dbg,
     return DW_DLV_OK;
 }
 
+/*  Like dwarf_globals_by_type() but nothing is
+    accumulated: each entry is passed to the callback
+    as it is read from the section and the callback
+    can end the iteration early.
+*/
+int
+dwarf_iterate_globals_by_type(Dwarf_Debug dbg,
+    int            requested_section,
+    dwarf_global_callback_func callback,
+    void          *user_data,
+    Dwarf_Unsigned *ret_count,
+    Dwarf_Error   *error)
+{
+    struct Dwarf_Global_Stream_s stream;
+    Dwarf_Chain  head_chain = 0;
+    Dwarf_Signed count = 0;
+    int          res = 0;
+
+    if (ret_count) {
+        *ret_count = 0;
+    }
+    CHECK_DBG(dbg,error,"dwarf_iterate_globals_by_type()");
+    if (!callback) {
+        _dwarf_error_string(dbg, error, DW_DLE_GLOBAL_NULL,
+            "DW_DLE_GLOBAL_NULL: "
+            "dwarf_iterate_globals_by_type() called "
+            "with a null callback");
+        return DW_DLV_ERROR;
+    }
+    memset(&stream,0,sizeof(stream));
+    stream.gs_callback = callback;
+    stream.gs_user_data = user_data;
+    res = _dwarf_internal_globals_by_type(dbg,requested_section,
+        "dwarf_iterate_globals_by_type().",&head_chain,&count,
+        &stream,error);
+    if (ret_count) {
+        *ret_count = stream.gs_count;
+    }
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    if (!stream.gs_count) {
+        return DW_DLV_NO_ENTRY;
+    }
+    return DW_DLV_OK;
+}
+
 int
 dwarf_get_globals(Dwarf_Debug dbg,
     Dwarf_Global **ret_globals,
@@ -373,7 +373,8 @@ insert_sht_list_in_group_map(Dwarf_Debug dbg,
     res = _dwarf_load_section(dbg,&secdata,error);
     if (res != DW_DLV_OK) {
         if (secdata.dss_data_was_malloc) {
-            free(secdata.dss_data);
+            _dwarf_allocator_free(&dbg->de_allocator,
+                secdata.dss_data);
             secdata.dss_data = 0;
         }
         return res;
@@ -384,7 +385,8 @@ insert_sht_list_in_group_map(Dwarf_Debug dbg,
     }
     if (doas->as_entrysize != 4) {
         if (secdata.dss_data_was_malloc) {
-            free(secdata.dss_data);
+            _dwarf_allocator_free(&dbg->de_allocator,
+                secdata.dss_data);
             secdata.dss_data = 0;
         }
         _dwarf_error(dbg,error,DW_DLE_GROUP_INTERNAL_ERROR);
@@ -414,7 +416,8 @@ insert_sht_list_in_group_map(Dwarf_Debug dbg,
             /* Duplicates the check in READ_UNALIGNED_CK
                 so we can free allocated memory bere. */
             if (secdata.dss_data_was_malloc) {
-                free(secdata.dss_data);
+                _dwarf_allocator_free(&dbg->de_allocator,
+                    secdata.dss_data);
                 secdata.dss_data = 0;
             }
             _dwarf_error(dbg,error,DW_DLE_GROUP_INTERNAL_ERROR);
@@ -428,7 +431,8 @@ insert_sht_list_in_group_map(Dwarf_Debug dbg,
         if (fval != 1 && fval != 0x1000000) {
             /*  Could be corrupted elf object. */
             if (secdata.dss_data_was_malloc) {
-                free(secdata.dss_data);
+                _dwarf_allocator_free(&dbg->de_allocator,
+                    secdata.dss_data);
                 secdata.dss_data = 0;
             }
             _dwarf_error(dbg,error,DW_DLE_GROUP_INTERNAL_ERROR);
@@ -443,7 +447,8 @@ insert_sht_list_in_group_map(Dwarf_Debug dbg,
                 /* Duplicates the check in READ_UNALIGNED_CK
                     so we can free allocated memory bere. */
                 if (secdata.dss_data_was_malloc) {
-                    free(secdata.dss_data);
+                    _dwarf_allocator_free(&dbg->de_allocator,
+                        secdata.dss_data);
                     secdata.dss_data = 0;
                 }
                 _dwarf_error(dbg,error,DW_DLE_GROUP_INTERNAL_ERROR);
@@ -463,7 +468,8 @@ insert_sht_list_in_group_map(Dwarf_Debug dbg,
                     DWARF_32BIT_SIZE);
                 if (valr > section_count) {
                     if (secdata.dss_data_was_malloc) {
-                        free(secdata.dss_data);
+                        _dwarf_allocator_free(&dbg->de_allocator,
+                            secdata.dss_data);
                         secdata.dss_data = 0;
                     }
                     _dwarf_error(dbg,error,
@@ -492,7 +498,8 @@ insert_sht_list_in_group_map(Dwarf_Debug dbg,
                 }
                 if (resx == DW_DLV_ERROR){
                     if (secdata.dss_data_was_malloc) {
-                        free(secdata.dss_data);
+                        _dwarf_allocator_free(&dbg->de_allocator,
+                            secdata.dss_data);
                         secdata.dss_data = 0;
                     }
                     _dwarf_error(dbg,error,err);
@@ -511,7 +518,8 @@ insert_sht_list_in_group_map(Dwarf_Debug dbg,
                     error);
                 if (res != DW_DLV_OK) {
                     if (secdata.dss_data_was_malloc) {
-                        free(secdata.dss_data);
+                        _dwarf_allocator_free(&dbg->de_allocator,
+                            secdata.dss_data);
                         secdata.dss_data = 0;
                     }
                     return res;
@@ -520,7 +528,8 @@ insert_sht_list_in_group_map(Dwarf_Debug dbg,
         }
     }
     if (secdata.dss_data_was_malloc) {
-        free(secdata.dss_data);
+        _dwarf_allocator_free(&dbg->de_allocator,
+            secdata.dss_data);
         secdata.dss_data = 0;
     }
     return DW_DLV_OK;
@@ -1016,6 +1025,22 @@ dwarf_object_init_b(Dwarf_Obj_Access_Interface_a* obj,
     unsigned groupnumber,
     Dwarf_Debug* ret_dbg,
     Dwarf_Error* error)
+{
+    return dwarf_object_init_alloc(obj,0,errhand,errarg,
+        groupnumber,ret_dbg,error);
+}
+
+/*  As dwarf_object_init_b() but the Dwarf_Debug uses
+    *allocator (if non-NULL) rather than the
+    dwarf_set_allocator() default. */
+int
+dwarf_object_init_alloc(Dwarf_Obj_Access_Interface_a* obj,
+    const Dwarf_Allocator *allocator,
+    Dwarf_Handler errhand,
+    Dwarf_Ptr errarg,
+    unsigned groupnumber,
+    Dwarf_Debug* ret_dbg,
+    Dwarf_Error* error)
 {
     Dwarf_Debug dbg = 0;
     int setup_result = DW_DLV_OK;
@@ -1028,12 +1053,17 @@ dwarf_object_init_b(Dwarf_Obj_Access_Interface_a* obj,
     /*  Non-null *ret_dbg will cause problems dealing with
         DW_DLV_ERROR */
     *ret_dbg = 0;
+    if (allocator &&
+        (!allocator->da_malloc != !allocator->da_free)) {
+        DWARF_DBG_ERROR(NULL,DW_DLE_ALLOCATOR_ERROR,
+            DW_DLV_ERROR);
+    }
     filesize = obj->ai_methods->om_get_filesize(obj->ai_object);
     /*  Initializes  Dwarf_Debug struct and returns
         a pointer to that empty record.
         Filesize is to set up a sensible default hash tree
         size. */
-    dbg = _dwarf_get_debug(filesize);
+    dbg = _dwarf_get_debug(filesize,allocator);
     if (IS_INVALID_DBG(dbg)) {
         DWARF_DBG_ERROR(dbg, DW_DLE_DBG_ALLOC, DW_DLV_ERROR);
     }
@@ -1354,7 +1384,7 @@ do_decompress(Dwarf_Debug dbg,
         return DW_DLV_ERROR;
     }
     destlen = uncompressed_len;
-    dest = malloc(destlen);
+    dest = _dwarf_allocator_malloc(&dbg->de_allocator,destlen);
     if (!dest) {
         _dwarf_error_string(dbg, error,
             DW_DLE_ALLOC_FAIL,
@@ -1370,13 +1400,13 @@ do_decompress(Dwarf_Debug dbg,
 
         res = uncompress(dest,&dlen,src,srclen);
         if (res == Z_BUF_ERROR) {
-            free(dest);
+            _dwarf_allocator_free(&dbg->de_allocator,dest);
             DWARF_DBG_ERROR(dbg, DW_DLE_ZLIB_BUF_ERROR, DW_DLV_ERROR);
         } else if (res == Z_MEM_ERROR) {
-            free(dest);
+            _dwarf_allocator_free(&dbg->de_allocator,dest);
             DWARF_DBG_ERROR(dbg, DW_DLE_ALLOC_FAIL, DW_DLV_ERROR);
         } else if (res != Z_OK) {
-            free(dest);
+            _dwarf_allocator_free(&dbg->de_allocator,dest);
             /* Probably Z_DATA_ERROR. */
             DWARF_DBG_ERROR(dbg, DW_DLE_ZLIB_DATA_ERROR,
                 DW_DLV_ERROR);
@@ -1386,7 +1416,7 @@ do_decompress(Dwarf_Debug dbg,
         size_t zsize =
             ZSTD_decompress(dest,destlen,src,srclen);
         if (zsize != destlen) {
-            free(dest);
+            _dwarf_allocator_free(&dbg->de_allocator,dest);
             _dwarf_error_string(dbg, error,
                 DW_DLE_ZLIB_DATA_ERROR,
                 "DW_DLE_ZLIB_DATA_ERROR"
@@ -1414,6 +1444,7 @@ _dwarf_load_section(Dwarf_Debug dbg,
     int err = 0;
     struct Dwarf_Obj_Access_Interface_a_s *o = 0;
 
+    section->dss_last_use = ++dbg->de_section_use_clock;
     /* check to see if the section is already loaded */
     if (section->dss_data !=  NULL) {
         return DW_DLV_OK;
@@ -1437,6 +1468,10 @@ _dwarf_load_section(Dwarf_Debug dbg,
     if (res == DW_DLV_ERROR) {
         DWARF_DBG_ERROR(dbg, err, DW_DLV_ERROR);
     }
+    if (res == DW_DLV_OK) {
+        DW_PERF_ADD(dbg,ps_sections_loaded,1);
+        DW_PERF_ADD(dbg,ps_section_bytes_loaded,section->dss_size);
+    }
     /*  For PE and mach-o all section data was always
         malloc'd. We do not need to set dss_data_was_malloc
         though as the o->object data will eventually free
@@ -1474,6 +1509,9 @@ _dwarf_load_section(Dwarf_Debug dbg,
         if (res != DW_DLV_OK) {
             return res;
         }
+        DW_PERF_ADD(dbg,ps_sections_decompressed,1);
+        DW_PERF_ADD(dbg,ps_section_bytes_decompressed,
+            section->dss_size);
 #else /* !defined(HAVE_ZLIB) && defined(HAVE_ZSTD) */
         _dwarf_error_string(dbg, error,
             DW_DLE_ZDEBUG_REQUIRES_ZLIB,
@@ -1502,6 +1540,322 @@ _dwarf_load_section(Dwarf_Debug dbg,
     return res;
 }
 
+static int
+section_name_wanted(struct Dwarf_Section_s *secdata,
+    const char **names,
+    Dwarf_Unsigned count)
+{
+    Dwarf_Unsigned i = 0;
+
+    if (!names) {
+        return TRUE;
+    }
+    for ( ; i < count; ++i) {
+        const char *n = names[i];
+
+        if (!n) {
+            continue;
+        }
+        if (secdata->dss_standard_name &&
+            !strcmp(n,secdata->dss_standard_name)) {
+            return TRUE;
+        }
+        if (secdata->dss_name &&
+            !strcmp(n,secdata->dss_name)) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/*  Loads a set of DWARF sections at once.
+    For Elf objects read by libdwarf itself
+    the section bytes of all requested sections
+    are read first, adjacent sections together
+    in one vectored read, then each is finished
+    (decompression, relocation) as
+    _dwarf_load_section() always did.
+    Other object formats simply load the
+    sections one at a time. */
+int
+dwarf_load_sections(Dwarf_Debug dbg,
+    const char   **section_names,
+    Dwarf_Unsigned section_count,
+    Dwarf_Error   *error)
+{
+    struct Dwarf_Section_s *secs[DWARF_MAX_DEBUG_SECTIONS];
+    Dwarf_Unsigned indexes[DWARF_MAX_DEBUG_SECTIONS];
+    unsigned count = 0;
+    unsigned i = 0;
+    struct Dwarf_Obj_Access_Interface_a_s *o = 0;
+
+    CHECK_DBG(dbg,error,"dwarf_load_sections()");
+    if (section_names && !section_count) {
+        return DW_DLV_NO_ENTRY;
+    }
+    for (i = 0; i < dbg->de_debug_sections_total_entries &&
+        i < DWARF_MAX_DEBUG_SECTIONS; ++i) {
+        struct Dwarf_Section_s *secdata =
+            dbg->de_debug_sections[i].ds_secdata;
+
+        if (!secdata || secdata->dss_data ||
+            !secdata->dss_size || !secdata->dss_index) {
+            continue;
+        }
+        if (!section_name_wanted(secdata,section_names,
+            section_count)) {
+            continue;
+        }
+        secs[count] = secdata;
+        indexes[count] = secdata->dss_index;
+        ++count;
+    }
+    if (!count) {
+        return DW_DLV_NO_ENTRY;
+    }
+    o = dbg->de_obj_file;
+    if (o && o->ai_object && *(char *)(o->ai_object) == 'F') {
+        int err = 0;
+        int res = 0;
+
+        res = _dwarf_elf_nlload_sections(o,indexes,count,&err);
+        if (res == DW_DLV_ERROR) {
+            DWARF_DBG_ERROR(dbg, err, DW_DLV_ERROR);
+        }
+    }
+    for (i = 0; i < count; ++i) {
+        int res = 0;
+
+        res = _dwarf_load_section(dbg,secs[i],error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+    }
+    return DW_DLV_OK;
+}
+
+/*  Bytes of memory held for one section: the
+    section data plus, if the section was decompressed,
+    the raw compressed bytes the object reader holds. */
+static Dwarf_Unsigned
+section_resident_bytes(struct Dwarf_Section_s *sec)
+{
+    Dwarf_Unsigned total = 0;
+
+    if (!sec->dss_data) {
+        return 0;
+    }
+    total = sec->dss_size;
+    if (sec->dss_did_decompress && sec->dss_data_was_malloc) {
+        total += sec->dss_compressed_length;
+    }
+    return total;
+}
+
+/*  TRUE if the object reader can free the raw
+    bytes of one section (and read them again later).
+    The libelf reader and caller-provided readers cannot. */
+static Dwarf_Bool
+reader_can_unload(Dwarf_Debug dbg)
+{
+    struct Dwarf_Obj_Access_Interface_a_s *o = dbg->de_obj_file;
+    char otype = 0;
+
+    if (!o || !o->ai_object) {
+        return FALSE;
+    }
+    otype = *(char *)(o->ai_object);
+    switch(otype) {
+    case 'F':
+    case 'M':
+    case 'P':
+        return TRUE;
+    default:
+        break;
+    }
+    return FALSE;
+}
+
+/*  Only sections libdwarf itself keeps no pointers into
+    (between calls) can be evicted, and only if they
+    are exactly the bytes of the object file
+    (perhaps decompressed), never relocated.
+    .debug_str and .debug_line_str are not evictable:
+    line contexts and Dwarf_Global records point
+    directly at strings in them.
+    A section is only worth evicting if doing so
+    frees memory: either libdwarf allocated the
+    data (decompression) or the reader can unload it. */
+static Dwarf_Bool
+section_is_evictable(Dwarf_Debug dbg,
+    struct Dwarf_Section_s *sec)
+{
+    if (!sec->dss_data || !sec->dss_index) {
+        return FALSE;
+    }
+    if (sec->dss_ignore_reloc_group_sec) {
+        return FALSE;
+    }
+    if (_dwarf_apply_relocs && sec->dss_reloc_size) {
+        return FALSE;
+    }
+    if (!sec->dss_data_was_malloc && !reader_can_unload(dbg)) {
+        return FALSE;
+    }
+    if (sec == &dbg->de_debug_ranges ||
+        sec == &dbg->de_debug_aranges ||
+        sec == &dbg->de_debug_macinfo) {
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/*  Returns the number of bytes actually freed. */
+static Dwarf_Unsigned
+evict_section(Dwarf_Debug dbg, struct Dwarf_Section_s *sec)
+{
+    struct Dwarf_Obj_Access_Interface_a_s *o = dbg->de_obj_file;
+    Dwarf_Unsigned freed = 0;
+    Dwarf_Unsigned rawsize = sec->dss_size;
+
+    if (sec->dss_data_was_malloc) {
+        _dwarf_allocator_free(&dbg->de_allocator,sec->dss_data);
+        freed += sec->dss_size;
+    }
+    if (sec->dss_did_decompress) {
+        /*  Back to the size as recorded in the object
+            so the reload decompresses again. */
+        rawsize = sec->dss_compressed_length;
+        sec->dss_size = sec->dss_compressed_length;
+        sec->dss_did_decompress = FALSE;
+    }
+    sec->dss_data = 0;
+    sec->dss_data_was_malloc = FALSE;
+    if (!reader_can_unload(dbg)) {
+        /*  The reader still holds the raw bytes. */
+        return freed;
+    }
+    switch(*(char *)(o->ai_object)) {
+    case 'F':
+        _dwarf_elf_nlunload_section(o,sec->dss_index);
+        break;
+    case 'M':
+        _dwarf_macho_unload_section(o,sec->dss_index);
+        break;
+    case 'P':
+        _dwarf_pe_unload_section(o,sec->dss_index);
+        break;
+    default:
+        return freed;
+    }
+    return freed + rawsize;
+}
+
+int
+dwarf_set_section_memory_budget(Dwarf_Debug dbg,
+    Dwarf_Unsigned  budget,
+    Dwarf_Unsigned *old_budget,
+    Dwarf_Error    *error)
+{
+    CHECK_DBG(dbg,error,"dwarf_set_section_memory_budget()");
+    if (old_budget) {
+        *old_budget = dbg->de_section_budget;
+    }
+    dbg->de_section_budget = budget;
+    return DW_DLV_OK;
+}
+
+int
+dwarf_get_section_resident_bytes(Dwarf_Debug dbg,
+    const char     *section_name,
+    Dwarf_Unsigned *resident_bytes,
+    Dwarf_Error    *error)
+{
+    Dwarf_Unsigned total = 0;
+    Dwarf_Bool     found = FALSE;
+    unsigned i = 0;
+
+    CHECK_DBG(dbg,error,"dwarf_get_section_resident_bytes()");
+    for ( ; i < dbg->de_debug_sections_total_entries &&
+        i < DWARF_MAX_DEBUG_SECTIONS; ++i) {
+        struct Dwarf_Section_s *sec =
+            dbg->de_debug_sections[i].ds_secdata;
+
+        if (!sec) {
+            continue;
+        }
+        if (section_name &&
+            !section_name_wanted(sec,&section_name,1)) {
+            continue;
+        }
+        found = TRUE;
+        total += section_resident_bytes(sec);
+    }
+    if (!found) {
+        return DW_DLV_NO_ENTRY;
+    }
+    *resident_bytes = total;
+    return DW_DLV_OK;
+}
+
+/*  Frees least-recently-used evictable sections until
+    the resident total is within the budget. */
+int
+dwarf_evict_sections(Dwarf_Debug dbg,
+    Dwarf_Unsigned *bytes_released,
+    Dwarf_Error    *error)
+{
+    Dwarf_Unsigned resident = 0;
+    Dwarf_Unsigned released = 0;
+    unsigned i = 0;
+
+    CHECK_DBG(dbg,error,"dwarf_evict_sections()");
+    if (!dbg->de_section_budget) {
+        return DW_DLV_NO_ENTRY;
+    }
+    for ( ; i < dbg->de_debug_sections_total_entries &&
+        i < DWARF_MAX_DEBUG_SECTIONS; ++i) {
+        struct Dwarf_Section_s *sec =
+            dbg->de_debug_sections[i].ds_secdata;
+
+        if (sec) {
+            resident += section_resident_bytes(sec);
+        }
+    }
+    while (resident > dbg->de_section_budget) {
+        struct Dwarf_Section_s *oldest = 0;
+        Dwarf_Unsigned secbytes = 0;
+
+        for (i = 0; i < dbg->de_debug_sections_total_entries &&
+            i < DWARF_MAX_DEBUG_SECTIONS; ++i) {
+            struct Dwarf_Section_s *sec =
+                dbg->de_debug_sections[i].ds_secdata;
+
+            if (!sec || !section_is_evictable(dbg,sec)) {
+                continue;
+            }
+            if (!oldest || sec->dss_last_use < oldest->dss_last_use) {
+                oldest = sec;
+            }
+        }
+        if (!oldest) {
+            break;
+        }
+        secbytes = section_resident_bytes(oldest);
+        released += evict_section(dbg,oldest);
+        /*  The section no longer counts as resident
+            whether or not the reader kept raw bytes. */
+        resident -= secbytes;
+    }
+    if (bytes_released) {
+        *bytes_released = released;
+    }
+    if (!released) {
+        return DW_DLV_NO_ENTRY;
+    }
+    return DW_DLV_OK;
+}
+
 /* This is a hack so clients can verify offsets.
    Added (without so many sections to report)  April 2005
    so that debugger can detect broken offsets
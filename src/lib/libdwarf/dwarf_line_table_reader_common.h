@@ -1362,6 +1362,7 @@ read_line_table_program(Dwarf_Debug dbg,
 
     (void)orig_line_ptr;
     (void)err_count_out;
+    DW_PERF_ADD(dbg,ps_line_program_executions,1);
     /*  Initialize the one state machine variable that depends on the
         prefix.  */
     _dwarf_set_line_table_regs_default_values(&regs,
@@ -139,19 +139,6 @@ determine_location_lkind(unsigned int version,
     return DW_LKIND_unknown;
 }
 
-static void
-_dwarf_free_op_chain(Dwarf_Debug dbg,
-    Dwarf_Loc_Chain headloc)
-{
-    Dwarf_Loc_Chain cur = headloc;
-
-    while (cur) {
-        Dwarf_Loc_Chain next = cur->lc_next;
-        dwarf_dealloc(dbg, cur, DW_DLA_LOC_CHAIN);
-        cur = next;
-    }
-}
-
 /*  Using a loclist offset to get the in-memory
     address of .debug_loc data to read, returns the loclist
     'header' info in return_block.
@@ -601,12 +588,6 @@ _dwarf_fill_in_locdesc_op_c(Dwarf_Debug dbg,
     /* Offset of current operator from start of block. */
     Dwarf_Unsigned offset = 0;
 
-    /*  Chain the  DW_OPerator structs. */
-    Dwarf_Loc_Chain new_loc = NULL;
-    Dwarf_Loc_Chain prev_loc = NULL;
-    Dwarf_Loc_Chain head_loc = NULL;
-    Dwarf_Loc_Chain *plast = &head_loc;
-
     Dwarf_Unsigned  op_count = 0;
 
     /*  Contiguous block of Dwarf_Loc_Expr_Op_s
@@ -641,7 +622,11 @@ _dwarf_fill_in_locdesc_op_c(Dwarf_Debug dbg,
             return res;
         }
     }
-    /* New loop getting Loc operators. Non DWO */
+    /*  Two passes over the operators: the first counts
+        them (and finds any error), the second decodes them
+        straight into the final array. Decoding is cheap
+        compared to allocating a Dwarf_Loc_Chain per
+        operator, which is what was done before. */
     while (offset <= loc_block->bl_len) {
         Dwarf_Unsigned nextoffset = 0;
         struct Dwarf_Loc_Expr_Op_s temp_loc;
@@ -658,7 +643,6 @@ _dwarf_fill_in_locdesc_op_c(Dwarf_Debug dbg,
             &temp_loc,
             error);
         if (res == DW_DLV_ERROR) {
-            _dwarf_free_op_chain(dbg,head_loc);
             return res;
         }
         if (res == DW_DLV_NO_ENTRY) {
@@ -667,52 +651,40 @@ _dwarf_fill_in_locdesc_op_c(Dwarf_Debug dbg,
             break;
         }
         op_count++;
-        new_loc = (Dwarf_Loc_Chain) _dwarf_get_alloc(dbg,
-            DW_DLA_LOC_CHAIN, 1);
-        if (new_loc == NULL) {
-            _dwarf_free_op_chain(dbg,head_loc);
-            _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
-            return DW_DLV_ERROR;
-        }
-
-        /* Copying all the fields. DWARF 2,3,4,5. */
-        new_loc->lc_atom    = temp_loc.lr_atom;
-        new_loc->lc_opnumber= temp_loc.lr_opnumber;
-        new_loc->lc_number  = temp_loc.lr_number;
-        new_loc->lc_number2 = temp_loc.lr_number2;
-        new_loc->lc_number3 = temp_loc.lr_number3;
-        new_loc->lc_offset  = temp_loc.lr_offset;
-        *plast = new_loc;
-        plast= &(new_loc->lc_next);
         offset = nextoffset;
     }
     block_loc =
         (Dwarf_Loc_Expr_Op ) _dwarf_get_alloc(dbg,
         DW_DLA_LOC_BLOCK_C, op_count);
-    new_loc = head_loc;
     if (!block_loc) {
         _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
-        for (i = 0; i < op_count; i++) {
-            prev_loc = new_loc;
-            new_loc = prev_loc->lc_next;
-            dwarf_dealloc(dbg, prev_loc, DW_DLA_LOC_CHAIN);
-        }
         return DW_DLV_ERROR;
     }
 
     /* op_count could be zero. */
-    new_loc = head_loc;
+    offset = 0;
     for (i = 0; i < op_count; i++) {
-        /* Copying only the fields needed by DWARF 2,3,4 */
-        (block_loc + i)->lr_atom = new_loc->lc_atom;
-        (block_loc + i)->lr_number = new_loc->lc_number;
-        (block_loc + i)->lr_number2 = new_loc->lc_number2;
-        (block_loc + i)->lr_number3 = new_loc->lc_number3;
-        (block_loc + i)->lr_offset = new_loc->lc_offset;
-        (block_loc + i)->lr_opnumber = new_loc->lc_opnumber;
-        prev_loc = new_loc;
-        new_loc = prev_loc->lc_next;
-        dwarf_dealloc(dbg, prev_loc, DW_DLA_LOC_CHAIN);
+        Dwarf_Unsigned nextoffset = 0;
+
+        res = _dwarf_read_loc_expr_op(dbg,loc_block,
+            i,
+            version_stamp,
+            offset_size,
+            address_size,
+            offset,
+            section_end,
+            &nextoffset,
+            block_loc + i,
+            error);
+        if (res != DW_DLV_OK) {
+            /*  Impossible, the first pass read these. */
+            dwarf_dealloc(dbg,block_loc,DW_DLA_LOC_BLOCK_C);
+            if (res == DW_DLV_NO_ENTRY) {
+                _dwarf_error(dbg, error, DW_DLE_LOCATION_ERROR);
+            }
+            return DW_DLV_ERROR;
+        }
+        offset = nextoffset;
     }
     /*  Synthesizing the DW_LLE values for the old loclist
         versions. */
@@ -757,6 +729,8 @@ _dwarf_fill_in_locdesc_op_c(Dwarf_Debug dbg,
     }
     locdesc->ld_cents = (Dwarf_Half)op_count;
     locdesc->ld_s = block_loc;
+    locdesc->ld_expr_length = offset;
+    locdesc->ld_loclist_head = loc_head;
 
     locdesc->ld_kind = lkind;
     locdesc->ld_section_offset = loc_block->bl_section_offset;
@@ -1142,54 +1116,75 @@ _dwarf_original_loclist_build(Dwarf_Debug dbg,
     return DW_DLV_OK;
 }
 
+/*  The expression bytes of a DW_FORM_exprloc or
+    DW_FORM_block* location attribute. */
 static int
-_dwarf_original_expression_build(Dwarf_Debug dbg,
-    Dwarf_Loc_Head_c llhead,
-    Dwarf_Attribute attr,
-    Dwarf_Error *error)
+_dwarf_get_expression_block(Dwarf_Debug dbg,
+    Dwarf_Attribute  attr,
+    Dwarf_CU_Context cucontext,
+    unsigned         form,
+    unsigned         lkind,
+    Dwarf_Block_c   *loc_blockc,
+    Dwarf_Error     *error)
 {
-
-    Dwarf_Block_c loc_blockc;
-    Dwarf_Unsigned rawlowpc = 0;
-    Dwarf_Unsigned rawhighpc = 0;
-    unsigned form = llhead->ll_attrform;
     int blkres = 0;
-    Dwarf_Locdesc_c llbuf = 0;
-    unsigned listlen = 1;
-    Dwarf_CU_Context cucontext = llhead->ll_context;
-    unsigned address_size = llhead->ll_address_size;
 
-    memset(&loc_blockc,0,sizeof(loc_blockc));
+    memset(loc_blockc,0,sizeof(*loc_blockc));
     if (form == DW_FORM_exprloc) {
         /*  A bit ugly. dwarf_formexprloc should use a
             Dwarf_Block argument. */
-        blkres = dwarf_formexprloc(attr,&loc_blockc.bl_len,
-            (Dwarf_Ptr)&loc_blockc.bl_data,error);
+        blkres = dwarf_formexprloc(attr,&loc_blockc->bl_len,
+            (Dwarf_Ptr)&loc_blockc->bl_data,error);
         if (blkres != DW_DLV_OK) {
             return blkres;
         }
-        loc_blockc.bl_kind = llhead->ll_kind;
-        loc_blockc.bl_section_offset  =
-            (char *)loc_blockc.bl_data -
+        loc_blockc->bl_kind = lkind;
+        loc_blockc->bl_section_offset  =
+            (char *)loc_blockc->bl_data -
             (char *)dbg->de_debug_info.dss_data;
-        loc_blockc.bl_locdesc_offset = 0; /* not relevant */
+        loc_blockc->bl_locdesc_offset = 0; /* not relevant */
     } else {
         Dwarf_Block loc_block;
 
         memset(&loc_block,0,sizeof(loc_block));
         blkres = _dwarf_formblock_internal(dbg,attr,
-            llhead->ll_context,
+            cucontext,
             &loc_block,
             error);
         if (blkres != DW_DLV_OK) {
             return blkres;
         }
-        loc_blockc.bl_len = loc_block.bl_len;
-        loc_blockc.bl_data = loc_block.bl_data;
-        loc_blockc.bl_kind = llhead->ll_kind;
-        loc_blockc.bl_section_offset =
+        loc_blockc->bl_len = loc_block.bl_len;
+        loc_blockc->bl_data = loc_block.bl_data;
+        loc_blockc->bl_kind = lkind;
+        loc_blockc->bl_section_offset =
             loc_block.bl_section_offset;
-        loc_blockc.bl_locdesc_offset = 0; /* not relevant */
+        loc_blockc->bl_locdesc_offset = 0; /* not relevant */
+    }
+    return DW_DLV_OK;
+}
+
+static int
+_dwarf_original_expression_build(Dwarf_Debug dbg,
+    Dwarf_Loc_Head_c llhead,
+    Dwarf_Attribute attr,
+    Dwarf_Error *error)
+{
+
+    Dwarf_Block_c loc_blockc;
+    Dwarf_Unsigned rawlowpc = 0;
+    Dwarf_Unsigned rawhighpc = 0;
+    unsigned form = llhead->ll_attrform;
+    int blkres = 0;
+    Dwarf_Locdesc_c llbuf = 0;
+    unsigned listlen = 1;
+    Dwarf_CU_Context cucontext = llhead->ll_context;
+    unsigned address_size = llhead->ll_address_size;
+
+    blkres = _dwarf_get_expression_block(dbg,attr,
+        cucontext,form,llhead->ll_kind,&loc_blockc,error);
+    if (blkres != DW_DLV_OK) {
+        return blkres;
     }
     /*  We will mark the Locdesc_c DW_LLE_start_end
         shortly. Here we fake the address range
@@ -1576,6 +1571,41 @@ cook_loclists_contents(Dwarf_Debug dbg,
     return DW_DLV_OK;
 }
 
+static void
+lkind_unknown_error(Dwarf_Debug dbg,
+    Dwarf_Half     cuversionstamp,
+    Dwarf_Unsigned attrnum,
+    Dwarf_Half     form,
+    Dwarf_Bool     is_dwo,
+    Dwarf_Error   *error)
+{
+    dwarfstring m;
+    const char * formname = "<unknownform>";
+    const char * attrname = "<unknown attribute>";
+
+    dwarfstring_constructor(&m);
+    dwarf_get_FORM_name((unsigned int)form,&formname);
+    dwarf_get_AT_name((unsigned int)attrnum,&attrname);
+    dwarfstring_append_printf_u(&m,
+        "DW_DLE_LOC_EXPR_BAD: For Compilation Unit "
+        "version %u",cuversionstamp);
+    dwarfstring_append_printf_u(&m,
+        ", attribute 0x%x (",attrnum);
+    dwarfstring_append(&m,(char *)attrname);
+    dwarfstring_append_printf_u(&m,
+        ") form 0x%x (",form);
+    dwarfstring_append(&m,(char *)formname);
+    if (is_dwo) {
+        dwarfstring_append(&m,") (the CU is a .dwo) ");
+    } else {
+        dwarfstring_append(&m,") (the CU is not a .dwo) ");
+    }
+    dwarfstring_append(&m," we don't understand the location");
+    _dwarf_error_string(dbg,error,DW_DLE_LOC_EXPR_BAD,
+        dwarfstring_string(&m));
+    dwarfstring_destructor(&m);
+}
+
 /*  New October 2015
     This interface requires the use of interface functions
     to get data from Dwarf_Locdesc_c.  The structures
@@ -1621,31 +1651,8 @@ dwarf_get_loclist_c(Dwarf_Attribute attr,
     lkind = determine_location_lkind(cuversionstamp,
         form, is_dwo);
     if (lkind == DW_LKIND_unknown) {
-        dwarfstring m;
-        const char * formname = "<unknownform>";
-        const char * attrname = "<unknown attribute>";
-
-        dwarfstring_constructor(&m);
-        dwarf_get_FORM_name((unsigned int)form,&formname);
-        dwarf_get_AT_name((unsigned int)attrnum,&attrname);
-        dwarfstring_append_printf_u(&m,
-            "DW_DLE_LOC_EXPR_BAD: For Compilation Unit "
-            "version %u",cuversionstamp);
-        dwarfstring_append_printf_u(&m,
-            ", attribute 0x%x (",attrnum);
-        dwarfstring_append(&m,(char *)attrname);
-        dwarfstring_append_printf_u(&m,
-            ") form 0x%x (",form);
-        dwarfstring_append(&m,(char *)formname);
-        if (is_dwo) {
-            dwarfstring_append(&m,") (the CU is a .dwo) ");
-        } else {
-            dwarfstring_append(&m,") (the CU is not a .dwo) ");
-        }
-        dwarfstring_append(&m," we don't understand the location");
-        _dwarf_error_string(dbg,error,DW_DLE_LOC_EXPR_BAD,
-            dwarfstring_string(&m));
-        dwarfstring_destructor(&m);
+        lkind_unknown_error(dbg,cuversionstamp,attrnum,
+            form,is_dwo,error);
         return DW_DLV_ERROR;
     }
     /*  Doing this early (first) to avoid repeating the alloc code
@@ -1780,6 +1787,9 @@ dwarf_loclist_from_expr_c(Dwarf_Debug dbg,
     llhead->ll_context = 0; /* Not available! */
     llhead->ll_dbg = dbg;
     llhead->ll_kind = DW_LKIND_expression;
+    llhead->ll_address_size = address_size;
+    llhead->ll_offset_size = offset_size;
+    llhead->ll_cuversion = dwarf_version;
 
     /*  An empty location description (block length 0)
         means the code generator emitted no variable,
@@ -1909,3 +1919,369 @@ dwarf_get_location_op_value_c(Dwarf_Locdesc_c locdesc,
     return DW_DLV_OK;
 }
 /* ============== End of the October 2015 interfaces. */
+
+/*  Set up an operator stream. Operand reads are
+    bounded by the end of the section the bytes are in
+    (as _dwarf_fill_in_locdesc_op_c() does) or, for bytes
+    not in any section, by the end of the expression. */
+static void
+_dwarf_loc_expr_stream_setup(Dwarf_Debug dbg,
+    Dwarf_Small   *data,
+    Dwarf_Unsigned len,
+    Dwarf_Unsigned section_offset,
+    Dwarf_Half     address_size,
+    Dwarf_Half     offset_size,
+    Dwarf_Half     version,
+    Dwarf_Loc_Expr_Stream *stream)
+{
+    memset(stream,0,sizeof(*stream));
+    stream->es_dbg = dbg;
+    stream->es_data = data;
+    stream->es_len = len;
+    stream->es_end = data + len;
+    stream->es_section_offset = section_offset;
+    stream->es_address_size = address_size;
+    stream->es_offset_size = offset_size;
+    stream->es_version = version;
+    if (data && len) {
+        const char  *section_name = 0;
+        Dwarf_Small *section_start = 0;
+        Dwarf_Unsigned section_size = 0;
+        Dwarf_Small *section_end = 0;
+        int res = 0;
+
+        res = _dwarf_what_section_are_we(dbg,
+            data,&section_name,&section_start,
+            &section_size,&section_end);
+        if (res == DW_DLV_OK) {
+            stream->es_end = section_end;
+        }
+    }
+}
+
+int
+dwarf_loc_expr_stream_init(Dwarf_Debug dbg,
+    Dwarf_Ptr      expression_in,
+    Dwarf_Unsigned expression_length,
+    Dwarf_Half     address_size,
+    Dwarf_Half     offset_size,
+    Dwarf_Half     dwarf_version,
+    Dwarf_Loc_Expr_Stream *stream_out,
+    Dwarf_Error   *error)
+{
+    CHECK_DBG(dbg,error,"dwarf_loc_expr_stream_init()");
+    if (!stream_out || (!expression_in && expression_length)) {
+        _dwarf_error_string(dbg, error,DW_DLE_LOC_EXPR_BAD,
+            "DW_DLE_LOC_EXPR_BAD: "
+            "NULL stream or expression pointer passed to "
+            "dwarf_loc_expr_stream_init()");
+        return DW_DLV_ERROR;
+    }
+    _dwarf_loc_expr_stream_setup(dbg,
+        (Dwarf_Small *)expression_in,expression_length,0,
+        address_size,offset_size,dwarf_version,stream_out);
+    return DW_DLV_OK;
+}
+
+int
+dwarf_loc_expr_stream_next(Dwarf_Loc_Expr_Stream *stream,
+    Dwarf_Small    * atom_out,
+    Dwarf_Unsigned * operand1,
+    Dwarf_Unsigned * operand2,
+    Dwarf_Unsigned * operand3,
+    Dwarf_Unsigned * offset_for_branch,
+    Dwarf_Error    * error)
+{
+    Dwarf_Debug    dbg = 0;
+    Dwarf_Block_c  loc_block;
+    struct Dwarf_Loc_Expr_Op_s op;
+    Dwarf_Unsigned nextoffset = 0;
+    int            res = 0;
+
+    if (!stream) {
+        _dwarf_error_string(NULL, error,DW_DLE_DBG_NULL,
+            "DW_DLE_DBG_NULL: "
+            "NULL Dwarf_Loc_Expr_Stream "
+            "in calling "
+            "dwarf_loc_expr_stream_next()");
+        return DW_DLV_ERROR;
+    }
+    dbg = stream->es_dbg;
+    CHECK_DBG(dbg,error,"dwarf_loc_expr_stream_next()");
+    memset(&loc_block,0,sizeof(loc_block));
+    loc_block.bl_len = stream->es_len;
+    loc_block.bl_data = stream->es_data;
+    loc_block.bl_section_offset = stream->es_section_offset;
+    res = _dwarf_read_loc_expr_op(dbg,&loc_block,
+        (Dwarf_Signed)stream->es_opnumber,
+        stream->es_version,
+        stream->es_offset_size,
+        stream->es_address_size,
+        (Dwarf_Signed)stream->es_offset,
+        stream->es_end,
+        &nextoffset,
+        &op,
+        error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    *atom_out = op.lr_atom;
+    *operand1 = op.lr_number;
+    *operand2 = op.lr_number2;
+    *operand3 = op.lr_number3;
+    *offset_for_branch = op.lr_offset;
+    stream->es_offset = nextoffset;
+    stream->es_opnumber++;
+    return DW_DLV_OK;
+}
+
+/*  Returns DW_DLV_OK and the address for a .debug_addr
+    index or DW_DLV_NO_ENTRY if it cannot be found,
+    in which case the entry using it cannot match. */
+static int
+loc_index_to_addr(Dwarf_Debug dbg,
+    Dwarf_CU_Context cucontext,
+    Dwarf_Unsigned index,
+    Dwarf_Addr *addr_out)
+{
+    Dwarf_Error lerr = 0;
+    int res = 0;
+
+    res = _dwarf_look_in_local_and_tied_by_index(dbg,
+        cucontext,index,addr_out,&lerr);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,lerr);
+        return DW_DLV_NO_ENTRY;
+    }
+    return res;
+}
+
+/*  DWARF2-4 .debug_loc lists and the GNU DWARF4 .dwo
+    lists: read the entries in place and cook their
+    addresses, stopping at the first that contains pc. */
+static int
+_dwarf_find_loclist_entry_by_pc(Dwarf_Debug dbg,
+    Dwarf_Attribute  attr,
+    Dwarf_CU_Context cucontext,
+    unsigned         lkind,
+    Dwarf_Addr       pc,
+    Dwarf_Small     *lle_value_out,
+    Dwarf_Addr      *lowpc_out,
+    Dwarf_Addr      *highpc_out,
+    Dwarf_Block_c   *ops_out,
+    Dwarf_Error     *error)
+{
+    Dwarf_Unsigned offset = 0;
+    Dwarf_Half     address_size = cucontext->cc_address_size;
+    Dwarf_Addr     baseaddress = cucontext->cc_low_pc;
+    int            res = 0;
+
+    res = _dwarf_get_loclist_header_start(dbg,
+        attr, &offset, error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    for (;;) {
+        Dwarf_Block_c b;
+        Dwarf_Addr    rawlow = 0;
+        Dwarf_Addr    rawhigh = 0;
+        Dwarf_Half    lle_op = 0;
+        Dwarf_Bool    at_end = FALSE;
+        Dwarf_Addr    lopc = 0;
+        Dwarf_Addr    hipc = 0;
+        Dwarf_Bool    bounded = FALSE;
+        Dwarf_Small   lle_value = 0;
+
+        memset(&b,0,sizeof(b));
+        if (lkind == DW_LKIND_GNU_exp_list) {
+            res = _dwarf_read_loc_section_dwo(dbg, &b,
+                &rawlow, &rawhigh, &at_end, &lle_op,
+                offset, address_size, lkind, error);
+        } else {
+            res = _dwarf_read_loc_section(dbg, &b,
+                &rawlow, &rawhigh, &lle_op,
+                offset, address_size, error);
+        }
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (lkind == DW_LKIND_GNU_exp_list) {
+            if (at_end) {
+                break;
+            }
+            lle_value = (Dwarf_Small)lle_op;
+            switch(lle_op) {
+            case DW_LLEX_base_address_selection_entry:
+                (void)loc_index_to_addr(dbg,cucontext,
+                    rawhigh,&baseaddress);
+                break;
+            case DW_LLEX_start_length_entry:
+                if (loc_index_to_addr(dbg,cucontext,rawlow,
+                    &lopc) == DW_DLV_OK) {
+                    hipc = lopc + rawhigh;
+                    bounded = TRUE;
+                }
+                break;
+            case DW_LLEX_offset_pair_entry:
+                lopc = rawlow + baseaddress;
+                hipc = rawhigh + baseaddress;
+                bounded = TRUE;
+                break;
+            case DW_LLEX_start_end_entry:
+                if (loc_index_to_addr(dbg,cucontext,rawlow,
+                    &lopc) == DW_DLV_OK &&
+                    loc_index_to_addr(dbg,cucontext,rawhigh,
+                    &hipc) == DW_DLV_OK) {
+                    bounded = TRUE;
+                }
+                break;
+            default:
+                break;
+            }
+        } else {
+            if (lle_op == DW_LLE_end_of_list) {
+                break;
+            }
+            if (lle_op == DW_LLE_base_address) {
+                baseaddress = rawhigh;
+            } else {
+                /*  As synthesized by
+                    _dwarf_fill_in_locdesc_op_c(). */
+                lle_value = DW_LLE_offset_pair;
+                lopc = rawlow + baseaddress;
+                hipc = rawhigh + baseaddress;
+                bounded = TRUE;
+            }
+        }
+        if (bounded && lopc <= pc && pc < hipc) {
+            *lle_value_out = lle_value;
+            *lowpc_out = lopc;
+            *highpc_out = hipc;
+            /*  _dwarf_read_loc_section() leaves
+                this zero. */
+            b.bl_locdesc_offset = offset;
+            *ops_out = b;
+            return DW_DLV_OK;
+        }
+        offset = b.bl_section_offset + b.bl_len;
+    }
+    return DW_DLV_NO_ENTRY;
+}
+
+/*  New in 0.9.2. Finds the single location entry
+    applicable at pc without building a Dwarf_Loc_Head_c
+    or decoding any operators. */
+int
+dwarf_get_loclist_entry_by_pc(Dwarf_Attribute attr,
+    Dwarf_Addr       pc,
+    Dwarf_Small    * lle_value_out,
+    Dwarf_Addr     * lowpc_out,
+    Dwarf_Addr     * highpc_out,
+    Dwarf_Loc_Expr_Stream * stream_out,
+    Dwarf_Error    * error)
+{
+    Dwarf_Debug      dbg = 0;
+    Dwarf_Half       form = 0;
+    Dwarf_CU_Context cucontext = 0;
+    Dwarf_Half       cuversionstamp = 0;
+    Dwarf_Half       address_size = 0;
+    Dwarf_Half       offset_size = 0;
+    Dwarf_Bool       is_dwo = FALSE;
+    Dwarf_Block_c    ops;
+    Dwarf_Small      lle_value = 0;
+    Dwarf_Addr       lopc = 0;
+    Dwarf_Addr       hipc = 0;
+    int              lkind = 0;
+    int              res = 0;
+
+    if (!attr) {
+        _dwarf_error_string(dbg, error,DW_DLE_ATTR_NULL,
+            "DW_DLE_ATTR_NULL"
+            "NULL Dwarf_Attribute "
+            "argument passed to "
+            "dwarf_get_loclist_entry_by_pc()");
+        return DW_DLV_ERROR;
+    }
+    dbg = attr->ar_dbg;
+    CHECK_DBG(dbg,error,"dwarf_get_loclist_entry_by_pc()");
+    if (!stream_out) {
+        _dwarf_error_string(dbg, error,DW_DLE_LOC_EXPR_BAD,
+            "DW_DLE_LOC_EXPR_BAD: "
+            "NULL Dwarf_Loc_Expr_Stream passed to "
+            "dwarf_get_loclist_entry_by_pc()");
+        return DW_DLV_ERROR;
+    }
+    res = _dwarf_setup_loc(attr, &dbg,&cucontext, &form, error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    cuversionstamp = cucontext->cc_version_stamp;
+    address_size = cucontext->cc_address_size;
+    offset_size = cucontext->cc_length_size;
+    is_dwo = cucontext->cc_is_dwo;
+    lkind = determine_location_lkind(cuversionstamp,
+        form, is_dwo);
+    memset(&ops,0,sizeof(ops));
+    switch(lkind) {
+    case DW_LKIND_expression:
+        res = _dwarf_get_expression_block(dbg,attr,
+            cucontext,form,lkind,&ops,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        /*  Applies at every pc, see
+            _dwarf_original_expression_build() */
+        lle_value = DW_LLE_start_end;
+        lopc = 0;
+        hipc = MAX_ADDR;
+        break;
+    case DW_LKIND_loclist:
+    case DW_LKIND_GNU_exp_list:
+        res = _dwarf_find_loclist_entry_by_pc(dbg,attr,
+            cucontext,lkind,pc,&lle_value,&lopc,&hipc,
+            &ops,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        break;
+    case DW_LKIND_loclists: {
+        struct Dwarf_Loc_Head_c_s llhead;
+
+        memset(&llhead,0,sizeof(llhead));
+        llhead.ll_dbg = dbg;
+        llhead.ll_kind = lkind;
+        llhead.ll_attrform = form;
+        llhead.ll_context = cucontext;
+        llhead.ll_cu_base_address_present =
+            cucontext->cc_low_pc_present;
+        llhead.ll_cu_base_address = cucontext->cc_low_pc;
+        res = _dwarf_loclists_find_lle_by_pc(dbg,attr,
+            &llhead,pc,&lle_value,&lopc,&hipc,&ops,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        /*  The loclists header sizes apply to the
+            expression, as in build_array_of_lle() */
+        cuversionstamp = llhead.ll_cuversion;
+        address_size = (Dwarf_Half)llhead.ll_address_size;
+        offset_size = (Dwarf_Half)llhead.ll_offset_size;
+        break;
+    }
+    default:
+        lkind_unknown_error(dbg,cuversionstamp,
+            attr->ar_attribute,form,is_dwo,error);
+        return DW_DLV_ERROR;
+    }
+    res = _dwarf_loc_block_sanity_check(dbg,&ops,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    _dwarf_loc_expr_stream_setup(dbg,ops.bl_data,ops.bl_len,
+        ops.bl_section_offset,address_size,offset_size,
+        cuversionstamp,stream_out);
+    stream_out->es_locdesc_offset = ops.bl_locdesc_offset;
+    *lle_value_out = lle_value;
+    *lowpc_out = lopc;
+    *highpc_out = hipc;
+    return DW_DLV_OK;
+}
@@ -211,6 +211,19 @@ struct Dwarf_Locdesc_c_s {
     /* Section (not CU) offset where location descr begins*/
     Dwarf_Unsigned   ld_locdesc_offset;
 
+    /*  Byte length of the expression. */
+    Dwarf_Unsigned   ld_expr_length;
+
+    /*  Filled in by dwarf_expr_evaluate() the first
+        time it sees this locdesc: the shape of the
+        expression (an EXPR_SHAPE value, zero means
+        not yet looked at) and, for the single operator
+        shapes, the precomputed register, address or
+        constant and offset. */
+    Dwarf_Small      ld_eval_shape;
+    Dwarf_Unsigned   ld_eval_value;
+    Dwarf_Signed     ld_eval_offset;
+
     /* Pointer to our header (in which we are located). */
     Dwarf_Loc_Head_c ld_loclist_head;
     Dwarf_Locdesc_c  ld_next; /*helps building the locdescs*/
@@ -306,6 +319,16 @@ int _dwarf_loclists_fill_in_lle_head(Dwarf_Debug dbg,
     Dwarf_Loc_Head_c llhead,
     Dwarf_Error *error);
 
+int _dwarf_loclists_find_lle_by_pc(Dwarf_Debug dbg,
+    Dwarf_Attribute attr,
+    Dwarf_Loc_Head_c llhead,
+    Dwarf_Addr      pc,
+    Dwarf_Small    *lle_value_out,
+    Dwarf_Addr     *lowpc_out,
+    Dwarf_Addr     *highpc_out,
+    Dwarf_Block_c  *ops_out,
+    Dwarf_Error    *error);
+
 int _dwarf_loclists_expression_build(Dwarf_Debug dbg,
     Dwarf_Attribute attr,
     Dwarf_Loc_Head_c* llhead,
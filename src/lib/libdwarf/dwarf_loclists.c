@@ -1091,12 +1091,11 @@ build_array_of_lle(Dwarf_Debug dbg,
     return DW_DLV_OK;
 }
 
-/*  Build a head with all the relevent Entries
-    attached, all the locdescs and for each such,
-    all its expression operators.
-*/
-int
-_dwarf_loclists_fill_in_lle_head(Dwarf_Debug dbg,
+/*  Find the loclists context and the first lle
+    of the list the attribute refers to and record
+    them in llhead.  Nothing is allocated. */
+static int
+locate_lle_area(Dwarf_Debug dbg,
     Dwarf_Attribute attr,
     Dwarf_Loc_Head_c llhead,
     Dwarf_Error         *error)
@@ -1219,7 +1218,25 @@ _dwarf_loclists_fill_in_lle_head(Dwarf_Debug dbg,
     llhead->ll_llearea_offset = lle_global_offset;
     llhead->ll_llepointer = lle_global_offset +
         dbg->de_debug_loclists.dss_data;
+    return DW_DLV_OK;
+}
+
+/*  Build a head with all the relevent Entries
+    attached, all the locdescs and for each such,
+    all its expression operators.
+*/
+int
+_dwarf_loclists_fill_in_lle_head(Dwarf_Debug dbg,
+    Dwarf_Attribute attr,
+    Dwarf_Loc_Head_c llhead,
+    Dwarf_Error         *error)
+{
+    int res = 0;
 
+    res = locate_lle_area(dbg,attr,llhead,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
     res = build_array_of_lle(dbg,llhead,error);
     if (res != DW_DLV_OK) {
         return res;
@@ -1227,6 +1244,182 @@ _dwarf_loclists_fill_in_lle_head(Dwarf_Debug dbg,
     return DW_DLV_OK;
 }
 
+/*  Returns DW_DLV_OK and the address for a .debug_addr
+    index or DW_DLV_NO_ENTRY if it cannot be found,
+    in which case the entry using it cannot match. */
+static int
+lle_index_to_addr(Dwarf_Debug dbg,
+    Dwarf_CU_Context cucontext,
+    Dwarf_Unsigned index,
+    Dwarf_Addr *addr_out)
+{
+    Dwarf_Error lerr = 0;
+    int res = 0;
+
+    res = _dwarf_look_in_local_and_tied_by_index(dbg,
+        cucontext,index,addr_out,&lerr);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,lerr);
+        return DW_DLV_NO_ENTRY;
+    }
+    return res;
+}
+
+/*  For dwarf_get_loclist_entry_by_pc().
+    llhead is a caller-local head with the CU
+    fields set (ll_context, ll_attrform and the
+    base address). The entries are read in place,
+    their addresses cooked as cook_loclists_contents()
+    does, and the first entry whose range contains pc
+    is returned (or a DW_LLE_default_location entry).
+    No expression operators are decoded. */
+int
+_dwarf_loclists_find_lle_by_pc(Dwarf_Debug dbg,
+    Dwarf_Attribute attr,
+    Dwarf_Loc_Head_c llhead,
+    Dwarf_Addr      pc,
+    Dwarf_Small    *lle_value_out,
+    Dwarf_Addr     *lowpc_out,
+    Dwarf_Addr     *highpc_out,
+    Dwarf_Block_c  *ops_out,
+    Dwarf_Error    *error)
+{
+    int            res = 0;
+    Dwarf_Small   *data = 0;
+    Dwarf_Unsigned dataoffset = 0;
+    Dwarf_Small   *enddata = 0;
+    Dwarf_CU_Context cucontext = llhead->ll_context;
+    Dwarf_Addr     baseaddress = llhead->ll_cu_base_address;
+    Dwarf_Bool     base_present =
+        llhead->ll_cu_base_address_present;
+    Dwarf_Bool     have_default = FALSE;
+    Dwarf_Block_c  default_ops;
+
+    res = locate_lle_area(dbg,attr,llhead,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    data = llhead->ll_llepointer;
+    dataoffset = llhead->ll_llearea_offset;
+    enddata = llhead->ll_end_data_area;
+    memset(&default_ops,0,sizeof(default_ops));
+    for (;;) {
+        unsigned       entrylen = 0;
+        unsigned       code = 0;
+        Dwarf_Unsigned val1 = 0;
+        Dwarf_Unsigned val2 = 0;
+        Dwarf_Unsigned opsblocksize  = 0;
+        Dwarf_Unsigned opsoffset  = 0;
+        Dwarf_Small   *ops = 0;
+        Dwarf_Addr     lopc = 0;
+        Dwarf_Addr     hipc = 0;
+        Dwarf_Bool     bounded = FALSE;
+
+        if (data >= enddata) {
+            _dwarf_error_string(dbg,error,DW_DLE_LOCLISTS_ERROR,
+                "DW_DLE_LOCLISTS_ERROR: "
+                "a loclist runs off the end of its "
+                ".debug_loclists contribution. Corrupt data.");
+            return DW_DLV_ERROR;
+        }
+        res = read_single_lle_entry(dbg,
+            data,dataoffset, enddata,
+            llhead->ll_address_size,&entrylen,
+            &code,&val1, &val2,
+            &opsblocksize,&opsoffset,&ops,
+            error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        switch(code) {
+        case DW_LLE_end_of_list:
+            break;
+        case DW_LLE_base_addressx:
+            base_present = (lle_index_to_addr(dbg,cucontext,
+                val1,&baseaddress) == DW_DLV_OK);
+            break;
+        case DW_LLE_startx_endx:
+            if (lle_index_to_addr(dbg,cucontext,val1,&lopc) ==
+                DW_DLV_OK &&
+                lle_index_to_addr(dbg,cucontext,val2,&hipc) ==
+                DW_DLV_OK) {
+                bounded = TRUE;
+            }
+            break;
+        case DW_LLE_startx_length:
+            if (lle_index_to_addr(dbg,cucontext,val1,&lopc) ==
+                DW_DLV_OK) {
+                hipc = lopc + val2;
+                bounded = TRUE;
+            }
+            break;
+        case DW_LLE_offset_pair:
+            if (base_present) {
+                lopc = val1 + baseaddress;
+                hipc = val2 + baseaddress;
+                bounded = TRUE;
+            }
+            break;
+        case DW_LLE_default_location:
+            if (!have_default) {
+                have_default = TRUE;
+                default_ops.bl_len = opsblocksize;
+                default_ops.bl_data = ops;
+                default_ops.bl_locdesc_offset = dataoffset;
+            }
+            break;
+        case DW_LLE_base_address:
+            baseaddress = val1;
+            base_present = TRUE;
+            break;
+        case DW_LLE_start_end:
+            lopc = val1;
+            hipc = val2;
+            bounded = TRUE;
+            break;
+        case DW_LLE_start_length:
+            lopc = val1;
+            hipc = val1 + val2;
+            bounded = TRUE;
+            break;
+        default:
+            /* read_single_lle_entry() rejects others */
+            break;
+        }
+        if (code == DW_LLE_end_of_list) {
+            break;
+        }
+        if (bounded && lopc <= pc && pc < hipc) {
+            *lle_value_out = (Dwarf_Small)code;
+            *lowpc_out = lopc;
+            *highpc_out = hipc;
+            memset(ops_out,0,sizeof(*ops_out));
+            ops_out->bl_len = opsblocksize;
+            ops_out->bl_data = ops;
+            ops_out->bl_kind = DW_LKIND_loclists;
+            ops_out->bl_section_offset = ops -
+                dbg->de_debug_loclists.dss_data;
+            ops_out->bl_locdesc_offset = dataoffset;
+            return DW_DLV_OK;
+        }
+        data += entrylen;
+        dataoffset += entrylen;
+    }
+    if (have_default) {
+        *lle_value_out = DW_LLE_default_location;
+        *lowpc_out = 0;
+        *highpc_out = 0;
+        default_ops.bl_kind = DW_LKIND_loclists;
+        if (default_ops.bl_data) {
+            default_ops.bl_section_offset = default_ops.bl_data -
+                dbg->de_debug_loclists.dss_data;
+        }
+        *ops_out = default_ops;
+        return DW_DLV_OK;
+    }
+    return DW_DLV_NO_ENTRY;
+}
+
 #if 0 /* candiate??? for public api */
 int
 dwarf_get_loclists_entry_fields(
@@ -128,6 +128,7 @@ static int _dwarf_macho_object_access_init(
     unsigned offsetsize,
     unsigned * universalbinary_count,
     Dwarf_Unsigned filesize,
+    const Dwarf_Allocator *alloc,
     Dwarf_Obj_Access_Interface_a **binary_interface,
     int *localerrnum);
 
@@ -220,7 +221,8 @@ macho_load_section (void *obj, Dwarf_Unsigned section_index,
             return DW_DLV_ERROR;
         }
 
-        sp->loaded_data = malloc((size_t)sp->size);
+        sp->loaded_data = _dwarf_allocator_malloc(
+            &macho->mo_allocator,sp->size);
         if (!sp->loaded_data) {
             *error = DW_DLE_ALLOC_FAIL;
             return DW_DLV_ERROR;
@@ -230,7 +232,8 @@ macho_load_section (void *obj, Dwarf_Unsigned section_index,
             sp->size,
             (inner+macho->mo_filesize), error);
         if (res != DW_DLV_OK) {
-            free(sp->loaded_data);
+            _dwarf_allocator_free(&macho->mo_allocator,
+                sp->loaded_data);
             sp->loaded_data = 0;
             return res;
         }
@@ -265,7 +268,8 @@ _dwarf_destruct_macho_internals(
         sp = mp->mo_dwarf_sections;
         for ( i=0; i < mp->mo_dwarf_sectioncount; ++i,++sp) {
             if (sp->loaded_data) {
-                free(sp->loaded_data);
+                _dwarf_allocator_free(&mp->mo_allocator,
+                    sp->loaded_data);
                 sp->loaded_data = 0;
             }
         }
@@ -275,6 +279,29 @@ _dwarf_destruct_macho_internals(
     free(mp);
     return;
 }
+/*  Frees the section bytes read by macho_load_section()
+    so a later load reads them from the file again. */
+void
+_dwarf_macho_unload_section(
+    struct Dwarf_Obj_Access_Interface_a_s *aip,
+    Dwarf_Unsigned section_index)
+{
+    dwarf_macho_object_access_internals_t *mp = 0;
+    struct generic_macho_section *sp = 0;
+
+    if (!aip) {
+        return;
+    }
+    mp = (dwarf_macho_object_access_internals_t *)aip->ai_object;
+    if (!section_index ||
+        section_index >= mp->mo_dwarf_sectioncount) {
+        return;
+    }
+    sp = mp->mo_dwarf_sections + section_index;
+    _dwarf_allocator_free(&mp->mo_allocator,sp->loaded_data);
+    sp->loaded_data = 0;
+}
+
 void
 _dwarf_destruct_macho_access(
     struct Dwarf_Obj_Access_Interface_a_s *aip)
@@ -860,6 +887,7 @@ _dwarf_macho_setup(int fd,
     unsigned groupnumber,
     Dwarf_Handler errhand,
     Dwarf_Ptr errarg,
+    const Dwarf_Allocator *alloc,
     Dwarf_Debug *dbg,Dwarf_Error *error)
 {
     Dwarf_Obj_Access_Interface_a *binary_interface = 0;
@@ -874,6 +902,7 @@ _dwarf_macho_setup(int fd,
         ftype,endian,offsetsize,
         &universalbinary_count,
         filesize,
+        alloc,
         &binary_interface,
         &localerrnum);
     if (res != DW_DLV_OK) {
@@ -885,8 +914,8 @@ _dwarf_macho_setup(int fd,
     }
     /*  allocates and initializes Dwarf_Debug,
         generic code */
-    res = dwarf_object_init_b(binary_interface, errhand, errarg,
-        groupnumber, dbg, error);
+    res = dwarf_object_init_alloc(binary_interface, alloc,
+        errhand, errarg, groupnumber, dbg, error);
     if (res != DW_DLV_OK){
         _dwarf_destruct_macho_access(binary_interface);
         return res;
@@ -1094,6 +1123,7 @@ _dwarf_macho_object_access_init(
     unsigned offsetsize,
     unsigned * universalbinary_count,
     Dwarf_Unsigned filesize,
+    const Dwarf_Allocator *alloc,
     Dwarf_Obj_Access_Interface_a **binary_interface,
     int *localerrnum)
 {
@@ -1109,6 +1139,7 @@ _dwarf_macho_object_access_init(
         return DW_DLV_ERROR;
     }
     memset(internals,0,sizeof(*internals));
+    _dwarf_choose_allocator(alloc,&internals->mo_allocator);
     res = _dwarf_macho_object_access_internals_init(internals,
         fd,
         uninumber,
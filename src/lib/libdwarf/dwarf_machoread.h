@@ -119,6 +119,8 @@ typedef struct dwarf_macho_filedata_s {
     const char *     mo_path; /* libdwarf must free.*/
     int              mo_fd;
     int              mo_destruct_close_fd; /*aka: lib owns fd */
+    /*  Used for loaded_data, see dwarf_set_allocator(). */
+    Dwarf_Allocator  mo_allocator;
     Dwarf_Unsigned   mo_filesize;
     Dwarf_Unsigned   mo_machine;
     Dwarf_Unsigned   mo_flags;
@@ -543,12 +543,7 @@ _dwarf_object_detector_fd_a(int fd,
     }
     /*  fileoffsetbase is non zero iff we have
         an Apple Universal Binary. */
-    res = _dwarf_seekr(fd,fileoffsetbase,SEEK_SET,0);
-    if (res != DW_DLV_OK) {
-        *errcode = DW_DLE_SEEK_ERROR;
-        return DW_DLV_ERROR;
-    }
-    res = _dwarf_readr(fd,(char *)&h,readlen,0);
+    res = _dwarf_preadr(fd,(char *)&h,fileoffsetbase,readlen,0);
     if (res != DW_DLV_OK) {
         *errcode = DW_DLE_READ_ERROR;
         return DW_DLV_ERROR;
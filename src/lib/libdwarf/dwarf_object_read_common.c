@@ -32,7 +32,6 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <config.h>
 #include <stddef.h> /* size_t */
-#include <stdio.h>  /* SEEK_END SEEK_SET */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -74,12 +73,52 @@ _dwarf_object_read_random(int fd, char *buf, Dwarf_Unsigned loc,
         *errc = DW_DLE_READ_OFF_END;
         return DW_DLV_ERROR;
     }
-    res = _dwarf_seekr(fd,loc,SEEK_SET,0);
+    /*  A positional read, so the shared fd offset
+        is neither used nor changed. */
+    res = _dwarf_preadr(fd,buf,loc,size,0);
     if (res != DW_DLV_OK) {
-        *errc = DW_DLE_SEEK_ERROR;
+        *errc = DW_DLE_READ_ERROR;
+        return DW_DLV_ERROR;
+    }
+    return DW_DLV_OK;
+}
+
+/*  Like _dwarf_object_read_random() but scatters
+    one contiguous range of the file (starting at loc)
+    into count buffers, using preadv() where available
+    so several sections can be read by one system call. */
+int
+_dwarf_object_readv_random(int fd, struct Dwarf_Read_Vec_s *vec,
+    unsigned count, Dwarf_Unsigned loc,
+    Dwarf_Unsigned filesize, int *errc)
+{
+    Dwarf_Unsigned endpoint = loc;
+    unsigned i = 0;
+    int res = 0;
+
+    for ( ; i < count; ++i) {
+        Dwarf_Unsigned newend = endpoint + vec[i].rv_len;
+
+        if (newend < endpoint) {
+            /*  Overflow!  The object is corrupt. */
+            *errc = DW_DLE_READ_OFF_END;
+            return DW_DLV_ERROR;
+        }
+        endpoint = newend;
+    }
+    if (endpoint == loc) {
+        /*  Nothing to read, which is not an error. */
+        return DW_DLV_OK;
+    }
+    if (loc >= filesize) {
+        *errc = DW_DLE_SEEK_OFF_END;
+        return DW_DLV_ERROR;
+    }
+    if (endpoint > filesize) {
+        *errc = DW_DLE_READ_OFF_END;
         return DW_DLV_ERROR;
     }
-    res = _dwarf_readr(fd,buf,size,0);
+    res = _dwarf_preadvr(fd,vec,count,loc);
     if (res != DW_DLV_OK) {
         *errc = DW_DLE_READ_ERROR;
         return DW_DLV_ERROR;
@@ -39,6 +39,9 @@ extern "C" {
 
 int _dwarf_object_read_random(int fd,char *buf,Dwarf_Unsigned loc,
     Dwarf_Unsigned size,Dwarf_Unsigned filesize,int *errc);
+int _dwarf_object_readv_random(int fd,
+    struct Dwarf_Read_Vec_s *vec, unsigned count,
+    Dwarf_Unsigned loc, Dwarf_Unsigned filesize,int *errc);
 
 #ifdef __cplusplus
 }
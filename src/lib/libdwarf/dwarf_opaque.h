@@ -85,6 +85,9 @@ struct Dwarf_Die_s {
     Dwarf_Unsigned    di_abbrev_code;
     /* TRUE if part of debug_info. FALSE if part of .debug_types. */
     Dwarf_Bool di_is_info;
+    /*  One more than the index of this DIE in the
+        cc_die_table if known, else zero. */
+    Dwarf_Unsigned di_table_index;
 };
 
 struct Dwarf_Attribute_s {
@@ -329,6 +332,9 @@ struct Dwarf_CU_Context_s {
     Dwarf_Byte_Ptr   cc_last_abbrev_endptr;
     Dwarf_Hash_Table cc_abbrev_hash_table;
     Dwarf_Unsigned   cc_highest_known_code;
+    /*  Flat table of the DIEs of this CU, built on
+        request. See dwarf_die_table.c */
+    struct Dwarf_Die_Table_s *cc_die_table;
     Dwarf_CU_Context cc_next;
 
     Dwarf_Bool cc_is_info;    /* TRUE means context is
@@ -447,6 +453,12 @@ struct Dwarf_Section_s {
         space for libdwarf.  */
     Dwarf_Small     dss_ignore_reloc_group_sec;
     char dss_is_rela;
+
+    /*  Value of de_section_use_clock at the most
+        recent _dwarf_load_section() call for this
+        section. Used to pick least-recently-used
+        sections in dwarf_evict_sections(). */
+    Dwarf_Unsigned  dss_last_use;
 };
 
 /*  Overview: if next_to_use== first, no error slots are used.
@@ -636,6 +648,31 @@ struct Dwarf_Debug_s {
         leave this zero. */
     Dwarf_Unsigned de_filesize;
 
+    /*  Section memory budget in bytes set by
+        dwarf_set_section_memory_budget(). Zero
+        means no budget.  de_section_use_clock ticks
+        on every _dwarf_load_section() call. */
+    Dwarf_Unsigned de_section_budget;
+    Dwarf_Unsigned de_section_use_clock;
+
+    /*  Copy of the allocator passed at init
+        (dwarf_init_path_alloc()) or else of the
+        dwarf_set_allocator() setting when this
+        Dwarf_Debug was created. All zero
+        means malloc()/free(). */
+    Dwarf_Allocator de_allocator;
+
+    /*  Sorted address to CU table for dwarf_find_cu_by_pc(),
+        built on first use. See dwarf_arange.c */
+    struct Dwarf_Pc_Cu_Table_s *de_pc_cu_table;
+
+#ifdef HAVE_PERF_STATS
+    /*  See dwarf_get_perf_stats(). Update only with
+        DW_PERF_ADD() so the counting compiles away
+        when HAVE_PERF_STATS is not defined. */
+    Dwarf_Perf_Stats de_perf_stats;
+#endif /* HAVE_PERF_STATS */
+
     /*  The value is what the object file encodes for
         the machine, In an  Elf Header, for example, its value
         comes from the e_machine field.
@@ -828,6 +865,14 @@ struct Dwarf_Debug_s {
     struct Dwarf_Tied_Data_s de_tied_data;
 };
 
+#ifdef HAVE_PERF_STATS
+#define DW_PERF_ADD(pa_dbg,pa_field,pa_n) \
+    ((pa_dbg)->de_perf_stats.pa_field += (pa_n))
+#else /* !HAVE_PERF_STATS */
+#define DW_PERF_ADD(pa_dbg,pa_field,pa_n)
+#endif /* HAVE_PERF_STATS */
+
+
 /* New style. takes advantage of dwarfstrings capability.
     This not a public function. */
 void  _dwarf_printf(Dwarf_Debug dbg, const char * data);
@@ -1042,9 +1087,16 @@ _dwarf_elf_nlsetup(int fd,
     unsigned groupnumber,
     Dwarf_Handler errhand,
     Dwarf_Ptr errarg,
+    const Dwarf_Allocator *alloc,
     Dwarf_Debug *dbg,Dwarf_Error *error);
 void _dwarf_destruct_elf_nlaccess(
     struct Dwarf_Obj_Access_Interface_a_s *aip);
+int _dwarf_elf_nlload_sections(
+    struct Dwarf_Obj_Access_Interface_a_s *aip,
+    Dwarf_Unsigned *indexes, unsigned count, int *errc);
+void _dwarf_elf_nlunload_section(
+    struct Dwarf_Obj_Access_Interface_a_s *aip,
+    Dwarf_Unsigned section_index);
 
 extern int _dwarf_macho_setup(int fd,
     char *true_path,
@@ -1056,9 +1108,13 @@ extern int _dwarf_macho_setup(int fd,
     unsigned groupnumber,
     Dwarf_Handler errhand,
     Dwarf_Ptr errarg,
+    const Dwarf_Allocator *alloc,
     Dwarf_Debug *dbg,Dwarf_Error *error);
 void _dwarf_destruct_macho_access(
     struct Dwarf_Obj_Access_Interface_a_s *aip);
+void _dwarf_macho_unload_section(
+    struct Dwarf_Obj_Access_Interface_a_s *aip,
+    Dwarf_Unsigned section_index);
 
 extern int _dwarf_pe_setup(int fd,
     char *path,
@@ -1069,9 +1125,13 @@ extern int _dwarf_pe_setup(int fd,
     unsigned groupnumber,
     Dwarf_Handler errhand,
     Dwarf_Ptr errarg,
+    const Dwarf_Allocator *alloc,
     Dwarf_Debug *dbg,Dwarf_Error *error);
 void _dwarf_destruct_pe_access(
     struct Dwarf_Obj_Access_Interface_a_s *aip);
+void _dwarf_pe_unload_section(
+    struct Dwarf_Obj_Access_Interface_a_s *aip,
+    Dwarf_Unsigned section_index);
 
 void _dwarf_create_address_size_dwarf_error(Dwarf_Debug dbg,
     Dwarf_Error *error,
@@ -1094,6 +1154,23 @@ Dwarf_Byte_Ptr _dwarf_calculate_info_section_start_ptr(
 
 Dwarf_Byte_Ptr _dwarf_calculate_info_section_end_ptr(
     Dwarf_CU_Context context);
+int _dwarf_next_die_info_ptr(Dwarf_Byte_Ptr die_info_ptr,
+    Dwarf_CU_Context cu_context,
+    Dwarf_Byte_Ptr die_info_end,
+    Dwarf_Byte_Ptr cu_info_start,
+    Dwarf_Bool want_AT_sibling,
+    Dwarf_Bool * has_die_child,
+    Dwarf_Byte_Ptr *next_die_ptr_out,
+    Dwarf_Abbrev_List *abbrev_list_out,
+    Dwarf_Error *error);
+int _dwarf_make_die_at(Dwarf_CU_Context cu_context,
+    Dwarf_Bool is_info,
+    Dwarf_Off offset,
+    Dwarf_Die * new_die,
+    Dwarf_Error * error);
+void _dwarf_free_die_table(Dwarf_CU_Context context);
+void _dwarf_die_table_note_related(Dwarf_Die from,
+    Dwarf_Die newdie, Dwarf_Bool is_child);
 Dwarf_Byte_Ptr _dwarf_calculate_abbrev_section_end_ptr(
     Dwarf_CU_Context context);
 
@@ -1102,8 +1179,28 @@ int  _dwarf_readr(int fd, char *buf, Dwarf_Unsigned size,
     Dwarf_Unsigned *sizeread);
 int  _dwarf_seekr(int fd, Dwarf_Unsigned loc, int seektype,
     Dwarf_Unsigned *out_loc);
+int  _dwarf_preadr(int fd, char *buf, Dwarf_Unsigned loc,
+    Dwarf_Unsigned size, Dwarf_Unsigned *sizeread);
+/*  One destination buffer for _dwarf_preadvr(). */
+struct Dwarf_Read_Vec_s {
+    char          *rv_buf;
+    Dwarf_Unsigned rv_len;
+};
+int  _dwarf_preadvr(int fd, struct Dwarf_Read_Vec_s *vec,
+    unsigned count, Dwarf_Unsigned loc);
 int  _dwarf_openr(const char *name);
 
+/*  See dwarf_set_allocator(). A Dwarf_Allocator with
+    a NULL da_malloc means malloc()/free().
+    _dwarf_choose_allocator() copies *requested to *out,
+    or the dwarf_set_allocator() default if requested
+    is NULL. */
+void  _dwarf_choose_allocator(const Dwarf_Allocator *requested,
+    Dwarf_Allocator *out);
+void *_dwarf_allocator_malloc(Dwarf_Allocator *a,
+    Dwarf_Unsigned len);
+void  _dwarf_allocator_free(Dwarf_Allocator *a, void *space);
+
 int _dwarf_formblock_internal(Dwarf_Debug dbg,
     Dwarf_Attribute attr,
     Dwarf_CU_Context cu_context,
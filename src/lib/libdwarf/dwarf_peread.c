@@ -75,6 +75,7 @@ static int _dwarf_pe_object_access_init(
     unsigned endian,
     unsigned offsetsize,
     size_t filesize,
+    const Dwarf_Allocator *alloc,
     Dwarf_Obj_Access_Interface_a **binary_interface,
     int *localerrnum);
 
@@ -393,7 +394,8 @@ pe_load_section (void *obj, Dwarf_Unsigned section_index,
             in the section were not written to disc.
             Malloc enough for the whole section, read in
             the bytes we have. */
-        sp->loaded_data = malloc((size_t)sp->VirtualSize);
+        sp->loaded_data = _dwarf_allocator_malloc(
+            &pep->pe_allocator,sp->VirtualSize);
         if (!sp->loaded_data) {
             *error = DW_DLE_ALLOC_FAIL;
             return DW_DLV_ERROR;
@@ -404,7 +406,8 @@ pe_load_section (void *obj, Dwarf_Unsigned section_index,
             pep->pe_filesize,
             error);
         if (res != DW_DLV_OK) {
-            free(sp->loaded_data);
+            _dwarf_allocator_free(&pep->pe_allocator,
+                sp->loaded_data);
             sp->loaded_data = 0;
             return res;
         }
@@ -420,6 +423,28 @@ pe_load_section (void *obj, Dwarf_Unsigned section_index,
     return DW_DLV_NO_ENTRY;
 }
 
+/*  Frees the section bytes read by pe_load_section()
+    so a later load reads them from the file again. */
+void
+_dwarf_pe_unload_section(
+    struct Dwarf_Obj_Access_Interface_a_s *aip,
+    Dwarf_Unsigned section_index)
+{
+    dwarf_pe_object_access_internals_t *pep = 0;
+    struct dwarf_pe_generic_image_section_header *sp = 0;
+
+    if (!aip) {
+        return;
+    }
+    pep = (dwarf_pe_object_access_internals_t*)(aip->ai_object);
+    if (!section_index || section_index >= pep->pe_section_count) {
+        return;
+    }
+    sp = pep->pe_sectionptr + section_index;
+    _dwarf_allocator_free(&pep->pe_allocator,sp->loaded_data);
+    sp->loaded_data = 0;
+}
+
 void
 _dwarf_destruct_pe_access(
     struct Dwarf_Obj_Access_Interface_a_s *aip)
@@ -443,7 +468,8 @@ _dwarf_destruct_pe_access(
         sp = pep->pe_sectionptr;
         for (i=0; i < pep->pe_section_count; ++i,++sp) {
             if (sp->loaded_data) {
-                free(sp->loaded_data);
+                _dwarf_allocator_free(&pep->pe_allocator,
+                    sp->loaded_data);
                 sp->loaded_data = 0;
             }
             free(sp->name);
@@ -825,6 +851,7 @@ _dwarf_pe_setup(int fd,
     unsigned groupnumber,
     Dwarf_Handler errhand,
     Dwarf_Ptr errarg,
+    const Dwarf_Allocator *alloc,
     Dwarf_Debug *dbg,Dwarf_Error *error)
 {
     Dwarf_Obj_Access_Interface_a *binary_interface = 0;
@@ -835,6 +862,7 @@ _dwarf_pe_setup(int fd,
     res = _dwarf_pe_object_access_init(
         fd,
         ftype,endian,offsetsize,filesize,
+        alloc,
         &binary_interface,
         &localerrnum);
     if (res != DW_DLV_OK) {
@@ -846,8 +874,8 @@ _dwarf_pe_setup(int fd,
     }
     /*  allocates and initializes Dwarf_Debug,
         generic code */
-    res = dwarf_object_init_b(binary_interface, errhand, errarg,
-        groupnumber, dbg, error);
+    res = dwarf_object_init_alloc(binary_interface, alloc,
+        errhand, errarg, groupnumber, dbg, error);
     if (res != DW_DLV_OK){
         _dwarf_destruct_pe_access(binary_interface);
         return res;
@@ -942,6 +970,7 @@ _dwarf_pe_object_access_init(
     unsigned endian,
     unsigned offsetsize,
     size_t filesize,
+    const Dwarf_Allocator *alloc,
     Dwarf_Obj_Access_Interface_a **binary_interface,
     int *localerrnum)
 {
@@ -957,6 +986,7 @@ _dwarf_pe_object_access_init(
         return DW_DLV_ERROR;
     }
     memset(internals,0,sizeof(*internals));
+    _dwarf_choose_allocator(alloc,&internals->pe_allocator);
     res = _dwarf_pe_object_access_internals_init(internals,
         fd,
         ftype, endian, offsetsize, filesize,
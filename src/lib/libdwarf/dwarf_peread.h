@@ -122,6 +122,8 @@ typedef struct pe_filedata_s {
     const char *     pe_path; /* must free.*/
     int              pe_fd;
     int              pe_destruct_close_fd; /*aka: lib owns fd */
+    /*  Used for loaded_data, see dwarf_set_allocator(). */
+    Dwarf_Allocator  pe_allocator;
     int              pe_is_64bit;
     Dwarf_Unsigned   pe_filesize;
     Dwarf_Unsigned   pe_flags;
@@ -62,6 +62,10 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <fcntl.h> /* open() O_RDONLY */
 #endif /* HAVE_FCNTL_H */
 
+#ifdef HAVE_PREADV
+#include <sys/uio.h> /* preadv() struct iovec */
+#endif /* HAVE_PREADV */
+
 #include "dwarf.h"
 #include "libdwarf.h"
 #include "libdwarf_private.h"
@@ -136,6 +140,154 @@ _dwarf_readr(int fd,
     return DW_DLV_OK;
 }
 
+/*  Positional read: reads size bytes at file offset loc
+    without using or changing the file offset of fd,
+    so two threads (or two Dwarf_Debug sharing an fd)
+    can read the same file concurrently.
+    Where pread() is not available (Windows) this
+    falls back to lseek() followed by read(). */
+int
+_dwarf_preadr(int fd,
+    char *buf,
+    Dwarf_Unsigned loc,
+    Dwarf_Unsigned size,
+    Dwarf_Unsigned *sizeread_out)
+{
+#if defined(_WIN32)
+    int res = 0;
+
+    res = _dwarf_seekr(fd,loc,SEEK_SET,0);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    return _dwarf_readr(fd,buf,size,sizeread_out);
+#else /* linux */
+    Dwarf_Signed rcode = 0;
+    Dwarf_Unsigned max_single_read = 0x1ffff000;
+    Dwarf_Unsigned remaining_bytes = size;
+    Dwarf_Unsigned totalsize = size;
+    Dwarf_Signed   sloc = 0;
+
+    sloc = (Dwarf_Signed)loc;
+    if (sloc < 0) {
+        return DW_DLV_ERROR;
+    }
+    while (remaining_bytes > 0) {
+        size = remaining_bytes;
+        if (size > max_single_read) {
+            size = max_single_read;
+        }
+        rcode = (Dwarf_Signed)pread(fd,buf,(size_t)size,
+            (off_t)loc);
+        if (rcode <= 0) {
+            return DW_DLV_ERROR;
+        }
+        /*  pread may legitimately return fewer bytes
+            than asked for, so just continue from there. */
+        remaining_bytes -= (Dwarf_Unsigned)rcode;
+        buf += rcode;
+        loc += (Dwarf_Unsigned)rcode;
+    }
+    if (sizeread_out) {
+        *sizeread_out = totalsize;
+    }
+    return DW_DLV_OK;
+#endif
+}
+
+/*  Vectored positional read: fills each of the
+    count buffers in turn from one contiguous range
+    of the file starting at loc.  With preadv()
+    up to DW_PREADV_MAX buffers are filled per
+    system call, otherwise each buffer gets its own
+    _dwarf_preadr().  Short reads are continued. */
+#define DW_PREADV_MAX 16
+int
+_dwarf_preadvr(int fd,
+    struct Dwarf_Read_Vec_s *vec,
+    unsigned count,
+    Dwarf_Unsigned loc)
+{
+#if defined(HAVE_PREADV) && !defined(_WIN32)
+    struct iovec iov[DW_PREADV_MAX];
+    unsigned cur = 0;
+    /*  Bytes of vec[cur] already read. */
+    Dwarf_Unsigned curdone = 0;
+    Dwarf_Signed   sloc = 0;
+
+    sloc = (Dwarf_Signed)loc;
+    if (sloc < 0) {
+        return DW_DLV_ERROR;
+    }
+    for (;;) {
+        int  iovcount = 0;
+        unsigned k = 0;
+        Dwarf_Signed rcode = 0;
+        Dwarf_Unsigned got = 0;
+
+        /*  Zero-length entries read nothing and are not
+            an error.  Skipping them here also means a vector
+            that is all zero-length never reaches preadv(),
+            whose 0 return would look like end-of-file. */
+        while (cur < count && !vec[cur].rv_len) {
+            ++cur;
+        }
+        if (cur >= count) {
+            break;
+        }
+        for (k = cur; k < count && iovcount < DW_PREADV_MAX; ++k) {
+            Dwarf_Unsigned off = (k == cur)? curdone:0;
+
+            if (!vec[k].rv_len) {
+                continue;
+            }
+            iov[iovcount].iov_base = vec[k].rv_buf + off;
+            iov[iovcount].iov_len = (size_t)(vec[k].rv_len - off);
+            ++iovcount;
+        }
+        rcode = (Dwarf_Signed)preadv(fd,iov,iovcount,(off_t)loc);
+        if (rcode <= 0) {
+            return DW_DLV_ERROR;
+        }
+        got = (Dwarf_Unsigned)rcode;
+        loc += got;
+        while (got > 0 && cur < count) {
+            Dwarf_Unsigned left = vec[cur].rv_len - curdone;
+
+            if (got < left) {
+                curdone += got;
+                got = 0;
+                break;
+            }
+            got -= left;
+            curdone = 0;
+            ++cur;
+            while (cur < count && !vec[cur].rv_len) {
+                ++cur;
+            }
+        }
+    }
+    return DW_DLV_OK;
+#else /* !HAVE_PREADV */
+    unsigned k = 0;
+
+    for ( ; k < count; ++k) {
+        int res = 0;
+
+        if (!vec[k].rv_len) {
+            continue;
+        }
+        res = _dwarf_preadr(fd,vec[k].rv_buf,loc,
+            vec[k].rv_len,0);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        loc += vec[k].rv_len;
+    }
+    return DW_DLV_OK;
+#endif /* HAVE_PREADV */
+}
+
 int
 _dwarf_seekr(int fd,
     Dwarf_Unsigned loc,
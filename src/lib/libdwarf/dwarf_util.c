@@ -141,6 +141,24 @@ dwarf_get_endian_copy_function(Dwarf_Debug dbg)
     return 0;
 }
 
+int
+dwarf_get_perf_stats(Dwarf_Debug dbg,
+    Dwarf_Perf_Stats *stats,
+    Dwarf_Error *error)
+{
+    CHECK_DBG(dbg,error,"dwarf_get_perf_stats()");
+#ifdef HAVE_PERF_STATS
+    if (!stats) {
+        return DW_DLV_NO_ENTRY;
+    }
+    *stats = dbg->de_perf_stats;
+    return DW_DLV_OK;
+#else /* !HAVE_PERF_STATS */
+    (void)stats;
+    return DW_DLV_NO_ENTRY;
+#endif /* HAVE_PERF_STATS */
+}
+
 Dwarf_Bool
 _dwarf_file_has_debug_fission_cu_index(Dwarf_Debug dbg)
 {
@@ -742,6 +760,7 @@ _dwarf_get_abbrev_for_code(Dwarf_CU_Context context,
         dbg->de_debug_abbrev.dss_data;
     Dwarf_Unsigned     hashable_val             = 0;
 
+    DW_PERF_ADD(dbg,ps_abbrev_lookups,1);
     if (!hash_table_base->tb_entries) {
         hash_table_base->tb_table_entry_count =
             HT_DEFAULT_TABLE_SIZE;
@@ -777,6 +796,7 @@ printf("debugging: initial size %u\n",HT_DEFAULT_TABLE_SIZE);
             results in no hash collisions whatever,
             so searching the list of collisions
             is normally very quick. */
+        DW_PERF_ADD(dbg,ps_abbrev_rehashes,1);
         newht->tb_table_entry_count =
             hash_table_base->tb_table_entry_count * HT_MULTIPLE;
 #ifdef TESTINGHASHTAB
@@ -822,7 +842,9 @@ printf("debugging: initial size %u\n",HT_DEFAULT_TABLE_SIZE);
     /* Determine if the 'code' is the list of synonyms already. */
     hash_abbrev_entry = entry_cur;
     for ( ; hash_abbrev_entry && hash_abbrev_entry->abl_code != code;
-        hash_abbrev_entry = hash_abbrev_entry->abl_next) {}
+        hash_abbrev_entry = hash_abbrev_entry->abl_next) {
+        DW_PERF_ADD(dbg,ps_abbrev_hash_probes,1);
+    }
     if (hash_abbrev_entry) {
         /*  This returns a pointer to an abbrev
             list entry, not the list itself. */
@@ -568,6 +568,16 @@ typedef struct Dwarf_Line_s*       Dwarf_Line;
 */
 typedef struct Dwarf_Global_s*     Dwarf_Global;
 
+/*! @typedef dwarf_global_callback_func
+
+    Used as a function pointer to a user-written
+    callback function for dwarf_iterate_globals_by_type().
+    Return DW_DLV_OK to continue, any other value
+    ends the iteration.
+*/
+typedef int (* dwarf_global_callback_func)
+    (Dwarf_Global /*global*/, void * /*user_data*/);
+
 /*! @typedef Dwarf_Type
     Used to reference a reference to an entry in
     the .debug_pubtypes section (as well as
@@ -765,6 +775,160 @@ struct Dwarf_Debug_Fission_Per_CU_s  {
 */
 typedef struct Dwarf_Rnglists_Head_s * Dwarf_Rnglists_Head;
 
+/*! @typedef Dwarf_Perf_Stats
+    Counters of internal libdwarf work done for
+    one Dwarf_Debug, filled in by dwarf_get_perf_stats().
+    The ps_alloc_count array is indexed by
+    DW_DLA number. DW_PERF_ALLOC_TYPE_COUNT is
+    one more than the largest DW_DLA number.
+*/
+#define DW_PERF_ALLOC_TYPE_COUNT 66
+typedef struct Dwarf_Perf_Stats_s {
+    Dwarf_Unsigned ps_sections_loaded;
+    Dwarf_Unsigned ps_section_bytes_loaded;
+    Dwarf_Unsigned ps_sections_decompressed;
+    /* Bytes after decompression */
+    Dwarf_Unsigned ps_section_bytes_decompressed;
+    Dwarf_Unsigned ps_alloc_count[DW_PERF_ALLOC_TYPE_COUNT];
+    Dwarf_Unsigned ps_alloc_bytes;
+    /* Calls to find an abbreviation by code */
+    Dwarf_Unsigned ps_abbrev_lookups;
+    /* Hash chain entries examined in those lookups */
+    Dwarf_Unsigned ps_abbrev_hash_probes;
+    Dwarf_Unsigned ps_abbrev_rehashes;
+    Dwarf_Unsigned ps_cu_context_lookups;
+    /* CU contexts examined in those lookups */
+    Dwarf_Unsigned ps_cu_context_list_steps;
+    /* Frame instruction sequences (CIE or FDE) executed */
+    Dwarf_Unsigned ps_frame_instr_executions;
+    Dwarf_Unsigned ps_line_program_executions;
+} Dwarf_Perf_Stats;
+
+/*! @typedef Dwarf_Allocator
+    Memory allocation functions an application may
+    provide (see dwarf_set_allocator()) to replace
+    malloc() and free() for the memory libdwarf
+    allocates on behalf of a Dwarf_Debug.
+    da_malloc must return memory aligned for any
+    type (as malloc() does) or NULL on failure.
+    da_free may be a no-op for an arena or bump
+    allocator that is released as a whole after
+    dwarf_finish().
+    The da_user_data pointer is passed unchanged to
+    both functions.
+*/
+typedef struct Dwarf_Allocator_s {
+    void * (*da_malloc)(void *da_user_data,
+        Dwarf_Unsigned da_length);
+    void   (*da_free)(void *da_user_data, void *da_space);
+    void *   da_user_data;
+} Dwarf_Allocator;
+
+/*! @typedef Dwarf_Loc_Expr_Stream
+    A cursor over the operators of one DWARF expression.
+    Operators are decoded one at a time straight from
+    the expression bytes, nothing is allocated.
+    Set up by dwarf_loc_expr_stream_init() or
+    dwarf_get_loclist_entry_by_pc() and advanced with
+    dwarf_loc_expr_stream_next().
+    Callers should treat the fields as read-only.
+*/
+typedef struct Dwarf_Loc_Expr_Stream_s {
+    Dwarf_Debug    es_dbg;
+    /* The expression bytes and their length. */
+    Dwarf_Small   *es_data;
+    Dwarf_Unsigned es_len;
+    /*  Operands are not read past this point
+        (the end of the containing section, if known). */
+    Dwarf_Small   *es_end;
+    /*  Byte offset (from es_data) and index of
+        the next operator. */
+    Dwarf_Unsigned es_offset;
+    Dwarf_Unsigned es_opnumber;
+    /*  Section offset of es_data, zero if not known. */
+    Dwarf_Unsigned es_section_offset;
+    /*  From dwarf_get_loclist_entry_by_pc(), the
+        section offset of the location list entry
+        itself, as dwarf_get_locdesc_entry_d() returns.
+        Zero otherwise. */
+    Dwarf_Unsigned es_locdesc_offset;
+    Dwarf_Half     es_version;
+    Dwarf_Half     es_offset_size;
+    Dwarf_Half     es_address_size;
+} Dwarf_Loc_Expr_Stream;
+
+/*! @typedef Dwarf_Expr_Callbacks
+    The machine state dwarf_expr_evaluate() needs,
+    supplied by the caller (a debugger, unwinder or
+    similar) as a table of functions.
+    Each function returns DW_DLV_OK with the value set,
+    DW_DLV_NO_ENTRY if the value is not available
+    (for example a register the unwinder did not recover),
+    or DW_DLV_ERROR.
+    A function may be NULL if the caller
+    cannot provide that value, evaluating an
+    expression that needs it is then an error.
+    ec_user_data is passed unchanged to every function.
+*/
+typedef struct Dwarf_Expr_Callbacks_s {
+    void * ec_user_data;
+    /*  The contents of DWARF register ec_regnum. */
+    int (*ec_read_register)(void *ec_user_data,
+        Dwarf_Unsigned ec_regnum, Dwarf_Unsigned *ec_value);
+    /*  ec_size (1 to 8) bytes of target memory at ec_addr,
+        as an unsigned value in target byte order. */
+    int (*ec_read_memory)(void *ec_user_data,
+        Dwarf_Addr ec_addr, Dwarf_Unsigned ec_size,
+        Dwarf_Unsigned *ec_value);
+    /*  The frame base (the value of the enclosing
+        function's DW_AT_frame_base), for DW_OP_fbreg. */
+    int (*ec_frame_base)(void *ec_user_data,
+        Dwarf_Addr *ec_value);
+    /*  The canonical frame address, for
+        DW_OP_call_frame_cfa. */
+    int (*ec_call_frame_cfa)(void *ec_user_data,
+        Dwarf_Addr *ec_value);
+    /*  The address of thread-local offset ec_offset, for
+        DW_OP_form_tls_address and DW_OP_GNU_push_tls_address. */
+    int (*ec_tls_address)(void *ec_user_data,
+        Dwarf_Unsigned ec_offset, Dwarf_Addr *ec_value);
+    /*  The address of the object being described, for
+        DW_OP_push_object_address. */
+    int (*ec_object_address)(void *ec_user_data,
+        Dwarf_Addr *ec_value);
+} Dwarf_Expr_Callbacks;
+
+/*! @typedef Dwarf_Expr_Piece
+    One piece of the location dwarf_expr_evaluate()
+    computes. An expression without DW_OP_piece
+    or DW_OP_bit_piece yields a single piece
+    with ep_size_bits zero (the whole object).
+*/
+typedef struct Dwarf_Expr_Piece_s {
+    /*  One of the DW_EXPR_LOC values. */
+    Dwarf_Small    ep_kind;
+    /*  The address (DW_EXPR_LOC_MEMORY), register
+        number (DW_EXPR_LOC_REGISTER), value
+        (DW_EXPR_LOC_VALUE) or byte length of
+        ep_block (DW_EXPR_LOC_IMPLICIT). */
+    Dwarf_Unsigned ep_value;
+    /*  For DW_EXPR_LOC_IMPLICIT, the DW_OP_implicit_value
+        bytes. Points into the object, do not free. */
+    Dwarf_Ptr      ep_block;
+    /*  Size and (for DW_OP_bit_piece) offset
+        of the piece, in bits. */
+    Dwarf_Unsigned ep_size_bits;
+    Dwarf_Unsigned ep_offset_bits;
+} Dwarf_Expr_Piece;
+
+/*! @brief No such DIE in a DIE table
+
+    The value dwarf_die_table_entry() returns for
+    a parent, sibling or first-child index that
+    does not exist.
+*/
+#define DW_DIE_TABLE_NO_INDEX (~(Dwarf_Unsigned)0)
+
 /*! @} endgroup allstructs */
 
 /*! @defgroup framedefines Default stack frame #defines
@@ -1388,9 +1552,12 @@ typedef struct Dwarf_Rnglists_Head_s * Dwarf_Rnglists_Head;
 #define DW_DLE_ARITHMETIC_OVERFLOW             501
 #define DW_DLE_UNIVERSAL_BINARY_ERROR          502
 #define DW_DLE_UNIV_BIN_OFFSET_SIZE_ERROR      503
+#define DW_DLE_EXPR_EVAL_ERROR                 504
+#define DW_DLE_PRO_SECTION_SINK_ERROR          505
+#define DW_DLE_ALLOCATOR_ERROR                 506
 
 /*! @note DW_DLE_LAST MUST EQUAL LAST ERROR NUMBER */
-#define DW_DLE_LAST        503
+#define DW_DLE_LAST        506
 #define DW_DLE_LO_USER     0x10000
 /*! @} */
 
@@ -1487,6 +1654,37 @@ DW_API int dwarf_init_path_a(const char * dw_path,
     Dwarf_Debug*      dw_dbg,
     Dwarf_Error*      dw_error);
 
+/*! @brief Initialization based on path with an allocator
+
+    This is identical to dwarf_init_path_a() except that
+    it adds a new argument, dw_allocator, giving the
+    allocation functions (see Dwarf_Allocator) for
+    this Dwarf_Debug and its object reader.
+    Unlike dwarf_set_allocator() nothing process-wide
+    is read or changed, so threads may each open
+    a Dwarf_Debug with their own allocator at the
+    same time.
+
+    @param dw_allocator
+    The struct is copied.
+    Pass NULL to use the dwarf_set_allocator() default
+    (normally malloc()/free()).
+    If exactly one of da_malloc and da_free is NULL
+    the call fails with DW_DLE_ALLOCATOR_ERROR.
+    The other arguments are as for dwarf_init_path_a().
+    @return DW_DLV_OK etc.
+*/
+DW_API int dwarf_init_path_alloc(const char * dw_path,
+    char *            dw_true_path_out_buffer,
+    unsigned int      dw_true_path_bufferlen,
+    unsigned int      dw_groupnumber,
+    unsigned int      dw_universalnumber,
+    const Dwarf_Allocator * dw_allocator,
+    Dwarf_Handler     dw_errhand,
+    Dwarf_Ptr         dw_errarg,
+    Dwarf_Debug*      dw_dbg,
+    Dwarf_Error*      dw_error);
+
 /*! @brief Initialization following GNU debuglink section data.
 
     Sets the true-path with DWARF if there is
@@ -1679,6 +1877,27 @@ DW_API int dwarf_object_init_b(Dwarf_Obj_Access_Interface_a* dw_obj,
     Dwarf_Debug*  dw_dbg,
     Dwarf_Error*  dw_error);
 
+/*! @brief Used to access DWARF information with an allocator
+
+    This is identical to dwarf_object_init_b() except
+    that the Dwarf_Debug uses the allocation functions
+    in *dw_allocator (copied) instead of the
+    dwarf_set_allocator() default.
+    Pass NULL for the default.
+    The object reader behind dw_obj is the
+    caller's and does its own allocation.
+    If exactly one of da_malloc and da_free is NULL
+    the call fails with DW_DLE_ALLOCATOR_ERROR.
+*/
+DW_API int dwarf_object_init_alloc(
+    Dwarf_Obj_Access_Interface_a* dw_obj,
+    const Dwarf_Allocator * dw_allocator,
+    Dwarf_Handler dw_errhand,
+    Dwarf_Ptr     dw_errarg,
+    unsigned int  dw_groupnumber,
+    Dwarf_Debug*  dw_dbg,
+    Dwarf_Error*  dw_error);
+
 /*! @brief Used to close the object_init dw_dbg.
 
     Close the dw_dbg opened by dwarf_object_init_b().
@@ -2043,6 +2262,148 @@ DW_API int dwarf_offdie_b(Dwarf_Debug dw_dbg,
     Dwarf_Die*       dw_return_die,
     Dwarf_Error*     dw_error);
 
+/*! @brief Build the flat DIE table of a CU
+
+    Reads every DIE of the CU containing dw_die
+    once, in order, recording for each its
+    offset, tag, abbreviation code, depth and
+    the table indexes of its parent, next sibling
+    and first child.
+    The table is kept with the CU until dwarf_finish()
+    and makes dwarf_die_parent() and the other
+    dwarf_die_table functions cheap.
+    Calling this is optional: those functions
+    build the table on first use.
+    Index zero is always the CU DIE.
+
+    @param dw_die
+    Any DIE of the CU of interest.
+    @param dw_entry_count
+    On success returns the number of DIEs
+    in the table (null DIEs are not counted).
+    @param dw_error
+    The usual Dwarf_Error*.
+    @return
+    DW_DLV_OK or DW_DLV_ERROR.
+*/
+DW_API int dwarf_die_table_build(Dwarf_Die dw_die,
+    Dwarf_Unsigned *dw_entry_count,
+    Dwarf_Error    *dw_error);
+
+/*! @brief Return the DIE table index of a DIE
+
+    For a DIE returned by dwarf_die_parent() or
+    dwarf_die_table_die() this is O(1), otherwise a
+    binary search of the table by offset.
+
+    @param dw_die
+    The DIE of interest.
+    @param dw_index
+    On success returns the index of dw_die in the
+    table of its CU.
+    @param dw_error
+    The usual Dwarf_Error*.
+    @return
+    DW_DLV_OK, DW_DLV_NO_ENTRY if the DIE is not
+    in the table (which should not happen), or
+    DW_DLV_ERROR.
+*/
+DW_API int dwarf_die_table_index(Dwarf_Die dw_die,
+    Dwarf_Unsigned *dw_index,
+    Dwarf_Error    *dw_error);
+
+/*! @brief Return the fields of a DIE table entry
+
+    Any of the output pointers may be NULL if that
+    field is not of interest.
+    The parent, sibling and first-child indexes
+    are DW_DIE_TABLE_NO_INDEX when there is
+    no such DIE.
+
+    @param dw_die
+    Any DIE of the CU of interest.
+    @param dw_index
+    The table index, less than the count
+    from dwarf_die_table_build().
+    @param dw_offset
+    Returns the section-global offset of the DIE.
+    @param dw_tag
+    Returns the DIE tag.
+    @param dw_abbrev_code
+    Returns the abbreviation code.
+    @param dw_depth
+    Returns the depth, zero for the CU DIE.
+    @param dw_parent
+    Returns the index of the parent DIE.
+    @param dw_sibling
+    Returns the index of the next sibling DIE.
+    @param dw_first_child
+    Returns the index of the first child DIE.
+    @param dw_error
+    The usual Dwarf_Error*.
+    @return
+    DW_DLV_OK, DW_DLV_NO_ENTRY if dw_index is not
+    less than the entry count, or DW_DLV_ERROR.
+*/
+DW_API int dwarf_die_table_entry(Dwarf_Die dw_die,
+    Dwarf_Unsigned  dw_index,
+    Dwarf_Off      *dw_offset,
+    Dwarf_Half     *dw_tag,
+    Dwarf_Unsigned *dw_abbrev_code,
+    Dwarf_Unsigned *dw_depth,
+    Dwarf_Unsigned *dw_parent,
+    Dwarf_Unsigned *dw_sibling,
+    Dwarf_Unsigned *dw_first_child,
+    Dwarf_Error    *dw_error);
+
+/*! @brief Return the DIE at a DIE table index
+
+    @param dw_die
+    Any DIE of the CU of interest.
+    @param dw_index
+    The table index.
+    @param dw_return_die
+    On success returns the DIE, to be freed
+    with dwarf_dealloc_die().
+    @param dw_error
+    The usual Dwarf_Error*.
+    @return
+    DW_DLV_OK, DW_DLV_NO_ENTRY if dw_index is not
+    less than the entry count, or DW_DLV_ERROR.
+*/
+DW_API int dwarf_die_table_die(Dwarf_Die dw_die,
+    Dwarf_Unsigned dw_index,
+    Dwarf_Die     *dw_return_die,
+    Dwarf_Error   *dw_error);
+
+/*! @brief Return the parent of a DIE
+
+    Uses the CU DIE table (building it if necessary)
+    so no walk of the CU is needed.
+    The parent is found in constant time for a DIE
+    returned by dwarf_die_table_die() or reached
+    from such a DIE by dwarf_child() or
+    dwarf_siblingof_c() once the table exists.
+    For any other DIE the first call does a binary
+    search of the table by offset (O(log n)),
+    and later calls on that Dwarf_Die are
+    constant time.
+
+    @param dw_die
+    The DIE of interest.
+    @param dw_return_parent
+    On success returns the parent DIE, to be freed
+    with dwarf_dealloc_die().
+    @param dw_error
+    The usual Dwarf_Error*.
+    @return
+    DW_DLV_OK, DW_DLV_NO_ENTRY if dw_die is the
+    CU DIE, or DW_DLV_ERROR.
+*/
+DW_API int dwarf_die_parent(Dwarf_Die dw_die,
+    Dwarf_Die   *dw_return_parent,
+    Dwarf_Error *dw_error);
+
 /*! @brief Return a DIE given a Dwarf_Sig8 hash.
 
     Returns DIE and is_info flag if it finds the hash
@@ -4585,6 +4946,192 @@ DW_API int dwarf_loclist_from_expr_c(Dwarf_Debug dw_dbg,
     Dwarf_Unsigned  * dw_listlen,
     Dwarf_Error     * dw_error);
 
+/*! @brief Find the location list entry covering a pc
+
+    New in 0.9.2.
+    A faster alternative to dwarf_get_loclist_c() for
+    the common question "where is this variable at
+    this pc". The location list entries are read
+    in place and only the entry whose cooked address range
+    [low,high) contains dw_pc is returned, as an
+    operator stream. Nothing is allocated.
+
+    If no bounded entry contains dw_pc a DWARF5
+    DW_LLE_default_location entry, if present, is
+    returned.
+    For a location expression (DW_LKIND_expression)
+    the expression applies to every pc so it is always
+    returned, with dw_lowpc_out zero and dw_highpc_out
+    the maximum address.
+    Entries whose addresses cannot be computed
+    (for example a missing .debug_addr in split dwarf)
+    are skipped.
+
+    @param dw_attr
+    The attribute must refer to a location expression
+    or a location list, as for dwarf_get_loclist_c().
+    @param dw_pc
+    The address of interest.
+    @param dw_lle_value_out
+    On success returns the DW_LLE value (real or
+    synthesized, as from dwarf_get_locdesc_entry_d())
+    of the entry found.
+    @param dw_lowpc_out
+    On success returns the cooked low address of the entry.
+    @param dw_highpc_out
+    On success returns the cooked high address of the entry.
+    @param dw_stream_out
+    Pass in a pointer to a Dwarf_Loc_Expr_Stream
+    (usually a local variable).
+    On success it is set to the start of the
+    entry's expression, ready for
+    dwarf_loc_expr_stream_next().
+    Its es_locdesc_offset is set to the section offset
+    of the entry found, including a
+    DW_LLE_default_location entry.
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    Returns DW_DLV_OK if an entry was found,
+    DW_DLV_NO_ENTRY if no entry covers dw_pc
+    (or there is no location data), or DW_DLV_ERROR.
+*/
+DW_API int dwarf_get_loclist_entry_by_pc(Dwarf_Attribute dw_attr,
+    Dwarf_Addr       dw_pc,
+    Dwarf_Small    * dw_lle_value_out,
+    Dwarf_Addr     * dw_lowpc_out,
+    Dwarf_Addr     * dw_highpc_out,
+    Dwarf_Loc_Expr_Stream * dw_stream_out,
+    Dwarf_Error    * dw_error);
+
+/*! @brief Set up an operator stream on expression bytes
+
+    New in 0.9.2.
+    The allocation-free counterpart of
+    dwarf_loclist_from_expr_c().
+
+    @param dw_dbg
+    The applicable Dwarf_Debug
+    @param dw_expression_in
+    Pass in a pointer to the expression bytes.
+    @param dw_expression_length
+    Pass in the length, in bytes, of the expression.
+    @param dw_address_size
+    Pass in the applicable address_size.
+    @param dw_offset_size
+    Pass in the applicable offset size.
+    @param dw_dwarf_version
+    Pass in the applicable dwarf version.
+    @param dw_stream_out
+    Pass in a pointer to a Dwarf_Loc_Expr_Stream,
+    it is set to the first operator.
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    Returns DW_DLV_OK or DW_DLV_ERROR.
+*/
+DW_API int dwarf_loc_expr_stream_init(Dwarf_Debug dw_dbg,
+    Dwarf_Ptr      dw_expression_in,
+    Dwarf_Unsigned dw_expression_length,
+    Dwarf_Half     dw_address_size,
+    Dwarf_Half     dw_offset_size,
+    Dwarf_Half     dw_dwarf_version,
+    Dwarf_Loc_Expr_Stream * dw_stream_out,
+    Dwarf_Error  * dw_error);
+
+/*! @brief Decode the next operator of an operator stream
+
+    The values returned are exactly those
+    dwarf_get_location_op_value_c() returns
+    for the same operator.
+
+    @param dw_stream
+    A stream set up by dwarf_loc_expr_stream_init() or
+    dwarf_get_loclist_entry_by_pc().
+    @param dw_operator_out
+    On success returns the DW_OP operator, such as DW_OP_plus .
+    @param dw_operand1
+    On success returns the value of the operand or zero.
+    @param dw_operand2
+    On success returns the value of the operand or zero.
+    @param dw_operand3
+    On success returns the value of the operand or zero.
+    @param dw_offset_for_branch
+    On success returns the byte offset of the
+    operator within the expression.
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    Returns DW_DLV_OK and advances the stream,
+    DW_DLV_NO_ENTRY at the end of the expression,
+    or DW_DLV_ERROR.
+*/
+DW_API int dwarf_loc_expr_stream_next(
+    Dwarf_Loc_Expr_Stream * dw_stream,
+    Dwarf_Small    * dw_operator_out,
+    Dwarf_Unsigned * dw_operand1,
+    Dwarf_Unsigned * dw_operand2,
+    Dwarf_Unsigned * dw_operand3,
+    Dwarf_Unsigned * dw_offset_for_branch,
+    Dwarf_Error    * dw_error);
+
+#define DW_EXPR_LOC_EMPTY    0 /* No location, optimized out */
+#define DW_EXPR_LOC_MEMORY   1 /* ep_value is an address */
+#define DW_EXPR_LOC_REGISTER 2 /* ep_value is a register number */
+#define DW_EXPR_LOC_VALUE    3 /* DW_OP_stack_value */
+#define DW_EXPR_LOC_IMPLICIT 4 /* DW_OP_implicit_value */
+
+/*! @brief Evaluate a location description
+
+    New in 0.9.2.
+    Runs the DWARF expression of dw_locdesc
+    (as returned by dwarf_get_locdesc_entry_d())
+    against the machine state the caller's
+    callback table provides and returns
+    where the object is.
+
+    The common single-operator forms
+    (DW_OP_addr, DW_OP_addrx, DW_OP_regN, DW_OP_regx,
+    DW_OP_bregN, DW_OP_bregx, DW_OP_fbreg,
+    DW_OP_call_frame_cfa, a constant with DW_OP_stack_value)
+    and DW_OP_piece sequences of them are recognized
+    the first time dw_locdesc is evaluated and from then
+    on are computed directly, without running
+    the stack machine.
+
+    The DWARF5 typed-stack operators, DW_OP_call*,
+    DW_OP_entry_value, DW_OP_implicit_pointer and
+    DW_OP_xderef* are not supported and
+    result in DW_DLV_ERROR.
+
+    @param dw_locdesc
+    The location description to evaluate.
+    @param dw_callbacks
+    The caller's machine state functions.
+    @param dw_pieces
+    Pass in an array of dw_pieces_max entries.
+    On success the location is returned in the
+    first *dw_piece_count of them.
+    There are never more pieces than there are operators
+    in the expression.
+    @param dw_pieces_max
+    The number of entries in dw_pieces.
+    @param dw_piece_count
+    On success returns the number of pieces,
+    at least one.
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    Returns DW_DLV_OK, DW_DLV_NO_ENTRY if a callback
+    returned DW_DLV_NO_ENTRY, or DW_DLV_ERROR.
+*/
+DW_API int dwarf_expr_evaluate(Dwarf_Locdesc_c dw_locdesc,
+    const Dwarf_Expr_Callbacks * dw_callbacks,
+    Dwarf_Expr_Piece * dw_pieces,
+    Dwarf_Unsigned     dw_pieces_max,
+    Dwarf_Unsigned   * dw_piece_count,
+    Dwarf_Error      * dw_error);
+
 /*! @brief Dealloc (free) all memory allocated for Dwarf_Loc_Head_c
     @param dw_head
     A head pointer.
@@ -6995,6 +7542,76 @@ DW_API int dwarf_get_arange(Dwarf_Arange* dw_aranges,
     Dwarf_Arange *   dw_returned_arange,
     Dwarf_Error*     dw_error);
 
+/*! @brief Find the CU containing a code address
+
+    On the first call libdwarf builds a table, sorted by
+    address, of the .debug_aranges entries plus the
+    DW_AT_ranges or DW_AT_low_pc/DW_AT_high_pc of
+    each CU in .debug_info that has no aranges
+    (so missing or incomplete .debug_aranges
+    are not a problem). Each lookup is then a
+    binary search.
+    The table is freed by dwarf_finish().
+
+    Where the ranges of different CUs overlap (which
+    is not valid DWARF) the CU whose range starts
+    first is returned.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_pc
+    Pass in the code address of interest.
+    @param dw_cu_die_offset
+    On success returns the .debug_info section offset
+    of the CU DIE of the CU containing dw_pc.
+    Use dwarf_offdie_b() to get the CU DIE itself.
+    @param dw_error
+    On error dw_error is set to point to the error details.
+    @return
+    The usual value: DW_DLV_OK etc.
+    Returns DW_DLV_NO_ENTRY if no CU contains dw_pc.
+*/
+DW_API int dwarf_find_cu_by_pc(Dwarf_Debug dw_dbg,
+    Dwarf_Addr       dw_pc,
+    Dwarf_Off *      dw_cu_die_offset,
+    Dwarf_Error*     dw_error);
+
+/*! @brief Find the CUs containing many code addresses
+
+    As dwarf_find_cu_by_pc() but for an array of
+    addresses.  If the array is sorted in increasing
+    address order each lookup usually takes a few
+    steps forward from the previous one.
+    Unsorted arrays work too, just more slowly.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_pc_count
+    Pass in the number of addresses in dw_pcs.
+    @param dw_pcs
+    Pass in the array of code addresses.
+    @param dw_cu_die_offsets
+    Pass in an array of dw_pc_count entries.
+    On success dw_cu_die_offsets[i] is set to
+    the CU DIE offset for dw_pcs[i], or zero if
+    no CU contains dw_pcs[i].
+    @param dw_found_count
+    If non-null, on success returns the number of
+    addresses that were found.
+    @param dw_error
+    On error dw_error is set to point to the error details.
+    @return
+    The usual value: DW_DLV_OK etc.
+    Returns DW_DLV_NO_ENTRY if none of the addresses
+    are in a CU.
+*/
+DW_API int dwarf_find_cus_by_pcs(Dwarf_Debug dw_dbg,
+    Dwarf_Unsigned    dw_pc_count,
+    const Dwarf_Addr *dw_pcs,
+    Dwarf_Off *       dw_cu_die_offsets,
+    Dwarf_Unsigned *  dw_found_count,
+    Dwarf_Error*      dw_error);
+
 /*! @brief Given an arange return its CU DIE offset.
 
     @param dw_arange
@@ -7155,6 +7772,53 @@ DW_API int dwarf_globals_by_type(Dwarf_Debug dw_dbg,
     Dwarf_Signed   *dw_count,
     Dwarf_Error    *dw_error);
 
+/*! @brief Visit Fast Access DWARF2-DWARF5 entries one at a time
+
+    New in 0.9.2.
+    Reads the same entries, in the same order, as
+    dwarf_globals_by_type() but passes each one to
+    dw_callback as it is read from the section instead of
+    building an array, so no space is allocated per entry.
+    The callback may end the iteration early by returning
+    anything other than DW_DLV_OK.
+
+    The Dwarf_Global passed to the callback is only
+    valid during that call. All the functions taking
+    a Dwarf_Global (dwarf_globname(),
+    dwarf_global_name_offsets() etc) may be used on it,
+    but it must not be passed to dwarf_dealloc()
+    or saved for later use.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_requested_section
+    Pass in one of the values DW_GL_GLOBALS through
+    DW_GL_WEAKS to select the section to read,
+    exactly as for dwarf_globals_by_type().
+    @param dw_callback
+    The function called for each entry.
+    @param dw_user_data
+    Passed unchanged to each dw_callback call.
+    @param dw_count
+    If non-null, on return the number of entries
+    passed to dw_callback is returned through the pointer.
+    @param dw_error
+    On error dw_error is set to point to the error details.
+    @return
+    Returns DW_DLV_OK if at least one entry was passed
+    to dw_callback (whether or not the callback ended the
+    iteration), DW_DLV_NO_ENTRY if there were no entries,
+    or DW_DLV_ERROR.
+    On error the callback may already have been
+    called for some entries.
+*/
+DW_API int dwarf_iterate_globals_by_type(Dwarf_Debug dw_dbg,
+    int             dw_requested_section,
+    dwarf_global_callback_func dw_callback,
+    void           *dw_user_data,
+    Dwarf_Unsigned *dw_count,
+    Dwarf_Error    *dw_error);
+
 /*! @brief Dealloc the Dwarf_Global  data
 
     @param dw_dbg
@@ -8988,6 +9652,146 @@ DW_API int dwarf_machine_architecture(Dwarf_Debug dw_dbg,
 */
 DW_API Dwarf_Unsigned dwarf_get_section_count(Dwarf_Debug dw_dbg);
 
+/*! @brief Load a set of DWARF sections in one step.
+
+    Normally each section is read from the object
+    the first time some function needs it.
+    An application that knows it will need several
+    sections (for example .debug_info, .debug_abbrev,
+    .debug_str and .debug_line) can call this right after
+    initialization so they are all read at once.
+    For Elf objects sections adjacent in the file
+    are read with a single vectored read (preadv)
+    where the platform has one.
+
+    All object reads in libdwarf are positional (pread)
+    where available, so the file offset of the
+    object's file descriptor is not used or changed.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_section_names
+    Pass in an array of section names such as
+    ".debug_info" (the standard name or the actual
+    name in the object) or pass NULL to load every
+    DWARF section libdwarf knows of in this object.
+    @param dw_section_count
+    The number of entries in dw_section_names.
+    Ignored if dw_section_names is NULL.
+    @param dw_error
+    On error returns the error usual details.
+    @return
+    DW_DLV_OK if at least one section was loaded.
+    DW_DLV_NO_ENTRY if there was nothing to load
+    (no such sections or all already loaded).
+*/
+DW_API int dwarf_load_sections(Dwarf_Debug dw_dbg,
+    const char   ** dw_section_names,
+    Dwarf_Unsigned  dw_section_count,
+    Dwarf_Error   * dw_error);
+
+/*! @brief Set a memory budget for loaded sections.
+
+    Long-running applications that keep many
+    Dwarf_Debug open can trim the memory used
+    by a few sections at points of their choosing.
+    Sections are loaded on first
+    use as always.  When the application calls
+    dwarf_evict_sections() the least recently used
+    sections that can be safely reloaded are freed
+    until the total is within the budget.
+    A freed section is read again (transparently)
+    the next time something needs it.
+
+    This is an explicit trim, not a bound on memory:
+    the budget is only consulted by
+    dwarf_evict_sections(), loading a section
+    never evicts another, and the total can stay
+    over the budget after the call.
+    Only sections that libdwarf keeps no internal
+    pointers into are evicted:
+    .debug_ranges, .debug_aranges and .debug_macinfo,
+    and never one that had relocations applied.
+    Every other section (.debug_info, .debug_line,
+    .debug_loc, .debug_loclists, .debug_abbrev and
+    the rest) stays resident until dwarf_finish().
+    .debug_str and .debug_line_str are never evicted
+    as line tables and Dwarf_Global records
+    point into them.
+    With an object reader that cannot free
+    individual sections (such as a libelf-based reader)
+    only section data libdwarf itself allocated
+    (decompressed data) is freed.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_budget
+    The budget in bytes. Zero (the default) means
+    no budget: dwarf_evict_sections() does nothing.
+    @param dw_old_budget
+    If non-null the previous budget is returned through it.
+    @param dw_error
+    The usual error pointer.
+    @return
+    DW_DLV_OK unless dw_dbg is invalid.
+*/
+DW_API int dwarf_set_section_memory_budget(Dwarf_Debug dw_dbg,
+    Dwarf_Unsigned   dw_budget,
+    Dwarf_Unsigned * dw_old_budget,
+    Dwarf_Error    * dw_error);
+
+/*! @brief Free sections to get within the budget.
+
+    Call this only at a point where the application
+    holds no pointers into the evictable
+    sections listed for dwarf_set_section_memory_budget(),
+    as those become invalid.
+    libdwarf never evicts sections on its own.
+    The least recently used order is that of
+    the last load request: every libdwarf reader
+    of the three evictable sections requests the
+    section load on entry.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_bytes_released
+    On success returns the number of bytes
+    actually freed.
+    @param dw_error
+    The usual error pointer.
+    @return
+    DW_DLV_OK if something was freed,
+    DW_DLV_NO_ENTRY if no budget is set or
+    nothing could be (or needed to be) freed.
+*/
+DW_API int dwarf_evict_sections(Dwarf_Debug dw_dbg,
+    Dwarf_Unsigned * dw_bytes_released,
+    Dwarf_Error    * dw_error);
+
+/*! @brief Report memory held for loaded sections.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_section_name
+    A section name such as ".debug_info"
+    or NULL to get the total over all
+    DWARF sections.
+    @param dw_resident_bytes
+    On success returns the number of bytes
+    currently held for the section(s),
+    zero if not loaded.  A decompressed section
+    counts both its compressed and decompressed size.
+    @param dw_error
+    The usual error pointer.
+    @return
+    DW_DLV_OK, or DW_DLV_NO_ENTRY if the
+    named section is not in the object.
+*/
+DW_API int dwarf_get_section_resident_bytes(Dwarf_Debug dw_dbg,
+    const char     * dw_section_name,
+    Dwarf_Unsigned * dw_resident_bytes,
+    Dwarf_Error    * dw_error);
+
 /*! @brief Get section sizes for many sections.
 
     The list of sections is incomplete and the argument list
@@ -9213,6 +10017,37 @@ DW_API int dwarf_set_stringcheck(int dw_stringcheck);
 */
 DW_API int dwarf_set_reloc_application(int dw_apply);
 
+/*! @brief Get internal performance counters
+
+    Reports counts of internal work (section loads,
+    allocations by DW_DLA type, abbreviation
+    and CU lookups, frame and line program executions)
+    done for this Dwarf_Debug since it was opened.
+    Useful to learn why processing a particular
+    object is slow.
+
+    The counters exist only if libdwarf was built
+    with perf stats enabled (the default; see
+    the cmake option ENABLE_PERF_STATS, configure
+    option --disable-perf-stats, meson option perf_stats).
+    When disabled they cost nothing and this returns
+    DW_DLV_NO_ENTRY.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_stats
+    Pass in a pointer to a Dwarf_Perf_Stats
+    and on success it is filled in.
+    @param dw_error
+    The usual error pointer.
+    @return
+    DW_DLV_OK, or DW_DLV_NO_ENTRY if the counters
+    are not compiled in.
+*/
+DW_API int dwarf_get_perf_stats(Dwarf_Debug dw_dbg,
+    Dwarf_Perf_Stats *dw_stats,
+    Dwarf_Error      *dw_error);
+
 /*! @brief Get a pointer to the applicable swap/noswap function
 
     the function pointer returned enables libdwarf users
@@ -9280,6 +10115,55 @@ DW_API void dwarf_record_cmdline_options(
 */
 DW_API int dwarf_set_de_alloc_flag(int dw_v);
 
+/*! @brief Set the default allocator for new Dwarf_Debug instances
+
+    Independent of any Dwarf_Debug.
+    The default in effect when a dwarf_init*() or
+    dwarf_object_init_b() call creates a Dwarf_Debug
+    is recorded in that Dwarf_Debug (and its object
+    reader) and used for it until dwarf_finish(),
+    so changing the default never affects an
+    open Dwarf_Debug.
+    To give each Dwarf_Debug its own allocator
+    pass it to dwarf_init_path_alloc() or
+    dwarf_object_init_alloc() instead, which
+    do not read or change this default.
+
+    The allocator is used for the Dwarf_Debug itself,
+    for everything returned by libdwarf that is
+    freed with dwarf_dealloc(), and for section data
+    (as read from the object file or decompressed).
+    Smaller temporary buffers internal to libdwarf
+    still use malloc().
+
+    The setting itself is a single process-wide
+    variable with no locking, read by every
+    dwarf_init*() call not given an allocator.
+    Call dwarf_set_allocator() before any other
+    libdwarf call, normally once at program start,
+    or not at all.
+    Memory a caller-provided object reader
+    (see dwarf_object_init_b()) allocates is
+    up to that reader.
+
+    @param dw_allocator
+    Pass in a pointer to the functions to use.
+    The struct is copied.
+    Pass NULL to restore the default malloc()/free().
+    @param dw_old_allocator
+    If non-NULL the previous allocator is
+    returned through the pointer.
+    @return
+    Returns DW_DLV_OK, or DW_DLV_ERROR (changing nothing)
+    if dw_allocator is non-NULL and exactly one of
+    da_malloc and da_free is NULL.
+    A Dwarf_Allocator with both NULL (as returned
+    via dw_old_allocator when the default was
+    in effect) also means malloc()/free().
+*/
+DW_API int dwarf_set_allocator(const Dwarf_Allocator *dw_allocator,
+    Dwarf_Allocator *dw_old_allocator);
+
 /*! @brief Set the address size on a Dwarf_Debug
 
     DWARF information CUs and other
@@ -71,11 +71,136 @@
 #define BLOCK_TO_LIST(blk) \
     ((memory_list_t*) (((char*)blk) - sizeof(memory_list_t)))
 
+/*  Blocks up to P_ARENA_MAX_BLOCK bytes (nearly every
+    DIE, attribute, expression and string) are instead
+    carved from P_ARENA_CHUNK_SIZE chunks owned by the dbg,
+    which saves a malloc() and the list insertion per
+    block and lets _dwarf_p_dealloc_all() free a few
+    hundred chunks rather than every block.
+    Arena blocks keep the memory_list_t prefix, with
+    both pointers zero (no list block ever has that),
+    so _dwarf_p_dealloc() knows to leave them for
+    _dwarf_p_dealloc_all(). Larger blocks (section
+    buffers mostly) stay on the list as before so they
+    can be freed individually. */
+#define P_ARENA_CHUNK_SIZE (64*1024)
+#define P_ARENA_MAX_BLOCK  (4*1024)
+#define P_ARENA_ALIGN      16
+
+struct Dwarf_P_Arena_Chunk_s {
+    struct Dwarf_P_Arena_Chunk_s *ac_next;
+};
+/*  Chunk header rounded up so blocks keep P_ARENA_ALIGN. */
+#define P_ARENA_HDR ((sizeof(struct Dwarf_P_Arena_Chunk_s) + \
+    P_ARENA_ALIGN-1) & ~(Dwarf_Unsigned)(P_ARENA_ALIGN-1))
+
+/*  See dwarf_pro_set_allocator(). Copied into each
+    Dwarf_P_Debug created without an allocator of
+    its own (see dwarf_producer_init_alloc()).
+    All zero means malloc()/free(). */
+static Dwarf_Allocator global_pro_allocator;
+
+int
+dwarf_pro_set_allocator(const Dwarf_Allocator *newalloc,
+    Dwarf_Allocator *oldalloc)
+{
+    if (newalloc && (!newalloc->da_malloc != !newalloc->da_free)) {
+        /* Only one of the pair provided. */
+        return DW_DLV_ERROR;
+    }
+    if (oldalloc) {
+        *oldalloc = global_pro_allocator;
+    }
+    if (newalloc) {
+        global_pro_allocator = *newalloc;
+    } else {
+        memset(&global_pro_allocator,0,
+            sizeof(global_pro_allocator));
+    }
+    return DW_DLV_OK;
+}
+
+void
+_dwarf_p_choose_allocator(const Dwarf_Allocator *requested,
+    Dwarf_Allocator *out)
+{
+    if (requested) {
+        *out = *requested;
+        return;
+    }
+    *out = global_pro_allocator;
+}
+
+static void *
+p_allocator_malloc(Dwarf_Allocator *a, Dwarf_Unsigned len)
+{
+    if (a->da_malloc) {
+        return a->da_malloc(a->da_user_data,len);
+    }
+    return malloc((size_t)len);
+}
+
+static void
+p_allocator_free(Dwarf_Allocator *a, void *space)
+{
+    if (a->da_free) {
+        a->da_free(a->da_user_data,space);
+        return;
+    }
+    free(space);
+}
+
+static memory_list_t *
+p_arena_alloc(Dwarf_P_Debug dbg, Dwarf_Unsigned len)
+{
+    char *ret = 0;
+
+    len = (len + P_ARENA_ALIGN-1) &
+        ~(Dwarf_Unsigned)(P_ARENA_ALIGN-1);
+    if (len > dbg->de_arena_left) {
+        struct Dwarf_P_Arena_Chunk_s *c = 0;
+
+        /*  The rest of the current chunk is abandoned,
+            at most P_ARENA_MAX_BLOCK bytes. */
+        c = (struct Dwarf_P_Arena_Chunk_s *)p_allocator_malloc(
+            &dbg->de_allocator,P_ARENA_CHUNK_SIZE);
+        if (!c) {
+            return NULL;
+        }
+        c->ac_next = dbg->de_arena_chunks;
+        dbg->de_arena_chunks = c;
+        dbg->de_arena_next = (char *)c + P_ARENA_HDR;
+        dbg->de_arena_left = P_ARENA_CHUNK_SIZE - P_ARENA_HDR;
+    }
+    ret = dbg->de_arena_next;
+    dbg->de_arena_next += len;
+    dbg->de_arena_left -= len;
+    return (memory_list_t *)ret;
+}
+
 /*
-  dbg should be NULL only when allocating dbg itself.  In that
-  case we initialize it to an empty circular doubly-linked list.
+  Allocates the dbg itself with alloc, which
+  dwarf_producer_init_alloc() then records in the dbg.
+  We initialize it to an empty circular doubly-linked list.
 */
+Dwarf_Ptr
+_dwarf_p_get_debug_alloc(Dwarf_Allocator *alloc, Dwarf_Unsigned size)
+{
+    memory_list_t *lp = NULL;
+    void *sp = 0;
+
+    lp = (memory_list_t *) p_allocator_malloc(alloc,
+        size + sizeof(memory_list_t));
+    if (lp == NULL) {
+        return NULL;
+    }
+    sp = LIST_TO_BLOCK(lp);
+    memset(sp, 0, size);
+    lp->next = lp->prev = lp;
+    return sp;
+}
 
+/*  The dbg itself comes from _dwarf_p_get_debug_alloc(). */
 Dwarf_Ptr
 _dwarf_p_get_alloc(Dwarf_P_Debug dbg, Dwarf_Unsigned size)
 {
@@ -84,9 +209,24 @@ _dwarf_p_get_alloc(Dwarf_P_Debug dbg, Dwarf_Unsigned size)
     memory_list_t *dbglp = NULL;
     memory_list_t *nextblock = NULL;
 
+    if (!dbg) {
+        return NULL;
+    }
+    if (size <= P_ARENA_MAX_BLOCK) {
+        lp = p_arena_alloc(dbg,size + sizeof(memory_list_t));
+        if (lp == NULL) {
+            return NULL;
+        }
+        lp->next = lp->prev = 0;
+        sp = LIST_TO_BLOCK(lp);
+        memset(sp, 0, size);
+        return sp;
+    }
     /*  Alloc control struct and data block together
         for performance reasons */
-    lp = (memory_list_t *) malloc(size + sizeof(memory_list_t));
+    lp = (memory_list_t *) p_allocator_malloc(
+        &dbg->de_allocator,
+        size + sizeof(memory_list_t));
     if (lp == NULL) {
         /* should throw an error */
         return NULL;
@@ -94,32 +234,32 @@ _dwarf_p_get_alloc(Dwarf_P_Debug dbg, Dwarf_Unsigned size)
     /* point to 'size' bytes just beyond lp struct */
     sp = LIST_TO_BLOCK(lp);
     memset(sp, 0, size);
-    if (dbg == NULL) {
-        lp->next = lp->prev = lp;
-    } else {
-        /* I always have to draw a picture to understand this part. */
-
-        dbglp = BLOCK_TO_LIST(dbg);
-        nextblock = dbglp->next;
+    /* I always have to draw a picture to understand this part. */
+    dbglp = BLOCK_TO_LIST(dbg);
+    nextblock = dbglp->next;
 
-        /* Insert between dbglp and nextblock */
-        dbglp->next = lp;
-        lp->prev = dbglp;
-        lp->next = nextblock;
-        nextblock->prev = lp;
-    }
+    /* Insert between dbglp and nextblock */
+    dbglp->next = lp;
+    lp->prev = dbglp;
+    lp->next = nextblock;
+    nextblock->prev = lp;
     return sp;
 }
 
 /*
-  The dbg structure is not needed here anymore.
+  The dbg structure is needed only for its allocator.
 */
 void
-_dwarf_p_dealloc(Dwarf_Small * ptr) /* ARGSUSED */
+_dwarf_p_dealloc(Dwarf_P_Debug dbg, Dwarf_Small * ptr)
 {
     memory_list_t *lp;
 
     lp = BLOCK_TO_LIST(ptr);
+    if (!lp->next && !lp->prev) {
+        /*  An arena block, freed with its chunk in
+            _dwarf_p_dealloc_all(). */
+        return;
+    }
     /*  Remove from a doubly linked, circular list.
         Read carefully, use a white board if necessary.
         If this is an empty list, the following
@@ -144,7 +284,7 @@ _dwarf_p_dealloc(Dwarf_Small * ptr) /* ARGSUSED */
         lp->next->prev = lp->prev;
         lp->prev = lp->next = 0;
     }
-    free((void*)lp);
+    p_allocator_free(&dbg->de_allocator,(void*)lp);
 }
 
 static void
@@ -155,6 +295,7 @@ _dwarf_str_hashtab_freenode(void * nodep)
 
 /*
   This routine deallocates all the nodes on the dbg list,
+  then the arena chunks,
   and then deallocates the dbg structure itself.
 */
 
@@ -163,6 +304,8 @@ _dwarf_p_dealloc_all(Dwarf_P_Debug dbg)
 {
     memory_list_t *dbglp;
     memory_list_t *base_dbglp;
+    Dwarf_Allocator alloc;
+    struct Dwarf_P_Arena_Chunk_s *chunk = 0;
 
     if (dbg == NULL) {
         /* should throw an error */
@@ -175,12 +318,84 @@ _dwarf_p_dealloc_all(Dwarf_P_Debug dbg)
     while (dbglp != base_dbglp) {
         memory_list_t*next = dbglp->next;
 
-        _dwarf_p_dealloc( LIST_TO_BLOCK(dbglp));
+        _dwarf_p_dealloc(dbg,LIST_TO_BLOCK(dbglp));
         dbglp = next;
     }
     dwarf_tdestroy(dbg->de_debug_str_hashtab,
         _dwarf_str_hashtab_freenode);
     dwarf_tdestroy(dbg->de_debug_line_str_hashtab,
         _dwarf_str_hashtab_freenode);
-    free((void *)base_dbglp);
+    alloc = dbg->de_allocator;
+    chunk = dbg->de_arena_chunks;
+    dbg->de_arena_chunks = 0;
+    while (chunk) {
+        struct Dwarf_P_Arena_Chunk_s *next = chunk->ac_next;
+
+        p_allocator_free(&alloc,(void *)chunk);
+        chunk = next;
+    }
+    p_allocator_free(&alloc,(void *)base_dbglp);
+}
+
+/*  A copy of dbg for a section generator to run on
+    another thread (see dwarf_pro_set_parallel_generation()).
+    It shares nothing the generator allocates with dbg:
+    it has its own (empty) memory list and arena.
+    The caller resets the section data list.
+    Returns NULL if out of memory. */
+Dwarf_P_Debug
+_dwarf_p_worker_debug(Dwarf_P_Debug dbg)
+{
+    Dwarf_P_Debug worker = 0;
+    memory_list_t *lp = 0;
+
+    worker = (Dwarf_P_Debug)_dwarf_p_get_debug_alloc(
+        &dbg->de_allocator, sizeof(struct Dwarf_P_Debug_s));
+    if (!worker) {
+        return NULL;
+    }
+    /*  The copy overwrites nothing of the list node,
+        which precedes the block. */
+    memcpy(worker,dbg,sizeof(struct Dwarf_P_Debug_s));
+    lp = BLOCK_TO_LIST(worker);
+    lp->next = lp->prev = lp;
+    worker->de_arena_chunks = 0;
+    worker->de_arena_next = 0;
+    worker->de_arena_left = 0;
+    return worker;
+}
+
+/*  Hands everything allocated on worker (its list blocks
+    and arena chunks) to dbg, so _dwarf_p_dealloc_all(dbg)
+    frees it and pointers into it stay valid, then frees
+    the worker itself. dbg keeps carving from its own
+    newest arena chunk. */
+void
+_dwarf_p_merge_worker_debug(Dwarf_P_Debug dbg,
+    Dwarf_P_Debug worker)
+{
+    memory_list_t *wlp = BLOCK_TO_LIST(worker);
+    struct Dwarf_P_Arena_Chunk_s *chunk = 0;
+
+    if (wlp->next != wlp) {
+        memory_list_t *first = wlp->next;
+        memory_list_t *last = wlp->prev;
+        memory_list_t *dbglp = BLOCK_TO_LIST(dbg);
+        memory_list_t *nextblock = dbglp->next;
+
+        /* Insert the worker's blocks after dbglp. */
+        dbglp->next = first;
+        first->prev = dbglp;
+        last->next = nextblock;
+        nextblock->prev = last;
+    }
+    chunk = worker->de_arena_chunks;
+    if (chunk) {
+        while (chunk->ac_next) {
+            chunk = chunk->ac_next;
+        }
+        chunk->ac_next = dbg->de_arena_chunks;
+        dbg->de_arena_chunks = worker->de_arena_chunks;
+    }
+    p_allocator_free(&dbg->de_allocator,(void *)wlp);
 }
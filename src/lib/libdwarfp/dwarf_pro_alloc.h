@@ -34,8 +34,15 @@ extern "C" {
 #endif /* __cplusplus */
 
 Dwarf_Ptr _dwarf_p_get_alloc(Dwarf_P_Debug, Dwarf_Unsigned);
-void _dwarf_p_dealloc(Dwarf_Small * ptr);
+void _dwarf_p_dealloc(Dwarf_P_Debug dbg, Dwarf_Small * ptr);
 void _dwarf_p_dealloc_all(Dwarf_P_Debug dbg);
+Dwarf_Ptr _dwarf_p_get_debug_alloc(Dwarf_Allocator *alloc,
+    Dwarf_Unsigned size);
+void _dwarf_p_choose_allocator(const Dwarf_Allocator *requested,
+    Dwarf_Allocator *out);
+Dwarf_P_Debug _dwarf_p_worker_debug(Dwarf_P_Debug dbg);
+void _dwarf_p_merge_worker_debug(Dwarf_P_Debug dbg,
+    Dwarf_P_Debug worker);
 
 #ifdef __cplusplus
 }
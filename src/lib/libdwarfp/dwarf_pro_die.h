@@ -45,6 +45,11 @@ struct Dwarf_P_Abbrev_s {
     Dwarf_Signed *abb_implicits;
     int abb_n_attr;           /* num of attrs = # of forms */
     Dwarf_P_Abbrev abb_next;
+
+    /*  Hash of tag, children and the attr/form/implicit
+        list, and the chain within one abbrev hash bucket. */
+    Dwarf_Unsigned abb_hash;
+    Dwarf_P_Abbrev abb_hash_next;
 };
 
 /* used in pro_section.c */
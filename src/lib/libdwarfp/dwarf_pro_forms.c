@@ -403,7 +403,7 @@ dwarf_add_AT_block_a(
         _dwarf_p_get_alloc(dbg, len_size + block_size);
     if (new_attr->ar_data == NULL) {
         /* free the block we got earlier */
-        _dwarf_p_dealloc((unsigned char *) new_attr);
+        _dwarf_p_dealloc(dbg,(unsigned char *)new_attr);
         _dwarf_p_error(dbg, error, DW_DLE_ALLOC_FAIL);
         return DW_DLV_ERROR;
     }
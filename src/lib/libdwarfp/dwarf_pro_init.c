@@ -171,17 +171,47 @@ dwarf_producer_init(Dwarf_Unsigned flags,
     const char *extra, /* Extra input strings, comma separated. */
     Dwarf_P_Debug *dbg_returned,
     Dwarf_Error * error)
+{
+    return dwarf_producer_init_alloc(flags,func,errhand,errarg,
+        user_data,isa_name,dwarf_version,extra,0,
+        dbg_returned,error);
+}
+
+/*  New October 2026. As dwarf_producer_init() but
+    the Dwarf_P_Debug uses *allocator (if non-NULL)
+    rather than the dwarf_pro_set_allocator() default. */
+int
+dwarf_producer_init_alloc(Dwarf_Unsigned flags,
+    Dwarf_Callback_Func func,
+    Dwarf_Handler errhand,
+    Dwarf_Ptr errarg,
+    void * user_data,
+    const char *isa_name,
+    const char *dwarf_version,
+    const char *extra,
+    const Dwarf_Allocator *allocator,
+    Dwarf_P_Debug *dbg_returned,
+    Dwarf_Error * error)
 {
     Dwarf_P_Debug dbg = 0;
+    Dwarf_Allocator alloc;
     int res = 0;
     int err_ret = 0;
-    dbg = (Dwarf_P_Debug) _dwarf_p_get_alloc(NULL,
+
+    if (allocator &&
+        (!allocator->da_malloc != !allocator->da_free)) {
+        DWARF_P_DBG_ERROR(dbg, DW_DLE_ALLOCATOR_ERROR,
+            DW_DLV_ERROR);
+    }
+    _dwarf_p_choose_allocator(allocator,&alloc);
+    dbg = (Dwarf_P_Debug) _dwarf_p_get_debug_alloc(&alloc,
         sizeof(struct Dwarf_P_Debug_s));
     if (dbg == NULL) {
         DWARF_P_DBG_ERROR(dbg, DW_DLE_DBG_ALLOC,
             DW_DLV_ERROR);
     }
     memset((void *) dbg, 0, sizeof(struct Dwarf_P_Debug_s));
+    dbg->de_allocator = alloc;
     /* For the time being */
     if (func == NULL) {
         DWARF_P_DBG_ERROR(dbg, DW_DLE_NO_CALLBACK_FUNC,
@@ -412,6 +412,35 @@ struct Dwarf_P_Debug_s {
     void *    de_user_data;
     Dwarf_Ptr de_errarg;
 
+    /*  Copy of the allocator passed to
+        dwarf_producer_init_alloc(), or of the
+        dwarf_pro_set_allocator() default.
+        All zero means malloc()/free(). */
+    Dwarf_Allocator de_allocator;
+
+    /*  Arena chunks small blocks from _dwarf_p_get_alloc()
+        are carved from, all freed by _dwarf_p_dealloc_all().
+        de_arena_next/de_arena_left describe the unused
+        tail of the newest chunk. */
+    struct Dwarf_P_Arena_Chunk_s *de_arena_chunks;
+    char *de_arena_next;
+    Dwarf_Unsigned de_arena_left;
+
+    /*  See dwarf_pro_set_section_sink(). With a sink,
+        finished section data chunks are passed to it and
+        put on de_stream_free for _dwarf_pro_buffer() to
+        reuse. de_stream_nbytes counts the bytes streamed
+        per DEBUG_* section and de_stream_chunks the
+        chunks created since the last flush. */
+    Dwarf_P_Section_Sink_Func de_section_sink;
+    void *de_section_sink_data;
+    Dwarf_P_Section_Data de_stream_free;
+    Dwarf_Unsigned de_stream_chunks;
+    Dwarf_Unsigned de_stream_nbytes[NUM_DEBUG_SECTIONS];
+
+    /*  See dwarf_pro_set_parallel_generation(). */
+    Dwarf_Bool de_parallel_generation;
+
     /*  Call back function, used to create .debug* sections.
         Provided by library user.  */
     Dwarf_Callback_Func de_callback_func;
@@ -33,7 +33,10 @@
 
 #include <stddef.h> /* NULL */
 #include <stdlib.h> /* free() malloc() qsort() */
-#include <string.h> /* memcpy() strcmp() strcpy() strlen() */
+#include <string.h> /* memcpy() memset() strcmp() strcpy() strlen() */
+#ifdef HAVE_PTHREAD
+#include <pthread.h> /* pthread_create() pthread_join() */
+#endif /* HAVE_PTHREAD */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -59,6 +62,32 @@ struct Dwarf_Sort_Abbrev_s {
     Dwarf_P_Attribute dsa_attrp;
 };
 
+/*  Abbreviations already created for .debug_info,
+    hashed on tag, children and the sorted
+    attr/form/implicit_const list so finding a
+    shareable abbrev does not walk every abbrev
+    created so far. abt_size is a power of two. */
+struct Dwarf_P_Abbrev_Table_s {
+    Dwarf_P_Abbrev *abt_buckets;
+    Dwarf_Unsigned  abt_size;
+    Dwarf_Unsigned  abt_count;
+};
+#define ABBREV_TABLE_INITIAL_SIZE 64
+
+/*  With a section sink (dwarf_pro_set_section_sink())
+    the section data list is emptied each time finished
+    chunks are streamed and points here until the next
+    chunk is created. Never written. */
+static struct Dwarf_P_Section_Data_s stream_sentinel = {
+    MAGIC_SECT_NO, 0, 0, 0, 0
+};
+/*  While writing .debug_info DIEs, stream once this many
+    chunks (about 64KB) are waiting. */
+#define STREAM_FLUSH_CHUNKS 16
+
+static int stream_finished_sections(Dwarf_P_Debug dbg,
+    Dwarf_Error *error);
+
 /* Must match up with pro_section.h defines of DEBUG_INFO etc
 and sectnames (below).  REL_SEC_PREFIX is either ".rel" or ".rela"
 see pro_incl.h
@@ -172,6 +201,8 @@ static int _dwarf_pro_generate_debugframe(Dwarf_P_Debug dbg,
     Dwarf_Unsigned *nbufs, Dwarf_Error * error);
 static int _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
     Dwarf_Unsigned *nbufs, Dwarf_Error * error);
+static int prepare_debuginfo_dies(Dwarf_P_Debug dbg,
+    Dwarf_Error * error);
 static int _dwarf_pro_generate_debugsup(Dwarf_P_Debug dbg,
     Dwarf_Unsigned *nbufs, Dwarf_Error * error);
 
@@ -305,6 +336,275 @@ dwarf_need_debug_names_section(Dwarf_P_Debug dbg)
     return dbg->de_force_dnames;
 }
 
+/*  Returns TRUE if generating .debug_frame adds
+    DW_AT_MIPS_fde to a DIE, so .debug_info must
+    not be generated before or alongside it. */
+static Dwarf_Bool
+fde_adds_die_attr(Dwarf_P_Debug dbg)
+{
+    Dwarf_P_Fde curfde = dbg->de_frame_fdes;
+
+    for ( ; curfde; curfde = curfde->fde_next) {
+        if (curfde->fde_die) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+#ifdef HAVE_PTHREAD
+/*  With dwarf_pro_set_parallel_generation() the
+    .debug_line, .debug_frame and .debug_info (with
+    .debug_abbrev) generators run at once, each on a
+    worker copy of the dbg from _dwarf_p_worker_debug()
+    with its own section data list, memory and
+    relocation list. What each one writes is its own:
+    only the .debug_info generator touches the DIE tree
+    (prepare_debuginfo_dies() already ran) and its
+    markers and string attrs, and only the .debug_line
+    generator adds to .debug_str and .debug_line_str.
+    merge_generate_task() then appends the chunks to the
+    dbg's list in the serial order, so every section
+    (and the chunk list itself) is the same as from a
+    serial transform. */
+#define GEN_LINE  0
+#define GEN_FRAME 1
+#define GEN_INFO  2
+#define GEN_TASK_COUNT 3
+
+struct generate_task_s {
+    int gt_sect; /* DEBUG_LINE, DEBUG_FRAME or DEBUG_INFO */
+    int (*gt_generate)(Dwarf_P_Debug, Dwarf_Unsigned *,
+        Dwarf_Error *);
+    Dwarf_Bool     gt_wanted;
+    Dwarf_P_Debug  gt_dbg;
+    struct Dwarf_P_Section_Data_s gt_sentinel;
+    Dwarf_Unsigned gt_nbufs;
+    Dwarf_Error    gt_error;
+    int            gt_res;
+    Dwarf_Bool     gt_threaded;
+    pthread_t      gt_thread;
+};
+
+static void *
+run_generate_task(void *arg)
+{
+    struct generate_task_s *t = (struct generate_task_s *)arg;
+
+    t->gt_res = t->gt_generate(t->gt_dbg,&t->gt_nbufs,
+        &t->gt_error);
+    return NULL;
+}
+
+static int
+open_generate_task(Dwarf_P_Debug dbg,
+    struct generate_task_s *t)
+{
+    Dwarf_P_Debug w = _dwarf_p_worker_debug(dbg);
+
+    if (!w) {
+        return DW_DLV_ERROR;
+    }
+    t->gt_sentinel.ds_elf_sect_no = MAGIC_SECT_NO;
+    w->de_debug_sects = &t->gt_sentinel;
+    w->de_first_debug_sect = &t->gt_sentinel;
+    w->de_current_active_section = &t->gt_sentinel;
+    w->de_n_debug_sect = 0;
+    /*  Streaming is done on the calling thread as
+        each task is merged. */
+    w->de_section_sink = 0;
+    w->de_section_sink_data = 0;
+    w->de_stream_free = 0;
+    w->de_stream_chunks = 0;
+    /*  Errors come back in gt_error and are
+        reported on the calling thread. */
+    w->de_errhand = 0;
+    w->de_errarg = 0;
+    t->gt_dbg = w;
+    return DW_DLV_OK;
+}
+
+/*  Moves the task's section data and the state its
+    generator built to dbg, and its memory, so
+    pointers into it (gt_error too) remain valid. */
+static void
+merge_generate_task(Dwarf_P_Debug dbg,
+    struct generate_task_s *t)
+{
+    Dwarf_P_Debug w = t->gt_dbg;
+    int sect = t->gt_sect;
+
+    if (!w) {
+        return;
+    }
+    if (w->de_first_debug_sect != &t->gt_sentinel) {
+        if (dbg->de_debug_sects->ds_elf_sect_no ==
+            MAGIC_SECT_NO) {
+            dbg->de_debug_sects = w->de_first_debug_sect;
+            dbg->de_first_debug_sect = w->de_first_debug_sect;
+        } else {
+            dbg->de_current_active_section->ds_next =
+                w->de_first_debug_sect;
+        }
+        dbg->de_current_active_section =
+            w->de_current_active_section;
+        dbg->de_n_debug_sect += w->de_n_debug_sect;
+        dbg->de_stream_chunks += w->de_stream_chunks;
+    }
+    dbg->de_reloc_sect[sect] = w->de_reloc_sect[sect];
+    dbg->de_sect_string_attr[sect] =
+        w->de_sect_string_attr[sect];
+    if (sect == DEBUG_INFO) {
+        dbg->de_markers = w->de_markers;
+        dbg->de_marker_n_alloc = w->de_marker_n_alloc;
+        dbg->de_marker_n_used = w->de_marker_n_used;
+    } else if (sect == DEBUG_LINE) {
+        dbg->de_debug_str_hashtab = w->de_debug_str_hashtab;
+        dbg->de_debug_line_str_hashtab =
+            w->de_debug_line_str_hashtab;
+        dbg->de_stats.ps_strp = w->de_stats.ps_strp;
+        dbg->de_stats.ps_line_strp = w->de_stats.ps_line_strp;
+    }
+    _dwarf_p_merge_worker_debug(dbg,w);
+    t->gt_dbg = 0;
+}
+
+/*  Merges every task not yet merged (so nothing
+    leaks) and reports the first error in serial
+    order. */
+static int
+fail_generate_tasks(Dwarf_P_Debug dbg,
+    struct generate_task_s *tasks,
+    int res,
+    Dwarf_Error *error)
+{
+    int i = 0;
+    Dwarf_Error e = 0;
+
+    for (i = 0; i < GEN_TASK_COUNT; ++i) {
+        merge_generate_task(dbg,&tasks[i]);
+    }
+    if (res != DW_DLV_ERROR) {
+        return res;
+    }
+    for (i = 0; i < GEN_TASK_COUNT; ++i) {
+        if (tasks[i].gt_res == DW_DLV_ERROR) {
+            e = tasks[i].gt_error;
+            break;
+        }
+    }
+    if (e) {
+        DWARF_P_DBG_ERROR(dbg, e->er_errval, DW_DLV_ERROR);
+    }
+    return DW_DLV_ERROR;
+}
+
+/*  Generates .debug_line, .debug_frame,
+    .debug_macinfo and .debug_info (the sections
+    dwarf_transform_to_disk_form_a() otherwise
+    generates one after the other) with the first
+    three of those run concurrently. */
+static int
+generate_sections_in_parallel(Dwarf_P_Debug dbg,
+    Dwarf_Unsigned *nbufs,
+    Dwarf_Error *error)
+{
+    struct generate_task_s tasks[GEN_TASK_COUNT];
+    int last = -1;
+    int i = 0;
+    int res = 0;
+
+    memset(tasks,0,sizeof(tasks));
+    tasks[GEN_LINE].gt_sect = DEBUG_LINE;
+    tasks[GEN_LINE].gt_generate = _dwarf_pro_generate_debugline;
+    tasks[GEN_LINE].gt_wanted =
+        dwarf_need_debug_line_section(dbg) == TRUE;
+    tasks[GEN_FRAME].gt_sect = DEBUG_FRAME;
+    tasks[GEN_FRAME].gt_generate = _dwarf_pro_generate_debugframe;
+    tasks[GEN_FRAME].gt_wanted = dbg->de_frame_cies != 0;
+    tasks[GEN_INFO].gt_sect = DEBUG_INFO;
+    tasks[GEN_INFO].gt_generate = _dwarf_pro_generate_debuginfo;
+    tasks[GEN_INFO].gt_wanted = dbg->de_dies &&
+        !fde_adds_die_attr(dbg);
+
+    for (i = 0; i < GEN_TASK_COUNT; ++i) {
+        if (!tasks[i].gt_wanted) {
+            continue;
+        }
+        res = open_generate_task(dbg,&tasks[i]);
+        if (res != DW_DLV_OK) {
+            fail_generate_tasks(dbg,tasks,DW_DLV_OK,error);
+            DWARF_P_DBG_ERROR(dbg, DW_DLE_ALLOC_FAIL, DW_DLV_ERROR);
+        }
+        last = i;
+    }
+    /*  The calling thread runs the last task. A task
+        whose thread cannot be created runs here too. */
+    for (i = 0; i < GEN_TASK_COUNT; ++i) {
+        struct generate_task_s *t = &tasks[i];
+
+        if (!t->gt_wanted) {
+            continue;
+        }
+        if (i != last &&
+            !pthread_create(&t->gt_thread,NULL,
+            run_generate_task,t)) {
+            t->gt_threaded = TRUE;
+            continue;
+        }
+        run_generate_task(t);
+    }
+    res = DW_DLV_OK;
+    for (i = 0; i < GEN_TASK_COUNT; ++i) {
+        if (tasks[i].gt_threaded) {
+            pthread_join(tasks[i].gt_thread,NULL);
+        }
+        if (tasks[i].gt_res == DW_DLV_ERROR) {
+            res = DW_DLV_ERROR;
+        }
+    }
+    if (res != DW_DLV_OK) {
+        return fail_generate_tasks(dbg,tasks,res,error);
+    }
+
+    merge_generate_task(dbg,&tasks[GEN_LINE]);
+    res = stream_finished_sections(dbg,error);
+    if (res != DW_DLV_OK) {
+        return fail_generate_tasks(dbg,tasks,res,error);
+    }
+    merge_generate_task(dbg,&tasks[GEN_FRAME]);
+    res = stream_finished_sections(dbg,error);
+    if (res != DW_DLV_OK) {
+        return fail_generate_tasks(dbg,tasks,res,error);
+    }
+    if (dbg->de_first_macinfo) {
+        res  = _dwarf_pro_transform_macro_info_to_disk(dbg,
+            nbufs,error);
+        if (res == DW_DLV_OK) {
+            res = stream_finished_sections(dbg,error);
+        }
+        if (res != DW_DLV_OK) {
+            return fail_generate_tasks(dbg,tasks,res,error);
+        }
+    }
+    if (tasks[GEN_INFO].gt_wanted) {
+        merge_generate_task(dbg,&tasks[GEN_INFO]);
+    } else if (dbg->de_dies) {
+        /*  After .debug_frame added DW_AT_MIPS_fde. */
+        res = _dwarf_pro_generate_debuginfo(dbg,nbufs,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    res = stream_finished_sections(dbg,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    *nbufs = dbg->de_n_debug_sect;
+    return DW_DLV_OK;
+}
+#endif /* HAVE_PTHREAD */
+
 /*  Convert debug information to  a format such that
     it can be written on disk.
     Called exactly once per execution.
@@ -322,6 +622,7 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg, Dwarf_Unsigned *count,
     Dwarf_Unsigned nbufs = 0;
     int sect = 0;
     int err = 0;
+    int sres = 0;
     Dwarf_Unsigned du = 0;
 
     if (dbg->de_version_magic_number != PRO_VERSION_MAGIC) {
@@ -489,33 +790,68 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg, Dwarf_Unsigned *count,
         }
     }
 
-    if (dwarf_need_debug_line_section(dbg) == TRUE) {
-        int res = _dwarf_pro_generate_debugline(dbg,&nbufs, error);
-        if (res == DW_DLV_ERROR) {
+    if (dbg->de_dies) {
+        int res = prepare_debuginfo_dies(dbg,error);
+        if (res != DW_DLV_OK) {
             return res;
         }
     }
-
-    if (dbg->de_frame_cies) {
-        int res = _dwarf_pro_generate_debugframe(dbg,&nbufs,error);
-        if (res == DW_DLV_ERROR) {
+#ifdef HAVE_PTHREAD
+    if (dbg->de_parallel_generation) {
+        int res = generate_sections_in_parallel(dbg,&nbufs,error);
+        if (res != DW_DLV_OK) {
             return res;
         }
-    }
-    if (dbg->de_first_macinfo) {
-        /* For DWARF 2,3,4 only */
-        /* Need new code for DWARF5 macro info. FIXME*/
-        int res  = _dwarf_pro_transform_macro_info_to_disk(dbg,
-            &nbufs,error);
-        if (res == DW_DLV_ERROR) {
-            return res;
+    } else
+#endif /* HAVE_PTHREAD */
+    {
+        if (dwarf_need_debug_line_section(dbg) == TRUE) {
+            int res = _dwarf_pro_generate_debugline(dbg,&nbufs,
+                error);
+            if (res == DW_DLV_ERROR) {
+                return res;
+            }
+            sres = stream_finished_sections(dbg,error);
+            if (sres != DW_DLV_OK) {
+                return sres;
+            }
         }
-    }
 
-    if (dbg->de_dies) {
-        int res= _dwarf_pro_generate_debuginfo(dbg, &nbufs, error);
-        if (res == DW_DLV_ERROR) {
-            return res;
+        if (dbg->de_frame_cies) {
+            int res = _dwarf_pro_generate_debugframe(dbg,&nbufs,
+                error);
+            if (res == DW_DLV_ERROR) {
+                return res;
+            }
+            sres = stream_finished_sections(dbg,error);
+            if (sres != DW_DLV_OK) {
+                return sres;
+            }
+        }
+        if (dbg->de_first_macinfo) {
+            /* For DWARF 2,3,4 only */
+            /* Need new code for DWARF5 macro info. FIXME*/
+            int res  = _dwarf_pro_transform_macro_info_to_disk(
+                dbg,&nbufs,error);
+            if (res == DW_DLV_ERROR) {
+                return res;
+            }
+            sres = stream_finished_sections(dbg,error);
+            if (sres != DW_DLV_OK) {
+                return sres;
+            }
+        }
+
+        if (dbg->de_dies) {
+            int res= _dwarf_pro_generate_debuginfo(dbg, &nbufs,
+                error);
+            if (res == DW_DLV_ERROR) {
+                return res;
+            }
+            sres = stream_finished_sections(dbg,error);
+            if (sres != DW_DLV_OK) {
+                return sres;
+            }
         }
     }
 
@@ -524,6 +860,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg, Dwarf_Unsigned *count,
         if (res == DW_DLV_ERROR) {
             return res;
         }
+        sres = stream_finished_sections(dbg,error);
+        if (sres != DW_DLV_OK) {
+            return sres;
+        }
     }
     if (dbg->de_debug_line_str->ds_data) {
         int res = _dwarf_pro_generate_debug_line_str(dbg,&nbufs,
@@ -531,6 +871,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg, Dwarf_Unsigned *count,
         if (res == DW_DLV_ERROR) {
             return res;
         }
+        sres = stream_finished_sections(dbg,error);
+        if (sres != DW_DLV_OK) {
+            return sres;
+        }
     }
 
     if (dbg->de_arange) {
@@ -538,6 +882,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg, Dwarf_Unsigned *count,
         if (res == DW_DLV_ERROR) {
             return res;
         }
+        sres = stream_finished_sections(dbg,error);
+        if (sres != DW_DLV_OK) {
+            return sres;
+        }
     }
     if (dbg->de_output_version < 5) {
         if (dbg->de_simple_name_headers[dwarf_snk_pubname].sn_head) {
@@ -604,12 +952,20 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg, Dwarf_Unsigned *count,
             }
         }
     }
+    sres = stream_finished_sections(dbg,error);
+    if (sres != DW_DLV_OK) {
+        return sres;
+    }
     if (dwarf_need_debug_names_section(dbg) == TRUE) {
         int res = _dwarf_pro_generate_dnames(dbg,&nbufs,
             error);
         if (res == DW_DLV_ERROR) {
             return res;
         }
+        sres = stream_finished_sections(dbg,error);
+        if (sres != DW_DLV_OK) {
+            return sres;
+        }
     }
 #if 0  /* FIXME: TODO new sections */
     if (dwarf_need_debug_macro_section(dbg) == TRUE) {
@@ -645,6 +1001,14 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg, Dwarf_Unsigned *count,
         }
         nbufs += new_chunks;
     }
+    if (dbg->de_section_sink) {
+        sres = stream_finished_sections(dbg,error);
+        if (sres != DW_DLV_OK) {
+            return sres;
+        }
+        /*  Everything went to the sink. */
+        nbufs = 0;
+    }
     *count = nbufs;
     return DW_DLV_OK;
 }
@@ -2581,11 +2945,103 @@ abcompare(const void *l_in, const void *r_in)
     return 0;
 }
 
-/*  Handles abbreviations. It takes a die, searches through
-    current list of abbreviations for a matching one. If it
+/*  FNV-1a style mixing, one value at a time. */
+static Dwarf_Unsigned
+abbrev_hash_mix(Dwarf_Unsigned h, Dwarf_Unsigned v)
+{
+    h ^= v;
+    h *= 16777619;
+    h ^= h >> 29;
+    return h;
+}
+
+/*  The die attrs must already be sorted (sort_die_attrs())
+    so the hash agrees with the abbrev arrays built
+    from the same attrs. */
+static Dwarf_Unsigned
+abbrev_hash_die(Dwarf_P_Die die)
+{
+    Dwarf_Unsigned h = 2166136261U;
+    Dwarf_P_Attribute curattr = die->di_attrs;
+
+    h = abbrev_hash_mix(h,die->di_tag);
+    h = abbrev_hash_mix(h,die->di_child?DW_CHILDREN_yes:
+        DW_CHILDREN_no);
+    h = abbrev_hash_mix(h,(Dwarf_Unsigned)die->di_n_attr);
+    for ( ; curattr; curattr = curattr->ar_next) {
+        h = abbrev_hash_mix(h,curattr->ar_attribute);
+        h = abbrev_hash_mix(h,curattr->ar_attribute_form);
+        if (curattr->ar_attribute_form == DW_FORM_implicit_const) {
+            h = abbrev_hash_mix(h,
+                (Dwarf_Unsigned)curattr->ar_implicit_const);
+        }
+    }
+    return h;
+}
+
+static int
+abbrev_table_init(Dwarf_P_Debug dbg,
+    struct Dwarf_P_Abbrev_Table_s *tab)
+{
+    tab->abt_buckets = (Dwarf_P_Abbrev *)
+        _dwarf_p_get_alloc(dbg,
+        sizeof(Dwarf_P_Abbrev)*ABBREV_TABLE_INITIAL_SIZE);
+    if (!tab->abt_buckets) {
+        return DW_DLV_ERROR;
+    }
+    tab->abt_size = ABBREV_TABLE_INITIAL_SIZE;
+    tab->abt_count = 0;
+    return DW_DLV_OK;
+}
+
+/*  Doubles the bucket count once there is more than
+    one abbrev per bucket. On allocation failure the
+    table simply stays at its current size. */
+static void
+abbrev_table_insert(Dwarf_P_Debug dbg,
+    struct Dwarf_P_Abbrev_Table_s *tab,
+    Dwarf_P_Abbrev ab)
+{
+    Dwarf_Unsigned slot = 0;
+
+    if (tab->abt_count >= tab->abt_size) {
+        Dwarf_Unsigned newsize = tab->abt_size*2;
+        Dwarf_P_Abbrev *newb = 0;
+        Dwarf_Unsigned i = 0;
+
+        newb = (Dwarf_P_Abbrev *)_dwarf_p_get_alloc(dbg,
+            sizeof(Dwarf_P_Abbrev)*newsize);
+        if (newb) {
+            for (i = 0; i < tab->abt_size; ++i) {
+                Dwarf_P_Abbrev cur = tab->abt_buckets[i];
+
+                while (cur) {
+                    Dwarf_P_Abbrev next = cur->abb_hash_next;
+
+                    slot = cur->abb_hash & (newsize-1);
+                    cur->abb_hash_next = newb[slot];
+                    newb[slot] = cur;
+                    cur = next;
+                }
+            }
+            _dwarf_p_dealloc(dbg,(Dwarf_Small *)tab->abt_buckets);
+            tab->abt_buckets = newb;
+            tab->abt_size = newsize;
+        }
+    }
+    slot = ab->abb_hash & (tab->abt_size-1);
+    ab->abb_hash_next = tab->abt_buckets[slot];
+    tab->abt_buckets[slot] = ab;
+    tab->abt_count++;
+}
+
+/*  Handles abbreviations. It takes a die, looks in
+    the table of abbreviations created so far for a
+    matching one. If it
     finds one, it returns a pointer to the abbrev through
     the ab_out pointer, and if it does not,
-    it returns a new abbrev through the ab_out pointer.
+    it returns a new abbrev through the ab_out pointer
+    (and records it in the table).
 
     The die->die_attrs are sorted by attribute and the curabbrev
     attrs are too.
@@ -2595,7 +3051,7 @@ abcompare(const void *l_in, const void *r_in)
     abb_idx has 0. */
 static int
 _dwarf_pro_getabbrev(Dwarf_P_Debug dbg,
-    Dwarf_P_Die die, Dwarf_P_Abbrev head,
+    Dwarf_P_Die die, struct Dwarf_P_Abbrev_Table_s *tab,
     Dwarf_P_Abbrev*ab_out,Dwarf_Error *error)
 {
     Dwarf_P_Abbrev curabbrev = 0;
@@ -2605,12 +3061,14 @@ _dwarf_pro_getabbrev(Dwarf_P_Debug dbg,
     Dwarf_Unsigned *attrs = 0;
     Dwarf_Signed *implicits = 0;
     int attrcount = die->di_n_attr;
+    Dwarf_Unsigned hash = abbrev_hash_die(die);
 
-    curabbrev = head;
-    /*  Loop thru the currently known abbreviations needed
+    curabbrev = tab->abt_buckets[hash & (tab->abt_size-1)];
+    /*  Loop thru the known abbreviations with this hash
         to see if we can share an existing abbrev.  */
-    while (curabbrev) {
-        if ((die->di_tag == curabbrev->abb_tag) &&
+    for ( ; curabbrev; curabbrev = curabbrev->abb_hash_next) {
+        if (curabbrev->abb_hash == hash &&
+            (die->di_tag == curabbrev->abb_tag) &&
             ((die->di_child != NULL &&
             curabbrev->abb_children == DW_CHILDREN_yes) ||
             (die->di_child == NULL &&
@@ -2632,24 +3090,23 @@ _dwarf_pro_getabbrev(Dwarf_P_Debug dbg,
                 return DW_DLV_OK;
             }
         }
-        curabbrev = curabbrev->abb_next;
     }
     /* no match, create new abbreviation */
     if (attrcount) {
         forms = (Dwarf_Unsigned *)
-            _dwarf_p_get_alloc(die->di_dbg,
+            _dwarf_p_get_alloc(dbg,
                 sizeof(Dwarf_Unsigned) * attrcount);
         if (forms == NULL) {
             DWARF_P_DBG_ERROR(dbg, DW_DLE_ABBREV_ALLOC, DW_DLV_ERROR);
         }
         attrs = (Dwarf_Unsigned *)
-            _dwarf_p_get_alloc(die->di_dbg,
+            _dwarf_p_get_alloc(dbg,
                 sizeof(Dwarf_Unsigned) * attrcount);
         if (attrs == NULL) {
             DWARF_P_DBG_ERROR(dbg, DW_DLE_ABBREV_ALLOC, DW_DLV_ERROR);
         }
         implicits = (Dwarf_Signed *)
-            _dwarf_p_get_alloc(die->di_dbg,
+            _dwarf_p_get_alloc(dbg,
                 sizeof(Dwarf_Signed) * attrcount);
         if (implicits == NULL) {
             DWARF_P_DBG_ERROR(dbg, DW_DLE_ABBREV_ALLOC, DW_DLV_ERROR);
@@ -2696,7 +3153,7 @@ _dwarf_pro_getabbrev(Dwarf_P_Debug dbg,
     }
 
     curabbrev = (Dwarf_P_Abbrev)
-        _dwarf_p_get_alloc(die->di_dbg,
+        _dwarf_p_get_alloc(dbg,
         sizeof(struct Dwarf_P_Abbrev_s));
     if (curabbrev == NULL) {
         DWARF_P_DBG_ERROR(dbg, DW_DLE_ABBREV_ALLOC, DW_DLV_ERROR);
@@ -2714,6 +3171,8 @@ _dwarf_pro_getabbrev(Dwarf_P_Debug dbg,
     curabbrev->abb_n_attr = attrcount;
     curabbrev->abb_idx = 0;
     curabbrev->abb_next = NULL;
+    curabbrev->abb_hash = hash;
+    abbrev_table_insert(dbg,tab,curabbrev);
     *ab_out = curabbrev;
     return DW_DLV_OK;
 }
@@ -2940,60 +3399,58 @@ write_out_debug_abbrev(Dwarf_P_Debug dbg,
     return DW_DLV_OK;
 }
 
+/*  Sorts the die attrs by attribute number, relinking
+    the attribute list in place (an insertion sort: DIEs
+    have few attrs and the common already-in-order case
+    just appends at the tail). No allocation is needed,
+    this runs once per DIE. */
 static int
 sort_die_attrs(Dwarf_P_Debug dbg,Dwarf_P_Die die,
     Dwarf_Error *error)
 {
-    struct Dwarf_Sort_Abbrev_s *sortab = 0;
-    struct Dwarf_Sort_Abbrev_s *ap = 0;
     Dwarf_P_Attribute at = 0;
     Dwarf_P_Attribute sorted_attrlist = 0;
     Dwarf_P_Attribute sorted_tail = 0;
-    int attrcount = die->di_n_attr;
-    int res = 0;
-    int k = 0;
+    int dupattr = FALSE;
 
-    if (attrcount < 2) {
+    if (die->di_n_attr < 2) {
         return DW_DLV_OK;
     }
-    sortab = (struct Dwarf_Sort_Abbrev_s *)
-        malloc(sizeof(struct Dwarf_Sort_Abbrev_s)*attrcount);
-    if (!sortab) {
-        DWARF_P_DBG_ERROR(dbg, DW_DLE_ABBREV_ALLOC, DW_DLV_ERROR);
-    }
-    /*  ASSERT at->ar_next chain length == attrcount  */
-    ap = sortab;
     at = die->di_attrs;
-    for ( ; at; ++ap, at = at->ar_next) {
-        ap->dsa_attr = at->ar_attribute;
-        ap->dsa_form = at->ar_attribute_form;
-        ap->dsa_attrp = at;
-    }
-    qsort(sortab,attrcount,sizeof(struct Dwarf_Sort_Abbrev_s),
-        abcompare);
-    res = verify_ab_no_dups(sortab,attrcount);
-    if (res != DW_DLV_OK) {
-        free(sortab);
-        DWARF_P_DBG_ERROR(dbg, DW_DLE_DUP_ATTR_ON_DIE, DW_DLV_ERROR);
-    }
-    ap = sortab;
-    k = 0;
-    for ( ; k < attrcount; ++k,++ap) {
-        Dwarf_P_Attribute localptr = ap->dsa_attrp;
-        if (!sorted_attrlist) {
-            sorted_attrlist = localptr;
-            sorted_tail = sorted_attrlist;
-            localptr->ar_next = 0;
+    while (at) {
+        Dwarf_P_Attribute next = at->ar_next;
+        Dwarf_P_Attribute *pp = 0;
+
+        if (!sorted_attrlist ||
+            sorted_tail->ar_attribute < at->ar_attribute) {
+            at->ar_next = 0;
+            if (sorted_tail) {
+                sorted_tail->ar_next = at;
+            } else {
+                sorted_attrlist = at;
+            }
+            sorted_tail = at;
+            at = next;
             continue;
         }
-        sorted_tail->ar_next  = localptr;
-        sorted_tail = localptr;
-        localptr->ar_next = 0;
+        pp = &sorted_attrlist;
+        while ((*pp)->ar_attribute < at->ar_attribute) {
+            pp = &(*pp)->ar_next;
+        }
+        if ((*pp)->ar_attribute == at->ar_attribute) {
+            /*  Keep the list whole, report after. */
+            dupattr = TRUE;
+        }
+        at->ar_next = *pp;
+        *pp = at;
+        at = next;
     }
     /*  Now replace the list with the same pointers
         but in order sorted by attribute. */
     die->di_attrs = sorted_attrlist;
-    free(sortab);
+    if (dupattr) {
+        DWARF_P_DBG_ERROR(dbg, DW_DLE_DUP_ATTR_ON_DIE, DW_DLV_ERROR);
+    }
     return DW_DLV_OK;
 }
 
@@ -3051,6 +3508,71 @@ _dwarf_pro_generate_debugsup(Dwarf_P_Debug dbg,
     return DW_DLV_OK;
 }
 
+/*  Adds the attributes the .debug_info generator
+    needs to the DIE tree: DW_AT_macro_info and
+    DW_AT_stmt_list on the CU DIE and DW_AT_sibling on
+    top level DIEs with children. Done before the
+    generators run so that with parallel generation
+    only the .debug_frame generator (DW_AT_MIPS_fde,
+    see fde_adds_die_attr()) changes the tree, and
+    then .debug_info is not generated alongside it. */
+static int
+prepare_debuginfo_dies(Dwarf_P_Debug dbg,
+    Dwarf_Error * error)
+{
+    Dwarf_P_Die curdie = dbg->de_dies;
+    Dwarf_P_Die first_child = 0;
+    Dwarf_Half version = dbg->de_output_version;
+    int res = 0;
+
+    /*  Create AT_macro_info if appropriate */
+    if (version < 5) {
+        if (dbg->de_first_macinfo != NULL) {
+            res = _dwarf_pro_add_AT_macro_info(dbg, curdie, 0, error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+        }
+    } else {
+        /* FIXME need to add code to emit DWARF5 macro data. */
+#if 0
+            res = _dwarf_pro_add_AT_macro5_info(dbg, curdie,
+                0, error);
+#endif
+    }
+
+    /* Create AT_stmt_list attribute if necessary */
+    if (dwarf_need_debug_line_section(dbg) == TRUE) {
+        res =_dwarf_pro_add_AT_stmt_list(dbg, curdie, error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+
+    /*  Pass 0: only top level dies, add at_sibling attribute to those
+        dies with children, but if and only if
+        there is no sibling attribute already. */
+    first_child = curdie->di_child;
+    while (first_child && first_child->di_right) {
+        if (first_child->di_child) {
+            if (!has_sibling_die_already(first_child)) {
+                Dwarf_P_Attribute attr_out = 0;
+                res = dwarf_add_AT_reference_c(dbg,
+                    first_child,
+                    DW_AT_sibling,
+                    first_child->di_right,
+                    &attr_out,error);
+                if (res != DW_DLV_OK) {
+                    /* DW_DLV_NO_ENTRY is impossible. */
+                    return res;
+                }
+            }
+        }
+        first_child = first_child->di_right;
+    }
+    return DW_DLV_OK;
+}
+
 static int
 _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
     Dwarf_Unsigned *nbufs,
@@ -3062,8 +3584,8 @@ _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
     Dwarf_P_Abbrev curabbrev = 0;
     Dwarf_P_Abbrev abbrev_head = 0;
     Dwarf_P_Abbrev abbrev_tail = 0;
+    struct Dwarf_P_Abbrev_Table_s abbrev_table;
     Dwarf_P_Die curdie = 0;
-    Dwarf_P_Die first_child = 0;
     Dwarf_Unsigned dw = 0;
     Dwarf_Unsigned du = 0;
     Dwarf_Half dh = 0;
@@ -3120,30 +3642,6 @@ _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
     }
 
     curdie = dbg->de_dies;
-
-    /*  Create AT_macro_info if appropriate */
-    if (version < 5) {
-        if (dbg->de_first_macinfo != NULL) {
-            res = _dwarf_pro_add_AT_macro_info(dbg, curdie, 0, error);
-            if (res != DW_DLV_OK) {
-                return res;
-            }
-        }
-    } else {
-        /* FIXME need to add code to emit DWARF5 macro data. */
-#if 0
-            res = _dwarf_pro_add_AT_macro5_info(dbg, curdie,
-                0, error);
-#endif
-    }
-
-    /* Create AT_stmt_list attribute if necessary */
-    if (dwarf_need_debug_line_section(dbg) == TRUE) {
-        res =_dwarf_pro_add_AT_stmt_list(dbg, curdie, error);
-        if (res != DW_DLV_OK) {
-            return res;
-        }
-    }
     die_off = cu_header_size;
 
     /*  Relocation for abbrev offset in cu header store relocation
@@ -3157,31 +3655,13 @@ _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
         DWARF_P_DBG_ERROR(dbg, DW_DLE_REL_ALLOC, DW_DLV_ERROR);
     }
 
-    /*  Pass 0: only top level dies, add at_sibling attribute to those
-        dies with children, but if and only if
-        there is no sibling attribute already. */
-    first_child = curdie->di_child;
-    while (first_child && first_child->di_right) {
-        if (first_child->di_child) {
-            if (!has_sibling_die_already(first_child)) {
-                Dwarf_P_Attribute attr_out = 0;
-                res = dwarf_add_AT_reference_c(dbg,
-                    first_child,
-                    DW_AT_sibling,
-                    first_child->di_right,
-                    &attr_out,error);
-                if (res != DW_DLV_OK) {
-                    /* DW_DLV_NO_ENTRY is impossible. */
-                    return res;
-                }
-            }
-        }
-        first_child = first_child->di_right;
-    }
-
     /*  Pass 1: create abbrev info, get die offsets,
         calc relocations */
     abbrev_head = abbrev_tail = NULL;
+    res = abbrev_table_init(dbg,&abbrev_table);
+    if (res != DW_DLV_OK) {
+        DWARF_P_DBG_ERROR(dbg, DW_DLE_ABBREV_ALLOC, DW_DLV_ERROR);
+    }
     marker_count = 0;
     string_attr_count = 0;
     while (curdie != NULL) {
@@ -3204,7 +3684,7 @@ _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
         /*  Find or create a final abbrev record for the
             debug_abbrev section we will write (below). */
         cres  = _dwarf_pro_getabbrev(dbg,curdie,
-            abbrev_head,&curabbrev,error);
+            &abbrev_table,&curabbrev,error);
         if (cres != DW_DLV_OK) {
             return cres;
         }
@@ -3332,6 +3812,16 @@ _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
         DWARF_P_DBG_ERROR(dbg, DW_DLE_REL_ALLOC, DW_DLV_ERROR);
     }
 
+    /*  Write out debug_info size, now that we know it
+        (Pass 1 set every die offset).
+        This is back-patching the CU header we created
+        above, done before Pass 2 so the header can be
+        streamed while DIEs are still being written. */
+    du = die_off - OFFSET_PLUS_EXTENSION_SIZE;
+    WRITE_UNALIGNED(dbg, (void *) abbr_off_ptr,
+        (const void *) &du, sizeof(du), offset_size);
+    abbr_off_ptr = 0;
+
     /*  Pass 2: Write out the die information Here 'data' is a
         temporary, one block for each GET_CHUNK.
         'data' is overused. */
@@ -3339,6 +3829,14 @@ _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
     while (curdie != NULL) {
         Dwarf_P_Attribute curattr;
 
+        if (dbg->de_section_sink &&
+            dbg->de_stream_chunks >= STREAM_FLUSH_CHUNKS) {
+            res = stream_finished_sections(dbg,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+        }
+
         if (curdie->di_marker != 0) {
             res = marker_add(dbg, curdie->di_offset,
                 curdie->di_marker);
@@ -3483,13 +3981,6 @@ _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
         }
     } /* end while (curdir != NULL) */
 
-    /*  Write out debug_info size, now that we know it
-        This is back-patching the CU header we created
-        above. */
-    du = die_off - OFFSET_PLUS_EXTENSION_SIZE;
-    WRITE_UNALIGNED(dbg, (void *) abbr_off_ptr,
-        (const void *) &du, sizeof(du), offset_size);
-
     data = 0;                   /* Emphasize not usable now */
 
     res = write_out_debug_abbrev(dbg,
@@ -3549,6 +4040,107 @@ _dwarf_pro_generate_debug_line_str(Dwarf_P_Debug dbg,
     return DW_DLV_OK;
 }
 
+int
+dwarf_pro_set_section_sink(Dwarf_P_Debug dbg,
+    Dwarf_P_Section_Sink_Func sink,
+    void *sink_user_data,
+    Dwarf_Error *error)
+{
+    if (!dbg || dbg->de_version_magic_number != PRO_VERSION_MAGIC) {
+        DWARF_P_DBG_ERROR(dbg, DW_DLE_IA, DW_DLV_ERROR);
+    }
+    dbg->de_section_sink = sink;
+    dbg->de_section_sink_data = sink?sink_user_data:0;
+    return DW_DLV_OK;
+}
+
+int
+dwarf_pro_set_parallel_generation(Dwarf_P_Debug dbg,
+    Dwarf_Bool enable,
+    Dwarf_Error *error)
+{
+    if (!dbg || dbg->de_version_magic_number != PRO_VERSION_MAGIC) {
+        DWARF_P_DBG_ERROR(dbg, DW_DLE_IA, DW_DLV_ERROR);
+    }
+#ifdef HAVE_PTHREAD
+    dbg->de_parallel_generation = enable?TRUE:FALSE;
+    return DW_DLV_OK;
+#else /* !HAVE_PTHREAD */
+    dbg->de_parallel_generation = FALSE;
+    return enable?DW_DLV_NO_ENTRY:DW_DLV_OK;
+#endif /* HAVE_PTHREAD */
+}
+
+/*  Hands every chunk on the section data list to the
+    section sink, in list order (so each section's bytes
+    arrive in order), and keeps the chunks for reuse by
+    _dwarf_pro_buffer(). Only called between writes:
+    nothing may hold a pointer into a chunk. */
+static int
+stream_finished_sections(Dwarf_P_Debug dbg,
+    Dwarf_Error *error)
+{
+    Dwarf_P_Section_Data cur = 0;
+
+    if (!dbg->de_section_sink) {
+        return DW_DLV_OK;
+    }
+    cur = dbg->de_debug_sects;
+    while (cur && cur->ds_elf_sect_no != MAGIC_SECT_NO) {
+        Dwarf_P_Section_Data next = cur->ds_next;
+        int errcode = 0;
+        int res = 0;
+        int k = 0;
+
+        res = dbg->de_section_sink(
+            (Dwarf_Unsigned)cur->ds_elf_sect_no,
+            (Dwarf_Ptr)cur->ds_data,
+            (Dwarf_Unsigned)cur->ds_nbytes,
+            dbg->de_section_sink_data,&errcode);
+        if (res != DW_DLV_OK) {
+            dbg->de_debug_sects = cur;
+            dbg->de_first_debug_sect = cur;
+            DWARF_P_DBG_ERROR(dbg, DW_DLE_PRO_SECTION_SINK_ERROR,
+                DW_DLV_ERROR);
+        }
+        for (k = 0; k < NUM_DEBUG_SECTIONS; ++k) {
+            if (dbg->de_elf_sects[k] == cur->ds_elf_sect_no) {
+                dbg->de_stream_nbytes[k] += cur->ds_nbytes;
+                break;
+            }
+        }
+        if (cur->ds_orig_alloc == CHUNK_SIZE) {
+            cur->ds_next = dbg->de_stream_free;
+            dbg->de_stream_free = cur;
+        } else {
+            _dwarf_p_dealloc(dbg,(Dwarf_Small *)cur);
+        }
+        cur = next;
+    }
+    dbg->de_debug_sects = &stream_sentinel;
+    dbg->de_first_debug_sect = &stream_sentinel;
+    dbg->de_current_active_section = &stream_sentinel;
+    dbg->de_stream_chunks = 0;
+    return DW_DLV_OK;
+}
+
+/*  Bytes generated so far for the DEBUG_* section sect,
+    whether still in the section data list or already
+    streamed. */
+Dwarf_Unsigned
+_dwarf_pro_section_nbytes(Dwarf_P_Debug dbg, int sect)
+{
+    Dwarf_P_Section_Data cur = 0;
+    Dwarf_Unsigned total = dbg->de_stream_nbytes[sect];
+
+    for (cur = dbg->de_debug_sects; cur; cur = cur->ds_next) {
+        if (cur->ds_elf_sect_no == dbg->de_elf_sects[sect]) {
+            total += cur->ds_nbytes;
+        }
+    }
+    return total;
+}
+
 /*  Get a buffer of section data.
     section_idx is the elf-section number that this data applies to.
     length shows length of returned data
@@ -3642,12 +4234,20 @@ _dwarf_pro_buffer(Dwarf_P_Debug dbg,
         if (nbytes < CHUNK_SIZE) {
             space = CHUNK_SIZE;
         }
-        cursect = (Dwarf_P_Section_Data)
-            _dwarf_p_get_alloc(dbg,
-                sizeof(struct Dwarf_P_Section_Data_s)
+        if (space == CHUNK_SIZE && dbg->de_stream_free) {
+            /*  A chunk already handed to the section sink. */
+            cursect = dbg->de_stream_free;
+            dbg->de_stream_free = cursect->ds_next;
+            memset(cursect,0,sizeof(struct Dwarf_P_Section_Data_s)
                 + space);
-        if (cursect == NULL) {
-            return (NULL);
+        } else {
+            cursect = (Dwarf_P_Section_Data)
+                _dwarf_p_get_alloc(dbg,
+                    sizeof(struct Dwarf_P_Section_Data_s)
+                    + space);
+            if (cursect == NULL) {
+                return (NULL);
+            }
         }
         /* _dwarf_p_get_alloc zeroes the space... */
 
@@ -3672,6 +4272,7 @@ _dwarf_pro_buffer(Dwarf_P_Debug dbg,
             dbg->de_current_active_section = cursect;
         }
         dbg->de_n_debug_sect++;
+        dbg->de_stream_chunks++;
 
         return ((Dwarf_Small *) cursect->ds_data);
     }
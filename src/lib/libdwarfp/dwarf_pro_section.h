@@ -73,6 +73,9 @@ struct Dwarf_P_Section_Data_s {
 Dwarf_Small *_dwarf_pro_buffer(Dwarf_P_Debug dbg, int sectno,
     unsigned long nbytes);
 
+Dwarf_Unsigned _dwarf_pro_section_nbytes(Dwarf_P_Debug dbg,
+    int sect);
+
 /* GET_CHUNK_ERROR is new Sept 2016 to use DW_DLV_ERROR. */
 #define GET_CHUNK_ERR(dbg,sectno,ptr,nbytes,error) \
 { \
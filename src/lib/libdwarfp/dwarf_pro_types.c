@@ -145,9 +145,6 @@ _dwarf_transform_simplename_to_disk(Dwarf_P_Debug dbg,
     /* Used to fill in 0. */
     const Dwarf_Signed big_zero = 0;
 
-    /* Used to scan the section data buffers. */
-    Dwarf_P_Section_Data debug_sect;
-
     Dwarf_Signed debug_info_size;
 
     Dwarf_P_Simple_nameentry nameentry_original;
@@ -164,18 +161,12 @@ _dwarf_transform_simplename_to_disk(Dwarf_P_Debug dbg,
 
     /* ***** BEGIN CODE ***** */
 
-    debug_info_size = 0;
-    for (debug_sect = dbg->de_debug_sects; debug_sect != NULL;
-        debug_sect = debug_sect->ds_next) {
-        /*  We want the size of the .debug_info section for this CU
-            because the dwarf spec requires us
-            to output it below so we
-            look for it specifically. */
-        if (debug_sect->ds_elf_sect_no ==
-            dbg->de_elf_sects[DEBUG_INFO]) {
-            debug_info_size += debug_sect->ds_nbytes;
-        }
-    }
+    /*  We want the size of the .debug_info section for this CU
+        because the dwarf spec requires us
+        to output it below. Some of it may already have
+        gone to a section sink. */
+    debug_info_size = (Dwarf_Signed)
+        _dwarf_pro_section_nbytes(dbg,DEBUG_INFO);
 
     hdr = &dbg->de_simple_name_headers[entrykind];
     /* Size of the .debug_typenames (or similar) section header. */
@@ -176,6 +176,19 @@ typedef int (*Dwarf_Callback_Func)(
     void *          /*user_data*/,
     int*            /*error*/);
 
+/*  Receives finished section bytes when a sink is set
+    with dwarf_pro_set_section_sink(). elf_section_index
+    is the value the Dwarf_Callback_Func returned for
+    the section. The bytes are only valid during the call.
+    Return DW_DLV_OK, or DW_DLV_ERROR (optionally setting
+    *error) to stop dwarf_transform_to_disk_form_a(). */
+typedef int (*Dwarf_P_Section_Sink_Func)(
+    Dwarf_Unsigned  /*elf_section_index*/,
+    Dwarf_Ptr       /*bytes*/,
+    Dwarf_Unsigned  /*length*/,
+    void *          /*user_data*/,
+    int*            /*error*/);
+
 /*  Returns DW_DLV_OK or DW_DLV_ERROR and
     if DW_DLV_OK returns the Dwarf_P_Debug
     pointer through the dbg_returned argument. */
@@ -191,6 +204,45 @@ DWP_API int dwarf_producer_init(
     Dwarf_P_Debug *,      /* dbg_returned */
     Dwarf_Error *         /*error*/);
 
+/*  As dwarf_producer_init() but the Dwarf_P_Debug uses
+    the allocator (see Dwarf_Allocator in libdwarf.h)
+    passed in, copied, until dwarf_producer_finish_a().
+    Small producer records are carved from 64KB chunks
+    obtained through it, so expect mostly chunk-sized
+    requests, all freed by dwarf_producer_finish_a().
+    Nothing process-wide is read or changed, so threads
+    may each create a Dwarf_P_Debug with their own
+    allocator at the same time.
+    NULL means the dwarf_pro_set_allocator() default.
+    Fails with DW_DLE_ALLOCATOR_ERROR if exactly one of
+    da_malloc and da_free is NULL. */
+DWP_API int dwarf_producer_init_alloc(
+    Dwarf_Unsigned        /*flags*/,
+    Dwarf_Callback_Func   /*func*/,
+    Dwarf_Handler         /*errhand*/,
+    Dwarf_Ptr             /*errarg*/,
+    void *                /*user_data*/,
+    const char *isa_name,
+    const char *dwarf_version,
+    const char *extra,
+    const Dwarf_Allocator * /*allocator*/,
+    Dwarf_P_Debug *,      /* dbg_returned */
+    Dwarf_Error *         /*error*/);
+
+/*  Sets the default allocator used for every Dwarf_P_Debug
+    created afterwards by dwarf_producer_init().
+    NULL restores malloc()/free(). The previous setting
+    is returned through old_allocator if that is non-NULL.
+    Returns DW_DLV_OK, or DW_DLV_ERROR if exactly one of
+    da_malloc and da_free is NULL.
+    The setting is one process-wide variable with no
+    locking: call this before any other libdwarfp call
+    or not at all, and use dwarf_producer_init_alloc()
+    for an allocator per Dwarf_P_Debug. */
+DWP_API int dwarf_pro_set_allocator(
+    const Dwarf_Allocator * /*allocator*/,
+    Dwarf_Allocator *       /*old_allocator*/);
+
 /*  Returns DW_DLV_OK or DW_DLV_ERROR.
     The desired form must be DW_FORM_string (the default)
     or DW_FORM_strp.  */
@@ -203,6 +255,42 @@ DWP_API int dwarf_transform_to_disk_form_a(Dwarf_P_Debug /*dbg*/,
     Dwarf_Unsigned *   /*nbufs_out*/,
     Dwarf_Error*     /*error*/);
 
+/*  New October 2026. Streams section output.
+    With a sink set, dwarf_transform_to_disk_form_a()
+    hands each section's bytes to sink as they are
+    finished (.debug_info in pieces of about 64KB while it
+    is written) and reuses the buffers, instead of
+    keeping every section in memory until
+    dwarf_get_section_bytes_a() is called. Bytes for one
+    elf section arrive in order and are not revisited
+    (the .debug_info unit length is known before the
+    DIEs are written). The transform then returns a
+    buffer count of zero. Relocations are unchanged:
+    fetch them with dwarf_get_relocation_info().
+    Call before dwarf_transform_to_disk_form_a().
+    A NULL sink restores the default. */
+DWP_API int dwarf_pro_set_section_sink(Dwarf_P_Debug /*dbg*/,
+    Dwarf_P_Section_Sink_Func /*sink*/,
+    void *           /*sink_user_data*/,
+    Dwarf_Error*     /*error*/);
+
+/*  New October 2026. With enable TRUE,
+    dwarf_transform_to_disk_form_a() generates
+    .debug_line, .debug_frame and .debug_info (with
+    .debug_abbrev) on separate threads and then joins
+    their section data in the usual order: the bytes
+    are identical to a serial transform. The allocator
+    (see dwarf_producer_init_alloc()) is then called
+    from those threads too, so must be thread safe.
+    Returns DW_DLV_NO_ENTRY (and generation stays
+    serial) if libdwarfp was built without threads.
+    With a section sink, .debug_info is streamed once
+    it is complete rather than in pieces.
+    Call before dwarf_transform_to_disk_form_a(). */
+DWP_API int dwarf_pro_set_parallel_generation(Dwarf_P_Debug /*dbg*/,
+    Dwarf_Bool       /*enable*/,
+    Dwarf_Error*     /*error*/);
+
 /* New September 2016. Preferred. */
 DWP_API int dwarf_get_section_bytes_a(Dwarf_P_Debug /*dbg*/,
     Dwarf_Unsigned   /*dwarf_section*/,
@@ -0,0 +1,14 @@
+#!/bin/sh
+# This is the script used to create testcppnsLE64ELf.testme,
+# a two-CU x86_64 DWARF5 C++ executable, with g++ 12.2 on
+# Debian. Run it in this directory only to rebuild the object.
+#   testcppnsLE64ELfsource_a.cc is compiled with -gpubnames
+#   and testcppnsLE64ELfsource_b.cc is not, so
+#   .debug_pubnames covers only the first CU and lists
+#   its functions by qualified name (cpns::cp_scale).
+a=testcppnsLE64ELfsource_a
+b=testcppnsLE64ELfsource_b
+c++ -gdwarf-5 -O2 -gpubnames -c $a.cc -o junk.$a.o || exit 1
+c++ -gdwarf-5 -O2 -c $b.cc -o junk.$b.o || exit 1
+c++ junk.$a.o junk.$b.o -o testcppnsLE64ELf.testme || exit 1
+rm -f junk.$a.o junk.$b.o
@@ -0,0 +1,28 @@
+#!/bin/sh
+# This is the script used to create testmulticuLE64ELf.testme,
+# a two-CU x86_64 DWARF5 executable, with gcc 12.2 on Debian.
+# Run it in this directory only to rebuild the object:
+# the tests check values (pcs, offsets) of this build.
+#   testmulticuLE64ELfsource_a.c is compiled with -gpubnames
+#   and testmulticuLE64ELfsource_b.c is not, so
+#   .debug_pubnames covers only the first CU.
+#   A DW_LLE_default_location entry (DW_OP_lit7
+#   DW_OP_stack_value) is added to the location
+#   list of main's argv, as gcc does not emit one.
+a=testmulticuLE64ELfsource_a
+b=testmulticuLE64ELfsource_b
+cc -gdwarf-5 -O2 -gpubnames -S $a.c -o junk.$a.s || exit 1
+awk '
+/^\.LLST5:/ { inlist = 1 }
+inlist && /^\t\.byte\t0$/ {
+    print "\t.byte\t0x5"
+    print "\t.uleb128 0x2"
+    print "\t.byte\t0x37"
+    print "\t.byte\t0x9f"
+    inlist = 0
+}
+{ print }' junk.$a.s > junk.$a.edited.s || exit 1
+cc -c junk.$a.edited.s -o junk.$a.o || exit 1
+cc -gdwarf-5 -O2 -c $b.c -o junk.$b.o || exit 1
+cc junk.$a.o junk.$b.o -o testmulticuLE64ELf.testme || exit 1
+rm -f junk.$a.s junk.$a.edited.s junk.$a.o junk.$b.o
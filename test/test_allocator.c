@@ -0,0 +1,358 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  Tests dwarf_set_allocator(): a counting allocator
+    must see the Dwarf_Debug, the DIEs and attributes
+    and the section data, every block it hands out
+    must come back by dwarf_finish(), and a Dwarf_Debug
+    opened after restoring the default must not use it.
+    Then tests dwarf_init_path_alloc(): two Dwarf_Debug
+    open at once, each with its own allocator, must
+    each use only their own.
+
+    ./test_allocator -f <top of the source tree>
+    or with DWTOPSRCDIR set in the environment. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() free() getenv() malloc() */
+#include <string.h> /* strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+
+#define OBJNAME "/test/testmulticuLE64ELf.testme"
+
+static int errcount;
+static char pathbuf[2000];
+
+struct counts_s {
+    Dwarf_Unsigned c_mallocs;
+    Dwarf_Unsigned c_frees;
+    Dwarf_Unsigned c_bytes;
+    Dwarf_Unsigned c_outstanding;
+};
+
+/*  Each block is preceded by its length so
+    c_outstanding can be kept exact. The header is
+    the size of the largest basic type to keep
+    the returned space aligned. */
+union header_u {
+    Dwarf_Unsigned h_len;
+    double         h_align_d;
+    void          *h_align_p;
+};
+
+static void *
+count_malloc(void *user_data,Dwarf_Unsigned len)
+{
+    struct counts_s *c = (struct counts_s *)user_data;
+    union header_u *h = 0;
+
+    h = (union header_u *)malloc(sizeof(union header_u) +
+        (size_t)len);
+    if (!h) {
+        return 0;
+    }
+    h->h_len = len;
+    ++c->c_mallocs;
+    c->c_bytes += len;
+    c->c_outstanding += len;
+    return (void *)(h+1);
+}
+
+static void
+count_free(void *user_data,void *space)
+{
+    struct counts_s *c = (struct counts_s *)user_data;
+    union header_u *h = ((union header_u *)space) - 1;
+
+    ++c->c_frees;
+    c->c_outstanding -= h->h_len;
+    free(h);
+}
+
+static void
+check(const char *msg,int ok,int line)
+{
+    if (ok) {
+        return;
+    }
+    printf("FAIL %s test line %d\n",msg,line);
+    ++errcount;
+}
+
+static void
+setup_path(int argc,char **argv)
+{
+    const char *top = 0;
+    size_t len = 0;
+
+    if (argc > 2 && !strcmp(argv[1],"-f")) {
+        top = argv[2];
+    } else {
+        top = getenv("DWTOPSRCDIR");
+    }
+    if (!top) {
+        printf("FAIL test_allocator: use -f <source base> "
+            "or set DWTOPSRCDIR\n");
+        exit(EXIT_FAILURE);
+    }
+    len = strlen(top);
+    if (len + sizeof(OBJNAME) >= sizeof(pathbuf)) {
+        printf("FAIL test_allocator: path too long\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(pathbuf,top,len);
+    memcpy(pathbuf+len,OBJNAME,sizeof(OBJNAME));
+}
+
+/*  Reads the attributes of die and its children,
+    returning the number of DIEs seen. */
+static int
+walk_die(Dwarf_Debug dbg,Dwarf_Die die)
+{
+    Dwarf_Attribute *atlist = 0;
+    Dwarf_Signed atcount = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Die child = 0;
+    Dwarf_Error err = 0;
+    int count = 1;
+    int res = 0;
+
+    res = dwarf_attrlist(die,&atlist,&atcount,&err);
+    if (res == DW_DLV_OK) {
+        for (i = 0; i < atcount; ++i) {
+            dwarf_dealloc_attribute(atlist[i]);
+        }
+        dwarf_dealloc(dbg,atlist,DW_DLA_LIST);
+    }
+    res = dwarf_child(die,&child,&err);
+    while (res == DW_DLV_OK) {
+        Dwarf_Die sib = 0;
+
+        count += walk_die(dbg,child);
+        res = dwarf_siblingof_c(child,&sib,&err);
+        dwarf_dealloc_die(child);
+        child = sib;
+    }
+    return count;
+}
+
+static int
+walk_all(Dwarf_Debug dbg)
+{
+    int count = 0;
+
+    for (;;) {
+        Dwarf_Die cudie = 0;
+        Dwarf_Error err = 0;
+        int res = 0;
+
+        res = dwarf_next_cu_header_e(dbg,TRUE,&cudie,
+            0,0,0,0,0,0,0,0,0,0,&err);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        count += walk_die(dbg,cudie);
+        dwarf_dealloc_die(cudie);
+    }
+    return count;
+}
+
+/*  The allocators passed at init are used with
+    the process-wide default left alone. */
+static void
+test_init_path_alloc(void)
+{
+    struct counts_s counts1;
+    struct counts_s counts2;
+    Dwarf_Allocator alloc1;
+    Dwarf_Allocator alloc2;
+    Dwarf_Allocator half;
+    Dwarf_Allocator cur;
+    Dwarf_Debug dbg1 = 0;
+    Dwarf_Debug dbg2 = 0;
+    Dwarf_Error err = 0;
+    Dwarf_Unsigned mallocs1 = 0;
+    int res = 0;
+
+    memset(&counts1,0,sizeof(counts1));
+    memset(&counts2,0,sizeof(counts2));
+    memset(&half,0,sizeof(half));
+    half.da_malloc = count_malloc;
+    half.da_user_data = &counts1;
+    res = dwarf_init_path_alloc(pathbuf,0,0,DW_GROUPNUMBER_ANY,
+        0,&half,0,0,&dbg1,&err);
+    check("init reject da_free NULL",res == DW_DLV_ERROR,__LINE__);
+    if (res == DW_DLV_ERROR) {
+        check("DW_DLE_ALLOCATOR_ERROR",
+            dwarf_errno(err) == DW_DLE_ALLOCATOR_ERROR,__LINE__);
+        dwarf_dealloc_error(0,err);
+        err = 0;
+    }
+    check("nothing allocated by half allocator",
+        counts1.c_mallocs == 0 && !dbg1,__LINE__);
+
+    alloc1.da_malloc = count_malloc;
+    alloc1.da_free = count_free;
+    alloc1.da_user_data = &counts1;
+    alloc2 = alloc1;
+    alloc2.da_user_data = &counts2;
+    res = dwarf_init_path_alloc(pathbuf,0,0,DW_GROUPNUMBER_ANY,
+        0,&alloc1,0,0,&dbg1,&err);
+    check("init_path_alloc 1",res == DW_DLV_OK,__LINE__);
+    if (res != DW_DLV_OK) {
+        return;
+    }
+    mallocs1 = counts1.c_mallocs;
+    check("dbg1 allocated by alloc1",mallocs1 > 0,__LINE__);
+    res = dwarf_init_path_alloc(pathbuf,0,0,DW_GROUPNUMBER_ANY,
+        0,&alloc2,0,0,&dbg2,&err);
+    check("init_path_alloc 2",res == DW_DLV_OK,__LINE__);
+    if (res != DW_DLV_OK) {
+        dwarf_finish(dbg1);
+        return;
+    }
+    check("dbg2 allocated by alloc2",counts2.c_mallocs > 0,
+        __LINE__);
+    check("opening dbg2 left alloc1 alone",
+        counts1.c_mallocs == mallocs1,__LINE__);
+    res = dwarf_set_allocator(0,&cur);
+    check("default not changed by init",
+        res == DW_DLV_OK && !cur.da_malloc && !cur.da_free,
+        __LINE__);
+
+    walk_all(dbg2);
+    check("walking dbg2 left alloc1 alone",
+        counts1.c_mallocs == mallocs1,__LINE__);
+    walk_all(dbg1);
+    check("walking dbg1 used alloc1",
+        counts1.c_mallocs > mallocs1,__LINE__);
+    dwarf_finish(dbg1);
+    check("dbg1 every block freed",
+        counts1.c_frees == counts1.c_mallocs &&
+        counts1.c_outstanding == 0,__LINE__);
+    dwarf_finish(dbg2);
+    check("dbg2 every block freed",
+        counts2.c_frees == counts2.c_mallocs &&
+        counts2.c_outstanding == 0,__LINE__);
+}
+
+int
+main(int argc,char **argv)
+{
+    struct counts_s counts;
+    Dwarf_Allocator alloc;
+    Dwarf_Allocator old;
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    Dwarf_Unsigned info_size = 0;
+    Dwarf_Addr addr = 0;
+    Dwarf_Unsigned mallocs = 0;
+    int dies = 0;
+    int res = 0;
+
+    setup_path(argc,argv);
+    memset(&counts,0,sizeof(counts));
+    memset(&alloc,0,sizeof(alloc));
+
+    /*  Half an allocator is refused. */
+    alloc.da_malloc = count_malloc;
+    res = dwarf_set_allocator(&alloc,0);
+    check("reject da_free NULL",res == DW_DLV_ERROR,__LINE__);
+
+    alloc.da_free = count_free;
+    alloc.da_user_data = &counts;
+    memset(&old,1,sizeof(old));
+    res = dwarf_set_allocator(&alloc,&old);
+    check("dwarf_set_allocator",res == DW_DLV_OK,__LINE__);
+    check("default allocator is all zero",
+        !old.da_malloc && !old.da_free,__LINE__);
+
+    res = dwarf_init_path(pathbuf,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        printf("FAIL test_allocator: cannot open %s\n",
+            pathbuf);
+        exit(EXIT_FAILURE);
+    }
+    check("Dwarf_Debug allocated by it",counts.c_mallocs > 0,
+        __LINE__);
+    /*  Restoring the default does not change
+        an open Dwarf_Debug. */
+    res = dwarf_set_allocator(0,&old);
+    check("restore default",res == DW_DLV_OK,__LINE__);
+    check("old allocator returned",
+        old.da_malloc == count_malloc &&
+        old.da_free == count_free &&
+        old.da_user_data == (void *)&counts,__LINE__);
+    mallocs = counts.c_mallocs;
+    dies = walk_all(dbg);
+    check("DIEs read",dies > 10,__LINE__);
+    check("DIEs and attributes allocated by it",
+        counts.c_mallocs > mallocs + (Dwarf_Unsigned)dies,
+        __LINE__);
+    res = dwarf_get_section_info_by_name(dbg,".debug_info",
+        &addr,&info_size,&err);
+    check(".debug_info present",res == DW_DLV_OK,__LINE__);
+    check("section data allocated by it",
+        counts.c_bytes > info_size,__LINE__);
+    dwarf_finish(dbg);
+    check("every block freed",
+        counts.c_frees == counts.c_mallocs,__LINE__);
+    check("no bytes outstanding",counts.c_outstanding == 0,
+        __LINE__);
+
+    /*  With the default back in place the
+        counting allocator is not called. */
+    mallocs = counts.c_mallocs;
+    dbg = 0;
+    res = dwarf_init_path(pathbuf,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&err);
+    check("second open",res == DW_DLV_OK,__LINE__);
+    if (res == DW_DLV_OK) {
+        walk_all(dbg);
+        dwarf_finish(dbg);
+    }
+    check("default allocator used",
+        counts.c_mallocs == mallocs,__LINE__);
+
+    test_init_path_alloc();
+    if (errcount) {
+        printf("FAIL test_allocator\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_allocator\n");
+    return 0;
+}
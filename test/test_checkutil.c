@@ -0,0 +1,205 @@
+/*
+  Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of version 2 of the GNU General
+  Public License as published by the Free Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU General Public
+  License along with this program; if not, write the Free
+  Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+  Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks that the interval and key indexes used by
+    the dd_checkutil.c lookups give the same answers
+    as a linear search of what was added. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() */
+
+#ifdef HAVE_STDINT_H
+#include <stdint.h> /* uintptr_t */
+#endif /* HAVE_STDINT_H */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dd_globals.h"
+#include "dd_glflags.h"
+#include "dd_minimal.h"
+
+struct glflags_s glflags;
+void dd_minimal_count_global_error(void) {}
+
+#define MAXRANGES 3000
+
+static Dwarf_Addr lows[MAXRANGES];
+static Dwarf_Addr highs[MAXRANGES];
+static int nranges;
+static unsigned long seed = 1;
+
+static unsigned long
+next_random(void)
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 8) & 0xffffff;
+}
+
+static Dwarf_Bool
+linear_find(Dwarf_Addr addr)
+{
+    int i = 0;
+
+    for (i = 0; i < nranges; ++i) {
+        if (addr >= lows[i] && addr <= highs[i]) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+static int
+check_addresses(Bucket_Group *g,const char *msg)
+{
+    int failcount = 0;
+    Dwarf_Addr a = 0;
+
+    for (a = 0; a < 0x30000; a += 7) {
+        Dwarf_Bool want = linear_find(a);
+
+        if (FindAddressInBucketGroup(g,a) != want) {
+            printf("FAIL %s address 0x%lx\n",msg,
+                (unsigned long)a);
+            ++failcount;
+            break;
+        }
+        if (IsValidInBucketGroup(g,a) != want) {
+            printf("FAIL %s valid 0x%lx\n",msg,
+                (unsigned long)a);
+            ++failcount;
+            break;
+        }
+    }
+    return failcount;
+}
+
+static void
+add_range(Bucket_Group *g,Dwarf_Addr low, Dwarf_Addr high)
+{
+    lows[nranges] = low;
+    highs[nranges] = high;
+    ++nranges;
+    AddEntryIntoBucketGroup(g,0,low,low,high,NULL,FALSE);
+}
+
+static int
+test_ranges(void)
+{
+    Bucket_Group *g = AllocateBucketGroup(KIND_RANGES_INFO);
+    int failcount = 0;
+    int i = 0;
+
+    SetLimitsBucketGroup(g,0,0x40000);
+    /*  Index built on the first lookup. */
+    for (i = 0; i < MAXRANGES/2; ++i) {
+        Dwarf_Addr low = next_random() % 0x30000;
+
+        add_range(g,low,low + (next_random() % 40));
+    }
+    /* Touching but not overlapping, and low > high. */
+    add_range(g,0x100,0x1ff);
+    add_range(g,0x200,0x2ff);
+    add_range(g,0x500,0x400);
+    failcount += check_addresses(g,"built");
+
+    /*  Entries added after the index exists. */
+    for (i = 0; i < MAXRANGES/2 - 3; ++i) {
+        Dwarf_Addr low = next_random() % 0x30000;
+
+        add_range(g,low,low + (next_random() % 40));
+    }
+    failcount += check_addresses(g,"maintained");
+
+    ResetBucketGroup(g);
+    nranges = 0;
+    failcount += check_addresses(g,"reset");
+    add_range(g,0x1000,0x1010);
+    failcount += check_addresses(g,"after reset");
+    ReleaseBucketGroup(g);
+    nranges = 0;
+    return failcount;
+}
+
+static int
+test_keys(void)
+{
+    Bucket_Group *g = AllocateBucketGroup(KIND_VISITED_INFO);
+    int failcount = 0;
+    Bucket_Data *d = 0;
+
+    ResetBucketGroup(g);
+    AddEntryIntoBucketGroup(g,0x40,0,0,0,NULL,FALSE);
+    if (FindKeyInBucketGroup(g,0x30)) {
+        printf("FAIL key 0x30 found, not added\n");
+        ++failcount;
+    }
+    AddEntryIntoBucketGroup(g,0x30,0,0,0,NULL,FALSE);
+    AddEntryIntoBucketGroup(g,0x30,0,0,0,NULL,FALSE);
+    d = FindKeyInBucketGroup(g,0x30);
+    if (!d || d->key != 0x30) {
+        printf("FAIL key 0x30 not found\n");
+        ++failcount;
+    }
+    DeleteKeyInBucketGroup(g,0x30);
+    if (!FindKeyInBucketGroup(g,0x30)) {
+        printf("FAIL duplicate key 0x30 lost\n");
+        ++failcount;
+    }
+    DeleteKeyInBucketGroup(g,0x30);
+    if (FindKeyInBucketGroup(g,0x30)) {
+        printf("FAIL key 0x30 found after delete\n");
+        ++failcount;
+    }
+    if (!FindKeyInBucketGroup(g,0x40)) {
+        printf("FAIL key 0x40 not found\n");
+        ++failcount;
+    }
+    ResetBucketGroup(g);
+    if (FindKeyInBucketGroup(g,0x40)) {
+        printf("FAIL key 0x40 found after reset\n");
+        ++failcount;
+    }
+    ReleaseBucketGroup(g);
+    return failcount;
+}
+
+int main(void)
+{
+    int failcount = 0;
+
+    failcount += test_ranges();
+    failcount += test_keys();
+    if (failcount) {
+        printf("FAIL checkutil test\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS checkutil test\n");
+    exit(EXIT_SUCCESS);
+}
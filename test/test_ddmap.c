@@ -0,0 +1,365 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <string.h> /* memset() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dd_map.h"
+#include "dd_intern.h"
+#include "dd_addrmap.h"
+
+/*  Each map is checked against a plain array indexed
+    by key number: the keys used are keynum*KEYSTEP
+    (plus a high bias for some runs) so both maps see
+    key 0, clustered keys and keys far apart. */
+
+#define KEYCOUNT 5000
+#define KEYSTEP  8
+
+struct test_entry {
+    Dwarf_Unsigned te_key;
+    Dwarf_Unsigned te_val;
+};
+
+static Dwarf_Unsigned ref_val[KEYCOUNT];
+static Dwarf_Bool     ref_present[KEYCOUNT];
+static Dwarf_Unsigned rand_state = 1;
+
+static Dwarf_Unsigned
+next_rand(void)
+{
+    rand_state = rand_state*6364136223846793005ULL +
+        1442695040888963407ULL;
+    return rand_state >> 33;
+}
+
+static Dwarf_Unsigned
+key_of(Dwarf_Unsigned n,Dwarf_Unsigned bias)
+{
+    return bias + n*KEYSTEP;
+}
+
+/*  Chooses the next key number, in random order or
+    in increasing order (with the odd step back,
+    as FDE low_pc values have). */
+static Dwarf_Unsigned
+pick(int ascending, Dwarf_Unsigned i)
+{
+    if (ascending) {
+        Dwarf_Unsigned n = i % KEYCOUNT;
+
+        if (n && !(i % 17)) {
+            return n - 1;
+        }
+        return n;
+    }
+    return next_rand() % KEYCOUNT;
+}
+
+static void
+fail(const char *name,const char *msg,Dwarf_Unsigned n,
+    int *failcount)
+{
+    printf("FAIL %s %s key number %lu\n",name,msg,
+        (unsigned long)n);
+    (*failcount)++;
+}
+
+struct walk_data {
+    Dwarf_Unsigned wd_bias;
+    Dwarf_Unsigned wd_seen;
+    int            wd_bad;
+};
+
+static void
+walk_visit(void *entry, void *data)
+{
+    struct test_entry *e = (struct test_entry *)entry;
+    struct walk_data *wd = (struct walk_data *)data;
+    Dwarf_Unsigned n = (e->te_key - wd->wd_bias)/KEYSTEP;
+
+    if (n >= KEYCOUNT || !ref_present[n] ||
+        e->te_val != ref_val[n]) {
+        wd->wd_bad++;
+    }
+    wd->wd_seen++;
+}
+
+static void
+test_hash_map(struct Dd_Hash_Map_s *map,int ascending,
+    Dwarf_Unsigned bias,int *failcount)
+{
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned count = 0;
+    const char *name = ascending?"hash ascending":"hash random";
+
+    memset(ref_present,0,sizeof(ref_present));
+    for (i = 0; i < 3*KEYCOUNT; ++i) {
+        Dwarf_Unsigned n = pick(ascending,i);
+        Dwarf_Bool is_new = FALSE;
+        struct test_entry *e = 0;
+
+        e = (struct test_entry *)dd_hash_map_insert(map,
+            key_of(n,bias),&is_new);
+        if (!e) {
+            fail(name,"insert returned NULL",n,failcount);
+            return;
+        }
+        if (e->te_key != key_of(n,bias)) {
+            fail(name,"insert wrong key",n,failcount);
+        }
+        if (is_new == ref_present[n]) {
+            fail(name,"insert is_new wrong",n,failcount);
+        }
+        if (is_new) {
+            if (e->te_val) {
+                fail(name,"new entry not zeroed",n,failcount);
+            }
+            ref_present[n] = TRUE;
+            ++count;
+        } else if (e->te_val != ref_val[n]) {
+            fail(name,"insert old value wrong",n,failcount);
+        }
+        e->te_val = i+1;
+        ref_val[n] = i+1;
+    }
+    if (dd_hash_map_count(map) != count) {
+        fail(name,"count wrong",count,failcount);
+    }
+    for (i = 0; i < KEYCOUNT; ++i) {
+        struct test_entry *e = 0;
+
+        e = (struct test_entry *)dd_hash_map_find(map,
+            key_of(i,bias));
+        if (ref_present[i]) {
+            if (!e || e->te_key != key_of(i,bias) ||
+                e->te_val != ref_val[i]) {
+                fail(name,"find wrong",i,failcount);
+            }
+        } else if (e) {
+            fail(name,"find found absent key",i,failcount);
+        }
+        /* Between the keys, never present. */
+        if (dd_hash_map_find(map,key_of(i,bias)+1)) {
+            fail(name,"find found in-between key",i,failcount);
+        }
+    }
+    {
+        struct walk_data wd;
+
+        memset(&wd,0,sizeof(wd));
+        wd.wd_bias = bias;
+        dd_hash_map_walk(map,walk_visit,&wd);
+        if (wd.wd_bad || wd.wd_seen != count) {
+            fail(name,"walk wrong",wd.wd_seen,failcount);
+        }
+    }
+    dd_hash_map_destroy(map);
+    if (dd_hash_map_count(map) ||
+        dd_hash_map_find(map,key_of(0,bias))) {
+        fail(name,"destroy left entries",0,failcount);
+    }
+}
+
+static void
+test_sorted_map(struct Dd_Sorted_Map_s *map,int ascending,
+    Dwarf_Unsigned bias,int *failcount)
+{
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned n = 0;
+    const char *name = ascending?"sorted ascending":
+        "sorted random";
+
+    memset(ref_present,0,sizeof(ref_present));
+    for (i = 0; i < 3*KEYCOUNT; ++i) {
+        Dwarf_Bool is_new = FALSE;
+        struct test_entry *e = 0;
+
+        n = pick(ascending,i);
+        e = (struct test_entry *)dd_sorted_map_insert(map,
+            key_of(n,bias),&is_new);
+        if (!e) {
+            fail(name,"insert returned NULL",n,failcount);
+            return;
+        }
+        if (e->te_key != key_of(n,bias)) {
+            fail(name,"insert wrong key",n,failcount);
+        }
+        if (is_new == ref_present[n]) {
+            fail(name,"insert is_new wrong",n,failcount);
+        }
+        if (is_new) {
+            if (e->te_val) {
+                fail(name,"new entry not zeroed",n,failcount);
+            }
+            ref_present[n] = TRUE;
+            ++count;
+        } else if (e->te_val != ref_val[n]) {
+            fail(name,"insert old value wrong",n,failcount);
+        }
+        e->te_val = i+1;
+        ref_val[n] = i+1;
+    }
+    if (dd_sorted_map_count(map) != count) {
+        fail(name,"count wrong",count,failcount);
+    }
+    for (i = 0; i < KEYCOUNT; ++i) {
+        struct test_entry *e = 0;
+
+        e = (struct test_entry *)dd_sorted_map_find(map,
+            key_of(i,bias));
+        if (ref_present[i]) {
+            if (!e || e->te_key != key_of(i,bias) ||
+                e->te_val != ref_val[i]) {
+                fail(name,"find wrong",i,failcount);
+            }
+        } else if (e) {
+            fail(name,"find found absent key",i,failcount);
+        }
+        if (dd_sorted_map_find(map,key_of(i,bias)+1)) {
+            fail(name,"find found in-between key",i,failcount);
+        }
+    }
+    /* Walking by index must give the keys in order. */
+    n = 0;
+    for (i = 0; i < KEYCOUNT; ++i) {
+        struct test_entry *e = 0;
+
+        if (!ref_present[i]) {
+            continue;
+        }
+        e = (struct test_entry *)dd_sorted_map_entry(map,n);
+        if (!e || e->te_key != key_of(i,bias)) {
+            fail(name,"entry order wrong",i,failcount);
+        }
+        ++n;
+    }
+    dd_sorted_map_destroy(map);
+    if (dd_sorted_map_count(map) ||
+        dd_sorted_map_find(map,key_of(0,bias))) {
+        fail(name,"destroy left entries",0,failcount);
+    }
+}
+
+/*  The address map print_frames.c keeps FDE low_pc
+    values in looks each address up before inserting
+    it. Here the addresses arrive in descending order,
+    or alternately from the low and the high end. */
+static void
+test_addr_map(int interleaved,int *failcount)
+{
+    void *map = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned bias = 0x400000;
+    const char *name = interleaved?"addr_map interleaved":
+        "addr_map descending";
+
+    for (i = 0; i < KEYCOUNT; ++i) {
+        Dwarf_Unsigned n = KEYCOUNT - 1 - i;
+        Dwarf_Unsigned addr = 0;
+        struct Addr_Map_Entry *e = 0;
+
+        if (interleaved) {
+            n = (i & 1)? KEYCOUNT - 1 - i/2 : i/2;
+        }
+        addr = key_of(n,bias);
+        if (addr_map_find(addr,&map)) {
+            fail(name,"found before insert",n,failcount);
+        }
+        e = addr_map_insert(addr,(n & 1)?"odd":0,&map);
+        if (!e || e->mp_key != addr) {
+            fail(name,"insert",n,failcount);
+        }
+        if (addr_map_find(addr,&map) != e) {
+            fail(name,"find after insert",n,failcount);
+        }
+    }
+    for (i = 0; i < KEYCOUNT; ++i) {
+        struct Addr_Map_Entry *e = 0;
+
+        e = addr_map_find(key_of(i,bias),&map);
+        if (!e) {
+            fail(name,"missing",i,failcount);
+            continue;
+        }
+        if ((i & 1) != (e->mp_name != 0)) {
+            fail(name,"wrong name",i,failcount);
+        }
+    }
+    if (addr_map_find(key_of(KEYCOUNT,bias),&map) ||
+        addr_map_find(bias + 1,&map)) {
+        fail(name,"found an address never inserted",0,
+            failcount);
+    }
+    addr_map_destroy(map);
+}
+
+int
+main(int argc, char *argv[])
+{
+    int failcount = 0;
+    struct Dd_Hash_Map_s hmap;
+    struct Dd_Sorted_Map_s smap;
+    Dwarf_Unsigned highbias = 0xffff000000000000ULL;
+
+    dd_hash_map_init(&hmap,sizeof(struct test_entry));
+    dd_sorted_map_init(&smap,sizeof(struct test_entry));
+
+    /*  Empty maps find nothing. */
+    if (dd_hash_map_find(&hmap,0) ||
+        dd_sorted_map_find(&smap,0)) {
+        printf("FAIL empty map found an entry\n");
+        failcount++;
+    }
+    /*  Each map is reused after destroy. */
+    test_hash_map(&hmap,0,0,&failcount);
+    test_hash_map(&hmap,1,0,&failcount);
+    test_hash_map(&hmap,0,highbias,&failcount);
+    test_sorted_map(&smap,0,0,&failcount);
+    test_sorted_map(&smap,1,0,&failcount);
+    test_sorted_map(&smap,1,highbias,&failcount);
+    test_addr_map(0,&failcount);
+    test_addr_map(1,&failcount);
+    if (failcount) {
+        printf("FAIL ddmap, %d failures\n",failcount);
+        return 1;
+    }
+    printf("PASS ddmap\n");
+    return 0;
+    (void)argc;
+    (void)argv;
+}
@@ -0,0 +1,257 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  Tests the dd_out_* functions of dwarfdump's
+    dd_output.c: each must write what the printf()
+    format it stands in for writes, and a width
+    wider than DD_NUMBUF_LEN gets only the padding
+    that fits.
+    stdout is sent to a junk file and each result
+    read back from there, so messages go to stderr. */
+
+#include <config.h>
+
+#include <stdio.h>  /* fprintf() fread() freopen() remove() sprintf() */
+#include <stdlib.h> /* exit() */
+#include <string.h> /* memcmp() memset() strcpy() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dd_output.h"
+
+#define OUTNAME "junk.ddoutput"
+#define BUFLEN 400
+
+static int errcount;
+static long outstart;
+
+static void
+start_output(void)
+{
+    fflush(stdout);
+    outstart = ftell(stdout);
+}
+
+/*  Reads back what was written since start_output()
+    and compares it with expect. */
+static void
+check_output(const char *msg,const char *expect,int line)
+{
+    char got[BUFLEN];
+    size_t explen = strlen(expect);
+    size_t len = 0;
+    long end = 0;
+
+    fflush(stdout);
+    end = ftell(stdout);
+    if (end < outstart || (size_t)(end - outstart) >= BUFLEN) {
+        fprintf(stderr,"FAIL %s output length %ld test line %d\n",
+            msg,end - outstart,line);
+        ++errcount;
+        return;
+    }
+    len = (size_t)(end - outstart);
+    fseek(stdout,outstart,SEEK_SET);
+    if (fread(got,1,len,stdout) != len) {
+        fprintf(stderr,"FAIL %s cannot read back test line %d\n",
+            msg,line);
+        ++errcount;
+        fseek(stdout,0,SEEK_END);
+        return;
+    }
+    fseek(stdout,0,SEEK_END);
+    got[len] = 0;
+    if (len == explen && !memcmp(got,expect,len)) {
+        return;
+    }
+    fprintf(stderr,"FAIL %s expected \"%s\" got \"%s\" "
+        "test line %d\n",msg,expect,got,line);
+    ++errcount;
+}
+
+static const Dwarf_Unsigned uvals[] = {
+0,1,9,10,0xabc,12345,0xffffffff,
+((Dwarf_Unsigned)0x1234567 << 32) | 0x89abcdef,
+~(Dwarf_Unsigned)0
+};
+#define UVAL_COUNT (sizeof(uvals)/sizeof(uvals[0]))
+
+static const Dwarf_Signed svals[] = {
+0,1,-1,42,-42,1234567,-1234567,
+(Dwarf_Signed)(~(Dwarf_Unsigned)0 >> 1),
+/*  The most negative value, which has no positive. */
+-(Dwarf_Signed)(~(Dwarf_Unsigned)0 >> 1) - 1
+};
+#define SVAL_COUNT (sizeof(svals)/sizeof(svals[0]))
+
+static const int widths[] = {0,1,2,8,10,16,20,30};
+#define WIDTH_COUNT (sizeof(widths)/sizeof(widths[0]))
+
+static void
+test_numbers(void)
+{
+    char expect[BUFLEN];
+    unsigned i = 0;
+    unsigned w = 0;
+
+    for (i = 0; i < UVAL_COUNT; ++i) {
+        for (w = 0; w < WIDTH_COUNT; ++w) {
+            int width = widths[w];
+
+            sprintf(expect,"0x%0*" DW_PR_DUx,width,uvals[i]);
+            start_output();
+            dd_out_hex(uvals[i],width);
+            check_output("dd_out_hex",expect,__LINE__);
+
+            sprintf(expect,"%*" DW_PR_DUu,width,uvals[i]);
+            start_output();
+            dd_out_udec(uvals[i],width);
+            check_output("dd_out_udec",expect,__LINE__);
+        }
+    }
+    for (i = 0; i < SVAL_COUNT; ++i) {
+        for (w = 0; w < WIDTH_COUNT; ++w) {
+            int width = widths[w];
+
+            sprintf(expect,"%*" DW_PR_DSd,width,svals[i]);
+            start_output();
+            dd_out_sdec(svals[i],width);
+            check_output("dd_out_sdec",expect,__LINE__);
+
+            sprintf(expect,"%0*" DW_PR_DSd,width,svals[i]);
+            start_output();
+            dd_out_sdec_zero(svals[i],width);
+            check_output("dd_out_sdec_zero",expect,__LINE__);
+        }
+    }
+}
+
+/*  Builds count copies of fill followed by tail. */
+static void
+make_padded(char *out,int fill,size_t count,const char *tail)
+{
+    memset(out,fill,count);
+    strcpy(out+count,tail);
+}
+
+static void
+test_truncation(void)
+{
+    char expect[BUFLEN];
+
+    /*  Padding stops at DD_NUMBUF_LEN bytes in all. */
+    make_padded(expect,' ',DD_NUMBUF_LEN-3,"123");
+    start_output();
+    dd_out_udec(123,DD_NUMBUF_LEN+50);
+    check_output("dd_out_udec wide",expect,__LINE__);
+
+    make_padded(expect,' ',DD_NUMBUF_LEN-3,"-12");
+    start_output();
+    dd_out_sdec(-12,DD_NUMBUF_LEN*3);
+    check_output("dd_out_sdec wide",expect,__LINE__);
+
+    expect[0] = '-';
+    make_padded(expect+1,'0',DD_NUMBUF_LEN-3,"12");
+    start_output();
+    dd_out_sdec_zero(-12,DD_NUMBUF_LEN+1);
+    check_output("dd_out_sdec_zero wide",expect,__LINE__);
+
+    expect[0] = '0';
+    expect[1] = 'x';
+    make_padded(expect+2,'0',DD_NUMBUF_LEN-4,"ab");
+    start_output();
+    dd_out_hex(0xab,DD_NUMBUF_LEN);
+    check_output("dd_out_hex wide",expect,__LINE__);
+
+    /*  Exactly DD_NUMBUF_LEN is not cut. */
+    make_padded(expect,' ',DD_NUMBUF_LEN-1,"7");
+    start_output();
+    dd_out_udec(7,DD_NUMBUF_LEN);
+    check_output("dd_out_udec at the limit",expect,__LINE__);
+
+    /*  Digits wider than the width are never cut. */
+    start_output();
+    dd_out_udec(~(Dwarf_Unsigned)0,3);
+    check_output("dd_out_udec narrow","18446744073709551615",
+        __LINE__);
+    start_output();
+    dd_out_sdec(-100,-5);
+    check_output("dd_out_sdec negative width","-100",__LINE__);
+}
+
+static void
+test_strings(void)
+{
+    char expect[BUFLEN];
+    static const int counts[] = {-1,0,1,63,64,65,128,200};
+    unsigned i = 0;
+
+    for (i = 0; i < sizeof(counts)/sizeof(counts[0]); ++i) {
+        int count = counts[i];
+
+        make_padded(expect,' ',count > 0?(size_t)count:0,"|");
+        start_output();
+        dd_out_spaces(count);
+        dd_out_char('|');
+        check_output("dd_out_spaces",expect,__LINE__);
+    }
+    start_output();
+    dd_out_string("");
+    check_output("dd_out_string empty","",__LINE__);
+    start_output();
+    dd_out_string("<a b>");
+    dd_out_char('x');
+    printf("%d",5);
+    dd_out_string("\n");
+    check_output("mixed with printf","<a b>x5\n",__LINE__);
+}
+
+int
+main(void)
+{
+    if (!freopen(OUTNAME,"w+",stdout)) {
+        fprintf(stderr,"FAIL test_ddoutput cannot open %s\n",
+            OUTNAME);
+        exit(EXIT_FAILURE);
+    }
+    test_numbers();
+    test_truncation();
+    test_strings();
+    fclose(stdout);
+    remove(OUTNAME);
+    if (errcount) {
+        fprintf(stderr,"FAIL test_ddoutput\n");
+        exit(EXIT_FAILURE);
+    }
+    fprintf(stderr,"PASS test_ddoutput\n");
+    return 0;
+}
@@ -0,0 +1,291 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  Tests the per-CU DIE table (dwarf_die_table_build()
+    and friends) and dwarf_die_parent() against a
+    dwarf_child()/dwarf_siblingof_c() walk of every CU,
+    and that the table memory comes from the allocator
+    passed to dwarf_init_path_alloc().
+
+    ./test_dietable -f <top of the source tree>
+    or with DWTOPSRCDIR set in the environment. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() free() getenv() malloc() */
+#include <string.h> /* strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+
+#define OBJNAME "/test/testmulticuLE64ELf.testme"
+#define MAX_DEPTH 20
+
+static int errcount;
+static char pathbuf[2000];
+static Dwarf_Unsigned mallocs;
+static Dwarf_Unsigned frees;
+
+/*  Counts calls only, blocks are plain malloc()ed. */
+static void *
+count_malloc(void *user_data,Dwarf_Unsigned len)
+{
+    (void)user_data;
+    ++mallocs;
+    return malloc((size_t)len);
+}
+
+static void
+count_free(void *user_data,void *space)
+{
+    (void)user_data;
+    ++frees;
+    free(space);
+}
+
+static void
+check(const char *msg,int ok,int line)
+{
+    if (ok) {
+        return;
+    }
+    printf("FAIL %s test line %d\n",msg,line);
+    ++errcount;
+}
+
+static void
+setup_path(int argc,char **argv)
+{
+    const char *top = 0;
+    size_t len = 0;
+
+    if (argc > 2 && !strcmp(argv[1],"-f")) {
+        top = argv[2];
+    } else {
+        top = getenv("DWTOPSRCDIR");
+    }
+    if (!top) {
+        printf("FAIL test_dietable: use -f <source base> "
+            "or set DWTOPSRCDIR\n");
+        exit(EXIT_FAILURE);
+    }
+    len = strlen(top);
+    if (len + sizeof(OBJNAME) >= sizeof(pathbuf)) {
+        printf("FAIL test_dietable: path too long\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(pathbuf,top,len);
+    memcpy(pathbuf+len,OBJNAME,sizeof(OBJNAME));
+}
+
+static Dwarf_Off
+die_offset(Dwarf_Die die)
+{
+    Dwarf_Off off = 0;
+    Dwarf_Error err = 0;
+
+    if (dwarf_dieoffset(die,&off,&err) != DW_DLV_OK) {
+        check("dwarf_dieoffset",0,__LINE__);
+    }
+    return off;
+}
+
+/*  Checks the table entry of die against what
+    the walk knows: its parent (the table index
+    of the parent, or DW_DIE_TABLE_NO_INDEX),
+    its depth, and the previous sibling's index
+    whose sibling link must point here.
+    Returns the number of DIEs checked and sets
+    *index_out to the index of die. */
+static int
+check_die(Dwarf_Die die,Dwarf_Unsigned parent_index,
+    Dwarf_Off parent_off,Dwarf_Unsigned depth,
+    Dwarf_Unsigned *index_out)
+{
+    Dwarf_Error err = 0;
+    Dwarf_Unsigned index = 0;
+    Dwarf_Off off = 0;
+    Dwarf_Half tag = 0;
+    Dwarf_Half realtag = 0;
+    Dwarf_Unsigned abbrev = 0;
+    Dwarf_Unsigned edepth = 0;
+    Dwarf_Unsigned eparent = 0;
+    Dwarf_Unsigned esibling = 0;
+    Dwarf_Unsigned efirst = 0;
+    Dwarf_Unsigned previndex = DW_DIE_TABLE_NO_INDEX;
+    Dwarf_Die parent = 0;
+    Dwarf_Die child = 0;
+    int count = 1;
+    int res = 0;
+
+    res = dwarf_die_table_index(die,&index,&err);
+    check("dwarf_die_table_index",res == DW_DLV_OK,__LINE__);
+    if (res != DW_DLV_OK) {
+        return count;
+    }
+    *index_out = index;
+    res = dwarf_die_table_entry(die,index,&off,&tag,&abbrev,
+        &edepth,&eparent,&esibling,&efirst,&err);
+    check("dwarf_die_table_entry",res == DW_DLV_OK,__LINE__);
+    check("entry offset",off == die_offset(die),__LINE__);
+    dwarf_tag(die,&realtag,&err);
+    check("entry tag",tag == realtag,__LINE__);
+    check("entry abbrev code",abbrev == dwarf_die_abbrev_code(die),
+        __LINE__);
+    check("entry depth",edepth == depth,__LINE__);
+    check("entry parent",eparent == parent_index,__LINE__);
+
+    res = dwarf_die_parent(die,&parent,&err);
+    if (parent_index == DW_DIE_TABLE_NO_INDEX) {
+        check("CU DIE has no parent",res == DW_DLV_NO_ENTRY,
+            __LINE__);
+    } else {
+        check("dwarf_die_parent",res == DW_DLV_OK,__LINE__);
+        if (res == DW_DLV_OK) {
+            Dwarf_Unsigned pindex = 0;
+
+            check("parent offset",die_offset(parent) == parent_off,
+                __LINE__);
+            /*  A DIE from the table knows its index. */
+            res = dwarf_die_table_index(parent,&pindex,&err);
+            check("parent index",res == DW_DLV_OK &&
+                pindex == parent_index,__LINE__);
+            dwarf_dealloc_die(parent);
+        }
+    }
+
+    /*  die knows its index by now, so the children
+        get theirs from the table as they are read. */
+    res = dwarf_child(die,&child,&err);
+    check("first child link",
+        (res == DW_DLV_OK) == (efirst != DW_DIE_TABLE_NO_INDEX),
+        __LINE__);
+    while (res == DW_DLV_OK) {
+        Dwarf_Die sib = 0;
+        Dwarf_Unsigned kidindex = 0;
+
+        count += check_die(child,index,off,depth+1,&kidindex);
+        if (previndex == DW_DIE_TABLE_NO_INDEX) {
+            check("first child index",kidindex == efirst,
+                __LINE__);
+        } else {
+            Dwarf_Unsigned psib = 0;
+
+            dwarf_die_table_entry(die,previndex,0,0,0,0,0,
+                &psib,0,&err);
+            check("sibling index",psib == kidindex,__LINE__);
+        }
+        previndex = kidindex;
+        res = dwarf_siblingof_c(child,&sib,&err);
+        dwarf_dealloc_die(child);
+        child = sib;
+    }
+    if (previndex != DW_DIE_TABLE_NO_INDEX) {
+        Dwarf_Unsigned psib = 0;
+
+        dwarf_die_table_entry(die,previndex,0,0,0,0,0,
+            &psib,0,&err);
+        check("last child has no sibling",
+            psib == DW_DIE_TABLE_NO_INDEX,__LINE__);
+    }
+    return count;
+}
+
+int
+main(int argc,char **argv)
+{
+    Dwarf_Allocator alloc;
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    int cus = 0;
+    int res = 0;
+
+    setup_path(argc,argv);
+    memset(&alloc,0,sizeof(alloc));
+    alloc.da_malloc = count_malloc;
+    alloc.da_free = count_free;
+    res = dwarf_init_path_alloc(pathbuf,0,0,DW_GROUPNUMBER_ANY,
+        0,&alloc,0,0,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        printf("FAIL test_dietable: cannot open %s\n",pathbuf);
+        exit(EXIT_FAILURE);
+    }
+    for (;;) {
+        Dwarf_Die cudie = 0;
+        Dwarf_Die outofrange = 0;
+        Dwarf_Unsigned count = 0;
+        Dwarf_Unsigned again = 0;
+        Dwarf_Unsigned cuindex = 0;
+        Dwarf_Unsigned before = 0;
+        int walked = 0;
+
+        res = dwarf_next_cu_header_e(dbg,TRUE,&cudie,
+            0,0,0,0,0,0,0,0,0,0,&err);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        ++cus;
+        before = mallocs;
+        res = dwarf_die_table_build(cudie,&count,&err);
+        check("dwarf_die_table_build",res == DW_DLV_OK,__LINE__);
+        check("table memory from the allocator",mallocs > before,
+            __LINE__);
+        before = mallocs;
+        res = dwarf_die_table_build(cudie,&again,&err);
+        check("second build reuses the table",
+            res == DW_DLV_OK && again == count &&
+            mallocs == before,__LINE__);
+        walked = check_die(cudie,DW_DIE_TABLE_NO_INDEX,0,0,
+            &cuindex);
+        check("CU DIE is entry 0",cuindex == 0,__LINE__);
+        check("table has every DIE",
+            (Dwarf_Unsigned)walked == count,__LINE__);
+        res = dwarf_die_table_die(cudie,count,&outofrange,&err);
+        check("index past the end",res == DW_DLV_NO_ENTRY,
+            __LINE__);
+        res = dwarf_die_table_entry(cudie,count,0,0,0,0,0,0,0,
+            &err);
+        check("entry past the end",res == DW_DLV_NO_ENTRY,
+            __LINE__);
+        dwarf_dealloc_die(cudie);
+    }
+    check("two CUs",cus == 2,__LINE__);
+    dwarf_finish(dbg);
+    check("all allocator memory freed",mallocs == frees,__LINE__);
+    if (errcount) {
+        printf("FAIL test_dietable\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_dietable\n");
+    return 0;
+}
@@ -0,0 +1,110 @@
+#!/bin/sh
+# Copyright (C) 2026 David Anderson
+# This script is hereby placed in the Public Domain
+# for anyone to use in any way for any purpose.
+#
+# Checks dwarfdump --file-batch: each file's output
+# must match a plain single-file run, in command
+# line order, for any number of jobs and when the
+# names come from an @listfile.
+#
+# Assumes we run the script in the test directory of the build.
+# Either pass in the top source dir as an argument
+# or set env var DWTOPSRCDIR to the source directory.
+
+chkres() {
+r=$1
+m=$2
+if [ $r -ne 0 ]
+then
+  echo "FAIL $m.  Exit status for the test $r"
+  exit 1
+fi
+}
+
+if [ $# -gt 0 ]
+then
+  top_srcdir="$1"
+else
+  top_srcdir=$DWTOPSRCDIR
+fi
+blddir=`pwd`
+bname=`basename $blddir`
+top_blddir="$blddir"
+if [ x$bname = "xtest" ]
+then
+  top_blddir="$blddir/.."
+fi
+dd=$top_blddir/src/bin/dwarfdump/dwarfdump
+testsrc=$top_srcdir/test
+conf="-x name=$top_srcdir/src/bin/dwarfdump/dwarfdump.conf"
+o=junk.batch
+f1=$testsrc/testuriLE64ELf.testme
+f2=$testsrc/testobjLE32PE.exe
+f3=$testsrc/dummyexecutable
+
+rm -f $o.*
+i=1
+for f in $f1 $f2 $f3
+do
+  $dd $conf -ka $f > $o.single$i
+  chkres $? "running $dd -ka $f"
+  i=`expr $i + 1`
+done
+
+$dd $conf --file-batch-jobs=1 -ka $f1 $f2 $f3 > $o.jobs1
+chkres $? "running $dd --file-batch-jobs=1"
+
+# The lines printed once, before any file, are the
+# same as those starting a single-file run.
+hdr=`grep -n "batch file 1 of 3: " $o.jobs1 | cut -d: -f1`
+if [ x$hdr = "x" ]
+then
+  echo "FAIL no batch file header in $o.jobs1"
+  exit 1
+fi
+pre=`expr $hdr - 2`
+head -n $pre $o.single1 > $o.expect
+i=1
+for f in $f1 $f2 $f3
+do
+  echo "" >> $o.expect
+  echo "$dd batch file $i of 3: $f" >> $o.expect
+  tail -n +`expr $pre + 1` $o.single$i >> $o.expect
+  i=`expr $i + 1`
+done
+echo "" >> $o.expect
+echo "*** BATCH SUMMARY ***" >> $o.expect
+echo "Files dumped     : 3" >> $o.expect
+echo "Files failed     : 0" >> $o.expect
+n=`wc -l < $o.expect`
+head -n $n $o.jobs1 > $o.jobs1head
+diff $o.expect $o.jobs1head
+chkres $? "batch output differs from single-file runs"
+
+$dd $conf --file-batch-jobs=3 -ka $f1 $f2 $f3 > $o.jobs3
+chkres $? "running $dd --file-batch-jobs=3"
+diff $o.jobs1 $o.jobs3
+chkres $? "batch output depends on the number of jobs"
+
+echo "# batch list" > $o.list
+echo "$f1" >> $o.list
+echo "" >> $o.list
+echo "$f2" >> $o.list
+$dd $conf --file-batch-jobs=2 -ka @$o.list $f3 > $o.list3
+chkres $? "running $dd with an @listfile"
+diff $o.jobs1 $o.list3
+chkres $? "@listfile output differs"
+
+$dd $conf --file-batch -ka $f1 $testsrc/no-such-object > $o.fail
+if [ $? -eq 0 ]
+then
+  echo "FAIL a missing batch file must give failure status"
+  exit 1
+fi
+grep "^Files failed     : 1" $o.fail > /dev/null
+chkres $? "missing batch file not counted as failed"
+
+rm -f $o.*
+echo "PASS test_dwarfdumpbatch.sh"
+exit 0
@@ -0,0 +1,112 @@
+#!/bin/sh
+# Copyright (C) 2026 David Anderson
+# This script is hereby placed in the Public Domain
+# for anyone to use in any way for any purpose.
+#
+# Checks dwarfdump --format-json: every output line
+# must be a JSON object with a "type", and there must
+# be one die record per DIE the text output shows.
+#
+# Assumes we run the script in the test directory of the build.
+# Either pass in the top source dir as an argument
+# or set env var DWTOPSRCDIR to the source directory.
+
+chkres() {
+r=$1
+m=$2
+if [ $r -ne 0 ]
+then
+  echo "FAIL $m.  Exit status for the test $r"
+  exit 1
+fi
+}
+
+if [ $# -gt 0 ]
+then
+  top_srcdir="$1"
+else
+  top_srcdir=$DWTOPSRCDIR
+fi
+blddir=`pwd`
+bname=`basename $blddir`
+top_blddir="$blddir"
+if [ x$bname = "xtest" ]
+then
+  top_blddir="$blddir/.."
+fi
+dd=$top_blddir/src/bin/dwarfdump/dwarfdump
+testsrc=$top_srcdir/test
+o=junk.json
+
+for f in $testsrc/testuriLE64ELf.testme $testsrc/testobjLE32PE.exe \
+    $testsrc/dummyexecutable
+do
+  $dd --format-json $f > $o.out
+  chkres $? "running $dd --format-json $f"
+  python3 -c '
+import json,sys
+for n, l in enumerate(open(sys.argv[1]), 1):
+    r = json.loads(l)
+    if not isinstance(r, dict) or "type" not in r:
+        sys.exit("line %d is not a record" % n)
+' $o.out
+  chkres $? "--format-json output of $f is not JSON Lines"
+  a=`$dd -i $f | grep -cE '^ *< *[0-9]+><0x[0-9a-f]+>'`
+  b=`$dd --format-json -i $f | grep -c '"type":"die"'`
+  if [ "$a" != "$b" ]
+  then
+    echo "FAIL $f: $a DIEs in text, $b die records"
+    exit 1
+  fi
+done
+
+$dd --format-json --file-batch-jobs=2 -l $testsrc/dummyexecutable \
+    $testsrc/testuriLE64ELf.testme > $o.out
+chkres $? "running $dd --format-json --file-batch-jobs=2"
+n=`grep -c '^{"type":"file",' $o.out`
+if [ "$n" != "2" ]
+then
+  echo "FAIL --format-json batch run has $n file records"
+  exit 1
+fi
+tail -n 1 $o.out | grep '^{"type":"batch_summary",' > /dev/null
+chkres $? "--format-json batch run does not end in a summary"
+
+# Print options with no JSON form are errors, not dropped.
+for opt in -r -s -p -m -N --print-raw-loclists "-i -u x.c"
+do
+  $dd --format-json $opt $testsrc/testuriLE64ELf.testme > $o.out
+  if [ $? -eq 0 ]
+  then
+    echo "FAIL --format-json $opt must give failure status"
+    exit 1
+  fi
+  grep '^--format-json has no JSON form for ' $o.out > /dev/null
+  chkres $? "--format-json $opt does not name the option"
+  grep '"type":' $o.out > /dev/null
+  if [ $? -eq 0 ]
+  then
+    echo "FAIL --format-json $opt wrote records"
+    exit 1
+  fi
+done
+# The records come from the text walkers, so values have
+# the text interpretation: a location list is its entries,
+# not a bare offset, and frames have their register rules.
+f=$testsrc/testmulticuLE64ELf.testme
+$dd --format-json -i $f | \
+    grep '"DW_AT_location":"0x[0-9a-f]* *.debug_loclists' > /dev/null
+chkres $? "--format-json location lists of $f are not interpreted"
+$dd --format-json -F $f | grep '"type":"register",' > /dev/null
+chkres $? "--format-json -F of $f has no register records"
+
+$dd --format-json -a $testsrc/testuriLE64ELf.testme > $o.all
+chkres $? "running $dd --format-json -a"
+$dd --format-json $testsrc/testuriLE64ELf.testme > $o.out
+chkres $? "running $dd --format-json"
+cmp $o.all $o.out
+chkres $? "--format-json -a differs from the default sections"
+
+rm -f $o.*
+echo "PASS test_dwarfdumpjson.sh"
+exit 0
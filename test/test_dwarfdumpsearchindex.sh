@@ -0,0 +1,91 @@
+#!/bin/sh
+# Copyright (C) 2026 David Anderson
+# This script is hereby placed in the Public Domain
+# for anyone to use in any way for any purpose.
+#
+# Checks dwarfdump -S with --search-use-index on an object
+# whose name index is partial: testmulticuLE64ELf.testme
+# has .debug_pubnames and .debug_pubtypes for its first CU
+# only. The second CU is not indexed and must still be
+# searched, so the matches must be those of the full walk.
+# testcppnsLE64ELf.testme is the same layout from C++:
+# its index names are qualified (cpns::cp_scale) while
+# -S match= compares the unqualified DW_AT_name.
+#
+# Assumes we run the script in the test directory of the build.
+# Either pass in the top source dir as an argument
+# or set env var DWTOPSRCDIR to the source directory.
+
+chkres() {
+r=$1
+m=$2
+if [ $r -ne 0 ]
+then
+  echo "FAIL $m.  Exit status for the test $r"
+  exit 1
+fi
+}
+
+if [ $# -gt 0 ]
+then
+  top_srcdir="$1"
+else
+  top_srcdir=$DWTOPSRCDIR
+fi
+blddir=`pwd`
+bname=`basename $blddir`
+top_blddir="$blddir"
+if [ x$bname = "xtest" ]
+then
+  top_blddir="$blddir/.."
+fi
+dd=$top_blddir/src/bin/dwarfdump/dwarfdump
+testsrc=$top_srcdir/test
+conf="-x name=$top_srcdir/src/bin/dwarfdump/dwarfdump.conf"
+o=junk.searchindex
+f=$testsrc/testmulticuLE64ELf.testme
+
+rm -f $o.*
+# mc_step_b is declared in the indexed CU, which lists
+# it in .debug_pubnames, and defined in the other one.
+# mc_counter_a is only in the indexed CU.
+for s in match=mc_step_b match=mc_counter_a any=mc_
+do
+  $dd $conf -S $s $f > $o.full
+  chkres $? "running $dd -S $s"
+  $dd $conf -S $s --search-use-index $f > $o.index
+  chkres $? "running $dd -S $s --search-use-index"
+  grep -v "^Search strategy\|^Index names read\|^CUs " \
+    $o.index > $o.indexmatches
+  diff $o.full $o.indexmatches
+  chkres $? "-S $s index matches differ from the full walk"
+  grep "^CUs not indexed  : 1$" $o.index > /dev/null
+  chkres $? "-S $s the unindexed CU not reported"
+done
+
+# No indexed name matches: only the unindexed CU is walked.
+$dd $conf -S match=no_such_name --search-use-index $f > $o.index
+chkres $? "running $dd -S match=no_such_name --search-use-index"
+grep "^CUs searched     : 1 of 2$" $o.index > /dev/null
+chkres $? "the indexed CU with no match is not skipped"
+
+f=$testsrc/testcppnsLE64ELf.testme
+for s in match=cp_scale match=cp_twice match=cp_counter_a any=cp_
+do
+  $dd $conf -S $s $f > $o.full
+  chkres $? "running $dd -S $s on $f"
+  $dd $conf -S $s --search-use-index $f > $o.index
+  chkres $? "running $dd -S $s --search-use-index on $f"
+  grep -v "^Search strategy\|^Index names read\|^CUs " \
+    $o.index > $o.indexmatches
+  diff $o.full $o.indexmatches
+  chkres $? "-S $s index matches differ from the full walk of $f"
+done
+# cpns::cp_scale is indexed, so its CU must be searched.
+$dd $conf -S match=cp_scale --search-use-index $f > $o.index
+grep "^CUs searched     : 2 of 2$" $o.index > /dev/null
+chkres $? "the CU indexing cpns::cp_scale is skipped"
+
+rm -f $o.*
+echo "PASS test_dwarfdumpsearchindex.sh"
+exit 0
@@ -0,0 +1,78 @@
+#!/bin/sh
+# Copyright (C) 2026 David Anderson
+# This script is hereby placed in the Public Domain
+# for anyone to use in any way for any purpose.
+#
+# Checks dwarfdump --print-size-stats: the .debug_info
+# bytes by DIE tag (with unit headers and null entries)
+# and by attribute form (with abbreviation codes,
+# unit headers and null entries) must each add up
+# to the size of .debug_info.
+#
+# Assumes we run the script in the test directory of the build.
+# Either pass in the top source dir as an argument
+# or set env var DWTOPSRCDIR to the source directory.
+
+chkres() {
+r=$1
+m=$2
+if [ $r -ne 0 ]
+then
+  echo "FAIL $m.  Exit status for the test $r"
+  exit 1
+fi
+}
+
+if [ $# -gt 0 ]
+then
+  top_srcdir="$1"
+else
+  top_srcdir=$DWTOPSRCDIR
+fi
+blddir=`pwd`
+bname=`basename $blddir`
+top_blddir="$blddir"
+if [ x$bname = "xtest" ]
+then
+  top_blddir="$blddir/.."
+fi
+dd=$top_blddir/src/bin/dwarfdump/dwarfdump
+testsrc=$top_srcdir/test
+o=junk.sizestats
+
+for f in $testsrc/testuriLE64ELf.testme $testsrc/testobjLE32PE.exe \
+    $testsrc/dummyexecutable $testsrc/test-mach-o-32.dSYM
+do
+  $dd --print-size-stats $f > $o.out
+  chkres $? "running $dd --print-size-stats $f"
+  awk '
+/^  \.debug_info / { info = $2 }
+/^\.debug_info bytes by DIE tag/  { part = "tag"; next }
+/^\.debug_info bytes by attribute form/ { part = "form"; next }
+/^$/ { part = "" }
+part != "" && $1 ~ /^[0-9]+$/ {
+    sum[part] += $1
+    if ($NF == "headers)" || $NF == "entries)") {
+        extra += $1
+    }
+}
+END {
+    if (info == "" || info == 0) {
+        print "no .debug_info size"
+        exit 1
+    }
+    if (sum["tag"] != info) {
+        print "tags add up to " sum["tag"] " not " info
+        exit 1
+    }
+    if (sum["form"] + extra != info) {
+        print "forms add up to " sum["form"] + extra " not " info
+        exit 1
+    }
+}' $o.out
+  chkres $? "--print-size-stats totals of $f"
+done
+
+rm -f $o.*
+echo "PASS test_dwarfdumpsizestats.sh"
+exit 0
@@ -0,0 +1,68 @@
+#!/bin/sh
+# Copyright (C) 2026 David Anderson
+# This script is hereby placed in the Public Domain
+# for anyone to use in any way for any purpose.
+#
+# Checks dwarfgen --parallel-generation: the object
+# written when the producer generates .debug_line,
+# .debug_frame and .debug_info on separate threads
+# must be byte-identical to the one from a serial
+# generation, streamed or not.
+#
+# Assumes we run the script in the test directory of the build.
+# Either pass in the top source dir as an argument
+# or set env var DWTOPSRCDIR to the source directory.
+
+chkres() {
+r=$1
+m=$2
+if [ $r -ne 0 ]
+then
+  echo "FAIL $m.  Exit status for the test $r"
+  exit 1
+fi
+}
+
+if [ $# -gt 0 ]
+then
+  top_srcdir="$1"
+else
+  top_srcdir=$DWTOPSRCDIR
+fi
+blddir=`pwd`
+bname=`basename $blddir`
+top_blddir="$blddir"
+if [ x$bname = "xtest" ]
+then
+  top_blddir="$blddir/.."
+fi
+dg=$top_blddir/src/bin/dwarfgen/dwarfgen
+testsrc=$top_srcdir/test
+o=junk.dgparallel
+
+rm -f $o.*
+for f in $testsrc/testmulticuLE64ELf.testme \
+    $testsrc/testuriLE64ELf.testme
+do
+  for c in 0 1 2
+  do
+    for opt in "" --default-form-strp --add-frame-advance-loc
+    do
+      $dg -t obj -c $c $opt -o $o.serial $f > $o.out 2>&1
+      chkres $? "running $dg -c $c $opt $f"
+      $dg -t obj -c $c $opt --parallel-generation \
+        -o $o.parallel $f > $o.out 2>&1
+      chkres $? "running $dg -c $c $opt --parallel-generation $f"
+      cmp $o.serial $o.parallel
+      chkres $? "parallel output differs from serial, -c $c $opt $f"
+      $dg -t obj -c $c $opt --parallel-generation --stream-output \
+        -o $o.parallel $f > $o.out 2>&1
+      chkres $? "running $dg -c $c $opt --parallel-generation --stream-output $f"
+      cmp $o.serial $o.parallel
+      chkres $? "parallel streamed output differs from serial, -c $c $opt $f"
+    done
+  done
+done
+rm -f $o.*
+echo "PASS test_dwarfgenparallel.sh"
+exit 0
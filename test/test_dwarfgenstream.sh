@@ -0,0 +1,58 @@
+#!/bin/sh
+# Copyright (C) 2026 David Anderson
+# This script is hereby placed in the Public Domain
+# for anyone to use in any way for any purpose.
+#
+# Checks dwarfgen --stream-output: the object written
+# when the producer streams each section through
+# the sink must be byte-identical to the one written
+# from the buffered sections.
+#
+# Assumes we run the script in the test directory of the build.
+# Either pass in the top source dir as an argument
+# or set env var DWTOPSRCDIR to the source directory.
+
+chkres() {
+r=$1
+m=$2
+if [ $r -ne 0 ]
+then
+  echo "FAIL $m.  Exit status for the test $r"
+  exit 1
+fi
+}
+
+if [ $# -gt 0 ]
+then
+  top_srcdir="$1"
+else
+  top_srcdir=$DWTOPSRCDIR
+fi
+blddir=`pwd`
+bname=`basename $blddir`
+top_blddir="$blddir"
+if [ x$bname = "xtest" ]
+then
+  top_blddir="$blddir/.."
+fi
+dg=$top_blddir/src/bin/dwarfgen/dwarfgen
+testsrc=$top_srcdir/test
+o=junk.dgstream
+
+rm -f $o.*
+for f in $testsrc/testmulticuLE64ELf.testme \
+    $testsrc/testuriLE64ELf.testme
+do
+  for c in 0 1 2
+  do
+    $dg -t obj -c $c -o $o.buffered $f > $o.out 2>&1
+    chkres $? "running $dg -c $c $f"
+    $dg -t obj -c $c --stream-output -o $o.streamed $f > $o.out 2>&1
+    chkres $? "running $dg -c $c --stream-output $f"
+    cmp $o.buffered $o.streamed
+    chkres $? "streamed output differs from buffered, -c $c $f"
+  done
+done
+rm -f $o.*
+echo "PASS test_dwarfgenstream.sh"
+exit 0
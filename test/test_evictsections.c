@@ -0,0 +1,315 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  Tests dwarf_evict_sections(): line tables and
+    globals read before an eviction must still
+    be usable after it, and the bytes reported
+    released must be what the resident total dropped by.
+
+    ./test_evictsections -f <top of the source tree>
+    or with DWTOPSRCDIR set in the environment. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() getenv() */
+#include <string.h> /* strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+
+#define OBJNAME "/test/testmulticuLE64ELf.testme"
+#define MAX_NAMES 50
+#define NAME_LEN 100
+
+static int errcount;
+static char pathbuf[2000];
+
+/*  Copies of the strings seen before eviction. */
+static char filenames[MAX_NAMES][NAME_LEN];
+static int  filename_count;
+static char globnames[MAX_NAMES][NAME_LEN];
+static int  globname_count;
+
+static void
+check(const char *msg,int ok,int line)
+{
+    if (ok) {
+        return;
+    }
+    printf("FAIL %s test line %d\n",msg,line);
+    ++errcount;
+}
+
+static void
+copy_name(char *out,const char *in)
+{
+    size_t len = strlen(in);
+
+    if (len >= NAME_LEN) {
+        len = NAME_LEN-1;
+    }
+    memcpy(out,in,len);
+    out[len] = 0;
+}
+
+static void
+setup_path(int argc,char **argv)
+{
+    const char *top = 0;
+    size_t len = 0;
+
+    if (argc > 2 && !strcmp(argv[1],"-f")) {
+        top = argv[2];
+    } else {
+        top = getenv("DWTOPSRCDIR");
+    }
+    if (!top) {
+        printf("FAIL test_evictsections: use -f <source base> "
+            "or set DWTOPSRCDIR\n");
+        exit(EXIT_FAILURE);
+    }
+    len = strlen(top);
+    if (len + sizeof(OBJNAME) >= sizeof(pathbuf)) {
+        printf("FAIL test_evictsections: path too long\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(pathbuf,top,len);
+    memcpy(pathbuf+len,OBJNAME,sizeof(OBJNAME));
+}
+
+/*  Walks the line table file names of every CU.
+    With record set the names are saved, otherwise
+    they are compared with the saved ones. */
+static void
+walk_line_files(Dwarf_Line_Context *contexts,int ccount,
+    int record)
+{
+    int n = 0;
+    int c = 0;
+
+    for (c = 0; c < ccount; ++c) {
+        Dwarf_Signed base = 0;
+        Dwarf_Signed count = 0;
+        Dwarf_Signed end = 0;
+        Dwarf_Signed i = 0;
+        Dwarf_Error err = 0;
+        int res = 0;
+
+        res = dwarf_srclines_files_indexes(contexts[c],&base,
+            &count,&end,&err);
+        check("dwarf_srclines_files_indexes",res == DW_DLV_OK,
+            __LINE__);
+        if (res != DW_DLV_OK) {
+            return;
+        }
+        for (i = base; i < end; ++i) {
+            const char *name = 0;
+            Dwarf_Unsigned dirindex = 0;
+
+            res = dwarf_srclines_files_data_b(contexts[c],i,
+                &name,&dirindex,0,0,0,&err);
+            check("dwarf_srclines_files_data_b",res == DW_DLV_OK,
+                __LINE__);
+            if (res != DW_DLV_OK || n >= MAX_NAMES) {
+                return;
+            }
+            if (record) {
+                copy_name(filenames[n],name);
+            } else {
+                check("line table file name unchanged",
+                    !strncmp(filenames[n],name,NAME_LEN-1),
+                    __LINE__);
+            }
+            ++n;
+        }
+    }
+    if (record) {
+        filename_count = n;
+    } else {
+        check("line table file count",n == filename_count,
+            __LINE__);
+    }
+}
+
+static void
+walk_globals(Dwarf_Global *globs,Dwarf_Signed count,int record)
+{
+    Dwarf_Signed i = 0;
+
+    for (i = 0; i < count && i < MAX_NAMES; ++i) {
+        char *name = 0;
+        Dwarf_Error err = 0;
+        int res = 0;
+
+        res = dwarf_globname(globs[i],&name,&err);
+        check("dwarf_globname",res == DW_DLV_OK,__LINE__);
+        if (res != DW_DLV_OK) {
+            return;
+        }
+        if (record) {
+            copy_name(globnames[i],name);
+        } else {
+            check("global name unchanged",
+                !strncmp(globnames[i],name,NAME_LEN-1),__LINE__);
+        }
+    }
+    if (record) {
+        globname_count = (int)i;
+    } else {
+        check("global count",(int)i == globname_count,__LINE__);
+    }
+}
+
+static Dwarf_Unsigned
+resident(Dwarf_Debug dbg,const char *secname)
+{
+    Dwarf_Unsigned bytes = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    res = dwarf_get_section_resident_bytes(dbg,secname,
+        &bytes,&err);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,err);
+    }
+    return bytes;
+}
+
+int
+main(int argc,char **argv)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    Dwarf_Line_Context contexts[10];
+    int ccount = 0;
+    Dwarf_Global *globs = 0;
+    Dwarf_Signed globcount = 0;
+    Dwarf_Arange *aranges = 0;
+    Dwarf_Signed arangecount = 0;
+    Dwarf_Unsigned before = 0;
+    Dwarf_Unsigned released = 0;
+    Dwarf_Unsigned arangesize = 0;
+    Dwarf_Signed i = 0;
+    int res = 0;
+
+    setup_path(argc,argv);
+    res = dwarf_init_path(pathbuf,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        printf("FAIL test_evictsections: cannot open %s\n",
+            pathbuf);
+        exit(EXIT_FAILURE);
+    }
+    res = dwarf_set_section_memory_budget(dbg,1,0,&err);
+    check("set budget",res == DW_DLV_OK,__LINE__);
+
+    /*  Everything below points into .debug_str or
+        .debug_line_str. */
+    for (;;) {
+        Dwarf_Die cudie = 0;
+        Dwarf_Unsigned version = 0;
+        Dwarf_Small tcount = 0;
+
+        res = dwarf_next_cu_header_e(dbg,TRUE,&cudie,
+            0,0,0,0,0,0,0,0,0,0,&err);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        if (ccount < 10) {
+            res = dwarf_srclines_b(cudie,&version,&tcount,
+                &contexts[ccount],&err);
+            check("dwarf_srclines_b",res == DW_DLV_OK,__LINE__);
+            if (res == DW_DLV_OK) {
+                ++ccount;
+            }
+        }
+        dwarf_dealloc_die(cudie);
+    }
+    check("two CUs with line tables",ccount == 2,__LINE__);
+    walk_line_files(contexts,ccount,TRUE);
+    res = dwarf_get_globals(dbg,&globs,&globcount,&err);
+    check("dwarf_get_globals",res == DW_DLV_OK,__LINE__);
+    check("globals present",globcount > 0,__LINE__);
+    walk_globals(globs,globcount,TRUE);
+    res = dwarf_get_aranges(dbg,&aranges,&arangecount,&err);
+    check("dwarf_get_aranges",res == DW_DLV_OK,__LINE__);
+    for (i = 0; i < arangecount; ++i) {
+        dwarf_dealloc(dbg,aranges[i],DW_DLA_ARANGE);
+    }
+    dwarf_dealloc(dbg,aranges,DW_DLA_LIST);
+    arangesize = resident(dbg,".debug_aranges");
+    check(".debug_aranges loaded",arangesize > 0,__LINE__);
+
+    before = resident(dbg,0);
+    res = dwarf_evict_sections(dbg,&released,&err);
+    check("dwarf_evict_sections",res == DW_DLV_OK,__LINE__);
+    check("released is what the resident total lost",
+        released == before - resident(dbg,0),__LINE__);
+    check("released .debug_aranges",released == arangesize,
+        __LINE__);
+    check(".debug_aranges evicted",
+        resident(dbg,".debug_aranges") == 0,__LINE__);
+    check(".debug_str kept",resident(dbg,".debug_str") > 0,
+        __LINE__);
+    check(".debug_line_str kept",
+        resident(dbg,".debug_line_str") > 0,__LINE__);
+
+    /*  The line contexts and globals from before. */
+    walk_line_files(contexts,ccount,FALSE);
+    walk_globals(globs,globcount,FALSE);
+
+    /*  An evicted section reloads on use. */
+    res = dwarf_get_aranges(dbg,&aranges,&arangecount,&err);
+    check("dwarf_get_aranges after eviction",res == DW_DLV_OK,
+        __LINE__);
+    if (res == DW_DLV_OK) {
+        for (i = 0; i < arangecount; ++i) {
+            dwarf_dealloc(dbg,aranges[i],DW_DLA_ARANGE);
+        }
+        dwarf_dealloc(dbg,aranges,DW_DLA_LIST);
+    }
+    check(".debug_aranges reloaded",
+        resident(dbg,".debug_aranges") == arangesize,__LINE__);
+
+    dwarf_globals_dealloc(dbg,globs,globcount);
+    for (i = 0; i < ccount; ++i) {
+        dwarf_srclines_dealloc_b(contexts[i]);
+    }
+    dwarf_finish(dbg);
+    if (errcount) {
+        printf("FAIL test_evictsections\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_evictsections\n");
+    return 0;
+}
@@ -0,0 +1,704 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  Tests dwarf_expr_evaluate() on expressions built
+    here: the stack operators, branches, pieces,
+    callback failures and malformed expressions.
+    Each expression is the DW_AT_location of a DIE
+    in a .debug_info built in memory and read through
+    dwarf_object_init_b(), as in
+    src/bin/dwarfexample/jitreader.c.
+
+    ./test_expreval */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() */
+#include <string.h> /* memcmp() memcpy() memset() strcmp() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+
+#define REG_VALUE   0x1000 /* register n holds REG_VALUE+n */
+#define FRAME_BASE  0x2000
+#define CFA         0x3000
+#define MEM_DELTA   0x55   /* memory at a holds a+MEM_DELTA */
+
+/*  What the callbacks return. */
+#define CB_OK       0
+#define CB_NO_ENTRY 1
+#define CB_ERROR    2
+
+#define MAX_BYTES  80
+#define MAX_PIECES 4
+
+/*  c_res values other than DW_DLV_*. */
+#define DECODE_ERROR 90 /* dwarf_get_loclist_c() fails */
+#define SPECIAL      91 /* checked in run_special() */
+
+static int errcount;
+static int cbmode;
+
+struct piece_s {
+    Dwarf_Small    p_kind;
+    Dwarf_Unsigned p_value;
+    Dwarf_Unsigned p_size_bits;
+    Dwarf_Unsigned p_offset_bits;
+};
+
+struct eval_case_s {
+    const char     *c_name;
+    Dwarf_Small     c_bytes[MAX_BYTES];
+    unsigned        c_len;
+    Dwarf_Half      c_address_size;
+    int             c_cbmode;
+    /*  Expected return, and for DW_DLV_OK
+        the expected pieces. */
+    int             c_res;
+    unsigned        c_piece_count;
+    struct piece_s  c_pieces[MAX_PIECES];
+};
+
+static struct eval_case_s cases[] = {
+/*  Stack operators. */
+{"minus",{DW_OP_lit5,DW_OP_lit3,DW_OP_minus,DW_OP_stack_value},
+    4,8,CB_OK,DW_DLV_OK,1,{{DW_EXPR_LOC_VALUE,2,0,0}}},
+{"rot",{DW_OP_lit1,DW_OP_lit2,DW_OP_lit3,DW_OP_rot,
+    DW_OP_minus,DW_OP_plus,DW_OP_stack_value},
+    7,8,CB_OK,DW_DLV_OK,1,{{DW_EXPR_LOC_VALUE,2,0,0}}},
+{"swap neg",{DW_OP_lit10,DW_OP_lit3,DW_OP_swap,DW_OP_minus,
+    DW_OP_neg,DW_OP_stack_value},
+    6,8,CB_OK,DW_DLV_OK,1,{{DW_EXPR_LOC_VALUE,7,0,0}}},
+{"over mul",{DW_OP_lit4,DW_OP_lit5,DW_OP_over,DW_OP_plus,
+    DW_OP_mul,DW_OP_stack_value},
+    6,8,CB_OK,DW_DLV_OK,1,{{DW_EXPR_LOC_VALUE,36,0,0}}},
+{"pick drop",{DW_OP_lit1,DW_OP_lit2,DW_OP_lit3,DW_OP_pick,2,
+    DW_OP_drop,DW_OP_dup,DW_OP_mul,DW_OP_stack_value},
+    9,8,CB_OK,DW_DLV_OK,1,{{DW_EXPR_LOC_VALUE,9,0,0}}},
+{"abs",{DW_OP_const1s,0xf8,DW_OP_abs,DW_OP_lit2,DW_OP_mul,
+    DW_OP_stack_value},
+    6,8,CB_OK,DW_DLV_OK,1,{{DW_EXPR_LOC_VALUE,16,0,0}}},
+{"signed compare",{DW_OP_const1s,0xff,DW_OP_lit1,DW_OP_lt,
+    DW_OP_stack_value},
+    5,8,CB_OK,DW_DLV_OK,1,{{DW_EXPR_LOC_VALUE,1,0,0}}},
+{"shra",{DW_OP_const1s,0xf0,DW_OP_lit2,DW_OP_shra,
+    DW_OP_stack_value},
+    5,8,CB_OK,DW_DLV_OK,1,
+    {{DW_EXPR_LOC_VALUE,(Dwarf_Unsigned)-4,0,0}}},
+{"32 bit wraps",{DW_OP_lit0,DW_OP_lit1,DW_OP_minus,
+    DW_OP_stack_value},
+    4,4,CB_OK,DW_DLV_OK,1,{{DW_EXPR_LOC_VALUE,0xffffffff,0,0}}},
+{"constant value",{DW_OP_const2u,0x34,0x12,DW_OP_stack_value},
+    4,8,CB_OK,DW_DLV_OK,1,{{DW_EXPR_LOC_VALUE,0x1234,0,0}}},
+/*  Branches. bra at 1 goes to 1+3+4 = 8, skip at 5
+    to 5+3+1 = 9. */
+{"bra taken",{DW_OP_lit1,DW_OP_bra,4,0,DW_OP_lit9,
+    DW_OP_skip,1,0,DW_OP_lit8,DW_OP_stack_value},
+    10,8,CB_OK,DW_DLV_OK,1,{{DW_EXPR_LOC_VALUE,8,0,0}}},
+{"bra not taken",{DW_OP_lit0,DW_OP_bra,4,0,DW_OP_lit9,
+    DW_OP_skip,1,0,DW_OP_lit8,DW_OP_stack_value},
+    10,8,CB_OK,DW_DLV_OK,1,{{DW_EXPR_LOC_VALUE,9,0,0}}},
+/*  Counts 3 down to 0, branching back from 4 to 1. */
+{"loop",{DW_OP_lit3,DW_OP_lit1,DW_OP_minus,DW_OP_dup,
+    DW_OP_bra,0xfa,0xff,DW_OP_stack_value},
+    8,8,CB_OK,DW_DLV_OK,1,{{DW_EXPR_LOC_VALUE,0,0,0}}},
+/*  Machine state through the callbacks. */
+{"reg",{DW_OP_reg3},
+    1,8,CB_OK,DW_DLV_OK,1,{{DW_EXPR_LOC_REGISTER,3,0,0}}},
+{"regx",{DW_OP_regx,0x21},
+    2,8,CB_OK,DW_DLV_OK,1,{{DW_EXPR_LOC_REGISTER,33,0,0}}},
+{"breg",{DW_OP_breg6,0x10},
+    2,8,CB_OK,DW_DLV_OK,1,{{DW_EXPR_LOC_MEMORY,REG_VALUE+6+16,0,0}}},
+{"fbreg",{DW_OP_fbreg,0x78},
+    2,8,CB_OK,DW_DLV_OK,1,{{DW_EXPR_LOC_MEMORY,FRAME_BASE-8,0,0}}},
+{"cfa",{DW_OP_call_frame_cfa},
+    1,8,CB_OK,DW_DLV_OK,1,{{DW_EXPR_LOC_MEMORY,CFA,0,0}}},
+{"addr",{DW_OP_addr,0x78,0x56,0x34,0x12,0,0,0,0},
+    9,8,CB_OK,DW_DLV_OK,1,{{DW_EXPR_LOC_MEMORY,0x12345678,0,0}}},
+{"deref",{DW_OP_breg7,0,DW_OP_deref,DW_OP_lit4,DW_OP_plus},
+    5,8,CB_OK,DW_DLV_OK,1,
+    {{DW_EXPR_LOC_MEMORY,REG_VALUE+7+MEM_DELTA+4,0,0}}},
+{"deref_size",{DW_OP_fbreg,0,DW_OP_deref_size,1},
+    4,8,CB_OK,DW_DLV_OK,1,
+    {{DW_EXPR_LOC_MEMORY,(FRAME_BASE+MEM_DELTA)&0xff,0,0}}},
+/*  Pieces. */
+{"register pieces",{DW_OP_reg0,DW_OP_piece,4,DW_OP_reg3,
+    DW_OP_piece,4},
+    6,8,CB_OK,DW_DLV_OK,2,
+    {{DW_EXPR_LOC_REGISTER,0,32,0},
+    {DW_EXPR_LOC_REGISTER,3,32,0}}},
+{"empty piece",{DW_OP_piece,4,DW_OP_fbreg,0x10,DW_OP_piece,2},
+    6,8,CB_OK,DW_DLV_OK,2,
+    {{DW_EXPR_LOC_EMPTY,0,32,0},
+    {DW_EXPR_LOC_MEMORY,FRAME_BASE+16,16,0}}},
+{"bit piece",{DW_OP_reg1,DW_OP_bit_piece,3,5},
+    4,8,CB_OK,DW_DLV_OK,1,{{DW_EXPR_LOC_REGISTER,1,3,5}}},
+{"mixed pieces",{DW_OP_lit5,DW_OP_stack_value,DW_OP_piece,4,
+    DW_OP_breg2,4,DW_OP_piece,2,DW_OP_regx,9,DW_OP_piece,1},
+    12,8,CB_OK,DW_DLV_OK,3,
+    {{DW_EXPR_LOC_VALUE,5,32,0},
+    {DW_EXPR_LOC_MEMORY,REG_VALUE+2+4,16,0},
+    {DW_EXPR_LOC_REGISTER,9,8,0}}},
+/*  Callbacks that cannot or do not give a value. */
+{"register not available",{DW_OP_breg6,0},
+    2,8,CB_NO_ENTRY,DW_DLV_NO_ENTRY,0,{{0,0,0,0}}},
+{"register callback fails",{DW_OP_breg6,0},
+    2,8,CB_ERROR,DW_DLV_ERROR,0,{{0,0,0,0}}},
+{"frame base callback fails",{DW_OP_fbreg,0,DW_OP_lit1,
+    DW_OP_plus},
+    4,8,CB_ERROR,DW_DLV_ERROR,0,{{0,0,0,0}}},
+{"memory callback fails",{DW_OP_lit8,DW_OP_deref},
+    2,8,CB_ERROR,DW_DLV_ERROR,0,{{0,0,0,0}}},
+{"cfa piece callback fails",{DW_OP_call_frame_cfa,DW_OP_piece,8},
+    3,8,CB_ERROR,DW_DLV_ERROR,0,{{0,0,0,0}}},
+/*  Malformed expressions. */
+{"underflow",{DW_OP_lit1,DW_OP_plus},
+    2,8,CB_OK,DW_DLV_ERROR,0,{{0,0,0,0}}},
+{"stack_value on empty stack",{DW_OP_nop,DW_OP_stack_value},
+    2,8,CB_OK,DW_DLV_ERROR,0,{{0,0,0,0}}},
+{"empty at the end",{DW_OP_lit1,DW_OP_drop},
+    2,8,CB_OK,DW_DLV_ERROR,0,{{0,0,0,0}}},
+{"division by zero",{DW_OP_lit1,DW_OP_lit0,DW_OP_div},
+    3,8,CB_OK,DW_DLV_ERROR,0,{{0,0,0,0}}},
+{"mod by zero",{DW_OP_lit1,DW_OP_lit0,DW_OP_mod},
+    3,8,CB_OK,DW_DLV_ERROR,0,{{0,0,0,0}}},
+{"operator after stack_value",{DW_OP_lit1,DW_OP_stack_value,
+    DW_OP_lit2},
+    3,8,CB_OK,DW_DLV_ERROR,0,{{0,0,0,0}}},
+{"operator after a register",{DW_OP_reg1,DW_OP_lit2},
+    2,8,CB_OK,DW_DLV_ERROR,0,{{0,0,0,0}}},
+{"operator after the last piece",{DW_OP_reg1,DW_OP_piece,4,
+    DW_OP_lit2},
+    4,8,CB_OK,DW_DLV_ERROR,0,{{0,0,0,0}}},
+/*  bra at 1 to 1+3+1 = 5, inside the const1u at 4. */
+{"branch into an operator",{DW_OP_lit1,DW_OP_bra,1,0,
+    DW_OP_const1u,7,DW_OP_stack_value},
+    7,8,CB_OK,DW_DLV_ERROR,0,{{0,0,0,0}}},
+/*  skip at 0 to 0+3-3 = 0, forever. */
+{"endless loop",{DW_OP_skip,0xfd,0xff},
+    3,8,CB_OK,DW_DLV_ERROR,0,{{0,0,0,0}}},
+{"deref size 9",{DW_OP_lit8,DW_OP_deref_size,9},
+    3,8,CB_OK,DW_DLV_ERROR,0,{{0,0,0,0}}},
+{"unsupported operator",{DW_OP_call2,0,0},
+    3,8,CB_OK,DW_DLV_ERROR,0,{{0,0,0,0}}},
+{"too many pieces",{DW_OP_reg0,DW_OP_piece,1,DW_OP_reg1,
+    DW_OP_piece,1,DW_OP_reg2,DW_OP_piece,1,DW_OP_reg3,
+    DW_OP_piece,1,DW_OP_reg4,DW_OP_piece,1},
+    15,8,CB_OK,DW_DLV_ERROR,0,{{0,0,0,0}}},
+/*  65 pushes, one more than the stack holds. */
+{"stack overflow",{
+    DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,
+    DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,
+    DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,
+    DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,
+    DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,
+    DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,
+    DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,
+    DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,
+    DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,
+    DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,
+    DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,
+    DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,
+    DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0,DW_OP_lit0},
+    65,8,CB_OK,DW_DLV_ERROR,0,{{0,0,0,0}}},
+{"truncated operand",{DW_OP_const4u,1,2},
+    3,8,CB_OK,DECODE_ERROR,0,{{0,0,0,0}}},
+{"bad leb",{DW_OP_lit1,DW_OP_constu,0x80},
+    3,8,CB_OK,DECODE_ERROR,0,{{0,0,0,0}}},
+{"implicit_value",{DW_OP_implicit_value,3,0x11,0x22,0x33,
+    DW_OP_piece,3,DW_OP_reg5,DW_OP_piece,1},
+    10,8,CB_OK,SPECIAL,0,{{0,0,0,0}}},
+{"missing callback",{DW_OP_fbreg,0},
+    2,8,CB_OK,SPECIAL,0,{{0,0,0,0}}}
+};
+#define CASE_COUNT (sizeof(cases)/sizeof(cases[0]))
+
+/*  The DIE offset of each case, set by build_sections(). */
+static Dwarf_Off dieoffs[CASE_COUNT];
+
+static int
+cb_result(void)
+{
+    switch (cbmode) {
+    case CB_NO_ENTRY:
+        return DW_DLV_NO_ENTRY;
+    case CB_ERROR:
+        return DW_DLV_ERROR;
+    default:
+        break;
+    }
+    return DW_DLV_OK;
+}
+
+static int
+cb_read_register(void *user_data,Dwarf_Unsigned regnum,
+    Dwarf_Unsigned *value)
+{
+    (void)user_data;
+    *value = REG_VALUE + regnum;
+    return cb_result();
+}
+
+static int
+cb_read_memory(void *user_data,Dwarf_Addr addr,
+    Dwarf_Unsigned size,Dwarf_Unsigned *value)
+{
+    (void)user_data;
+    (void)size;
+    *value = addr + MEM_DELTA;
+    return cb_result();
+}
+
+static int
+cb_frame_base(void *user_data,Dwarf_Addr *value)
+{
+    (void)user_data;
+    *value = FRAME_BASE;
+    return cb_result();
+}
+
+static int
+cb_call_frame_cfa(void *user_data,Dwarf_Addr *value)
+{
+    (void)user_data;
+    *value = CFA;
+    return cb_result();
+}
+
+static void
+check(const char *name,const char *msg,int ok,int line)
+{
+    if (ok) {
+        return;
+    }
+    printf("FAIL %s: %s test line %d\n",name,msg,line);
+    ++errcount;
+}
+
+/*  The in-memory object: one CU per address size,
+    a DW_TAG_variable with an exprloc DW_AT_location
+    for each case. */
+static Dwarf_Small abbrevbytes[] = {
+    1, DW_TAG_compile_unit, DW_CHILDREN_yes, 0, 0,
+    2, DW_TAG_variable, DW_CHILDREN_no,
+    DW_AT_location, DW_FORM_exprloc, 0, 0,
+    0 };
+static Dwarf_Small infobytes[CASE_COUNT*(MAX_BYTES+3) + 64];
+
+#define SECCOUNT 3
+struct sectiondata_s {
+    Dwarf_Unsigned sd_size;
+    const char    *sd_name;
+    Dwarf_Small   *sd_content;
+};
+static struct sectiondata_s sectiondata[SECCOUNT] = {
+{0,"",0},
+{sizeof(abbrevbytes),".debug_abbrev",abbrevbytes},
+{0,".debug_info",infobytes}
+};
+
+static Dwarf_Unsigned
+put_bytes(Dwarf_Unsigned off,const Dwarf_Small *bytes,
+    unsigned len)
+{
+    memcpy(infobytes+off,bytes,len);
+    return off + len;
+}
+
+static Dwarf_Unsigned
+build_cu(Dwarf_Unsigned off,Dwarf_Half address_size)
+{
+    /*  DWARF5 32bit little-endian header,
+        unit_length filled in at the end. */
+    Dwarf_Small header[] = {0,0,0,0, 5,0, DW_UT_compile, 0,
+        0,0,0,0};
+    Dwarf_Unsigned start = off;
+    Dwarf_Unsigned length = 0;
+    Dwarf_Small one = 0;
+    unsigned i = 0;
+
+    header[7] = (Dwarf_Small)address_size;
+    off = put_bytes(off,header,sizeof(header));
+    one = 1;
+    off = put_bytes(off,&one,1);
+    for (i = 0; i < CASE_COUNT; ++i) {
+        struct eval_case_s *c = cases+i;
+        Dwarf_Small die[2];
+
+        if (c->c_address_size != address_size) {
+            continue;
+        }
+        dieoffs[i] = off;
+        /*  Every length is under 128, one byte of leb. */
+        die[0] = 2;
+        die[1] = (Dwarf_Small)c->c_len;
+        off = put_bytes(off,die,2);
+        off = put_bytes(off,c->c_bytes,c->c_len);
+    }
+    one = 0;
+    off = put_bytes(off,&one,1);
+    length = off - start - 4;
+    infobytes[start]   = (Dwarf_Small)(length & 0xff);
+    infobytes[start+1] = (Dwarf_Small)((length >> 8) & 0xff);
+    return off;
+}
+
+static void
+build_sections(void)
+{
+    Dwarf_Unsigned off = 0;
+
+    off = build_cu(off,8);
+    off = build_cu(off,4);
+    sectiondata[2].sd_size = off;
+}
+
+static int
+obj_section_info(void *obj,Dwarf_Unsigned index,
+    Dwarf_Obj_Access_Section_a *sec,int *error)
+{
+    (void)obj;
+    *error = 0;
+    if (index >= SECCOUNT) {
+        return DW_DLV_NO_ENTRY;
+    }
+    memset(sec,0,sizeof(*sec));
+    sec->as_name = sectiondata[index].sd_name;
+    sec->as_size = sectiondata[index].sd_size;
+    sec->as_entrysize = 1;
+    return DW_DLV_OK;
+}
+
+static Dwarf_Small
+obj_byte_order(void *obj)
+{
+    (void)obj;
+    return DW_END_little;
+}
+
+static Dwarf_Small
+obj_length_size(void *obj)
+{
+    (void)obj;
+    return 4;
+}
+
+static Dwarf_Small
+obj_pointer_size(void *obj)
+{
+    (void)obj;
+    return 8;
+}
+
+static Dwarf_Unsigned
+obj_file_size(void *obj)
+{
+    (void)obj;
+    return sizeof(abbrevbytes) + sectiondata[2].sd_size;
+}
+
+static Dwarf_Unsigned
+obj_section_count(void *obj)
+{
+    (void)obj;
+    return SECCOUNT;
+}
+
+static int
+obj_load_section(void *obj,Dwarf_Unsigned index,
+    Dwarf_Small **data,int *error)
+{
+    (void)obj;
+    *error = 0;
+    if (index >= SECCOUNT) {
+        return DW_DLV_NO_ENTRY;
+    }
+    *data = sectiondata[index].sd_content;
+    return DW_DLV_OK;
+}
+
+static const Dwarf_Obj_Access_Methods_a obj_methods = {
+    obj_section_info,
+    obj_byte_order,
+    obj_length_size,
+    obj_pointer_size,
+    obj_file_size,
+    obj_section_count,
+    obj_load_section,
+    0 /* no relocations */
+};
+static struct Dwarf_Obj_Access_Interface_a_s obj_interface =
+    { 0,&obj_methods };
+
+/*  Returns the Dwarf_Loc_Head_c for the
+    DW_AT_location of case c and its single
+    Dwarf_Locdesc_c. */
+static int
+make_locdesc(Dwarf_Debug dbg,struct eval_case_s *c,
+    Dwarf_Loc_Head_c *head_out,Dwarf_Locdesc_c *desc_out)
+{
+    Dwarf_Die die = 0;
+    Dwarf_Attribute attr = 0;
+    Dwarf_Loc_Head_c head = 0;
+    Dwarf_Unsigned listlen = 0;
+    Dwarf_Small lle = 0;
+    Dwarf_Unsigned rawlo = 0;
+    Dwarf_Unsigned rawhi = 0;
+    Dwarf_Bool noaddr = FALSE;
+    Dwarf_Addr lo = 0;
+    Dwarf_Addr hi = 0;
+    Dwarf_Unsigned opcount = 0;
+    Dwarf_Small source = 0;
+    Dwarf_Unsigned exproff = 0;
+    Dwarf_Unsigned descoff = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    res = dwarf_offdie_b(dbg,dieoffs[c - cases],TRUE,&die,&err);
+    check(c->c_name,"dwarf_offdie_b",res == DW_DLV_OK,__LINE__);
+    if (res != DW_DLV_OK) {
+        return FALSE;
+    }
+    res = dwarf_attr(die,DW_AT_location,&attr,&err);
+    check(c->c_name,"dwarf_attr",res == DW_DLV_OK,__LINE__);
+    if (res != DW_DLV_OK) {
+        dwarf_dealloc_die(die);
+        return FALSE;
+    }
+    res = dwarf_get_loclist_c(attr,&head,&listlen,&err);
+    dwarf_dealloc_attribute(attr);
+    dwarf_dealloc_die(die);
+    if (c->c_res == DECODE_ERROR) {
+        check(c->c_name,"decoding fails",res == DW_DLV_ERROR,
+            __LINE__);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,err);
+        } else if (res == DW_DLV_OK) {
+            dwarf_dealloc_loc_head_c(head);
+        }
+        return FALSE;
+    }
+    check(c->c_name,"dwarf_get_loclist_c",res == DW_DLV_OK,
+        __LINE__);
+    if (res != DW_DLV_OK) {
+        return FALSE;
+    }
+    res = dwarf_get_locdesc_entry_d(head,0,&lle,&rawlo,&rawhi,
+        &noaddr,&lo,&hi,&opcount,desc_out,&source,&exproff,
+        &descoff,&err);
+    check(c->c_name,"dwarf_get_locdesc_entry_d",res == DW_DLV_OK,
+        __LINE__);
+    if (res != DW_DLV_OK) {
+        dwarf_dealloc_loc_head_c(head);
+        return FALSE;
+    }
+    *head_out = head;
+    return TRUE;
+}
+
+static struct eval_case_s *
+find_case(const char *name)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < CASE_COUNT; ++i) {
+        if (!strcmp(cases[i].c_name,name)) {
+            return cases+i;
+        }
+    }
+    printf("FAIL test_expreval: no case %s\n",name);
+    exit(EXIT_FAILURE);
+    return 0;
+}
+
+static void
+run_case(Dwarf_Debug dbg,const Dwarf_Expr_Callbacks *cb,
+    struct eval_case_s *c)
+{
+    Dwarf_Loc_Head_c head = 0;
+    Dwarf_Locdesc_c desc = 0;
+    Dwarf_Expr_Piece pieces[MAX_PIECES];
+    Dwarf_Unsigned count = 0;
+    Dwarf_Error err = 0;
+    unsigned pass = 0;
+    int res = 0;
+
+    if (c->c_res == SPECIAL) {
+        return;
+    }
+    if (!make_locdesc(dbg,c,&head,&desc)) {
+        return;
+    }
+    cbmode = c->c_cbmode;
+    /*  The second pass uses what the first
+        recorded in the locdesc. */
+    for (pass = 0; pass < 2; ++pass) {
+        unsigned i = 0;
+
+        memset(pieces,0,sizeof(pieces));
+        count = 0;
+        res = dwarf_expr_evaluate(desc,cb,pieces,MAX_PIECES,
+            &count,&err);
+        check(c->c_name,"return value",res == c->c_res,__LINE__);
+        if (res == DW_DLV_ERROR) {
+            check(c->c_name,"DW_DLE_EXPR_EVAL_ERROR",
+                dwarf_errno(err) == DW_DLE_EXPR_EVAL_ERROR,
+                __LINE__);
+            dwarf_dealloc_error(dbg,err);
+            err = 0;
+        }
+        if (res != DW_DLV_OK || c->c_res != DW_DLV_OK) {
+            continue;
+        }
+        check(c->c_name,"piece count",count == c->c_piece_count,
+            __LINE__);
+        for (i = 0; i < count && i < c->c_piece_count; ++i) {
+            const struct piece_s *p = c->c_pieces+i;
+
+            check(c->c_name,"piece kind",
+                pieces[i].ep_kind == p->p_kind,__LINE__);
+            check(c->c_name,"piece value",
+                pieces[i].ep_value == p->p_value,__LINE__);
+            check(c->c_name,"piece size",
+                pieces[i].ep_size_bits == p->p_size_bits,__LINE__);
+            check(c->c_name,"piece offset",
+                pieces[i].ep_offset_bits == p->p_offset_bits,
+                __LINE__);
+        }
+    }
+    cbmode = CB_OK;
+    dwarf_dealloc_loc_head_c(head);
+}
+
+/*  Cases that do not fit the table. */
+static void
+run_special(Dwarf_Debug dbg,const Dwarf_Expr_Callbacks *cb)
+{
+    Dwarf_Expr_Callbacks nocb;
+    struct eval_case_s *c = 0;
+    Dwarf_Loc_Head_c head = 0;
+    Dwarf_Locdesc_c desc = 0;
+    Dwarf_Expr_Piece pieces[MAX_PIECES];
+    Dwarf_Unsigned count = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    c = find_case("implicit_value");
+    if (make_locdesc(dbg,c,&head,&desc)) {
+        res = dwarf_expr_evaluate(desc,cb,pieces,MAX_PIECES,
+            &count,&err);
+        check(c->c_name,"evaluate",res == DW_DLV_OK &&
+            count == 2,__LINE__);
+        if (res == DW_DLV_OK && count == 2) {
+            check(c->c_name,"implicit piece",
+                pieces[0].ep_kind == DW_EXPR_LOC_IMPLICIT &&
+                pieces[0].ep_value == 3 &&
+                pieces[0].ep_size_bits == 24 &&
+                pieces[0].ep_block &&
+                !memcmp(pieces[0].ep_block,c->c_bytes+2,3),
+                __LINE__);
+            check(c->c_name,"register piece",
+                pieces[1].ep_kind == DW_EXPR_LOC_REGISTER &&
+                pieces[1].ep_value == 5 &&
+                pieces[1].ep_size_bits == 8,__LINE__);
+        }
+        dwarf_dealloc_loc_head_c(head);
+    }
+
+    /*  A NULL callback the expression needs. */
+    memset(&nocb,0,sizeof(nocb));
+    c = find_case("missing callback");
+    if (make_locdesc(dbg,c,&head,&desc)) {
+        res = dwarf_expr_evaluate(desc,&nocb,pieces,MAX_PIECES,
+            &count,&err);
+        check(c->c_name,"DW_DLE_EXPR_EVAL_ERROR",
+            res == DW_DLV_ERROR &&
+            dwarf_errno(err) == DW_DLE_EXPR_EVAL_ERROR,__LINE__);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,err);
+            err = 0;
+        }
+        /*  Bad arguments. */
+        res = dwarf_expr_evaluate(desc,cb,pieces,0,&count,&err);
+        check("no pieces","DW_DLE_INVALID_NULL_ARGUMENT",
+            res == DW_DLV_ERROR &&
+            dwarf_errno(err) == DW_DLE_INVALID_NULL_ARGUMENT,
+            __LINE__);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,err);
+            err = 0;
+        }
+        dwarf_dealloc_loc_head_c(head);
+    }
+    res = dwarf_expr_evaluate(0,cb,pieces,MAX_PIECES,&count,&err);
+    check("NULL locdesc","error",res == DW_DLV_ERROR,__LINE__);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,err);
+        err = 0;
+    }
+}
+
+int
+main(void)
+{
+    Dwarf_Expr_Callbacks cb;
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    unsigned i = 0;
+    int res = 0;
+
+    build_sections();
+    res = dwarf_object_init_b(&obj_interface,0,0,
+        DW_GROUPNUMBER_ANY,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        printf("FAIL test_expreval: dwarf_object_init_b %s\n",
+            res == DW_DLV_ERROR? dwarf_errmsg(err):"no entry");
+        exit(EXIT_FAILURE);
+    }
+    memset(&cb,0,sizeof(cb));
+    cb.ec_read_register = cb_read_register;
+    cb.ec_read_memory = cb_read_memory;
+    cb.ec_frame_base = cb_frame_base;
+    cb.ec_call_frame_cfa = cb_call_frame_cfa;
+    for (i = 0; i < CASE_COUNT; ++i) {
+        run_case(dbg,&cb,cases+i);
+    }
+    run_special(dbg,&cb);
+    dwarf_object_finish(dbg);
+    if (errcount) {
+        printf("FAIL test_expreval\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_expreval\n");
+    return 0;
+}
@@ -0,0 +1,238 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  Tests dwarf_find_cu_by_pc() and dwarf_find_cus_by_pcs()
+    on testmulticuLE64ELf.testme, whose first CU
+    (CU DIE at 0xc) has the ranges [0x1040,0x1063) and
+    [0x1160,0x11a9) and whose second (CU DIE at 0x19a)
+    has [0x11b0,0x11c5).
+    The table memory must come from the allocator
+    passed to dwarf_init_path_alloc().
+
+    ./test_findcubypc -f <top of the source tree>
+    or with DWTOPSRCDIR set in the environment. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() free() getenv() malloc() */
+#include <string.h> /* strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+
+#define OBJNAME "/test/testmulticuLE64ELf.testme"
+#define CU_A 0xc
+#define CU_B 0x19a
+
+static int errcount;
+static char pathbuf[2000];
+static Dwarf_Unsigned mallocs;
+static Dwarf_Unsigned frees;
+
+struct pc_case_s {
+    Dwarf_Addr pc;
+    /* Zero if no CU has pc */
+    Dwarf_Off  cu;
+};
+
+static struct pc_case_s cases[] = {
+{0,      0},
+{0x1000, 0},
+{0x103f, 0},
+/*  First range of CU A, both ends. */
+{0x1040, CU_A},
+{0x1062, CU_A},
+{0x1063, 0},
+{0x1100, 0},
+{0x1160, CU_A},
+/*  The CU boundary: last byte of A, the gap, B. */
+{0x11a8, CU_A},
+{0x11a9, 0},
+{0x11af, 0},
+{0x11b0, CU_B},
+{0x11c4, CU_B},
+{0x11c5, 0},
+{~(Dwarf_Addr)0, 0}
+};
+#define CASE_COUNT (sizeof(cases)/sizeof(cases[0]))
+
+/*  Counts calls only, blocks are plain malloc()ed. */
+static void *
+count_malloc(void *user_data,Dwarf_Unsigned len)
+{
+    (void)user_data;
+    ++mallocs;
+    return malloc((size_t)len);
+}
+
+static void
+count_free(void *user_data,void *space)
+{
+    (void)user_data;
+    ++frees;
+    free(space);
+}
+
+static void
+check(const char *msg,int ok,Dwarf_Addr pc,int line)
+{
+    if (ok) {
+        return;
+    }
+    printf("FAIL %s pc 0x%lx test line %d\n",msg,
+        (unsigned long)pc,line);
+    ++errcount;
+}
+
+static void
+setup_path(int argc,char **argv)
+{
+    const char *top = 0;
+    size_t len = 0;
+
+    if (argc > 2 && !strcmp(argv[1],"-f")) {
+        top = argv[2];
+    } else {
+        top = getenv("DWTOPSRCDIR");
+    }
+    if (!top) {
+        printf("FAIL test_findcubypc: use -f <source base> "
+            "or set DWTOPSRCDIR\n");
+        exit(EXIT_FAILURE);
+    }
+    len = strlen(top);
+    if (len + sizeof(OBJNAME) >= sizeof(pathbuf)) {
+        printf("FAIL test_findcubypc: path too long\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(pathbuf,top,len);
+    memcpy(pathbuf+len,OBJNAME,sizeof(OBJNAME));
+}
+
+/*  Runs dwarf_find_cus_by_pcs() on the cases
+    in the order given by order[]. */
+static void
+check_many(Dwarf_Debug dbg,const unsigned *order,
+    unsigned count,int line)
+{
+    Dwarf_Addr pcs[CASE_COUNT];
+    Dwarf_Off  offs[CASE_COUNT];
+    Dwarf_Unsigned found = 0;
+    Dwarf_Unsigned expect_found = 0;
+    Dwarf_Error err = 0;
+    unsigned i = 0;
+    int res = 0;
+
+    for (i = 0; i < count; ++i) {
+        pcs[i] = cases[order[i]].pc;
+        offs[i] = 0x5555;
+        if (cases[order[i]].cu) {
+            ++expect_found;
+        }
+    }
+    res = dwarf_find_cus_by_pcs(dbg,count,pcs,offs,&found,&err);
+    check("dwarf_find_cus_by_pcs return",
+        res == (expect_found? DW_DLV_OK: DW_DLV_NO_ENTRY),0,line);
+    if (res != DW_DLV_OK) {
+        return;
+    }
+    check("dwarf_find_cus_by_pcs found count",
+        found == expect_found,0,line);
+    for (i = 0; i < count; ++i) {
+        check("dwarf_find_cus_by_pcs offset",
+            offs[i] == cases[order[i]].cu,pcs[i],line);
+    }
+}
+
+int
+main(int argc,char **argv)
+{
+    Dwarf_Allocator alloc;
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    Dwarf_Unsigned before = 0;
+    unsigned order[CASE_COUNT];
+    unsigned misses[CASE_COUNT];
+    unsigned misscount = 0;
+    unsigned i = 0;
+    int res = 0;
+
+    setup_path(argc,argv);
+    memset(&alloc,0,sizeof(alloc));
+    alloc.da_malloc = count_malloc;
+    alloc.da_free = count_free;
+    res = dwarf_init_path_alloc(pathbuf,0,0,DW_GROUPNUMBER_ANY,
+        0,&alloc,0,0,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        printf("FAIL test_findcubypc: cannot open %s\n",pathbuf);
+        exit(EXIT_FAILURE);
+    }
+    before = mallocs;
+    for (i = 0; i < CASE_COUNT; ++i) {
+        Dwarf_Off off = 0x5555;
+
+        res = dwarf_find_cu_by_pc(dbg,cases[i].pc,&off,&err);
+        if (cases[i].cu) {
+            check("dwarf_find_cu_by_pc hit",
+                res == DW_DLV_OK && off == cases[i].cu,
+                cases[i].pc,__LINE__);
+        } else {
+            check("dwarf_find_cu_by_pc miss",
+                res == DW_DLV_NO_ENTRY,cases[i].pc,__LINE__);
+            misses[misscount++] = i;
+        }
+    }
+
+    check("table memory from the allocator",mallocs > before,
+        0,__LINE__);
+
+    /*  Sorted, reversed, and only misses. */
+    for (i = 0; i < CASE_COUNT; ++i) {
+        order[i] = i;
+    }
+    check_many(dbg,order,CASE_COUNT,__LINE__);
+    for (i = 0; i < CASE_COUNT; ++i) {
+        order[i] = (unsigned)(CASE_COUNT - 1 - i);
+    }
+    check_many(dbg,order,CASE_COUNT,__LINE__);
+    check_many(dbg,misses,misscount,__LINE__);
+    dwarf_finish(dbg);
+    check("all allocator memory freed",mallocs == frees,
+        0,__LINE__);
+    if (errcount) {
+        printf("FAIL test_findcubypc\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_findcubypc\n");
+    return 0;
+}
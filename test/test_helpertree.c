@@ -37,6 +37,7 @@
 #include "libdwarf_private.h"
 #include "dd_globals.h"
 #include "dwarf_tsearch.h"
+#include "dd_map.h"
 #include "dd_helpertree.h"
 
 /*  WARNING: the tree walk functions will, if presented **tree
@@ -0,0 +1,215 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  Tests dwarf_iterate_globals_by_type(): for each
+    kind it must see the same entries, in the same order
+    and with the same offsets, as dwarf_globals_by_type(),
+    and a callback returning other than DW_DLV_OK
+    must end the iteration.
+
+    ./test_iterglobals -f <top of the source tree>
+    or with DWTOPSRCDIR set in the environment. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() getenv() */
+#include <string.h> /* strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+
+#define OBJNAME "/test/testmulticuLE64ELf.testme"
+
+static int errcount;
+static char pathbuf[2000];
+
+/*  What the callback compares each entry against. */
+struct compare_s {
+    Dwarf_Global  *c_globs;
+    Dwarf_Signed   c_count;
+    Dwarf_Signed   c_seen;
+    /*  Stop after this many, zero means never. */
+    Dwarf_Signed   c_stop_after;
+};
+
+static void
+check(const char *msg,int ok,int line)
+{
+    if (ok) {
+        return;
+    }
+    printf("FAIL %s test line %d\n",msg,line);
+    ++errcount;
+}
+
+static void
+setup_path(int argc,char **argv)
+{
+    const char *top = 0;
+    size_t len = 0;
+
+    if (argc > 2 && !strcmp(argv[1],"-f")) {
+        top = argv[2];
+    } else {
+        top = getenv("DWTOPSRCDIR");
+    }
+    if (!top) {
+        printf("FAIL test_iterglobals: use -f <source base> "
+            "or set DWTOPSRCDIR\n");
+        exit(EXIT_FAILURE);
+    }
+    len = strlen(top);
+    if (len + sizeof(OBJNAME) >= sizeof(pathbuf)) {
+        printf("FAIL test_iterglobals: path too long\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(pathbuf,top,len);
+    memcpy(pathbuf+len,OBJNAME,sizeof(OBJNAME));
+}
+
+static int
+compare_global(Dwarf_Global g,void *user_data)
+{
+    struct compare_s *c = (struct compare_s *)user_data;
+    Dwarf_Global want = 0;
+    char *name = 0;
+    char *wname = 0;
+    Dwarf_Off dieoff = 0;
+    Dwarf_Off wdieoff = 0;
+    Dwarf_Off cuoff = 0;
+    Dwarf_Off wcuoff = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+    int wres = 0;
+
+    if (c->c_seen >= c->c_count) {
+        check("more entries than dwarf_globals_by_type",0,
+            __LINE__);
+        return DW_DLV_NO_ENTRY;
+    }
+    want = c->c_globs[c->c_seen];
+    ++c->c_seen;
+    res = dwarf_global_name_offsets(g,&name,&dieoff,&cuoff,&err);
+    wres = dwarf_global_name_offsets(want,&wname,&wdieoff,&wcuoff,
+        &err);
+    check("dwarf_global_name_offsets",
+        res == DW_DLV_OK && wres == DW_DLV_OK,__LINE__);
+    if (res == DW_DLV_OK && wres == DW_DLV_OK) {
+        check("same name",!strcmp(name,wname),__LINE__);
+        check("same DIE offset",dieoff == wdieoff,__LINE__);
+        check("same CU DIE offset",cuoff == wcuoff,__LINE__);
+    }
+    check("same tag",
+        dwarf_global_tag_number(g) == dwarf_global_tag_number(want),
+        __LINE__);
+    if (c->c_stop_after && c->c_seen >= c->c_stop_after) {
+        return DW_DLV_NO_ENTRY;
+    }
+    return DW_DLV_OK;
+}
+
+static void
+compare_kind(Dwarf_Debug dbg,int kind,int expect_entries)
+{
+    struct compare_s cmp;
+    Dwarf_Global *globs = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Unsigned itercount = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+    int ires = 0;
+
+    memset(&cmp,0,sizeof(cmp));
+    res = dwarf_globals_by_type(dbg,kind,&globs,&count,&err);
+    check("dwarf_globals_by_type",res != DW_DLV_ERROR,__LINE__);
+    if (res == DW_DLV_ERROR) {
+        return;
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        count = 0;
+    }
+    check("entries expected",(count > 0) == expect_entries,
+        __LINE__);
+    cmp.c_globs = globs;
+    cmp.c_count = count;
+    itercount = 12345;
+    ires = dwarf_iterate_globals_by_type(dbg,kind,compare_global,
+        &cmp,&itercount,&err);
+    /*  dwarf_globals_by_type() returns an empty
+        array where this returns DW_DLV_NO_ENTRY. */
+    check("return value",
+        ires == (count? DW_DLV_OK: DW_DLV_NO_ENTRY),__LINE__);
+    check("same count",(Dwarf_Signed)itercount == count,__LINE__);
+    check("callback saw every entry",cmp.c_seen == count,__LINE__);
+
+    if (count > 1) {
+        /*  Ending early after the first entry. */
+        cmp.c_seen = 0;
+        cmp.c_stop_after = 1;
+        ires = dwarf_iterate_globals_by_type(dbg,kind,
+            compare_global,&cmp,&itercount,&err);
+        check("stopped early",ires == DW_DLV_OK &&
+            itercount == 1 && cmp.c_seen == 1,__LINE__);
+    }
+    if (res == DW_DLV_OK) {
+        dwarf_globals_dealloc(dbg,globs,count);
+    }
+}
+
+int
+main(int argc,char **argv)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    setup_path(argc,argv);
+    res = dwarf_init_path(pathbuf,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        printf("FAIL test_iterglobals: cannot open %s\n",pathbuf);
+        exit(EXIT_FAILURE);
+    }
+    compare_kind(dbg,DW_GL_GLOBALS,TRUE);
+    compare_kind(dbg,DW_GL_PUBTYPES,TRUE);
+    /*  Sections not in the object. */
+    compare_kind(dbg,DW_GL_FUNCS,FALSE);
+    compare_kind(dbg,DW_GL_WEAKS,FALSE);
+    dwarf_finish(dbg);
+    if (errcount) {
+        printf("FAIL test_iterglobals\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_iterglobals\n");
+    return 0;
+}
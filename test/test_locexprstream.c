@@ -0,0 +1,418 @@
+/*
+Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  Tests dwarf_get_loclist_entry_by_pc() on the
+    location list of main's argv in
+    testmulticuLE64ELf.testme (.debug_loclists
+    offset 0x2b), which is
+        0x2b DW_LLE_base_address 0x1040
+        0x34 DW_LLE_offset_pair [0x1040,0x1046) DW_OP_reg4
+        0x39 DW_LLE_offset_pair [0x1046,0x1063)
+             DW_OP_entry_value DW_OP_stack_value
+        0x41 DW_LLE_default_location
+             DW_OP_lit7 DW_OP_stack_value
+        0x45 DW_LLE_end_of_list
+    and argc's, which has no default entry.
+    Also tests dwarf_loc_expr_stream_init() and
+    dwarf_loc_expr_stream_next() on expression bytes
+    built here, well formed and not.
+
+    ./test_locexprstream -f <top of the source tree>
+    or with DWTOPSRCDIR set in the environment. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() getenv() */
+#include <string.h> /* strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+
+#define OBJNAME "/test/testmulticuLE64ELf.testme"
+
+static int errcount;
+static char pathbuf[2000];
+
+/*  One operator expected from a stream. */
+struct op_s {
+    Dwarf_Small    o_atom;
+    Dwarf_Unsigned o_op1;
+    Dwarf_Unsigned o_offset;
+};
+
+static void
+check(const char *msg,int ok,int line)
+{
+    if (ok) {
+        return;
+    }
+    printf("FAIL %s test line %d\n",msg,line);
+    ++errcount;
+}
+
+static void
+setup_path(int argc,char **argv)
+{
+    const char *top = 0;
+    size_t len = 0;
+
+    if (argc > 2 && !strcmp(argv[1],"-f")) {
+        top = argv[2];
+    } else {
+        top = getenv("DWTOPSRCDIR");
+    }
+    if (!top) {
+        printf("FAIL test_locexprstream: use -f <source base> "
+            "or set DWTOPSRCDIR\n");
+        exit(EXIT_FAILURE);
+    }
+    len = strlen(top);
+    if (len + sizeof(OBJNAME) >= sizeof(pathbuf)) {
+        printf("FAIL test_locexprstream: path too long\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(pathbuf,top,len);
+    memcpy(pathbuf+len,OBJNAME,sizeof(OBJNAME));
+}
+
+/*  Reads the whole stream, comparing each operator
+    with ops[]. Operands are compared only where
+    o_op1 is not ~0. Then the end must be reported,
+    and reported again. */
+static void
+check_stream(Dwarf_Loc_Expr_Stream *stream,
+    const struct op_s *ops,unsigned count,int line)
+{
+    Dwarf_Small atom = 0;
+    Dwarf_Unsigned op1 = 0;
+    Dwarf_Unsigned op2 = 0;
+    Dwarf_Unsigned op3 = 0;
+    Dwarf_Unsigned offset = 0;
+    Dwarf_Error err = 0;
+    unsigned i = 0;
+    int res = 0;
+
+    for (i = 0; ; ++i) {
+        res = dwarf_loc_expr_stream_next(stream,&atom,&op1,&op2,
+            &op3,&offset,&err);
+        if (i == count) {
+            check("end of stream",res == DW_DLV_NO_ENTRY,line);
+            break;
+        }
+        check("dwarf_loc_expr_stream_next",res == DW_DLV_OK,line);
+        if (res != DW_DLV_OK) {
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc_error(stream->es_dbg,err);
+            }
+            return;
+        }
+        check("operator",atom == ops[i].o_atom,line);
+        check("operator offset",offset == ops[i].o_offset,line);
+        if (ops[i].o_op1 != ~(Dwarf_Unsigned)0) {
+            check("operand",op1 == ops[i].o_op1,line);
+        }
+    }
+    res = dwarf_loc_expr_stream_next(stream,&atom,&op1,&op2,
+        &op3,&offset,&err);
+    check("end of stream again",res == DW_DLV_NO_ENTRY,line);
+}
+
+/*  Expects dwarf_loc_expr_stream_next() to fail
+    after 'good' operators. */
+static void
+check_malformed(Dwarf_Debug dbg,Dwarf_Small *bytes,
+    Dwarf_Unsigned len,unsigned good,int line)
+{
+    Dwarf_Loc_Expr_Stream stream;
+    Dwarf_Error err = 0;
+    unsigned i = 0;
+    int res = 0;
+
+    res = dwarf_loc_expr_stream_init(dbg,bytes,len,8,4,5,
+        &stream,&err);
+    check("dwarf_loc_expr_stream_init",res == DW_DLV_OK,line);
+    for (i = 0; i <= good; ++i) {
+        Dwarf_Small atom = 0;
+        Dwarf_Unsigned op1 = 0;
+        Dwarf_Unsigned op2 = 0;
+        Dwarf_Unsigned op3 = 0;
+        Dwarf_Unsigned offset = 0;
+
+        res = dwarf_loc_expr_stream_next(&stream,&atom,&op1,&op2,
+            &op3,&offset,&err);
+        if (i < good) {
+            check("operator before the bad one",res == DW_DLV_OK,
+                line);
+        } else {
+            check("malformed operator",res == DW_DLV_ERROR,line);
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc_error(dbg,err);
+                err = 0;
+            }
+        }
+    }
+}
+
+static void
+test_built_expressions(Dwarf_Debug dbg)
+{
+    static Dwarf_Small expr[] = {
+        DW_OP_const1u, 0x12,
+        DW_OP_plus_uconst, 0x80, 0x01,
+        DW_OP_addr, 1,2,3,4,5,6,7,8,
+        DW_OP_dup,
+        DW_OP_stack_value };
+    static const struct op_s expr_ops[] = {
+        {DW_OP_const1u,0x12,0},
+        {DW_OP_plus_uconst,0x80,2},
+        {DW_OP_addr,0x0807060504030201ULL,5},
+        {DW_OP_dup,0,14},
+        {DW_OP_stack_value,0,15}};
+    static Dwarf_Small short_const[] = {
+        DW_OP_lit1, DW_OP_const4u, 1, 2};
+    static Dwarf_Small bad_leb[] = {
+        DW_OP_lit1, DW_OP_lit2, DW_OP_constu, 0x80};
+    static Dwarf_Small short_addr[] = {
+        DW_OP_addr, 1,2,3,4};
+    static Dwarf_Small unknown_op[] = {
+        DW_OP_lit0, 0xfe};
+    Dwarf_Loc_Expr_Stream stream;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    res = dwarf_loc_expr_stream_init(dbg,expr,sizeof(expr),8,4,5,
+        &stream,&err);
+    check("dwarf_loc_expr_stream_init",res == DW_DLV_OK,__LINE__);
+    check("es_locdesc_offset zero",stream.es_locdesc_offset == 0,
+        __LINE__);
+    check_stream(&stream,expr_ops,
+        sizeof(expr_ops)/sizeof(expr_ops[0]),__LINE__);
+
+    res = dwarf_loc_expr_stream_init(dbg,0,0,8,4,5,&stream,&err);
+    check("empty expression",res == DW_DLV_OK,__LINE__);
+    check_stream(&stream,0,0,__LINE__);
+    res = dwarf_loc_expr_stream_init(dbg,0,4,8,4,5,&stream,&err);
+    check("NULL with a length",res == DW_DLV_ERROR,__LINE__);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,err);
+        err = 0;
+    }
+
+    check_malformed(dbg,short_const,sizeof(short_const),1,
+        __LINE__);
+    check_malformed(dbg,bad_leb,sizeof(bad_leb),2,__LINE__);
+    check_malformed(dbg,short_addr,sizeof(short_addr),0,__LINE__);
+    check_malformed(dbg,unknown_op,sizeof(unknown_op),1,__LINE__);
+}
+
+/*  Returns the DW_AT_location of the formal
+    parameter named name in main (the first
+    subprogram with children of the first CU). */
+static int
+find_param_location(Dwarf_Debug dbg,const char *name,
+    Dwarf_Die *die_out,Dwarf_Attribute *attr_out)
+{
+    Dwarf_Die cudie = 0;
+    Dwarf_Die die = 0;
+    Dwarf_Error err = 0;
+    int found = FALSE;
+    int res = 0;
+
+    res = dwarf_next_cu_header_e(dbg,TRUE,&cudie,
+        0,0,0,0,0,0,0,0,0,0,&err);
+    if (res != DW_DLV_OK) {
+        return FALSE;
+    }
+    res = dwarf_child(cudie,&die,&err);
+    while (res == DW_DLV_OK && !found) {
+        Dwarf_Die sib = 0;
+        Dwarf_Die param = 0;
+        char *diename = 0;
+        int pres = 0;
+
+        if (dwarf_diename(die,&diename,&err) == DW_DLV_OK &&
+            !strcmp(diename,"main")) {
+            pres = dwarf_child(die,&param,&err);
+        } else {
+            pres = DW_DLV_NO_ENTRY;
+        }
+        while (pres == DW_DLV_OK) {
+            Dwarf_Die psib = 0;
+            char *pname = 0;
+
+            if (!found &&
+                dwarf_diename(param,&pname,&err) == DW_DLV_OK &&
+                !strcmp(pname,name) &&
+                dwarf_attr(param,DW_AT_location,attr_out,&err) ==
+                DW_DLV_OK) {
+                found = TRUE;
+                *die_out = param;
+                break;
+            }
+            pres = dwarf_siblingof_c(param,&psib,&err);
+            dwarf_dealloc_die(param);
+            param = psib;
+        }
+        res = dwarf_siblingof_c(die,&sib,&err);
+        dwarf_dealloc_die(die);
+        die = sib;
+    }
+    if (res == DW_DLV_OK) {
+        dwarf_dealloc_die(die);
+    }
+    dwarf_dealloc_die(cudie);
+    /*  Position at the end so the next
+        dwarf_next_cu_header_e() starts over. */
+    while (dwarf_next_cu_header_e(dbg,TRUE,0,
+        0,0,0,0,0,0,0,0,0,0,&err) == DW_DLV_OK) {
+    }
+    return found;
+}
+
+/*  Looks up pc in the argv location list. */
+static void
+check_argv_at(Dwarf_Attribute attr,Dwarf_Addr pc,
+    Dwarf_Small lle,Dwarf_Addr low,Dwarf_Addr high,
+    Dwarf_Unsigned entryoff,const struct op_s *ops,
+    unsigned opcount,int line)
+{
+    Dwarf_Loc_Expr_Stream stream;
+    Dwarf_Small lle_value = 0;
+    Dwarf_Addr lowpc = 1;
+    Dwarf_Addr highpc = 1;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    memset(&stream,0x5a,sizeof(stream));
+    res = dwarf_get_loclist_entry_by_pc(attr,pc,&lle_value,
+        &lowpc,&highpc,&stream,&err);
+    check("dwarf_get_loclist_entry_by_pc",res == DW_DLV_OK,line);
+    if (res != DW_DLV_OK) {
+        return;
+    }
+    check("DW_LLE value",lle_value == lle,line);
+    check("low pc",lowpc == low,line);
+    check("high pc",highpc == high,line);
+    check("entry offset",stream.es_locdesc_offset == entryoff,
+        line);
+    check_stream(&stream,ops,opcount,line);
+}
+
+static void
+test_entry_by_pc(Dwarf_Debug dbg)
+{
+    static const struct op_s reg4_ops[] = {
+        {DW_OP_reg4,0,0}};
+    static const struct op_s entry_ops[] = {
+        {DW_OP_entry_value,1,0},
+        {DW_OP_stack_value,0,3}};
+    static const struct op_s default_ops[] = {
+        {DW_OP_lit7,7,0},
+        {DW_OP_stack_value,0,1}};
+    Dwarf_Die die = 0;
+    Dwarf_Attribute attr = 0;
+    Dwarf_Loc_Expr_Stream stream;
+    Dwarf_Small lle_value = 0;
+    Dwarf_Addr lowpc = 0;
+    Dwarf_Addr highpc = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    if (!find_param_location(dbg,"argv",&die,&attr)) {
+        check("argv location found",0,__LINE__);
+        return;
+    }
+    check_argv_at(attr,0x1040,DW_LLE_offset_pair,0x1040,0x1046,
+        0x34,reg4_ops,1,__LINE__);
+    check_argv_at(attr,0x1045,DW_LLE_offset_pair,0x1040,0x1046,
+        0x34,reg4_ops,1,__LINE__);
+    check_argv_at(attr,0x1046,DW_LLE_offset_pair,0x1046,0x1063,
+        0x39,entry_ops,2,__LINE__);
+    /*  Outside every bounded entry. */
+    check_argv_at(attr,0x1063,DW_LLE_default_location,0,0,
+        0x41,default_ops,2,__LINE__);
+    check_argv_at(attr,0x11b0,DW_LLE_default_location,0,0,
+        0x41,default_ops,2,__LINE__);
+    check_argv_at(attr,0,DW_LLE_default_location,0,0,
+        0x41,default_ops,2,__LINE__);
+    dwarf_dealloc_attribute(attr);
+    dwarf_dealloc_die(die);
+
+    if (!find_param_location(dbg,"argc",&die,&attr)) {
+        check("argc location found",0,__LINE__);
+        return;
+    }
+    res = dwarf_get_loclist_entry_by_pc(attr,0x1048,&lle_value,
+        &lowpc,&highpc,&stream,&err);
+    check("argc at 0x1048",res == DW_DLV_OK &&
+        lle_value == DW_LLE_offset_pair &&
+        lowpc == 0x1040 && highpc == 0x104a &&
+        stream.es_locdesc_offset == 0x19,__LINE__);
+    res = dwarf_get_loclist_entry_by_pc(attr,0x1063,&lle_value,
+        &lowpc,&highpc,&stream,&err);
+    check("argc has no default",res == DW_DLV_NO_ENTRY,__LINE__);
+    res = dwarf_get_loclist_entry_by_pc(attr,0x1000,&lle_value,
+        &lowpc,&highpc,0,&err);
+    check("NULL stream",res == DW_DLV_ERROR,__LINE__);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,err);
+    }
+    dwarf_dealloc_attribute(attr);
+    dwarf_dealloc_die(die);
+}
+
+int
+main(int argc,char **argv)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    setup_path(argc,argv);
+    res = dwarf_init_path(pathbuf,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        printf("FAIL test_locexprstream: cannot open %s\n",
+            pathbuf);
+        exit(EXIT_FAILURE);
+    }
+    test_built_expressions(dbg);
+    test_entry_by_pc(dbg);
+    dwarf_finish(dbg);
+    if (errcount) {
+        printf("FAIL test_locexprstream\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_locexprstream\n");
+    return 0;
+}
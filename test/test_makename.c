@@ -40,8 +40,9 @@ Portions Copyright(C) David Anderson 2016. All Rights reserved.
 
 #include <config.h>
 
-#include <stdio.h>  /* printf() */
+#include <stdio.h>  /* printf() sprintf() */
 #include <stdlib.h> /* exit() */
+#include <string.h> /* memset() strcmp() strlen() */
 
 #ifdef HAVE_STDINT_H
 #include <stdint.h> /* uintptr_t */
@@ -51,6 +52,8 @@ Portions Copyright(C) David Anderson 2016. All Rights reserved.
 #include "dwarf_tsearch.h"
 #include "dd_makename.h"
 #include "dd_globals.h"
+#include "dd_map.h"
+#include "dd_intern.h"
 #include "dd_minimal.h"
 
 void dd_minimal_count_global_error(void) {}
@@ -73,6 +76,76 @@ char *samples[]  = {
 0
 };
 
+#define MANY 20000
+static const char *many[MANY];
+
+/*  Many strings (so the maps grow and several chunks
+    are used), one longer than a chunk, and strings
+    looked up by where they lie. */
+static int
+test_intern(void)
+{
+    struct Dd_Intern_s in;
+    char buf[40];
+    static char longstr[100000];
+    /*  Stands in for a string section: "abc" at two
+        places and "xyz". */
+    static const char section[] = "abc\0xyz\0abc";
+    const char *l = 0;
+    const char *a1 = 0;
+    const char *a2 = 0;
+    int i = 0;
+    int errct = 0;
+
+    memset(&in,0,sizeof(in));
+    for (i = 0; i < MANY; ++i) {
+        sprintf(buf,"name%d",i);
+        many[i] = dd_intern(&in,buf);
+        if (!many[i] || strcmp(many[i],buf)) {
+            printf(" FAIL. intern %s\n",buf);
+            ++errct;
+        }
+    }
+    memset(longstr,'q',sizeof(longstr)-1);
+    l = dd_intern(&in,longstr);
+    if (!l || l == longstr || strlen(l) != sizeof(longstr)-1) {
+        printf(" FAIL. intern long string\n");
+        ++errct;
+    }
+    for (i = 0; i < MANY; ++i) {
+        sprintf(buf,"name%d",i);
+        if (dd_intern(&in,buf) != many[i]) {
+            printf(" FAIL. second intern %s\n",buf);
+            ++errct;
+        }
+    }
+    if (dd_intern(&in,longstr) != l ||
+        in.in_count != MANY+1) {
+        printf(" FAIL. intern counts\n");
+        ++errct;
+    }
+    a1 = dd_intern_section_string(&in,section);
+    a2 = dd_intern_section_string(&in,section+8);
+    if (!a1 || a1 != a2 || strcmp(a1,"abc") ||
+        dd_intern_section_string(&in,section) != a1 ||
+        dd_intern(&in,"abc") != a1) {
+        printf(" FAIL. section string abc\n");
+        ++errct;
+    }
+    a2 = dd_intern_section_string(&in,section+4);
+    if (!a2 || a2 == a1 || strcmp(a2,"xyz")) {
+        printf(" FAIL. section string xyz\n");
+        ++errct;
+    }
+    dd_intern_destroy(&in);
+    if (in.in_count || dd_intern(&in,"") == 0) {
+        printf(" FAIL. intern after destroy\n");
+        ++errct;
+    }
+    dd_intern_destroy(&in);
+    return errct;
+}
+
 int main(void)
 {
     char *e1 = 0;
@@ -98,6 +171,13 @@ int main(void)
         printf(" FAIL. match  pointers\n");
         ++errct;
     }
+    if (makename(0)[0] || *makename("") ||
+        makename("") != makename("")) {
+        printf(" FAIL. empty strings\n");
+        ++errct;
+    }
+    errct += test_intern();
+    makename_destructor();
     if (errct) {
         exit(EXIT_FAILURE);
     }
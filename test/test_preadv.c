@@ -0,0 +1,201 @@
+/*
+  Copyright (C) 2026 David Anderson. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  Tests of the positional and vectored read
+    functions in dwarf_seekr.c and
+    dwarf_object_read_common.c, which
+    dwarf_load_sections() uses to read sections.  */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() tmpfile() fileno() */
+#include <stdlib.h> /* exit() */
+#include <string.h> /* memcmp() memset() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dwarf_base_types.h"
+#include "dwarf_opaque.h"
+#include "dwarf_object_read_common.h"
+
+#ifdef _WIN32
+#define fileno _fileno
+#endif /* _WIN32 */
+
+#define FILE_LEN 1000
+#define BUF_COUNT 40
+
+static int errcount;
+static unsigned char filedata[FILE_LEN];
+static char bufs[BUF_COUNT][FILE_LEN];
+
+static void
+check_res(const char *msg,int expect,int got,int line)
+{
+    if (expect == got) {
+        return;
+    }
+    printf("FAIL %s expected %d got %d test line %d\n",
+        msg,expect,got,line);
+    ++errcount;
+}
+
+static void
+check_bytes(const char *msg,const char *buf,
+    Dwarf_Unsigned loc,Dwarf_Unsigned len,int line)
+{
+    if (!len) {
+        return;
+    }
+    if (!memcmp(buf,filedata+loc,(size_t)len)) {
+        return;
+    }
+    printf("FAIL %s bytes differ at file offset %lu "
+        "length %lu test line %d\n",
+        msg,(unsigned long)loc,(unsigned long)len,line);
+    ++errcount;
+}
+
+/*  Reads lens[0..count-1] contiguous lengths
+    starting at loc and checks what landed in
+    each buffer. */
+static void
+test_vec(const char *msg,int fd,Dwarf_Unsigned loc,
+    Dwarf_Unsigned *lens,unsigned count,int line)
+{
+    struct Dwarf_Read_Vec_s vec[BUF_COUNT];
+    Dwarf_Unsigned off = loc;
+    unsigned i = 0;
+    int res = 0;
+
+    for (i = 0; i < count; ++i) {
+        memset(bufs[i],0xee,FILE_LEN);
+        vec[i].rv_buf = bufs[i];
+        vec[i].rv_len = lens[i];
+    }
+    res = _dwarf_preadvr(fd,vec,count,loc);
+    check_res(msg,DW_DLV_OK,res,line);
+    if (res != DW_DLV_OK) {
+        return;
+    }
+    for (i = 0; i < count; ++i) {
+        check_bytes(msg,bufs[i],off,lens[i],line);
+        off += lens[i];
+    }
+}
+
+int
+main(void)
+{
+    FILE *f = 0;
+    int fd = -1;
+    unsigned i = 0;
+    int res = 0;
+    int errc = 0;
+    Dwarf_Unsigned lens[BUF_COUNT];
+    struct Dwarf_Read_Vec_s vec[2];
+    Dwarf_Unsigned sizeread = 0;
+
+    for (i = 0; i < FILE_LEN; ++i) {
+        filedata[i] = (unsigned char)(i*7 + 3);
+    }
+    f = tmpfile();
+    if (!f) {
+        printf("FAIL test_preadv cannot create a temp file\n");
+        exit(EXIT_FAILURE);
+    }
+    if (fwrite(filedata,1,FILE_LEN,f) != FILE_LEN ||
+        fflush(f)) {
+        printf("FAIL test_preadv cannot write the temp file\n");
+        exit(EXIT_FAILURE);
+    }
+    fd = fileno(f);
+
+    /*  Plain positional reads. */
+    res = _dwarf_preadr(fd,bufs[0],10,100,&sizeread);
+    check_res("preadr",DW_DLV_OK,res,__LINE__);
+    check_res("preadr size",100,(int)sizeread,__LINE__);
+    check_bytes("preadr",bufs[0],10,100,__LINE__);
+    res = _dwarf_preadr(fd,bufs[0],10,0,0);
+    check_res("preadr zero length",DW_DLV_OK,res,__LINE__);
+    res = _dwarf_preadr(fd,bufs[0],FILE_LEN-10,20,0);
+    check_res("preadr past end",DW_DLV_ERROR,res,__LINE__);
+
+    /*  Vectored reads. */
+    lens[0] = 0; lens[1] = 0; lens[2] = 0;
+    test_vec("all zero length",fd,5,lens,3,__LINE__);
+    test_vec("no entries",fd,5,lens,0,__LINE__);
+    lens[0] = 0; lens[1] = 17; lens[2] = 0; lens[3] = 40;
+    lens[4] = 0;
+    test_vec("zero length mixed in",fd,3,lens,5,__LINE__);
+    /*  More entries than one preadv() call takes. */
+    for (i = 0; i < BUF_COUNT; ++i) {
+        lens[i] = (i%3)? (Dwarf_Unsigned)(i+1): 0;
+    }
+    test_vec("many entries",fd,0,lens,BUF_COUNT,__LINE__);
+    lens[0] = 10; lens[1] = 30;
+    vec[0].rv_buf = bufs[0];
+    vec[0].rv_len = lens[0];
+    vec[1].rv_buf = bufs[1];
+    vec[1].rv_len = lens[1];
+    res = _dwarf_preadvr(fd,vec,2,FILE_LEN-20);
+    check_res("preadvr past end",DW_DLV_ERROR,res,__LINE__);
+
+    /*  The bounds-checking layer over it. */
+    vec[0].rv_len = 0;
+    vec[1].rv_len = 0;
+    res = _dwarf_object_readv_random(fd,vec,2,FILE_LEN,
+        FILE_LEN,&errc);
+    check_res("readv_random zero length at end",
+        DW_DLV_OK,res,__LINE__);
+    vec[0].rv_len = 10;
+    vec[1].rv_len = 30;
+    res = _dwarf_object_readv_random(fd,vec,2,FILE_LEN-20,
+        FILE_LEN,&errc);
+    check_res("readv_random past end",DW_DLV_ERROR,res,__LINE__);
+    check_res("readv_random past end errc",
+        DW_DLE_READ_OFF_END,errc,__LINE__);
+    res = _dwarf_object_readv_random(fd,vec,2,FILE_LEN-40,
+        FILE_LEN,&errc);
+    check_res("readv_random to end",DW_DLV_OK,res,__LINE__);
+    check_bytes("readv_random to end",bufs[0],FILE_LEN-40,10,
+        __LINE__);
+    check_bytes("readv_random to end",bufs[1],FILE_LEN-30,30,
+        __LINE__);
+    fclose(f);
+    if (errcount) {
+        printf("FAIL test_preadv\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_preadv\n");
+    return 0;
+}
@@ -68,6 +68,9 @@ testx(const char *expr,
     }
     res = dd_re_exec((char *)check);
     checkres(res,"dd_re_exec",expr,check,intexpv2,line);
+    /*  The DFA and the backtracking matcher must agree. */
+    res = dd_re_exec_nfa((char *)check);
+    checkres(res,"dd_re_exec_nfa",expr,check,intexpv2,line);
 }
 
 int
@@ -146,6 +149,20 @@ main(void)
     testx("a[fx]+b[cd]",DW_DLV_OK,"afffbdddy",DW_DLV_OK,__LINE__);
     testx("a[fx]+b[cd]",DW_DLV_OK,"afffdddy",
         DW_DLV_NO_ENTRY,__LINE__);
+    /*  An empty closure only matches at the end
+        of both string and pattern. */
+    testx("x+",DW_DLV_OK,"xa",DW_DLV_NO_ENTRY,__LINE__);
+    testx("x*",DW_DLV_OK,"ab",DW_DLV_NO_ENTRY,__LINE__);
+    testx("x*",DW_DLV_OK,"",DW_DLV_OK,__LINE__);
+    testx("b*[a-c]+",DW_DLV_OK,"bbax-a",DW_DLV_OK,__LINE__);
+    testx("^x*",DW_DLV_OK,"xxc",DW_DLV_OK,__LINE__);
+    testx("_*",DW_DLV_OK,"b_ca",DW_DLV_OK,__LINE__);
+    testx("a.*b$",DW_DLV_OK,"xaxxbyb",DW_DLV_OK,__LINE__);
+    testx("a.*b$",DW_DLV_OK,"xaxxbyc",DW_DLV_NO_ENTRY,__LINE__);
+    testx("[^x]",DW_DLV_OK,"\303\251",DW_DLV_OK,__LINE__);
+    /*  Enough states to fill the DFA. */
+    testx("[ab]*a[ab][ab][ab][ab][ab][ab][ab][ab][ab]b",DW_DLV_OK,
+        "abababababaaaaaaaabbbbbbabababbbbabab",DW_DLV_OK,__LINE__);
     if (errcount > 0) {
         printf("\n\nFAIL test_regex errcount %d\n",errcount);
         return 1;
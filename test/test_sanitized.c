@@ -33,8 +33,9 @@ Portions Copyright (C) 2013-2018 David Anderson. All Rights Reserved.
 
 #include <config.h>
 
+#include <stdio.h>  /* printf() snprintf() */
 #include <stdlib.h> /* exit() */
-#include <string.h> /* strcmp() */
+#include <string.h> /* memset() strcat() strcmp() */
 
 #include "libdwarf_private.h"
 #include "dd_esb.h"
@@ -95,6 +96,90 @@ const char *s8 =
 "aaaa bbbb cccc dddd eeee ffff gggg";
 
 
+/*  The translation done one byte at a time,
+    independent of dd_sanitized.c. */
+static void
+expected_translation(const unsigned char *in, char *out)
+{
+    for ( ; *in; ++in) {
+        unsigned c = *in;
+        int ok = (c >= 0x20 && c < 0x7f && c != '%') ||
+            c == '\t' || c == '\n';
+
+#ifdef _WIN32
+        if (c == '\r') {
+            ok = 1;
+        }
+#endif /* _WIN32 */
+        if (ok) {
+            *out++ = (char)c;
+        } else {
+            snprintf(out,4,"%%%02x",c);
+            out += 3;
+        }
+    }
+    *out = 0;
+}
+
+/*  Every byte value at every offset of strings long
+    enough to need several blocks of the fast scan,
+    so the scan and the translation must agree. */
+static void
+test_all_bytes_all_offsets(void)
+{
+    unsigned char in[48];
+    char expbuf[48*3+1];
+    unsigned len = 0;
+
+    for (len = 1; len < sizeof(in); ++len) {
+        unsigned pos = 0;
+
+        for (pos = 0; pos < len; ++pos) {
+            unsigned c = 1;
+
+            for ( ; c < 256; ++c) {
+                const char *out = 0;
+
+                memset(in,'a',len);
+                in[len] = 0;
+                in[pos] = (unsigned char)c;
+                expected_translation(in,expbuf);
+                out = sanitized((const char *)in);
+                validate_san(__LINE__,(const char *)in,
+                    out,expbuf);
+                if (!strcmp(expbuf,(const char *)in) &&
+                    out != (const char *)in) {
+                    ++failcount;
+                    printf("  FAIL line %d clean string "
+                        "was copied\n",__LINE__);
+                }
+            }
+        }
+    }
+}
+
+/*  Two translated results, as in one printf,
+    both stay valid. A clean string between
+    them must not use up a buffer. */
+static void
+test_two_at_once(void)
+{
+    const char *o1 = 0;
+    const char *o2 = 0;
+    const char *o3 = 0;
+    char all[100];
+
+    o1 = sanitized("one\001");
+    o2 = sanitized("clean");
+    o3 = sanitized("three\177");
+    all[0] = 0;
+    strcat(all,o1);
+    strcat(all,o2);
+    strcat(all,o3);
+    validate_san(__LINE__,"two at once",all,
+        "one%01cleanthree%7f");
+}
+
 int main(void)
 {
     const char *out = 0;
@@ -144,6 +229,8 @@ int main(void)
          validate_san(__LINE__,
             exp,out,exp);
     }
+    test_all_bytes_all_offsets();
+    test_two_at_once();
 #ifdef TIMING
     {
          int i = 0;
@@ -0,0 +1,31 @@
+/*  This test code is hereby placed in the public domain. */
+
+/*  One of the two sources of testcppnsLE64ELf.testme,
+    see buildingcppns.sh. */
+
+namespace cpns {
+int cp_counter_a = 5;
+
+__attribute__((noinline)) int
+cp_scale(int v,int k)
+{
+    return v * k + cp_counter_a;
+}
+
+namespace inner {
+__attribute__((noinline)) int
+cp_twice(int v)
+{
+    return cp_scale(v,2);
+}
+} /* namespace inner */
+} /* namespace cpns */
+
+extern int cp_step_b(int v);
+
+int
+main(int argc,char **argv)
+{
+    (void)argv;
+    return cp_step_b(cpns::inner::cp_twice(argc)) & 0x7f;
+}
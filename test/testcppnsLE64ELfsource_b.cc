@@ -0,0 +1,18 @@
+/*  This test code is hereby placed in the public domain. */
+
+/*  One of the two sources of testcppnsLE64ELf.testme,
+    see buildingcppns.sh. */
+
+namespace cpns {
+__attribute__((noinline)) int
+cp_scale_b(int v)
+{
+    return v + 7;
+}
+} /* namespace cpns */
+
+int
+cp_step_b(int v)
+{
+    return cpns::cp_scale_b(v) * 3;
+}
@@ -0,0 +1,36 @@
+/*  This test code is hereby placed in the public domain. */
+
+/*  One of the two sources of testmulticuLE64ELf.testme,
+    see buildingmulticu.sh. */
+
+int mc_counter_a = 3;
+
+extern int mc_step_b(int v);
+
+struct mc_pair_s {
+    int mp_first;
+    int mp_second;
+};
+
+__attribute__((noinline)) int
+mc_scale_a(int v,int k)
+{
+    int scaled = v * k;
+    int i = 0;
+
+    for (i = 0; i < k; ++i) {
+        scaled = mc_step_b(scaled) + i;
+    }
+    return scaled + mc_counter_a;
+}
+
+int
+main(int argc,char **argv)
+{
+    struct mc_pair_s p;
+
+    (void)argv;
+    p.mp_first = mc_scale_a(argc,5);
+    p.mp_second = mc_step_b(p.mp_first);
+    return p.mp_first + p.mp_second > 1000;
+}
@@ -0,0 +1,18 @@
+/*  This test code is hereby placed in the public domain. */
+
+/*  One of the two sources of testmulticuLE64ELf.testme,
+    see buildingmulticu.sh.
+    Compiled without -gpubnames so the object's
+    .debug_pubnames covers only the other CU. */
+
+int mc_counter_b = 7;
+
+__attribute__((noinline)) int
+mc_step_b(int v)
+{
+    int t = v ^ mc_counter_b;
+    int r = t * 3;
+
+    mc_counter_b = r & 0xff;
+    return r >> 1;
+}